@@ -0,0 +1,17 @@
+// Cost of one super-loop iteration of the application on the host.
+#include "nucleo/app/application.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+int main(int argc, char** argv) {
+    using namespace nucleo;
+    testkit::Bench bench(argc, argv);
+
+    platform::host::reset();
+    app::Application application;
+    application.init(0);
+    std::uint32_t now = 0;
+    bench.run("app_poll", 1000, [&] { application.poll(++now); });
+    testkit::do_not_optimize(application.heartbeat_count());
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Host entry point: runs the application against the simulated board for a
+// fixed span of virtual time and prints what the peripherals saw.
+//
+//   nucleo_h563zi_host [duration_ms]
+//   nucleo_h563zi_host --replay <trace>
+//
+// --replay feeds a trace recorded on the board (nucleo/hil/recorder.hpp)
+// into the simulated peripherals on the virtual clock, polling the
+// application after every event, and prints per-stage processing latency.
+// The input and its timing are the same on every run, so two builds can be
+// compared on production input.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "nucleo/app/application.hpp"
+#include "nucleo/boot/sequence.hpp"
+#include "nucleo/hil/host/replay.hpp"
+#include "nucleo/net/board_eth.hpp"
+#include "nucleo/net/udp.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/platform/board.hpp"
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/uart/uart.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+namespace {
+
+// The same boot steps as the firmware image.
+struct Services {
+    nucleo::app::Application* application;
+    nucleo::uart::Uart* console;
+    nucleo::net::UdpStack* network;
+};
+
+nucleo::Status init_board(void*) {
+    nucleo::platform::board_init();
+    nucleo::perf::cycle_counter_init();
+    return nucleo::Status::ok;
+}
+
+nucleo::Status start_console(void* context) {
+    Services& s = *static_cast<Services*>(context);
+    const nucleo::Status status = s.console->start(nucleo::app::Config{}.console_baud);
+    if (status == nucleo::Status::ok) {
+        s.application->attach_console(*s.console);
+    }
+    return status;
+}
+
+nucleo::Status start_network(void* context) {
+    Services& s = *static_cast<Services*>(context);
+    const nucleo::Status status = s.network->start();
+    if (status == nucleo::Status::ok) {
+        s.application->attach_network(*s.network);
+    }
+    return status;
+}
+
+bool read_file(const char* path, std::vector<std::uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using namespace nucleo;
+    const bool replay = argc > 2 && std::strcmp(argv[1], "--replay") == 0;
+    const std::uint32_t duration_ms =
+        argc > 1 && !replay ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10'000;
+
+    std::vector<std::uint8_t> trace_bytes;
+    hil::host::Trace trace;
+    if (replay) {
+        if (!read_file(argv[2], trace_bytes)) {
+            return 1;
+        }
+        const Status status = hil::host::decode_trace({trace_bytes.data(), trace_bytes.size()}, trace);
+        if (status != Status::ok) {
+            std::fprintf(stderr, "%s: %s\n", argv[2], to_string(status));
+            return 1;
+        }
+    }
+
+    platform::host::reset();
+    platform::system_init();
+
+    app::Application application;
+    static std::uint8_t console_rx[2048];
+    static std::uint8_t console_tx[2048];
+    uart::Uart console(uart::vcp_port(), console_rx, console_tx);
+    static net::StaticPacketPool<24> packets;
+    static net::DescriptorRing<8> eth_rx;
+    static net::DescriptorRing<8> eth_tx;
+    static net::Ethernet ethernet(net::board_ethernet_port(), packets, eth_rx, eth_tx);
+    static net::UdpStack network(ethernet, packets,
+                                 {net::board_mac_address(), app::Config{}.ip_address});
+    Services services{&application, &console, &network};
+
+    boot::BootSequence sequence;
+    sequence.add({"board", init_board});
+    sequence.add({"console", start_console, &services, boot::Urgency::deferred, {"board"}});
+    sequence.add({"network", start_network, &services, boot::Urgency::deferred, {"board"}});
+    (void)sequence.run_critical();
+
+    application.init(platform::millis());
+    application.poll(platform::millis());
+    platform::mark_boot_phase(platform::BootPhase::first_cycle_done);
+    if (replay) {
+        // Finish booting first so only the recorded input is measured.
+        while (!sequence.finished()) {
+            sequence.run_deferred();
+            application.poll(platform::millis());
+            platform::host::advance_ms(1);
+        }
+        perf::reset_probes();
+        hil::host::Player player(trace);
+        player.readdress_frames(net::board_mac_address());
+        for (std::uint32_t ms = 0; !player.done(); ++ms) {
+            while (player.deliver_next(ms)) {
+                application.poll(platform::millis());
+            }
+            application.poll(platform::millis());
+            platform::host::advance_ms(1);
+        }
+        const hil::host::PlayerStats& s = player.stats();
+        std::printf("replayed %zu events over %u ms (%u dropped while recording)\n", trace.events.size(),
+                    player.duration_ms(), trace.dropped);
+        std::printf("  adc blocks %u (%u not matching the scan sequence), uart %u chunks / %u bytes, "
+                    "eth %u frames (%u missed), gpio %u edges\n",
+                    s.adc_blocks, s.adc_mismatched, s.uart_chunks, s.uart_bytes, s.eth_frames, s.eth_missed,
+                    s.gpio_edges);
+        std::printf("  %u COBS frames echoed, %u datagrams echoed, %u button presses\n\n",
+                    application.frames_echoed(), application.datagrams_echoed(), application.button_presses());
+        std::fputs(hil::host::format_stage_latency().c_str(), stdout);
+        return 0;
+    }
+    while (platform::millis() < duration_ms) {
+        sequence.run_deferred();
+        application.poll(platform::millis());
+        platform::host::advance_ms(1);
+    }
+
+    std::printf("ran %u ms: %u heartbeats, green LED transitions %u, %u datagrams echoed\n",
+                duration_ms, application.heartbeat_count(),
+                platform::host::led_transitions(platform::Led::green), application.datagrams_echoed());
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Top-level application logic shared by the firmware image and the host build.
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "nucleo/hil/recorder.hpp"
+#include "nucleo/net/udp.hpp"
+#include "nucleo/uart/cobs.hpp"
+#include "nucleo/uart/uart.hpp"
+
+namespace nucleo::app {
+
+struct Config {
+    /// Green LED toggles every half period.
+    std::uint32_t heartbeat_period_ms = 1000;
+    /// User button must read stable for this long before it is acted on.
+    std::uint32_t debounce_ms = 20;
+    /// Line rate of the ST-LINK VCP console.
+    std::uint32_t console_baud = 921'600;
+    /// Static address of the Ethernet interface.
+    net::Ipv4Address ip_address = net::ipv4(192, 168, 1, 50);
+    /// Datagrams to this UDP port are echoed back in place (RFC 862).
+    std::uint16_t udp_echo_port = 7;
+};
+
+/// Super-loop application. poll() is non-blocking and is called from main()
+/// as often as possible with the current millisecond tick.
+class Application {
+public:
+    explicit Application(const Config& config = {});
+
+    /// Turns all LEDs off and schedules the first heartbeat at `now_ms`.
+    void init(std::uint32_t now_ms);
+    void poll(std::uint32_t now_ms);
+
+    /// Connects the serial console. Every COBS frame received on it is
+    /// echoed back, which lets a host measure link round-trip time. A user
+    /// button press sends a profiling snapshot (see nucleo-perfdump --cobs).
+    void attach_console(uart::Uart& console);
+
+    /// Connects the network stack; started by the caller.
+    void attach_network(net::UdpStack& network) { network_ = &network; }
+
+    /// Records console bytes and user button edges as the application sees
+    /// them, for replay in the host build (nucleo/hil/host/replay.hpp).
+    /// Ethernet frames are recorded by an Ethernet receive tap. The recorder
+    /// stays idle until the console frame "NHIL" 0x01 starts a trace (again
+    /// after a full one); "NHIL" 0x00 ends it. Both are echoed like any
+    /// other frame. Its clock must count milliseconds, like poll()'s tick.
+    void attach_recorder(hil::Recorder& recorder) { recorder_ = &recorder; }
+
+    std::uint32_t heartbeat_count() const { return heartbeat_count_; }
+    std::uint32_t button_presses() const { return button_presses_; }
+    std::uint32_t frames_echoed() const { return frames_echoed_; }
+    /// Frames not echoed because the transmit ring could not take all of it.
+    std::uint32_t frames_dropped() const { return frames_dropped_; }
+    std::uint32_t snapshots_sent() const { return snapshots_sent_; }
+    std::uint32_t datagrams_echoed() const { return datagrams_echoed_; }
+
+private:
+    void update_heartbeat(std::uint32_t now_ms);
+    void update_button(std::uint32_t now_ms);
+    void service_console();
+    void service_network();
+    void send_snapshot(std::uint32_t now_ms);
+    void control_recorder(ConstByteSpan frame);
+
+    static constexpr std::size_t kMaxFrame = 256;
+    static constexpr std::size_t kMaxSnapshot = 1024;
+
+    Config config_;
+    std::uint32_t next_heartbeat_ms_ = 0;
+    std::uint32_t heartbeat_count_ = 0;
+    std::uint32_t button_changed_ms_ = 0;
+    std::uint32_t button_presses_ = 0;
+    bool button_raw_ = false;
+    bool button_stable_ = false;
+
+    uart::Uart* console_ = nullptr;
+    std::array<std::uint8_t, kMaxFrame> rx_frame_{};
+    std::array<std::uint8_t, kMaxSnapshot> snapshot_{};
+    std::array<std::uint8_t, uart::cobs_encoded_size_max(kMaxSnapshot)> tx_frame_{};
+    uart::CobsDecoder decoder_{rx_frame_};
+    std::uint32_t frames_echoed_ = 0;
+    std::uint32_t frames_dropped_ = 0;
+    std::uint32_t snapshots_sent_ = 0;
+
+    net::UdpStack* network_ = nullptr;
+    std::uint32_t datagrams_echoed_ = 0;
+
+    hil::Recorder* recorder_ = nullptr;
+};
+
+}  // namespace nucleo::app
@@ -0,0 +1,142 @@
+#include "nucleo/app/application.hpp"
+
+#include <cstring>
+
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/platform/board.hpp"
+
+namespace nucleo::app {
+
+using platform::Led;
+
+Application::Application(const Config& config) : config_(config) {}
+
+void Application::init(std::uint32_t now_ms) {
+    next_heartbeat_ms_ = now_ms;
+    button_changed_ms_ = now_ms;
+    platform::led_write(Led::green, false);
+    platform::led_write(Led::yellow, false);
+    platform::led_write(Led::red, false);
+}
+
+void Application::poll(std::uint32_t now_ms) {
+    NUCLEO_PROBE("app.poll");
+    update_heartbeat(now_ms);
+    update_button(now_ms);
+    service_console();
+    service_network();
+}
+
+void Application::attach_console(uart::Uart& console) {
+    console_ = &console;
+    decoder_.reset();
+}
+
+void Application::service_console() {
+    if (console_ == nullptr) {
+        return;
+    }
+    NUCLEO_PROBE("app.console");
+    const uart::RxDrain drained = console_->rx_drain([&](ConstByteSpan bytes) {
+        if (recorder_ != nullptr) {
+            recorder_->uart_rx(bytes);
+        }
+        decoder_.feed(bytes, [&](ConstByteSpan frame) {
+            control_recorder(frame);
+            // A partial frame would go out without its delimiter and cost
+            // the host this frame and the next, so drop it whole instead.
+            const std::size_t n = uart::cobs_encode(frame, tx_frame_);
+            if (console_->tx_free() < n) {
+                ++frames_dropped_;
+                return;
+            }
+            console_->write(ConstByteSpan{tx_frame_.data(), n});
+            ++frames_echoed_;
+        });
+    });
+    if (drained.overrun) {
+        // Lost bytes: a partial frame would otherwise be merged with
+        // whatever arrives next.
+        decoder_.reset();
+    }
+}
+
+void Application::control_recorder(ConstByteSpan frame) {
+    if (recorder_ == nullptr || frame.size() != sizeof hil::kTraceMagic + 1 ||
+        std::memcmp(frame.data(), hil::kTraceMagic, sizeof hil::kTraceMagic) != 0) {
+        return;
+    }
+    switch (frame[sizeof hil::kTraceMagic]) {
+    case 0:
+        recorder_->stop();
+        break;
+    case 1:
+        recorder_->start(1000);
+        break;
+    default:
+        break;
+    }
+}
+
+void Application::service_network() {
+    if (network_ == nullptr) {
+        return;
+    }
+    NUCLEO_PROBE("app.network");
+    network_->poll([&](net::Datagram& datagram) {
+        if (datagram.port == config_.udp_echo_port &&
+            network_->reply(datagram, datagram.payload.size()) == Status::ok) {
+            ++datagrams_echoed_;
+        }
+    });
+}
+
+void Application::update_heartbeat(std::uint32_t now_ms) {
+    // Signed difference keeps the comparison correct across tick wrap.
+    if (static_cast<std::int32_t>(now_ms - next_heartbeat_ms_) < 0) {
+        return;
+    }
+    platform::led_toggle(Led::green);
+    ++heartbeat_count_;
+    next_heartbeat_ms_ = now_ms + config_.heartbeat_period_ms / 2;
+}
+
+void Application::update_button(std::uint32_t now_ms) {
+    const bool raw = platform::user_button_pressed();
+    if (raw != button_raw_) {
+        if (recorder_ != nullptr) {
+            recorder_->gpio_edge(hil::Line::user_button, raw);
+        }
+        button_raw_ = raw;
+        button_changed_ms_ = now_ms;
+        return;
+    }
+    if (raw == button_stable_ || now_ms - button_changed_ms_ < config_.debounce_ms) {
+        return;
+    }
+    button_stable_ = raw;
+    platform::led_write(Led::red, raw);
+    if (raw) {
+        ++button_presses_;
+        send_snapshot(now_ms);
+    }
+}
+
+void Application::send_snapshot(std::uint32_t now_ms) {
+    if (console_ == nullptr) {
+        return;
+    }
+    const std::size_t size = perf::write_snapshot(snapshot_, now_ms);
+    if (size == 0) {
+        return;
+    }
+    const std::size_t n = uart::cobs_encode(ConstByteSpan{snapshot_.data(), size}, tx_frame_);
+    if (console_->tx_free() < n) {
+        return;
+    }
+    console_->write(ConstByteSpan{tx_frame_.data(), n});
+    ++snapshots_sent_;
+}
+
+}  // namespace nucleo::app
@@ -0,0 +1,104 @@
+// Firmware entry point.
+#include "nucleo/app/application.hpp"
+#include "nucleo/boot/sequence.hpp"
+#include "nucleo/hil/recorder.hpp"
+#include "nucleo/memory/placement.hpp"
+#include "nucleo/net/board_eth.hpp"
+#include "nucleo/net/udp.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/platform/board.hpp"
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/irq.hpp"
+#include "nucleo/uart/uart.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+namespace {
+
+// Everything a DMA channel reads or writes lives in SRAM3, away from the
+// CPU's stack and data traffic in SRAM1 (checked by stm32h5/layout.budget).
+NUCLEO_DMA_BUFFER std::uint8_t g_console_rx[2048];
+NUCLEO_DMA_BUFFER std::uint8_t g_console_tx[2048];
+NUCLEO_DMA_BUFFER nucleo::net::PacketStorage<32> g_packet_storage;
+NUCLEO_DMA_BUFFER nucleo::net::DescriptorRing<12> g_eth_rx;
+NUCLEO_DMA_BUFFER nucleo::net::DescriptorRing<12> g_eth_tx;
+
+// Input trace for host replay (nucleo/hil/recorder.hpp), read out with the
+// debugger. Not touched by DMA; it goes in SRAM3 because it would not fit
+// the 64K SRAM1 budget (stm32h5/layout.budget), not because SRAM1 is full.
+NUCLEO_SRAM3_BSS std::uint8_t g_hil_storage[64 * 1024];
+
+// What the deferred boot steps start and hand to the application.
+struct Services {
+    nucleo::app::Application* application;
+    nucleo::uart::Uart* console;
+    nucleo::net::UdpStack* network;
+};
+
+nucleo::Status init_board(void*) {
+    nucleo::platform::board_init();
+    nucleo::perf::cycle_counter_init();
+    return nucleo::Status::ok;
+}
+
+nucleo::Status start_console(void* context) {
+    Services& s = *static_cast<Services*>(context);
+    const nucleo::Status status = s.console->start(nucleo::app::Config{}.console_baud);
+    if (status == nucleo::Status::ok) {
+        s.application->attach_console(*s.console);
+    }
+    return status;
+}
+
+nucleo::Status start_network(void* context) {
+    Services& s = *static_cast<Services*>(context);
+    const nucleo::Status status = s.network->start();
+    if (status == nucleo::Status::ok) {
+        s.application->attach_network(*s.network);
+    }
+    return status;
+}
+
+}  // namespace
+
+int main() {
+    using namespace nucleo;
+    // PLL1 and the cache are already up (see the reset handler); this adds
+    // the SysTick.
+    platform::system_init();
+
+    app::Application application;
+    static uart::Uart console(uart::vcp_port(), g_console_rx, g_console_tx);
+    static memory::BlockPool packet_blocks(g_packet_storage);
+    static net::PacketPool packets(packet_blocks);
+    static net::Ethernet ethernet(net::board_ethernet_port(), packets, g_eth_rx, g_eth_tx);
+    static net::UdpStack network(ethernet, packets,
+                                 {net::board_mac_address(), app::Config{}.ip_address});
+    static Services services{&application, &console, &network};
+
+    // Idle until a console command starts a trace (Application::attach_recorder);
+    // until then each input costs the recorder one load.
+    static hil::Recorder recorder(g_hil_storage, platform::millis);
+    application.attach_recorder(recorder);
+    ethernet.set_rx_tap([](void* r, ConstByteSpan frame) { static_cast<hil::Recorder*>(r)->eth_rx(frame); },
+                        &recorder);
+
+    // Only the board I/O stands between reset and the first control cycle;
+    // the console and the Ethernet MAC/PHY come up one per loop pass after it.
+    static boot::BootSequence sequence;
+    sequence.add({"board", init_board});
+    sequence.add({"console", start_console, &services, boot::Urgency::deferred, {"board"}});
+    sequence.add({"network", start_network, &services, boot::Urgency::deferred, {"board"}});
+    (void)sequence.run_critical();
+
+    application.init(platform::millis());
+    application.poll(platform::millis());
+    platform::mark_boot_phase(platform::BootPhase::first_cycle_done);
+    for (;;) {
+        if (sequence.run_deferred() && sequence.finished()) {
+            boot::publish_probes(sequence);
+        }
+        application.poll(platform::millis());
+        platform::wait_for_interrupt();
+    }
+}
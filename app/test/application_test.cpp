@@ -0,0 +1,348 @@
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "nucleo/app/application.hpp"
+#include "nucleo/hil/host/replay.hpp"
+#include "nucleo/net/host/sim_ethernet.hpp"
+#include "nucleo/platform/board.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/host/sim_uart.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+using namespace nucleo;
+using platform::Led;
+
+namespace {
+
+void run_for(app::Application& application, std::uint32_t start_ms, std::uint32_t ms) {
+    for (std::uint32_t i = 0; i < ms; ++i) {
+        application.poll(start_ms + i);
+    }
+}
+
+}  // namespace
+
+TEST(heartbeat_toggles_green_every_half_period) {
+    platform::host::reset();
+    app::Application application({/*heartbeat_period_ms=*/100, /*debounce_ms=*/20});
+    application.init(0);
+    run_for(application, 0, 1000);
+    CHECK_EQ(application.heartbeat_count(), 20u);
+    CHECK_EQ(platform::host::led_transitions(Led::green), 20u);
+}
+
+TEST(heartbeat_survives_tick_wrap) {
+    platform::host::reset();
+    app::Application application({100, 20});
+    const std::uint32_t start = 0xFFFFFF00u;
+    application.init(start);
+    run_for(application, start, 512);
+    CHECK(application.heartbeat_count() >= 10u);
+    CHECK(application.heartbeat_count() <= 12u);
+}
+
+TEST(button_is_debounced) {
+    platform::host::reset();
+    app::Application application({1000, 20});
+    application.init(0);
+
+    // A 5 ms glitch is ignored.
+    platform::host::set_user_button(true);
+    run_for(application, 0, 5);
+    platform::host::set_user_button(false);
+    run_for(application, 5, 50);
+    CHECK_EQ(application.button_presses(), 0u);
+    CHECK(!platform::host::led_state(Led::red));
+
+    // A held press lights the red LED once it is stable.
+    platform::host::set_user_button(true);
+    run_for(application, 55, 50);
+    CHECK_EQ(application.button_presses(), 1u);
+    CHECK(platform::host::led_state(Led::red));
+
+    platform::host::set_user_button(false);
+    run_for(application, 105, 50);
+    CHECK(!platform::host::led_state(Led::red));
+}
+
+TEST(console_echoes_cobs_frames) {
+    platform::host::reset();
+    std::array<std::uint8_t, 256> rx{};
+    std::array<std::uint8_t, 256> tx{};
+    uart::host::SimUart sim;
+    uart::Uart console(sim, rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+
+    app::Application application;
+    application.attach_console(console);
+    application.init(0);
+
+    const std::uint8_t payload[] = {0x10, 0x00, 0x20, 0x30};
+    std::uint8_t encoded[uart::cobs_encoded_size_max(sizeof payload)];
+    const std::size_t n = uart::cobs_encode(payload, encoded);
+    sim.receive(ConstByteSpan{encoded, n});
+    application.poll(1);
+    sim.flush_tx();
+
+    CHECK_EQ(application.frames_echoed(), 1u);
+    CHECK(sim.transmitted() == std::vector<std::uint8_t>(encoded, encoded + n));
+}
+
+TEST(console_drops_frames_that_do_not_fit_whole) {
+    platform::host::reset();
+    std::array<std::uint8_t, 256> rx{};
+    std::array<std::uint8_t, 16> tx{};
+    uart::host::SimUart sim;
+    uart::Uart console(sim, rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+
+    app::Application application;
+    application.attach_console(console);
+    application.init(0);
+
+    // Two 11-byte frames in one poll: the second does not fit behind the
+    // first and must not be sent in part.
+    const std::uint8_t payload[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::uint8_t encoded[uart::cobs_encoded_size_max(sizeof payload)];
+    const std::size_t n = uart::cobs_encode(payload, encoded);
+    REQUIRE_EQ(n, 11u);
+    sim.receive(ConstByteSpan{encoded, n});
+    sim.receive(ConstByteSpan{encoded, n});
+    application.poll(1);
+    sim.flush_tx();
+
+    CHECK_EQ(application.frames_echoed(), 1u);
+    CHECK_EQ(application.frames_dropped(), 1u);
+    CHECK(sim.transmitted() == std::vector<std::uint8_t>(encoded, encoded + n));
+    CHECK_EQ(console.stats().tx_rejected_bytes, 0u);
+}
+
+TEST(console_overrun_drops_the_partial_frame) {
+    platform::host::reset();
+    std::array<std::uint8_t, 256> rx{};
+    std::array<std::uint8_t, 256> tx{};
+    uart::host::SimUart sim;
+    uart::Uart console(sim, rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+
+    app::Application application;
+    application.attach_console(console);
+    application.init(0);
+
+    const std::uint8_t payload[] = {0x10, 0x20, 0x30, 0x40};
+    std::uint8_t encoded[uart::cobs_encoded_size_max(sizeof payload)];
+    const std::size_t n = uart::cobs_encode(payload, encoded);
+
+    // Half a frame, then more than a lap of bytes the application never
+    // sees, then a whole frame.
+    sim.receive(ConstByteSpan{encoded, 2});
+    application.poll(1);
+    const std::vector<std::uint8_t> flood(300, 0x55);
+    sim.receive(ConstByteSpan{flood.data(), flood.size()});
+    application.poll(2);
+    sim.receive(ConstByteSpan{encoded, n});
+    application.poll(3);
+    sim.flush_tx();
+
+    CHECK_EQ(console.stats().rx_overruns, 1u);
+    CHECK_EQ(application.frames_echoed(), 1u);
+    CHECK(sim.transmitted() == std::vector<std::uint8_t>(encoded, encoded + n));
+}
+
+TEST(console_frames_start_and_stop_the_recorder) {
+    platform::host::reset();
+    std::array<std::uint8_t, 256> rx{};
+    std::array<std::uint8_t, 256> tx{};
+    uart::host::SimUart sim;
+    uart::Uart console(sim, rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+    std::array<std::uint8_t, 256> storage{};
+    hil::Recorder recorder(storage, platform::millis);
+
+    app::Application application;
+    application.attach_console(console);
+    application.attach_recorder(recorder);
+    application.init(0);
+
+    std::uint32_t now = 0;
+    const auto send = [&](std::initializer_list<std::uint8_t> payload) {
+        const std::vector<std::uint8_t> p(payload);
+        std::uint8_t encoded[uart::cobs_encoded_size_max(8)];
+        const std::size_t n = uart::cobs_encode(ConstByteSpan{p.data(), p.size()}, encoded);
+        sim.receive(ConstByteSpan{encoded, n});
+        application.poll(++now);
+        sim.flush_tx();
+    };
+
+    send({1, 2, 3});
+    CHECK(!recorder.recording());
+    send({'N', 'H', 'I', 'L', 1});
+    CHECK(recorder.recording());
+    CHECK_EQ(recorder.records(), 0u);  // arrived before the trace started
+    send({1, 2, 3});
+    send({'N', 'H', 'I', 'L', 0});
+    CHECK(!recorder.recording());
+    CHECK_EQ(recorder.records(), 2u);  // the frame and the stop command
+    send({1, 2, 3});
+    CHECK_EQ(recorder.records(), 2u);
+
+    // A new start discards the old trace.
+    send({'N', 'H', 'I', 'L', 1});
+    CHECK(recorder.recording());
+    CHECK_EQ(recorder.records(), 0u);
+    CHECK_EQ(application.frames_echoed(), 6u);  // commands are echoed too
+}
+
+TEST(button_press_sends_profiling_snapshot) {
+    platform::host::reset();
+    std::array<std::uint8_t, 256> rx{};
+    std::array<std::uint8_t, 2048> tx{};
+    uart::host::SimUart sim;
+    uart::Uart console(sim, rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+
+    app::Application application({1000, 20});
+    application.attach_console(console);
+    application.init(0);
+    run_for(application, 0, 10);
+    platform::host::set_user_button(true);
+    run_for(application, 10, 50);
+    sim.flush_tx();
+    REQUIRE_EQ(application.snapshots_sent(), 1u);
+
+    // One COBS frame whose payload starts with the snapshot magic.
+    const std::vector<std::uint8_t> wire = sim.transmitted();
+    REQUIRE(!wire.empty());
+    CHECK_EQ(wire.back(), 0u);
+    std::vector<std::uint8_t> decoded(wire.size());
+    const std::size_t n = uart::cobs_decode(ConstByteSpan{wire.data(), wire.size() - 1}, ByteSpan{decoded.data(), decoded.size()});
+    REQUIRE(n >= 4u);
+    CHECK_EQ(decoded[0], 'N');
+    CHECK_EQ(decoded[3], 'F');
+}
+
+namespace {
+
+struct NetNode {
+    explicit NetNode(net::Ipv4Address ip, std::uint8_t id)
+        : stack(eth, pool, {{{0x02, 0, 0, 0, 0, id}}, ip}) {}
+    net::host::SimEthernet sim;
+    net::StaticPacketPool<16> pool;
+    net::DescriptorRing<4> rx;
+    net::DescriptorRing<4> tx;
+    net::Ethernet eth{sim, pool, rx, tx};
+    net::UdpStack stack;
+};
+
+}  // namespace
+
+TEST(udp_echo_port_replies) {
+    platform::host::reset();
+    const app::Config config;
+    auto board = std::make_unique<NetNode>(config.ip_address, 1);
+    auto peer = std::make_unique<NetNode>(net::ipv4(192, 168, 1, 2), 2);
+    net::host::SimEthernet::connect(board->sim, peer->sim);
+    REQUIRE_EQ(board->stack.start(), Status::ok);
+    REQUIRE_EQ(peer->stack.start(), Status::ok);
+
+    app::Application application(config);
+    application.attach_network(board->stack);
+    application.init(0);
+
+    const std::uint8_t ping[] = {1, 2, 3};
+    const net::Endpoint echo{config.ip_address, config.udp_echo_port};
+    CHECK_EQ(peer->stack.send_to(echo, 4000, ping), Status::not_found);  // ARP first
+    application.poll(1);
+    peer->stack.poll([](net::Datagram&) {});
+    REQUIRE_EQ(peer->stack.send_to(echo, 4000, ping), Status::ok);
+    REQUIRE_EQ(peer->stack.send_to({config.ip_address, 9}, 4000, ping), Status::ok);  // not echoed
+    peer->stack.flush();
+    application.poll(2);
+
+    std::vector<std::uint8_t> got;
+    peer->stack.poll([&](net::Datagram& d) { got.assign(d.payload.begin(), d.payload.end()); });
+    CHECK_EQ(application.datagrams_echoed(), 1u);
+    CHECK(got == std::vector<std::uint8_t>(ping, ping + sizeof ping));
+}
+
+namespace {
+
+// Console frames and button presses at fixed virtual times, through the
+// board VCP so the host replay can feed the same port.
+struct ReplayRun {
+    std::uint32_t frames_echoed = 0;
+    std::uint32_t button_presses = 0;
+    std::uint32_t snapshots_sent = 0;
+};
+
+ReplayRun run_console_session(hil::Recorder* recorder, const hil::host::Trace* trace) {
+    platform::host::reset();
+    static std::array<std::uint8_t, 256> rx;
+    static std::array<std::uint8_t, 4096> tx;
+    uart::Uart console(uart::vcp_port(), rx, tx);
+    app::Application application({1000, 20});
+    application.attach_console(console);
+    if (recorder != nullptr) {
+        application.attach_recorder(*recorder);
+        recorder->start(1000);
+    }
+    if (console.start(921'600) != Status::ok) {
+        return {};
+    }
+    application.init(platform::millis());
+
+    const std::uint8_t payload[] = {0x10, 0x00, 0x20, 0x30};
+    std::uint8_t encoded[uart::cobs_encoded_size_max(sizeof payload)];
+    const std::size_t n = uart::cobs_encode(payload, encoded);
+    std::optional<hil::host::Player> player;
+    if (trace != nullptr) {
+        player.emplace(*trace);
+    }
+    for (std::uint32_t ms = 0; ms < 300; ++ms) {
+        if (player) {
+            while (player->deliver_next(ms)) {
+                application.poll(platform::millis());
+            }
+        } else {
+            if (ms % 40 == 3) {
+                uart::host::vcp_sim().receive(ConstByteSpan{encoded, n});
+            }
+            if (ms == 50 || ms == 200) {
+                platform::host::set_user_button(true);
+            }
+            if (ms == 120 || ms == 205) {
+                platform::host::set_user_button(false);  // the second press is a glitch
+            }
+        }
+        application.poll(platform::millis());
+        uart::host::vcp_sim().flush_tx();
+        platform::host::advance_ms(1);
+    }
+    return {application.frames_echoed(), application.button_presses(), application.snapshots_sent()};
+}
+
+}  // namespace
+
+TEST(recorded_session_replays_identically) {
+    std::array<std::uint8_t, 1024> storage{};
+    hil::Recorder recorder(storage, platform::millis);
+    const ReplayRun live = run_console_session(&recorder, nullptr);
+    CHECK_EQ(live.frames_echoed, 8u);
+    CHECK_EQ(live.button_presses, 1u);
+    CHECK_EQ(recorder.dropped(), 0u);
+
+    hil::host::Trace trace;
+    REQUIRE_EQ(hil::host::decode_trace(recorder.trace(), trace), Status::ok);
+    CHECK_EQ(trace.events.size(), 12u);  // 8 console chunks and 4 button edges
+    for (int i = 0; i < 2; ++i) {
+        const ReplayRun replayed = run_console_session(nullptr, &trace);
+        CHECK_EQ(replayed.frames_echoed, live.frames_echoed);
+        CHECK_EQ(replayed.button_presses, live.button_presses);
+        CHECK_EQ(replayed.snapshots_sent, live.snapshots_sent);
+    }
+}
@@ -0,0 +1,28 @@
+# Post-link layout step for the firmware, run as a script:
+#
+#   cmake -DNM=<nm> -DELF=<elf> -DMAP=<map> -DBUDGET=<file> [-DTOOL=<nucleo-layout>] -P NucleoLayout.cmake
+#
+# Writes the `nm -S -C` symbol listing next to the map (<name>.sym). With
+# TOOL (a host build's tools/layout/nucleo-layout) it also writes the
+# placement report (<name>.layout.txt) and fails the build on any budget
+# violation.
+get_filename_component(_dir ${MAP} DIRECTORY)
+get_filename_component(_stem ${MAP} NAME_WE)
+set(_symbols ${_dir}/${_stem}.sym)
+
+execute_process(
+  COMMAND ${NM} -S -C -n ${ELF}
+  OUTPUT_FILE ${_symbols}
+  RESULT_VARIABLE _result)
+if(NOT _result EQUAL 0)
+  message(FATAL_ERROR "${NM} failed on ${ELF}")
+endif()
+
+if(TOOL)
+  execute_process(
+    COMMAND ${TOOL} ${MAP} --symbols ${_symbols} --budget ${BUDGET} --output ${_dir}/${_stem}.layout.txt
+    RESULT_VARIABLE _result)
+  if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "${ELF} is over its memory budget (${BUDGET}); see ${_dir}/${_stem}.layout.txt")
+  endif()
+endif()
@@ -0,0 +1,70 @@
+# Helpers shared by every module under modules/.
+#
+# A module is one static library with a public include/ directory, portable
+# sources, and per-platform sources that are picked by NUCLEO_PLATFORM:
+#
+#   nucleo_add_module(uart
+#     SOURCES         src/ring.cpp
+#     HOST_SOURCES    host/sim_uart.cpp
+#     STM32H5_SOURCES stm32h5/uart_gpdma.cpp
+#     DEPENDS         nucleo::platform)
+#
+# creates target nucleo_uart with alias nucleo::uart.
+
+add_library(nucleo_options INTERFACE)
+add_library(nucleo::options ALIAS nucleo_options)
+target_compile_options(nucleo_options INTERFACE
+  -Wall -Wextra -Wshadow
+  $<$<COMPILE_LANGUAGE:CXX>:-Wnon-virtual-dtor>)
+if(NUCLEO_PLATFORM STREQUAL stm32h5)
+  target_compile_definitions(nucleo_options INTERFACE NUCLEO_PLATFORM_STM32H5=1)
+else()
+  target_compile_definitions(nucleo_options INTERFACE NUCLEO_PLATFORM_HOST=1)
+endif()
+
+function(nucleo_add_module name)
+  cmake_parse_arguments(ARG "" "" "SOURCES;HOST_SOURCES;STM32H5_SOURCES;DEPENDS" ${ARGN})
+  set(target nucleo_${name})
+  set(sources ${ARG_SOURCES})
+  if(NUCLEO_PLATFORM STREQUAL host)
+    list(APPEND sources ${ARG_HOST_SOURCES})
+  else()
+    list(APPEND sources ${ARG_STM32H5_SOURCES})
+  endif()
+
+  if(sources)
+    add_library(${target} STATIC ${sources})
+    target_include_directories(${target} PUBLIC ${CMAKE_CURRENT_SOURCE_DIR}/include)
+    target_link_libraries(${target} PUBLIC nucleo::options ${ARG_DEPENDS})
+  else()
+    add_library(${target} INTERFACE)
+    target_include_directories(${target} INTERFACE ${CMAKE_CURRENT_SOURCE_DIR}/include)
+    target_link_libraries(${target} INTERFACE nucleo::options ${ARG_DEPENDS})
+  endif()
+  add_library(nucleo::${name} ALIAS ${target})
+endfunction()
+
+# Host-only unit test executable, registered with CTest under label "unit".
+function(nucleo_add_test name)
+  if(NOT NUCLEO_BUILD_TESTS)
+    return()
+  endif()
+  cmake_parse_arguments(ARG "" "" "SOURCES;DEPENDS" ${ARGN})
+  add_executable(${name} ${ARG_SOURCES})
+  target_link_libraries(${name} PRIVATE nucleo::options nucleo::testkit_main ${ARG_DEPENDS})
+  add_test(NAME ${name} COMMAND ${name})
+  set_tests_properties(${name} PROPERTIES LABELS unit TIMEOUT 120)
+endfunction()
+
+# Host-only benchmark executable. CTest runs it with --quick as a smoke test
+# (label "bench"); run the binary directly for full-length measurements.
+function(nucleo_add_benchmark name)
+  if(NOT NUCLEO_BUILD_BENCHMARKS)
+    return()
+  endif()
+  cmake_parse_arguments(ARG "" "" "SOURCES;DEPENDS" ${ARGN})
+  add_executable(${name} ${ARG_SOURCES})
+  target_link_libraries(${name} PRIVATE nucleo::options nucleo::testkit ${ARG_DEPENDS})
+  add_test(NAME ${name} COMMAND ${name} --quick)
+  set_tests_properties(${name} PROPERTIES LABELS bench TIMEOUT 300)
+endfunction()
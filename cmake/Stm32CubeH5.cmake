@@ -0,0 +1,20 @@
+# Locates the CMSIS headers of an STM32CubeH5 firmware package.
+#
+# The drivers in this tree are written against the CMSIS device header only
+# (register level), so the HAL sources from the package are not compiled.
+
+set(STM32CUBE_H5_DIR "$ENV{STM32CUBE_H5_DIR}" CACHE PATH "Root of an STM32CubeH5 firmware package")
+
+set(_cmsis_device_dir ${STM32CUBE_H5_DIR}/Drivers/CMSIS/Device/ST/STM32H5xx/Include)
+set(_cmsis_core_dir   ${STM32CUBE_H5_DIR}/Drivers/CMSIS/Core/Include)
+
+if(NOT EXISTS ${_cmsis_device_dir}/stm32h5xx.h)
+  message(FATAL_ERROR
+    "STM32CubeH5 not found. Set STM32CUBE_H5_DIR (cache or environment) to the "
+    "root of the STM32CubeH5 package (expected ${_cmsis_device_dir}/stm32h5xx.h).")
+endif()
+
+add_library(stm32cube_cmsis INTERFACE)
+add_library(stm32cube::cmsis ALIAS stm32cube_cmsis)
+target_include_directories(stm32cube_cmsis SYSTEM INTERFACE ${_cmsis_core_dir} ${_cmsis_device_dir})
+target_compile_definitions(stm32cube_cmsis INTERFACE STM32H563xx)
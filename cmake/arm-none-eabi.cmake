@@ -0,0 +1,30 @@
+# Toolchain file for the STM32H563ZI (Cortex-M33, single-precision FPU).
+#
+#   cmake -S . -B build-fw -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake \
+#         -DSTM32CUBE_H5_DIR=/path/to/STM32CubeH5
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR cortex-m33)
+
+set(NUCLEO_TOOLCHAIN_PREFIX "arm-none-eabi-" CACHE STRING "GNU Arm toolchain prefix")
+
+set(CMAKE_C_COMPILER   ${NUCLEO_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_CXX_COMPILER ${NUCLEO_TOOLCHAIN_PREFIX}g++)
+set(CMAKE_ASM_COMPILER ${NUCLEO_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_OBJCOPY      ${NUCLEO_TOOLCHAIN_PREFIX}objcopy CACHE FILEPATH "")
+set(CMAKE_SIZE         ${NUCLEO_TOOLCHAIN_PREFIX}size CACHE FILEPATH "")
+set(CMAKE_NM           ${NUCLEO_TOOLCHAIN_PREFIX}nm CACHE FILEPATH "")
+
+# The compiler checks cannot link without a linker script.
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(NUCLEO_CPU_FLAGS "-mcpu=cortex-m33 -mthumb -mfpu=fpv5-sp-d16 -mfloat-abi=hard")
+
+set(CMAKE_C_FLAGS_INIT   "${NUCLEO_CPU_FLAGS} -ffunction-sections -fdata-sections")
+set(CMAKE_CXX_FLAGS_INIT "${NUCLEO_CPU_FLAGS} -ffunction-sections -fdata-sections -fno-exceptions -fno-rtti -fno-threadsafe-statics -fno-use-cxa-atexit")
+set(CMAKE_ASM_FLAGS_INIT "${NUCLEO_CPU_FLAGS} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${NUCLEO_CPU_FLAGS} -specs=nano.specs -specs=nosys.specs -Wl,--gc-sections -Wl,--print-memory-usage")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
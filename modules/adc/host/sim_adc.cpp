@@ -0,0 +1,132 @@
+#include "nucleo/adc/host/sim_adc.hpp"
+
+#include <cmath>
+
+#include "nucleo/adc/board_adc.hpp"
+#include "nucleo/platform/host/sim.hpp"
+
+namespace nucleo::adc {
+namespace host {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+}  // namespace
+
+std::uint16_t Waveform::sample(double t, double noise) const {
+    double cycle = frequency_hz * t + phase;
+    cycle -= std::floor(cycle);
+    double unit = 0;  // -1..1
+    switch (shape) {
+        case Shape::dc:
+            break;
+        case Shape::sine:
+            unit = std::sin(2 * kPi * cycle);
+            break;
+        case Shape::square:
+            unit = cycle < 0.5 ? 1.0 : -1.0;
+            break;
+        case Shape::triangle:
+            unit = cycle < 0.5 ? 4 * cycle - 1 : 3 - 4 * cycle;
+            break;
+        case Shape::noise:
+            unit = noise;
+            break;
+    }
+    const double code = std::round(offset + amplitude * unit);
+    return static_cast<std::uint16_t>(code < 0 ? 0 : code > kFullScale ? kFullScale : code);
+}
+
+Status SimAdc::start(Acquisition& owner, const AdcConfig& config, Span<std::uint16_t> buffer) {
+    owner_ = &owner;
+    buffer_ = buffer;
+    channels_ = config.channels.size();
+    sample_rate_hz_ = config.sample_rate_hz;
+    dma_index_ = 0;
+    frame_count_ = 0;
+    elapsed_s_ = 0;
+    running_ = true;
+    return Status::ok;
+}
+
+void SimAdc::set_waveform(std::size_t index, const Waveform& waveform) {
+    if (index < kMaxChannels) {
+        waveforms_[index] = waveform;
+    }
+}
+
+double SimAdc::next_noise() {
+    noise_state_ = noise_state_ * 1664525u + 1013904223u;
+    return static_cast<double>(noise_state_ >> 8) / static_cast<double>(1u << 23) - 1.0;
+}
+
+void SimAdc::run_frames(std::size_t frames) {
+    if (!running_ || owner_ == nullptr) {
+        return;
+    }
+    for (std::size_t f = 0; f < frames; ++f) {
+        const double t = now_s();
+        for (std::size_t c = 0; c < channels_; ++c) {
+            const Waveform& w = waveforms_[c];
+            buffer_[dma_index_++] = w.sample(t, w.shape == Waveform::Shape::noise ? next_noise() : 0);
+        }
+        end_frame();
+    }
+}
+
+void SimAdc::run_samples(const std::uint16_t* samples, std::size_t frames) {
+    if (!running_ || owner_ == nullptr) {
+        return;
+    }
+    for (std::size_t f = 0; f < frames; ++f) {
+        for (std::size_t c = 0; c < channels_; ++c) {
+            buffer_[dma_index_++] = *samples++;
+        }
+        end_frame();
+    }
+}
+
+void SimAdc::end_frame() {
+    ++frame_count_;
+    const std::size_t size = buffer_.size();
+    const std::size_t half = size / 2;
+    if (dma_index_ == half || dma_index_ == size) {
+        const std::size_t completed = dma_index_ == half ? 0 : 1;
+        if (dma_index_ == size) {
+            dma_index_ = 0;
+        }
+        platform::host::IsrScope isr;
+        owner_->isr_block_complete(completed);
+    }
+}
+
+void SimAdc::run_for(double seconds) {
+    // Track total elapsed time rather than a fractional remainder so many
+    // small steps do not drift.
+    elapsed_s_ += seconds;
+    const auto due = static_cast<std::uint64_t>(elapsed_s_ * sample_rate_hz_ + 1e-6);
+    if (due > frame_count_) {
+        run_frames(static_cast<std::size_t>(due - frame_count_));
+    }
+}
+
+void SimAdc::inject_adc_overrun() {
+    platform::host::IsrScope isr;
+    owner_->isr_adc_overrun();
+}
+
+void SimAdc::inject_dma_error() {
+    platform::host::IsrScope isr;
+    owner_->isr_dma_error();
+}
+
+SimAdc& board_adc_sim() {
+    static SimAdc sim;
+    return sim;
+}
+
+}  // namespace host
+
+AdcPort& board_adc_port() { return host::board_adc_sim(); }
+
+}  // namespace nucleo::adc
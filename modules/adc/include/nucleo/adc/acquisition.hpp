@@ -0,0 +1,129 @@
+// Double-buffered ADC acquisition.
+//
+// A hardware timer triggers one scan of the channel sequence per sample
+// period and the DMA streams the results, interleaved frame by frame, into
+// a buffer split in two blocks. While the DMA fills one block the
+// application processes the other in place, so there is one interrupt per
+// block and none per sample.
+//
+//   std::uint16_t buffer[2 * 64 * 4];
+//   adc::Acquisition acq(adc::board_adc_port(), buffer);
+//   acq.start({48'000, channels, 64});
+//   acq.poll([](const adc::Block& b) { filter(b); });      // main loop
+//
+// Processing of a block must finish within one block period, before the
+// DMA completes the other half and moves back into it. Overruns are
+// counted, not prevented: a block the consumer never reached in time is
+// dropped, and a block still being processed when the next one completes
+// is reported as a processing overrun.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "nucleo/adc/port.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::adc {
+
+/// One block of interleaved frames, in place in the DMA buffer.
+struct Block {
+    const std::uint16_t* samples = nullptr;
+    std::size_t frames = 0;
+    std::size_t channels = 0;
+    /// Blocks completed before this one since start().
+    std::uint32_t sequence = 0;
+    /// perf::cycles() when the last frame landed.
+    std::uint32_t ready_tick = 0;
+
+    std::uint16_t at(std::size_t frame, std::size_t channel) const { return samples[frame * channels + channel]; }
+};
+
+struct AcquisitionStats {
+    std::uint32_t blocks_completed = 0;
+    std::uint32_t blocks_processed = 0;
+    /// Completed blocks that were overwritten before processing began.
+    std::uint32_t blocks_dropped = 0;
+    /// Blocks the DMA began overwriting while they were being processed.
+    std::uint32_t processing_overruns = 0;
+    /// Conversions lost because the DMA did not read the ADC in time.
+    std::uint32_t adc_overruns = 0;
+    std::uint32_t dma_errors = 0;
+    /// Longest time from block completion to the end of its processing.
+    std::uint32_t max_latency_ticks = 0;
+};
+
+class Acquisition {
+public:
+    using Notify = void (*)(void* context, std::uint32_t sequence);
+
+    /// `buffer` must hold at least two blocks of the largest configuration
+    /// started and be reachable by the DMA controller.
+    Acquisition(AdcPort& port, Span<std::uint16_t> buffer);
+
+    /// invalid_argument for an empty or oversized channel list, a zero rate
+    /// or block size, or a buffer too small for two blocks.
+    Status start(const AdcConfig& config);
+    void stop();
+
+    /// Called from the block interrupt after each completed block, e.g. to
+    /// post a scheduler event. Set before start().
+    void set_notify(Notify notify, void* context) {
+        notify_ = notify;
+        notify_context_ = context;
+    }
+
+    /// Passes each ready block, oldest first, to fn(const Block&) and
+    /// releases it. Stale blocks are skipped so processing never falls more
+    /// than one block behind. Returns the number of blocks processed.
+    template <typename Fn>
+    std::size_t poll(Fn&& fn, std::size_t budget = SIZE_MAX) {
+        std::size_t count = 0;
+        Block block;
+        while (count < budget && next_block(block)) {
+            fn(static_cast<const Block&>(block));
+            finish_block(block);
+            ++count;
+        }
+        return count;
+    }
+
+    bool block_ready() const { return completed_.load(std::memory_order_acquire) != consumed_; }
+    std::size_t block_samples() const { return block_samples_; }
+    AcquisitionStats stats() const;
+    void reset_stats();
+
+    // ---- interrupt side, called by the port ----
+
+    void isr_block_complete(std::size_t half);
+    void isr_adc_overrun() { adc_overruns_.fetch_add(1, std::memory_order_relaxed); }
+    void isr_dma_error() { dma_errors_.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    bool next_block(Block& block);
+    void finish_block(const Block& block);
+
+    AdcPort& port_;
+    Span<std::uint16_t> buffer_;
+    std::size_t frames_ = 0;
+    std::size_t channels_ = 0;
+    std::size_t block_samples_ = 0;
+    Notify notify_ = nullptr;
+    void* notify_context_ = nullptr;
+
+    // Written by the interrupt.
+    std::atomic<std::uint32_t> completed_{0};
+    std::uint32_t ready_tick_[2] = {};
+    std::atomic<std::uint32_t> adc_overruns_{0};
+    std::atomic<std::uint32_t> dma_errors_{0};
+
+    // Thread side.
+    std::uint32_t consumed_ = 0;
+    std::uint32_t processed_ = 0;
+    std::uint32_t dropped_ = 0;
+    std::uint32_t processing_overruns_ = 0;
+    std::uint32_t max_latency_ = 0;
+};
+
+}  // namespace nucleo::adc
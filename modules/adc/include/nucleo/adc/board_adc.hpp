@@ -0,0 +1,12 @@
+// The board's analog inputs (ADC1, triggered by TIM6).
+#pragma once
+
+#include "nucleo/adc/port.hpp"
+
+namespace nucleo::adc {
+
+/// ADC1 + TIM6 + GPDMA1 channel 4 on the target; the SimAdc returned by
+/// host::board_adc_sim() on the host.
+AdcPort& board_adc_port();
+
+}  // namespace nucleo::adc
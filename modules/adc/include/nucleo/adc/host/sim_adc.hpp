@@ -0,0 +1,84 @@
+// Simulated ADC with circular-DMA semantics and synthetic inputs (host only).
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/adc/acquisition.hpp"
+#include "nucleo/adc/port.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/adc/host/sim_adc.hpp is only available in host builds"
+#endif
+
+namespace nucleo::adc::host {
+
+/// 12-bit converter: codes 0..kFullScale.
+inline constexpr std::uint16_t kFullScale = 4095;
+
+struct Waveform {
+    enum class Shape : std::uint8_t { dc, sine, square, triangle, noise };
+
+    Shape shape = Shape::dc;
+    /// Peak deviation from `offset`, in codes.
+    double amplitude = 0;
+    double offset = 2048;
+    double frequency_hz = 0;
+    /// Fraction of a period, 0..1.
+    double phase = 0;
+
+    /// Code at time `t` seconds, clamped to the converter range. `noise`
+    /// supplies a uniform value in [-1, 1) for Shape::noise.
+    std::uint16_t sample(double t, double noise = 0) const;
+};
+
+class SimAdc final : public AdcPort {
+public:
+    Status start(Acquisition& owner, const AdcConfig& config, Span<std::uint16_t> buffer) override;
+    void stop() override { running_ = false; }
+
+    /// Input on the `index`-th channel of the scan sequence.
+    void set_waveform(std::size_t index, const Waveform& waveform);
+
+    /// Converts `frames` trigger periods' worth of frames into the buffer
+    /// exactly as the DMA would, raising the half- and full-buffer events
+    /// as simulated interrupts. Does nothing while stopped.
+    void run_frames(std::size_t frames);
+
+    /// run_frames() for the frames that fall in `seconds` of sampling.
+    void run_for(double seconds);
+
+    /// Converts recorded codes instead of the waveforms: `frames` frames
+    /// of interleaved samples, one per channel of the scan sequence, e.g.
+    /// a block replayed from a trace (nucleo/hil/host/replay.hpp).
+    void run_samples(const std::uint16_t* samples, std::size_t frames);
+
+    void inject_adc_overrun();
+    void inject_dma_error();
+
+    bool running() const { return running_; }
+    /// Length of the scan sequence given to start().
+    std::size_t channels() const { return channels_; }
+    std::uint64_t frames_converted() const { return frame_count_; }
+    /// Sampling time of the next frame, in seconds since start().
+    double now_s() const { return static_cast<double>(frame_count_) / sample_rate_hz_; }
+
+private:
+    double next_noise();
+    void end_frame();
+
+    Acquisition* owner_ = nullptr;
+    Span<std::uint16_t> buffer_;
+    std::size_t channels_ = 0;
+    std::size_t dma_index_ = 0;
+    std::uint32_t sample_rate_hz_ = 1;
+    std::uint64_t frame_count_ = 0;
+    double elapsed_s_ = 0;
+    std::uint32_t noise_state_ = 0x12345678;
+    bool running_ = false;
+    Waveform waveforms_[kMaxChannels];
+};
+
+/// The simulated board ADC, same object as board_adc_port() in host builds.
+SimAdc& board_adc_sim();
+
+}  // namespace nucleo::adc::host
@@ -0,0 +1,42 @@
+// Hardware half of the ADC acquisition path.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::adc {
+
+class Acquisition;
+
+/// Longest regular conversion sequence the driver programs.
+inline constexpr std::size_t kMaxChannels = 8;
+
+struct AdcConfig {
+    /// Scan rate: one conversion of every channel per trigger.
+    std::uint32_t sample_rate_hz = 48'000;
+    /// ADC input numbers in scan order, 1..kMaxChannels entries.
+    Span<const std::uint8_t> channels;
+    /// Frames (one sample per channel) per processing block.
+    std::size_t block_frames = 64;
+};
+
+/// Implemented by the ADC1/TIM6/GPDMA driver on the target and by SimAdc on
+/// the host. Calls are per half buffer, never per sample.
+class AdcPort {
+public:
+    /// Starts timer-triggered scans streamed by circular DMA into `buffer`
+    /// (two blocks of interleaved frames). From then on the port calls
+    /// owner.isr_block_complete(0) when the first half fills and
+    /// owner.isr_block_complete(1) when the second does, and reports
+    /// converter overruns and DMA faults through isr_adc_overrun() and
+    /// isr_dma_error().
+    virtual Status start(Acquisition& owner, const AdcConfig& config, Span<std::uint16_t> buffer) = 0;
+    virtual void stop() = 0;
+
+protected:
+    ~AdcPort() = default;
+};
+
+}  // namespace nucleo::adc
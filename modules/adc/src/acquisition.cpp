@@ -0,0 +1,99 @@
+#include "nucleo/adc/acquisition.hpp"
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::adc {
+
+Acquisition::Acquisition(AdcPort& port, Span<std::uint16_t> buffer) : port_(port), buffer_(buffer) {}
+
+Status Acquisition::start(const AdcConfig& config) {
+    const std::size_t channels = config.channels.size();
+    if (channels == 0 || channels > kMaxChannels || config.sample_rate_hz == 0 || config.block_frames == 0 ||
+        2 * config.block_frames * channels > buffer_.size()) {
+        return Status::invalid_argument;
+    }
+    port_.stop();
+    frames_ = config.block_frames;
+    channels_ = channels;
+    block_samples_ = frames_ * channels_;
+    completed_.store(0, std::memory_order_relaxed);
+    consumed_ = 0;
+    reset_stats();
+    return port_.start(*this, config, buffer_.first(2 * block_samples_));
+}
+
+void Acquisition::stop() { port_.stop(); }
+
+NUCLEO_RAMFUNC void Acquisition::isr_block_complete(std::size_t half) {
+    const std::uint32_t now = perf::cycles();
+    std::uint32_t completed = completed_.load(std::memory_order_relaxed);
+    if (half != (completed & 1)) {
+        // The other half's interrupt was lost (or serviced too late to tell
+        // them apart): both blocks are complete now.
+        ready_tick_[completed & 1] = now;
+        ++completed;
+    }
+    ready_tick_[half] = now;
+    completed_.store(completed + 1, std::memory_order_release);
+    if (notify_ != nullptr) {
+        notify_(notify_context_, completed);
+    }
+}
+
+bool Acquisition::next_block(Block& block) {
+    const std::uint32_t completed = completed_.load(std::memory_order_acquire);
+    if (completed == consumed_) {
+        return false;
+    }
+    // With two blocks of buffer, anything older than the newest completed
+    // block is already being overwritten.
+    if (completed - consumed_ > 1) {
+        dropped_ += completed - consumed_ - 1;
+        consumed_ = completed - 1;
+    }
+    const std::size_t half = consumed_ & 1;
+    block.samples = buffer_.data() + half * block_samples_;
+    block.frames = frames_;
+    block.channels = channels_;
+    block.sequence = consumed_;
+    block.ready_tick = ready_tick_[half];
+    return true;
+}
+
+void Acquisition::finish_block(const Block& block) {
+    // The DMA moves back into this block's half as soon as the next block
+    // completes.
+    if (completed_.load(std::memory_order_acquire) - block.sequence >= 2) {
+        ++processing_overruns_;
+    }
+    const std::uint32_t latency = perf::cycles() - block.ready_tick;
+    if (latency > max_latency_) {
+        max_latency_ = latency;
+    }
+    consumed_ = block.sequence + 1;
+    ++processed_;
+}
+
+AcquisitionStats Acquisition::stats() const {
+    AcquisitionStats s;
+    s.blocks_completed = completed_.load(std::memory_order_relaxed);
+    s.blocks_processed = processed_;
+    s.blocks_dropped = dropped_;
+    s.processing_overruns = processing_overruns_;
+    s.adc_overruns = adc_overruns_.load(std::memory_order_relaxed);
+    s.dma_errors = dma_errors_.load(std::memory_order_relaxed);
+    s.max_latency_ticks = max_latency_;
+    return s;
+}
+
+void Acquisition::reset_stats() {
+    processed_ = 0;
+    dropped_ = 0;
+    processing_overruns_ = 0;
+    max_latency_ = 0;
+    adc_overruns_.store(0, std::memory_order_relaxed);
+    dma_errors_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace nucleo::adc
@@ -0,0 +1,213 @@
+// ADC1 scans triggered by TIM6 TRGO, streamed by GPDMA1 channel 4 in
+// circular mode.
+#include "stm32h5xx.h"
+
+#include "nucleo/adc/acquisition.hpp"
+#include "nucleo/adc/board_adc.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::adc {
+namespace {
+
+// RM0481, GPDMA1 request mapping and the ADC regular trigger table.
+constexpr std::uint32_t kRequestAdc1 = 0;
+constexpr std::uint32_t kExtselTim6Trgo = 13;
+constexpr std::uint32_t kIrqPriority = 4;  // above the UART: a late block costs data
+// SMPx code 0b001 samples for 6.5 ADC clocks; a 12-bit conversion adds
+// 12.5 more. Counted in half clocks at 62.5 MHz (HCLK / 4), that is just
+// under 3.3 Msps.
+constexpr std::uint32_t kSampleTime6Cycles5 = 1;
+constexpr std::uint32_t kAdcClockHz = 62'500'000;
+constexpr std::uint32_t kHalfClocksPerConversion = 13 + 25;  // 6.5 + 12.5
+constexpr std::uint32_t kMaxConversionsPerSecond = 2 * kAdcClockHz / kHalfClocksPerConversion;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+
+// Same self-linked item as the UART receiver: reloads the block size and
+// destination at the end of every pass.
+struct CircularLli {
+    std::uint32_t cbr1;
+    std::uint32_t cdar;
+    std::uint32_t cllr;
+};
+
+class Adc1Port final : public AdcPort {
+public:
+    Status start(Acquisition& owner, const AdcConfig& config, Span<std::uint16_t> buffer) override;
+    void stop() override;
+
+    void on_adc_irq();
+    void on_dma_irq();
+
+private:
+    Acquisition* owner_ = nullptr;
+    CircularLli lli_{};
+};
+
+Adc1Port g_port;
+
+void delay_cycles(std::uint32_t n) {
+    for (volatile std::uint32_t i = 0; i < n; ++i) {
+    }
+}
+
+void set_sequence(Span<const std::uint8_t> channels) {
+    // SQR1 holds L and SQ1..SQ4, SQR2 SQ5..SQ9; six bits per slot.
+    std::uint32_t sqr1 = static_cast<std::uint32_t>(channels.size() - 1) << ADC_SQR1_L_Pos;
+    std::uint32_t sqr2 = 0;
+    for (std::size_t i = 0; i < channels.size(); ++i) {
+        const std::uint32_t ch = channels[i] & 0x1F;
+        if (i < 4) {
+            sqr1 |= ch << (ADC_SQR1_SQ1_Pos + 6 * i);
+        } else {
+            sqr2 |= ch << (ADC_SQR2_SQ5_Pos + 6 * (i - 4));
+        }
+        // Every input gets the same sampling time so frames are evenly spaced.
+        if (ch < 10) {
+            ADC1->SMPR1 = (ADC1->SMPR1 & ~(7u << (3 * ch))) | (kSampleTime6Cycles5 << (3 * ch));
+        } else {
+            ADC1->SMPR2 = (ADC1->SMPR2 & ~(7u << (3 * (ch - 10)))) | (kSampleTime6Cycles5 << (3 * (ch - 10)));
+        }
+    }
+    ADC1->SQR1 = sqr1;
+    ADC1->SQR2 = sqr2;
+}
+
+Status enable_adc() {
+    // Exit deep power-down, start the regulator (tADCVREG_STUP = 20 us),
+    // calibrate, enable.
+    ADC1->CR &= ~ADC_CR_DEEPPWD;
+    ADC1->CR |= ADC_CR_ADVREGEN;
+    delay_cycles(platform::core_clock_hz() / 50'000);
+    ADC1->CR |= ADC_CR_ADCAL;
+    while ((ADC1->CR & ADC_CR_ADCAL) != 0) {
+    }
+    ADC1->ISR = ADC_ISR_ADRDY;
+    ADC1->CR |= ADC_CR_ADEN;
+    for (std::uint32_t spin = 0; (ADC1->ISR & ADC_ISR_ADRDY) == 0; ++spin) {
+        if (spin > 1'000'000) {
+            return Status::hardware_error;
+        }
+    }
+    return Status::ok;
+}
+
+Status Adc1Port::start(Acquisition& owner, const AdcConfig& config, Span<std::uint16_t> buffer) {
+    const std::uint32_t timer_clock = platform::core_clock_hz();
+    const std::uint32_t period = timer_clock / config.sample_rate_hz;
+    if (config.sample_rate_hz * config.channels.size() > kMaxConversionsPerSecond || period < 2 ||
+        buffer.size_bytes() > DMA_CBR1_BNDT) {
+        return Status::invalid_argument;
+    }
+    owner_ = &owner;
+
+    RCC->AHB2ENR |= RCC_AHB2ENR_ADCEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPDMA1EN;
+    RCC->APB1LENR |= RCC_APB1LENR_TIM6EN;
+    (void)RCC->APB1LENR;
+
+    // Inputs need no pin setup: GPIOs come out of reset in analog mode.
+    ADC12_COMMON->CCR = (ADC12_COMMON->CCR & ~ADC_CCR_CKMODE) | (3u << ADC_CCR_CKMODE_Pos);  // HCLK / 4
+    if (Status s = enable_adc(); s != Status::ok) {
+        return s;
+    }
+    set_sequence(config.channels);
+    // 12-bit, circular DMA requests, hardware trigger on rising TRGO. An
+    // overrun keeps the old data and raises OVR.
+    ADC1->CFGR = ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | (1u << ADC_CFGR_EXTEN_Pos) |
+                 (kExtselTim6Trgo << ADC_CFGR_EXTSEL_Pos);
+    ADC1->ISR = ADC_ISR_OVR;
+    ADC1->IER = ADC_IER_OVRIE;
+
+    DMA_Channel_TypeDef* dma = GPDMA1_Channel4;
+    dma->CCR = DMA_CCR_RESET;
+    const std::uint32_t bytes = static_cast<std::uint32_t>(buffer.size_bytes());
+    const std::uint32_t lli_addr = reinterpret_cast<std::uint32_t>(&lli_);
+    const std::uint32_t cllr = DMA_CLLR_UB1 | DMA_CLLR_UDA | (lli_addr & DMA_CLLR_LA);
+    lli_ = {bytes, reinterpret_cast<std::uint32_t>(buffer.data()), cllr};
+    // Half-word to half-word, peripheral fixed, memory increments.
+    dma->CTR1 = (1u << DMA_CTR1_SDW_LOG2_Pos) | (1u << DMA_CTR1_DDW_LOG2_Pos) | DMA_CTR1_DINC;
+    dma->CTR2 = kRequestAdc1 << DMA_CTR2_REQSEL_Pos;
+    dma->CBR1 = bytes;
+    dma->CSAR = reinterpret_cast<std::uint32_t>(&ADC1->DR);
+    dma->CDAR = reinterpret_cast<std::uint32_t>(buffer.data());
+    dma->CLBAR = lli_addr & DMA_CLBAR_LBA;
+    dma->CLLR = cllr;
+    dma->CFCR = kDmaAllFlags;
+    dma->CCR = DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_DTEIE | DMA_CCR_ULEIE | DMA_CCR_USEIE | DMA_CCR_EN;
+
+    NVIC_SetPriority(GPDMA1_Channel4_IRQn, kIrqPriority);
+    NVIC_SetPriority(ADC1_IRQn, kIrqPriority);
+    NVIC_EnableIRQ(GPDMA1_Channel4_IRQn);
+    NVIC_EnableIRQ(ADC1_IRQn);
+
+    ADC1->CR |= ADC_CR_ADSTART;  // armed; conversions wait for the trigger
+
+    // TIM6 update -> TRGO once per sample period.
+    const std::uint32_t prescaler = (period - 1) / 0x10000;
+    TIM6->CR1 = 0;
+    TIM6->PSC = prescaler;
+    TIM6->ARR = period / (prescaler + 1) - 1;
+    TIM6->CR2 = 2u << TIM_CR2_MMS_Pos;
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->CR1 = TIM_CR1_CEN;
+    return Status::ok;
+}
+
+void Adc1Port::stop() {
+    if (owner_ == nullptr) {
+        return;
+    }
+    TIM6->CR1 = 0;
+    if ((ADC1->CR & ADC_CR_ADSTART) != 0) {
+        ADC1->CR |= ADC_CR_ADSTP;
+        while ((ADC1->CR & ADC_CR_ADSTP) != 0) {
+        }
+    }
+    // Disable the ADC too: enable_adc() calibrates on the next start(),
+    // which the reference manual only allows with ADEN = 0.
+    if ((ADC1->CR & ADC_CR_ADEN) != 0) {
+        ADC1->CR |= ADC_CR_ADDIS;
+        while ((ADC1->CR & ADC_CR_ADEN) != 0) {
+        }
+    }
+    GPDMA1_Channel4->CCR = DMA_CCR_RESET;
+    NVIC_DisableIRQ(GPDMA1_Channel4_IRQn);
+    NVIC_DisableIRQ(ADC1_IRQn);
+}
+
+NUCLEO_RAMFUNC void Adc1Port::on_adc_irq() {
+    if ((ADC1->ISR & ADC_ISR_OVR) != 0) {
+        ADC1->ISR = ADC_ISR_OVR;
+        owner_->isr_adc_overrun();
+    }
+}
+
+NUCLEO_RAMFUNC void Adc1Port::on_dma_irq() {
+    DMA_Channel_TypeDef* dma = GPDMA1_Channel4;
+    const std::uint32_t csr = dma->CSR;
+    dma->CFCR = csr & kDmaAllFlags;
+    // Both flags at once means this interrupt was serviced a half late;
+    // report the halves in order.
+    if ((csr & DMA_CSR_HTF) != 0) {
+        owner_->isr_block_complete(0);
+    }
+    if ((csr & DMA_CSR_TCF) != 0) {
+        owner_->isr_block_complete(1);
+    }
+    if ((csr & (DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF)) != 0) {
+        owner_->isr_dma_error();
+    }
+}
+
+}  // namespace
+
+AdcPort& board_adc_port() { return g_port; }
+
+}  // namespace nucleo::adc
+
+extern "C" NUCLEO_RAMFUNC void ADC1_IRQHandler() { nucleo::adc::g_port.on_adc_irq(); }
+extern "C" NUCLEO_RAMFUNC void GPDMA1_Channel4_IRQHandler() { nucleo::adc::g_port.on_dma_irq(); }
@@ -0,0 +1,172 @@
+#include <iterator>
+#include <vector>
+
+#include "nucleo/adc/acquisition.hpp"
+#include "nucleo/adc/host/sim_adc.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::adc;
+using host::Waveform;
+
+namespace {
+
+constexpr std::uint32_t kRate = 10'000;
+constexpr std::size_t kFrames = 16;
+const std::uint8_t kChannels[] = {3, 10, 13};
+// Input on each scan-sequence slot.
+const Waveform kShapes[] = {
+    {Waveform::Shape::dc, 0, 100, 0, 0},
+    {Waveform::Shape::sine, 1000, 2048, 250, 0},
+    {Waveform::Shape::triangle, 2000, 2048, 125, 0.25},
+};
+
+struct Rig {
+    Rig() {
+        for (std::size_t c = 0; c < std::size(kShapes); ++c) {
+            sim.set_waveform(c, kShapes[c]);
+        }
+    }
+    Status start() { return acq.start({kRate, kChannels, kFrames}); }
+
+    host::SimAdc sim;
+    std::vector<std::uint16_t> buffer = std::vector<std::uint16_t>(2 * kFrames * 3);
+    Acquisition acq{sim, {buffer.data(), buffer.size()}};
+};
+
+// Expected code on scan-sequence slot `channel` for absolute frame `frame`.
+std::uint16_t expected(std::size_t channel, std::size_t frame) {
+    return kShapes[channel].sample(static_cast<double>(frame) / kRate);
+}
+
+bool block_matches(const Block& b) {
+    bool ok = b.frames == kFrames && b.channels == 3;
+    for (std::size_t f = 0; f < b.frames; ++f) {
+        for (std::size_t c = 0; c < b.channels; ++c) {
+            ok = ok && b.at(f, c) == expected(c, b.sequence * kFrames + f);
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+TEST(start_validates_configuration) {
+    Rig rig;
+    const std::uint8_t nine[9] = {};
+    CHECK_EQ(rig.acq.start({kRate, {}, kFrames}), Status::invalid_argument);
+    CHECK_EQ(rig.acq.start({kRate, nine, 4}), Status::invalid_argument);
+    CHECK_EQ(rig.acq.start({0, kChannels, kFrames}), Status::invalid_argument);
+    CHECK_EQ(rig.acq.start({kRate, kChannels, kFrames + 1}), Status::invalid_argument);
+    CHECK_EQ(rig.acq.start({kRate, kChannels, 0}), Status::invalid_argument);
+    CHECK(!rig.sim.running());
+    CHECK_EQ(rig.start(), Status::ok);
+    CHECK(rig.sim.running());
+    CHECK_EQ(rig.acq.block_samples(), kFrames * 3);
+}
+
+TEST(blocks_arrive_in_order_with_interleaved_frames) {
+    Rig rig;
+    REQUIRE_EQ(rig.start(), Status::ok);
+    std::uint32_t next = 0;
+    bool ok = true;
+    for (int round = 0; round < 10; ++round) {
+        rig.sim.run_frames(kFrames / 2);
+        CHECK_EQ(rig.acq.poll([](const Block&) {}), 0u);  // half a block is not a block
+        rig.sim.run_frames(kFrames / 2);
+        CHECK(rig.acq.block_ready());
+        rig.acq.poll([&](const Block& b) {
+            ok = ok && b.sequence == next++ && block_matches(b);
+        });
+    }
+    CHECK(ok);
+    CHECK_EQ(next, 10u);
+    const AcquisitionStats s = rig.acq.stats();
+    CHECK_EQ(s.blocks_completed, 10u);
+    CHECK_EQ(s.blocks_processed, 10u);
+    CHECK_EQ(s.blocks_dropped, 0u);
+    CHECK_EQ(s.processing_overruns, 0u);
+}
+
+TEST(a_slow_consumer_drops_stale_blocks_and_gets_the_newest) {
+    Rig rig;
+    REQUIRE_EQ(rig.start(), Status::ok);
+    rig.sim.run_frames(5 * kFrames);
+    std::vector<std::uint32_t> seen;
+    bool ok = true;
+    rig.acq.poll([&](const Block& b) {
+        seen.push_back(b.sequence);
+        ok = ok && block_matches(b);
+    });
+    CHECK((seen == std::vector<std::uint32_t>{4}));
+    CHECK(ok);
+    CHECK_EQ(rig.acq.stats().blocks_dropped, 4u);
+
+    // Two blocks behind: the older one's half is already being refilled.
+    rig.sim.run_frames(kFrames);
+    rig.sim.run_frames(kFrames);
+    seen.clear();
+    rig.acq.poll([&](const Block& b) { seen.push_back(b.sequence); });
+    CHECK((seen == std::vector<std::uint32_t>{6}));
+    CHECK_EQ(rig.acq.stats().blocks_dropped, 5u);
+}
+
+TEST(processing_longer_than_a_block_period_is_an_overrun) {
+    Rig rig;
+    REQUIRE_EQ(rig.start(), Status::ok);
+    rig.sim.run_frames(kFrames);
+    // The DMA fills the other half meanwhile; finishing before it completes is fine.
+    rig.acq.poll([&](const Block&) { rig.sim.run_frames(kFrames - 1); }, 1);
+    CHECK_EQ(rig.acq.stats().processing_overruns, 0u);
+    rig.sim.run_frames(1);
+    // Still busy when the next block completes: the DMA is now refilling
+    // the half being processed.
+    rig.acq.poll([&](const Block&) { rig.sim.run_frames(kFrames); }, 1);
+    CHECK_EQ(rig.acq.stats().processing_overruns, 1u);
+}
+
+TEST(notify_runs_per_block_and_faults_are_counted) {
+    Rig rig;
+    std::vector<std::uint32_t> notified;
+    rig.acq.set_notify(
+        [](void* ctx, std::uint32_t seq) { static_cast<std::vector<std::uint32_t>*>(ctx)->push_back(seq); },
+        &notified);
+    REQUIRE_EQ(rig.start(), Status::ok);
+    rig.sim.run_frames(3 * kFrames + 3);
+    CHECK((notified == std::vector<std::uint32_t>{0, 1, 2}));
+
+    rig.sim.inject_adc_overrun();
+    rig.sim.inject_dma_error();
+    rig.sim.inject_dma_error();
+    CHECK_EQ(rig.acq.stats().adc_overruns, 1u);
+    CHECK_EQ(rig.acq.stats().dma_errors, 2u);
+
+    rig.acq.stop();
+    rig.sim.run_frames(4 * kFrames);
+    CHECK_EQ(notified.size(), 3u);
+}
+
+TEST(run_for_converts_at_the_sample_rate) {
+    Rig rig;
+    REQUIRE_EQ(rig.start(), Status::ok);
+    for (int i = 0; i < 1000; ++i) {
+        rig.sim.run_for(0.00033);  // 3.3 frames per step
+    }
+    CHECK_EQ(rig.sim.frames_converted(), 3300u);
+    CHECK_EQ(rig.acq.stats().blocks_completed, 3300u / kFrames);
+}
+
+TEST(waveforms_follow_their_shape_and_clamp) {
+    const Waveform square{Waveform::Shape::square, 500, 1000, 10, 0};
+    CHECK_EQ(square.sample(0.01), 1500);
+    CHECK_EQ(square.sample(0.06), 500);
+    const Waveform tri{Waveform::Shape::triangle, 1000, 2000, 1, 0};
+    CHECK_EQ(tri.sample(0.0), 1000);
+    CHECK_EQ(tri.sample(0.25), 2000);
+    CHECK_EQ(tri.sample(0.5), 3000);
+    const Waveform loud{Waveform::Shape::sine, 5000, 2048, 1, 0};
+    CHECK_EQ(loud.sample(0.25), host::kFullScale);
+    CHECK_EQ(loud.sample(0.75), 0);
+    const Waveform noise{Waveform::Shape::noise, 100, 2048, 0, 0};
+    CHECK_EQ(noise.sample(0, -1.0), 1948);
+}
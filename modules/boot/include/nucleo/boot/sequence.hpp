@@ -0,0 +1,145 @@
+// Peripheral bring-up ordered by declared dependencies.
+//
+// Each driver or service registers a step: a name, an init function, the
+// names of the steps it needs first, and whether the first control cycle
+// has to wait for it. Registration order does not matter; resolve()
+// sorts the steps topologically, breaking ties by registration order so
+// the sequence is the same on every boot.
+//
+//   boot::BootSequence boot;
+//   boot.add({"board", init_board});
+//   boot.add({"adc", start_adc, &adc, boot::Urgency::critical, {"board"}});
+//   boot.add({"network", start_network, &net, boot::Urgency::deferred, {"board"}});
+//   boot.run_critical();                        // before the control loop
+//   for (;;) {
+//       control_cycle();
+//       boot.run_deferred();                    // one step per pass
+//   }
+//
+// A deferred step that a critical step depends on is promoted and runs
+// with the critical ones. A step whose dependency failed is skipped, and
+// so are its own dependants; independent steps still run. Every step is
+// timed with the sequence's tick source, and the sequence marks the
+// critical_init_done and deferred_init_done boot phases.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::boot {
+
+using StepId = std::uint8_t;
+inline constexpr StepId kNoStep = 0xFF;
+inline constexpr std::size_t kMaxSteps = 32;
+inline constexpr std::size_t kMaxDependencies = 4;
+
+enum class Urgency : std::uint8_t {
+    /// Runs in run_critical(), before the first control cycle.
+    critical,
+    /// Runs in run_deferred(), after it.
+    deferred,
+};
+
+using InitFn = Status (*)(void* context);
+
+struct StepConfig {
+    /// Unique, with static storage duration.
+    const char* name = "";
+    InitFn init = nullptr;
+    void* context = nullptr;
+    Urgency urgency = Urgency::critical;
+    /// Names of the steps that must succeed first; unused slots are null.
+    const char* after[kMaxDependencies] = {};
+};
+
+enum class StepState : std::uint8_t {
+    pending,
+    done,
+    failed,
+    /// Not run because a dependency failed or was skipped.
+    skipped,
+};
+
+struct StepRecord {
+    StepState state = StepState::pending;
+    /// What init returned (ok unless failed).
+    Status status = Status::ok;
+    /// Registered as deferred but needed by a critical step.
+    bool promoted = false;
+    /// Ticks at which init was called, and how long it took.
+    std::uint32_t start = 0;
+    std::uint32_t duration = 0;
+};
+
+class BootSequence {
+public:
+    using TickSource = std::uint32_t (*)();
+
+    /// `ticks` defaults to perf::cycles().
+    explicit BootSequence(TickSource ticks = nullptr);
+    BootSequence(const BootSequence&) = delete;
+    BootSequence& operator=(const BootSequence&) = delete;
+
+    /// Registers a step. Returns kNoStep when the table is full, the name is
+    /// empty or taken, init is null, or the sequence has already started.
+    StepId add(const StepConfig& config);
+
+    /// Orders the steps. not_found if a dependency names no step,
+    /// invalid_argument if dependencies form a cycle; blocked() then names
+    /// the offending step. run_critical() resolves on its own.
+    Status resolve();
+
+    /// Runs the critical (and promoted) steps in order. Returns ok, the
+    /// status of the first step that failed, or the resolve() error.
+    Status run_critical();
+
+    /// Runs the next deferred step, if run_critical() has been called.
+    /// Returns false when there is nothing left to run.
+    bool run_deferred();
+
+    /// run_deferred() until it returns false.
+    void run_all_deferred() {
+        while (run_deferred()) {
+        }
+    }
+
+    /// Every step has run, failed or been skipped.
+    bool finished() const { return started_ && cursor_ == count_; }
+
+    std::size_t step_count() const { return count_; }
+    StepId find(const char* name) const;
+    const StepConfig& config(StepId step) const { return steps_[step]; }
+    const StepRecord& record(StepId step) const { return records_[step]; }
+    bool critical(StepId step) const { return (critical_ >> step & 1u) != 0; }
+    /// The resolved order; empty until resolve() succeeds.
+    Span<const StepId> order() const { return {order_, resolved_ ? count_ : 0}; }
+    StepId blocked() const { return blocked_; }
+
+private:
+    void run(StepId step);
+    void skip_finished();
+
+    TickSource now_;
+    StepConfig steps_[kMaxSteps];
+    StepRecord records_[kMaxSteps];
+    std::uint32_t depends_[kMaxSteps] = {};  // bit per dependency
+    StepId order_[kMaxSteps] = {};
+    std::uint32_t critical_ = 0;  // bit per step, after promotion
+    std::size_t count_ = 0;
+    std::size_t cursor_ = 0;  // next position in order_ for run_deferred()
+    StepId blocked_ = kNoStep;
+    bool resolved_ = false;
+    bool started_ = false;
+};
+
+/// Registers one perf probe per boot-phase interval ("boot.clocks",
+/// "boot.memory", ...) and one per step that ran ("boot.<name>"), each
+/// holding one sample, the duration in cycles, so the next perf snapshot
+/// carries the boot timing. Call once the sequence has finished; calling
+/// again replaces the samples.
+void publish_probes(const BootSequence& sequence);
+
+}  // namespace nucleo::boot
@@ -0,0 +1,73 @@
+#include <optional>
+
+#include "nucleo/boot/sequence.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/platform/boot_phase.hpp"
+
+namespace nucleo::boot {
+
+namespace {
+
+using platform::BootPhase;
+
+// Interval i runs from phase i to phase i + 1.
+constexpr const char* kIntervalNames[platform::kBootPhases - 1] = {
+    "boot.clocks", "boot.memory", "boot.constructors", "boot.critical_init", "boot.first_cycle", "boot.deferred_init",
+};
+
+constexpr std::size_t kNameSize = 24;
+
+// Probes register themselves for good on construction, so each slot is
+// built once and only its statistics are replaced afterwards.
+std::optional<perf::Probe> g_interval_probes[platform::kBootPhases - 1];
+std::optional<perf::Probe> g_step_probes[kMaxSteps];
+char g_step_names[kMaxSteps][kNameSize];
+
+void publish(std::optional<perf::Probe>& slot, const char* name, std::uint32_t cycles) {
+    if (!slot) {
+        slot.emplace(name);
+    }
+    slot->reset();
+    slot->record(cycles);
+}
+
+const char* step_probe_name(std::size_t slot, const char* name) {
+    char* out = g_step_names[slot];
+    const char prefix[] = "boot.";
+    std::size_t n = 0;
+    for (const char* p = prefix; *p != '\0'; ++p) {
+        out[n++] = *p;
+    }
+    for (const char* p = name; *p != '\0' && n + 1 < kNameSize; ++p) {
+        out[n++] = *p;
+    }
+    out[n] = '\0';
+    return out;
+}
+
+}  // namespace
+
+void publish_probes(const BootSequence& sequence) {
+    const std::uint32_t cycles_per_us = perf::cycle_counter_hz() / 1'000'000;
+    for (std::size_t i = 0; i + 1 < platform::kBootPhases; ++i) {
+        const auto from = static_cast<BootPhase>(i);
+        const auto to = static_cast<BootPhase>(i + 1);
+        if (platform::boot_phase_reached(from) && platform::boot_phase_reached(to)) {
+            const std::uint32_t us = platform::boot_phase_us(to) - platform::boot_phase_us(from);
+            publish(g_interval_probes[i], kIntervalNames[i], us * cycles_per_us);
+        }
+    }
+    for (std::size_t i = 0; i < sequence.step_count(); ++i) {
+        const StepRecord& r = sequence.record(static_cast<StepId>(i));
+        if (r.state != StepState::done && r.state != StepState::failed) {
+            continue;
+        }
+        // A slot keeps the name it was first published with.
+        const char* name = g_step_probes[i] ? g_step_probes[i]->name()
+                                            : step_probe_name(i, sequence.config(static_cast<StepId>(i)).name);
+        publish(g_step_probes[i], name, r.duration);
+    }
+}
+
+}  // namespace nucleo::boot
@@ -0,0 +1,168 @@
+#include "nucleo/boot/sequence.hpp"
+
+#include <cstring>
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/platform/boot_phase.hpp"
+
+namespace nucleo::boot {
+
+namespace {
+
+std::uint32_t default_ticks() { return perf::cycles(); }
+
+constexpr std::uint32_t bit(std::size_t step) { return 1u << step; }
+
+}  // namespace
+
+BootSequence::BootSequence(TickSource ticks) : now_(ticks != nullptr ? ticks : default_ticks) {}
+
+StepId BootSequence::add(const StepConfig& config) {
+    if (started_ || count_ == kMaxSteps || config.init == nullptr || config.name == nullptr ||
+        config.name[0] == '\0' || find(config.name) != kNoStep) {
+        return kNoStep;
+    }
+    const StepId id = static_cast<StepId>(count_++);
+    steps_[id] = config;
+    records_[id] = {};
+    resolved_ = false;
+    return id;
+}
+
+StepId BootSequence::find(const char* name) const {
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (std::strcmp(steps_[i].name, name) == 0) {
+            return static_cast<StepId>(i);
+        }
+    }
+    return kNoStep;
+}
+
+Status BootSequence::resolve() {
+    resolved_ = false;
+    blocked_ = kNoStep;
+    for (std::size_t i = 0; i < count_; ++i) {
+        depends_[i] = 0;
+        for (const char* name : steps_[i].after) {
+            if (name == nullptr) {
+                continue;
+            }
+            const StepId dep = find(name);
+            if (dep == kNoStep || dep == i) {
+                blocked_ = static_cast<StepId>(i);
+                return dep == kNoStep ? Status::not_found : Status::invalid_argument;
+            }
+            depends_[i] |= bit(dep);
+        }
+    }
+
+    // Kahn's algorithm, always taking the earliest-registered ready step.
+    std::uint32_t placed = 0;
+    for (std::size_t n = 0; n < count_; ++n) {
+        StepId next = kNoStep;
+        for (std::size_t i = 0; i < count_ && next == kNoStep; ++i) {
+            if ((placed & bit(i)) == 0 && (depends_[i] & ~placed) == 0) {
+                next = static_cast<StepId>(i);
+            }
+        }
+        if (next == kNoStep) {
+            // Whatever is left waits on itself; report the first of it.
+            for (std::size_t i = 0; i < count_ && blocked_ == kNoStep; ++i) {
+                if ((placed & bit(i)) == 0) {
+                    blocked_ = static_cast<StepId>(i);
+                }
+            }
+            return Status::invalid_argument;
+        }
+        order_[n] = next;
+        placed |= bit(next);
+    }
+
+    // Walking the order backwards reaches every step after all of its
+    // dependants, so one pass promotes transitively.
+    critical_ = 0;
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (steps_[i].urgency == Urgency::critical) {
+            critical_ |= bit(i);
+        }
+    }
+    for (std::size_t n = count_; n-- > 0;) {
+        const StepId step = order_[n];
+        if ((critical_ & bit(step)) != 0) {
+            critical_ |= depends_[step];
+        }
+    }
+    for (std::size_t i = 0; i < count_; ++i) {
+        records_[i].promoted = steps_[i].urgency == Urgency::deferred && (critical_ & bit(i)) != 0;
+    }
+    resolved_ = true;
+    return Status::ok;
+}
+
+void BootSequence::run(StepId step) {
+    StepRecord& r = records_[step];
+    std::uint32_t deps = depends_[step];
+    for (std::size_t i = 0; deps != 0; ++i, deps >>= 1) {
+        if ((deps & 1u) != 0 && records_[i].state != StepState::done) {
+            r.state = StepState::skipped;
+            return;
+        }
+    }
+    r.start = now_();
+    r.status = steps_[step].init(steps_[step].context);
+    r.duration = now_() - r.start;
+    r.state = r.status == Status::ok ? StepState::done : StepState::failed;
+}
+
+void BootSequence::skip_finished() {
+    while (cursor_ < count_ && records_[order_[cursor_]].state != StepState::pending) {
+        ++cursor_;
+    }
+}
+
+Status BootSequence::run_critical() {
+    if (started_) {
+        return Status::busy;
+    }
+    if (!resolved_) {
+        const Status status = resolve();
+        if (status != Status::ok) {
+            return status;
+        }
+    }
+    started_ = true;
+    Status result = Status::ok;
+    for (std::size_t n = 0; n < count_; ++n) {
+        const StepId step = order_[n];
+        if (!critical(step)) {
+            continue;
+        }
+        run(step);
+        if (records_[step].state == StepState::failed && result == Status::ok) {
+            result = records_[step].status;
+        }
+    }
+    platform::mark_boot_phase(platform::BootPhase::critical_init_done);
+    skip_finished();
+    if (finished()) {
+        platform::mark_boot_phase(platform::BootPhase::deferred_init_done);
+    }
+    return result;
+}
+
+bool BootSequence::run_deferred() {
+    if (!started_) {
+        return false;
+    }
+    if (finished()) {
+        return false;
+    }
+    run(order_[cursor_++]);
+    skip_finished();
+    if (finished()) {
+        platform::mark_boot_phase(platform::BootPhase::deferred_init_done);
+    }
+    return true;
+}
+
+}  // namespace nucleo::boot
@@ -0,0 +1,235 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "nucleo/boot/sequence.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::boot;
+
+namespace {
+
+// Steps append their names here as they run.
+std::vector<std::string> g_ran;
+
+Status log_step(void* context) {
+    g_ran.emplace_back(context != nullptr ? static_cast<const char*>(context) : "?");
+    return Status::ok;
+}
+
+struct Step {
+    const char* name;
+    Status result;
+};
+
+Status scripted_step(void* context) {
+    const Step& step = *static_cast<const Step*>(context);
+    g_ran.emplace_back(step.name);
+    return step.result;
+}
+
+std::uint32_t g_ticks = 0;
+std::uint32_t fake_ticks() { return g_ticks += 10; }
+
+StepConfig step(Step& s, Urgency urgency = Urgency::critical, std::initializer_list<const char*> after = {}) {
+    StepConfig c;
+    c.name = s.name;
+    c.init = scripted_step;
+    c.context = &s;
+    c.urgency = urgency;
+    std::size_t i = 0;
+    for (const char* dep : after) {
+        c.after[i++] = dep;
+    }
+    return c;
+}
+
+std::vector<std::string> names(const BootSequence& b) {
+    std::vector<std::string> out;
+    for (const StepId id : b.order()) {
+        out.emplace_back(b.config(id).name);
+    }
+    return out;
+}
+
+bool probe_exists(const char* name) {
+    for (const perf::Probe* p = perf::first_probe(); p != nullptr; p = p->next()) {
+        if (std::strcmp(p->name(), name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(steps_run_after_their_dependencies_whatever_the_registration_order) {
+    g_ran.clear();
+    Step net{"net", Status::ok}, phy{"phy", Status::ok}, clocks{"clocks", Status::ok}, gpio{"gpio", Status::ok};
+    BootSequence b(fake_ticks);
+    REQUIRE(b.add(step(net, Urgency::critical, {"phy", "clocks"})) != kNoStep);
+    REQUIRE(b.add(step(phy, Urgency::critical, {"gpio"})) != kNoStep);
+    REQUIRE(b.add(step(clocks)) != kNoStep);
+    REQUIRE(b.add(step(gpio, Urgency::critical, {"clocks"})) != kNoStep);
+    REQUIRE_EQ(b.resolve(), Status::ok);
+    CHECK(names(b) == (std::vector<std::string>{"clocks", "gpio", "phy", "net"}));
+    REQUIRE_EQ(b.run_critical(), Status::ok);
+    CHECK(g_ran == names(b));
+    CHECK(b.finished());
+}
+
+TEST(independent_steps_keep_registration_order) {
+    Step a{"a", Status::ok}, b_{"b", Status::ok}, c{"c", Status::ok}, d{"d", Status::ok};
+    BootSequence b(fake_ticks);
+    b.add(step(a));
+    b.add(step(b_, Urgency::critical, {"d"}));
+    b.add(step(c));
+    b.add(step(d));
+    REQUIRE_EQ(b.resolve(), Status::ok);
+    CHECK(names(b) == (std::vector<std::string>{"a", "c", "d", "b"}));
+}
+
+TEST(unknown_dependencies_and_cycles_are_reported) {
+    Step a{"a", Status::ok}, b_{"b", Status::ok}, c{"c", Status::ok};
+    {
+        BootSequence b(fake_ticks);
+        b.add(step(a));
+        b.add(step(b_, Urgency::critical, {"a", "uart"}));
+        CHECK_EQ(b.resolve(), Status::not_found);
+        CHECK_EQ(b.blocked(), b.find("b"));
+        CHECK(b.order().empty());
+        CHECK_EQ(b.run_critical(), Status::not_found);
+    }
+    {
+        BootSequence b(fake_ticks);
+        b.add(step(a));
+        b.add(step(b_, Urgency::critical, {"c"}));
+        b.add(step(c, Urgency::critical, {"b"}));
+        CHECK_EQ(b.resolve(), Status::invalid_argument);
+        CHECK_EQ(b.blocked(), b.find("b"));
+    }
+    {
+        BootSequence b(fake_ticks);
+        b.add(step(a, Urgency::critical, {"a"}));
+        CHECK_EQ(b.resolve(), Status::invalid_argument);
+    }
+}
+
+TEST(invalid_registrations_are_refused) {
+    BootSequence b(fake_ticks);
+    CHECK_EQ(b.add({"", log_step}), kNoStep);
+    CHECK_EQ(b.add({"x", nullptr}), kNoStep);
+    CHECK(b.add({"x", log_step}) != kNoStep);
+    CHECK_EQ(b.add({"x", log_step}), kNoStep);
+
+    static char names_storage[kMaxSteps][4];
+    BootSequence full(fake_ticks);
+    for (std::size_t i = 0; i < kMaxSteps; ++i) {
+        names_storage[i][0] = static_cast<char>('A' + i / 10);
+        names_storage[i][1] = static_cast<char>('0' + i % 10);
+        CHECK(full.add({names_storage[i], log_step}) != kNoStep);
+    }
+    CHECK_EQ(full.add({"one_too_many", log_step}), kNoStep);
+    REQUIRE_EQ(full.run_critical(), Status::ok);
+    CHECK_EQ(full.add({"late", log_step}), kNoStep);
+}
+
+TEST(deferred_steps_run_one_per_call_after_the_critical_ones) {
+    g_ran.clear();
+    Step clocks{"clocks", Status::ok}, control{"control", Status::ok}, console{"console", Status::ok},
+        network{"network", Status::ok};
+    BootSequence b(fake_ticks);
+    b.add(step(console, Urgency::deferred, {"clocks"}));
+    b.add(step(clocks));
+    b.add(step(network, Urgency::deferred, {"clocks"}));
+    b.add(step(control, Urgency::critical, {"clocks"}));
+
+    CHECK(!b.run_deferred());  // not before run_critical()
+    REQUIRE_EQ(b.run_critical(), Status::ok);
+    CHECK(g_ran == (std::vector<std::string>{"clocks", "control"}));
+    CHECK(!b.finished());
+    CHECK(b.run_deferred());
+    CHECK(g_ran.back() == "console");
+    CHECK(b.run_deferred());
+    CHECK(g_ran.back() == "network");
+    CHECK(b.finished());
+    CHECK(!b.run_deferred());
+    CHECK_EQ(g_ran.size(), 4u);
+}
+
+TEST(deferred_steps_needed_by_critical_ones_are_promoted) {
+    g_ran.clear();
+    Step pll{"pll", Status::ok}, dma{"dma", Status::ok}, adc{"adc", Status::ok}, log{"log", Status::ok};
+    BootSequence b(fake_ticks);
+    b.add(step(pll, Urgency::deferred));
+    b.add(step(dma, Urgency::deferred, {"pll"}));
+    b.add(step(log, Urgency::deferred));
+    b.add(step(adc, Urgency::critical, {"dma"}));
+    REQUIRE_EQ(b.run_critical(), Status::ok);
+    CHECK(g_ran == (std::vector<std::string>{"pll", "dma", "adc"}));
+    CHECK(b.record(b.find("pll")).promoted);
+    CHECK(b.record(b.find("dma")).promoted);
+    CHECK(!b.record(b.find("adc")).promoted);
+    CHECK(!b.critical(b.find("log")));
+    b.run_all_deferred();
+    CHECK(g_ran.back() == "log");
+}
+
+TEST(a_failure_skips_dependants_only) {
+    g_ran.clear();
+    Step phy{"phy", Status::timeout}, eth{"eth", Status::ok}, udp{"udp", Status::ok}, adc{"adc", Status::ok};
+    BootSequence b(fake_ticks);
+    b.add(step(phy));
+    b.add(step(eth, Urgency::critical, {"phy"}));
+    b.add(step(udp, Urgency::deferred, {"eth"}));
+    b.add(step(adc));
+    CHECK_EQ(b.run_critical(), Status::timeout);
+    CHECK(g_ran == (std::vector<std::string>{"phy", "adc"}));
+    CHECK(b.record(b.find("phy")).state == StepState::failed);
+    CHECK(b.record(b.find("eth")).state == StepState::skipped);
+    // The deferred dependant is skipped when its turn comes.
+    CHECK(b.record(b.find("udp")).state == StepState::pending);
+    CHECK(b.run_deferred());
+    CHECK(b.record(b.find("udp")).state == StepState::skipped);
+    CHECK(b.finished());
+    CHECK_EQ(g_ran.size(), 2u);
+}
+
+TEST(steps_are_timed_and_boot_phases_marked) {
+    platform::host::reset();
+    Step a{"timed_a", Status::ok}, c{"timed_c", Status::ok};
+    BootSequence b(fake_ticks);
+    b.add(step(a));
+    b.add(step(c, Urgency::deferred));
+    g_ticks = 100;
+    REQUIRE_EQ(b.run_critical(), Status::ok);
+    CHECK_EQ(b.record(0).start, 110u);
+    CHECK_EQ(b.record(0).duration, 10u);
+    CHECK(platform::boot_phase_reached(platform::BootPhase::critical_init_done));
+    CHECK(!platform::boot_phase_reached(platform::BootPhase::deferred_init_done));
+    b.run_all_deferred();
+    CHECK(platform::boot_phase_reached(platform::BootPhase::deferred_init_done));
+    CHECK(platform::boot_phase_us(platform::BootPhase::deferred_init_done) >=
+          platform::boot_phase_us(platform::BootPhase::critical_init_done));
+
+    platform::mark_boot_phase(platform::BootPhase::first_cycle_done);
+    publish_probes(b);
+    CHECK(probe_exists("boot.critical_init"));
+    CHECK(probe_exists("boot.timed_a"));
+    CHECK(probe_exists("boot.timed_c"));
+    // The step probes hold the step durations.
+    for (const perf::Probe* p = perf::first_probe(); p != nullptr; p = p->next()) {
+        if (std::strcmp(p->name(), "boot.timed_a") == 0) {
+            CHECK_EQ(p->stats().count, 1u);
+            CHECK_EQ(p->stats().max, 10u);
+        }
+    }
+    // Publishing again replaces the samples rather than adding probes.
+    const std::uint16_t probes = perf::probe_count();
+    publish_probes(b);
+    CHECK_EQ(perf::probe_count(), probes);
+}
@@ -0,0 +1,109 @@
+// Software crypto backend throughput: the baseline the accelerators are
+// measured against, and what the host build and accelerator-less parts run.
+//
+//  * sha256_4k / sha256_mbps: one 4 KB digest, and the rate it implies
+//  * sha256_segments / sha256_gathered: a 3-segment image hashed as a
+//    segment list (the chained-DMA entry point) and by first copying the
+//    segments into one buffer
+//  * aes128_gcm_1k / aes256_gcm_1k (+ _mbps): sealing a 1 KB telemetry
+//    record with 16 bytes of AAD
+//  * ecdsa_p256_verify: one signature check
+//  * image_verify_64k: verify_image() of a 64 KB image in three segments
+#include <cstring>
+#include <vector>
+
+#include "nucleo/crypto/aes_gcm.hpp"
+#include "nucleo/crypto/ecdsa.hpp"
+#include "nucleo/crypto/sha256.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::crypto;
+
+namespace {
+
+std::vector<std::uint8_t> pattern(std::size_t n) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+    return v;
+}
+
+double mbps(std::size_t bytes, double ns) { return static_cast<double>(bytes) / ns * 1e3; }
+
+// A valid signature over pattern(1000) (see test/ecdsa_test.cpp).
+const P256PublicKey kKey = {
+    {0x15, 0x06, 0x4e, 0x8c, 0xc4, 0x22, 0xf5, 0xdf, 0x25, 0x43, 0x1a, 0x2d, 0xaa, 0x2a, 0x68, 0xa3,
+     0xc5, 0x4b, 0xff, 0xe5, 0x09, 0xf6, 0xee, 0x42, 0x01, 0x56, 0xc3, 0xb6, 0xd4, 0x16, 0xb2, 0x92},
+    {0x22, 0x34, 0xa4, 0x97, 0x39, 0x8e, 0xe6, 0xbf, 0xd4, 0xc2, 0x90, 0xdb, 0x82, 0x51, 0x43, 0x42,
+     0x49, 0x30, 0x6e, 0x46, 0x02, 0x40, 0x93, 0x76, 0x67, 0x2d, 0x5a, 0x59, 0xbe, 0x90, 0x0d, 0xd1},
+};
+const P256Signature kSignature = {
+    {0x68, 0xba, 0xec, 0xd1, 0x72, 0xc9, 0x02, 0xc7, 0x87, 0xeb, 0x6e, 0x3c, 0xfc, 0x93, 0x3f, 0x8c,
+     0xb5, 0xca, 0x16, 0xcd, 0xf7, 0x7b, 0x59, 0x9d, 0x21, 0x25, 0x11, 0x31, 0x1e, 0x0b, 0x9f, 0x23},
+    {0xdc, 0x41, 0x80, 0x98, 0xfc, 0xd5, 0xe5, 0xa9, 0x55, 0xce, 0x0f, 0xe0, 0x71, 0x89, 0x31, 0x1a,
+     0x4f, 0x01, 0x20, 0xfe, 0x40, 0xf2, 0x78, 0x0a, 0x92, 0xe5, 0x97, 0x4f, 0x8d, 0xb5, 0x55, 0x5b},
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    Sha256Digest digest{};
+
+    const auto block = pattern(4096);
+    const testkit::Summary hash = bench.run("sha256_4k", 1, [&] {
+        sha256({block.data(), block.size()}, digest);
+        testkit::do_not_optimize(digest);
+    });
+    bench.metric("sha256_mbps", mbps(block.size(), hash.p50), "MB/s");
+
+    const auto image = pattern(64 * 1024);
+    const ConstByteSpan segments[] = {
+        {image.data(), 512}, {image.data() + 512, 60 * 1024}, {image.data() + 512 + 60 * 1024, 3584}};
+    bench.run("sha256_segments", 1, [&] {
+        sha256(segments, digest);
+        testkit::do_not_optimize(digest);
+    });
+    std::vector<std::uint8_t> gathered(image.size());
+    bench.run("sha256_gathered", 1, [&] {
+        std::size_t at = 0;
+        for (const ConstByteSpan& s : segments) {
+            std::memcpy(gathered.data() + at, s.data(), s.size());
+            at += s.size();
+        }
+        sha256({gathered.data(), gathered.size()}, digest);
+        testkit::do_not_optimize(digest);
+    });
+
+    const auto record = pattern(1024);
+    const auto aad = pattern(16);
+    std::vector<std::uint8_t> sealed(record.size());
+    std::uint8_t tag[AesGcm::kTagSize];
+    const std::uint8_t iv[AesGcm::kIvSize] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    for (const std::size_t key_size : {std::size_t{16}, std::size_t{32}}) {
+        const auto key = pattern(key_size);
+        AesGcm gcm;
+        gcm.set_key({key.data(), key.size()});
+        const char* name = key_size == 16 ? "aes128_gcm_1k" : "aes256_gcm_1k";
+        const testkit::Summary seal = bench.run(name, 1, [&] {
+            gcm.start(Direction::encrypt, iv, {aad.data(), aad.size()});
+            gcm.update({record.data(), record.size()}, {sealed.data(), sealed.size()});
+            gcm.finish(tag);
+            testkit::do_not_optimize(tag);
+        });
+        bench.metric(key_size == 16 ? "aes128_gcm_mbps" : "aes256_gcm_mbps", mbps(record.size(), seal.p50), "MB/s");
+    }
+
+    const auto signed_image = pattern(1000);
+    Sha256Digest signed_digest{};
+    sha256({signed_image.data(), signed_image.size()}, signed_digest);
+    bench.run("ecdsa_p256_verify", 1, [&] {
+        testkit::do_not_optimize(ecdsa_p256_verify(kKey, signed_digest, kSignature));
+    });
+    bench.run("image_verify_64k", 1, [&] {
+        testkit::do_not_optimize(verify_image(segments, kKey, kSignature));
+    });
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Sha256 in host builds: soft::Sha256 stands in for the HASH. Ownership of
+// the single peripheral is still modelled, so a second concurrent stream
+// fails here as it would on the target.
+#include "nucleo/crypto/sha256.hpp"
+
+namespace nucleo::crypto {
+namespace {
+
+bool g_claimed = false;
+
+}  // namespace
+
+Status Sha256::start() {
+    if (active_) {
+        soft_.start();
+        return Status::ok;
+    }
+    if (g_claimed) {
+        return Status::busy;
+    }
+    g_claimed = true;
+    active_ = true;
+    soft_.start();
+    return Status::ok;
+}
+
+Status Sha256::update(ConstByteSpan data) {
+    if (!active_) {
+        return Status::invalid_argument;
+    }
+    soft_.update(data);
+    return Status::ok;
+}
+
+Status Sha256::finish(Sha256Digest& out) {
+    if (!active_) {
+        return Status::invalid_argument;
+    }
+    soft_.finish(out.data());
+    abort();
+    return Status::ok;
+}
+
+void Sha256::abort() {
+    if (active_) {
+        active_ = false;
+        g_claimed = false;
+    }
+}
+
+Status sha256(Span<const ConstByteSpan> segments, Sha256Digest& out) {
+    Sha256 hash;
+    Status status = hash.start();
+    for (std::size_t i = 0; i < segments.size() && status == Status::ok; ++i) {
+        status = hash.update(segments[i]);
+    }
+    return status == Status::ok ? hash.finish(out) : status;
+}
+
+}  // namespace nucleo::crypto
@@ -0,0 +1,66 @@
+// AES-GCM authenticated encryption, for telemetry leaving the board.
+//
+// Parts with the AES accelerator (STM32H573, built with
+// NUCLEO_CRYPTO_AES_PKA) run the whole mode in hardware: header blocks are
+// written by the CPU, payload blocks stream through GPDMA1 channels 6
+// (memory -> DINR) and 7 (DOUTR -> memory), and the tag comes out of the
+// final phase. The STM32H563 on the Nucleo board has no AES, so there, as
+// on the host, soft::Gcm does the work behind the same API.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/crypto/soft.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::crypto {
+
+class AesGcm {
+public:
+    static constexpr std::size_t kIvSize = 12;
+    static constexpr std::size_t kTagSize = 16;
+    static constexpr std::size_t kBlockSize = 16;
+
+    /// `key` must be 16 or 32 bytes.
+    Status set_key(ConstByteSpan key);
+
+    /// Begins a message under a fresh `iv` (never reuse one with the same
+    /// key). `aad` is authenticated but not encrypted.
+    Status start(Direction direction, ConstByteSpan iv, ConstByteSpan aad = {});
+    /// Encrypts or decrypts `in` into `out` (same size, may alias). Only
+    /// the last update() of a message may have a length that is not a
+    /// multiple of kBlockSize, as the hardware pads that block.
+    Status update(ConstByteSpan in, ByteSpan out);
+    /// Ends an encryption and writes the tag (kTagSize bytes).
+    Status finish(ByteSpan tag);
+    /// Ends a decryption: corrupt if `tag` does not match, in which case
+    /// the plaintext already written must be discarded.
+    Status finish_verify(ConstByteSpan tag);
+
+private:
+    Status compute_tag(std::uint8_t* tag);
+
+    Direction direction_ = Direction::encrypt;
+    bool keyed_ = false;
+    bool started_ = false;
+    bool tail_ = false;  // a partial block was processed; the payload is over
+#if NUCLEO_CRYPTO_AES_PKA
+    std::uint32_t key_[8] = {};
+    std::size_t key_words_ = 0;
+    std::uint64_t aad_bytes_ = 0;
+    std::uint64_t text_bytes_ = 0;
+#else
+    soft::Gcm soft_;
+#endif
+};
+
+/// One-shot encryption: `ciphertext` has the size of `plaintext`.
+Status aes_gcm_seal(ConstByteSpan key, ConstByteSpan iv, ConstByteSpan aad, ConstByteSpan plaintext,
+                    ByteSpan ciphertext, ByteSpan tag);
+/// One-shot decryption; corrupt (and `plaintext` zeroed) if the tag fails.
+Status aes_gcm_open(ConstByteSpan key, ConstByteSpan iv, ConstByteSpan aad, ConstByteSpan ciphertext,
+                    ConstByteSpan tag, ByteSpan plaintext);
+
+}  // namespace nucleo::crypto
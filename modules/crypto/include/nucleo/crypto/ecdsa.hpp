@@ -0,0 +1,40 @@
+// ECDSA P-256 signature verification, for firmware images.
+//
+// With NUCLEO_CRYPTO_AES_PKA the PKA does the scalar multiplications
+// (STM32H573); elsewhere soft::p256_verify runs on the CPU. verify_image()
+// puts the two halves of an update check together: the image is hashed as
+// it lies in flash, segment by segment, and the digest checked against the
+// vendor key.
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "nucleo/crypto/sha256.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::crypto {
+
+/// Affine public key, big-endian coordinates.
+struct P256PublicKey {
+    std::array<std::uint8_t, 32> x;
+    std::array<std::uint8_t, 32> y;
+};
+
+/// Raw (r, s) signature, big-endian; not DER.
+struct P256Signature {
+    std::array<std::uint8_t, 32> r;
+    std::array<std::uint8_t, 32> s;
+};
+
+/// ok if `signature` is valid for `digest` under `key`; corrupt if it is
+/// not; invalid_argument if r or s is out of range or the key is not a
+/// curve point.
+Status ecdsa_p256_verify(const P256PublicKey& key, const Sha256Digest& digest, const P256Signature& signature);
+
+/// SHA-256 over `segments`, then ecdsa_p256_verify().
+Status verify_image(Span<const ConstByteSpan> segments, const P256PublicKey& key,
+                    const P256Signature& signature);
+
+}  // namespace nucleo::crypto
@@ -0,0 +1,61 @@
+// Streaming SHA-256 on the HASH accelerator.
+//
+// On the target the HASH is fed by GPDMA1 channel 5: update() hands the
+// word-aligned bulk of its data to the DMA and returns, so the CPU is free
+// while a flash region or a received frame is hashed. sha256() over a
+// list of segments goes further and chains them through a GPDMA linked
+// list, so an image split into header, body and trailer costs one
+// transfer setup. The host build runs soft::Sha256 behind the same API.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/crypto/soft.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::crypto {
+
+using Sha256Digest = std::array<std::uint8_t, 32>;
+
+class Sha256 {
+public:
+    Sha256() = default;
+    Sha256(const Sha256&) = delete;
+    Sha256& operator=(const Sha256&) = delete;
+    ~Sha256() { abort(); }
+
+    /// Claims the HASH and begins a digest. Returns busy while another
+    /// stream holds it (there is one HASH and no context swapping).
+    Status start();
+    /// Adds `data`. On the target this returns once the transfer is
+    /// queued; `data` must stay valid and unchanged until the next
+    /// update() or finish().
+    Status update(ConstByteSpan data);
+    /// Waits for queued data, writes the digest and releases the HASH.
+    Status finish(Sha256Digest& out);
+    /// Drops the digest in progress and releases the HASH.
+    void abort();
+
+    bool active() const { return active_; }
+
+private:
+    bool active_ = false;
+#if NUCLEO_PLATFORM_HOST
+    soft::Sha256 soft_;
+#else
+    std::uint8_t carry_[4] = {};  // bytes short of a whole DIN word
+    std::size_t carry_size_ = 0;
+#endif
+};
+
+/// Digest of the concatenation of `segments`. On the target, segments
+/// whose lengths (all but the last) are multiples of 4 go through one
+/// linked-list DMA transfer; others are streamed.
+Status sha256(Span<const ConstByteSpan> segments, Sha256Digest& out);
+
+inline Status sha256(ConstByteSpan data, Sha256Digest& out) { return sha256({&data, 1}, out); }
+
+}  // namespace nucleo::crypto
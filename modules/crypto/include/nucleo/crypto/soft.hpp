@@ -0,0 +1,106 @@
+// Portable implementations of the primitives the accelerators provide.
+//
+// These are the host backend of the crypto front ends and the reference the
+// hardware paths are tested against. They are straightforward table-driven
+// code: constant time is not a goal (nothing here handles a long-term
+// secret on the host), bit-exactness with the standards is.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::crypto {
+
+enum class Direction : std::uint8_t { encrypt, decrypt };
+
+namespace soft {
+
+class Sha256 {
+public:
+    static constexpr std::size_t kBlockSize = 64;
+    static constexpr std::size_t kDigestSize = 32;
+
+    Sha256() { start(); }
+
+    void start();
+    void update(ConstByteSpan data);
+    /// Pads, writes the digest to `out` (kDigestSize bytes) and restarts.
+    void finish(std::uint8_t* out);
+
+private:
+    void compress(const std::uint8_t* block);
+
+    std::uint32_t state_[8] = {};
+    std::uint8_t buffer_[kBlockSize] = {};
+    std::size_t buffered_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+/// AES block encryption with a 128- or 256-bit key (GCM only ever runs
+/// the cipher forwards, so there is no decryption schedule).
+class Aes {
+public:
+    static constexpr std::size_t kBlockSize = 16;
+
+    /// `key` must be 16 or 32 bytes.
+    Status set_key(ConstByteSpan key);
+    void encrypt_block(const std::uint8_t* in, std::uint8_t* out) const;
+    std::size_t rounds() const { return rounds_; }
+
+private:
+    std::uint32_t round_keys_[60] = {};
+    std::size_t rounds_ = 0;
+};
+
+/// AES-GCM with a 96-bit IV and a 128-bit tag (SP 800-38D). GHASH uses
+/// 4-bit tables (256 bytes per key).
+class Gcm {
+public:
+    static constexpr std::size_t kIvSize = 12;
+    static constexpr std::size_t kTagSize = 16;
+
+    Status set_key(ConstByteSpan key);
+    /// Begins a message. AAD may be fed in pieces before the first crypt().
+    Status start(Direction direction, ConstByteSpan iv);
+    Status aad(ConstByteSpan data);
+    /// Encrypts or decrypts `in` into `out` (same size; may be the same
+    /// buffer). Any split of the message gives the same result.
+    Status crypt(ConstByteSpan in, ByteSpan out);
+    /// Writes the tag (kTagSize bytes).
+    Status finish(ByteSpan tag);
+
+private:
+    void ghash_block(const std::uint8_t* block);
+    void ghash_bytes(const std::uint8_t* data, std::size_t size);
+    void flush_ghash();
+
+    Aes aes_;
+    bool keyed_ = false;
+    bool started_ = false;
+    bool in_payload_ = false;
+    Direction direction_ = Direction::encrypt;
+    std::uint64_t table_hi_[16] = {};
+    std::uint64_t table_lo_[16] = {};
+    std::uint8_t y_[16] = {};        // GHASH accumulator
+    std::uint8_t j0_[16] = {};       // pre-counter block
+    std::uint8_t counter_[16] = {};  // next counter block
+    std::uint8_t keystream_[16] = {};
+    std::size_t keystream_used_ = 16;
+    std::uint8_t partial_[16] = {};  // AAD or ciphertext not yet a full GHASH block
+    std::size_t partial_size_ = 0;
+    std::uint64_t aad_bytes_ = 0;
+    std::uint64_t text_bytes_ = 0;
+};
+
+/// ECDSA P-256 verification of `digest` (32 bytes, big-endian like all
+/// the other operands). Returns ok for a valid signature, corrupt for a
+/// well-formed one that does not verify, and invalid_argument when r or s
+/// is out of range or the key is not on the curve.
+Status p256_verify(const std::uint8_t* key_x, const std::uint8_t* key_y, const std::uint8_t* digest,
+                   const std::uint8_t* r, const std::uint8_t* s);
+
+}  // namespace soft
+}  // namespace nucleo::crypto
@@ -0,0 +1,40 @@
+// AesGcm on soft::Gcm: the host backend, and the target one on parts
+// without the AES accelerator.
+#include "nucleo/crypto/aes_gcm.hpp"
+
+namespace nucleo::crypto {
+
+Status AesGcm::set_key(ConstByteSpan key) {
+    const Status status = soft_.set_key(key);
+    keyed_ = status == Status::ok;
+    started_ = false;
+    return status;
+}
+
+Status AesGcm::start(Direction direction, ConstByteSpan iv, ConstByteSpan aad) {
+    if (!keyed_ || iv.size() != kIvSize) {
+        return Status::invalid_argument;
+    }
+    soft_.start(direction, iv);
+    soft_.aad(aad);
+    direction_ = direction;
+    started_ = true;
+    tail_ = false;
+    return Status::ok;
+}
+
+Status AesGcm::update(ConstByteSpan in, ByteSpan out) {
+    if (!started_ || tail_ || in.size() != out.size()) {
+        return Status::invalid_argument;
+    }
+    // Same rule as the hardware path, so code tested here runs there.
+    tail_ = in.size() % kBlockSize != 0;
+    return soft_.crypt(in, out);
+}
+
+Status AesGcm::compute_tag(std::uint8_t* tag) {
+    started_ = false;
+    return soft_.finish({tag, kTagSize});
+}
+
+}  // namespace nucleo::crypto
@@ -0,0 +1,327 @@
+#include <array>
+#include <cstring>
+
+#include "nucleo/crypto/soft.hpp"
+
+namespace nucleo::crypto::soft {
+namespace {
+
+constexpr std::uint8_t rotl8(std::uint8_t x, unsigned n) {
+    return static_cast<std::uint8_t>((x << n) | (x >> (8 - n)));
+}
+
+constexpr std::uint8_t xtime(std::uint8_t x) {
+    return static_cast<std::uint8_t>((x << 1) ^ ((x & 0x80) != 0 ? 0x1B : 0));
+}
+
+// The S-box, from walking GF(2^8) by powers of 3 and its inverse together.
+constexpr std::array<std::uint8_t, 256> make_sbox() {
+    std::array<std::uint8_t, 256> box{};
+    std::uint8_t p = 1;
+    std::uint8_t q = 1;
+    do {
+        p = static_cast<std::uint8_t>(p ^ xtime(p));
+        q = static_cast<std::uint8_t>(q ^ (q << 1));
+        q = static_cast<std::uint8_t>(q ^ (q << 2));
+        q = static_cast<std::uint8_t>(q ^ (q << 4));
+        if ((q & 0x80) != 0) {
+            q = static_cast<std::uint8_t>(q ^ 0x09);
+        }
+        const std::uint8_t affine = q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4);
+        box[p] = static_cast<std::uint8_t>(affine ^ 0x63);
+    } while (p != 1);
+    box[0] = 0x63;
+    return box;
+}
+
+constexpr std::array<std::uint8_t, 256> kSbox = make_sbox();
+
+// SubBytes + MixColumns for one byte: {2s, s, s, 3s}. The other three
+// column positions are byte rotations of it, which keeps the table at 1 KB.
+constexpr std::array<std::uint32_t, 256> make_te() {
+    std::array<std::uint32_t, 256> te{};
+    for (std::size_t i = 0; i < 256; ++i) {
+        const std::uint8_t s = kSbox[i];
+        const std::uint8_t s2 = xtime(s);
+        const std::uint8_t s3 = static_cast<std::uint8_t>(s2 ^ s);
+        te[i] = (std::uint32_t{s2} << 24) | (std::uint32_t{s} << 16) | (std::uint32_t{s} << 8) | s3;
+    }
+    return te;
+}
+
+constexpr std::array<std::uint32_t, 256> kTe = make_te();
+
+inline std::uint32_t rotr(std::uint32_t x, unsigned n) { return (x >> n) | (x << (32 - n)); }
+
+inline std::uint32_t load_be32(const std::uint8_t* p) {
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+}
+
+inline void store_be32(std::uint8_t* p, std::uint32_t v) {
+    p[0] = static_cast<std::uint8_t>(v >> 24);
+    p[1] = static_cast<std::uint8_t>(v >> 16);
+    p[2] = static_cast<std::uint8_t>(v >> 8);
+    p[3] = static_cast<std::uint8_t>(v);
+}
+
+inline std::uint64_t load_be64(const std::uint8_t* p) {
+    return (std::uint64_t{load_be32(p)} << 32) | load_be32(p + 4);
+}
+
+inline void store_be64(std::uint8_t* p, std::uint64_t v) {
+    store_be32(p, static_cast<std::uint32_t>(v >> 32));
+    store_be32(p + 4, static_cast<std::uint32_t>(v));
+}
+
+inline std::uint32_t sub_word(std::uint32_t w) {
+    return (std::uint32_t{kSbox[w >> 24]} << 24) | (std::uint32_t{kSbox[(w >> 16) & 0xFF]} << 16) |
+           (std::uint32_t{kSbox[(w >> 8) & 0xFF]} << 8) | kSbox[w & 0xFF];
+}
+
+inline std::uint32_t mix(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) {
+    return kTe[a >> 24] ^ rotr(kTe[(b >> 16) & 0xFF], 8) ^ rotr(kTe[(c >> 8) & 0xFF], 16) ^
+           rotr(kTe[d & 0xFF], 24);
+}
+
+inline std::uint32_t last(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) {
+    return (std::uint32_t{kSbox[a >> 24]} << 24) | (std::uint32_t{kSbox[(b >> 16) & 0xFF]} << 16) |
+           (std::uint32_t{kSbox[(c >> 8) & 0xFF]} << 8) | kSbox[d & 0xFF];
+}
+
+// Reduction constants for the four bits shifted out per GHASH table step.
+constexpr std::uint64_t kLast4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+};
+
+void increment32(std::uint8_t* block) {
+    store_be32(block + 12, load_be32(block + 12) + 1);
+}
+
+}  // namespace
+
+Status Aes::set_key(ConstByteSpan key) {
+    if (key.size() != 16 && key.size() != 32) {
+        return Status::invalid_argument;
+    }
+    const std::size_t nk = key.size() / 4;
+    rounds_ = nk + 6;
+    const std::size_t words = 4 * (rounds_ + 1);
+    for (std::size_t i = 0; i < nk; ++i) {
+        round_keys_[i] = load_be32(key.data() + 4 * i);
+    }
+    std::uint8_t rcon = 1;
+    for (std::size_t i = nk; i < words; ++i) {
+        std::uint32_t t = round_keys_[i - 1];
+        if (i % nk == 0) {
+            t = sub_word((t << 8) | (t >> 24)) ^ (std::uint32_t{rcon} << 24);
+            rcon = xtime(rcon);
+        } else if (nk > 6 && i % nk == 4) {
+            t = sub_word(t);
+        }
+        round_keys_[i] = round_keys_[i - nk] ^ t;
+    }
+    return Status::ok;
+}
+
+void Aes::encrypt_block(const std::uint8_t* in, std::uint8_t* out) const {
+    const std::uint32_t* rk = round_keys_;
+    std::uint32_t s0 = load_be32(in) ^ rk[0];
+    std::uint32_t s1 = load_be32(in + 4) ^ rk[1];
+    std::uint32_t s2 = load_be32(in + 8) ^ rk[2];
+    std::uint32_t s3 = load_be32(in + 12) ^ rk[3];
+    for (std::size_t r = 1; r < rounds_; ++r) {
+        rk += 4;
+        const std::uint32_t t0 = mix(s0, s1, s2, s3) ^ rk[0];
+        const std::uint32_t t1 = mix(s1, s2, s3, s0) ^ rk[1];
+        const std::uint32_t t2 = mix(s2, s3, s0, s1) ^ rk[2];
+        const std::uint32_t t3 = mix(s3, s0, s1, s2) ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+    rk += 4;
+    store_be32(out, last(s0, s1, s2, s3) ^ rk[0]);
+    store_be32(out + 4, last(s1, s2, s3, s0) ^ rk[1]);
+    store_be32(out + 8, last(s2, s3, s0, s1) ^ rk[2]);
+    store_be32(out + 12, last(s3, s0, s1, s2) ^ rk[3]);
+}
+
+Status Gcm::set_key(ConstByteSpan key) {
+    const Status status = aes_.set_key(key);
+    if (status != Status::ok) {
+        return status;
+    }
+    // Shoup's 4-bit tables: entry i holds i * H, bit-reflected.
+    std::uint8_t h[16] = {};
+    aes_.encrypt_block(h, h);
+    std::uint64_t vh = load_be64(h);
+    std::uint64_t vl = load_be64(h + 8);
+    table_hi_[0] = table_lo_[0] = 0;
+    table_hi_[8] = vh;
+    table_lo_[8] = vl;
+    for (std::size_t i = 4; i > 0; i >>= 1) {
+        const std::uint64_t carry = (vl & 1) * 0xe1000000u;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (carry << 32);
+        table_hi_[i] = vh;
+        table_lo_[i] = vl;
+    }
+    for (std::size_t i = 2; i <= 8; i *= 2) {
+        for (std::size_t j = 1; j < i; ++j) {
+            table_hi_[i + j] = table_hi_[i] ^ table_hi_[j];
+            table_lo_[i + j] = table_lo_[i] ^ table_lo_[j];
+        }
+    }
+    keyed_ = true;
+    started_ = false;
+    return Status::ok;
+}
+
+Status Gcm::start(Direction direction, ConstByteSpan iv) {
+    if (!keyed_ || iv.size() != kIvSize) {
+        return Status::invalid_argument;
+    }
+    direction_ = direction;
+    std::memcpy(j0_, iv.data(), kIvSize);
+    store_be32(j0_ + 12, 1);
+    std::memcpy(counter_, j0_, sizeof counter_);
+    increment32(counter_);
+    std::memset(y_, 0, sizeof y_);
+    keystream_used_ = sizeof keystream_;
+    partial_size_ = 0;
+    aad_bytes_ = text_bytes_ = 0;
+    in_payload_ = false;
+    started_ = true;
+    return Status::ok;
+}
+
+void Gcm::ghash_block(const std::uint8_t* block) {
+    std::uint8_t x[16];
+    for (std::size_t i = 0; i < 16; ++i) {
+        x[i] = static_cast<std::uint8_t>(y_[i] ^ block[i]);
+    }
+    std::size_t lo = x[15] & 0x0F;
+    std::uint64_t zh = table_hi_[lo];
+    std::uint64_t zl = table_lo_[lo];
+    for (int i = 15; i >= 0; --i) {
+        lo = x[i] & 0x0F;
+        const std::size_t hi = x[i] >> 4;
+        if (i != 15) {
+            const std::size_t rem = zl & 0x0F;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (kLast4[rem] << 48);
+            zh ^= table_hi_[lo];
+            zl ^= table_lo_[lo];
+        }
+        const std::size_t rem = zl & 0x0F;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (kLast4[rem] << 48);
+        zh ^= table_hi_[hi];
+        zl ^= table_lo_[hi];
+    }
+    store_be64(y_, zh);
+    store_be64(y_ + 8, zl);
+}
+
+void Gcm::flush_ghash() {
+    if (partial_size_ != 0) {
+        std::memset(partial_ + partial_size_, 0, 16 - partial_size_);
+        ghash_block(partial_);
+        partial_size_ = 0;
+    }
+}
+
+void Gcm::ghash_bytes(const std::uint8_t* data, std::size_t size) {
+    while (size != 0) {
+        if (partial_size_ == 0 && size >= 16) {
+            ghash_block(data);
+            data += 16;
+            size -= 16;
+            continue;
+        }
+        const std::size_t take = size < 16 - partial_size_ ? size : 16 - partial_size_;
+        std::memcpy(partial_ + partial_size_, data, take);
+        partial_size_ += take;
+        data += take;
+        size -= take;
+        if (partial_size_ == 16) {
+            ghash_block(partial_);
+            partial_size_ = 0;
+        }
+    }
+}
+
+Status Gcm::aad(ConstByteSpan data) {
+    if (!started_ || in_payload_) {
+        return Status::invalid_argument;
+    }
+    ghash_bytes(data.data(), data.size());
+    aad_bytes_ += data.size();
+    return Status::ok;
+}
+
+Status Gcm::crypt(ConstByteSpan in, ByteSpan out) {
+    if (!started_ || out.size() != in.size()) {
+        return Status::invalid_argument;
+    }
+    if (!in_payload_) {
+        flush_ghash();
+        in_payload_ = true;
+    }
+    const bool encrypting = direction_ == Direction::encrypt;
+    // The keystream position and the GHASH partial block stay in step:
+    // both restart at the first payload byte.
+    std::size_t i = 0;
+    while (i < in.size()) {
+        if (keystream_used_ == 16) {
+            aes_.encrypt_block(counter_, keystream_);
+            increment32(counter_);
+            keystream_used_ = 0;
+            if (in.size() - i >= 16) {
+                std::uint8_t cipher[16];
+                for (std::size_t k = 0; k < 16; ++k) {
+                    const std::uint8_t x = in[i + k];
+                    const std::uint8_t y = static_cast<std::uint8_t>(x ^ keystream_[k]);
+                    cipher[k] = encrypting ? y : x;
+                    out[i + k] = y;
+                }
+                ghash_block(cipher);
+                keystream_used_ = 16;
+                i += 16;
+                continue;
+            }
+        }
+        const std::uint8_t x = in[i];
+        const std::uint8_t y = static_cast<std::uint8_t>(x ^ keystream_[keystream_used_++]);
+        partial_[partial_size_++] = encrypting ? y : x;
+        out[i++] = y;
+        if (partial_size_ == 16) {
+            ghash_block(partial_);
+            partial_size_ = 0;
+        }
+    }
+    text_bytes_ += in.size();
+    return Status::ok;
+}
+
+Status Gcm::finish(ByteSpan tag) {
+    if (!started_ || tag.size() != kTagSize) {
+        return Status::invalid_argument;
+    }
+    flush_ghash();
+    std::uint8_t lengths[16];
+    store_be64(lengths, aad_bytes_ * 8);
+    store_be64(lengths + 8, text_bytes_ * 8);
+    ghash_block(lengths);
+    std::uint8_t mask[16];
+    aes_.encrypt_block(j0_, mask);
+    for (std::size_t i = 0; i < kTagSize; ++i) {
+        tag[i] = static_cast<std::uint8_t>(y_[i] ^ mask[i]);
+    }
+    started_ = false;
+    return Status::ok;
+}
+
+}  // namespace nucleo::crypto::soft
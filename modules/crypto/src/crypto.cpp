@@ -0,0 +1,73 @@
+// The parts of the front ends that do not depend on the backend.
+#include <cstring>
+
+#include "nucleo/crypto/aes_gcm.hpp"
+#include "nucleo/crypto/ecdsa.hpp"
+
+namespace nucleo::crypto {
+
+Status AesGcm::finish(ByteSpan tag) {
+    if (!started_ || direction_ != Direction::encrypt || tag.size() != kTagSize) {
+        return Status::invalid_argument;
+    }
+    return compute_tag(tag.data());
+}
+
+Status AesGcm::finish_verify(ConstByteSpan tag) {
+    if (!started_ || direction_ != Direction::decrypt || tag.size() != kTagSize) {
+        return Status::invalid_argument;
+    }
+    std::uint8_t expected[kTagSize];
+    const Status status = compute_tag(expected);
+    if (status != Status::ok) {
+        return status;
+    }
+    // Every byte is compared, so the time taken says nothing about where
+    // a forged tag first differs.
+    std::uint8_t diff = 0;
+    for (std::size_t i = 0; i < kTagSize; ++i) {
+        diff = static_cast<std::uint8_t>(diff | (expected[i] ^ tag[i]));
+    }
+    return diff == 0 ? Status::ok : Status::corrupt;
+}
+
+Status aes_gcm_seal(ConstByteSpan key, ConstByteSpan iv, ConstByteSpan aad, ConstByteSpan plaintext,
+                    ByteSpan ciphertext, ByteSpan tag) {
+    AesGcm gcm;
+    Status status = gcm.set_key(key);
+    if (status == Status::ok) {
+        status = gcm.start(Direction::encrypt, iv, aad);
+    }
+    if (status == Status::ok) {
+        status = gcm.update(plaintext, ciphertext);
+    }
+    return status == Status::ok ? gcm.finish(tag) : status;
+}
+
+Status aes_gcm_open(ConstByteSpan key, ConstByteSpan iv, ConstByteSpan aad, ConstByteSpan ciphertext,
+                    ConstByteSpan tag, ByteSpan plaintext) {
+    AesGcm gcm;
+    Status status = gcm.set_key(key);
+    if (status == Status::ok) {
+        status = gcm.start(Direction::decrypt, iv, aad);
+    }
+    if (status == Status::ok) {
+        status = gcm.update(ciphertext, plaintext);
+    }
+    if (status == Status::ok) {
+        status = gcm.finish_verify(tag);
+    }
+    if (status != Status::ok && plaintext.size() == ciphertext.size()) {
+        std::memset(plaintext.data(), 0, plaintext.size());
+    }
+    return status;
+}
+
+Status verify_image(Span<const ConstByteSpan> segments, const P256PublicKey& key,
+                    const P256Signature& signature) {
+    Sha256Digest digest;
+    const Status status = sha256(segments, digest);
+    return status == Status::ok ? ecdsa_p256_verify(key, digest, signature) : status;
+}
+
+}  // namespace nucleo::crypto
@@ -0,0 +1,11 @@
+// ECDSA verification on the CPU: the host backend, and the target one on
+// parts without the PKA.
+#include "nucleo/crypto/ecdsa.hpp"
+
+namespace nucleo::crypto {
+
+Status ecdsa_p256_verify(const P256PublicKey& key, const Sha256Digest& digest, const P256Signature& signature) {
+    return soft::p256_verify(key.x.data(), key.y.data(), digest.data(), signature.r.data(), signature.s.data());
+}
+
+}  // namespace nucleo::crypto
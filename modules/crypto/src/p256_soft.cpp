@@ -0,0 +1,283 @@
+// ECDSA P-256 verification (FIPS 186-4) on 8 x 32-bit limbs: Montgomery
+// arithmetic for both the field and the group order, Jacobian points and
+// a joint double-and-add for u1*G + u2*Q. Verification only handles
+// public values, so it favours brevity over constant time.
+#include "nucleo/crypto/soft.hpp"
+
+namespace nucleo::crypto::soft {
+namespace {
+
+constexpr std::size_t kLimbs = 8;
+
+struct U256 {
+    std::uint32_t w[kLimbs];  // least significant limb first
+};
+
+constexpr U256 kP = {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF}};
+constexpr U256 kN = {{0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF}};
+constexpr U256 kB = {{0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0, 0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8}};
+constexpr U256 kGx = {{0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2}};
+constexpr U256 kGy = {{0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2}};
+
+U256 from_be(const std::uint8_t* p) {
+    U256 r{};
+    for (std::size_t i = 0; i < kLimbs; ++i) {
+        const std::uint8_t* q = p + 4 * (kLimbs - 1 - i);
+        r.w[i] = (std::uint32_t{q[0]} << 24) | (std::uint32_t{q[1]} << 16) | (std::uint32_t{q[2]} << 8) | q[3];
+    }
+    return r;
+}
+
+int compare(const U256& a, const U256& b) {
+    for (std::size_t i = kLimbs; i-- > 0;) {
+        if (a.w[i] != b.w[i]) {
+            return a.w[i] < b.w[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+bool is_zero(const U256& a) {
+    std::uint32_t any = 0;
+    for (const std::uint32_t limb : a.w) {
+        any |= limb;
+    }
+    return any == 0;
+}
+
+bool bit(const U256& a, std::size_t i) { return ((a.w[i / 32] >> (i % 32)) & 1) != 0; }
+
+std::uint32_t add(U256& r, const U256& a, const U256& b) {
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < kLimbs; ++i) {
+        carry += std::uint64_t{a.w[i]} + b.w[i];
+        r.w[i] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+    }
+    return static_cast<std::uint32_t>(carry);
+}
+
+std::uint32_t sub(U256& r, const U256& a, const U256& b) {
+    std::int64_t borrow = 0;
+    for (std::size_t i = 0; i < kLimbs; ++i) {
+        borrow += std::int64_t{a.w[i]} - b.w[i];
+        r.w[i] = static_cast<std::uint32_t>(borrow);
+        borrow >>= 32;  // arithmetic: 0 or -1
+    }
+    return borrow != 0 ? 1 : 0;
+}
+
+// Arithmetic modulo an odd m > 2^255, operands in Montgomery form
+// (a * 2^256 mod m) unless noted.
+class Modulus {
+public:
+    explicit Modulus(const U256& m) : m_(m) {
+        std::uint32_t inv = 1;
+        for (int i = 0; i < 5; ++i) {
+            inv *= 2 - m.w[0] * inv;  // Newton: doubles the correct low bits
+        }
+        m0inv_ = 0 - inv;
+        const U256 zero{};
+        sub(one_, zero, m);  // 2^256 - m = 2^256 mod m, as m > 2^255
+        r2_ = one_;
+        for (int i = 0; i < 256; ++i) {
+            r2_ = add_mod(r2_, r2_);
+        }
+    }
+
+    const U256& modulus() const { return m_; }
+    const U256& one() const { return one_; }
+
+    U256 add_mod(const U256& a, const U256& b) const {
+        U256 r;
+        if (add(r, a, b) != 0 || compare(r, m_) >= 0) {
+            sub(r, r, m_);
+        }
+        return r;
+    }
+
+    U256 sub_mod(const U256& a, const U256& b) const {
+        U256 r;
+        if (sub(r, a, b) != 0) {
+            add(r, r, m_);
+        }
+        return r;
+    }
+
+    U256 mul(const U256& a, const U256& b) const {
+        // CIOS: interleave each partial product with one reduction step.
+        std::uint32_t t[kLimbs + 2] = {};
+        for (std::size_t i = 0; i < kLimbs; ++i) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < kLimbs; ++j) {
+                const std::uint64_t s = std::uint64_t{t[j]} + std::uint64_t{a.w[j]} * b.w[i] + carry;
+                t[j] = static_cast<std::uint32_t>(s);
+                carry = s >> 32;
+            }
+            std::uint64_t s = std::uint64_t{t[kLimbs]} + carry;
+            t[kLimbs] = static_cast<std::uint32_t>(s);
+            t[kLimbs + 1] = static_cast<std::uint32_t>(s >> 32);
+
+            const std::uint32_t q = t[0] * m0inv_;
+            carry = (std::uint64_t{t[0]} + std::uint64_t{q} * m_.w[0]) >> 32;
+            for (std::size_t j = 1; j < kLimbs; ++j) {
+                s = std::uint64_t{t[j]} + std::uint64_t{q} * m_.w[j] + carry;
+                t[j - 1] = static_cast<std::uint32_t>(s);
+                carry = s >> 32;
+            }
+            s = std::uint64_t{t[kLimbs]} + carry;
+            t[kLimbs - 1] = static_cast<std::uint32_t>(s);
+            t[kLimbs] = t[kLimbs + 1] + static_cast<std::uint32_t>(s >> 32);
+        }
+        U256 r;
+        for (std::size_t i = 0; i < kLimbs; ++i) {
+            r.w[i] = t[i];
+        }
+        if (t[kLimbs] != 0 || compare(r, m_) >= 0) {
+            sub(r, r, m_);
+        }
+        return r;
+    }
+
+    U256 sqr(const U256& a) const { return mul(a, a); }
+    /// Plain -> Montgomery; `a` must already be below m.
+    U256 to_mont(const U256& a) const { return mul(a, r2_); }
+    U256 from_mont(const U256& a) const {
+        U256 unit{};
+        unit.w[0] = 1;
+        return mul(a, unit);
+    }
+
+    /// a^(m-2) = 1/a by Fermat, for prime m.
+    U256 inverse(const U256& a) const {
+        U256 e;
+        U256 two{};
+        two.w[0] = 2;
+        sub(e, m_, two);
+        U256 r = one_;
+        for (std::size_t i = 256; i-- > 0;) {
+            r = sqr(r);
+            if (bit(e, i)) {
+                r = mul(r, a);
+            }
+        }
+        return r;
+    }
+
+private:
+    U256 m_;
+    U256 one_{};
+    U256 r2_{};
+    std::uint32_t m0inv_ = 0;
+};
+
+struct Point {
+    U256 x, y, z;  // Jacobian, Montgomery form; z == 0 is the point at infinity
+};
+
+Point dbl(const Modulus& f, const Point& p) {
+    if (is_zero(p.z)) {
+        return p;
+    }
+    // dbl-2001-b, for a = -3.
+    const U256 delta = f.sqr(p.z);
+    const U256 gamma = f.sqr(p.y);
+    const U256 beta = f.mul(p.x, gamma);
+    U256 alpha = f.mul(f.sub_mod(p.x, delta), f.add_mod(p.x, delta));
+    alpha = f.add_mod(alpha, f.add_mod(alpha, alpha));
+    const U256 beta2 = f.add_mod(beta, beta);
+    const U256 beta4 = f.add_mod(beta2, beta2);
+    const U256 beta8 = f.add_mod(beta4, beta4);
+    Point r;
+    r.x = f.sub_mod(f.sqr(alpha), beta8);
+    r.z = f.sub_mod(f.sub_mod(f.sqr(f.add_mod(p.y, p.z)), gamma), delta);
+    const U256 gamma2 = f.sqr(gamma);
+    const U256 gamma4 = f.add_mod(gamma2, gamma2);
+    const U256 gamma8 = f.add_mod(gamma4, gamma4);
+    r.y = f.sub_mod(f.mul(alpha, f.sub_mod(beta4, r.x)), f.add_mod(gamma8, gamma8));
+    return r;
+}
+
+Point add(const Modulus& f, const Point& p, const Point& q) {
+    if (is_zero(p.z)) {
+        return q;
+    }
+    if (is_zero(q.z)) {
+        return p;
+    }
+    // add-2007-bl without the doubled intermediates.
+    const U256 z1z1 = f.sqr(p.z);
+    const U256 z2z2 = f.sqr(q.z);
+    const U256 u1 = f.mul(p.x, z2z2);
+    const U256 u2 = f.mul(q.x, z1z1);
+    const U256 s1 = f.mul(p.y, f.mul(q.z, z2z2));
+    const U256 s2 = f.mul(q.y, f.mul(p.z, z1z1));
+    const U256 h = f.sub_mod(u2, u1);
+    const U256 r = f.sub_mod(s2, s1);
+    if (is_zero(h)) {
+        return is_zero(r) ? dbl(f, p) : Point{};
+    }
+    const U256 hh = f.sqr(h);
+    const U256 hhh = f.mul(h, hh);
+    const U256 v = f.mul(u1, hh);
+    Point out;
+    out.x = f.sub_mod(f.sub_mod(f.sqr(r), hhh), f.add_mod(v, v));
+    out.y = f.sub_mod(f.mul(r, f.sub_mod(v, out.x)), f.mul(s1, hhh));
+    out.z = f.mul(f.mul(p.z, q.z), h);
+    return out;
+}
+
+}  // namespace
+
+Status p256_verify(const std::uint8_t* key_x, const std::uint8_t* key_y, const std::uint8_t* digest,
+                   const std::uint8_t* r_bytes, const std::uint8_t* s_bytes) {
+    const U256 r = from_be(r_bytes);
+    const U256 s = from_be(s_bytes);
+    const U256 qx = from_be(key_x);
+    const U256 qy = from_be(key_y);
+    if (is_zero(r) || is_zero(s) || compare(r, kN) >= 0 || compare(s, kN) >= 0 || compare(qx, kP) >= 0 ||
+        compare(qy, kP) >= 0) {
+        return Status::invalid_argument;
+    }
+    const Modulus fp(kP);
+    const Modulus fn(kN);
+
+    // The key must satisfy y^2 = x^3 - 3x + b.
+    const Point q{fp.to_mont(qx), fp.to_mont(qy), fp.one()};
+    const U256 x3 = fp.mul(fp.sqr(q.x), q.x);
+    const U256 three_x = fp.add_mod(q.x, fp.add_mod(q.x, q.x));
+    if (compare(fp.sqr(q.y), fp.add_mod(fp.sub_mod(x3, three_x), fp.to_mont(kB))) != 0) {
+        return Status::invalid_argument;
+    }
+
+    U256 e = from_be(digest);
+    if (compare(e, kN) >= 0) {
+        sub(e, e, kN);
+    }
+    const U256 w = fn.inverse(fn.to_mont(s));
+    const U256 u1 = fn.from_mont(fn.mul(fn.to_mont(e), w));
+    const U256 u2 = fn.from_mont(fn.mul(fn.to_mont(r), w));
+
+    const Point g{fp.to_mont(kGx), fp.to_mont(kGy), fp.one()};
+    const Point gq = add(fp, g, q);
+    Point acc{};
+    for (std::size_t i = 256; i-- > 0;) {
+        acc = dbl(fp, acc);
+        const bool b1 = bit(u1, i);
+        const bool b2 = bit(u2, i);
+        if (b1 || b2) {
+            acc = add(fp, acc, b1 && b2 ? gq : (b1 ? g : q));
+        }
+    }
+    if (is_zero(acc.z)) {
+        return Status::corrupt;
+    }
+    const U256 zinv = fp.inverse(acc.z);
+    U256 x = fp.from_mont(fp.mul(acc.x, fp.sqr(zinv)));
+    if (compare(x, kN) >= 0) {
+        sub(x, x, kN);
+    }
+    return compare(x, r) == 0 ? Status::ok : Status::corrupt;
+}
+
+}  // namespace nucleo::crypto::soft
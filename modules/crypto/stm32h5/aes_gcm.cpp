@@ -0,0 +1,229 @@
+// AES-GCM on the AES accelerator (STM32H573 only; see aes_gcm.hpp), with
+// GPDMA1 channel 6 (memory -> DINR) and channel 7 (DOUTR -> memory) for the
+// payload phase.
+#include "stm32h5xx.h"
+
+#include <cstring>
+
+#include "nucleo/crypto/aes_gcm.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::crypto {
+namespace {
+
+// RM0481, GPDMA1 request mapping.
+constexpr std::uint32_t kRequestAesIn = 98;
+constexpr std::uint32_t kRequestAesOut = 99;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+constexpr std::uint32_t kDmaErrors = DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF;
+constexpr std::uint32_t kWords = (2u << DMA_CTR1_SDW_LOG2_Pos) | (2u << DMA_CTR1_DDW_LOG2_Pos);
+constexpr std::uint32_t kMaxDmaBytes = 65520;  // BNDT limit rounded down to blocks
+constexpr std::uint32_t kTimeoutMs = 100;
+
+// CR fields. GCM is CHMOD = 0b011; GCMPH selects init, header, payload
+// and final phases.
+constexpr std::uint32_t kChmodGcm = AES_CR_CHMOD_0 | AES_CR_CHMOD_1;
+constexpr std::uint32_t kPhaseInit = 0;
+constexpr std::uint32_t kPhaseHeader = AES_CR_GCMPH_0;
+constexpr std::uint32_t kPhasePayload = AES_CR_GCMPH_1;
+constexpr std::uint32_t kPhaseFinal = AES_CR_GCMPH_0 | AES_CR_GCMPH_1;
+constexpr std::uint32_t kByteSwap = AES_CR_DATATYPE_1;
+
+DMA_Channel_TypeDef* const kInChannel = GPDMA1_Channel6;
+DMA_Channel_TypeDef* const kOutChannel = GPDMA1_Channel7;
+
+std::uint32_t load_be32(const std::uint8_t* p) {
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+}
+
+Status wait_ccf() {
+    const std::uint32_t start = platform::millis();
+    while ((AES->SR & AES_SR_CCF) == 0) {
+        if (platform::millis() - start > kTimeoutMs) {
+            return Status::timeout;
+        }
+    }
+    AES->ICR = AES_ICR_CCF;
+    return Status::ok;
+}
+
+void set_phase(std::uint32_t phase) { AES->CR = (AES->CR & ~AES_CR_GCMPH) | phase; }
+
+// One block through DINR/DOUTR by the CPU; `in` is zero-padded to 16.
+Status block(const std::uint8_t* in, std::uint8_t* out) {
+    for (std::size_t w = 0; w < 4; ++w) {
+        std::uint32_t word;
+        std::memcpy(&word, in + 4 * w, sizeof word);
+        AES->DINR = word;
+    }
+    const Status status = wait_ccf();
+    for (std::size_t w = 0; w < 4; ++w) {
+        const std::uint32_t word = AES->DOUTR;
+        if (out != nullptr) {
+            std::memcpy(out + 4 * w, &word, sizeof word);
+        }
+    }
+    return status;
+}
+
+void dma_channel(DMA_Channel_TypeDef* ch, std::uint32_t ctr1, std::uint32_t ctr2, std::uint32_t src,
+                 std::uint32_t dst, std::uint32_t bytes) {
+    ch->CCR = DMA_CCR_RESET;
+    ch->CTR1 = ctr1;
+    ch->CTR2 = ctr2;
+    ch->CBR1 = bytes;
+    ch->CSAR = src;
+    ch->CDAR = dst;
+    ch->CLLR = 0;
+    ch->CFCR = kDmaAllFlags;
+    ch->CCR = DMA_CCR_EN;
+}
+
+// Whole blocks through both DMA channels; the output channel finishing
+// means every block has been through the core.
+Status dma_blocks(const std::uint8_t* in, std::uint8_t* out, std::uint32_t bytes) {
+    dma_channel(kOutChannel, kWords | DMA_CTR1_DINC, kRequestAesOut << DMA_CTR2_REQSEL_Pos,
+                reinterpret_cast<std::uint32_t>(&AES->DOUTR), reinterpret_cast<std::uint32_t>(out), bytes);
+    dma_channel(kInChannel, kWords | DMA_CTR1_SINC, (kRequestAesIn << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ,
+                reinterpret_cast<std::uint32_t>(in), reinterpret_cast<std::uint32_t>(&AES->DINR), bytes);
+    AES->CR |= AES_CR_DMAINEN | AES_CR_DMAOUTEN;
+    const std::uint32_t start = platform::millis();
+    while ((kOutChannel->CSR & DMA_CSR_TCF) == 0) {
+        if (platform::millis() - start > kTimeoutMs) {
+            kInChannel->CCR = DMA_CCR_RESET;
+            kOutChannel->CCR = DMA_CCR_RESET;
+            return Status::timeout;
+        }
+    }
+    AES->CR &= ~(AES_CR_DMAINEN | AES_CR_DMAOUTEN);
+    const bool failed = ((kInChannel->CSR | kOutChannel->CSR) & kDmaErrors) != 0;
+    kInChannel->CFCR = kDmaAllFlags;
+    kOutChannel->CFCR = kDmaAllFlags;
+    return failed ? Status::hardware_error : Status::ok;
+}
+
+}  // namespace
+
+Status AesGcm::set_key(ConstByteSpan key) {
+    if (key.size() != 16 && key.size() != 32) {
+        return Status::invalid_argument;
+    }
+    key_words_ = key.size() / 4;
+    for (std::size_t i = 0; i < key_words_; ++i) {
+        key_[i] = load_be32(key.data() + 4 * i);
+    }
+    keyed_ = true;
+    started_ = false;
+    return Status::ok;
+}
+
+Status AesGcm::start(Direction direction, ConstByteSpan iv, ConstByteSpan aad) {
+    if (!keyed_ || iv.size() != kIvSize) {
+        return Status::invalid_argument;
+    }
+    RCC->AHB2ENR |= RCC_AHB2ENR_AESEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPDMA1EN;
+    (void)RCC->AHB2ENR;
+
+    // Init phase: the core derives H = E(K, 0) from the key.
+    AES->CR = 0;
+    AES->CR = kChmodGcm | kByteSwap | kPhaseInit | (direction == Direction::decrypt ? AES_CR_MODE_1 : 0) |
+              (key_words_ == 8 ? AES_CR_KEYSIZE : 0);
+    // KEYR0 holds the least significant word of the key.
+    volatile std::uint32_t* const keyr_low[] = {&AES->KEYR0, &AES->KEYR1, &AES->KEYR2, &AES->KEYR3};
+    volatile std::uint32_t* const keyr_high[] = {&AES->KEYR4, &AES->KEYR5, &AES->KEYR6, &AES->KEYR7};
+    for (std::size_t i = 0; i < key_words_; ++i) {
+        const std::size_t r = key_words_ - 1 - i;
+        *(r < 4 ? keyr_low[r] : keyr_high[r - 4]) = key_[i];
+    }
+    AES->IVR3 = load_be32(iv.data());
+    AES->IVR2 = load_be32(iv.data() + 4);
+    AES->IVR1 = load_be32(iv.data() + 8);
+    AES->IVR0 = 2;  // the payload counter starts after J0
+    AES->CR |= AES_CR_EN;
+    Status status = wait_ccf();
+
+    // Header phase, block by block from the CPU.
+    set_phase(kPhaseHeader);
+    AES->CR |= AES_CR_EN;
+    for (std::size_t at = 0; at < aad.size() && status == Status::ok; at += kBlockSize) {
+        std::uint8_t padded[kBlockSize] = {};
+        const std::size_t n = aad.size() - at < kBlockSize ? aad.size() - at : kBlockSize;
+        std::memcpy(padded, aad.data() + at, n);
+        status = block(padded, nullptr);
+    }
+    set_phase(kPhasePayload);
+
+    direction_ = direction;
+    aad_bytes_ = aad.size();
+    text_bytes_ = 0;
+    started_ = status == Status::ok;
+    tail_ = false;
+    return status;
+}
+
+Status AesGcm::update(ConstByteSpan in, ByteSpan out) {
+    if (!started_ || tail_ || in.size() != out.size()) {
+        return Status::invalid_argument;
+    }
+    Status status = Status::ok;
+    const std::size_t whole = in.size() - in.size() % kBlockSize;
+    // The DMA moves words, so unaligned buffers go through the CPU.
+    const bool aligned = ((reinterpret_cast<std::uintptr_t>(in.data()) |
+                           reinterpret_cast<std::uintptr_t>(out.data())) & 3) == 0;
+    for (std::size_t at = 0; at < whole && status == Status::ok;) {
+        if (aligned) {
+            const std::uint32_t n = whole - at < kMaxDmaBytes ? static_cast<std::uint32_t>(whole - at) : kMaxDmaBytes;
+            status = dma_blocks(in.data() + at, out.data() + at, n);
+            at += n;
+        } else {
+            std::uint8_t buffer[kBlockSize];
+            std::memcpy(buffer, in.data() + at, kBlockSize);
+            status = block(buffer, buffer);
+            std::memcpy(out.data() + at, buffer, kBlockSize);
+            at += kBlockSize;
+        }
+    }
+    const std::size_t rest = in.size() - whole;
+    if (rest != 0 && status == Status::ok) {
+        // NPBLB tells the core how many padding bytes the last block has,
+        // so they stay out of the tag.
+        std::uint8_t buffer[kBlockSize] = {};
+        std::memcpy(buffer, in.data() + whole, rest);
+        AES->CR = (AES->CR & ~AES_CR_NPBLB) | ((kBlockSize - rest) << AES_CR_NPBLB_Pos);
+        status = block(buffer, buffer);
+        std::memcpy(out.data() + whole, buffer, rest);
+        tail_ = true;
+    }
+    text_bytes_ += in.size();
+    if (status != Status::ok) {
+        started_ = false;
+        AES->CR = 0;
+    }
+    return status;
+}
+
+Status AesGcm::compute_tag(std::uint8_t* tag) {
+    started_ = false;
+    // The length block is written as plain words: no byte swapping.
+    AES->CR = (AES->CR & ~(AES_CR_GCMPH | AES_CR_DATATYPE)) | kPhaseFinal;
+    AES->DINR = static_cast<std::uint32_t>((aad_bytes_ * 8) >> 32);
+    AES->DINR = static_cast<std::uint32_t>(aad_bytes_ * 8);
+    AES->DINR = static_cast<std::uint32_t>((text_bytes_ * 8) >> 32);
+    AES->DINR = static_cast<std::uint32_t>(text_bytes_ * 8);
+    const Status status = wait_ccf();
+    for (std::size_t w = 0; w < 4; ++w) {
+        const std::uint32_t word = AES->DOUTR;
+        tag[4 * w] = static_cast<std::uint8_t>(word >> 24);
+        tag[4 * w + 1] = static_cast<std::uint8_t>(word >> 16);
+        tag[4 * w + 2] = static_cast<std::uint8_t>(word >> 8);
+        tag[4 * w + 3] = static_cast<std::uint8_t>(word);
+    }
+    AES->CR = 0;
+    return status;
+}
+
+}  // namespace nucleo::crypto
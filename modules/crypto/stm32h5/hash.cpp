@@ -0,0 +1,277 @@
+// HASH with GPDMA1 channel 5 (memory -> DIN), driven through a linked list.
+//
+// Each transfer is described by a chain of nodes of at most kNodeBytes; a
+// node reloads CTR1 (word or byte source, depending on alignment), CBR1,
+// CSAR and CLLR. The DMA packs byte sources into words, so a segment only
+// has to be a multiple of 4 bytes long, not 4-byte aligned. MDMAT stays
+// set for every transfer: the final partial word is written by the CPU
+// before DCAL, which keeps one code path for streams and segment lists.
+// CTR2.TCEM is "end of last LLI", so TCF (and dma_wait()) marks the end of
+// the whole chain, not of its first node: the CPU's tail word and DCAL must
+// not overtake data the chain still has to feed.
+#include "stm32h5xx.h"
+
+#include <cstring>
+
+#include "nucleo/crypto/sha256.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::crypto {
+namespace {
+
+// RM0481, GPDMA1 request mapping.
+constexpr std::uint32_t kRequestHashIn = 97;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+constexpr std::uint32_t kDmaErrors = DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF;
+
+// CR: SHA-256, bytes in memory order (DATATYPE = 8-bit swap), DMA input
+// with more transfers to come.
+constexpr std::uint32_t kCrSha256 = HASH_CR_ALGO_0 | HASH_CR_ALGO_1 | HASH_CR_DATATYPE_1;
+
+constexpr std::size_t kNodes = 32;
+constexpr std::uint32_t kNodeBytes = 65532;  // BNDT limit rounded down to words
+constexpr std::uint32_t kTimeoutMs = 1000;
+
+DMA_Channel_TypeDef* const kChannel = GPDMA1_Channel5;
+
+// Register images in CTR1, CBR1, CSAR, CLLR order, as the UT1 | UB1 | USA
+// | ULL update flags expect them.
+struct Node {
+    std::uint32_t ctr1;
+    std::uint32_t cbr1;
+    std::uint32_t csar;
+    std::uint32_t cllr;
+};
+
+// In SRAM1, as the DMA fetches them and the nodes share the CLBAR page.
+Node g_nodes[kNodes] NUCLEO_ALIGNED(4);
+bool g_claimed = false;
+
+std::uint32_t ctr1_for(const std::uint8_t* p) {
+    // Word reads where the source allows; bytes packed into words otherwise.
+    const std::uint32_t ddw = 2u << DMA_CTR1_DDW_LOG2_Pos;
+    if ((reinterpret_cast<std::uintptr_t>(p) & 3) == 0) {
+        return ddw | (2u << DMA_CTR1_SDW_LOG2_Pos) | DMA_CTR1_SINC;
+    }
+    return ddw | (2u << DMA_CTR1_PAM_Pos) | DMA_CTR1_SINC;
+}
+
+std::uint32_t link(std::size_t next) {
+    return DMA_CLLR_UT1 | DMA_CLLR_UB1 | DMA_CLLR_USA | DMA_CLLR_ULL |
+           (reinterpret_cast<std::uint32_t>(&g_nodes[next]) & DMA_CLLR_LA);
+}
+
+bool dma_busy() { return (kChannel->CCR & DMA_CCR_EN) != 0 && (kChannel->CSR & DMA_CSR_TCF) == 0; }
+
+Status dma_wait() {
+    const std::uint32_t start = platform::millis();
+    while (dma_busy()) {
+        if (platform::millis() - start > kTimeoutMs) {
+            kChannel->CCR |= DMA_CCR_SUSP;
+            kChannel->CCR = DMA_CCR_RESET;
+            return Status::timeout;
+        }
+    }
+    const bool failed = (kChannel->CSR & kDmaErrors) != 0;
+    kChannel->CFCR = kDmaAllFlags;
+    kChannel->CCR = 0;
+    return failed ? Status::hardware_error : Status::ok;
+}
+
+// Describes `segments` (lengths already multiples of 4) as a node chain
+// and starts it. Returns the bytes queued; 0 if none.
+std::size_t dma_start(const ConstByteSpan* segments, std::size_t count) {
+    std::size_t used = 0;
+    std::size_t queued = 0;
+    for (std::size_t s = 0; s < count; ++s) {
+        const std::uint8_t* p = segments[s].data();
+        std::size_t left = segments[s].size();
+        while (left != 0) {
+            const std::uint32_t n = left < kNodeBytes ? static_cast<std::uint32_t>(left) : kNodeBytes;
+            g_nodes[used] = {ctr1_for(p), n, reinterpret_cast<std::uint32_t>(p), 0};
+            if (used != 0) {
+                g_nodes[used - 1].cllr = link(used);
+            }
+            ++used;
+            p += n;
+            left -= n;
+            queued += n;
+        }
+    }
+    if (used == 0) {
+        return 0;
+    }
+    // The first node is loaded into the registers directly; the rest are
+    // fetched as each block completes.
+    const Node& first = g_nodes[0];
+    kChannel->CCR = DMA_CCR_RESET;
+    kChannel->CLBAR = reinterpret_cast<std::uint32_t>(g_nodes) & DMA_CLBAR_LBA;
+    kChannel->CTR1 = first.ctr1;
+    // Nodes do not reload CTR2, so TCEM applies to the whole chain.
+    kChannel->CTR2 = (kRequestHashIn << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ | (3u << DMA_CTR2_TCEM_Pos);
+    kChannel->CBR1 = first.cbr1;
+    kChannel->CSAR = first.csar;
+    kChannel->CDAR = reinterpret_cast<std::uint32_t>(&HASH->DIN);
+    kChannel->CLLR = first.cllr;
+    kChannel->CFCR = kDmaAllFlags;
+    HASH->CR |= HASH_CR_DMAE | HASH_CR_MDMAT;
+    kChannel->CCR = DMA_CCR_EN;
+    return queued;
+}
+
+// Nodes needed for `n` bytes.
+std::size_t nodes_for(std::size_t n) { return (n + kNodeBytes - 1) / kNodeBytes; }
+
+}  // namespace
+
+Status Sha256::start() {
+    if (active_) {
+        abort();
+    }
+    if (g_claimed) {
+        return Status::busy;
+    }
+    g_claimed = true;
+    active_ = true;
+    RCC->AHB2ENR |= RCC_AHB2ENR_HASHEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPDMA1EN;
+    (void)RCC->AHB2ENR;
+    carry_size_ = 0;
+    HASH->CR = kCrSha256;
+    HASH->CR = kCrSha256 | HASH_CR_INIT;
+    return Status::ok;
+}
+
+Status Sha256::update(ConstByteSpan data) {
+    if (!active_) {
+        return Status::invalid_argument;
+    }
+    Status status = dma_wait();
+    const std::uint8_t* p = data.data();
+    std::size_t n = data.size();
+    if (carry_size_ != 0 && status == Status::ok) {
+        const std::size_t take = n < 4 - carry_size_ ? n : 4 - carry_size_;
+        std::memcpy(carry_ + carry_size_, p, take);
+        carry_size_ += take;
+        p += take;
+        n -= take;
+        if (carry_size_ == 4) {
+            std::uint32_t word;
+            std::memcpy(&word, carry_, sizeof word);
+            HASH->DIN = word;
+            carry_size_ = 0;
+        }
+    }
+    // Whole words by DMA, in as many chained passes as the node table needs.
+    std::size_t words = n & ~std::size_t{3};
+    while (words != 0 && status == Status::ok) {
+        const std::size_t chunk = words < kNodes * kNodeBytes ? words : kNodes * kNodeBytes;
+        const ConstByteSpan segment{p, chunk};
+        dma_start(&segment, 1);
+        p += chunk;
+        n -= chunk;
+        words -= chunk;
+        if (words != 0) {
+            status = dma_wait();
+        }
+    }
+    if (status == Status::ok && n != 0) {
+        std::memcpy(carry_, p, n);
+        carry_size_ = n;
+    }
+    if (status != Status::ok) {
+        abort();
+    }
+    return status;
+}
+
+Status Sha256::finish(Sha256Digest& out) {
+    if (!active_) {
+        return Status::invalid_argument;
+    }
+    const Status status = dma_wait();
+    if (status != Status::ok) {
+        abort();
+        return status;
+    }
+    HASH->CR &= ~(HASH_CR_DMAE | HASH_CR_MDMAT);
+    if (carry_size_ != 0) {
+        std::uint32_t word = 0;
+        std::memcpy(&word, carry_, carry_size_);
+        HASH->DIN = word;
+    }
+    // NBLW counts the valid bits of the last word written; 0 means all 32.
+    HASH->STR = static_cast<std::uint32_t>(8 * carry_size_);
+    HASH->STR |= HASH_STR_DCAL;
+    const std::uint32_t start = platform::millis();
+    while ((HASH->SR & HASH_SR_DCIS) == 0) {
+        if (platform::millis() - start > kTimeoutMs) {
+            abort();
+            return Status::timeout;
+        }
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        const std::uint32_t h = HASH_DIGEST->HR[i];
+        out[4 * i] = static_cast<std::uint8_t>(h >> 24);
+        out[4 * i + 1] = static_cast<std::uint8_t>(h >> 16);
+        out[4 * i + 2] = static_cast<std::uint8_t>(h >> 8);
+        out[4 * i + 3] = static_cast<std::uint8_t>(h);
+    }
+    abort();
+    return Status::ok;
+}
+
+void Sha256::abort() {
+    if (!active_) {
+        return;
+    }
+    if (dma_busy()) {
+        kChannel->CCR |= DMA_CCR_SUSP;
+        kChannel->CCR = DMA_CCR_RESET;
+    }
+    kChannel->CFCR = kDmaAllFlags;
+    HASH->CR = 0;
+    carry_size_ = 0;
+    active_ = false;
+    g_claimed = false;
+}
+
+Status sha256(Span<const ConstByteSpan> segments, Sha256Digest& out) {
+    Sha256 hash;
+    Status status = hash.start();
+    if (status != Status::ok) {
+        return status;
+    }
+    // One chain when every segment but the last is whole words and the
+    // node table holds them all; the last one's odd bytes go in finish().
+    bool chainable = segments.size() != 0;
+    std::size_t nodes = 0;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        const bool last = i + 1 == segments.size();
+        chainable = chainable && (last || segments[i].size() % 4 == 0);
+        nodes += nodes_for(segments[i].size());
+    }
+    if (!chainable || nodes > kNodes || segments.size() > kNodes) {
+        for (std::size_t i = 0; i < segments.size() && status == Status::ok; ++i) {
+            status = hash.update(segments[i]);
+        }
+        return status == Status::ok ? hash.finish(out) : status;
+    }
+    ConstByteSpan words[kNodes];
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        words[i] = segments[i];
+    }
+    const ConstByteSpan last = segments[segments.size() - 1];
+    const std::size_t tail = last.size() % 4;
+    words[segments.size() - 1] = last.first(last.size() - tail);
+    dma_start(words, segments.size());
+    // Everything is queued; the tail joins as the stream's carry.
+    status = hash.update(last.last(tail));
+    return status == Status::ok ? hash.finish(out) : status;
+}
+
+}  // namespace nucleo::crypto
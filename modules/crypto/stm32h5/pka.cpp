@@ -0,0 +1,133 @@
+// ECDSA verification on the PKA (STM32H573 only; see ecdsa.hpp).
+//
+// Operands go into PKA RAM least significant word first, each followed by
+// a zero word; the PKA runs the whole verification (about 11 M cycles at
+// the PKA clock) and leaves a verdict word.
+#include "stm32h5xx.h"
+
+#include "nucleo/crypto/ecdsa.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::crypto {
+namespace {
+
+constexpr std::uint32_t kModeEcdsaVerify = 0x26;
+constexpr std::uint32_t kValid = 0xD60D;
+constexpr std::uint32_t kTimeoutMs = 500;
+
+// RM0481, PKA RAM map for ECDSA verification, as word offsets into RAM[]
+// (byte address - 0x400) / 4.
+constexpr std::size_t word(std::uint32_t address) { return (address - 0x400) / 4; }
+constexpr std::size_t kOrderBits = word(0x0408);
+constexpr std::size_t kModulusBits = word(0x04C8);
+constexpr std::size_t kCoeffSign = word(0x0468);
+constexpr std::size_t kCoeffA = word(0x046C);
+constexpr std::size_t kModulus = word(0x04D0);
+constexpr std::size_t kGx = word(0x0678);
+constexpr std::size_t kGy = word(0x06D0);
+constexpr std::size_t kS = word(0x0A44);
+constexpr std::size_t kOrder = word(0x0D5C);
+constexpr std::size_t kR = word(0x0EE8);
+constexpr std::size_t kQx = word(0x0F40);
+constexpr std::size_t kQy = word(0x0F98);
+constexpr std::size_t kHash = word(0x0FE8);
+constexpr std::size_t kResult = word(0x05B0);
+
+// P-256 domain parameters, big-endian.
+constexpr std::uint8_t kP[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+constexpr std::uint8_t kN[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51,
+};
+constexpr std::uint8_t kGxBytes[32] = {
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+};
+constexpr std::uint8_t kGyBytes[32] = {
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5,
+};
+
+void put(std::size_t at, const std::uint8_t* be) {
+    for (std::size_t i = 0; i < 8; ++i) {
+        const std::uint8_t* p = be + 4 * (7 - i);
+        PKA->RAM[at + i] =
+            (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+    }
+    PKA->RAM[at + 8] = 0;
+}
+
+bool in_range(const std::uint8_t* be, const std::uint8_t* limit) {
+    for (std::size_t i = 0; i < 32; ++i) {
+        if (be[i] != limit[i]) {
+            return be[i] < limit[i];
+        }
+    }
+    return false;
+}
+
+bool is_zero(const std::uint8_t* be) {
+    std::uint8_t any = 0;
+    for (std::size_t i = 0; i < 32; ++i) {
+        any = static_cast<std::uint8_t>(any | be[i]);
+    }
+    return any == 0;
+}
+
+}  // namespace
+
+Status ecdsa_p256_verify(const P256PublicKey& key, const Sha256Digest& digest, const P256Signature& signature) {
+    // The PKA answers "invalid" for these too; checking first keeps the
+    // status codes the same as the software path.
+    if (is_zero(signature.r.data()) || is_zero(signature.s.data()) || !in_range(signature.r.data(), kN) ||
+        !in_range(signature.s.data(), kN) || !in_range(key.x.data(), kP) || !in_range(key.y.data(), kP)) {
+        return Status::invalid_argument;
+    }
+    RCC->AHB2ENR |= RCC_AHB2ENR_PKAEN | RCC_AHB2ENR_RNGEN;
+    (void)RCC->AHB2ENR;
+    PKA->CR = PKA_CR_EN;
+    const std::uint32_t start = platform::millis();
+    while ((PKA->SR & PKA_SR_INITOK) == 0) {
+        if (platform::millis() - start > kTimeoutMs) {
+            return Status::hardware_error;
+        }
+    }
+
+    PKA->RAM[kOrderBits] = 256;
+    PKA->RAM[kModulusBits] = 256;
+    PKA->RAM[kCoeffSign] = 1;  // a = -3
+    PKA->RAM[kCoeffA] = 3;
+    PKA->RAM[kCoeffA + 1] = 0;
+    put(kModulus, kP);
+    put(kGx, kGxBytes);
+    put(kGy, kGyBytes);
+    put(kOrder, kN);
+    put(kQx, key.x.data());
+    put(kQy, key.y.data());
+    put(kR, signature.r.data());
+    put(kS, signature.s.data());
+    put(kHash, digest.data());
+
+    PKA->CLRFR = PKA_CLRFR_PROCENDFC | PKA_CLRFR_RAMERRFC | PKA_CLRFR_ADDRERRFC | PKA_CLRFR_OPERRFC;
+    PKA->CR = PKA_CR_EN | (kModeEcdsaVerify << PKA_CR_MODE_Pos) | PKA_CR_START;
+    while ((PKA->SR & PKA_SR_PROCENDF) == 0) {
+        if (platform::millis() - start > kTimeoutMs) {
+            PKA->CR = 0;
+            return Status::timeout;
+        }
+    }
+    const bool faulted = (PKA->SR & (PKA_SR_RAMERRF | PKA_SR_ADDRERRF | PKA_SR_OPERRF)) != 0;
+    const std::uint32_t verdict = PKA->RAM[kResult];
+    PKA->CLRFR = PKA_CLRFR_PROCENDFC;
+    PKA->CR = 0;
+    if (faulted) {
+        // OPERR also flags a public key that is not on the curve.
+        return Status::invalid_argument;
+    }
+    return verdict == kValid ? Status::ok : Status::corrupt;
+}
+
+}  // namespace nucleo::crypto
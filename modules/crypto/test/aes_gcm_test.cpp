@@ -0,0 +1,140 @@
+#include <string>
+#include <vector>
+
+#include "nucleo/crypto/aes_gcm.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::crypto;
+
+namespace {
+
+std::vector<std::uint8_t> unhex(const char* s) {
+    std::vector<std::uint8_t> out;
+    auto nibble = [](char c) { return c <= '9' ? c - '0' : c - 'a' + 10; };
+    for (; s[0] != '\0' && s[1] != '\0'; s += 2) {
+        out.push_back(static_cast<std::uint8_t>(nibble(s[0]) << 4 | nibble(s[1])));
+    }
+    return out;
+}
+
+ConstByteSpan bytes(const std::vector<std::uint8_t>& v) { return {v.data(), v.size()}; }
+ByteSpan bytes(std::vector<std::uint8_t>& v) { return {v.data(), v.size()}; }
+
+// McGrew & Viega test cases 4 and 16 (the GCM specification): a 60-byte
+// message, so the last block is partial, with 20 bytes of AAD.
+const char* const kPlain =
+    "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39";
+const char* const kAad = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+const char* const kIv = "cafebabefacedbaddecaf888";
+
+struct Vector {
+    const char* key;
+    const char* cipher;
+    const char* tag;
+};
+
+const Vector kVectors[] = {
+    {"feffe9928665731c6d6a8f9467308308",
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+     "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+     "5bc94fbc3221a5db94fae95ae7121a47"},
+    {"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+     "76fc6ece0f4e1768cddf8853bb2d551b"},
+};
+
+}  // namespace
+
+TEST(seal_matches_the_gcm_spec_vectors) {
+    for (const Vector& v : kVectors) {
+        const auto plain = unhex(kPlain);
+        std::vector<std::uint8_t> cipher(plain.size());
+        std::vector<std::uint8_t> tag(AesGcm::kTagSize);
+        REQUIRE_EQ(aes_gcm_seal(bytes(unhex(v.key)), bytes(unhex(kIv)), bytes(unhex(kAad)), bytes(plain),
+                                bytes(cipher), bytes(tag)),
+                   Status::ok);
+        CHECK(cipher == unhex(v.cipher));
+        CHECK(tag == unhex(v.tag));
+    }
+}
+
+TEST(empty_message_tag_matches_test_case_1) {
+    const std::vector<std::uint8_t> zero_key(16), zero_iv(12);
+    std::vector<std::uint8_t> tag(AesGcm::kTagSize);
+    REQUIRE_EQ(aes_gcm_seal(bytes(zero_key), bytes(zero_iv), {}, {}, {}, bytes(tag)), Status::ok);
+    CHECK(tag == unhex("58e2fccefa7e3061367f1d57a4e7455a"));
+}
+
+TEST(open_round_trips_and_rejects_any_tampering) {
+    const Vector& v = kVectors[0];
+    const auto key = unhex(v.key);
+    const auto iv = unhex(kIv);
+    const auto aad = unhex(kAad);
+    const auto cipher = unhex(v.cipher);
+    const auto tag = unhex(v.tag);
+    std::vector<std::uint8_t> plain(cipher.size());
+    REQUIRE_EQ(aes_gcm_open(bytes(key), bytes(iv), bytes(aad), bytes(cipher), bytes(tag), bytes(plain)), Status::ok);
+    CHECK(plain == unhex(kPlain));
+
+    auto flip = [&](std::vector<std::uint8_t> c, std::vector<std::uint8_t> a, std::vector<std::uint8_t> t) {
+        std::vector<std::uint8_t> out(c.size(), 0xAA);
+        const Status status = aes_gcm_open(bytes(key), bytes(iv), bytes(a), bytes(c), bytes(t), bytes(out));
+        CHECK(out == std::vector<std::uint8_t>(c.size(), 0));  // nothing released
+        return status;
+    };
+    auto c = cipher;
+    c[59] ^= 0x01;
+    CHECK_EQ(flip(c, aad, tag), Status::corrupt);
+    auto a = aad;
+    a[0] ^= 0x80;
+    CHECK_EQ(flip(cipher, a, tag), Status::corrupt);
+    auto t = tag;
+    t[15] ^= 0x01;
+    CHECK_EQ(flip(cipher, aad, t), Status::corrupt);
+}
+
+TEST(block_multiple_updates_stream_like_one_call) {
+    const auto key = unhex(kVectors[1].key);
+    const auto iv = unhex(kIv);
+    std::vector<std::uint8_t> plain(1000);
+    for (std::size_t i = 0; i < plain.size(); ++i) {
+        plain[i] = static_cast<std::uint8_t>(i * 13);
+    }
+    std::vector<std::uint8_t> whole(plain.size());
+    std::vector<std::uint8_t> whole_tag(16);
+    REQUIRE_EQ(aes_gcm_seal(bytes(key), bytes(iv), {}, bytes(plain), bytes(whole), bytes(whole_tag)), Status::ok);
+
+    // Telemetry-sized pieces, encrypted in place; the partial block last.
+    AesGcm gcm;
+    REQUIRE_EQ(gcm.set_key(bytes(key)), Status::ok);
+    REQUIRE_EQ(gcm.start(Direction::encrypt, bytes(iv)), Status::ok);
+    std::vector<std::uint8_t> buffer = plain;
+    for (std::size_t at = 0; at < buffer.size(); at += 48) {
+        const std::size_t n = buffer.size() - at < 48 ? buffer.size() - at : 48;
+        REQUIRE_EQ(gcm.update({buffer.data() + at, n}, {buffer.data() + at, n}), Status::ok);
+    }
+    std::vector<std::uint8_t> tag(16);
+    REQUIRE_EQ(gcm.finish(bytes(tag)), Status::ok);
+    CHECK(buffer == whole);
+    CHECK(tag == whole_tag);
+}
+
+TEST(misuse_is_rejected) {
+    AesGcm gcm;
+    std::uint8_t buffer[32] = {};
+    std::uint8_t tag[16] = {};
+    CHECK_EQ(gcm.start(Direction::encrypt, {buffer, 12}), Status::invalid_argument);  // no key
+    CHECK_EQ(gcm.set_key({buffer, 24}), Status::invalid_argument);  // AES-192 is not offered
+    REQUIRE_EQ(gcm.set_key({buffer, 16}), Status::ok);
+    CHECK_EQ(gcm.start(Direction::encrypt, {buffer, 16}), Status::invalid_argument);
+    REQUIRE_EQ(gcm.start(Direction::encrypt, {buffer, 12}), Status::ok);
+    CHECK_EQ(gcm.update({buffer, 16}, {buffer, 15}), Status::invalid_argument);
+    REQUIRE_EQ(gcm.update({buffer, 5}, {buffer, 5}), Status::ok);
+    CHECK_EQ(gcm.update({buffer, 16}, {buffer, 16}), Status::invalid_argument);  // after a partial block
+    CHECK_EQ(gcm.finish_verify(tag), Status::invalid_argument);  // wrong direction
+    CHECK_EQ(gcm.finish(tag), Status::ok);
+    CHECK_EQ(gcm.finish(tag), Status::invalid_argument);  // message already ended
+}
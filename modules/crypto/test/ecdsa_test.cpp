@@ -0,0 +1,89 @@
+#include <vector>
+
+#include "nucleo/crypto/ecdsa.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::crypto;
+
+namespace {
+
+template <std::size_t N>
+std::array<std::uint8_t, N> unhex(const char* s) {
+    std::array<std::uint8_t, N> out{};
+    auto nibble = [](char c) { return c <= '9' ? c - '0' : c - 'a' + 10; };
+    for (std::size_t i = 0; i < N; ++i) {
+        out[i] = static_cast<std::uint8_t>(nibble(s[2 * i]) << 4 | nibble(s[2 * i + 1]));
+    }
+    return out;
+}
+
+// Signed with OpenSSL (prime256v1) over the SHA-256 of image(): the
+// bytes i * 7 + 3 for i < 1000.
+const P256PublicKey kKey = {
+    unhex<32>("15064e8cc422f5df25431a2daa2a68a3c54bffe509f6ee420156c3b6d416b292"),
+    unhex<32>("2234a497398ee6bfd4c290db8251434249306e4602409376672d5a59be900dd1"),
+};
+const Sha256Digest kDigest = unhex<32>("1e9bc38cbf860b9ec31918b065f9b52476c549a782e0e7990bed8ce3868d2371");
+const P256Signature kSignature = {
+    unhex<32>("68baecd172c902c787eb6e3cfc933f8cb5ca16cdf77b599d212511311e0b9f23"),
+    unhex<32>("dc418098fcd5e5a955ce0fe07189311a4f0120fe40f2780a92e5974f8db5555b"),
+};
+const char* const kOrder = "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551";
+
+std::vector<std::uint8_t> image() {
+    std::vector<std::uint8_t> v(1000);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<std::uint8_t>(i * 7 + 3);
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST(openssl_signature_verifies) {
+    CHECK_EQ(ecdsa_p256_verify(kKey, kDigest, kSignature), Status::ok);
+}
+
+TEST(any_changed_bit_fails) {
+    for (std::size_t bit = 0; bit < 256; bit += 37) {
+        Sha256Digest digest = kDigest;
+        digest[bit / 8] ^= static_cast<std::uint8_t>(1u << (bit % 8));
+        CHECK_EQ(ecdsa_p256_verify(kKey, digest, kSignature), Status::corrupt);
+
+        P256Signature signature = kSignature;
+        signature.s[bit / 8] ^= static_cast<std::uint8_t>(1u << (bit % 8));
+        const Status status = ecdsa_p256_verify(kKey, kDigest, signature);
+        CHECK(status == Status::corrupt || status == Status::invalid_argument);
+    }
+    // The same signature under the generator as the key.
+    P256PublicKey other = {
+        unhex<32>("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296"),
+        unhex<32>("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5"),
+    };
+    CHECK_EQ(ecdsa_p256_verify(other, kDigest, kSignature), Status::corrupt);
+}
+
+TEST(out_of_range_inputs_are_rejected) {
+    P256Signature signature = kSignature;
+    signature.r = {};
+    CHECK_EQ(ecdsa_p256_verify(kKey, kDigest, signature), Status::invalid_argument);
+    signature = kSignature;
+    signature.s = unhex<32>(kOrder);
+    CHECK_EQ(ecdsa_p256_verify(kKey, kDigest, signature), Status::invalid_argument);
+
+    P256PublicKey off_curve = kKey;
+    off_curve.y[31] ^= 0x01;
+    CHECK_EQ(ecdsa_p256_verify(off_curve, kDigest, kSignature), Status::invalid_argument);
+}
+
+TEST(image_verifies_from_segments) {
+    const auto data = image();
+    const ConstByteSpan segments[] = {{data.data(), 256}, {data.data() + 256, 700}, {data.data() + 956, 44}};
+    CHECK_EQ(verify_image(segments, kKey, kSignature), Status::ok);
+
+    auto patched = data;
+    patched[500] ^= 0x10;
+    const ConstByteSpan whole[] = {{patched.data(), patched.size()}};
+    CHECK_EQ(verify_image(whole, kKey, kSignature), Status::corrupt);
+}
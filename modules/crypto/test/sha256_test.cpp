@@ -0,0 +1,121 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "nucleo/crypto/sha256.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::crypto;
+
+namespace {
+
+std::string hex(const Sha256Digest& d) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string s;
+    for (const std::uint8_t b : d) {
+        s += kDigits[b >> 4];
+        s += kDigits[b & 0x0F];
+    }
+    return s;
+}
+
+ConstByteSpan text(const char* s) { return {reinterpret_cast<const std::uint8_t*>(s), std::strlen(s)}; }
+
+std::string digest_of(ConstByteSpan data) {
+    Sha256Digest d{};
+    CHECK_EQ(sha256(data, d), Status::ok);
+    return hex(d);
+}
+
+}  // namespace
+
+TEST(sha256_matches_fips_180_vectors) {
+    CHECK_EQ(digest_of(text("")), std::string("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    CHECK_EQ(digest_of(text("abc")), std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    CHECK_EQ(digest_of(text("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+             std::string("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    const std::vector<std::uint8_t> million(1000000, 'a');
+    CHECK_EQ(digest_of({million.data(), million.size()}),
+             std::string("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+}
+
+TEST(streaming_split_points_do_not_change_the_digest) {
+    std::vector<std::uint8_t> data(300);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+    const std::string whole = digest_of({data.data(), data.size()});
+    // Every pair of cut points around the block and word boundaries.
+    for (std::size_t a = 0; a < 140; a += 3) {
+        for (std::size_t b = a; b < data.size(); b += 17) {
+            Sha256 hash;
+            REQUIRE_EQ(hash.start(), Status::ok);
+            hash.update({data.data(), a});
+            hash.update({data.data() + a, b - a});
+            hash.update({data.data() + b, data.size() - b});
+            Sha256Digest d{};
+            REQUIRE_EQ(hash.finish(d), Status::ok);
+            CHECK_EQ(hex(d), whole);
+        }
+    }
+}
+
+TEST(segment_lists_hash_as_their_concatenation) {
+    std::vector<std::uint8_t> data(5000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::uint8_t>(i ^ (i >> 5));
+    }
+    const std::string whole = digest_of({data.data(), data.size()});
+    // Word-multiple segments (the chained path on the target), then odd ones.
+    const ConstByteSpan words[] = {{data.data(), 64}, {data.data() + 64, 4000}, {data.data() + 4064, 936}};
+    const ConstByteSpan odd[] = {{data.data(), 13}, {}, {data.data() + 13, 4986}, {data.data() + 4999, 1}};
+    Sha256Digest d{};
+    REQUIRE_EQ(sha256(words, d), Status::ok);
+    CHECK_EQ(hex(d), whole);
+    REQUIRE_EQ(sha256(odd, d), Status::ok);
+    CHECK_EQ(hex(d), whole);
+}
+
+TEST(multi_node_chains_hash_as_their_concatenation) {
+    // Sizes that make the target driver chain several GPDMA nodes per
+    // segment. This binary links the software backend, so it checks the
+    // expected digests only; the TCEM setting of the hardware chain is
+    // not exercised here and stays unverified until run on the board.
+    std::vector<std::uint8_t> data(3 * 65536 + 7);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::uint8_t>((i * 131) ^ (i >> 11));
+    }
+    const std::string whole = digest_of({data.data(), data.size()});
+    const ConstByteSpan segments[] = {
+        {data.data(), 140000}, {data.data() + 140000, 4}, {data.data() + 140004, data.size() - 140004}};
+    Sha256Digest d{};
+    REQUIRE_EQ(sha256(segments, d), Status::ok);
+    CHECK_EQ(hex(d), whole);
+
+    Sha256 hash;
+    REQUIRE_EQ(hash.start(), Status::ok);
+    REQUIRE_EQ(hash.update({data.data(), 70001}), Status::ok);
+    REQUIRE_EQ(hash.update({data.data() + 70001, data.size() - 70001}), Status::ok);
+    REQUIRE_EQ(hash.finish(d), Status::ok);
+    CHECK_EQ(hex(d), whole);
+}
+
+TEST(one_stream_owns_the_hash_at_a_time) {
+    Sha256 first;
+    Sha256 second;
+    REQUIRE_EQ(first.start(), Status::ok);
+    CHECK_EQ(second.start(), Status::busy);
+    Sha256Digest d{};
+    CHECK_EQ(second.finish(d), Status::invalid_argument);
+    first.abort();
+    CHECK_EQ(second.start(), Status::ok);
+    CHECK_EQ(second.finish(d), Status::ok);
+    CHECK_EQ(hex(d), std::string("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+    {
+        Sha256 scoped;
+        REQUIRE_EQ(scoped.start(), Status::ok);
+    }
+    CHECK_EQ(first.start(), Status::ok);  // released by the destructor
+    first.abort();
+}
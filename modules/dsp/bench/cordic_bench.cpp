@@ -0,0 +1,322 @@
+// CORDIC against libm and table lookups, in counter ticks per element,
+// with the worst error of each method over the same inputs.
+//
+//  * sincos: sinf/cosf, sin/cos in double, a 512-entry interpolated table,
+//    CORDIC one-shot calls and a DMA batch
+//  * atan2: atan2f, an octant-folded 256-entry interpolated table, CORDIC
+//    one-shot and batch
+//  * magnitude and square root: sqrtf against the CORDIC
+//
+// Each row processes a 256-element block repeatedly and keeps the best
+// run. Ticks are perf::cycles(): core cycles on the board, nanoseconds on
+// the host. On the host the CORDIC rows time cordic_model(), 24 iterations
+// of shift-and-add in C++ that are far slower than libm; only the board
+// figures compare the peripheral. The error column is log2 of the worst absolute error
+// (angles in units of pi), so -20 means within 2^-20.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "nucleo/dsp/cordic.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::dsp;
+
+namespace {
+
+constexpr std::size_t kBlock = 256;
+constexpr float kPi = 3.14159265358979f;
+
+// sin over one turn in 512 steps, plus a guard entry for interpolation.
+constexpr int kSinBits = 9;
+float sin_table[(1 << kSinBits) + 1];
+// atan(t) / pi for t in [0, 1].
+constexpr int kAtanSteps = 256;
+float atan_table[kAtanSteps + 1];
+
+void build_tables() {
+    for (int i = 0; i <= (1 << kSinBits); ++i) {
+        sin_table[i] = static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * i / (1 << kSinBits)));
+    }
+    for (int i = 0; i <= kAtanSteps; ++i) {
+        atan_table[i] = static_cast<float>(std::atan(static_cast<double>(i) / kAtanSteps) / 3.14159265358979323846);
+    }
+}
+
+// `turn` is the angle as a fraction of a full turn in 32 bits: the top bits
+// index the table and the rest interpolate.
+float table_sin(std::uint32_t turn) {
+    const std::uint32_t i = turn >> (32 - kSinBits);
+    const float frac = static_cast<float>(turn << kSinBits >> 8) * (1.0f / 16777216.0f);
+    return sin_table[i] + (sin_table[i + 1] - sin_table[i]) * frac;
+}
+
+float table_atan2_over_pi(float y, float x) {
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    const float lo = std::min(ax, ay);
+    const float hi = std::max(ax, ay);
+    const float t = hi > 0 ? lo / hi * kAtanSteps : 0;
+    const int i = std::min(static_cast<int>(t), kAtanSteps - 1);
+    float a = atan_table[i] + (atan_table[i + 1] - atan_table[i]) * (t - static_cast<float>(i));
+    if (ay > ax) {
+        a = 0.5f - a;
+    }
+    if (x < 0) {
+        a = 1.0f - a;
+    }
+    return y < 0 ? -a : a;
+}
+
+struct Row {
+    char name[32];
+    double ticks;
+    double error_log2;
+};
+
+std::vector<Row> table;
+
+double ticks_per_element(const testkit::Bench& bench, const std::function<void()>& block) {
+    std::uint32_t best = UINT32_MAX;
+    for (std::size_t i = 0, runs = bench.scale(2000); i < runs; ++i) {
+        const std::uint32_t start = perf::cycles();
+        block();
+        best = std::min(best, perf::cycles() - start);
+    }
+    return static_cast<double>(best) / kBlock;
+}
+
+void row(const testkit::Bench& bench, const char* name, const std::function<void()>& block,
+         const std::function<double()>& error) {
+    block();
+    Row r{};
+    std::snprintf(r.name, sizeof r.name, "%s", name);
+    r.ticks = ticks_per_element(bench, block);
+    const double e = error();
+    r.error_log2 = e > 0 ? std::log2(e) : -64;
+    table.push_back(r);
+    char metric[64];
+    std::snprintf(metric, sizeof metric, "%s", name);
+    bench.metric(metric, r.ticks, "ticks/element");
+    std::snprintf(metric, sizeof metric, "%s_error", name);
+    bench.metric(metric, r.error_log2, "log2");
+}
+
+struct Inputs {
+    std::vector<q31_t> angle;  // angle / pi
+    std::vector<float> radians;
+    std::vector<Vec2> vec;  // half scale, so magnitudes stay below 1
+    std::vector<float> vx, vy;
+    std::vector<q31_t> positive;
+    std::vector<float> positive_f;
+};
+
+Inputs make_inputs() {
+    std::mt19937 rng(1);
+    Inputs in;
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        const q31_t a = static_cast<q31_t>(rng());
+        const Vec2 v{static_cast<q31_t>(rng()) / 2, static_cast<q31_t>(rng()) / 2};
+        const q31_t p = static_cast<q31_t>(rng() & 0x7FFFFFFF);
+        in.angle.push_back(a);
+        in.radians.push_back(static_cast<float>(from_q31(a)) * kPi);
+        in.vec.push_back(v);
+        in.vx.push_back(static_cast<float>(from_q31(v.x)));
+        in.vy.push_back(static_cast<float>(from_q31(v.y)));
+        in.positive.push_back(p);
+        in.positive_f.push_back(static_cast<float>(from_q31(p)));
+    }
+    return in;
+}
+
+void sincos_rows(const testkit::Bench& bench, const Inputs& in) {
+    std::vector<float> s(kBlock), c(kBlock);
+    std::vector<SinCos> sc(kBlock);
+    const auto float_error = [&] {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            const double theta = from_q31(in.angle[i]) * 3.14159265358979323846;
+            worst = std::max({worst, std::fabs(s[i] - std::sin(theta)), std::fabs(c[i] - std::cos(theta))});
+        }
+        return worst;
+    };
+    const auto q31_error = [&] {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            const double theta = from_q31(in.angle[i]) * 3.14159265358979323846;
+            worst = std::max({worst, std::fabs(from_q31(sc[i].sin) - std::sin(theta)),
+                              std::fabs(from_q31(sc[i].cos) - std::cos(theta))});
+        }
+        return worst;
+    };
+
+    row(
+        bench, "sincos_libm_float",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                s[i] = std::sin(in.radians[i]);
+                c[i] = std::cos(in.radians[i]);
+            }
+        },
+        float_error);
+    row(
+        bench, "sincos_libm_double",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                const double theta = from_q31(in.angle[i]) * 3.14159265358979323846;
+                s[i] = static_cast<float>(std::sin(theta));
+                c[i] = static_cast<float>(std::cos(theta));
+            }
+        },
+        float_error);
+    row(
+        bench, "sincos_table",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                // angle / pi in Q31, read as unsigned, is the fraction of a
+                // turn.
+                const std::uint32_t turn = static_cast<std::uint32_t>(in.angle[i]);
+                s[i] = table_sin(turn);
+                c[i] = table_sin(turn + 0x40000000u);
+            }
+        },
+        float_error);
+    row(
+        bench, "sincos_cordic",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                sc[i] = cordic().sincos(in.angle[i]);
+            }
+        },
+        q31_error);
+    row(
+        bench, "sincos_cordic_batch", [&] { (void)cordic().sincos(in.angle.data(), sc.data(), kBlock); },
+        q31_error);
+}
+
+void atan2_rows(const testkit::Bench& bench, const Inputs& in) {
+    std::vector<float> a(kBlock);
+    std::vector<q31_t> aq(kBlock);
+    const auto want = [&](std::size_t i) {
+        return std::atan2(from_q31(in.vec[i].y), from_q31(in.vec[i].x)) / 3.14159265358979323846;
+    };
+    const auto fold = [](double d) { return std::fabs(d > 1 ? d - 2 : d < -1 ? d + 2 : d); };
+    const auto float_error = [&] {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            worst = std::max(worst, fold(a[i] - want(i)));
+        }
+        return worst;
+    };
+    const auto q31_error = [&] {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            worst = std::max(worst, fold(from_q31(aq[i]) - want(i)));
+        }
+        return worst;
+    };
+
+    row(
+        bench, "atan2_libm_float",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                a[i] = std::atan2(in.vy[i], in.vx[i]) * (1.0f / kPi);
+            }
+        },
+        float_error);
+    row(
+        bench, "atan2_table",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                a[i] = table_atan2_over_pi(in.vy[i], in.vx[i]);
+            }
+        },
+        float_error);
+    row(
+        bench, "atan2_cordic",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                aq[i] = cordic().atan2(in.vec[i].y, in.vec[i].x);
+            }
+        },
+        q31_error);
+    row(
+        bench, "atan2_cordic_batch", [&] { (void)cordic().atan2(in.vec.data(), aq.data(), kBlock); }, q31_error);
+}
+
+void root_rows(const testkit::Bench& bench, const Inputs& in) {
+    std::vector<float> f(kBlock);
+    std::vector<q31_t> q(kBlock);
+    const auto magnitude_error = [&](const std::function<double(std::size_t)>& got) {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            worst = std::max(worst, std::fabs(got(i) - std::hypot(from_q31(in.vec[i].x), from_q31(in.vec[i].y))));
+        }
+        return worst;
+    };
+    const auto sqrt_error = [&](const std::function<double(std::size_t)>& got) {
+        double worst = 0;
+        for (std::size_t i = 0; i < kBlock; ++i) {
+            worst = std::max(worst, std::fabs(got(i) - std::sqrt(from_q31(in.positive[i]))));
+        }
+        return worst;
+    };
+
+    row(
+        bench, "magnitude_libm_float",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                f[i] = std::sqrt(in.vx[i] * in.vx[i] + in.vy[i] * in.vy[i]);
+            }
+        },
+        [&] { return magnitude_error([&](std::size_t i) { return f[i]; }); });
+    row(
+        bench, "magnitude_cordic",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                q[i] = cordic().magnitude(in.vec[i].x, in.vec[i].y);
+            }
+        },
+        [&] { return magnitude_error([&](std::size_t i) { return from_q31(q[i]); }); });
+    row(
+        bench, "sqrt_libm_float",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                f[i] = std::sqrt(in.positive_f[i]);
+            }
+        },
+        [&] { return sqrt_error([&](std::size_t i) { return f[i]; }); });
+    row(
+        bench, "sqrt_cordic",
+        [&] {
+            for (std::size_t i = 0; i < kBlock; ++i) {
+                q[i] = cordic().sqrt(in.positive[i]);
+            }
+        },
+        [&] { return sqrt_error([&](std::size_t i) { return from_q31(q[i]); }); });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    perf::cycle_counter_init();
+    build_tables();
+    const Inputs in = make_inputs();
+    sincos_rows(bench, in);
+    atan2_rows(bench, in);
+    root_rows(bench, in);
+
+    std::printf("\n%-22s %14s %10s   at %lu ticks/s, CORDIC precision %u\n", "method", "ticks/element",
+                "error", static_cast<unsigned long>(perf::cycle_counter_hz()),
+                static_cast<unsigned>(cordic().precision()));
+    for (const Row& r : table) {
+        std::printf("%-22s %14.2f %8.1f\n", r.name, r.ticks, r.error_log2);
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+// CORDIC in host builds: the model stands in for the peripheral and
+// completes every batch immediately.
+#include "nucleo/dsp/cordic.hpp"
+
+namespace nucleo::dsp {
+
+CordicResult Cordic::calculate(CordicFunction function, q31_t arg1, q31_t arg2, std::uint8_t scale) {
+    return cordic_model(function, arg1, arg2, precision_, scale);
+}
+
+Status Cordic::start(CordicFunction function, const q31_t* in, std::size_t args, q31_t* out, std::size_t results,
+                     std::size_t n) {
+    if (n > kMaxBatch) {
+        return Status::invalid_argument;
+    }
+    // With one argument the peripheral reuses the last ARG2, which start()
+    // primes to 1 for sine/cosine.
+    for (std::size_t i = 0; i < n; ++i) {
+        const q31_t arg2 = args == 2 ? in[2 * i + 1] : INT32_MAX;
+        const CordicResult r = calculate(function, in[args * i], arg2);
+        out[results * i] = r.res1;
+        if (results == 2) {
+            out[2 * i + 1] = r.res2;
+        }
+    }
+    return Status::ok;
+}
+
+bool Cordic::busy() const { return false; }
+
+Status Cordic::wait(std::uint32_t) { return Status::ok; }
+
+Cordic& cordic() {
+    static Cordic instance;
+    return instance;
+}
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,71 @@
+// FMAC in host builds: the bit-accurate model stands in for the peripheral
+// and completes every transfer immediately.
+#include <algorithm>
+
+#include "nucleo/dsp/fmac.hpp"
+
+namespace nucleo::dsp {
+
+Status Fmac::configure(std::size_t p, std::size_t q, std::uint8_t gain_shift) {
+    const std::size_t words = (p + q) + (p + kInputSlack) + (q + kOutputWords);
+    if (p == 0 || p > 127 || q > 63 || gain_shift > 7 || words > kMemoryWords) {
+        return Status::invalid_argument;
+    }
+    p_ = static_cast<std::uint8_t>(p);
+    q_ = static_cast<std::uint8_t>(q);
+    gain_ = gain_shift;
+    saturations_ = 0;
+    configured_ = true;
+    reset();
+    return Status::ok;
+}
+
+Status Fmac::configure_fir(Span<const q15_t> coeffs, std::uint8_t gain_shift) {
+    const Status status = configure(coeffs.size(), 0, gain_shift);
+    if (status == Status::ok) {
+        iir_ = false;
+        std::copy(coeffs.begin(), coeffs.end(), coeff_b_);
+    }
+    return status;
+}
+
+Status Fmac::configure_iir(Span<const q15_t> b, Span<const q15_t> a, std::uint8_t gain_shift) {
+    if (b.size() > 64 || a.empty()) {
+        return Status::invalid_argument;
+    }
+    const Status status = configure(b.size(), a.size(), gain_shift);
+    if (status == Status::ok) {
+        iir_ = true;
+        std::copy(b.begin(), b.end(), coeff_b_);
+        std::copy(a.begin(), a.end(), coeff_a_);
+    }
+    return status;
+}
+
+void Fmac::reset() {
+    std::fill(std::begin(x_), std::end(x_), q15_t{0});
+    std::fill(std::begin(y_), std::end(y_), q15_t{0});
+}
+
+Status Fmac::start(const q15_t* in, q15_t* out, std::size_t n) {
+    if (!configured_) {
+        return Status::invalid_argument;
+    }
+    const Span<const q15_t> b{coeff_b_, p_};
+    const std::size_t saturated =
+        iir_ ? fmac_iir_model(b, {coeff_a_, q_}, {x_, p_}, {y_, q_}, gain_, in, out, n)
+             : fmac_fir_model(b, {x_, p_}, gain_, in, out, n);
+    saturations_ += static_cast<std::uint32_t>(saturated);
+    return Status::ok;
+}
+
+bool Fmac::busy() const { return false; }
+
+Status Fmac::wait(std::uint32_t) { return Status::ok; }
+
+Fmac& fmac() {
+    static Fmac instance;
+    return instance;
+}
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,95 @@
+// Cascaded biquad (second-order IIR) sections in direct form I, Q15 and Q31.
+//
+// Higher-order IIR filters are built as cascades: each section stays well
+// conditioned in fixed point where a single high-order recursion would
+// not. Per section, with the feedback terms already negated:
+//
+//   y[n] = (b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]) << post_shift
+//
+// Coefficients are stored scaled down by 2^post_shift so that values up to
+// 2^post_shift in magnitude are representable. The sum is exact in a
+// 64-bit accumulator; the result is truncated and saturated.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::dsp {
+
+/// Floating-point section with the usual denominator 1 + a1 z^-1 + a2 z^-2.
+struct BiquadDesign {
+    double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+};
+
+/// RBJ audio-EQ-cookbook designs; `cutoff` and `rate` in the same unit.
+BiquadDesign design_lowpass(double cutoff, double rate, double q = 0.7071067811865476);
+BiquadDesign design_highpass(double cutoff, double rate, double q = 0.7071067811865476);
+BiquadDesign design_bandpass(double center, double rate, double q);
+
+/// One Q15 section. The zero after b0 pads the table so (b1, b2) and
+/// (a1, a2) are each one aligned 32-bit load for the dual-MAC kernel.
+struct BiquadQ15Coeffs {
+    q15_t b0 = 0;
+    q15_t pad = 0;
+    q15_t b1 = 0;
+    q15_t b2 = 0;
+    q15_t a1 = 0;  ///< negated: the kernel adds the feedback terms
+    q15_t a2 = 0;
+};
+
+struct BiquadQ31Coeffs {
+    q31_t b0 = 0;
+    q31_t b1 = 0;
+    q31_t b2 = 0;
+    q31_t a1 = 0;  ///< negated
+    q31_t a2 = 0;
+};
+
+/// Smallest post shift that makes every coefficient of `d` fit.
+int biquad_post_shift(const BiquadDesign& d);
+BiquadQ15Coeffs quantize_q15(const BiquadDesign& d, int post_shift);
+BiquadQ31Coeffs quantize_q31(const BiquadDesign& d, int post_shift);
+
+/// Per-section history: x[n-1], x[n-2], y[n-1], y[n-2].
+template <typename T>
+struct BiquadState {
+    T x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+};
+
+class BiquadCascadeQ15 {
+public:
+    /// `state` must have as many entries as `sections`. All sections share
+    /// `post_shift` (0..15).
+    BiquadCascadeQ15(Span<const BiquadQ15Coeffs> sections, Span<BiquadState<q15_t>> state, int post_shift);
+
+    /// Filters `n` samples; `in` and `out` may be the same buffer.
+    void process(const q15_t* in, q15_t* out, std::size_t n);
+    void reset();
+
+    std::size_t sections() const { return sections_.size(); }
+
+private:
+    Span<const BiquadQ15Coeffs> sections_;
+    Span<BiquadState<q15_t>> state_;
+    int post_shift_;
+};
+
+class BiquadCascadeQ31 {
+public:
+    BiquadCascadeQ31(Span<const BiquadQ31Coeffs> sections, Span<BiquadState<q31_t>> state, int post_shift);
+
+    void process(const q31_t* in, q31_t* out, std::size_t n);
+    void reset();
+
+    std::size_t sections() const { return sections_.size(); }
+
+private:
+    Span<const BiquadQ31Coeffs> sections_;
+    Span<BiquadState<q31_t>> state_;
+    int post_shift_;
+};
+
+}  // namespace nucleo::dsp
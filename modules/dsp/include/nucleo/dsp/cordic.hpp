@@ -0,0 +1,130 @@
+// CORDIC coprocessor: sine/cosine, atan2, magnitude and square root in
+// Q31.
+//
+// Angles are fractions of pi: 0x80000000 is -pi and 0x7FFFFFFF is just
+// under +pi, so an angle wraps naturally in 32-bit arithmetic. The
+// one-shot calls write the arguments and read the results straight back;
+// the bus stalls until the result is ready, one clock per group of four
+// iterations (precision(), 6 by default), against well over a hundred
+// cycles for a libm sincos or atan2 on the M33. The start_*() calls stream
+// whole arrays through two GPDMA2 channels (channel 0 feeds WDATA,
+// channel 1 drains RDATA) and return at once; wait() blocks until the
+// last result is in memory.
+//
+// cordic_model() is a portable implementation of the same shift-and-add
+// iterations: the host build runs it in place of the peripheral, and it
+// doubles as a reference on any target. The host tests hold it to these
+// bounds against libm at the default precision: sine/cosine within 2^-22
+// of full scale, angles within 2^-24 (x pi), magnitudes and square roots
+// within 2^-29. Sine, cosine and angles lose four bits per precision step
+// below that; magnitudes converge twice as fast.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::dsp {
+
+/// CSR.FUNC codes of the functions this driver uses.
+enum class CordicFunction : std::uint8_t {
+    cosine = 0,
+    sine = 1,
+    phase = 2,
+    modulus = 3,
+    sqrt = 9,
+};
+
+struct SinCos {
+    q31_t sin;
+    q31_t cos;
+};
+
+/// A vector in Q31; the layout the phase and modulus functions read.
+struct Vec2 {
+    q31_t x;
+    q31_t y;
+};
+
+struct Polar {
+    q31_t angle;  ///< atan2(y, x) / pi
+    q31_t magnitude;
+};
+
+/// The two result words of one calculation.
+struct CordicResult {
+    q31_t res1;
+    q31_t res2;
+};
+
+class Cordic {
+public:
+    /// Iteration groups of four.
+    static constexpr std::uint8_t kDefaultPrecision = 6;
+    static constexpr std::uint8_t kMaxPrecision = 15;
+    /// Longest batch: two words per element must fit one DMA block of at
+    /// most 65535 bytes.
+    static constexpr std::size_t kMaxBatch = 65535 / (2 * sizeof(q31_t));
+
+    Status set_precision(std::uint8_t precision);
+    std::uint8_t precision() const { return precision_; }
+
+    /// `angle` / pi -> modulus * {sin, cos}.
+    SinCos sincos(q31_t angle, q31_t modulus = INT32_MAX);
+    /// atan2(y, x) / pi; arbitrary at the origin.
+    q31_t atan2(q31_t y, q31_t x);
+    /// sqrt(x^2 + y^2), which must stay below 1; larger results saturate.
+    q31_t magnitude(q31_t x, q31_t y);
+    Polar polar(q31_t x, q31_t y);
+    /// sqrt(x) for 0 <= x < 1; negative inputs give 0. Inputs are
+    /// normalised by even shifts first, so small ones keep the same
+    /// absolute error instead of leaving the peripheral's range.
+    q31_t sqrt(q31_t x);
+
+    /// Batched forms. Buffers must stay valid until wait() returns and may
+    /// not overlap; `n` is at most kMaxBatch.
+    /// One-shot calls wait for a running batch before they start.
+    Status start_sincos(const q31_t* angle, SinCos* out, std::size_t n);
+    Status start_atan2(const Vec2* in, q31_t* angle, std::size_t n);
+    Status start_polar(const Vec2* in, Polar* out, std::size_t n);
+    bool busy() const;
+    /// Blocks until the batch started by start_*() is complete.
+    Status wait(std::uint32_t timeout_ms = 100);
+
+    Status sincos(const q31_t* angle, SinCos* out, std::size_t n) {
+        const Status status = start_sincos(angle, out, n);
+        return status == Status::ok ? wait() : status;
+    }
+    Status atan2(const Vec2* in, q31_t* angle, std::size_t n) {
+        const Status status = start_atan2(in, angle, n);
+        return status == Status::ok ? wait() : status;
+    }
+    Status polar(const Vec2* in, Polar* out, std::size_t n) {
+        const Status status = start_polar(in, out, n);
+        return status == Status::ok ? wait() : status;
+    }
+
+private:
+    CordicResult calculate(CordicFunction function, q31_t arg1, q31_t arg2, std::uint8_t scale = 0);
+    Status start(CordicFunction function, const q31_t* in, std::size_t args, q31_t* out, std::size_t results,
+                 std::size_t n);
+
+    std::uint8_t precision_ = kDefaultPrecision;
+#if !NUCLEO_PLATFORM_HOST
+    std::uint32_t csr_ = 0;  // last CSR value written, to skip redundant writes
+#endif
+};
+
+/// The single CORDIC instance.
+Cordic& cordic();
+
+/// One calculation through the CORDIC datapath: `precision` groups of four
+/// iterations on Q31 arguments, with the argument conventions of RM0481
+/// (sine/cosine: angle, modulus; phase/modulus: x, y; sqrt: x * 2^-scale
+/// with scale 0..2). Results that overflow Q31 saturate; phases wrap.
+CordicResult cordic_model(CordicFunction function, q31_t arg1, q31_t arg2, std::uint8_t precision,
+                          std::uint8_t scale = 0);
+
+}  // namespace nucleo::dsp
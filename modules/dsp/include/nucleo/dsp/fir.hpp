@@ -0,0 +1,90 @@
+// Block FIR filters, Q15 and Q31.
+//
+// Coefficients are in natural order (b[0] multiplies the newest sample) and
+// are referenced, not copied. The state buffer holds the last taps - 1
+// inputs followed by one block of new samples, as in CMSIS-DSP: each
+// block is filtered straight out of it and only the tail is moved down
+// afterwards, so the inner loops never wrap.
+//
+// Arithmetic: exact products summed in a 64-bit accumulator, then shifted
+// down (truncating) and saturated. Q31 filters need log2(taps) bits of
+// headroom in the input to stay clear of accumulator wrap.
+#pragma once
+
+#include <cstddef>
+
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::dsp {
+
+/// State buffer length for a filter of `taps` processing blocks of up to
+/// `block` samples.
+constexpr std::size_t fir_state_size(std::size_t taps, std::size_t block) { return taps - 1 + block; }
+
+class FirQ15 {
+public:
+    /// `state` must hold fir_state_size(coeffs.size(), block) samples with
+    /// block >= 1; process() splits longer inputs into blocks of that size.
+    /// Without taps or with a shorter state the filter is not valid().
+    FirQ15(Span<const q15_t> coeffs, Span<q15_t> state);
+
+    /// Filters `n` samples; `in` and `out` may be the same buffer.
+    void process(const q15_t* in, q15_t* out, std::size_t n);
+    void reset();
+
+    std::size_t taps() const { return coeffs_.size(); }
+    std::size_t block_size() const { return block_; }
+    /// False for a filter that was given no taps or too little state;
+    /// process() then leaves the output untouched.
+    bool valid() const { return block_ != 0; }
+
+private:
+    void process_block(q15_t* out, std::size_t n);
+
+    Span<const q15_t> coeffs_;
+    Span<q15_t> state_;
+    std::size_t block_;
+};
+
+class FirQ31 {
+public:
+    FirQ31(Span<const q31_t> coeffs, Span<q31_t> state);
+
+    void process(const q31_t* in, q31_t* out, std::size_t n);
+    void reset();
+
+    std::size_t taps() const { return coeffs_.size(); }
+    std::size_t block_size() const { return block_; }
+    bool valid() const { return block_ != 0; }
+
+private:
+    void process_block(q31_t* out, std::size_t n);
+
+    Span<const q31_t> coeffs_;
+    Span<q31_t> state_;
+    std::size_t block_;
+};
+
+/// Filter plus its state storage.
+template <std::size_t Taps, std::size_t Block = 64>
+class StaticFirQ15 : public FirQ15 {
+public:
+    static_assert(Taps >= 1 && Block >= 1, "a filter needs a tap and a block of at least one sample");
+    explicit StaticFirQ15(Span<const q15_t> coeffs) : FirQ15(coeffs, state_storage_) {}
+
+private:
+    q15_t state_storage_[fir_state_size(Taps, Block)] = {};
+};
+
+template <std::size_t Taps, std::size_t Block = 64>
+class StaticFirQ31 : public FirQ31 {
+public:
+    static_assert(Taps >= 1 && Block >= 1, "a filter needs a tap and a block of at least one sample");
+    explicit StaticFirQ31(Span<const q31_t> coeffs) : FirQ31(coeffs, state_storage_) {}
+
+private:
+    q31_t state_storage_[fir_state_size(Taps, Block)] = {};
+};
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,91 @@
+// FMAC filter accelerator: Q15 FIR and direct-form-I IIR in hardware.
+//
+// The FMAC holds coefficients and sample history in its own 256-word
+// memory and streams samples through DMA, so a configured filter costs the
+// CPU nothing per sample: start() programs two GPDMA channels (channel 2
+// feeds WDATA, channel 3 drains RDATA) and returns; wait() blocks until
+// the last output is in memory.
+//
+// Its arithmetic differs from the software kernels: each q2.30 product is
+// truncated to q2.22 before being summed in a 26-bit (q4.22) accumulator, and the
+// output is the accumulator shifted left by the gain and saturated to Q15.
+// fmac_fir_model() / fmac_iir_model() reproduce that bit for bit; the host
+// build runs the model in place of the peripheral.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::dsp {
+
+class Fmac {
+public:
+    /// Words of FMAC memory shared by coefficients and sample buffers.
+    static constexpr std::size_t kMemoryWords = 256;
+    /// Extra input buffer words beyond the filter length, so DMA writes
+    /// run ahead of the filter.
+    static constexpr std::size_t kInputSlack = 4;
+    static constexpr std::size_t kOutputWords = 4;
+
+    /// Loads a FIR with `coeffs` (natural order, up to 127 taps) and zero
+    /// history. `gain_shift` (0..7) scales the output by 2^gain_shift.
+    Status configure_fir(Span<const q15_t> coeffs, std::uint8_t gain_shift = 0);
+
+    /// Loads an IIR with feed-forward `b` (up to 64) and feedback `a`
+    /// (a[0] = a1 ..., up to 63, negated like the biquad kernels).
+    Status configure_iir(Span<const q15_t> b, Span<const q15_t> a, std::uint8_t gain_shift = 0);
+
+    /// Starts filtering `n` samples by DMA. `in` and `out` must stay valid
+    /// until wait() returns; they may not overlap.
+    Status start(const q15_t* in, q15_t* out, std::size_t n);
+    bool busy() const;
+    /// Blocks until the transfer started by start() is complete.
+    Status wait(std::uint32_t timeout_ms = 100);
+
+    Status process(const q15_t* in, q15_t* out, std::size_t n) {
+        const Status status = start(in, out, n);
+        return status == Status::ok ? wait() : status;
+    }
+
+    /// Clears the sample history, keeping the configuration.
+    void reset();
+
+    /// Saturation events since configure (SAT flag occurrences).
+    std::uint32_t saturations() const { return saturations_; }
+
+private:
+    Status configure(std::size_t p, std::size_t q, std::uint8_t gain_shift);
+
+    bool iir_ = false;
+    std::uint8_t p_ = 0;
+    std::uint8_t q_ = 0;
+    std::uint8_t gain_ = 0;
+    std::uint32_t saturations_ = 0;
+    bool configured_ = false;
+#if NUCLEO_PLATFORM_HOST
+    q15_t coeff_b_[128] = {};
+    q15_t coeff_a_[64] = {};
+    q15_t x_[128] = {};  // newest first
+    q15_t y_[64] = {};
+#else
+    bool running_ = false;  // filter function started; history lives in the FMAC
+#endif
+};
+
+/// The single FMAC instance.
+Fmac& fmac();
+
+/// Bit-accurate model of the FMAC datapath. `x_history` / `y_history` hold
+/// previous inputs and outputs, newest first, and are updated. Returns the
+/// number of saturated outputs.
+std::size_t fmac_fir_model(Span<const q15_t> coeffs, Span<q15_t> x_history, std::uint8_t gain_shift,
+                           const q15_t* in, q15_t* out, std::size_t n);
+std::size_t fmac_iir_model(Span<const q15_t> b, Span<const q15_t> a, Span<q15_t> x_history,
+                           Span<q15_t> y_history, std::uint8_t gain_shift, const q15_t* in, q15_t* out,
+                           std::size_t n);
+
+}  // namespace nucleo::dsp
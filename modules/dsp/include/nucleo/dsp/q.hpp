@@ -0,0 +1,43 @@
+// Q15 / Q31 fixed-point types and the saturating conversions every kernel
+// and reference shares.
+#pragma once
+
+#include <cstdint>
+
+namespace nucleo::dsp {
+
+using q15_t = std::int16_t;  ///< [-1, 1) in steps of 2^-15
+using q31_t = std::int32_t;  ///< [-1, 1) in steps of 2^-31
+using q63_t = std::int64_t;  ///< accumulator
+
+constexpr q15_t sat_q15(std::int64_t v) {
+    return static_cast<q15_t>(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+constexpr q31_t sat_q31(std::int64_t v) {
+    return static_cast<q31_t>(v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : v);
+}
+
+/// acc + a * b with two's-complement wrap-around, so that kernels and
+/// references agree bit for bit even when a filter without enough input
+/// headroom overflows the 64-bit accumulator.
+constexpr q63_t mac_q63(q63_t acc, std::int32_t a, std::int32_t b) {
+    return static_cast<q63_t>(static_cast<std::uint64_t>(acc) +
+                              static_cast<std::uint64_t>(static_cast<std::int64_t>(a) * b));
+}
+
+/// Rounds to nearest and saturates; for building coefficient tables.
+constexpr q15_t to_q15(double v) {
+    const double scaled = v * 32768.0;
+    return sat_q15(static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+}
+
+constexpr q31_t to_q31(double v) {
+    const double scaled = v * 2147483648.0;
+    return sat_q31(static_cast<std::int64_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5));
+}
+
+constexpr double from_q15(q15_t v) { return v / 32768.0; }
+constexpr double from_q31(q31_t v) { return v / 2147483648.0; }
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,27 @@
+// Scalar reference implementations.
+//
+// Deliberately the most literal transcription of each filter's difference
+// equation, sample by sample, with no blocking, packing or unrolling. The
+// optimized kernels must match them bit for bit; the host tests hold them
+// to it. They build for both targets and double as a fallback.
+#pragma once
+
+#include <cstddef>
+
+#include "nucleo/dsp/biquad.hpp"
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::dsp::reference {
+
+/// `history` holds the previous taps - 1 inputs, newest last, and is
+/// updated.
+void fir_q15(Span<const q15_t> coeffs, Span<q15_t> history, const q15_t* in, q15_t* out, std::size_t n);
+void fir_q31(Span<const q31_t> coeffs, Span<q31_t> history, const q31_t* in, q31_t* out, std::size_t n);
+
+void biquad_q15(Span<const BiquadQ15Coeffs> sections, Span<BiquadState<q15_t>> state, int post_shift,
+                const q15_t* in, q15_t* out, std::size_t n);
+void biquad_q31(Span<const BiquadQ31Coeffs> sections, Span<BiquadState<q31_t>> state, int post_shift,
+                const q31_t* in, q31_t* out, std::size_t n);
+
+}  // namespace nucleo::dsp::reference
@@ -0,0 +1,72 @@
+// Dual 16-bit multiply-accumulate primitives (Armv8-M DSP extension).
+//
+// On the Cortex-M33 these are the single-cycle SMLAD/SMLALD family via the
+// CMSIS intrinsics. Everywhere else they are portable emulations with the
+// same semantics, so the SIMD kernels themselves run in host tests and are
+// checked bit for bit against the scalar references.
+//
+// A packed pair holds two q15 values, element 0 in the low halfword, which
+// is what a 32-bit little-endian load of two consecutive q15 gives.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "nucleo/dsp/q.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define NUCLEO_DSP_NATIVE_SIMD 1
+#include "stm32h5xx.h"
+#else
+#define NUCLEO_DSP_NATIVE_SIMD 0
+#endif
+
+namespace nucleo::dsp::simd {
+
+/// Two consecutive q15 values; `p` need not be word aligned (unaligned LDR
+/// is supported on the M33).
+NUCLEO_ALWAYS_INLINE std::uint32_t load_pair(const q15_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+NUCLEO_ALWAYS_INLINE void store_pair(q15_t* p, std::uint32_t v) { std::memcpy(p, &v, sizeof v); }
+
+NUCLEO_ALWAYS_INLINE std::int32_t lo(std::uint32_t v) { return static_cast<std::int16_t>(v); }
+NUCLEO_ALWAYS_INLINE std::int32_t hi(std::uint32_t v) { return static_cast<std::int16_t>(v >> 16); }
+
+/// (low halfword of a, low halfword of b): the PKHBT a, b, LSL #16 idiom.
+NUCLEO_ALWAYS_INLINE std::uint32_t pack_lo(std::uint32_t a, std::uint32_t b) {
+#if NUCLEO_DSP_NATIVE_SIMD
+    return __PKHBT(a, b, 16);
+#else
+    return (a & 0xFFFFu) | (b << 16);
+#endif
+}
+
+/// acc + x.lo * y.lo + x.hi * y.hi, 64-bit accumulator.
+NUCLEO_ALWAYS_INLINE q63_t smlald(std::uint32_t x, std::uint32_t y, q63_t acc) {
+#if NUCLEO_DSP_NATIVE_SIMD
+    return static_cast<q63_t>(__SMLALD(x, y, static_cast<std::uint64_t>(acc)));
+#else
+    return mac_q63(mac_q63(acc, lo(x), lo(y)), hi(x), hi(y));
+#endif
+}
+
+/// acc + x.lo * y.hi + x.hi * y.lo, 64-bit accumulator.
+NUCLEO_ALWAYS_INLINE q63_t smlaldx(std::uint32_t x, std::uint32_t y, q63_t acc) {
+#if NUCLEO_DSP_NATIVE_SIMD
+    return static_cast<q63_t>(__SMLALDX(x, y, static_cast<std::uint64_t>(acc)));
+#else
+    return mac_q63(mac_q63(acc, lo(x), hi(y)), hi(x), lo(y));
+#endif
+}
+
+/// acc + a * b, 32 x 32 -> 64 (SMLAL).
+NUCLEO_ALWAYS_INLINE q63_t smlal(std::int32_t a, std::int32_t b, q63_t acc) {
+    return mac_q63(acc, a, b);
+}
+
+}  // namespace nucleo::dsp::simd
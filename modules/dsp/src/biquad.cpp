@@ -0,0 +1,157 @@
+#include "nucleo/dsp/biquad.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "nucleo/dsp/simd.hpp"
+
+namespace nucleo::dsp {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+BiquadDesign normalize(double b0, double b1, double b2, double a0, double a1, double a2) {
+    return {b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+}  // namespace
+
+BiquadDesign design_lowpass(double cutoff, double rate, double q) {
+    const double w = 2 * kPi * cutoff / rate;
+    const double alpha = std::sin(w) / (2 * q);
+    const double c = std::cos(w);
+    return normalize((1 - c) / 2, 1 - c, (1 - c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+BiquadDesign design_highpass(double cutoff, double rate, double q) {
+    const double w = 2 * kPi * cutoff / rate;
+    const double alpha = std::sin(w) / (2 * q);
+    const double c = std::cos(w);
+    return normalize((1 + c) / 2, -(1 + c), (1 + c) / 2, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+BiquadDesign design_bandpass(double center, double rate, double q) {
+    const double w = 2 * kPi * center / rate;
+    const double alpha = std::sin(w) / (2 * q);
+    const double c = std::cos(w);
+    return normalize(alpha, 0, -alpha, 1 + alpha, -2 * c, 1 - alpha);
+}
+
+int biquad_post_shift(const BiquadDesign& d) {
+    double largest = 0;
+    for (const double v : {d.b0, d.b1, d.b2, d.a1, d.a2}) {
+        largest = std::fmax(largest, std::fabs(v));
+    }
+    int shift = 0;
+    // Scaled coefficients must stay strictly below 1.0 (the Q format's top).
+    while (largest / std::ldexp(1.0, shift) >= 1.0 - 1.0 / 32768) {
+        ++shift;
+    }
+    return shift;
+}
+
+BiquadQ15Coeffs quantize_q15(const BiquadDesign& d, int post_shift) {
+    const double s = std::ldexp(1.0, -post_shift);
+    BiquadQ15Coeffs c;
+    c.b0 = to_q15(d.b0 * s);
+    c.b1 = to_q15(d.b1 * s);
+    c.b2 = to_q15(d.b2 * s);
+    c.a1 = to_q15(-d.a1 * s);
+    c.a2 = to_q15(-d.a2 * s);
+    return c;
+}
+
+BiquadQ31Coeffs quantize_q31(const BiquadDesign& d, int post_shift) {
+    const double s = std::ldexp(1.0, -post_shift);
+    return {to_q31(d.b0 * s), to_q31(d.b1 * s), to_q31(d.b2 * s), to_q31(-d.a1 * s), to_q31(-d.a2 * s)};
+}
+
+BiquadCascadeQ15::BiquadCascadeQ15(Span<const BiquadQ15Coeffs> sections, Span<BiquadState<q15_t>> state,
+                                   int post_shift)
+    : sections_(sections), state_(state), post_shift_(post_shift) {
+    reset();
+}
+
+void BiquadCascadeQ15::reset() {
+    for (BiquadState<q15_t>& s : state_) {
+        s = {};
+    }
+}
+
+void BiquadCascadeQ15::process(const q15_t* in, q15_t* out, std::size_t n) {
+    // Section-major: each section runs over the whole block with its
+    // coefficients and history held in registers as packed pairs, and
+    // writes into `out`, which the next section reads in place.
+    const int shift = 15 - post_shift_;
+    const q15_t* src = in;
+    for (std::size_t k = 0; k < sections_.size(); ++k) {
+        const BiquadQ15Coeffs& c = sections_[k];
+        BiquadState<q15_t>& st = state_[k];
+        const std::uint32_t b12 = simd::load_pair(&c.b1);
+        const std::uint32_t a12 = simd::load_pair(&c.a1);
+        std::uint32_t xs = simd::pack_lo(static_cast<std::uint16_t>(st.x1), static_cast<std::uint16_t>(st.x2));
+        std::uint32_t ys = simd::pack_lo(static_cast<std::uint16_t>(st.y1), static_cast<std::uint16_t>(st.y2));
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint32_t x = static_cast<std::uint16_t>(src[i]);
+            q63_t acc = simd::smlal(src[i], c.b0, 0);
+            acc = simd::smlald(xs, b12, acc);
+            acc = simd::smlald(ys, a12, acc);
+            const q15_t y = sat_q15(acc >> shift);
+            out[i] = y;
+            // Shift histories: (x1, x2) <- (x, x1), (y1, y2) <- (y, y1).
+            xs = simd::pack_lo(x, xs);
+            ys = simd::pack_lo(static_cast<std::uint16_t>(y), ys);
+        }
+        st.x1 = static_cast<q15_t>(simd::lo(xs));
+        st.x2 = static_cast<q15_t>(simd::hi(xs));
+        st.y1 = static_cast<q15_t>(simd::lo(ys));
+        st.y2 = static_cast<q15_t>(simd::hi(ys));
+        src = out;
+    }
+    if (sections_.empty() && out != in) {
+        std::memmove(out, in, n * sizeof(q15_t));
+    }
+}
+
+BiquadCascadeQ31::BiquadCascadeQ31(Span<const BiquadQ31Coeffs> sections, Span<BiquadState<q31_t>> state,
+                                   int post_shift)
+    : sections_(sections), state_(state), post_shift_(post_shift) {
+    reset();
+}
+
+void BiquadCascadeQ31::reset() {
+    for (BiquadState<q31_t>& s : state_) {
+        s = {};
+    }
+}
+
+void BiquadCascadeQ31::process(const q31_t* in, q31_t* out, std::size_t n) {
+    const int shift = 31 - post_shift_;
+    const q31_t* src = in;
+    for (std::size_t k = 0; k < sections_.size(); ++k) {
+        const BiquadQ31Coeffs c = sections_[k];
+        BiquadState<q31_t> st = state_[k];
+        for (std::size_t i = 0; i < n; ++i) {
+            const q31_t x = src[i];
+            q63_t acc = simd::smlal(x, c.b0, 0);
+            acc = simd::smlal(st.x1, c.b1, acc);
+            acc = simd::smlal(st.x2, c.b2, acc);
+            acc = simd::smlal(st.y1, c.a1, acc);
+            acc = simd::smlal(st.y2, c.a2, acc);
+            const q31_t y = sat_q31(acc >> shift);
+            out[i] = y;
+            st.x2 = st.x1;
+            st.x1 = x;
+            st.y2 = st.y1;
+            st.y1 = y;
+        }
+        state_[k] = st;
+        src = out;
+    }
+    if (sections_.empty() && out != in) {
+        std::memmove(out, in, n * sizeof(q31_t));
+    }
+}
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,65 @@
+#include "nucleo/dsp/cordic.hpp"
+
+namespace nucleo::dsp {
+
+// Arrays of SinCos, Vec2 and Polar go to the DMA channels as plain word
+// streams in argument/result order.
+static_assert(sizeof(SinCos) == 2 * sizeof(q31_t) && sizeof(Vec2) == 2 * sizeof(q31_t) &&
+                  sizeof(Polar) == 2 * sizeof(q31_t),
+              "CORDIC batch records must be packed word pairs");
+
+Status Cordic::set_precision(std::uint8_t precision) {
+    if (precision == 0 || precision > kMaxPrecision) {
+        return Status::invalid_argument;
+    }
+    precision_ = precision;
+    return Status::ok;
+}
+
+SinCos Cordic::sincos(q31_t angle, q31_t modulus) {
+    const CordicResult r = calculate(CordicFunction::sine, angle, modulus);
+    return {r.res1, r.res2};
+}
+
+q31_t Cordic::atan2(q31_t y, q31_t x) { return calculate(CordicFunction::phase, x, y).res1; }
+
+q31_t Cordic::magnitude(q31_t x, q31_t y) { return calculate(CordicFunction::modulus, x, y).res1; }
+
+Polar Cordic::polar(q31_t x, q31_t y) {
+    const CordicResult r = calculate(CordicFunction::phase, x, y);
+    return {r.res1, r.res2};
+}
+
+q31_t Cordic::sqrt(q31_t x) {
+    if (x <= 0) {
+        return 0;
+    }
+    // sqrt(x * 4^k) = sqrt(x) * 2^k: bring x into [0.25, 1), where the
+    // peripheral converges, and shift the root back.
+    std::uint32_t v = static_cast<std::uint32_t>(x);
+    int k = 0;
+    while (v < (1u << 29)) {
+        v <<= 2;
+        ++k;
+    }
+    // RM0481: arguments of 0.75 and above take scale 1 (argument halved,
+    // result halved).
+    const std::uint8_t scale = v >= 0x60000000u ? 1 : 0;
+    const q31_t root = calculate(CordicFunction::sqrt, static_cast<q31_t>(v >> scale), 0, scale).res1;
+    const std::int64_t r = static_cast<std::int64_t>(root) << scale;
+    return sat_q31(k == 0 ? r : (r + (std::int64_t{1} << (k - 1))) >> k);
+}
+
+Status Cordic::start_sincos(const q31_t* angle, SinCos* out, std::size_t n) {
+    return start(CordicFunction::sine, angle, 1, &out->sin, 2, n);
+}
+
+Status Cordic::start_atan2(const Vec2* in, q31_t* angle, std::size_t n) {
+    return start(CordicFunction::phase, &in->x, 2, angle, 1, n);
+}
+
+Status Cordic::start_polar(const Vec2* in, Polar* out, std::size_t n) {
+    return start(CordicFunction::phase, &in->x, 2, &out->angle, 2, n);
+}
+
+}  // namespace nucleo::dsp
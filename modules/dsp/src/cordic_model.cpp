@@ -0,0 +1,221 @@
+#include <array>
+
+#include "nucleo/dsp/cordic.hpp"
+
+namespace nucleo::dsp {
+
+namespace {
+
+// Q31 arguments are carried with kGuard extra fraction bits so that the
+// truncation of each shift-and-add stays below the final rounding. The
+// largest intermediate (a gain-scaled magnitude of sqrt(2) * 1.65) needs
+// 41 bits; products with the Q30 gain constants are split in mul_q30().
+constexpr int kGuard = 8;
+constexpr int kFraction = 31 + kGuard;
+constexpr std::int64_t kOne = std::int64_t{1} << kFraction;  // 1.0, or pi for angles
+constexpr std::size_t kMaxIterations = 4 * Cordic::kMaxPrecision;
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double sqrt_newton(double v) {
+    double r = v > 1 ? v : 1.0;
+    for (int i = 0; i < 64; ++i) {
+        r = 0.5 * (r + v / r);
+    }
+    return r;
+}
+
+constexpr double pow2(int e) {
+    double v = 1.0;
+    for (int i = 0; i < e; ++i) {
+        v *= 0.5;
+    }
+    return v;
+}
+
+// atan(2^-i) / pi, by its Taylor series for i >= 1 (t <= 0.5).
+constexpr double atan_pow2_over_pi(int i) {
+    if (i == 0) {
+        return 0.25;
+    }
+    const double t = pow2(i);
+    double term = t;
+    double sum = 0;
+    for (int k = 0; k < 40; ++k) {
+        sum += (k % 2 == 0 ? term : -term) / (2 * k + 1);
+        term *= t * t;
+    }
+    return sum / kPi;
+}
+
+constexpr std::int64_t to_fixed(double v, int fraction) {
+    double scaled = v;
+    for (int i = 0; i < fraction; ++i) {
+        scaled *= 2;
+    }
+    return static_cast<std::int64_t>(scaled + 0.5);
+}
+
+struct Tables {
+    std::array<std::int64_t, kMaxIterations> atan{};
+    // Shift of each hyperbolic step: 1, 2, 3, 4, 4, 5, ... 13, 13, ... with
+    // steps 4, 13 and 40 repeated so the iteration converges.
+    std::array<int, kMaxIterations> hyperbolic_shift{};
+    // 1 / gain after 4 * p iterations, in Q30, indexed by precision p.
+    std::array<std::int64_t, Cordic::kMaxPrecision + 1> circular_inverse_gain{};
+    std::array<std::int64_t, Cordic::kMaxPrecision + 1> hyperbolic_inverse_gain{};
+};
+
+constexpr Tables make_tables() {
+    Tables t;
+    for (std::size_t i = 0; i < kMaxIterations; ++i) {
+        t.atan[i] = to_fixed(atan_pow2_over_pi(static_cast<int>(i)), kFraction);
+    }
+    int shift = 1;
+    int repeat = 4;
+    bool repeated = false;
+    for (std::size_t k = 0; k < kMaxIterations; ++k) {
+        t.hyperbolic_shift[k] = shift;
+        if (shift == repeat && !repeated) {
+            repeated = true;
+        } else {
+            if (shift == repeat) {
+                repeat = 3 * repeat + 1;
+                repeated = false;
+            }
+            ++shift;
+        }
+    }
+    for (std::size_t p = 1; p <= Cordic::kMaxPrecision; ++p) {
+        double circular = 1;
+        double hyperbolic = 1;
+        for (std::size_t k = 0; k < 4 * p; ++k) {
+            circular *= 1 + pow2(2 * static_cast<int>(k));
+            hyperbolic *= 1 - pow2(2 * t.hyperbolic_shift[k]);
+        }
+        t.circular_inverse_gain[p] = to_fixed(1 / sqrt_newton(circular), 30);
+        t.hyperbolic_inverse_gain[p] = to_fixed(1 / sqrt_newton(hyperbolic), 30);
+    }
+    return t;
+}
+
+constexpr Tables kTables = make_tables();
+
+// v * k / 2^30 for |v| < 2^52 and k < 2^31, without a 128-bit product.
+std::int64_t mul_q30(std::int64_t v, std::int64_t k) {
+    const std::int64_t hi = v >> 20;
+    const std::int64_t lo = v & 0xFFFFF;
+    return ((hi * k) >> 10) + ((lo * k) >> 30);
+}
+
+std::int64_t round_out(std::int64_t v) { return (v + (std::int64_t{1} << (kGuard - 1))) >> kGuard; }
+
+q31_t saturate(std::int64_t v) { return sat_q31(round_out(v)); }
+
+q31_t wrap(std::int64_t v) { return static_cast<q31_t>(static_cast<std::uint32_t>(round_out(v))); }
+
+CordicResult rotate(bool sine, q31_t angle, q31_t modulus, std::size_t iterations, std::size_t precision) {
+    // The iteration converges for |angle| up to ~0.55 pi; beyond pi/2 rotate
+    // by pi first and negate the result.
+    std::int64_t z = static_cast<std::int64_t>(angle) << kGuard;
+    bool negate = false;
+    if (z > kOne / 2) {
+        z -= kOne;
+        negate = true;
+    } else if (z < -kOne / 2) {
+        z += kOne;
+        negate = true;
+    }
+    std::int64_t x = mul_q30(static_cast<std::int64_t>(modulus) << kGuard, kTables.circular_inverse_gain[precision]);
+    std::int64_t y = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const std::int64_t dx = y >> i;
+        const std::int64_t dy = x >> i;
+        if (z >= 0) {
+            x -= dx;
+            y += dy;
+            z -= kTables.atan[i];
+        } else {
+            x += dx;
+            y -= dy;
+            z += kTables.atan[i];
+        }
+    }
+    if (negate) {
+        x = -x;
+        y = -y;
+    }
+    return sine ? CordicResult{saturate(y), saturate(x)} : CordicResult{saturate(x), saturate(y)};
+}
+
+CordicResult vector(bool phase_first, q31_t arg_x, q31_t arg_y, std::size_t iterations, std::size_t precision) {
+    std::int64_t x = static_cast<std::int64_t>(arg_x) << kGuard;
+    std::int64_t y = static_cast<std::int64_t>(arg_y) << kGuard;
+    std::int64_t z = 0;
+    if (x < 0) {
+        // Into the right half-plane by a rotation of pi.
+        z = y >= 0 ? kOne : -kOne;
+        x = -x;
+        y = -y;
+    }
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const std::int64_t dx = y >> i;
+        const std::int64_t dy = x >> i;
+        if (y >= 0) {
+            x += dx;
+            y -= dy;
+            z += kTables.atan[i];
+        } else {
+            x -= dx;
+            y += dy;
+            z -= kTables.atan[i];
+        }
+    }
+    const q31_t modulus = saturate(mul_q30(x, kTables.circular_inverse_gain[precision]));
+    const q31_t phase = wrap(z);
+    return phase_first ? CordicResult{phase, modulus} : CordicResult{modulus, phase};
+}
+
+CordicResult square_root(q31_t arg, std::uint8_t scale, std::size_t iterations, std::size_t precision) {
+    // sqrt(v) = sqrt((v + 1/4)^2 - (v - 1/4)^2), with v = arg * 2^scale.
+    const std::int64_t v = (static_cast<std::int64_t>(arg) << kGuard) << scale;
+    std::int64_t x = v + kOne / 4;
+    std::int64_t y = v - kOne / 4;
+    for (std::size_t k = 0; k < iterations; ++k) {
+        const int shift = kTables.hyperbolic_shift[k];
+        const std::int64_t dx = y >> shift;
+        const std::int64_t dy = x >> shift;
+        if (y < 0) {
+            x += dx;
+            y += dy;
+        } else {
+            x -= dx;
+            y -= dy;
+        }
+    }
+    const std::int64_t root = mul_q30(x, kTables.hyperbolic_inverse_gain[precision]) >> scale;
+    return {saturate(root), 0};
+}
+
+}  // namespace
+
+CordicResult cordic_model(CordicFunction function, q31_t arg1, q31_t arg2, std::uint8_t precision,
+                          std::uint8_t scale) {
+    const std::size_t p = precision == 0 ? 1 : precision > Cordic::kMaxPrecision ? Cordic::kMaxPrecision : precision;
+    const std::size_t iterations = 4 * p;
+    switch (function) {
+    case CordicFunction::cosine:
+        return rotate(false, arg1, arg2, iterations, p);
+    case CordicFunction::sine:
+        return rotate(true, arg1, arg2, iterations, p);
+    case CordicFunction::phase:
+        return vector(true, arg1, arg2, iterations, p);
+    case CordicFunction::modulus:
+        return vector(false, arg1, arg2, iterations, p);
+    case CordicFunction::sqrt:
+        return arg1 <= 0 ? CordicResult{0, 0} : square_root(arg1, scale > 2 ? 2 : scale, iterations, p);
+    }
+    return {0, 0};
+}
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,149 @@
+#include "nucleo/dsp/fir.hpp"
+
+#include <cstring>
+
+#include "nucleo/dsp/simd.hpp"
+
+namespace nucleo::dsp {
+
+// Both kernels compute, for block output i,
+//
+//   y[i] = sum_k state[i + k] * b[taps - 1 - k],   k = 0 .. taps - 1
+//
+// i.e. the oldest sample in the window meets the last coefficient. The Q15
+// kernel takes two taps per dual MAC: the sample pair (s[i+k], s[i+k+1])
+// against the coefficient pair (b[t-2-k], b[t-1-k]) needs the exchanged
+// product, SMLALDX. Two outputs are computed per pass so every coefficient
+// load is used twice.
+
+namespace {
+
+// Zero when there are no taps or `state` cannot hold the history plus one
+// new sample; process() then does nothing rather than loop or wrap.
+std::size_t block_for(std::size_t taps, std::size_t state) { return taps != 0 && state >= taps ? state - (taps - 1) : 0; }
+
+}  // namespace
+
+FirQ15::FirQ15(Span<const q15_t> coeffs, Span<q15_t> state)
+    : coeffs_(coeffs), state_(state), block_(block_for(coeffs.size(), state.size())) {
+    reset();
+}
+
+void FirQ15::reset() { std::memset(state_.data(), 0, state_.size_bytes()); }
+
+void FirQ15::process(const q15_t* in, q15_t* out, std::size_t n) {
+    if (block_ == 0) {
+        return;
+    }
+    const std::size_t history = coeffs_.size() - 1;
+    while (n != 0) {
+        const std::size_t chunk = n < block_ ? n : block_;
+        std::memcpy(state_.data() + history, in, chunk * sizeof(q15_t));
+        process_block(out, chunk);
+        std::memmove(state_.data(), state_.data() + chunk, history * sizeof(q15_t));
+        in += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+void FirQ15::process_block(q15_t* out, std::size_t n) {
+    const q15_t* b = coeffs_.data();
+    const std::size_t taps = coeffs_.size();
+    const std::size_t pairs = taps / 2;
+    const q15_t* s = state_.data();
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        q63_t acc0 = 0;
+        q63_t acc1 = 0;
+        const q15_t* x = s + i;
+        // One past the end, stepped back before each load: b + taps - 2
+        // would point before the array for a single-tap filter.
+        const q15_t* c = b + taps;
+        for (std::size_t p = 0; p < pairs; ++p) {
+            c -= 2;
+            const std::uint32_t cp = simd::load_pair(c);
+            acc0 = simd::smlaldx(simd::load_pair(x), cp, acc0);
+            acc1 = simd::smlaldx(simd::load_pair(x + 1), cp, acc1);
+            x += 2;
+        }
+        if ((taps & 1) != 0) {
+            acc0 = simd::smlal(x[0], b[0], acc0);
+            acc1 = simd::smlal(x[1], b[0], acc1);
+        }
+        out[i] = sat_q15(acc0 >> 15);
+        out[i + 1] = sat_q15(acc1 >> 15);
+    }
+    if (i < n) {
+        q63_t acc = 0;
+        const q15_t* x = s + i;
+        const q15_t* c = b + taps;
+        for (std::size_t p = 0; p < pairs; ++p) {
+            c -= 2;
+            acc = simd::smlaldx(simd::load_pair(x), simd::load_pair(c), acc);
+            x += 2;
+        }
+        if ((taps & 1) != 0) {
+            acc = simd::smlal(x[0], b[0], acc);
+        }
+        out[i] = sat_q15(acc >> 15);
+    }
+}
+
+FirQ31::FirQ31(Span<const q31_t> coeffs, Span<q31_t> state)
+    : coeffs_(coeffs), state_(state), block_(block_for(coeffs.size(), state.size())) {
+    reset();
+}
+
+void FirQ31::reset() { std::memset(state_.data(), 0, state_.size_bytes()); }
+
+void FirQ31::process(const q31_t* in, q31_t* out, std::size_t n) {
+    if (block_ == 0) {
+        return;
+    }
+    const std::size_t history = coeffs_.size() - 1;
+    while (n != 0) {
+        const std::size_t chunk = n < block_ ? n : block_;
+        std::memcpy(state_.data() + history, in, chunk * sizeof(q31_t));
+        process_block(out, chunk);
+        std::memmove(state_.data(), state_.data() + chunk, history * sizeof(q31_t));
+        in += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+void FirQ31::process_block(q31_t* out, std::size_t n) {
+    // No dual MAC for 32-bit data; two outputs per pass still halve the
+    // coefficient loads and keep both SMLAL chains independent.
+    const q31_t* b = coeffs_.data();
+    const std::size_t taps = coeffs_.size();
+    const q31_t* s = state_.data();
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        q63_t acc0 = 0;
+        q63_t acc1 = 0;
+        const q31_t* x = s + i;
+        q31_t x0 = x[0];
+        for (std::size_t k = 0; k < taps; ++k) {
+            const q31_t c = b[taps - 1 - k];
+            const q31_t x1 = x[k + 1];
+            acc0 = simd::smlal(x0, c, acc0);
+            acc1 = simd::smlal(x1, c, acc1);
+            x0 = x1;
+        }
+        out[i] = sat_q31(acc0 >> 31);
+        out[i + 1] = sat_q31(acc1 >> 31);
+    }
+    if (i < n) {
+        q63_t acc = 0;
+        for (std::size_t k = 0; k < taps; ++k) {
+            acc = simd::smlal(s[i + k], b[taps - 1 - k], acc);
+        }
+        out[i] = sat_q31(acc >> 31);
+    }
+}
+
+}  // namespace nucleo::dsp
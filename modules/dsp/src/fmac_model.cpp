@@ -0,0 +1,76 @@
+#include "nucleo/dsp/fmac.hpp"
+
+namespace nucleo::dsp {
+
+namespace {
+
+// RM0481, FMAC "Fixed point representation": q1.15 x q1.15 gives a q2.30
+// product whose 8 LSBs are dropped before it enters the 26-bit q4.22
+// accumulator; the output is the accumulator shifted left by R, read as
+// q1.15 and clipped (CR.CLIPEN, which this driver always sets).
+constexpr int kAccumulatorBits = 26;
+
+std::int32_t accumulate(std::int32_t acc, q15_t a, q15_t b) {
+    const std::int32_t product = (static_cast<std::int32_t>(a) * b) >> 8;
+    const std::uint32_t sum = static_cast<std::uint32_t>(acc) + static_cast<std::uint32_t>(product);
+    // Wrap to 26 bits and sign-extend.
+    const std::uint32_t wrapped = sum & ((1u << kAccumulatorBits) - 1);
+    return static_cast<std::int32_t>(wrapped << (32 - kAccumulatorBits)) >> (32 - kAccumulatorBits);
+}
+
+q15_t output(std::int32_t acc, std::uint8_t gain_shift, std::size_t& saturated) {
+    const std::int64_t v = (static_cast<std::int64_t>(acc) << gain_shift) >> 7;
+    const q15_t y = sat_q15(v);
+    if (y != v) {
+        ++saturated;
+    }
+    return y;
+}
+
+void push_front(Span<q15_t> history, q15_t v) {
+    if (history.empty()) {
+        return;
+    }
+    for (std::size_t k = history.size() - 1; k > 0; --k) {
+        history[k] = history[k - 1];
+    }
+    history[0] = v;
+}
+
+}  // namespace
+
+std::size_t fmac_fir_model(Span<const q15_t> coeffs, Span<q15_t> x_history, std::uint8_t gain_shift,
+                           const q15_t* in, q15_t* out, std::size_t n) {
+    std::size_t saturated = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        push_front(x_history, in[i]);
+        std::int32_t acc = 0;
+        for (std::size_t j = 0; j < coeffs.size(); ++j) {
+            acc = accumulate(acc, coeffs[j], x_history[j]);
+        }
+        out[i] = output(acc, gain_shift, saturated);
+    }
+    return saturated;
+}
+
+std::size_t fmac_iir_model(Span<const q15_t> b, Span<const q15_t> a, Span<q15_t> x_history,
+                           Span<q15_t> y_history, std::uint8_t gain_shift, const q15_t* in, q15_t* out,
+                           std::size_t n) {
+    std::size_t saturated = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        push_front(x_history, in[i]);
+        std::int32_t acc = 0;
+        for (std::size_t j = 0; j < b.size(); ++j) {
+            acc = accumulate(acc, b[j], x_history[j]);
+        }
+        for (std::size_t j = 0; j < a.size(); ++j) {
+            acc = accumulate(acc, a[j], y_history[j]);
+        }
+        const q15_t y = output(acc, gain_shift, saturated);
+        push_front(y_history, y);
+        out[i] = y;
+    }
+    return saturated;
+}
+
+}  // namespace nucleo::dsp
@@ -0,0 +1,94 @@
+#include "nucleo/dsp/reference.hpp"
+
+namespace nucleo::dsp::reference {
+
+namespace {
+
+template <typename T>
+void push_history(Span<T> history, T x) {
+    if (history.empty()) {
+        return;
+    }
+    for (std::size_t k = 0; k + 1 < history.size(); ++k) {
+        history[k] = history[k + 1];
+    }
+    history[history.size() - 1] = x;
+}
+
+// y[n] = sum_j b[j] x[n - j]; history[size - j] is x[n - j] for j >= 1.
+template <typename T>
+q63_t fir_sum(Span<const T> coeffs, Span<T> history, T x) {
+    q63_t acc = mac_q63(0, x, coeffs[0]);
+    for (std::size_t j = 1; j < coeffs.size(); ++j) {
+        acc = mac_q63(acc, history[history.size() - j], coeffs[j]);
+    }
+    return acc;
+}
+
+}  // namespace
+
+void fir_q15(Span<const q15_t> coeffs, Span<q15_t> history, const q15_t* in, q15_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const q15_t x = in[i];
+        out[i] = sat_q15(fir_sum(coeffs, history, x) >> 15);
+        push_history(history, x);
+    }
+}
+
+void fir_q31(Span<const q31_t> coeffs, Span<q31_t> history, const q31_t* in, q31_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const q31_t x = in[i];
+        out[i] = sat_q31(fir_sum(coeffs, history, x) >> 31);
+        push_history(history, x);
+    }
+}
+
+void biquad_q15(Span<const BiquadQ15Coeffs> sections, Span<BiquadState<q15_t>> state, int post_shift,
+                const q15_t* in, q15_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        q15_t v = in[i];
+        for (std::size_t k = 0; k < sections.size(); ++k) {
+            const BiquadQ15Coeffs& c = sections[k];
+            BiquadState<q15_t>& s = state[k];
+            q63_t acc = 0;
+            acc = mac_q63(acc, c.b0, v);
+            acc = mac_q63(acc, c.b1, s.x1);
+            acc = mac_q63(acc, c.b2, s.x2);
+            acc = mac_q63(acc, c.a1, s.y1);
+            acc = mac_q63(acc, c.a2, s.y2);
+            const q15_t y = sat_q15(acc >> (15 - post_shift));
+            s.x2 = s.x1;
+            s.x1 = v;
+            s.y2 = s.y1;
+            s.y1 = y;
+            v = y;
+        }
+        out[i] = v;
+    }
+}
+
+void biquad_q31(Span<const BiquadQ31Coeffs> sections, Span<BiquadState<q31_t>> state, int post_shift,
+                const q31_t* in, q31_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        q31_t v = in[i];
+        for (std::size_t k = 0; k < sections.size(); ++k) {
+            const BiquadQ31Coeffs& c = sections[k];
+            BiquadState<q31_t>& s = state[k];
+            q63_t acc = 0;
+            acc = mac_q63(acc, c.b0, v);
+            acc = mac_q63(acc, c.b1, s.x1);
+            acc = mac_q63(acc, c.b2, s.x2);
+            acc = mac_q63(acc, c.a1, s.y1);
+            acc = mac_q63(acc, c.a2, s.y2);
+            const q31_t y = sat_q31(acc >> (31 - post_shift));
+            s.x2 = s.x1;
+            s.x1 = v;
+            s.y2 = s.y1;
+            s.y1 = y;
+            v = y;
+        }
+        out[i] = v;
+    }
+}
+
+}  // namespace nucleo::dsp::reference
@@ -0,0 +1,129 @@
+// CORDIC with GPDMA2 channel 0 (memory -> WDATA) and channel 1 (RDATA -> memory).
+#include "stm32h5xx.h"
+
+#include "nucleo/dsp/cordic.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::dsp {
+namespace {
+
+// RM0481, GPDMA request mapping (shared by both GPDMA instances).
+constexpr std::uint32_t kRequestCordicRead = 89;
+constexpr std::uint32_t kRequestCordicWrite = 90;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+
+DMA_Channel_TypeDef* const kWriteChannel = GPDMA2_Channel0;
+DMA_Channel_TypeDef* const kReadChannel = GPDMA2_Channel1;
+
+// 32-bit arguments and results (ARGSIZE = RESSIZE = 0).
+std::uint32_t control(CordicFunction function, std::uint8_t precision, std::uint8_t scale, std::size_t args,
+                      std::size_t results) {
+    return (static_cast<std::uint32_t>(function) << CORDIC_CSR_FUNC_Pos) |
+           (static_cast<std::uint32_t>(precision) << CORDIC_CSR_PRECISION_Pos) |
+           (static_cast<std::uint32_t>(scale) << CORDIC_CSR_SCALE_Pos) | (args == 2 ? CORDIC_CSR_NARGS : 0u) |
+           (results == 2 ? CORDIC_CSR_NRES : 0u);
+}
+
+void dma_channel(DMA_Channel_TypeDef* ch, std::uint32_t tr1, std::uint32_t tr2, std::uint32_t bytes,
+                 const volatile void* src, volatile void* dst) {
+    ch->CCR = DMA_CCR_RESET;
+    ch->CTR1 = tr1;
+    ch->CTR2 = tr2;
+    ch->CBR1 = bytes;
+    ch->CSAR = reinterpret_cast<std::uint32_t>(src);
+    ch->CDAR = reinterpret_cast<std::uint32_t>(dst);
+    ch->CLLR = 0;
+    ch->CFCR = kDmaAllFlags;
+    ch->CCR = DMA_CCR_EN;
+}
+
+void power_up() {
+    RCC->AHB1ENR |= RCC_AHB1ENR_CORDICEN | RCC_AHB1ENR_GPDMA2EN;
+    (void)RCC->AHB1ENR;
+    kWriteChannel->CCR = DMA_CCR_RESET;
+    kReadChannel->CCR = DMA_CCR_RESET;
+}
+
+}  // namespace
+
+CordicResult Cordic::calculate(CordicFunction function, q31_t arg1, q31_t arg2, std::uint8_t scale) {
+    // A running batch owns the peripheral; it finishes on its own.
+    while (busy()) {
+    }
+    if (csr_ == 0) {
+        power_up();
+    }
+    const std::size_t args = function == CordicFunction::sqrt ? 1 : 2;
+    const std::size_t results = function == CordicFunction::sine || function == CordicFunction::phase ? 2 : 1;
+    const std::uint32_t csr = control(function, precision_, scale, args, results);
+    if (csr != csr_) {
+        CORDIC->CSR = csr;
+        csr_ = csr;
+    }
+    // Zero-overhead mode: the last argument write starts the calculation and
+    // the first RDATA read waits for it.
+    CORDIC->WDATA = static_cast<std::uint32_t>(arg1);
+    if (args == 2) {
+        CORDIC->WDATA = static_cast<std::uint32_t>(arg2);
+    }
+    CordicResult r{};
+    r.res1 = static_cast<q31_t>(CORDIC->RDATA);
+    if (results == 2) {
+        r.res2 = static_cast<q31_t>(CORDIC->RDATA);
+    }
+    return r;
+}
+
+Status Cordic::start(CordicFunction function, const q31_t* in, std::size_t args, q31_t* out, std::size_t results,
+                     std::size_t n) {
+    if (n > kMaxBatch) {
+        return Status::invalid_argument;
+    }
+    if (busy()) {
+        return Status::busy;
+    }
+    if (n == 0) {
+        return Status::ok;
+    }
+    if (args == 1) {
+        // With one argument per calculation the CORDIC reuses the last ARG2;
+        // one throwaway calculation sets the modulus to 1.
+        (void)calculate(function, 0, INT32_MAX);
+    } else if (csr_ == 0) {
+        power_up();
+    }
+    constexpr std::uint32_t kWords = (2u << DMA_CTR1_SDW_LOG2_Pos) | (2u << DMA_CTR1_DDW_LOG2_Pos);
+    dma_channel(kReadChannel, kWords | DMA_CTR1_DINC, kRequestCordicRead << DMA_CTR2_REQSEL_Pos,
+                static_cast<std::uint32_t>(n * results * sizeof(q31_t)), &CORDIC->RDATA, out);
+    dma_channel(kWriteChannel, kWords | DMA_CTR1_SINC, (kRequestCordicWrite << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ,
+                static_cast<std::uint32_t>(n * args * sizeof(q31_t)), in, &CORDIC->WDATA);
+    csr_ = control(function, precision_, 0, args, results) | CORDIC_CSR_DMAREN | CORDIC_CSR_DMAWEN;
+    CORDIC->CSR = csr_;
+    return Status::ok;
+}
+
+bool Cordic::busy() const { return (kReadChannel->CCR & DMA_CCR_EN) != 0 && (kReadChannel->CSR & DMA_CSR_TCF) == 0; }
+
+Status Cordic::wait(std::uint32_t timeout_ms) {
+    const std::uint32_t start = platform::millis();
+    while (busy()) {
+        if (platform::millis() - start > timeout_ms) {
+            return Status::timeout;
+        }
+    }
+    const std::uint32_t errors = DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF;
+    const bool failed = ((kReadChannel->CSR | kWriteChannel->CSR) & errors) != 0;
+    kReadChannel->CFCR = kDmaAllFlags;
+    kWriteChannel->CFCR = kDmaAllFlags;
+    return failed ? Status::hardware_error : Status::ok;
+}
+
+Cordic& cordic() {
+    static Cordic instance;
+    return instance;
+}
+
+}  // namespace nucleo::dsp
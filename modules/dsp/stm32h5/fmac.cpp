@@ -0,0 +1,196 @@
+// FMAC with GPDMA1 channel 2 (memory -> WDATA) and channel 3 (RDATA -> memory).
+#include "stm32h5xx.h"
+
+#include "nucleo/dsp/fmac.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::dsp {
+namespace {
+
+// RM0481, GPDMA1 request mapping.
+constexpr std::uint32_t kRequestFmacRead = 91;
+constexpr std::uint32_t kRequestFmacWrite = 92;
+
+// PARAM.FUNC codes.
+constexpr std::uint32_t kFuncLoadX1 = 1;
+constexpr std::uint32_t kFuncLoadX2 = 2;
+constexpr std::uint32_t kFuncLoadY = 3;
+constexpr std::uint32_t kFuncFir = 8;
+constexpr std::uint32_t kFuncIir = 9;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+
+DMA_Channel_TypeDef* const kWriteChannel = GPDMA1_Channel2;
+DMA_Channel_TypeDef* const kReadChannel = GPDMA1_Channel3;
+
+std::uint32_t param(std::uint32_t func, std::uint32_t p, std::uint32_t q = 0, std::uint32_t r = 0) {
+    return (func << FMAC_PARAM_FUNC_Pos) | (p << FMAC_PARAM_P_Pos) | (q << FMAC_PARAM_Q_Pos) |
+           (r << FMAC_PARAM_R_Pos);
+}
+
+void wait_idle() {
+    while ((FMAC->PARAM & FMAC_PARAM_START) != 0) {
+    }
+}
+
+// Polled load of `n` words through one of the LOAD functions.
+void load(std::uint32_t func, const q15_t* data, std::size_t n, std::size_t extra = 0) {
+    FMAC->PARAM = param(func, static_cast<std::uint32_t>(n + extra)) | FMAC_PARAM_START;
+    for (std::size_t i = 0; i < n; ++i) {
+        FMAC->WDATA = static_cast<std::uint16_t>(data != nullptr ? data[i] : 0);
+    }
+    for (std::size_t i = 0; i < extra; ++i) {
+        FMAC->WDATA = 0;
+    }
+    wait_idle();
+}
+
+}  // namespace
+
+Status Fmac::configure(std::size_t p, std::size_t q, std::uint8_t gain_shift) {
+    const std::size_t words = (p + q) + (p + kInputSlack) + (q + kOutputWords);
+    if (p == 0 || p > 127 || q > 63 || gain_shift > 7 || words > kMemoryWords) {
+        return Status::invalid_argument;
+    }
+    RCC->AHB1ENR |= RCC_AHB1ENR_FMACEN | RCC_AHB1ENR_GPDMA1EN;
+    (void)RCC->AHB1ENR;
+    kWriteChannel->CCR = DMA_CCR_RESET;
+    kReadChannel->CCR = DMA_CCR_RESET;
+    FMAC->CR = FMAC_CR_RESET;
+    while ((FMAC->CR & FMAC_CR_RESET) != 0) {
+    }
+
+    // Memory map: coefficients (X2) at 0, input ring (X1) after them, output
+    // ring (Y) last.
+    const std::uint32_t x2_size = static_cast<std::uint32_t>(p + q);
+    const std::uint32_t x1_base = x2_size;
+    const std::uint32_t x1_size = static_cast<std::uint32_t>(p + kInputSlack);
+    const std::uint32_t y_base = x1_base + x1_size;
+    const std::uint32_t y_size = static_cast<std::uint32_t>(q + kOutputWords);
+    FMAC->X2BUFCFG = (0u << FMAC_X2BUFCFG_X2_BASE_Pos) | (x2_size << FMAC_X2BUFCFG_X2_BUF_SIZE_Pos);
+    FMAC->X1BUFCFG = (x1_base << FMAC_X1BUFCFG_X1_BASE_Pos) | (x1_size << FMAC_X1BUFCFG_X1_BUF_SIZE_Pos);
+    FMAC->YBUFCFG = (y_base << FMAC_YBUFCFG_Y_BASE_Pos) | (y_size << FMAC_YBUFCFG_Y_BUF_SIZE_Pos);
+
+    p_ = static_cast<std::uint8_t>(p);
+    q_ = static_cast<std::uint8_t>(q);
+    gain_ = gain_shift;
+    saturations_ = 0;
+    configured_ = true;
+    running_ = false;
+    return Status::ok;
+}
+
+Status Fmac::configure_fir(Span<const q15_t> coeffs, std::uint8_t gain_shift) {
+    const Status status = configure(coeffs.size(), 0, gain_shift);
+    if (status != Status::ok) {
+        return status;
+    }
+    iir_ = false;
+    load(kFuncLoadX2, coeffs.data(), coeffs.size());
+    reset();
+    return Status::ok;
+}
+
+Status Fmac::configure_iir(Span<const q15_t> b, Span<const q15_t> a, std::uint8_t gain_shift) {
+    if (b.size() > 64 || a.empty()) {
+        return Status::invalid_argument;
+    }
+    const Status status = configure(b.size(), a.size(), gain_shift);
+    if (status != Status::ok) {
+        return status;
+    }
+    iir_ = true;
+    // X2 holds B then A; LOAD_X2 takes P = |B| and Q = |A|.
+    FMAC->PARAM = param(kFuncLoadX2, p_, q_) | FMAC_PARAM_START;
+    for (const q15_t c : b) {
+        FMAC->WDATA = static_cast<std::uint16_t>(c);
+    }
+    for (const q15_t c : a) {
+        FMAC->WDATA = static_cast<std::uint16_t>(c);
+    }
+    wait_idle();
+    reset();
+    return Status::ok;
+}
+
+void Fmac::reset() {
+    // Stopping the filter function and reloading zero history restarts the
+    // filter from rest with the same coefficients.
+    FMAC->PARAM = 0;
+    running_ = false;
+    load(kFuncLoadX1, nullptr, 0, p_);
+    if (iir_) {
+        load(kFuncLoadY, nullptr, 0, q_);
+    }
+}
+
+Status Fmac::start(const q15_t* in, q15_t* out, std::size_t n) {
+    if (!configured_) {
+        return Status::invalid_argument;
+    }
+    if (n == 0) {
+        return Status::ok;
+    }
+    if (n * sizeof(q15_t) > DMA_CBR1_BNDT || busy()) {
+        return n * sizeof(q15_t) > DMA_CBR1_BNDT ? Status::invalid_argument : Status::busy;
+    }
+    const std::uint32_t bytes = static_cast<std::uint32_t>(n * sizeof(q15_t));
+    constexpr std::uint32_t kHalfWords = (1u << DMA_CTR1_SDW_LOG2_Pos) | (1u << DMA_CTR1_DDW_LOG2_Pos);
+
+    kReadChannel->CCR = DMA_CCR_RESET;
+    kReadChannel->CTR1 = kHalfWords | DMA_CTR1_DINC;
+    kReadChannel->CTR2 = kRequestFmacRead << DMA_CTR2_REQSEL_Pos;
+    kReadChannel->CBR1 = bytes;
+    kReadChannel->CSAR = reinterpret_cast<std::uint32_t>(&FMAC->RDATA);
+    kReadChannel->CDAR = reinterpret_cast<std::uint32_t>(out);
+    kReadChannel->CLLR = 0;
+    kReadChannel->CFCR = kDmaAllFlags;
+    kReadChannel->CCR = DMA_CCR_EN;
+
+    kWriteChannel->CCR = DMA_CCR_RESET;
+    kWriteChannel->CTR1 = kHalfWords | DMA_CTR1_SINC;
+    kWriteChannel->CTR2 = (kRequestFmacWrite << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ;
+    kWriteChannel->CBR1 = bytes;
+    kWriteChannel->CSAR = reinterpret_cast<std::uint32_t>(in);
+    kWriteChannel->CDAR = reinterpret_cast<std::uint32_t>(&FMAC->WDATA);
+    kWriteChannel->CLLR = 0;
+    kWriteChannel->CFCR = kDmaAllFlags;
+    kWriteChannel->CCR = DMA_CCR_EN;
+
+    FMAC->CR = FMAC_CR_DMAREN | FMAC_CR_DMAWEN | FMAC_CR_CLIPEN;
+    if (!running_) {
+        // The filter function keeps running between transfers, holding its
+        // history in X1/Y, so consecutive blocks filter as one stream.
+        FMAC->PARAM = param(iir_ ? kFuncIir : kFuncFir, p_, q_, gain_) | FMAC_PARAM_START;
+        running_ = true;
+    }
+    return Status::ok;
+}
+
+bool Fmac::busy() const { return (kReadChannel->CCR & DMA_CCR_EN) != 0 && (kReadChannel->CSR & DMA_CSR_TCF) == 0; }
+
+Status Fmac::wait(std::uint32_t timeout_ms) {
+    const std::uint32_t start = platform::millis();
+    while (busy()) {
+        if (platform::millis() - start > timeout_ms) {
+            return Status::timeout;
+        }
+    }
+    if ((FMAC->SR & FMAC_SR_SAT) != 0) {
+        ++saturations_;
+    }
+    const std::uint32_t errors = DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF;
+    const bool failed = ((kReadChannel->CSR | kWriteChannel->CSR) & errors) != 0;
+    kReadChannel->CFCR = kDmaAllFlags;
+    kWriteChannel->CFCR = kDmaAllFlags;
+    return failed ? Status::hardware_error : Status::ok;
+}
+
+Fmac& fmac() {
+    static Fmac instance;
+    return instance;
+}
+
+}  // namespace nucleo::dsp
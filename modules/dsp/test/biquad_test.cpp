@@ -0,0 +1,132 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "nucleo/dsp/biquad.hpp"
+#include "nucleo/dsp/reference.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::dsp;
+
+namespace {
+
+std::vector<q15_t> noise_q15(std::size_t n, unsigned seed, int amplitude) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-amplitude, amplitude);
+    std::vector<q15_t> v(n);
+    for (q15_t& x : v) {
+        x = static_cast<q15_t>(dist(rng));
+    }
+    return v;
+}
+
+const BiquadDesign kDesigns[] = {
+    design_lowpass(1000, 48000),
+    design_highpass(200, 48000),
+    design_bandpass(3000, 48000, 2.0),
+    design_lowpass(10, 48000),  // poles close to z = 1, the hard case in fixed point
+};
+
+}  // namespace
+
+TEST(post_shift_makes_coefficients_fit) {
+    for (const BiquadDesign& d : kDesigns) {
+        const int shift = biquad_post_shift(d);
+        CHECK(shift >= 1);  // |a1| is close to 2 for all of these
+        const double scale = std::ldexp(1.0, -shift);
+        CHECK(std::fabs(d.a1 * scale) < 1.0);
+    }
+    CHECK_EQ(biquad_post_shift(BiquadDesign{0.5, 0.25, 0.125, 0, 0}), 0);
+}
+
+TEST(biquad_q15_cascade_is_bit_exact) {
+    const int shift = 1;
+    std::vector<BiquadQ15Coeffs> sections;
+    for (const BiquadDesign& d : kDesigns) {
+        sections.push_back(quantize_q15(d, shift));
+    }
+    const auto input = noise_q15(2000, 3, 8000);
+    std::vector<BiquadState<q15_t>> state(sections.size());
+    BiquadCascadeQ15 filter({sections.data(), sections.size()}, {state.data(), state.size()}, shift);
+    std::vector<q15_t> got(input.size());
+    for (std::size_t pos = 0, chunk = 1; pos < input.size(); chunk = chunk * 5 % 61 + 1) {
+        const std::size_t n = std::min(chunk, input.size() - pos);
+        filter.process(input.data() + pos, got.data() + pos, n);
+        pos += n;
+    }
+
+    std::vector<BiquadState<q15_t>> ref_state(sections.size());
+    std::vector<q15_t> want(input.size());
+    reference::biquad_q15({sections.data(), sections.size()}, {ref_state.data(), ref_state.size()}, shift,
+                          input.data(), want.data(), input.size());
+    CHECK(got == want);
+}
+
+TEST(biquad_q15_saturation_is_bit_exact) {
+    // A full-scale square wave overshoots through a Butterworth lowpass and
+    // clips; the kernel must clip identically or the recursion diverges.
+    const BiquadDesign d = design_lowpass(1000, 48000);
+    const int shift = biquad_post_shift(d);
+    const BiquadQ15Coeffs c[] = {quantize_q15(d, shift)};
+    std::vector<q15_t> input(1000);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = (i / 200) % 2 ? -32768 : 32767;
+    }
+    BiquadState<q15_t> st[1];
+    BiquadState<q15_t> ref_st[1];
+    BiquadCascadeQ15 filter(c, st, shift);
+    std::vector<q15_t> got(input.size());
+    std::vector<q15_t> want(input.size());
+    filter.process(input.data(), got.data(), input.size());
+    reference::biquad_q15(c, ref_st, shift, input.data(), want.data(), input.size());
+    CHECK(got == want);
+    bool clipped = false;
+    for (const q15_t v : got) {
+        clipped = clipped || v == 32767 || v == -32768;
+    }
+    CHECK(clipped);
+}
+
+TEST(biquad_q31_cascade_is_bit_exact) {
+    const int shift = 1;
+    std::vector<BiquadQ31Coeffs> sections;
+    for (const BiquadDesign& d : kDesigns) {
+        sections.push_back(quantize_q31(d, shift));
+    }
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<q31_t> dist(-(1 << 28), 1 << 28);
+    std::vector<q31_t> input(2000);
+    for (q31_t& x : input) {
+        x = dist(rng);
+    }
+    std::vector<BiquadState<q31_t>> state(sections.size());
+    BiquadCascadeQ31 filter({sections.data(), sections.size()}, {state.data(), state.size()}, shift);
+    std::vector<q31_t> got(input);
+    filter.process(got.data(), got.data(), 700);  // in place, in two calls
+    filter.process(got.data() + 700, got.data() + 700, got.size() - 700);
+
+    std::vector<BiquadState<q31_t>> ref_state(sections.size());
+    std::vector<q31_t> want(input.size());
+    reference::biquad_q31({sections.data(), sections.size()}, {ref_state.data(), ref_state.size()}, shift,
+                          input.data(), want.data(), input.size());
+    CHECK(got == want);
+}
+
+TEST(lowpass_passes_dc_and_highpass_blocks_it) {
+    for (const bool low : {true, false}) {
+        const BiquadDesign d = low ? design_lowpass(2000, 48000) : design_highpass(2000, 48000);
+        const int shift = biquad_post_shift(d);
+        const BiquadQ31Coeffs c[] = {quantize_q31(d, shift)};
+        BiquadState<q31_t> st[1];
+        BiquadCascadeQ31 filter(c, st, shift);
+        std::vector<q31_t> x(4000, to_q31(0.5));
+        filter.process(x.data(), x.data(), x.size());
+        const double settled = from_q31(x.back());
+        if (low) {
+            CHECK(std::fabs(settled - 0.5) < 1e-4);
+        } else {
+            CHECK(std::fabs(settled) < 1e-4);
+        }
+    }
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "nucleo/dsp/cordic.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::dsp;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double bound(int bits) { return std::ldexp(1.0, -bits); }
+
+// Angle error in units of pi, folded across the +-pi seam.
+double angle_error(q31_t got, double want_over_pi) {
+    double d = from_q31(got) - want_over_pi;
+    if (d > 1) {
+        d -= 2;
+    } else if (d < -1) {
+        d += 2;
+    }
+    return std::fabs(d);
+}
+
+std::vector<q31_t> random_q31(std::size_t n, unsigned seed, q31_t limit = INT32_MAX) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<q31_t> dist(-limit, limit);
+    std::vector<q31_t> v(n);
+    for (q31_t& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+struct PrecisionScope {
+    explicit PrecisionScope(std::uint8_t p) { (void)cordic().set_precision(p); }
+    ~PrecisionScope() { (void)cordic().set_precision(Cordic::kDefaultPrecision); }
+};
+
+double sincos_error(const std::vector<q31_t>& angles) {
+    double worst = 0;
+    for (const q31_t a : angles) {
+        const SinCos sc = cordic().sincos(a);
+        const double theta = from_q31(a) * kPi;
+        worst = std::max({worst, std::fabs(from_q31(sc.sin) - std::sin(theta)),
+                          std::fabs(from_q31(sc.cos) - std::cos(theta))});
+    }
+    return worst;
+}
+
+}  // namespace
+
+TEST(sincos_stays_within_bound_over_the_circle) {
+    auto angles = random_q31(20000, 1);
+    angles.insert(angles.end(), {0, INT32_MIN, INT32_MAX, 1 << 30, -(1 << 30), 1 << 29, 3 << 29});
+    CHECK(sincos_error(angles) <= bound(22));
+
+    // The modulus scales both results.
+    const SinCos half = cordic().sincos(to_q31(1.0 / 6), to_q31(0.5));
+    CHECK(std::fabs(from_q31(half.sin) - 0.25) <= bound(22));
+    CHECK(std::fabs(from_q31(half.cos) - 0.5 * std::cos(kPi / 6)) <= bound(22));
+}
+
+TEST(atan2_covers_every_quadrant) {
+    const auto x = random_q31(20000, 2);
+    const auto y = random_q31(20000, 3);
+    double worst = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        worst = std::max(worst, angle_error(cordic().atan2(y[i], x[i]), std::atan2(y[i], x[i]) / kPi));
+    }
+    CHECK(worst <= bound(24));
+
+    const q31_t one = INT32_MAX;
+    CHECK(angle_error(cordic().atan2(0, one), 0.0) <= bound(24));
+    CHECK(angle_error(cordic().atan2(one, 0), 0.5) <= bound(24));
+    CHECK(angle_error(cordic().atan2(-one, 0), -0.5) <= bound(24));
+    CHECK(angle_error(cordic().atan2(0, -one), 1.0) <= bound(24));
+    CHECK(angle_error(cordic().atan2(-1000, -one), std::atan2(-1000.0, -one) / kPi) <= bound(24));
+}
+
+TEST(magnitude_and_polar_agree_with_hypot) {
+    // Half-scale components keep the magnitude below 1.
+    const auto x = random_q31(20000, 4, INT32_MAX / 2);
+    const auto y = random_q31(20000, 5, INT32_MAX / 2);
+    double worst = 0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        const double want = std::hypot(from_q31(x[i]), from_q31(y[i]));
+        worst = std::max(worst, std::fabs(from_q31(cordic().magnitude(x[i], y[i])) - want));
+        const Polar p = cordic().polar(x[i], y[i]);
+        CHECK_EQ(p.angle, cordic().atan2(y[i], x[i]));
+        worst = std::max(worst, std::fabs(from_q31(p.magnitude) - want));
+    }
+    CHECK(worst <= bound(29));
+    // Past full scale the magnitude saturates rather than wrapping.
+    CHECK_EQ(cordic().magnitude(INT32_MAX, INT32_MAX), INT32_MAX);
+}
+
+TEST(sqrt_holds_its_bound_down_to_the_smallest_inputs) {
+    std::mt19937 rng(6);
+    double worst = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const q31_t v = static_cast<q31_t>(rng() & 0x7FFFFFFF) >> (rng() % 31);
+        worst = std::max(worst, std::fabs(from_q31(cordic().sqrt(v)) - std::sqrt(from_q31(v))));
+    }
+    for (const q31_t v : {1, 2, 3, 0x00DC0000, 0x5FFFFFFF, 0x60000000, INT32_MAX}) {
+        worst = std::max(worst, std::fabs(from_q31(cordic().sqrt(v)) - std::sqrt(from_q31(v))));
+    }
+    CHECK(worst <= bound(29));
+    CHECK_EQ(cordic().sqrt(0), 0);
+    CHECK_EQ(cordic().sqrt(-5), 0);
+}
+
+TEST(model_sqrt_applies_the_scale_factor) {
+    // RM0481: ARG1 = x * 2^-n, RES1 = sqrt(x) * 2^-n.
+    for (const double x : {0.1, 0.7, 1.2, 1.9, 2.3}) {
+        const std::uint8_t n = x < 0.75 ? 0 : x < 1.75 ? 1 : 2;
+        const CordicResult r =
+            cordic_model(CordicFunction::sqrt, to_q31(std::ldexp(x, -n)), 0, Cordic::kDefaultPrecision, n);
+        CHECK(std::fabs(from_q31(r.res1) - std::ldexp(std::sqrt(x), -n)) <= bound(28));
+    }
+}
+
+TEST(precision_trades_accuracy_for_latency) {
+    Cordic& c = cordic();
+    CHECK_EQ(c.set_precision(0), Status::invalid_argument);
+    CHECK_EQ(c.set_precision(16), Status::invalid_argument);
+    CHECK_EQ(c.precision(), Cordic::kDefaultPrecision);
+
+    const auto angles = random_q31(5000, 7);
+    double error[4] = {};
+    for (std::uint8_t p = 3; p <= 6; ++p) {
+        PrecisionScope scope(p);
+        error[p - 3] = sincos_error(angles);
+    }
+    for (int i = 0; i < 3; ++i) {
+        CHECK(error[i] > 4 * error[i + 1]);
+    }
+    CHECK(error[0] <= bound(10));
+}
+
+TEST(batches_match_one_shot_calls) {
+    Cordic& c = cordic();
+    const std::size_t n = 300;
+    const auto angles = random_q31(n, 8);
+    const auto xs = random_q31(n, 9, INT32_MAX / 2);
+    const auto ys = random_q31(n, 10, INT32_MAX / 2);
+    std::vector<Vec2> vectors(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        vectors[i] = {xs[i], ys[i]};
+    }
+
+    std::vector<SinCos> sc(n);
+    REQUIRE_EQ(c.sincos(angles.data(), sc.data(), n), Status::ok);
+    std::vector<q31_t> phase(n);
+    REQUIRE_EQ(c.start_atan2(vectors.data(), phase.data(), n), Status::ok);
+    REQUIRE_EQ(c.wait(), Status::ok);
+    std::vector<Polar> polar(n);
+    REQUIRE_EQ(c.polar(vectors.data(), polar.data(), n), Status::ok);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const SinCos one = c.sincos(angles[i]);
+        CHECK_EQ(sc[i].sin, one.sin);
+        CHECK_EQ(sc[i].cos, one.cos);
+        CHECK_EQ(phase[i], c.atan2(ys[i], xs[i]));
+        CHECK_EQ(polar[i].angle, phase[i]);
+        CHECK_EQ(polar[i].magnitude, c.magnitude(xs[i], ys[i]));
+    }
+}
+
+TEST(batches_longer_than_one_dma_block_are_rejected) {
+    std::vector<q31_t> angles(Cordic::kMaxBatch + 1);
+    std::vector<SinCos> out(angles.size());
+    CHECK_EQ(cordic().start_sincos(angles.data(), out.data(), angles.size()), Status::invalid_argument);
+    CHECK_EQ(cordic().sincos(angles.data(), out.data(), Cordic::kMaxBatch), Status::ok);
+    CHECK_EQ(cordic().sincos(angles.data(), out.data(), 0), Status::ok);
+}
@@ -0,0 +1,152 @@
+#include <random>
+#include <vector>
+
+#include "nucleo/dsp/fir.hpp"
+#include "nucleo/dsp/reference.hpp"
+#include "nucleo/dsp/simd.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::dsp;
+
+namespace {
+
+template <typename T>
+std::vector<T> random_vector(std::size_t n, std::mt19937& rng, int bits) {
+    std::uniform_int_distribution<std::int64_t> dist(-(std::int64_t{1} << (bits - 1)),
+                                                     (std::int64_t{1} << (bits - 1)) - 1);
+    std::vector<T> v(n);
+    for (T& x : v) {
+        x = static_cast<T>(dist(rng));
+    }
+    return v;
+}
+
+// Runs kernel and reference over the same input, fed in chunks of varying
+// length so block boundaries and history hand-over are exercised.
+template <typename T, typename Filter, typename Reference>
+bool matches_reference(const std::vector<T>& coeffs, std::size_t block, int input_bits, Reference reference) {
+    std::mt19937 rng(static_cast<unsigned>(coeffs.size() * 131 + block));
+    const std::vector<T> input = random_vector<T>(1000, rng, input_bits);
+
+    std::vector<T> state(fir_state_size(coeffs.size(), block));
+    Filter filter({coeffs.data(), coeffs.size()}, {state.data(), state.size()});
+    std::vector<T> got(input.size());
+    std::size_t pos = 0;
+    for (std::size_t chunk = 1; pos < input.size(); chunk = chunk * 3 % 97 + 1) {
+        const std::size_t n = std::min(chunk, input.size() - pos);
+        filter.process(input.data() + pos, got.data() + pos, n);
+        pos += n;
+    }
+
+    std::vector<T> history(coeffs.size() - 1);
+    std::vector<T> want(input.size());
+    reference({coeffs.data(), coeffs.size()}, {history.data(), history.size()}, input.data(), want.data(),
+              input.size());
+    return got == want;
+}
+
+}  // namespace
+
+TEST(simd_emulation_matches_instruction_semantics) {
+    const std::uint32_t x = simd::pack_lo(static_cast<std::uint16_t>(-3), 5);
+    const std::uint32_t y = simd::pack_lo(7, static_cast<std::uint16_t>(-11));
+    CHECK_EQ(simd::lo(x), -3);
+    CHECK_EQ(simd::hi(x), 5);
+    CHECK_EQ(simd::smlald(x, y, 100), 100 + (-3 * 7) + (5 * -11));
+    CHECK_EQ(simd::smlaldx(x, y, 100), 100 + (-3 * -11) + (5 * 7));
+    const q15_t pair[2] = {-32768, 32767};
+    CHECK_EQ(simd::lo(simd::load_pair(pair)), -32768);
+    CHECK_EQ(simd::hi(simd::load_pair(pair)), 32767);
+}
+
+TEST(q_conversions_round_and_saturate) {
+    CHECK_EQ(to_q15(0.5), 16384);
+    CHECK_EQ(to_q15(-1.0), -32768);
+    CHECK_EQ(to_q15(1.0), 32767);
+    CHECK_EQ(to_q31(-0.25), -536870912);
+    CHECK_EQ(sat_q15(40000), 32767);
+    CHECK_EQ(sat_q31(-(std::int64_t{1} << 40)), INT32_MIN);
+}
+
+TEST(fir_q15_impulse_response_is_the_coefficients) {
+    const q15_t coeffs[] = {100, -200, 300, -400, 500};
+    StaticFirQ15<5, 8> fir(coeffs);
+    q15_t x[8] = {-32768};  // -1.0
+    q15_t y[8] = {};
+    fir.process(x, y, 8);
+    for (std::size_t i = 0; i < 5; ++i) {
+        CHECK_EQ(y[i], -coeffs[i]);
+    }
+    CHECK_EQ(y[5], 0);
+}
+
+TEST(fir_q15_kernel_is_bit_exact) {
+    std::mt19937 rng(1);
+    for (const std::size_t taps : {1u, 2u, 3u, 4u, 7u, 16u, 31u, 64u}) {
+        for (const std::size_t block : {1u, 2u, 5u, 64u}) {
+            const auto coeffs = random_vector<q15_t>(taps, rng, 16);
+            CHECK((matches_reference<q15_t, FirQ15>(coeffs, block, 16, reference::fir_q15)));
+        }
+    }
+}
+
+TEST(fir_q15_saturates_like_the_reference) {
+    const std::vector<q15_t> coeffs(8, 32767);
+    CHECK((matches_reference<q15_t, FirQ15>(coeffs, 16, 16, reference::fir_q15)));
+    StaticFirQ15<8, 16> fir(Span<const q15_t>{coeffs.data(), coeffs.size()});
+    q15_t x[16];
+    for (q15_t& v : x) {
+        v = 32767;
+    }
+    fir.process(x, x, 16);  // in place
+    CHECK_EQ(x[15], 32767);
+}
+
+TEST(fir_q31_kernel_is_bit_exact) {
+    std::mt19937 rng(2);
+    for (const std::size_t taps : {1u, 2u, 5u, 16u, 33u}) {
+        for (const std::size_t block : {1u, 3u, 32u}) {
+            const auto coeffs = random_vector<q31_t>(taps, rng, 32);
+            // Inputs with log2(taps) bits of headroom, as documented.
+            CHECK((matches_reference<q31_t, FirQ31>(coeffs, block, 26, reference::fir_q31)));
+        }
+    }
+}
+
+TEST(fir_reset_clears_history) {
+    const q31_t coeffs[] = {to_q31(0.5), to_q31(0.5)};
+    StaticFirQ31<2, 4> fir(coeffs);
+    q31_t x[1] = {to_q31(0.5)};
+    q31_t y[1] = {};
+    fir.process(x, y, 1);
+    fir.reset();
+    x[0] = 0;
+    fir.process(x, y, 1);
+    CHECK_EQ(y[0], 0);
+}
+
+TEST(fir_without_room_for_a_block_is_rejected) {
+    const q15_t coeffs[] = {100, 200, 300};
+    q15_t state[3] = {};
+    q15_t x[4] = {1, 2, 3, 4};
+    q15_t y[4] = {7, 7, 7, 7};
+
+    FirQ15 too_short({coeffs, 3}, {state, 1});
+    CHECK(!too_short.valid());
+    FirQ15 no_block({coeffs, 3}, {state, 2});  // history only
+    CHECK(!no_block.valid());
+    FirQ15 no_taps({coeffs, 0}, {state, 3});
+    CHECK(!no_taps.valid());
+    no_taps.process(x, y, 4);  // returns instead of spinning
+    CHECK_EQ(y[0], 7);
+
+    FirQ15 one_sample({coeffs, 3}, {state, 3});
+    CHECK(one_sample.valid());
+    CHECK_EQ(one_sample.block_size(), 1u);
+
+    const q31_t coeffs31[] = {1, 2};
+    q31_t state31[1] = {};
+    CHECK(!FirQ31({coeffs31, 2}, {state31, 1}).valid());
+    CHECK(FirQ31({coeffs31, 1}, {state31, 1}).valid());
+}
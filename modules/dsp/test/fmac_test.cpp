@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "nucleo/dsp/biquad.hpp"
+#include "nucleo/dsp/fmac.hpp"
+#include "nucleo/dsp/reference.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::dsp;
+
+namespace {
+
+std::vector<q15_t> noise(std::size_t n, unsigned seed, int amplitude) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-amplitude, amplitude);
+    std::vector<q15_t> v(n);
+    for (q15_t& x : v) {
+        x = static_cast<q15_t>(dist(rng));
+    }
+    return v;
+}
+
+int max_abs_diff(const std::vector<q15_t>& a, const std::vector<q15_t>& b) {
+    int worst = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        worst = std::max(worst, std::abs(a[i] - b[i]));
+    }
+    return worst;
+}
+
+}  // namespace
+
+TEST(fir_model_stays_within_one_lsb_of_exact) {
+    // Each product loses < 2^-22 to truncation, so 64 taps cost < 0.5 LSB
+    // before the final truncation to Q15.
+    const auto coeffs = noise(64, 5, 1200);
+    const auto input = noise(1000, 6, 32767);
+    std::vector<q15_t> x_history(coeffs.size());
+    std::vector<q15_t> fmac_out(input.size());
+    fmac_fir_model({coeffs.data(), coeffs.size()}, {x_history.data(), x_history.size()}, 0, input.data(),
+                   fmac_out.data(), input.size());
+
+    std::vector<q15_t> history(coeffs.size() - 1);
+    std::vector<q15_t> exact(input.size());
+    reference::fir_q15({coeffs.data(), coeffs.size()}, {history.data(), history.size()}, input.data(),
+                       exact.data(), input.size());
+    CHECK(max_abs_diff(fmac_out, exact) <= 1);
+}
+
+TEST(fir_model_clips_and_counts) {
+    const q15_t coeffs[] = {32767, 32767, 32767};
+    q15_t history[3] = {};
+    const q15_t in[4] = {30000, 30000, 30000, -30000};
+    q15_t out[4];
+    const std::size_t saturated = fmac_fir_model(coeffs, history, 0, in, out, 4);
+    CHECK_EQ(out[1], 32767);
+    CHECK_EQ(out[2], 32767);
+    CHECK_EQ(saturated, 2u);
+}
+
+TEST(fmac_driver_streams_blocks_like_one_call) {
+    const auto coeffs = noise(31, 7, 3000);
+    const auto input = noise(500, 8, 20000);
+
+    Fmac& f = fmac();
+    REQUIRE_EQ(f.configure_fir({coeffs.data(), coeffs.size()}, 1), Status::ok);
+    std::vector<q15_t> got(input.size());
+    REQUIRE_EQ(f.process(input.data(), got.data(), 200), Status::ok);
+    REQUIRE_EQ(f.start(input.data() + 200, got.data() + 200, 300), Status::ok);
+    REQUIRE_EQ(f.wait(), Status::ok);
+
+    std::vector<q15_t> history(coeffs.size());
+    std::vector<q15_t> want(input.size());
+    fmac_fir_model({coeffs.data(), coeffs.size()}, {history.data(), history.size()}, 1, input.data(),
+                   want.data(), input.size());
+    CHECK(got == want);
+
+    f.reset();
+    std::vector<q15_t> again(200);
+    f.process(input.data(), again.data(), again.size());
+    CHECK(std::equal(again.begin(), again.end(), want.begin()));
+}
+
+TEST(fmac_iir_tracks_the_software_biquad) {
+    const BiquadDesign d = design_lowpass(2000, 48000);
+    const int shift = biquad_post_shift(d);
+    const BiquadQ15Coeffs c = quantize_q15(d, shift);
+    const q15_t b[] = {c.b0, c.b1, c.b2};
+    const q15_t a[] = {c.a1, c.a2};
+
+    Fmac& f = fmac();
+    REQUIRE_EQ(f.configure_iir(b, a, static_cast<std::uint8_t>(shift)), Status::ok);
+    const auto input = noise(2000, 9, 16000);
+    std::vector<q15_t> hw(input.size());
+    REQUIRE_EQ(f.process(input.data(), hw.data(), input.size()), Status::ok);
+
+    const BiquadQ15Coeffs sections[] = {c};
+    BiquadState<q15_t> state[1];
+    std::vector<q15_t> sw(input.size());
+    reference::biquad_q15(sections, state, shift, input.data(), sw.data(), input.size());
+    // Truncated products feed back through the recursion; the error stays
+    // bounded for a stable section.
+    CHECK(max_abs_diff(hw, sw) <= 8);
+}
+
+TEST(fmac_rejects_what_does_not_fit) {
+    Fmac& f = fmac();
+    const std::vector<q15_t> too_long(128, 1);
+    CHECK_EQ(f.configure_fir({too_long.data(), too_long.size()}), Status::invalid_argument);
+    const std::vector<q15_t> fits(120, 1);
+    CHECK_EQ(f.configure_fir({fits.data(), fits.size()}), Status::ok);
+    const q15_t one[] = {1};
+    CHECK_EQ(f.configure_fir(one, 8), Status::invalid_argument);
+}
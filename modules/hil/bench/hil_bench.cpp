@@ -0,0 +1,84 @@
+// Cost of recording input on the board side and of decoding it on the
+// host: record time per event and trace bytes per event for a console
+// chunk, a small Ethernet frame and a 64x4 ADC block of a noisy sine.
+//
+// The recorder restarts whenever its 64 KiB storage fills, as a long
+// capture would be cut into traces. Times are host nanoseconds; bytes per
+// event do not depend on the machine.
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "nucleo/hil/host/replay.hpp"
+#include "nucleo/hil/recorder.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::hil;
+
+namespace {
+
+constexpr std::size_t kFrames = 64;
+constexpr std::size_t kChannels = 4;
+
+std::vector<std::uint16_t> adc_block() {
+    std::mt19937 rng(1);
+    std::vector<std::uint16_t> out;
+    for (std::size_t f = 0; f < kFrames; ++f) {
+        for (std::size_t c = 0; c < kChannels; ++c) {
+            const double v = 2048 + 1000 * std::sin(0.05 * static_cast<double>(f) + static_cast<double>(c));
+            out.push_back(static_cast<std::uint16_t>(v + static_cast<double>(rng() % 9) - 4));
+        }
+    }
+    return out;
+}
+
+template <typename Fn>
+void measure(testkit::Bench& bench, const char* name, const char* bytes_name, Fn&& record) {
+    std::vector<std::uint8_t> storage(64 * 1024);
+    Recorder recorder({storage.data(), storage.size()}, perf::cycles);
+    recorder.start(perf::cycle_counter_hz());
+    bench.run(name, 64, [&] {
+        record(recorder);
+        if (!recorder.recording()) {
+            recorder.start(perf::cycle_counter_hz());
+        }
+    });
+
+    recorder.start(perf::cycle_counter_hz());
+    for (int i = 0; i < 100; ++i) {
+        record(recorder);
+    }
+    bench.metric(bytes_name, static_cast<double>(recorder.trace().size() - kTraceHeaderSize) / 100, "B/event");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    perf::cycle_counter_init();
+
+    const std::vector<std::uint8_t> chunk(32, 0x41);
+    const std::vector<std::uint8_t> frame(128, 0x5A);
+    const std::vector<std::uint16_t> samples = adc_block();
+    measure(bench, "record_uart_32", "record_uart_32_bytes",
+            [&](Recorder& r) { r.uart_rx({chunk.data(), chunk.size()}); });
+    measure(bench, "record_eth_128", "record_eth_128_bytes",
+            [&](Recorder& r) { r.eth_rx({frame.data(), frame.size()}); });
+    measure(bench, "record_adc_64x4", "record_adc_64x4_bytes",
+            [&](Recorder& r) { r.adc_block(samples.data(), kFrames, kChannels); });
+    bench.metric("adc_raw_bytes", static_cast<double>(samples.size() * sizeof(std::uint16_t)), "B/event");
+
+    // Host side: decoding a full trace of ADC blocks.
+    std::vector<std::uint8_t> storage(64 * 1024);
+    Recorder recorder({storage.data(), storage.size()}, perf::cycles);
+    recorder.start(perf::cycle_counter_hz());
+    while (recorder.recording()) {
+        recorder.adc_block(samples.data(), kFrames, kChannels);
+    }
+    host::Trace trace;
+    bench.run("decode_64k_adc_trace", 1, [&] { testkit::do_not_optimize(host::decode_trace(recorder.trace(), trace)); });
+    return 0;
+}
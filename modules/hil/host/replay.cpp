@@ -0,0 +1,181 @@
+#include "nucleo/hil/host/replay.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "nucleo/adc/host/sim_adc.hpp"
+#include "nucleo/net/host/sim_ethernet.hpp"
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/uart/host/sim_uart.hpp"
+
+namespace nucleo::hil::host {
+namespace {
+
+// Upper edge of the bucket holding the q-quantile, clamped to [min, max].
+std::uint64_t percentile(const perf::ProbeStats& s, double q) {
+    const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(s.count - 1));
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < perf::kBucketCount; ++i) {
+        seen += s.buckets[i];
+        if (seen > rank) {
+            return std::clamp<std::uint64_t>(perf::bucket_upper(i), s.min, s.max);
+        }
+    }
+    return s.max;
+}
+
+}  // namespace
+
+std::uint32_t Trace::ms(const TraceEvent& event) const {
+    return tick_hz != 0 ? static_cast<std::uint32_t>(event.tick * 1000 / tick_hz) : 0;
+}
+
+Status decode_trace(ConstByteSpan data, Trace& out) {
+    if (data.size() < kTraceHeaderSize) {
+        return Status::underflow;
+    }
+    ByteReader h(data.first(kTraceHeaderSize));
+    std::uint8_t magic[4] = {};
+    h.bytes(magic, sizeof magic);
+    if (std::memcmp(magic, kTraceMagic, sizeof magic) != 0 || h.u8() != kTraceVersion) {
+        return Status::corrupt;
+    }
+    h.u8();
+    h.u16();
+    out.tick_hz = h.u32();
+    const std::uint32_t length = h.u32();
+    const std::uint32_t count = h.u32();
+    out.dropped = h.u32();
+    if (data.size() - kTraceHeaderSize < length) {
+        return Status::underflow;
+    }
+
+    ByteReader r(data.subspan(kTraceHeaderSize, length));
+    out.events.clear();
+    out.events.reserve(std::min<std::size_t>(count, length));
+    std::uint64_t tick = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        TraceEvent e;
+        e.source = static_cast<Source>(r.u8());
+        tick += r.varint();
+        e.tick = tick;
+        switch (e.source) {
+        case Source::adc_block: {
+            e.channels = r.u8();
+            const std::uint64_t frames = r.varint();
+            if (e.channels == 0 || frames * e.channels > r.remaining()) {
+                return Status::corrupt;  // every sample takes at least a byte
+            }
+            e.samples.resize(static_cast<std::size_t>(frames) * e.channels);
+            for (std::size_t s = 0; s < e.samples.size(); ++s) {
+                const std::int64_t base = s >= e.channels ? e.samples[s - e.channels] : 0;
+                e.samples[s] = static_cast<std::uint16_t>(base + r.svarint());
+            }
+            break;
+        }
+        case Source::uart_rx:
+        case Source::eth_rx: {
+            const std::uint64_t size = r.varint();
+            if (size > r.remaining()) {
+                return Status::corrupt;
+            }
+            e.bytes.resize(static_cast<std::size_t>(size));
+            r.bytes(e.bytes.data(), e.bytes.size());
+            break;
+        }
+        case Source::gpio_edge: {
+            const std::uint64_t v = r.varint();
+            e.line = static_cast<Line>(v >> 1);
+            e.level = (v & 1) != 0;
+            break;
+        }
+        default:
+            return Status::corrupt;
+        }
+        if (!r.ok()) {
+            return Status::corrupt;
+        }
+        out.events.push_back(std::move(e));
+    }
+    return r.remaining() == 0 ? Status::ok : Status::corrupt;
+}
+
+bool Player::deliver_next(std::uint32_t elapsed_ms) {
+    if (done() || trace_.ms(trace_.events[next_]) > elapsed_ms) {
+        return false;
+    }
+    const TraceEvent& e = trace_.events[next_++];
+    switch (e.source) {
+    case Source::adc_block: {
+        adc::host::SimAdc& adc = adc::host::board_adc_sim();
+        if (adc.channels() != e.channels) {
+            ++stats_.adc_mismatched;
+            break;
+        }
+        adc.run_samples(e.samples.data(), e.samples.size() / e.channels);
+        ++stats_.adc_blocks;
+        break;
+    }
+    case Source::uart_rx:
+        uart::host::vcp_sim().receive(ConstByteSpan{e.bytes.data(), e.bytes.size()});
+        ++stats_.uart_chunks;
+        stats_.uart_bytes += static_cast<std::uint32_t>(e.bytes.size());
+        break;
+    case Source::eth_rx:
+        frame_ = e.bytes;
+        // Bit 0 of the first destination byte marks group addresses.
+        if (readdress_ && frame_.size() >= mac_.bytes.size() && (frame_[0] & 1) == 0) {
+            std::copy(mac_.bytes.begin(), mac_.bytes.end(), frame_.begin());
+        }
+        if (!net::host::board_eth_sim().receive(ConstByteSpan{frame_.data(), frame_.size()})) {
+            ++stats_.eth_missed;
+        }
+        ++stats_.eth_frames;
+        break;
+    case Source::gpio_edge:
+        if (e.line == Line::user_button) {
+            platform::host::set_user_button(e.level);
+        }
+        ++stats_.gpio_edges;
+        break;
+    }
+    return true;
+}
+
+std::uint32_t Player::duration_ms() const {
+    return trace_.events.empty() ? 0 : trace_.ms(trace_.events.back());
+}
+
+std::string format_stage_latency() {
+    const double us_per_tick = 1e6 / static_cast<double>(perf::cycle_counter_hz());
+    std::string out;
+    char line[160];
+    std::snprintf(line, sizeof line, "%-24s %10s %10s %10s %10s %10s\n", "stage", "count", "mean us", "p50 us",
+                  "p99 us", "max us");
+    out += line;
+    std::vector<const perf::Probe*> probes;
+    for (const perf::Probe* p = perf::first_probe(); p != nullptr; p = p->next()) {
+        if (p->stats().count != 0) {
+            probes.push_back(p);
+        }
+    }
+    std::sort(probes.begin(), probes.end(),
+              [](const perf::Probe* a, const perf::Probe* b) { return std::strcmp(a->name(), b->name()) < 0; });
+    for (const perf::Probe* p : probes) {
+        const perf::ProbeStats& s = p->stats();
+        std::snprintf(line, sizeof line, "%-24s %10" PRIu32 " %10.2f %10.2f %10.2f %10.2f\n", p->name(), s.count,
+                      static_cast<double>(s.total) / s.count * us_per_tick,
+                      static_cast<double>(percentile(s, 0.5)) * us_per_tick,
+                      static_cast<double>(percentile(s, 0.99)) * us_per_tick,
+                      static_cast<double>(s.max) * us_per_tick);
+        out += line;
+    }
+    return out;
+}
+
+}  // namespace nucleo::hil::host
@@ -0,0 +1,111 @@
+// Host-only decoding and deterministic replay of recorded input traces.
+//
+// A Player feeds the events of a decoded trace into the simulated board
+// (SimAdc, SimUart, SimEthernet and the user button) on the virtual
+// millisecond clock, so a host build of the application sees the same
+// input, in the same order and at the same virtual times, on every run:
+//
+//   hil::host::Trace trace;
+//   hil::host::decode_trace(bytes, trace);
+//   hil::host::Player player(trace);
+//   player.readdress_frames(net::board_mac_address());
+//   for (std::uint32_t ms = 0; !player.done(); ++ms, platform::host::advance_ms(1)) {
+//       while (player.deliver_next(ms)) {
+//           application.poll(platform::millis());
+//       }
+//       application.poll(platform::millis());
+//   }
+//   std::fputs(hil::host::format_stage_latency().c_str(), stdout);
+//
+// What the application does with the input is timed by its perf probes in
+// host nanoseconds, which format_stage_latency() turns into a per-stage
+// table.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nucleo/hil/recorder.hpp"
+#include "nucleo/net/address.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/hil/host/replay.hpp is only available in host builds"
+#endif
+
+namespace nucleo::hil::host {
+
+struct TraceEvent {
+    Source source = Source::uart_rx;
+    /// Ticks since the recording started.
+    std::uint64_t tick = 0;
+    std::vector<std::uint8_t> bytes;     // uart_rx, eth_rx
+    std::vector<std::uint16_t> samples;  // adc_block, interleaved
+    std::uint8_t channels = 0;           // adc_block
+    Line line = Line::user_button;       // gpio_edge
+    bool level = false;                  // gpio_edge
+};
+
+struct Trace {
+    std::uint32_t tick_hz = 0;
+    std::uint32_t dropped = 0;
+    std::vector<TraceEvent> events;
+
+    /// Virtual millisecond at which `event` happened.
+    std::uint32_t ms(const TraceEvent& event) const;
+};
+
+/// Parses a recorder trace. Bytes after the recorded length are ignored,
+/// so a dump of the whole storage decodes. corrupt on a bad magic, version
+/// or record; underflow when truncated.
+Status decode_trace(ConstByteSpan data, Trace& out);
+
+struct PlayerStats {
+    std::uint32_t adc_blocks = 0;
+    std::uint32_t uart_chunks = 0;
+    std::uint32_t uart_bytes = 0;
+    std::uint32_t eth_frames = 0;
+    std::uint32_t gpio_edges = 0;
+    /// Frames the simulated MAC had no free descriptor for, and ADC blocks
+    /// whose channel count did not match the running acquisition.
+    std::uint32_t eth_missed = 0;
+    std::uint32_t adc_mismatched = 0;
+};
+
+class Player {
+public:
+    /// `trace` must outlive the player.
+    explicit Player(const Trace& trace) : trace_(trace) {}
+
+    /// Unicast frames were addressed to the recording board; rewrite their
+    /// destination to `mac` so the simulated interface accepts them.
+    void readdress_frames(const net::MacAddress& mac) {
+        mac_ = mac;
+        readdress_ = true;
+    }
+
+    /// Delivers the next event if it is due at `elapsed_ms` since playback
+    /// began. Returns false when nothing (more) is due.
+    bool deliver_next(std::uint32_t elapsed_ms);
+
+    bool done() const { return next_ == trace_.events.size(); }
+    /// Virtual time of the last event.
+    std::uint32_t duration_ms() const;
+    const PlayerStats& stats() const { return stats_; }
+
+private:
+    const Trace& trace_;
+    std::size_t next_ = 0;
+    net::MacAddress mac_{};
+    bool readdress_ = false;
+    std::vector<std::uint8_t> frame_;
+    PlayerStats stats_{};
+};
+
+/// Count, mean, median, 99th percentile and maximum of every perf probe
+/// that fired, in microseconds.
+std::string format_stage_latency();
+
+}  // namespace nucleo::hil::host
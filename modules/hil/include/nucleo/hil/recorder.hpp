@@ -0,0 +1,108 @@
+// Recording of peripheral input for deterministic replay off the board.
+//
+// The recorder timestamps what the application receives (ADC blocks, UART
+// bytes, Ethernet frames, GPIO edges) into caller-provided storage, which
+// also holds the trace header. Nothing is recorded until start(), and a
+// stopped recorder costs its callers one load. The header is kept current
+// after every record, so trace() is a complete trace at any moment and a
+// debugger can dump the storage as is:
+//
+//   (gdb) dump binary memory input.nhil &g_hil_storage[0] &g_hil_storage[65536]
+//
+// The host build replays it through the simulated peripherals on a virtual
+// clock (nucleo/hil/host/replay.hpp).
+//
+// Layout (little-endian, varint = unsigned LEB128, svarint = ZigZag):
+//
+//   "NHIL"  version:u8  reserved:u8  reserved:u16  tick_hz:u32
+//   length:u32 (record bytes)  record_count:u32  dropped:u32
+//   record_count x {
+//       source:u8  ticks since the previous record (or start()):varint
+//       adc_block:  channels:u8  frames:varint
+//                   frames x channels x svarint (delta from the same channel
+//                   in the previous frame; the first frame from 0)
+//       uart_rx:    length:varint  bytes
+//       eth_rx:     length:varint  frame (without FCS)
+//       gpio_edge:  line << 1 | level:varint
+//   }
+//
+// Once a record does not fit, recording stops and later input is counted
+// in `dropped`, so a trace never has holes in the middle. Those later drops
+// reach the header at stop(), not one header rewrite per input.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::hil {
+
+inline constexpr std::uint8_t kTraceMagic[4] = {'N', 'H', 'I', 'L'};
+inline constexpr std::uint8_t kTraceVersion = 1;
+inline constexpr std::size_t kTraceHeaderSize = 24;
+
+enum class Source : std::uint8_t {
+    adc_block = 1,
+    uart_rx = 2,
+    eth_rx = 3,
+    gpio_edge = 4,
+};
+
+/// GPIO lines as recorded; the replay maps them back to board inputs.
+enum class Line : std::uint8_t {
+    user_button = 0,
+};
+
+class Recorder {
+public:
+    /// Ticks of a free-running counter, e.g. platform::millis. A gap
+    /// between records longer than one wrap of the counter is shortened.
+    using Clock = std::uint32_t (*)();
+
+    /// `storage` holds the header and the records; anything shorter than
+    /// the header records nothing.
+    Recorder(ByteSpan storage, Clock clock) : storage_(storage), clock_(clock) {}
+
+    /// Discards what was recorded and starts a new trace whose timestamps
+    /// count `tick_hz` ticks per second. Also re-arms a full recorder.
+    void start(std::uint32_t tick_hz);
+    /// Ends the trace and brings its header's drop count up to date; later
+    /// input is ignored, not counted as dropped.
+    void stop();
+    bool recording() const { return state_.load(std::memory_order_relaxed) == State::recording; }
+
+    // Each call appends one record. Safe from interrupts and thread code:
+    // the append runs under a critical section, which a stopped recorder
+    // does not take.
+
+    /// Interleaved frames, `channels` samples each, as in adc::Block.
+    void adc_block(const std::uint16_t* samples, std::size_t frames, std::size_t channels);
+    void uart_rx(ConstByteSpan bytes);
+    void eth_rx(ConstByteSpan frame);
+    void gpio_edge(Line line, bool level);
+
+    /// The header and every record so far.
+    ConstByteSpan trace() const { return {storage_.data(), size_}; }
+    std::uint32_t records() const { return records_; }
+    std::uint32_t dropped() const { return dropped_; }
+
+private:
+    enum class State : std::uint8_t { idle, recording, full };
+
+    template <typename Fn>
+    void append(Source source, Fn&& payload);
+    void write_header();
+
+    ByteSpan storage_;
+    Clock clock_;
+    std::size_t size_ = 0;
+    std::uint32_t tick_hz_ = 0;
+    std::uint32_t last_tick_ = 0;
+    std::uint32_t records_ = 0;
+    std::uint32_t dropped_ = 0;
+    std::atomic<State> state_{State::idle};
+};
+
+}  // namespace nucleo::hil
@@ -0,0 +1,109 @@
+#include "nucleo/hil/recorder.hpp"
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/irq.hpp"
+
+namespace nucleo::hil {
+
+void Recorder::start(std::uint32_t tick_hz) {
+    platform::CriticalSection lock;
+    tick_hz_ = tick_hz;
+    records_ = 0;
+    dropped_ = 0;
+    last_tick_ = clock_();
+    if (storage_.size() < kTraceHeaderSize) {
+        size_ = 0;
+        state_.store(State::idle, std::memory_order_relaxed);
+        return;
+    }
+    size_ = kTraceHeaderSize;
+    write_header();
+    state_.store(State::recording, std::memory_order_relaxed);
+}
+
+void Recorder::stop() {
+    platform::CriticalSection lock;
+    if (state_.load(std::memory_order_relaxed) == State::full) {
+        write_header();
+    }
+    state_.store(State::idle, std::memory_order_relaxed);
+}
+
+void Recorder::write_header() {
+    ByteWriter w(storage_.first(kTraceHeaderSize));
+    w.bytes(kTraceMagic, sizeof kTraceMagic);
+    w.u8(kTraceVersion);
+    w.u8(0);
+    w.u16(0);
+    w.u32(tick_hz_);
+    w.u32(static_cast<std::uint32_t>(size_ - kTraceHeaderSize));
+    w.u32(records_);
+    w.u32(dropped_);
+}
+
+template <typename Fn>
+void Recorder::append(Source source, Fn&& payload) {
+    if (state_.load(std::memory_order_relaxed) == State::idle) {
+        return;
+    }
+    platform::CriticalSection lock;
+    const State state = state_.load(std::memory_order_relaxed);
+    if (state != State::recording) {
+        if (state == State::full) {
+            ++dropped_;
+        }
+        return;
+    }
+    const std::uint32_t now = clock_();
+    ByteWriter w(storage_.subspan(size_));
+    w.u8(static_cast<std::uint8_t>(source));
+    w.varint(now - last_tick_);
+    payload(w);
+    if (w.ok()) {
+        size_ += w.size();
+        last_tick_ = now;
+        ++records_;
+    } else {
+        state_.store(State::full, std::memory_order_relaxed);
+        ++dropped_;
+    }
+    write_header();
+}
+
+void Recorder::adc_block(const std::uint16_t* samples, std::size_t frames, std::size_t channels) {
+    append(Source::adc_block, [&](ByteWriter& w) {
+        w.u8(static_cast<std::uint8_t>(channels));
+        w.varint(frames);
+        // Neighbouring frames differ little, so deltas are mostly one byte.
+        const std::uint16_t* previous = nullptr;
+        for (std::size_t f = 0; f < frames; ++f) {
+            const std::uint16_t* frame = samples + f * channels;
+            for (std::size_t c = 0; c < channels; ++c) {
+                const std::int32_t base = previous != nullptr ? previous[c] : 0;
+                w.svarint(static_cast<std::int32_t>(frame[c]) - base);
+            }
+            previous = frame;
+        }
+    });
+}
+
+void Recorder::uart_rx(ConstByteSpan bytes) {
+    append(Source::uart_rx, [&](ByteWriter& w) {
+        w.varint(bytes.size());
+        w.bytes(bytes.data(), bytes.size());
+    });
+}
+
+void Recorder::eth_rx(ConstByteSpan frame) {
+    append(Source::eth_rx, [&](ByteWriter& w) {
+        w.varint(frame.size());
+        w.bytes(frame.data(), frame.size());
+    });
+}
+
+void Recorder::gpio_edge(Line line, bool level) {
+    append(Source::gpio_edge,
+           [&](ByteWriter& w) { w.varint((static_cast<std::uint32_t>(line) << 1) | (level ? 1u : 0u)); });
+}
+
+}  // namespace nucleo::hil
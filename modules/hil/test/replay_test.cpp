@@ -0,0 +1,238 @@
+#include <array>
+#include <vector>
+
+#include "nucleo/adc/acquisition.hpp"
+#include "nucleo/adc/board_adc.hpp"
+#include "nucleo/adc/host/sim_adc.hpp"
+#include "nucleo/hil/host/replay.hpp"
+#include "nucleo/hil/recorder.hpp"
+#include "nucleo/net/board_eth.hpp"
+#include "nucleo/net/ethernet.hpp"
+#include "nucleo/net/host/sim_ethernet.hpp"
+#include "nucleo/platform/board.hpp"
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/uart.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+using namespace nucleo;
+using namespace nucleo::hil;
+
+namespace {
+
+// 1 kHz fake clock, so ticks are virtual milliseconds.
+std::uint32_t g_ticks = 0;
+std::uint32_t fake_clock() { return g_ticks; }
+
+ConstByteSpan bytes(const std::vector<std::uint8_t>& v) { return {v.data(), v.size()}; }
+
+std::vector<std::uint8_t> frame_to(const net::MacAddress& dst, std::uint8_t tag) {
+    std::vector<std::uint8_t> f(60, tag);
+    std::copy(dst.bytes.begin(), dst.bytes.end(), f.begin());
+    return f;
+}
+
+}  // namespace
+
+TEST(round_trip_keeps_order_times_and_payloads) {
+    std::array<std::uint8_t, 512> storage{};
+    Recorder recorder(storage, fake_clock);
+    g_ticks = 100;
+    recorder.start(1000);
+
+    const std::vector<std::uint8_t> chunk = {0x01, 0x02, 0x00};
+    const std::vector<std::uint8_t> frame = frame_to({{0x02, 0x80, 0xE1, 1, 2, 3}}, 0xAB);
+    const std::uint16_t samples[] = {2048, 100, 2050, 98, 2047, 101};
+    g_ticks = 105;
+    recorder.uart_rx(bytes(chunk));
+    g_ticks = 107;
+    recorder.gpio_edge(Line::user_button, true);
+    g_ticks = 1107;
+    recorder.eth_rx(bytes(frame));
+    recorder.adc_block(samples, 3, 2);
+    CHECK_EQ(recorder.records(), 4u);
+    CHECK_EQ(recorder.dropped(), 0u);
+
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace(recorder.trace(), trace), Status::ok);
+    CHECK_EQ(trace.tick_hz, 1000u);
+    REQUIRE_EQ(trace.events.size(), 4u);
+    CHECK(trace.events[0].source == Source::uart_rx);
+    CHECK(trace.events[0].bytes == chunk);
+    CHECK_EQ(trace.ms(trace.events[0]), 5u);
+    CHECK(trace.events[1].source == Source::gpio_edge);
+    CHECK(trace.events[1].line == Line::user_button);
+    CHECK(trace.events[1].level);
+    CHECK_EQ(trace.ms(trace.events[1]), 7u);
+    CHECK(trace.events[2].bytes == frame);
+    CHECK_EQ(trace.ms(trace.events[2]), 1007u);
+    CHECK_EQ(trace.events[3].channels, 2u);
+    CHECK(trace.events[3].samples == std::vector<std::uint16_t>(samples, samples + 6));
+    CHECK_EQ(trace.ms(trace.events[3]), 1007u);
+}
+
+TEST(slowly_varying_adc_blocks_take_about_a_byte_per_sample) {
+    std::vector<std::uint8_t> storage(4096);
+    Recorder recorder({storage.data(), storage.size()}, fake_clock);
+    recorder.start(1000);
+    std::vector<std::uint16_t> samples;
+    for (int f = 0; f < 256; ++f) {
+        samples.push_back(static_cast<std::uint16_t>(2048 + (f % 16) - 8));
+        samples.push_back(static_cast<std::uint16_t>(3000 - f / 4));
+    }
+    recorder.adc_block(samples.data(), 256, 2);
+    // Header, source, time, channels, frame count, 512 one-byte deltas
+    // except the first frame.
+    CHECK(recorder.trace().size() < kTraceHeaderSize + 4 + 512 + 4);
+
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace(recorder.trace(), trace), Status::ok);
+    REQUIRE_EQ(trace.events.size(), 1u);
+    CHECK(trace.events[0].samples == samples);
+}
+
+TEST(recording_stops_when_full_and_counts_drops) {
+    std::array<std::uint8_t, kTraceHeaderSize + 16> storage{};
+    Recorder recorder(storage, fake_clock);
+    recorder.start(1000);
+    const std::vector<std::uint8_t> chunk(6, 0x55);
+    recorder.uart_rx(bytes(chunk));  // 9 bytes
+    recorder.uart_rx(bytes(chunk));  // does not fit
+    recorder.gpio_edge(Line::user_button, false);  // would fit, but no holes
+    CHECK(!recorder.recording());
+    CHECK_EQ(recorder.records(), 1u);
+    CHECK_EQ(recorder.dropped(), 2u);
+
+    // A dump of the whole storage decodes; the unused tail is ignored.
+    // Drops after the first reach the header only at stop().
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace(storage, trace), Status::ok);
+    CHECK_EQ(trace.events.size(), 1u);
+    CHECK_EQ(trace.dropped, 1u);
+    recorder.stop();
+    REQUIRE_EQ(host::decode_trace(storage, trace), Status::ok);
+    CHECK_EQ(trace.dropped, 2u);
+
+    // stop() ends the trace without counting later input, and start()
+    // re-arms it.
+    recorder.start(1000);
+    recorder.stop();
+    recorder.gpio_edge(Line::user_button, true);
+    CHECK_EQ(recorder.records(), 0u);
+    CHECK_EQ(recorder.dropped(), 0u);
+    recorder.start(1000);
+    recorder.gpio_edge(Line::user_button, true);
+    CHECK(recorder.recording());
+    CHECK_EQ(recorder.records(), 1u);
+}
+
+TEST(nothing_is_recorded_before_start) {
+    std::array<std::uint8_t, 64> storage{};
+    Recorder recorder(storage, fake_clock);
+    recorder.gpio_edge(Line::user_button, true);
+    CHECK(!recorder.recording());
+    CHECK_EQ(recorder.records(), 0u);
+    CHECK_EQ(recorder.dropped(), 0u);
+    CHECK(recorder.trace().empty());
+}
+
+TEST(decode_rejects_bad_traces) {
+    std::array<std::uint8_t, 128> storage{};
+    Recorder recorder(storage, fake_clock);
+    recorder.start(1000);
+    const std::vector<std::uint8_t> chunk = {1, 2, 3, 4};
+    recorder.uart_rx(bytes(chunk));
+    std::vector<std::uint8_t> good(recorder.trace().begin(), recorder.trace().end());
+
+    host::Trace trace;
+    CHECK_EQ(host::decode_trace({good.data(), kTraceHeaderSize - 1}, trace), Status::underflow);
+    CHECK_EQ(host::decode_trace({good.data(), good.size() - 1}, trace), Status::underflow);
+
+    std::vector<std::uint8_t> bad = good;
+    bad[0] = 'X';
+    CHECK_EQ(host::decode_trace(bytes(bad), trace), Status::corrupt);
+    bad = good;
+    bad[kTraceHeaderSize] = 9;  // unknown source
+    CHECK_EQ(host::decode_trace(bytes(bad), trace), Status::corrupt);
+    bad = good;
+    bad[kTraceHeaderSize + 2] = 40;  // payload longer than the record
+    CHECK_EQ(host::decode_trace(bytes(bad), trace), Status::corrupt);
+}
+
+TEST(player_feeds_the_simulated_board_on_virtual_time) {
+    platform::host::reset();
+    const net::MacAddress recorded{{0x02, 0x80, 0xE1, 0x11, 0x22, 0x33}};
+    const net::MacAddress broadcast{{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+    const std::vector<std::uint8_t> chunk = {'h', 'i'};
+    const std::uint16_t samples[] = {10, 20, 11, 21, 12, 22, 13, 23};
+
+    std::array<std::uint8_t, 1024> storage{};
+    Recorder recorder(storage, fake_clock);
+    g_ticks = 0;
+    recorder.start(1000);
+    g_ticks = 3;
+    recorder.uart_rx(bytes(chunk));
+    g_ticks = 5;
+    recorder.gpio_edge(Line::user_button, true);
+    recorder.eth_rx(bytes(frame_to(recorded, 1)));
+    recorder.eth_rx(bytes(frame_to(broadcast, 2)));
+    g_ticks = 9;
+    recorder.adc_block(samples, 4, 2);
+    recorder.adc_block(samples, 2, 4);  // not the running scan sequence
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace(recorder.trace(), trace), Status::ok);
+
+    std::array<std::uint8_t, 64> rx{};
+    std::array<std::uint8_t, 64> tx{};
+    uart::Uart console(uart::vcp_port(), rx, tx);
+    REQUIRE_EQ(console.start(921'600), Status::ok);
+    net::StaticPacketPool<8> pool;
+    net::DescriptorRing<4> eth_rx;
+    net::DescriptorRing<4> eth_tx;
+    net::Ethernet ethernet(net::board_ethernet_port(), pool, eth_rx, eth_tx);
+    REQUIRE_EQ(ethernet.start(net::board_mac_address()), Status::ok);
+    std::vector<std::uint16_t> adc_buffer(2 * 4 * 2);
+    adc::Acquisition acquisition(adc::board_adc_port(), {adc_buffer.data(), adc_buffer.size()});
+    const std::uint8_t channels[] = {3, 10};
+    REQUIRE_EQ(acquisition.start({1000, channels, 4}), Status::ok);
+
+    host::Player player(trace);
+    player.readdress_frames(net::board_mac_address());
+    CHECK_EQ(player.duration_ms(), 9u);
+    CHECK(!player.deliver_next(2));
+    CHECK(player.deliver_next(3));
+    CHECK(!player.deliver_next(4));
+    std::vector<std::uint8_t> got;
+    console.rx_drain([&](ConstByteSpan b) { got.insert(got.end(), b.begin(), b.end()); });
+    CHECK(got == chunk);
+
+    while (player.deliver_next(5)) {
+    }
+    CHECK(platform::user_button_pressed());
+    std::vector<std::vector<std::uint8_t>> frames;
+    ethernet.receive([&](net::Packet* p) {
+        frames.emplace_back(p->bytes().begin(), p->bytes().end());
+        pool.release(p);
+    });
+    REQUIRE_EQ(frames.size(), 2u);
+    CHECK(std::equal(frames[0].begin(), frames[0].begin() + 6, net::board_mac_address().bytes.begin()));
+    CHECK_EQ(frames[0][6], 1u);
+    CHECK(std::equal(frames[1].begin(), frames[1].begin() + 6, broadcast.bytes.begin()));
+
+    while (player.deliver_next(9)) {
+    }
+    CHECK(player.done());
+    std::vector<std::uint16_t> seen;
+    acquisition.poll([&](const adc::Block& b) { seen.assign(b.samples, b.samples + b.frames * b.channels); });
+    CHECK(seen == std::vector<std::uint16_t>(samples, samples + 8));
+
+    const host::PlayerStats& s = player.stats();
+    CHECK_EQ(s.uart_chunks, 1u);
+    CHECK_EQ(s.uart_bytes, 2u);
+    CHECK_EQ(s.gpio_edges, 1u);
+    CHECK_EQ(s.eth_frames, 2u);
+    CHECK_EQ(s.eth_missed, 0u);
+    CHECK_EQ(s.adc_blocks, 1u);
+    CHECK_EQ(s.adc_mismatched, 1u);
+    acquisition.stop();
+}
@@ -0,0 +1,191 @@
+// Pool allocator vs. malloc under a long randomized workload.
+//
+// The workload keeps a live set of mixed-size objects (mostly small, a tail
+// of large ones) and randomly allocates or frees, biased to hover around a
+// target occupancy. Reported per allocator:
+//   * allocate / free latency percentiles (per call, clock overhead included)
+//   * internal fragmentation (bytes reserved vs. bytes requested)
+//   * capacity / footprint after the run, which is where fragmentation shows
+#include <malloc.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "nucleo/memory/block_pool.hpp"
+#include "nucleo/memory/pool_set.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::memory;
+using testkit::now_ns;
+
+namespace {
+
+struct Live {
+    void* ptr;
+    std::size_t size;
+};
+
+class Workload {
+public:
+    explicit Workload(std::uint32_t seed) : rng_(seed) {}
+
+    std::size_t next_size() {
+        const std::uint32_t r = rng_() % 100;
+        if (r < 70) {
+            return 8 + rng_() % 57;  // 8..64
+        }
+        if (r < 95) {
+            return 65 + rng_() % 192;  // 65..256
+        }
+        return 257 + rng_() % 768;  // 257..1024
+    }
+
+    /// Allocate when below the target live count, free when above, with noise.
+    bool should_allocate(std::size_t live, std::size_t target) {
+        const std::uint32_t r = rng_() % 100;
+        return live < target ? r < 65 : r < 35;
+    }
+
+    std::size_t pick(std::size_t n) { return rng_() % n; }
+
+private:
+    std::mt19937 rng_;
+};
+
+struct Result {
+    std::vector<double> alloc_ns;
+    std::vector<double> free_ns;
+    double internal_fragmentation = 0;
+    std::size_t failures = 0;
+};
+
+template <typename Alloc, typename Free, typename Reserved>
+Result run(std::size_t ops, std::size_t target_live, Alloc&& alloc, Free&& release,
+           Reserved&& reserved_size) {
+    Workload w(1234);
+    Result r;
+    r.alloc_ns.reserve(ops);
+    r.free_ns.reserve(ops);
+    std::vector<Live> live;
+    live.reserve(target_live * 2);
+    double frag_sum = 0;
+    std::size_t frag_samples = 0;
+
+    for (std::size_t op = 0; op < ops; ++op) {
+        if (live.empty() || w.should_allocate(live.size(), target_live)) {
+            const std::size_t size = w.next_size();
+            const std::uint64_t t0 = now_ns();
+            void* p = alloc(size);
+            const std::uint64_t t1 = now_ns();
+            r.alloc_ns.push_back(static_cast<double>(t1 - t0));
+            if (p == nullptr) {
+                ++r.failures;
+                continue;
+            }
+            static_cast<std::uint8_t*>(p)[0] = 1;  // touch it
+            live.push_back({p, size});
+        } else {
+            const std::size_t i = w.pick(live.size());
+            void* p = live[i].ptr;
+            live[i] = live.back();
+            live.pop_back();
+            const std::uint64_t t0 = now_ns();
+            release(p);
+            const std::uint64_t t1 = now_ns();
+            r.free_ns.push_back(static_cast<double>(t1 - t0));
+        }
+        if (op % 1024 == 0 && !live.empty()) {
+            std::size_t requested = 0;
+            std::size_t reserved = 0;
+            for (const Live& l : live) {
+                requested += l.size;
+                reserved += reserved_size(l);
+            }
+            frag_sum += 1.0 - static_cast<double>(requested) / static_cast<double>(reserved);
+            ++frag_samples;
+        }
+    }
+    for (const Live& l : live) {
+        release(l.ptr);
+    }
+    r.internal_fragmentation = frag_samples != 0 ? frag_sum / static_cast<double>(frag_samples) : 0;
+    return r;
+}
+
+void report(testkit::Bench& bench, const char* name, Result& r) {
+    char label[64];
+    std::snprintf(label, sizeof label, "%s_allocate", name);
+    const auto a = testkit::summarize(r.alloc_ns);
+    bench.report(label, a, "ns");
+    std::snprintf(label, sizeof label, "%s_allocate_p99.9", name);
+    bench.metric(label, a.p999, "ns");
+    std::snprintf(label, sizeof label, "%s_free", name);
+    const auto f = testkit::summarize(r.free_ns);
+    bench.report(label, f, "ns");
+    std::snprintf(label, sizeof label, "%s_free_p99.9", name);
+    bench.metric(label, f.p999, "ns");
+    std::snprintf(label, sizeof label, "%s_internal_fragmentation", name);
+    bench.metric(label, r.internal_fragmentation * 100.0, "%");
+    std::snprintf(label, sizeof label, "%s_failed_allocations", name);
+    bench.metric(label, static_cast<double>(r.failures), "");
+}
+
+// Size classes provisioned for the workload's peak (~600 live objects) with headroom.
+PoolStorage<32, 320> g_pool32;
+PoolStorage<64, 384> g_pool64;
+PoolStorage<128, 128> g_pool128;
+PoolStorage<256, 192> g_pool256;
+PoolStorage<1024, 96> g_pool1024;
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    const std::size_t ops = bench.scale(5'000'000);
+    constexpr std::size_t kTargetLive = 600;
+
+    BlockPool pool32(g_pool32);
+    BlockPool pool64(g_pool64);
+    BlockPool pool128(g_pool128);
+    BlockPool pool256(g_pool256);
+    BlockPool pool1024(g_pool1024);
+    BlockPool* const pools[] = {&pool32, &pool64, &pool128, &pool256, &pool1024};
+    PoolSet set(pools);
+
+    Result pool_result = run(
+        ops, kTargetLive, [&](std::size_t n) { return set.allocate(n); },
+        [&](void* p) { set.deallocate(p); },
+        [&](const Live& l) { return set.owner(l.ptr)->block_size(); });
+    report(bench, "poolset", pool_result);
+    bench.metric("poolset_spills", set.spills(), "");
+
+    // Nothing degrades with age: every block of every class is still available.
+    std::size_t recovered = 0;
+    std::size_t capacity = 0;
+    for (BlockPool* pool : pools) {
+        capacity += pool->capacity();
+        std::vector<void*> blocks;
+        while (void* p = pool->allocate()) {
+            blocks.push_back(p);
+        }
+        recovered += blocks.size();
+        for (void* p : blocks) {
+            pool->deallocate(p);
+        }
+    }
+    bench.metric("poolset_capacity_after_run",
+                 100.0 * static_cast<double>(recovered) / static_cast<double>(capacity),
+                 "%");
+
+    Result malloc_result = run(
+        ops, kTargetLive, [](std::size_t n) { return std::malloc(n); },
+        [](void* p) { std::free(p); }, [](const Live& l) { return malloc_usable_size(l.ptr); });
+    report(bench, "malloc", malloc_result);
+    const struct mallinfo2 info = mallinfo2();
+    bench.metric("malloc_arena_after_run", static_cast<double>(info.arena) / 1024.0, "KiB");
+    bench.metric("malloc_free_bytes_held", static_cast<double>(info.fordblks) / 1024.0, "KiB");
+    return 0;
+}
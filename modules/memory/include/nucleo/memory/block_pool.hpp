@@ -0,0 +1,107 @@
+// Fixed-block pool allocator.
+//
+// allocate() and deallocate() are O(1) and lock-free, so a pool can be
+// shared between interrupt handlers and thread code without masking
+// interrupts. Free blocks form an intrusive LIFO list whose head is a single
+// 32-bit word (16-bit ABA tag, 16-bit block index + 1) updated by CAS, which
+// compiles to LDREX/STREX on the Cortex-M33.
+//
+// Blocks that were never handed out are not on the free list; they are
+// carved off a bump index on demand. A pool therefore needs no
+// initialisation pass: all-zero storage is a valid empty pool, and pools
+// can live in NOLOAD sections and cost nothing at boot.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::memory {
+
+/// Blocks are at least 8-byte aligned and hold at least the free-list link.
+inline constexpr std::size_t kMinBlockAlign = 8;
+
+constexpr std::size_t block_stride(std::size_t size, std::size_t align = kMinBlockAlign) {
+    const std::size_t a = align < kMinBlockAlign ? kMinBlockAlign : align;
+    const std::size_t s = size < sizeof(std::uint32_t) ? sizeof(std::uint32_t) : size;
+    return (s + a - 1) / a * a;
+}
+
+/// Raw, suitably aligned storage for `Count` blocks of `BlockSize` bytes.
+/// All-zero, so it may be placed with NUCLEO_SRAM2_BSS / NUCLEO_SRAM3_BSS.
+template <std::size_t BlockSize, std::size_t Count, std::size_t Align = kMinBlockAlign>
+struct PoolStorage {
+    static_assert(Count > 0 && Count < 0xFFFF, "pool index is 16 bits");
+    static constexpr std::size_t kStride = block_stride(BlockSize, Align);
+    static constexpr std::size_t kCount = Count;
+    alignas(Align < kMinBlockAlign ? kMinBlockAlign : Align) std::uint8_t bytes[kStride * Count];
+};
+
+struct PoolStats {
+    std::uint32_t block_size = 0;
+    std::uint32_t capacity = 0;
+    std::uint32_t in_use = 0;
+    std::uint32_t high_water = 0;  ///< peak in_use since construction
+    std::uint32_t failures = 0;    ///< allocate() calls that returned nullptr
+};
+
+class BlockPool {
+public:
+    constexpr BlockPool(std::uint8_t* storage, std::size_t stride, std::size_t count)
+        : storage_(storage),
+          stride_(static_cast<std::uint32_t>(stride)),
+          capacity_(static_cast<std::uint32_t>(count)) {}
+
+    template <std::size_t BlockSize, std::size_t Count, std::size_t Align>
+    constexpr explicit BlockPool(PoolStorage<BlockSize, Count, Align>& storage)
+        : BlockPool(storage.bytes, storage.kStride, Count) {}
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    /// Returns a block of block_size() bytes, or nullptr when exhausted.
+    void* allocate();
+
+    /// Returns a block to the pool. nullptr is accepted and ignored; a
+    /// pointer that is not a block of this pool yields invalid_argument.
+    Status deallocate(void* block);
+
+    bool owns(const void* block) const;
+
+    std::size_t block_size() const { return stride_; }
+    std::size_t capacity() const { return capacity_; }
+    std::size_t in_use() const { return in_use_.load(std::memory_order_relaxed); }
+    std::size_t available() const { return capacity_ - in_use(); }
+
+    PoolStats stats() const;
+
+private:
+    static constexpr std::uint32_t kIndexMask = 0xFFFF;
+    static constexpr std::uint32_t kTagStep = 0x10000;
+
+    std::uint8_t* block(std::uint32_t index) const { return storage_ + index * stride_; }
+    void note_allocated();
+
+    std::uint8_t* storage_;
+    std::uint32_t stride_;
+    std::uint32_t capacity_;
+    std::atomic<std::uint32_t> free_head_{0};  // tag << 16 | (index + 1), 0 = empty
+    std::atomic<std::uint32_t> untouched_{0};  // blocks [untouched_, capacity_) never used
+    std::atomic<std::uint32_t> in_use_{0};
+    std::atomic<std::uint32_t> high_water_{0};
+    std::atomic<std::uint32_t> failures_{0};
+};
+
+/// Pool bundled with its own storage, for the common default-placement case.
+template <std::size_t BlockSize, std::size_t Count, std::size_t Align = kMinBlockAlign>
+class StaticPool : public BlockPool {
+public:
+    constexpr StaticPool() : BlockPool(storage_) {}
+
+private:
+    PoolStorage<BlockSize, Count, Align> storage_{};
+};
+
+}  // namespace nucleo::memory
@@ -0,0 +1,91 @@
+// Bounded lock-free multi-producer/multi-consumer queue (D. Vyukov's
+// sequence-per-cell design). Any mix of interrupt handlers and thread code
+// may push and pop; each operation is one CAS on the uncontended path.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::memory {
+
+template <typename T, std::size_t Capacity>
+class BoundedQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "queue elements are copied by value");
+
+public:
+    BoundedQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool push(const T& value) {
+        std::uint32_t pos = enqueue_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & kMask];
+            const std::uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::int32_t diff = static_cast<std::int32_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(T& out) {
+        std::uint32_t pos = dequeue_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & kMask];
+            const std::uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::int32_t diff = static_cast<std::int32_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = cell.value;
+                    cell.sequence.store(pos + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = dequeue_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Approximate when other contexts are active.
+    std::size_t size() const {
+        return enqueue_.load(std::memory_order_relaxed) - dequeue_.load(std::memory_order_relaxed);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::uint32_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::uint32_t> sequence;
+        T value;
+    };
+
+    Cell cells_[Capacity];
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> enqueue_{0};
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> dequeue_{0};
+};
+
+}  // namespace nucleo::memory
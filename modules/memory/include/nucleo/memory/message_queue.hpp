@@ -0,0 +1,85 @@
+// Bounded message queue backed by a block pool.
+//
+// Messages are constructed in place in pool blocks and only pointers move
+// through the queue, so posting a large message costs the same as posting a
+// small one and nothing touches the heap. The pool and the queue have the
+// same capacity, so a message that could be acquired can always be posted.
+//
+//   MessageQueue<Sample, 32> queue;
+//   if (Sample* s = queue.acquire()) { fill(*s); queue.post(s); }   // producer
+//   queue.consume([](Sample& s) { process(s); });                  // consumer
+#pragma once
+
+#include <new>
+#include <utility>
+
+#include "nucleo/memory/block_pool.hpp"
+#include "nucleo/memory/bounded_queue.hpp"
+
+namespace nucleo::memory {
+
+template <typename T, std::size_t Capacity>
+class MessageQueue {
+public:
+    MessageQueue() = default;
+    MessageQueue(const MessageQueue&) = delete;
+    MessageQueue& operator=(const MessageQueue&) = delete;
+
+    /// Constructs a message in a free block; nullptr when all are in use.
+    template <typename... Args>
+    T* acquire(Args&&... args) {
+        void* block = pool_.allocate();
+        return block != nullptr ? new (block) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /// Hands an acquired message to the consumer side.
+    void post(T* message) {
+        const bool pushed = queue_.push(message);
+        (void)pushed;  // cannot fail: the queue holds as many slots as the pool
+    }
+
+    /// acquire() + post() in one call. Returns false when the queue is full.
+    template <typename... Args>
+    bool send(Args&&... args) {
+        T* message = acquire(std::forward<Args>(args)...);
+        if (message == nullptr) {
+            return false;
+        }
+        post(message);
+        return true;
+    }
+
+    /// Oldest posted message, or nullptr. Hand it back with release().
+    T* receive() {
+        T* message = nullptr;
+        return queue_.pop(message) ? message : nullptr;
+    }
+
+    void release(T* message) {
+        message->~T();
+        pool_.deallocate(message);
+    }
+
+    /// Receives one message, passes it to fn(T&) and releases it.
+    template <typename Fn>
+    bool consume(Fn&& fn) {
+        T* message = receive();
+        if (message == nullptr) {
+            return false;
+        }
+        fn(*message);
+        release(message);
+        return true;
+    }
+
+    std::size_t pending() const { return queue_.size(); }
+    std::size_t free_slots() const { return pool_.available(); }
+    PoolStats pool_stats() const { return pool_.stats(); }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    StaticPool<sizeof(T), Capacity, alignof(T)> pool_;
+    BoundedQueue<T*, Capacity> queue_;
+};
+
+}  // namespace nucleo::memory
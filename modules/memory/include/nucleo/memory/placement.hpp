@@ -0,0 +1,26 @@
+// SRAM bank placement for zero-initialised objects (buffers, pool storage).
+//
+// SRAM1 (256 KB @ 0x2000'0000) holds .data, .bss and the stack. SRAM2
+// (64 KB @ 0x2004'0000, ECC-capable, retained in Stop mode) and SRAM3
+// (320 KB @ 0x2005'0000) are reserved for objects placed explicitly:
+//
+//   NUCLEO_SRAM3_BSS memory::PoolStorage<256, 64> g_frame_storage;
+//
+// Neither bank is cached (the ICACHE covers C-bus fetches and the DCACHE
+// external memory only), so DMA buffers need no cache maintenance there.
+// NUCLEO_DMA_BUFFER puts one in SRAM3, away from the CPU's traffic in SRAM1,
+// and aligns it to a cache line so a later port with a data cache cannot
+// share a line between a buffer and its neighbour:
+//
+//   NUCLEO_DMA_BUFFER std::uint8_t g_rx[2048];
+//
+// The sections are NOLOAD and zeroed by the startup code, so only objects
+// whose initial state is all-zero bytes may be placed there. In host builds
+// the section macros expand to nothing.
+#pragma once
+
+#include "nucleo/platform/compiler.hpp"
+
+#define NUCLEO_SRAM2_BSS NUCLEO_SECTION(".sram2_bss")
+#define NUCLEO_SRAM3_BSS NUCLEO_SECTION(".sram3_bss")
+#define NUCLEO_DMA_BUFFER NUCLEO_SRAM3_BSS NUCLEO_ALIGNED(NUCLEO_CACHE_LINE)
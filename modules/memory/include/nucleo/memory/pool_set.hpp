@@ -0,0 +1,42 @@
+// Size-class allocator over a set of block pools; the heap replacement for
+// variable-sized runtime allocations.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/memory/block_pool.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::memory {
+
+class PoolSet {
+public:
+    /// `pools` must be ordered by ascending block size and outlive the set.
+    explicit PoolSet(Span<BlockPool* const> pools) : pools_(pools) {}
+
+    /// Serves `size` bytes from the smallest class that fits. If that class
+    /// is exhausted the next larger one is tried (counted in spills()).
+    void* allocate(std::size_t size);
+
+    /// Returns a block to whichever pool owns it.
+    Status deallocate(void* block);
+
+    /// Pool that owns `block`, or nullptr.
+    BlockPool* owner(const void* block) const;
+
+    /// Block size that allocate(size) would prefer, 0 if none is large enough.
+    std::size_t class_size(std::size_t size) const;
+
+    std::uint32_t spills() const { return spills_.load(std::memory_order_relaxed); }
+    std::uint32_t failures() const { return failures_.load(std::memory_order_relaxed); }
+
+private:
+    Span<BlockPool* const> pools_;
+    std::atomic<std::uint32_t> spills_{0};
+    std::atomic<std::uint32_t> failures_{0};
+};
+
+}  // namespace nucleo::memory
@@ -0,0 +1,92 @@
+#include "nucleo/memory/block_pool.hpp"
+
+namespace nucleo::memory {
+namespace {
+
+// The link word lives in the first four bytes of a free block. Another
+// context may be writing the same word after winning a race for the block;
+// the tag makes our CAS fail in that case, so the load only has to be
+// tear-free, not synchronised.
+std::uint32_t load_link(const std::uint8_t* block) {
+    return __atomic_load_n(reinterpret_cast<const std::uint32_t*>(block), __ATOMIC_RELAXED);
+}
+
+void store_link(std::uint8_t* block, std::uint32_t link) {
+    __atomic_store_n(reinterpret_cast<std::uint32_t*>(block), link, __ATOMIC_RELAXED);
+}
+
+}  // namespace
+
+void* BlockPool::allocate() {
+    std::uint32_t head = free_head_.load(std::memory_order_acquire);
+    while ((head & kIndexMask) != 0) {
+        const std::uint32_t index = (head & kIndexMask) - 1;
+        const std::uint32_t next = load_link(block(index)) & kIndexMask;
+        const std::uint32_t desired = ((head + kTagStep) & ~kIndexMask) | next;
+        if (free_head_.compare_exchange_weak(head, desired, std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
+            note_allocated();
+            return block(index);
+        }
+    }
+
+    std::uint32_t fresh = untouched_.load(std::memory_order_relaxed);
+    while (fresh < capacity_) {
+        if (untouched_.compare_exchange_weak(fresh, fresh + 1, std::memory_order_relaxed)) {
+            note_allocated();
+            return block(fresh);
+        }
+    }
+
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+Status BlockPool::deallocate(void* p) {
+    if (p == nullptr) {
+        return Status::ok;
+    }
+    if (!owns(p)) {
+        return Status::invalid_argument;
+    }
+    std::uint8_t* const b = static_cast<std::uint8_t*>(p);
+    const std::uint32_t index = static_cast<std::uint32_t>(b - storage_) / stride_;
+
+    std::uint32_t head = free_head_.load(std::memory_order_relaxed);
+    std::uint32_t desired;
+    do {
+        store_link(b, head & kIndexMask);
+        desired = ((head + kTagStep) & ~kIndexMask) | (index + 1);
+    } while (!free_head_.compare_exchange_weak(head, desired, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    in_use_.fetch_sub(1, std::memory_order_relaxed);
+    return Status::ok;
+}
+
+bool BlockPool::owns(const void* p) const {
+    const std::uint8_t* const b = static_cast<const std::uint8_t*>(p);
+    if (b < storage_ || b >= storage_ + capacity_ * stride_) {
+        return false;
+    }
+    return static_cast<std::uint32_t>(b - storage_) % stride_ == 0;
+}
+
+void BlockPool::note_allocated() {
+    const std::uint32_t now = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::uint32_t peak = high_water_.load(std::memory_order_relaxed);
+    while (now > peak &&
+           !high_water_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+PoolStats BlockPool::stats() const {
+    PoolStats s;
+    s.block_size = stride_;
+    s.capacity = capacity_;
+    s.in_use = in_use_.load(std::memory_order_relaxed);
+    s.high_water = high_water_.load(std::memory_order_relaxed);
+    s.failures = failures_.load(std::memory_order_relaxed);
+    return s;
+}
+
+}  // namespace nucleo::memory
@@ -0,0 +1,49 @@
+#include "nucleo/memory/pool_set.hpp"
+
+namespace nucleo::memory {
+
+void* PoolSet::allocate(std::size_t size) {
+    bool best_fit = true;
+    for (BlockPool* pool : pools_) {
+        if (pool->block_size() < size) {
+            continue;
+        }
+        if (void* block = pool->allocate()) {
+            if (!best_fit) {
+                spills_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return block;
+        }
+        best_fit = false;
+    }
+    failures_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+Status PoolSet::deallocate(void* block) {
+    if (block == nullptr) {
+        return Status::ok;
+    }
+    BlockPool* pool = owner(block);
+    return pool != nullptr ? pool->deallocate(block) : Status::invalid_argument;
+}
+
+BlockPool* PoolSet::owner(const void* block) const {
+    for (BlockPool* pool : pools_) {
+        if (pool->owns(block)) {
+            return pool;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t PoolSet::class_size(std::size_t size) const {
+    for (const BlockPool* pool : pools_) {
+        if (pool->block_size() >= size) {
+            return pool->block_size();
+        }
+    }
+    return 0;
+}
+
+}  // namespace nucleo::memory
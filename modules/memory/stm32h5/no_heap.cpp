@@ -0,0 +1,30 @@
+// The firmware has no heap: runtime memory comes from block pools. Any
+// allocation that slips in through new or malloc stops at a breakpoint
+// instead of quietly fragmenting SRAM.
+#include <cerrno>
+#include <cstddef>
+#include <new>
+
+#include "stm32h5xx.h"
+
+namespace {
+
+[[noreturn]] void heap_used() {
+    for (;;) {
+        __BKPT(1);
+    }
+}
+
+}  // namespace
+
+extern "C" void* _sbrk(std::ptrdiff_t) {
+    errno = ENOMEM;
+    return reinterpret_cast<void*>(-1);
+}
+
+void* operator new(std::size_t) { heap_used(); }
+void* operator new[](std::size_t) { heap_used(); }
+void operator delete(void*) noexcept { heap_used(); }
+void operator delete[](void*) noexcept { heap_used(); }
+void operator delete(void*, std::size_t) noexcept { heap_used(); }
+void operator delete[](void*, std::size_t) noexcept { heap_used(); }
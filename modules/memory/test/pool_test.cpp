@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "nucleo/memory/block_pool.hpp"
+#include "nucleo/memory/pool_set.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::memory;
+
+TEST(stride_rounds_to_alignment) {
+    CHECK_EQ(block_stride(1), 8u);
+    CHECK_EQ(block_stride(8), 8u);
+    CHECK_EQ(block_stride(9), 16u);
+    CHECK_EQ(block_stride(40, 32), 64u);
+    CHECK_EQ((PoolStorage<24, 4, 32>::kStride), 32u);
+}
+
+TEST(allocates_every_block_once_then_fails) {
+    StaticPool<24, 16> pool;
+    std::set<void*> seen;
+    for (int i = 0; i < 16; ++i) {
+        void* p = pool.allocate();
+        REQUIRE(p != nullptr);
+        CHECK(pool.owns(p));
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(p) % kMinBlockAlign, 0u);
+        seen.insert(p);
+    }
+    CHECK_EQ(seen.size(), 16u);
+    CHECK(pool.allocate() == nullptr);
+    const PoolStats s = pool.stats();
+    CHECK_EQ(s.in_use, 16u);
+    CHECK_EQ(s.high_water, 16u);
+    CHECK_EQ(s.failures, 1u);
+}
+
+TEST(freed_blocks_are_reused_lifo) {
+    StaticPool<32, 8> pool;
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CHECK_EQ(pool.deallocate(a), Status::ok);
+    CHECK_EQ(pool.deallocate(b), Status::ok);
+    CHECK(pool.allocate() == b);
+    CHECK(pool.allocate() == a);
+    CHECK_EQ(pool.in_use(), 2u);
+    CHECK_EQ(pool.stats().high_water, 2u);
+}
+
+TEST(rejects_foreign_and_misaligned_pointers) {
+    StaticPool<32, 8> pool;
+    int local = 0;
+    auto* p = static_cast<std::uint8_t*>(pool.allocate());
+    CHECK_EQ(pool.deallocate(&local), Status::invalid_argument);
+    CHECK_EQ(pool.deallocate(p + 4), Status::invalid_argument);
+    CHECK_EQ(pool.deallocate(nullptr), Status::ok);
+    CHECK_EQ(pool.in_use(), 1u);
+}
+
+TEST(external_storage_is_usable_without_initialisation) {
+    static PoolStorage<64, 4> storage;  // zero-initialised, like a NOLOAD bank
+    BlockPool pool(storage);
+    CHECK_EQ(pool.block_size(), 64u);
+    CHECK_EQ(pool.capacity(), 4u);
+    void* p = pool.allocate();
+    CHECK(p == storage.bytes);
+}
+
+TEST(concurrent_alloc_free_keeps_blocks_exclusive) {
+    StaticPool<16, 64> pool;
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 20000;
+    std::atomic<int> corrupted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kRounds; ++i) {
+                auto* p = static_cast<std::uint32_t*>(pool.allocate());
+                if (p == nullptr) {
+                    continue;
+                }
+                p[1] = static_cast<std::uint32_t>(t);
+                std::this_thread::yield();
+                if (p[1] != static_cast<std::uint32_t>(t)) {
+                    ++corrupted;
+                }
+                pool.deallocate(p);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK_EQ(corrupted.load(), 0);
+    CHECK_EQ(pool.in_use(), 0u);
+    // Every block is still reachable.
+    int count = 0;
+    while (pool.allocate() != nullptr) {
+        ++count;
+    }
+    CHECK_EQ(count, 64);
+}
+
+TEST(pool_set_picks_smallest_class_and_spills) {
+    StaticPool<32, 2> small;
+    StaticPool<128, 2> large;
+    BlockPool* const pools[] = {&small, &large};
+    PoolSet set(pools);
+
+    CHECK_EQ(set.class_size(20), 32u);
+    CHECK_EQ(set.class_size(100), 128u);
+    CHECK_EQ(set.class_size(200), 0u);
+
+    void* a = set.allocate(20);
+    void* b = set.allocate(20);
+    void* c = set.allocate(20);  // small class exhausted
+    CHECK(small.owns(a) && small.owns(b));
+    CHECK(large.owns(c));
+    CHECK_EQ(set.spills(), 1u);
+    CHECK(set.allocate(500) == nullptr);
+    CHECK_EQ(set.failures(), 1u);
+
+    CHECK(set.owner(c) == &large);
+    CHECK_EQ(set.deallocate(c), Status::ok);
+    CHECK_EQ(large.in_use(), 0u);
+}
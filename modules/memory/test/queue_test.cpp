@@ -0,0 +1,124 @@
+#include <thread>
+#include <vector>
+
+#include "nucleo/memory/bounded_queue.hpp"
+#include "nucleo/memory/message_queue.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo::memory;
+
+namespace {
+
+struct Sample {
+    std::uint32_t seq;
+    std::uint16_t channel;
+    std::int32_t values[8];
+};
+
+struct Tracked {
+    static inline int live = 0;
+    explicit Tracked(int v) : value(v) { ++live; }
+    ~Tracked() { --live; }
+    int value;
+};
+
+}  // namespace
+
+TEST(bounded_queue_is_fifo_and_bounded) {
+    BoundedQueue<int, 4> q;
+    for (int i = 0; i < 4; ++i) {
+        CHECK(q.push(i));
+    }
+    CHECK(!q.push(99));
+    int v = -1;
+    for (int i = 0; i < 4; ++i) {
+        CHECK(q.pop(v));
+        CHECK_EQ(v, i);
+    }
+    CHECK(!q.pop(v));
+    // Indices keep running past the capacity.
+    for (int round = 0; round < 10; ++round) {
+        CHECK(q.push(round));
+        CHECK(q.pop(v));
+        CHECK_EQ(v, round);
+    }
+}
+
+TEST(bounded_queue_multi_producer_delivers_everything_once) {
+    BoundedQueue<std::uint32_t, 64> q;
+    constexpr std::uint32_t kPerProducer = 50000;
+    constexpr int kProducers = 3;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < kPerProducer; ++i) {
+                while (!q.push(static_cast<std::uint32_t>(p) << 24 | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<std::uint32_t> next(kProducers, 0);
+    bool ordered = true;
+    std::uint32_t received = 0;
+    while (received < kPerProducer * kProducers) {
+        std::uint32_t v;
+        if (!q.pop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const std::uint32_t producer = v >> 24;
+        ordered = ordered && (v & 0xFFFFFF) == next[producer];
+        ++next[producer];
+        ++received;
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    CHECK(ordered);
+    CHECK(q.empty());
+}
+
+TEST(message_queue_moves_pointers_not_payloads) {
+    MessageQueue<Sample, 4> queue;
+    Sample* s = queue.acquire();
+    REQUIRE(s != nullptr);
+    s->seq = 7;
+    s->values[7] = -3;
+    queue.post(s);
+    CHECK_EQ(queue.pending(), 1u);
+
+    Sample* r = queue.receive();
+    CHECK(r == s);
+    CHECK_EQ(r->values[7], -3);
+    queue.release(r);
+    CHECK_EQ(queue.free_slots(), 4u);
+}
+
+TEST(message_queue_reports_full_and_recovers) {
+    MessageQueue<Sample, 4> queue;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        CHECK(queue.send(Sample{i, 0, {}}));
+    }
+    CHECK(!queue.send(Sample{99, 0, {}}));
+    CHECK_EQ(queue.pool_stats().failures, 1u);
+
+    std::uint32_t expected = 0;
+    while (queue.consume([&](Sample& s) { CHECK_EQ(s.seq, expected++); })) {
+    }
+    CHECK_EQ(expected, 4u);
+    CHECK(queue.send(Sample{5, 0, {}}));
+}
+
+TEST(message_queue_runs_destructors) {
+    {
+        MessageQueue<Tracked, 8> queue;
+        queue.send(1);
+        queue.send(2);
+        CHECK_EQ(Tracked::live, 2);
+        queue.consume([](Tracked& t) { CHECK_EQ(t.value, 1); });
+        CHECK_EQ(Tracked::live, 1);
+        queue.consume([](Tracked&) {});
+    }
+    CHECK_EQ(Tracked::live, 0);
+}
@@ -0,0 +1,169 @@
+#include "nucleo/net/host/sim_ethernet.hpp"
+
+#include <cstring>
+
+#include "nucleo/net/board_eth.hpp"
+#include "nucleo/net/headers.hpp"
+#include "nucleo/platform/host/sim.hpp"
+
+namespace nucleo::net {
+namespace host {
+
+using namespace desc;
+
+namespace {
+
+constexpr std::size_t kMinFrame = 60;
+
+bool is_ipv4(const std::vector<std::uint8_t>& f) {
+    return f.size() >= kEthHeaderSize + kIpv4HeaderSize && load_be16(&f[eth::kType]) == kEtherTypeIpv4 &&
+           (f[kEthHeaderSize] >> 4) == 4;
+}
+
+// What the transmit checksum offload engine does with CIC = 3.
+void insert_checksums(std::vector<std::uint8_t>& f) {
+    if (!is_ipv4(f)) {
+        return;
+    }
+    std::uint8_t* iph = &f[kEthHeaderSize];
+    const std::size_t ihl = (iph[0] & 0x0F) * 4u;
+    const std::size_t total = load_be16(iph + ip::kTotalLength);
+    if (ihl < kIpv4HeaderSize || kEthHeaderSize + total > f.size() || total < ihl) {
+        return;
+    }
+    store_be16(iph + ip::kChecksum, 0);
+    store_be16(iph + ip::kChecksum, checksum_finish(checksum_add({iph, ihl})));
+    if (iph[ip::kProtocol] == kIpProtoUdp && total >= ihl + kUdpHeaderSize) {
+        std::uint8_t* udph = iph + ihl;
+        store_be16(udph + udp::kChecksum, 0);
+        const std::uint16_t sum =
+            udp_checksum(load_be32(iph + ip::kSrc), load_be32(iph + ip::kDst), {udph, total - ihl});
+        store_be16(udph + udp::kChecksum, sum == 0 ? 0xFFFF : sum);
+    }
+}
+
+// What the receive checksum offload engine reports in RDES1.
+std::uint32_t check_checksums(ConstByteSpan f) {
+    if (f.size() < kEthHeaderSize + kIpv4HeaderSize || load_be16(f.data() + eth::kType) != kEtherTypeIpv4) {
+        return 0;
+    }
+    const std::uint8_t* iph = f.data() + kEthHeaderSize;
+    const std::size_t ihl = (iph[0] & 0x0F) * 4u;
+    const std::size_t total = load_be16(iph + ip::kTotalLength);
+    if ((iph[0] >> 4) != 4 || ihl < kIpv4HeaderSize || total < ihl || kEthHeaderSize + total > f.size() ||
+        checksum_finish(checksum_add({iph, ihl})) != 0) {
+        return kRdes1Iphe;
+    }
+    if (iph[ip::kProtocol] == kIpProtoUdp && total >= ihl + kUdpHeaderSize) {
+        const std::uint8_t* udph = iph + ihl;
+        if (load_be16(udph + udp::kChecksum) != 0 &&
+            udp_checksum(load_be32(iph + ip::kSrc), load_be32(iph + ip::kDst), {udph, total - ihl}) != 0) {
+            return kRdes1Ipce;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+Status SimEthernet::start(Ethernet& owner, const MacAddress&, Span<DmaDescriptor> rx,
+                          Span<DmaDescriptor> tx, std::uint32_t rx_buffer_size) {
+    owner_ = &owner;
+    rx_ = rx;
+    tx_ = tx;
+    rx_buffer_size_ = rx_buffer_size;
+    rx_index_ = tx_index_ = tx_tail_ = 0;
+    return Status::ok;
+}
+
+void SimEthernet::connect(SimEthernet& a, SimEthernet& b) {
+    a.peer_ = &b;
+    b.peer_ = &a;
+}
+
+void SimEthernet::rx_tail(std::uint32_t) {
+    // The DMA polls descriptor ownership itself; the write only resumes a
+    // suspended receiver, which the simulation never is.
+    ++rx_tail_writes_;
+}
+
+void SimEthernet::tx_tail(std::uint32_t index) {
+    ++tx_tail_writes_;
+    tx_tail_ = index;
+    if (!hold_tx_) {
+        complete_tx();
+    }
+}
+
+std::size_t SimEthernet::complete_tx() {
+    if (owner_ == nullptr) {
+        return 0;
+    }
+    std::size_t sent = 0;
+    bool interrupt = false;
+    while (tx_index_ != tx_tail_) {
+        DmaDescriptor& d = tx_[tx_index_];
+        const std::uint32_t des3 = d.des3;
+        if ((des3 & kTdes3Own) == 0) {
+            break;  // the real DMA suspends here
+        }
+        const std::size_t length = d.des2 & kTdes2B1lMask;
+        scratch_.assign(d.host_buffer, d.host_buffer + length);
+        if (scratch_.size() < kMinFrame) {
+            scratch_.resize(kMinFrame, 0);
+        }
+        if ((des3 & kTdes3CicFull) == kTdes3CicFull) {
+            insert_checksums(scratch_);
+        }
+        if (capture_) {
+            transmitted_.push_back(scratch_);
+        }
+        if (peer_ != nullptr && link_up_) {
+            peer_->receive({scratch_.data(), scratch_.size()});
+        }
+        interrupt = interrupt || (d.des2 & kTdes2Ioc) != 0;
+        d.des3 = des3 & ~(kTdes3Own | kTdes3Es);  // write-back: done, no error
+        tx_index_ = tx_index_ + 1 == tx_.size() ? 0 : tx_index_ + 1;
+        ++sent;
+    }
+    if (interrupt) {
+        ++tx_interrupts_;
+        platform::host::IsrScope isr;
+        owner_->isr_tx();
+    }
+    return sent;
+}
+
+bool SimEthernet::receive(ConstByteSpan frame) {
+    if (owner_ == nullptr || !link_up_) {
+        return false;
+    }
+    DmaDescriptor& d = rx_[rx_index_];
+    const std::uint32_t des3 = d.des3;
+    if ((des3 & kRdes3Own) == 0 || frame.size() > rx_buffer_size_) {
+        ++rx_missed_;
+        return false;
+    }
+    std::memcpy(d.host_buffer, frame.data(), frame.size());  // the DMA's write
+    d.des1 = check_checksums(frame);
+    d.des3 = kRdes3Fd | kRdes3Ld | (static_cast<std::uint32_t>(frame.size()) & kRdes3PlMask);
+    rx_index_ = rx_index_ + 1 == rx_.size() ? 0 : rx_index_ + 1;
+    if ((des3 & kRdes3Ioc) != 0) {
+        platform::host::IsrScope isr;
+        owner_->isr_rx();
+    }
+    return true;
+}
+
+SimEthernet& board_eth_sim() {
+    static SimEthernet sim;
+    return sim;
+}
+
+}  // namespace host
+
+EthernetPort& board_ethernet_port() { return host::board_eth_sim(); }
+
+MacAddress board_mac_address() { return {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}}; }
+
+}  // namespace nucleo::net
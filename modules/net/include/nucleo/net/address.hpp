@@ -0,0 +1,41 @@
+// Link- and network-layer addresses.
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace nucleo::net {
+
+struct MacAddress {
+    std::array<std::uint8_t, 6> bytes{};
+
+    bool is_broadcast() const {
+        for (const std::uint8_t b : bytes) {
+            if (b != 0xFF) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend bool operator==(const MacAddress& a, const MacAddress& b) { return a.bytes == b.bytes; }
+    friend bool operator!=(const MacAddress& a, const MacAddress& b) { return !(a == b); }
+};
+
+inline constexpr MacAddress kBroadcastMac{{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+
+/// IPv4 address in host byte order.
+using Ipv4Address = std::uint32_t;
+
+constexpr Ipv4Address ipv4(std::uint8_t a, std::uint8_t b, std::uint8_t c, std::uint8_t d) {
+    return static_cast<Ipv4Address>(a) << 24 | static_cast<Ipv4Address>(b) << 16 |
+           static_cast<Ipv4Address>(c) << 8 | d;
+}
+
+inline constexpr Ipv4Address kBroadcastIp = 0xFFFFFFFFu;
+
+struct Endpoint {
+    Ipv4Address ip = 0;
+    std::uint16_t port = 0;
+};
+
+}  // namespace nucleo::net
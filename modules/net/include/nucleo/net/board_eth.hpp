@@ -0,0 +1,17 @@
+// The board's Ethernet interface (LAN8742A PHY over RMII).
+#pragma once
+
+#include "nucleo/net/address.hpp"
+#include "nucleo/net/port.hpp"
+
+namespace nucleo::net {
+
+/// ETH MAC/DMA on the target; the SimEthernet returned by
+/// host::board_eth_sim() on the host.
+EthernetPort& board_ethernet_port();
+
+/// Locally administered unicast address derived from the device's unique
+/// ID, so every board gets its own.
+MacAddress board_mac_address();
+
+}  // namespace nucleo::net
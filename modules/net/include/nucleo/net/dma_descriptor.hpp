@@ -0,0 +1,75 @@
+// STM32H5 Ethernet DMA descriptors (RM0481, "Ethernet DMA descriptors").
+//
+// The driver builds descriptors in the hardware's own format on both
+// builds; on the host the simulated MAC walks the same rings, so ownership
+// hand-over, write-back and tail pointer handling are exercised by the
+// unit tests rather than only on the board.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::net {
+
+struct DmaDescriptor {
+    volatile std::uint32_t des0;
+    volatile std::uint32_t des1;
+    volatile std::uint32_t des2;
+    volatile std::uint32_t des3;
+#if NUCLEO_PLATFORM_HOST
+    /// des0 only holds 32-bit bus addresses; the simulated DMA finds the
+    /// buffer here instead.
+    std::uint8_t* host_buffer;
+#endif
+};
+
+#if !NUCLEO_PLATFORM_HOST
+static_assert(sizeof(DmaDescriptor) == 16, "descriptor skip length is programmed as 0");
+#endif
+
+namespace desc {
+
+// Transmit, read format.
+inline constexpr std::uint32_t kTdes2Ioc = 1u << 31;
+inline constexpr std::uint32_t kTdes2B1lMask = 0x3FFF;
+inline constexpr std::uint32_t kTdes3Own = 1u << 31;
+inline constexpr std::uint32_t kTdes3Fd = 1u << 29;
+inline constexpr std::uint32_t kTdes3Ld = 1u << 28;
+inline constexpr std::uint32_t kTdes3CicFull = 3u << 16;  ///< insert IPv4 header and UDP/TCP checksums
+inline constexpr std::uint32_t kTdes3FlMask = 0x7FFF;
+// Transmit, write-back format.
+inline constexpr std::uint32_t kTdes3Es = 1u << 15;
+
+// Receive, read format.
+inline constexpr std::uint32_t kRdes3Own = 1u << 31;
+inline constexpr std::uint32_t kRdes3Ioc = 1u << 30;
+inline constexpr std::uint32_t kRdes3Buf1v = 1u << 24;
+// Receive, write-back format.
+inline constexpr std::uint32_t kRdes1Ipce = 1u << 7;  ///< payload checksum error
+inline constexpr std::uint32_t kRdes1Iphe = 1u << 3;  ///< IP header error
+inline constexpr std::uint32_t kRdes3Fd = 1u << 29;
+inline constexpr std::uint32_t kRdes3Ld = 1u << 28;
+inline constexpr std::uint32_t kRdes3Es = 1u << 15;
+inline constexpr std::uint32_t kRdes3PlMask = 0x7FFF;
+
+}  // namespace desc
+
+inline std::uint32_t dma_address(const void* p) {
+    return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(p));
+}
+
+struct Packet;
+
+/// Descriptors plus the driver's shadow of which packet each one holds
+/// (receive write-back overwrites the buffer address). All-zero when
+/// constructed, so it may be placed with NUCLEO_SRAM3_BSS.
+template <std::size_t N>
+struct DescriptorRing {
+    static_assert(N >= 4, "ring too short to overlap processing and DMA");
+    alignas(16) DmaDescriptor descriptors[N]{};
+    Packet* packets[N]{};
+};
+
+}  // namespace nucleo::net
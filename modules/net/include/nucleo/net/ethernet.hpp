@@ -0,0 +1,158 @@
+// Zero-copy Ethernet MAC driver.
+//
+// Every receive descriptor is armed with a packet from the pool. When a
+// frame arrives the packet itself is handed to the caller and the
+// descriptor is re-armed with a fresh one, so received data is never
+// copied. Transmit takes ownership of a packet until the DMA is done with
+// it; completed packets are reclaimed in batches and go straight back to
+// the pool. Tail pointer writes (doorbells) and transmit-complete
+// interrupts happen once per batch, not once per frame.
+//
+// receive(), transmit(), flush() and reclaim() belong to one thread of
+// execution; only the isr_*() hooks run in interrupt context.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/net/dma_descriptor.hpp"
+#include "nucleo/net/packet.hpp"
+#include "nucleo/net/port.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::net {
+
+struct EthernetStats {
+    std::uint32_t rx_frames = 0;
+    std::uint32_t rx_bytes = 0;
+    std::uint32_t rx_errors = 0;     ///< frames with MAC or checksum errors, dropped
+    std::uint32_t rx_no_buffer = 0;  ///< frames dropped because the pool was empty
+    std::uint32_t rx_irqs = 0;
+    std::uint32_t tx_frames = 0;
+    std::uint32_t tx_bytes = 0;
+    std::uint32_t tx_errors = 0;
+    std::uint32_t tx_ring_full = 0;  ///< transmit() calls refused with busy
+    std::uint32_t tx_doorbells = 0;  ///< tail pointer writes
+    std::uint32_t tx_reclaims = 0;   ///< reclaim batches that freed packets
+    std::uint32_t tx_irqs = 0;
+};
+
+class Ethernet {
+public:
+    /// Largest frame handed to transmit(), without FCS.
+    static constexpr std::size_t kMaxFrame = 1518;
+
+    template <std::size_t RxCount, std::size_t TxCount>
+    Ethernet(EthernetPort& port, PacketPool& pool, DescriptorRing<RxCount>& rx,
+             DescriptorRing<TxCount>& tx)
+        : port_(port),
+          pool_(pool),
+          rx_{rx.descriptors, rx.packets, RxCount},
+          tx_{tx.descriptors, tx.packets, TxCount} {}
+
+    Ethernet(const Ethernet&) = delete;
+    Ethernet& operator=(const Ethernet&) = delete;
+
+    /// Arms every receive descriptor with a pool packet and starts the MAC.
+    /// Returns no_memory if the pool cannot fill the receive ring.
+    Status start(const MacAddress& mac);
+
+    bool link_up() { return port_.link_up(); }
+
+    // ---- receive ----
+
+    using RxTap = void (*)(void* context, ConstByteSpan frame);
+
+    /// Shows every received frame to `tap` before it is handed on, e.g. to
+    /// record input for replay (nucleo/hil/recorder.hpp). nullptr removes it.
+    void set_rx_tap(RxTap tap, void* context) {
+        rx_tap_ = tap;
+        rx_tap_context_ = context;
+    }
+
+    /// Hands up to `budget` received frames to fn(Packet*), which takes
+    /// ownership and must eventually release or transmit the packet. The
+    /// receive tail pointer is written once at the end. Returns the number
+    /// of frames delivered.
+    template <typename Fn>
+    std::size_t receive(Fn&& fn, std::size_t budget = SIZE_MAX) {
+        std::size_t delivered = 0;
+        while (delivered < budget) {
+            Packet* packet = rx_take();
+            if (packet == nullptr) {
+                break;
+            }
+            if (rx_tap_ != nullptr) {
+                rx_tap_(rx_tap_context_, packet->bytes());
+            }
+            fn(packet);
+            ++delivered;
+        }
+        rx_commit();
+        return delivered;
+    }
+
+    /// True when the next receive descriptor holds a frame.
+    bool rx_pending() const;
+
+    // ---- transmit ----
+
+    /// Queues `packet` (its bytes() are the frame without FCS). On ok the
+    /// driver owns the packet and returns it to the pool once sent; on busy
+    /// (ring full) or invalid_argument the caller keeps it. Nothing is sent
+    /// until flush().
+    Status transmit(Packet* packet);
+
+    /// Starts the DMA on everything queued since the last flush, with one
+    /// completion interrupt for the whole batch.
+    void flush();
+
+    /// Returns the packets of completed transmissions to the pool. Returns
+    /// the number reclaimed.
+    std::size_t reclaim();
+
+    std::size_t tx_in_flight() const { return tx_count_; }
+    std::size_t tx_free() const { return tx_.size - 1 - tx_count_; }
+
+    EthernetStats stats() const;
+
+    // ---- interrupt side, called by the port ----
+
+    void isr_rx() { ++rx_irqs_; }
+    void isr_tx() { ++tx_irqs_; }
+
+private:
+    struct Ring {
+        DmaDescriptor* descriptors;
+        Packet** packets;
+        std::uint32_t size;
+    };
+
+    Packet* rx_take();
+    void rx_commit();
+    void arm_rx(std::uint32_t index, Packet* packet);
+    std::uint32_t next(const Ring& ring, std::uint32_t index) const {
+        return index + 1 == ring.size ? 0 : index + 1;
+    }
+
+    EthernetPort& port_;
+    PacketPool& pool_;
+    Ring rx_;
+    Ring tx_;
+
+    std::uint32_t rx_next_ = 0;     // next descriptor to inspect
+    bool rx_rearmed_ = false;       // descriptors armed since the last doorbell
+    std::uint32_t tx_head_ = 0;     // next free descriptor
+    std::uint32_t tx_clean_ = 0;    // oldest descriptor not yet reclaimed
+    std::uint32_t tx_count_ = 0;    // descriptors holding packets
+    std::uint32_t tx_unflushed_ = 0;
+
+    RxTap rx_tap_ = nullptr;
+    void* rx_tap_context_ = nullptr;
+
+    EthernetStats stats_{};
+    volatile std::uint32_t rx_irqs_ = 0;
+    volatile std::uint32_t tx_irqs_ = 0;
+};
+
+}  // namespace nucleo::net
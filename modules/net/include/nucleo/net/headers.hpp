@@ -0,0 +1,102 @@
+// Ethernet II, ARP, IPv4 and UDP wire formats (all big-endian).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/net/address.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::net {
+
+inline constexpr std::size_t kEthHeaderSize = 14;
+inline constexpr std::size_t kArpSize = 28;
+inline constexpr std::size_t kIpv4HeaderSize = 20;  ///< without options
+inline constexpr std::size_t kUdpHeaderSize = 8;
+inline constexpr std::size_t kUdpHeadroom = kEthHeaderSize + kIpv4HeaderSize + kUdpHeaderSize;
+inline constexpr std::size_t kMtu = 1500;
+inline constexpr std::size_t kMaxUdpPayload = kMtu - kIpv4HeaderSize - kUdpHeaderSize;
+
+inline constexpr std::uint16_t kEtherTypeIpv4 = 0x0800;
+inline constexpr std::uint16_t kEtherTypeArp = 0x0806;
+inline constexpr std::uint8_t kIpProtoUdp = 17;
+
+// Field offsets from the start of each header.
+namespace eth {
+inline constexpr std::size_t kDst = 0;
+inline constexpr std::size_t kSrc = 6;
+inline constexpr std::size_t kType = 12;
+}  // namespace eth
+namespace ip {
+inline constexpr std::size_t kVersionIhl = 0;
+inline constexpr std::size_t kTotalLength = 2;
+inline constexpr std::size_t kId = 4;
+inline constexpr std::size_t kFragment = 6;
+inline constexpr std::size_t kTtl = 8;
+inline constexpr std::size_t kProtocol = 9;
+inline constexpr std::size_t kChecksum = 10;
+inline constexpr std::size_t kSrc = 12;
+inline constexpr std::size_t kDst = 16;
+inline constexpr std::uint16_t kDontFragment = 0x4000;
+inline constexpr std::uint16_t kMoreFragments = 0x2000;
+inline constexpr std::uint16_t kOffsetMask = 0x1FFF;
+}  // namespace ip
+namespace udp {
+inline constexpr std::size_t kSrcPort = 0;
+inline constexpr std::size_t kDstPort = 2;
+inline constexpr std::size_t kLength = 4;
+inline constexpr std::size_t kChecksum = 6;
+}  // namespace udp
+namespace arp {
+inline constexpr std::size_t kOp = 6;
+inline constexpr std::size_t kSenderMac = 8;
+inline constexpr std::size_t kSenderIp = 14;
+inline constexpr std::size_t kTargetMac = 18;
+inline constexpr std::size_t kTargetIp = 24;
+inline constexpr std::uint16_t kRequest = 1;
+inline constexpr std::uint16_t kReply = 2;
+}  // namespace arp
+
+inline std::uint16_t load_be16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] << 8 | p[1]);
+}
+inline std::uint32_t load_be32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) << 24 | static_cast<std::uint32_t>(p[1]) << 16 |
+           static_cast<std::uint32_t>(p[2]) << 8 | p[3];
+}
+inline void store_be16(std::uint8_t* p, std::uint16_t v) {
+    p[0] = static_cast<std::uint8_t>(v >> 8);
+    p[1] = static_cast<std::uint8_t>(v);
+}
+inline void store_be32(std::uint8_t* p, std::uint32_t v) {
+    p[0] = static_cast<std::uint8_t>(v >> 24);
+    p[1] = static_cast<std::uint8_t>(v >> 16);
+    p[2] = static_cast<std::uint8_t>(v >> 8);
+    p[3] = static_cast<std::uint8_t>(v);
+}
+inline MacAddress load_mac(const std::uint8_t* p) {
+    MacAddress mac;
+    for (std::size_t i = 0; i < mac.bytes.size(); ++i) {
+        mac.bytes[i] = p[i];
+    }
+    return mac;
+}
+inline void store_mac(std::uint8_t* p, const MacAddress& mac) {
+    for (std::size_t i = 0; i < mac.bytes.size(); ++i) {
+        p[i] = mac.bytes[i];
+    }
+}
+
+/// One's-complement sum of `data` folded into `sum` (RFC 1071), not yet
+/// complemented. Chain calls to cover a pseudo-header plus payload.
+std::uint32_t checksum_add(ConstByteSpan data, std::uint32_t sum = 0);
+
+/// Final Internet checksum of a running checksum_add() sum.
+std::uint16_t checksum_finish(std::uint32_t sum);
+
+/// Internet checksum over the UDP pseudo-header and `udp` (header plus
+/// payload). With the checksum field zeroed this is the value to store;
+/// over a datagram carrying a correct checksum it is 0.
+std::uint16_t udp_checksum(Ipv4Address src, Ipv4Address dst, ConstByteSpan udp);
+
+}  // namespace nucleo::net
@@ -0,0 +1,81 @@
+// Simulated Ethernet MAC with DMA descriptor semantics (host only).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "nucleo/net/ethernet.hpp"
+#include "nucleo/net/port.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/net/host/sim_ethernet.hpp is only available in host builds"
+#endif
+
+namespace nucleo::net::host {
+
+/// Behaves like the ETH DMA towards the driver: walks the same descriptor
+/// rings, honours ownership bits and tail pointers, writes back status,
+/// inserts and verifies checksums like the offload engine, and raises
+/// completion interrupts only for descriptors that ask for one. Frames a
+/// port sends are recorded and, when it is wired to a peer (or to itself),
+/// DMA-written into the peer's receive ring.
+class SimEthernet final : public EthernetPort {
+public:
+    Status start(Ethernet& owner, const MacAddress& mac, Span<DmaDescriptor> rx,
+                 Span<DmaDescriptor> tx, std::uint32_t rx_buffer_size) override;
+    void rx_tail(std::uint32_t index) override;
+    void tx_tail(std::uint32_t index) override;
+    bool link_up() override { return link_up_; }
+
+    /// Wires two ports back to back; frames sent by one arrive at the other.
+    static void connect(SimEthernet& a, SimEthernet& b);
+    void loopback() { peer_ = this; }
+    void disconnect() { peer_ = nullptr; }
+
+    /// Frame arriving from the wire (without FCS). Returns false if the
+    /// receive ring had no free descriptor and the frame was dropped.
+    bool receive(ConstByteSpan frame);
+
+    /// While held, tail pointer writes are latched but the DMA does not
+    /// run, as if the wire were busy; complete_tx() then sends everything.
+    void hold_tx(bool hold) { hold_tx_ = hold; }
+    /// Sends every descriptor up to the last tail pointer. Returns the
+    /// number of frames sent.
+    std::size_t complete_tx();
+
+    /// Recording of sent frames can be turned off for long benchmark runs.
+    void set_capture(bool capture) { capture_ = capture; }
+    const std::vector<std::vector<std::uint8_t>>& transmitted() const { return transmitted_; }
+    void clear_transmitted() { transmitted_.clear(); }
+
+    void set_link(bool up) { link_up_ = up; }
+    std::uint32_t rx_missed() const { return rx_missed_; }
+    std::uint32_t tx_interrupts() const { return tx_interrupts_; }
+    std::uint32_t rx_tail_writes() const { return rx_tail_writes_; }
+    std::uint32_t tx_tail_writes() const { return tx_tail_writes_; }
+
+private:
+    Ethernet* owner_ = nullptr;
+    SimEthernet* peer_ = nullptr;
+    Span<DmaDescriptor> rx_;
+    Span<DmaDescriptor> tx_;
+    std::uint32_t rx_buffer_size_ = 0;
+    std::uint32_t rx_index_ = 0;
+    std::uint32_t tx_index_ = 0;
+    std::uint32_t tx_tail_ = 0;
+    bool hold_tx_ = false;
+    bool capture_ = true;
+    bool link_up_ = true;
+    std::uint32_t rx_missed_ = 0;
+    std::uint32_t tx_interrupts_ = 0;
+    std::uint32_t rx_tail_writes_ = 0;
+    std::uint32_t tx_tail_writes_ = 0;
+    std::vector<std::uint8_t> scratch_;
+    std::vector<std::vector<std::uint8_t>> transmitted_;
+};
+
+/// The simulated board interface, same object as board_ethernet_port() in
+/// host builds. Not connected to anything until a test wires it up.
+SimEthernet& board_eth_sim();
+
+}  // namespace nucleo::net::host
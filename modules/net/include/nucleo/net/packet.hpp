@@ -0,0 +1,86 @@
+// Packet buffers shared by the Ethernet DMA and the protocol layers.
+//
+// A Packet is one pool block: a small header followed by a frame-sized,
+// cache-line aligned data area. The receive DMA writes frames straight into
+// it and the transmit DMA reads from it, so a datagram crosses the stack
+// without being copied. Protocol layers move `offset` to strip headers on
+// the way up and to prepend them in the headroom on the way down.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/memory/block_pool.hpp"
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::net {
+
+struct Packet {
+    /// Largest frame the MAC accepts (1522-byte VLAN frame), rounded up to
+    /// whole cache lines.
+    static constexpr std::size_t kCapacity = 1536;
+
+    std::uint16_t offset = 0;  ///< first valid byte of data
+    std::uint16_t length = 0;  ///< valid bytes from offset
+    alignas(NUCLEO_CACHE_LINE) std::uint8_t data[kCapacity];
+
+    std::uint8_t* begin() { return data + offset; }
+    const std::uint8_t* begin() const { return data + offset; }
+    ByteSpan bytes() { return {data + offset, length}; }
+    ConstByteSpan bytes() const { return {data + offset, length}; }
+
+    std::size_t headroom() const { return offset; }
+    std::size_t tailroom() const { return kCapacity - offset - length; }
+
+    /// Grows the packet by `n` bytes at the front; requires headroom() >= n.
+    std::uint8_t* push(std::size_t n) {
+        offset = static_cast<std::uint16_t>(offset - n);
+        length = static_cast<std::uint16_t>(length + n);
+        return begin();
+    }
+    /// Drops `n` bytes from the front; requires length >= n.
+    void pull(std::size_t n) {
+        offset = static_cast<std::uint16_t>(offset + n);
+        length = static_cast<std::uint16_t>(length - n);
+    }
+};
+
+/// Typed front end of a block pool whose blocks hold one Packet. Like the
+/// underlying BlockPool it is lock-free and may be used from interrupts.
+class PacketPool {
+public:
+    explicit constexpr PacketPool(memory::BlockPool& blocks) : blocks_(blocks) {}
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    /// An empty packet with `headroom` bytes reserved in front, or nullptr
+    /// when the pool is exhausted. The data area is not cleared.
+    Packet* allocate(std::size_t headroom = 0);
+    void release(Packet* packet);
+
+    std::size_t available() const { return blocks_.available(); }
+    std::size_t capacity() const { return blocks_.capacity(); }
+    memory::PoolStats stats() const { return blocks_.stats(); }
+
+private:
+    memory::BlockPool& blocks_;
+};
+
+/// Storage for `Count` packets, zero-initialised so it may be placed with
+/// NUCLEO_SRAM3_BSS next to a BlockPool and a PacketPool over it.
+template <std::size_t Count>
+using PacketStorage = memory::PoolStorage<sizeof(Packet), Count, alignof(Packet)>;
+
+/// Packet pool bundled with its own storage.
+template <std::size_t Count>
+class StaticPacketPool : public PacketPool {
+public:
+    // PacketPool only stores the reference; blocks_ is constructed before use.
+    StaticPacketPool() : PacketPool(blocks_) {}
+
+private:
+    memory::StaticPool<sizeof(Packet), Count, alignof(Packet)> blocks_;
+};
+
+}  // namespace nucleo::net
@@ -0,0 +1,44 @@
+// Hardware half of the Ethernet driver.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/net/address.hpp"
+#include "nucleo/net/dma_descriptor.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::net {
+
+class Ethernet;
+
+/// Implemented by the ETH MAC/DMA driver on the target and by SimEthernet
+/// on the host. The rings are owned by the Ethernet driver; the port only
+/// programs their base addresses and moves the tail pointers.
+class EthernetPort {
+public:
+    /// Resets the MAC, programs `mac` and both rings and starts the DMA.
+    /// Receive and transmit-complete interrupts are reported through
+    /// owner.isr_rx() / owner.isr_tx(). Receive descriptors are expected to
+    /// be armed already; `rx_buffer_size` is the size of each buffer.
+    virtual Status start(Ethernet& owner, const MacAddress& mac, Span<DmaDescriptor> rx,
+                         Span<DmaDescriptor> tx, std::uint32_t rx_buffer_size) = 0;
+
+    /// Tells the receive DMA that descriptors were re-armed. `index` is the
+    /// next descriptor the driver will inspect; every other one is armed.
+    virtual void rx_tail(std::uint32_t index) = 0;
+
+    /// Starts transmission of descriptors up to (not including) `index`.
+    /// The driver never fills the whole ring, so `index` equal to the DMA's
+    /// position means there is nothing to send.
+    virtual void tx_tail(std::uint32_t index) = 0;
+
+    /// Current PHY link state; also applies the negotiated speed and duplex
+    /// to the MAC when the link comes up.
+    virtual bool link_up() = 0;
+
+protected:
+    ~EthernetPort() = default;
+};
+
+}  // namespace nucleo::net
@@ -0,0 +1,148 @@
+// Minimal IPv4/UDP endpoint on top of the zero-copy Ethernet driver.
+//
+// Received datagrams are delivered in the packet the DMA wrote them into;
+// the payload span points into that buffer. Datagrams are sent from pool
+// packets that reserve header room in front of the payload, so the stack
+// only writes the 42 header bytes and never moves payload. Checksums are
+// left to the MAC's checksum offload engine in both directions.
+//
+// ARP is limited to answering requests for our address and a small cache
+// learned from ARP traffic and received datagrams; IP fragments and options
+// are not supported.
+//
+//   stack.poll([&](net::Datagram& d) {
+//       if (d.port == 7) stack.reply(d, d.payload.size());   // echo in place
+//   });
+//   if (net::Packet* p = stack.allocate(64)) {
+//       fill(p->bytes());
+//       if (stack.send(p, peer, 5000) != Status::ok) stack.release(p);
+//   }
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/net/address.hpp"
+#include "nucleo/net/ethernet.hpp"
+#include "nucleo/net/headers.hpp"
+#include "nucleo/net/packet.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::net {
+
+struct NetConfig {
+    MacAddress mac;
+    Ipv4Address ip = 0;
+    Ipv4Address netmask = ipv4(255, 255, 255, 0);
+    Ipv4Address gateway = 0;  ///< 0: off-subnet destinations are unreachable
+};
+
+/// A received datagram. The stack releases `packet` after the handler
+/// returns unless the handler took it over (reply() does, or set it to
+/// nullptr after keeping it).
+struct Datagram {
+    Packet* packet = nullptr;
+    Endpoint source;
+    std::uint16_t port = 0;  ///< local destination port
+    ByteSpan payload;
+};
+
+struct UdpStats {
+    std::uint32_t rx_datagrams = 0;
+    std::uint32_t rx_dropped = 0;  ///< frames not for us, malformed or unsupported
+    std::uint32_t arp_requests_sent = 0;
+    std::uint32_t arp_replies_sent = 0;
+    std::uint32_t tx_datagrams = 0;
+    std::uint32_t tx_unresolved = 0;  ///< send() refused while ARP was pending
+};
+
+class UdpStack {
+public:
+    static constexpr std::size_t kArpCacheSize = 4;
+
+    UdpStack(Ethernet& ethernet, PacketPool& pool, const NetConfig& config);
+    UdpStack(const UdpStack&) = delete;
+    UdpStack& operator=(const UdpStack&) = delete;
+
+    Status start() { return ethernet_.start(config_.mac); }
+
+    /// Processes received frames, handing each datagram to
+    /// on_datagram(Datagram&), then reclaims finished transmissions and
+    /// flushes anything queued (including replies made by the handler).
+    /// Returns the number of datagrams delivered.
+    template <typename Fn>
+    std::size_t poll(Fn&& on_datagram, std::size_t budget = 32) {
+        std::size_t delivered = 0;
+        ethernet_.receive(
+            [&](Packet* packet) {
+                Datagram datagram;
+                if (!accept(packet, datagram)) {
+                    return;
+                }
+                on_datagram(datagram);
+                release(datagram.packet);
+                ++delivered;
+            },
+            budget);
+        ethernet_.reclaim();
+        ethernet_.flush();
+        return delivered;
+    }
+
+    /// A packet with `payload_size` bytes of payload (packet->bytes()) and
+    /// header room in front, or nullptr if the pool is empty or the size
+    /// exceeds kMaxUdpPayload.
+    Packet* allocate(std::size_t payload_size);
+    void release(Packet* packet) { pool_.release(packet); }
+
+    /// Sends the payload in `packet` to `to` from local port `from_port`.
+    /// On ok the stack owns the packet. Otherwise the caller keeps it:
+    /// not_found while the next hop's MAC address is being resolved (an ARP
+    /// request has been sent), busy when the transmit ring is full.
+    /// Transmission starts on the next poll() or flush().
+    Status send(Packet* packet, const Endpoint& to, std::uint16_t from_port);
+
+    /// Copies `payload` into a fresh packet and sends it. The packet is
+    /// released on failure.
+    Status send_to(const Endpoint& to, std::uint16_t from_port, ConstByteSpan payload);
+
+    /// Sends the first `length` bytes of `datagram`'s payload area back to
+    /// its source, reusing the received packet. On ok the packet is taken
+    /// over (datagram.packet becomes nullptr).
+    Status reply(Datagram& datagram, std::size_t length);
+
+    void flush() { ethernet_.flush(); }
+
+    /// Looks up the MAC address that frames for `ip` are sent to.
+    bool resolve(Ipv4Address ip, MacAddress& mac) const;
+
+    const NetConfig& config() const { return config_; }
+    UdpStats stats() const { return stats_; }
+    Ethernet& ethernet() { return ethernet_; }
+
+private:
+    struct ArpEntry {
+        Ipv4Address ip = 0;
+        MacAddress mac;
+    };
+
+    bool accept(Packet* packet, Datagram& datagram);
+    void handle_arp(Packet* packet);
+    void learn(Ipv4Address ip, const MacAddress& mac);
+    void send_arp_request(Ipv4Address ip);
+    bool on_subnet(Ipv4Address ip) const {
+        return ((ip ^ config_.ip) & config_.netmask) == 0;
+    }
+
+    Ethernet& ethernet_;
+    PacketPool& pool_;
+    NetConfig config_;
+    std::array<ArpEntry, kArpCacheSize> arp_{};
+    std::uint32_t arp_victim_ = 0;
+    std::uint16_t ip_id_ = 0;
+    UdpStats stats_{};
+};
+
+}  // namespace nucleo::net
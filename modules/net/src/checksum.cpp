@@ -0,0 +1,30 @@
+#include "nucleo/net/headers.hpp"
+
+namespace nucleo::net {
+
+std::uint32_t checksum_add(ConstByteSpan data, std::uint32_t sum) {
+    const std::uint8_t* p = data.data();
+    std::size_t n = data.size();
+    for (; n >= 2; p += 2, n -= 2) {
+        sum += load_be16(p);
+    }
+    if (n != 0) {
+        sum += static_cast<std::uint32_t>(p[0]) << 8;
+    }
+    return sum;
+}
+
+std::uint16_t checksum_finish(std::uint32_t sum) {
+    while ((sum >> 16) != 0) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return static_cast<std::uint16_t>(~sum);
+}
+
+std::uint16_t udp_checksum(Ipv4Address src, Ipv4Address dst, ConstByteSpan udp) {
+    std::uint32_t sum = (src >> 16) + (src & 0xFFFF) + (dst >> 16) + (dst & 0xFFFF);
+    sum += kIpProtoUdp + static_cast<std::uint32_t>(udp.size());
+    return checksum_finish(checksum_add(udp, sum));
+}
+
+}  // namespace nucleo::net
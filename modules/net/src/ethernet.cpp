@@ -0,0 +1,177 @@
+#include "nucleo/net/ethernet.hpp"
+
+#include <atomic>
+
+namespace nucleo::net {
+
+using namespace desc;
+
+namespace {
+
+void set_buffer(DmaDescriptor& d, std::uint8_t* buffer) {
+    d.des0 = dma_address(buffer);
+#if NUCLEO_PLATFORM_HOST
+    d.host_buffer = buffer;
+#endif
+}
+
+}  // namespace
+
+Status Ethernet::start(const MacAddress& mac) {
+    for (std::uint32_t i = 0; i < rx_.size; ++i) {
+        Packet* packet = rx_.packets[i] != nullptr ? rx_.packets[i] : pool_.allocate();
+        if (packet == nullptr) {
+            return Status::no_memory;
+        }
+        arm_rx(i, packet);
+    }
+    for (std::uint32_t i = 0; i < tx_.size; ++i) {
+        pool_.release(tx_.packets[i]);
+        tx_.packets[i] = nullptr;
+        DmaDescriptor& d = tx_.descriptors[i];
+        d.des0 = d.des1 = d.des2 = d.des3 = 0;
+    }
+    rx_next_ = 0;
+    rx_rearmed_ = false;
+    tx_head_ = tx_clean_ = tx_count_ = tx_unflushed_ = 0;
+
+    const Status status = port_.start(*this, mac, {rx_.descriptors, rx_.size},
+                                      {tx_.descriptors, tx_.size}, Packet::kCapacity);
+    if (status == Status::ok) {
+        port_.rx_tail(0);
+    }
+    return status;
+}
+
+void Ethernet::arm_rx(std::uint32_t index, Packet* packet) {
+    rx_.packets[index] = packet;
+    DmaDescriptor& d = rx_.descriptors[index];
+    set_buffer(d, packet->data);
+    d.des1 = 0;
+    d.des2 = 0;
+    // Buffer fields must be visible before the DMA can see OWN.
+    std::atomic_thread_fence(std::memory_order_release);
+    d.des3 = kRdes3Own | kRdes3Ioc | kRdes3Buf1v;
+}
+
+bool Ethernet::rx_pending() const {
+    return (rx_.descriptors[rx_next_].des3 & kRdes3Own) == 0;
+}
+
+Packet* Ethernet::rx_take() {
+    for (;;) {
+        const std::uint32_t index = rx_next_;
+        DmaDescriptor& d = rx_.descriptors[index];
+        const std::uint32_t des3 = d.des3;
+        if ((des3 & kRdes3Own) != 0) {
+            return nullptr;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        rx_next_ = next(rx_, index);
+        rx_rearmed_ = true;
+
+        Packet* packet = rx_.packets[index];
+        // Buffers hold a whole frame, so a good frame is always first and
+        // last; anything else is a MAC error or a checksum the offload
+        // engine rejected.
+        const bool whole = (des3 & (kRdes3Fd | kRdes3Ld)) == (kRdes3Fd | kRdes3Ld);
+        if (!whole || (des3 & kRdes3Es) != 0 || (d.des1 & (kRdes1Iphe | kRdes1Ipce)) != 0) {
+            ++stats_.rx_errors;
+            arm_rx(index, packet);
+            continue;
+        }
+        Packet* fresh = pool_.allocate();
+        if (fresh == nullptr) {
+            // Keep the ring full rather than the frame: dropping here is what
+            // lets the DMA keep receiving while the application catches up.
+            ++stats_.rx_no_buffer;
+            arm_rx(index, packet);
+            continue;
+        }
+        arm_rx(index, fresh);
+        packet->offset = 0;
+        packet->length = static_cast<std::uint16_t>(des3 & kRdes3PlMask);
+        ++stats_.rx_frames;
+        stats_.rx_bytes += packet->length;
+        return packet;
+    }
+}
+
+void Ethernet::rx_commit() {
+    if (rx_rearmed_) {
+        rx_rearmed_ = false;
+        port_.rx_tail(rx_next_);
+    }
+}
+
+Status Ethernet::transmit(Packet* packet) {
+    if (packet == nullptr || packet->length == 0 || packet->length > kMaxFrame) {
+        return Status::invalid_argument;
+    }
+    // One descriptor stays empty so a full ring is distinguishable from an
+    // idle one at the tail pointer.
+    if (tx_count_ == tx_.size - 1 && reclaim() == 0) {
+        ++stats_.tx_ring_full;
+        return Status::busy;
+    }
+    const std::uint32_t index = tx_head_;
+    tx_.packets[index] = packet;
+    DmaDescriptor& d = tx_.descriptors[index];
+    set_buffer(d, packet->begin());
+    d.des1 = 0;
+    d.des2 = packet->length & kTdes2B1lMask;
+    // OWN is safe to set now: the DMA stops at the tail pointer, which only
+    // moves in flush().
+    d.des3 = kTdes3Own | kTdes3Fd | kTdes3Ld | kTdes3CicFull | (packet->length & kTdes3FlMask);
+    tx_head_ = next(tx_, index);
+    ++tx_count_;
+    ++tx_unflushed_;
+    ++stats_.tx_frames;
+    stats_.tx_bytes += packet->length;
+    return Status::ok;
+}
+
+void Ethernet::flush() {
+    if (tx_unflushed_ == 0) {
+        return;
+    }
+    // One completion interrupt per batch, on its last descriptor.
+    const std::uint32_t last = tx_head_ == 0 ? tx_.size - 1 : tx_head_ - 1;
+    tx_.descriptors[last].des2 = tx_.descriptors[last].des2 | kTdes2Ioc;
+    tx_unflushed_ = 0;
+    ++stats_.tx_doorbells;
+    std::atomic_thread_fence(std::memory_order_release);
+    port_.tx_tail(tx_head_);
+}
+
+std::size_t Ethernet::reclaim() {
+    std::size_t reclaimed = 0;
+    while (tx_count_ > tx_unflushed_) {
+        const std::uint32_t index = tx_clean_;
+        const std::uint32_t des3 = tx_.descriptors[index].des3;
+        if ((des3 & kTdes3Own) != 0) {
+            break;
+        }
+        if ((des3 & kTdes3Es) != 0) {
+            ++stats_.tx_errors;
+        }
+        pool_.release(tx_.packets[index]);
+        tx_.packets[index] = nullptr;
+        tx_clean_ = next(tx_, index);
+        --tx_count_;
+        ++reclaimed;
+    }
+    if (reclaimed != 0) {
+        ++stats_.tx_reclaims;
+    }
+    return reclaimed;
+}
+
+EthernetStats Ethernet::stats() const {
+    EthernetStats s = stats_;
+    s.rx_irqs = rx_irqs_;
+    s.tx_irqs = tx_irqs_;
+    return s;
+}
+
+}  // namespace nucleo::net
@@ -0,0 +1,24 @@
+#include "nucleo/net/packet.hpp"
+
+#include <new>
+
+namespace nucleo::net {
+
+Packet* PacketPool::allocate(std::size_t headroom) {
+    void* block = blocks_.allocate();
+    if (block == nullptr) {
+        return nullptr;
+    }
+    // Default-initialise: the header is set, the data area is left alone.
+    Packet* packet = new (block) Packet;
+    packet->offset = static_cast<std::uint16_t>(headroom);
+    return packet;
+}
+
+void PacketPool::release(Packet* packet) {
+    if (packet != nullptr) {
+        blocks_.deallocate(packet);
+    }
+}
+
+}  // namespace nucleo::net
@@ -0,0 +1,256 @@
+#include "nucleo/net/udp.hpp"
+
+#include <cstring>
+
+namespace nucleo::net {
+
+UdpStack::UdpStack(Ethernet& ethernet, PacketPool& pool, const NetConfig& config)
+    : ethernet_(ethernet), pool_(pool), config_(config) {}
+
+bool UdpStack::accept(Packet* packet, Datagram& datagram) {
+    const std::uint8_t* frame = packet->begin();
+    if (packet->length < kEthHeaderSize) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return false;
+    }
+    const MacAddress dst_mac = load_mac(frame + eth::kDst);
+    if (dst_mac != config_.mac && !dst_mac.is_broadcast()) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return false;
+    }
+    const std::uint16_t type = load_be16(frame + eth::kType);
+    if (type == kEtherTypeArp) {
+        handle_arp(packet);
+        return false;
+    }
+
+    // IPv4 without fragments, addressed to us, carrying UDP. Nothing past
+    // the Ethernet header is read before the fixed IPv4 header is known to
+    // be there.
+    if (type != kEtherTypeIpv4 || packet->length < kEthHeaderSize + kIpv4HeaderSize) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return false;
+    }
+    const std::uint8_t* iph = frame + kEthHeaderSize;
+    const std::size_t ip_room = packet->length - kEthHeaderSize;
+    const std::size_t ihl = (iph[ip::kVersionIhl] & 0x0F) * 4u;
+    const std::size_t total = load_be16(iph + ip::kTotalLength);
+    const Ipv4Address dst_ip = load_be32(iph + ip::kDst);
+    if ((iph[ip::kVersionIhl] >> 4) != 4 || ihl < kIpv4HeaderSize ||
+        total < ihl + kUdpHeaderSize || total > ip_room || iph[ip::kProtocol] != kIpProtoUdp ||
+        (load_be16(iph + ip::kFragment) & (ip::kMoreFragments | ip::kOffsetMask)) != 0 ||
+        (dst_ip != config_.ip && dst_ip != kBroadcastIp)) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return false;
+    }
+    const std::uint8_t* udph = iph + ihl;
+    const std::size_t udp_length = load_be16(udph + udp::kLength);
+    if (udp_length < kUdpHeaderSize || udp_length > total - ihl) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return false;
+    }
+
+    const Ipv4Address src_ip = load_be32(iph + ip::kSrc);
+    learn(src_ip, load_mac(frame + eth::kSrc));
+
+    datagram.packet = packet;
+    datagram.source = {src_ip, load_be16(udph + udp::kSrcPort)};
+    datagram.port = load_be16(udph + udp::kDstPort);
+    packet->pull(kEthHeaderSize + ihl + kUdpHeaderSize);
+    packet->length = static_cast<std::uint16_t>(udp_length - kUdpHeaderSize);
+    datagram.payload = packet->bytes();
+    ++stats_.rx_datagrams;
+    return true;
+}
+
+void UdpStack::handle_arp(Packet* packet) {
+    std::uint8_t* frame = packet->begin();
+    std::uint8_t* a = frame + kEthHeaderSize;
+    // Ethernet/IPv4 ARP only: htype 1, ptype 0x0800, hlen 6, plen 4.
+    if (packet->length < kEthHeaderSize + kArpSize || load_be16(a) != 1 ||
+        load_be16(a + 2) != kEtherTypeIpv4 || a[4] != 6 || a[5] != 4) {
+        ++stats_.rx_dropped;
+        release(packet);
+        return;
+    }
+    const std::uint16_t op = load_be16(a + arp::kOp);
+    const MacAddress sender_mac = load_mac(a + arp::kSenderMac);
+    const Ipv4Address sender_ip = load_be32(a + arp::kSenderIp);
+    const Ipv4Address target_ip = load_be32(a + arp::kTargetIp);
+    if (target_ip == config_.ip) {
+        learn(sender_ip, sender_mac);
+    }
+    if (op != arp::kRequest || target_ip != config_.ip) {
+        release(packet);
+        return;
+    }
+    // Turn the request around in its own buffer.
+    store_mac(frame + eth::kDst, sender_mac);
+    store_mac(frame + eth::kSrc, config_.mac);
+    store_be16(a + arp::kOp, arp::kReply);
+    store_mac(a + arp::kTargetMac, sender_mac);
+    store_be32(a + arp::kTargetIp, sender_ip);
+    store_mac(a + arp::kSenderMac, config_.mac);
+    store_be32(a + arp::kSenderIp, config_.ip);
+    packet->length = kEthHeaderSize + kArpSize;
+    if (ethernet_.transmit(packet) == Status::ok) {
+        ++stats_.arp_replies_sent;
+    } else {
+        release(packet);
+    }
+}
+
+void UdpStack::learn(Ipv4Address ip, const MacAddress& mac) {
+    if (!on_subnet(ip) || ip == config_.ip || mac.is_broadcast()) {
+        return;
+    }
+    for (ArpEntry& entry : arp_) {
+        if (entry.ip == ip) {
+            entry.mac = mac;
+            return;
+        }
+    }
+    arp_[arp_victim_] = {ip, mac};
+    arp_victim_ = (arp_victim_ + 1) % kArpCacheSize;
+}
+
+bool UdpStack::resolve(Ipv4Address ip, MacAddress& mac) const {
+    if (ip == kBroadcastIp || (on_subnet(ip) && (ip | config_.netmask) == kBroadcastIp)) {
+        mac = kBroadcastMac;
+        return true;
+    }
+    const Ipv4Address hop = on_subnet(ip) ? ip : config_.gateway;
+    if (hop == 0) {
+        return false;
+    }
+    for (const ArpEntry& entry : arp_) {
+        if (entry.ip == hop) {
+            mac = entry.mac;
+            return true;
+        }
+    }
+    return false;
+}
+
+void UdpStack::send_arp_request(Ipv4Address ip) {
+    const Ipv4Address hop = on_subnet(ip) ? ip : config_.gateway;
+    if (hop == 0) {
+        return;
+    }
+    Packet* packet = pool_.allocate();
+    if (packet == nullptr) {
+        return;
+    }
+    // The MAC pads frames to the 60-byte minimum (CPC = 0).
+    packet->length = kEthHeaderSize + kArpSize;
+    std::uint8_t* frame = packet->begin();
+    std::memset(frame, 0, packet->length);
+    store_mac(frame + eth::kDst, kBroadcastMac);
+    store_mac(frame + eth::kSrc, config_.mac);
+    store_be16(frame + eth::kType, kEtherTypeArp);
+    std::uint8_t* a = frame + kEthHeaderSize;
+    store_be16(a, 1);
+    store_be16(a + 2, kEtherTypeIpv4);
+    a[4] = 6;
+    a[5] = 4;
+    store_be16(a + arp::kOp, arp::kRequest);
+    store_mac(a + arp::kSenderMac, config_.mac);
+    store_be32(a + arp::kSenderIp, config_.ip);
+    store_be32(a + arp::kTargetIp, hop);
+    if (ethernet_.transmit(packet) == Status::ok) {
+        ++stats_.arp_requests_sent;
+        ethernet_.flush();
+    } else {
+        release(packet);
+    }
+}
+
+Packet* UdpStack::allocate(std::size_t payload_size) {
+    if (payload_size > kMaxUdpPayload) {
+        return nullptr;
+    }
+    Packet* packet = pool_.allocate(kUdpHeadroom);
+    if (packet != nullptr) {
+        packet->length = static_cast<std::uint16_t>(payload_size);
+    }
+    return packet;
+}
+
+Status UdpStack::send(Packet* packet, const Endpoint& to, std::uint16_t from_port) {
+    if (packet == nullptr || packet->headroom() < kUdpHeadroom || packet->length > kMaxUdpPayload) {
+        return Status::invalid_argument;
+    }
+    MacAddress dst_mac;
+    if (!resolve(to.ip, dst_mac)) {
+        ++stats_.tx_unresolved;
+        send_arp_request(to.ip);
+        return Status::not_found;
+    }
+
+    const std::size_t payload = packet->length;
+    std::uint8_t* frame = packet->push(kUdpHeadroom);
+    store_mac(frame + eth::kDst, dst_mac);
+    store_mac(frame + eth::kSrc, config_.mac);
+    store_be16(frame + eth::kType, kEtherTypeIpv4);
+
+    std::uint8_t* iph = frame + kEthHeaderSize;
+    iph[ip::kVersionIhl] = 0x45;
+    iph[1] = 0;  // DSCP/ECN
+    store_be16(iph + ip::kTotalLength, static_cast<std::uint16_t>(kIpv4HeaderSize + kUdpHeaderSize + payload));
+    store_be16(iph + ip::kId, ip_id_++);
+    store_be16(iph + ip::kFragment, ip::kDontFragment);
+    iph[ip::kTtl] = 64;
+    iph[ip::kProtocol] = kIpProtoUdp;
+    store_be16(iph + ip::kChecksum, 0);  // inserted by the MAC
+    store_be32(iph + ip::kSrc, config_.ip);
+    store_be32(iph + ip::kDst, to.ip);
+
+    std::uint8_t* udph = iph + kIpv4HeaderSize;
+    store_be16(udph + udp::kSrcPort, from_port);
+    store_be16(udph + udp::kDstPort, to.port);
+    store_be16(udph + udp::kLength, static_cast<std::uint16_t>(kUdpHeaderSize + payload));
+    store_be16(udph + udp::kChecksum, 0);  // inserted by the MAC
+
+    const Status status = ethernet_.transmit(packet);
+    if (status != Status::ok) {
+        packet->pull(kUdpHeadroom);
+        packet->length = static_cast<std::uint16_t>(payload);
+        return status;
+    }
+    ++stats_.tx_datagrams;
+    return Status::ok;
+}
+
+Status UdpStack::send_to(const Endpoint& to, std::uint16_t from_port, ConstByteSpan payload) {
+    Packet* packet = allocate(payload.size());
+    if (packet == nullptr) {
+        return payload.size() > kMaxUdpPayload ? Status::invalid_argument : Status::no_memory;
+    }
+    std::memcpy(packet->begin(), payload.data(), payload.size());
+    const Status status = send(packet, to, from_port);
+    if (status != Status::ok) {
+        release(packet);
+    }
+    return status;
+}
+
+Status UdpStack::reply(Datagram& datagram, std::size_t length) {
+    Packet* packet = datagram.packet;
+    if (packet == nullptr || length > packet->length + packet->tailroom() || length > kMaxUdpPayload) {
+        return Status::invalid_argument;
+    }
+    packet->length = static_cast<std::uint16_t>(length);
+    const Status status = send(packet, datagram.source, datagram.port);
+    if (status == Status::ok) {
+        datagram.packet = nullptr;
+        datagram.payload = {};
+    }
+    return status;
+}
+
+}  // namespace nucleo::net
@@ -0,0 +1,224 @@
+// ETH MAC + DMA (RMII, LAN8742A PHY at MDIO address 0) on the NUCLEO-H563ZI.
+#include "stm32h5xx.h"
+
+#include "nucleo/net/board_eth.hpp"
+#include "nucleo/net/ethernet.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::net {
+namespace {
+
+constexpr std::uint32_t kAfEth = 11;
+constexpr std::uint32_t kIrqPriority = 6;
+
+struct Pin {
+    GPIO_TypeDef* port;
+    std::uint32_t pin;
+};
+
+// UM3115: RMII signals routed to the on-board PHY.
+const Pin kRmiiPins[] = {
+    {GPIOA, 1},   // REF_CLK
+    {GPIOA, 2},   // MDIO
+    {GPIOC, 1},   // MDC
+    {GPIOA, 7},   // CRS_DV
+    {GPIOC, 4},   // RXD0
+    {GPIOC, 5},   // RXD1
+    {GPIOG, 11},  // TX_EN
+    {GPIOG, 13},  // TXD0
+    {GPIOB, 15},  // TXD1
+};
+
+// LAN8742A registers.
+constexpr std::uint32_t kPhyAddress = 0;
+constexpr std::uint32_t kPhyBcr = 0;
+constexpr std::uint32_t kPhyBsr = 1;
+constexpr std::uint32_t kPhySpecialStatus = 31;
+constexpr std::uint32_t kBcrReset = 1u << 15;
+constexpr std::uint32_t kBcrAutoNegotiate = 1u << 12;
+constexpr std::uint32_t kBcrRestartAutoNegotiate = 1u << 9;
+constexpr std::uint32_t kBsrLinkUp = 1u << 2;
+constexpr std::uint32_t kSpecial100Mbit = 1u << 3;
+constexpr std::uint32_t kSpecialFullDuplex = 1u << 4;
+
+// MDC = HCLK / 124 for HCLK in 250-300 MHz (CR = 5), within the 2.5 MHz limit.
+constexpr std::uint32_t kMdioClockRange = 5;
+
+class EthPort final : public EthernetPort {
+public:
+    Status start(Ethernet& owner, const MacAddress& mac, Span<DmaDescriptor> rx,
+                 Span<DmaDescriptor> tx, std::uint32_t rx_buffer_size) override;
+    void rx_tail(std::uint32_t index) override;
+    void tx_tail(std::uint32_t index) override;
+    bool link_up() override;
+
+    void on_irq();
+
+private:
+    Ethernet* owner_ = nullptr;
+    Span<DmaDescriptor> rx_;
+    Span<DmaDescriptor> tx_;
+    bool link_ = false;
+};
+
+EthPort g_port;
+
+void configure_pins() {
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_GPIOBEN | RCC_AHB2ENR_GPIOCEN |
+                    RCC_AHB2ENR_GPIOGEN;
+    (void)RCC->AHB2ENR;
+    for (const Pin& p : kRmiiPins) {
+        p.port->MODER = (p.port->MODER & ~(3u << (p.pin * 2))) | (2u << (p.pin * 2));
+        p.port->OSPEEDR |= 3u << (p.pin * 2);
+        volatile std::uint32_t& afr = p.port->AFR[p.pin / 8];
+        afr = (afr & ~(0xFu << ((p.pin % 8) * 4))) | (kAfEth << ((p.pin % 8) * 4));
+    }
+}
+
+std::uint32_t mdio_read(std::uint32_t reg) {
+    ETH->MACMDIOAR = (kPhyAddress << ETH_MACMDIOAR_PA_Pos) | (reg << ETH_MACMDIOAR_RDA_Pos) |
+                     (kMdioClockRange << ETH_MACMDIOAR_CR_Pos) | (3u << ETH_MACMDIOAR_GOC_Pos) |
+                     ETH_MACMDIOAR_MB;
+    while ((ETH->MACMDIOAR & ETH_MACMDIOAR_MB) != 0) {
+    }
+    return ETH->MACMDIODR & 0xFFFF;
+}
+
+void mdio_write(std::uint32_t reg, std::uint32_t value) {
+    ETH->MACMDIODR = value;
+    ETH->MACMDIOAR = (kPhyAddress << ETH_MACMDIOAR_PA_Pos) | (reg << ETH_MACMDIOAR_RDA_Pos) |
+                     (kMdioClockRange << ETH_MACMDIOAR_CR_Pos) | (1u << ETH_MACMDIOAR_GOC_Pos) |
+                     ETH_MACMDIOAR_MB;
+    while ((ETH->MACMDIOAR & ETH_MACMDIOAR_MB) != 0) {
+    }
+}
+
+Status EthPort::start(Ethernet& owner, const MacAddress& mac, Span<DmaDescriptor> rx,
+                      Span<DmaDescriptor> tx, std::uint32_t rx_buffer_size) {
+    owner_ = &owner;
+    rx_ = rx;
+    tx_ = tx;
+    link_ = false;
+
+    // RMII must be selected while the MAC is held in reset.
+    RCC->APB3ENR |= RCC_APB3ENR_SBSEN;
+    RCC->AHB1RSTR |= RCC_AHB1RSTR_ETHRST;
+    SBS->PMCR = (SBS->PMCR & ~SBS_PMCR_ETH_SEL_PHY) | SBS_PMCR_ETH_SEL_PHY_2;
+    RCC->AHB1RSTR &= ~RCC_AHB1RSTR_ETHRST;
+    RCC->AHB1ENR |= RCC_AHB1ENR_ETHEN | RCC_AHB1ENR_ETHTXEN | RCC_AHB1ENR_ETHRXEN;
+    (void)RCC->AHB1ENR;
+    configure_pins();
+
+    ETH->DMAMR |= ETH_DMAMR_SWR;
+    for (std::uint32_t start = platform::millis(); (ETH->DMAMR & ETH_DMAMR_SWR) != 0;) {
+        if (platform::millis() - start > 10) {
+            return Status::hardware_error;  // no REF_CLK from the PHY
+        }
+    }
+
+    mdio_write(kPhyBcr, kBcrReset);
+    for (std::uint32_t start = platform::millis(); (mdio_read(kPhyBcr) & kBcrReset) != 0;) {
+        if (platform::millis() - start > 100) {
+            return Status::timeout;
+        }
+    }
+    mdio_write(kPhyBcr, kBcrAutoNegotiate | kBcrRestartAutoNegotiate);
+
+    // MAC: checksum offload, strip FCS and pad; speed/duplex set on link up.
+    ETH->MACCR = ETH_MACCR_IPC | ETH_MACCR_CST | ETH_MACCR_ACS;
+    ETH->MACPFR = 0;  // own address and broadcast only
+    ETH->MACA0HR = static_cast<std::uint32_t>(mac.bytes[5]) << 8 | mac.bytes[4];
+    ETH->MACA0LR = static_cast<std::uint32_t>(mac.bytes[3]) << 24 |
+                   static_cast<std::uint32_t>(mac.bytes[2]) << 16 |
+                   static_cast<std::uint32_t>(mac.bytes[1]) << 8 | mac.bytes[0];
+
+    // MTL: store-and-forward both ways (required for checksum insertion).
+    ETH->MTLTQOMR |= ETH_MTLTQOMR_TSF;
+    ETH->MTLRQOMR |= ETH_MTLRQOMR_RSF;
+
+    // DMA: address-aligned bursts, contiguous descriptors (DSL = 0).
+    ETH->DMASBMR = ETH_DMASBMR_AAL | ETH_DMASBMR_FB;
+    ETH->DMACCR = 0;
+    ETH->DMACTCR = 32u << ETH_DMACTCR_TPBL_Pos;
+    ETH->DMACRCR = (32u << ETH_DMACRCR_RPBL_Pos) | (rx_buffer_size << ETH_DMACRCR_RBSZ_Pos);
+    ETH->DMACTDLAR = dma_address(tx.data());
+    ETH->DMACTDRLR = static_cast<std::uint32_t>(tx.size() - 1);
+    ETH->DMACTDTPR = dma_address(tx.data());
+    ETH->DMACRDLAR = dma_address(rx.data());
+    ETH->DMACRDRLR = static_cast<std::uint32_t>(rx.size() - 1);
+    ETH->DMACIER = ETH_DMACIER_NIE | ETH_DMACIER_RIE | ETH_DMACIER_TIE | ETH_DMACIER_AIE |
+                   ETH_DMACIER_FBEE | ETH_DMACIER_RBUE;
+
+    NVIC_SetPriority(ETH_IRQn, kIrqPriority);
+    NVIC_EnableIRQ(ETH_IRQn);
+
+    ETH->DMACTCR |= ETH_DMACTCR_ST;
+    ETH->DMACRCR |= ETH_DMACRCR_SR;
+    ETH->MACCR |= ETH_MACCR_TE | ETH_MACCR_RE;
+    return Status::ok;
+}
+
+void EthPort::rx_tail(std::uint32_t index) {
+    // The DMA stops at the tail descriptor, so point at the one just before
+    // the driver's read position: every other descriptor is armed.
+    const std::uint32_t last = index == 0 ? static_cast<std::uint32_t>(rx_.size() - 1) : index - 1;
+    __DSB();
+    ETH->DMACRDTPR = dma_address(&rx_[last]);
+}
+
+void EthPort::tx_tail(std::uint32_t index) {
+    __DSB();
+    ETH->DMACTDTPR = dma_address(&tx_[index]);
+}
+
+bool EthPort::link_up() {
+    const bool up = (mdio_read(kPhyBsr) & kBsrLinkUp) != 0;
+    if (up && !link_) {
+        const std::uint32_t status = mdio_read(kPhySpecialStatus);
+        std::uint32_t maccr = ETH->MACCR & ~(ETH_MACCR_FES | ETH_MACCR_DM);
+        if ((status & kSpecial100Mbit) != 0) {
+            maccr |= ETH_MACCR_FES;
+        }
+        if ((status & kSpecialFullDuplex) != 0) {
+            maccr |= ETH_MACCR_DM;
+        }
+        ETH->MACCR = maccr;
+    }
+    link_ = up;
+    return up;
+}
+
+NUCLEO_RAMFUNC void EthPort::on_irq() {
+    const std::uint32_t status = ETH->DMACSR;
+    // Status bits are write-one-to-clear.
+    ETH->DMACSR = status & (ETH_DMACSR_RI | ETH_DMACSR_TI | ETH_DMACSR_RBU | ETH_DMACSR_FBE |
+                            ETH_DMACSR_NIS | ETH_DMACSR_AIS);
+    if ((status & ETH_DMACSR_RI) != 0) {
+        owner_->isr_rx();
+    }
+    if ((status & ETH_DMACSR_TI) != 0) {
+        owner_->isr_tx();
+    }
+    if ((status & ETH_DMACSR_RBU) != 0) {
+        // Receiver suspended on an unarmed descriptor; the next rx_tail()
+        // write resumes it.
+        owner_->isr_rx();
+    }
+}
+
+}  // namespace
+
+EthernetPort& board_ethernet_port() { return g_port; }
+
+MacAddress board_mac_address() {
+    // 96-bit unique ID; fold the lot into the low three bytes.
+    const std::uint32_t* uid = reinterpret_cast<const std::uint32_t*>(UID_BASE);
+    const std::uint32_t h = uid[0] ^ uid[1] ^ uid[2];
+    return {{0x02, 0x80, 0xE1, static_cast<std::uint8_t>(h >> 16), static_cast<std::uint8_t>(h >> 8),
+             static_cast<std::uint8_t>(h)}};
+}
+
+}  // namespace nucleo::net
+
+extern "C" NUCLEO_RAMFUNC void ETH_IRQHandler() { nucleo::net::g_port.on_irq(); }
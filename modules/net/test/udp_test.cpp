@@ -0,0 +1,202 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "nucleo/net/headers.hpp"
+#include "nucleo/net/host/sim_ethernet.hpp"
+#include "nucleo/net/udp.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::net;
+
+namespace {
+
+struct Node {
+    explicit Node(std::uint8_t id)
+        : config{{{0x02, 0, 0, 0, 0, id}}, ipv4(192, 168, 1, id)}, stack(eth, pool, config) {}
+
+    NetConfig config;
+    host::SimEthernet sim;
+    StaticPacketPool<24> pool;
+    DescriptorRing<8> rx;
+    DescriptorRing<8> tx;
+    Ethernet eth{sim, pool, rx, tx};
+    UdpStack stack;
+};
+
+struct Link {
+    Link() {
+        host::SimEthernet::connect(a->sim, b->sim);
+        a->stack.start();
+        b->stack.start();
+    }
+    std::unique_ptr<Node> a = std::make_unique<Node>(1);
+    std::unique_ptr<Node> b = std::make_unique<Node>(2);
+};
+
+std::vector<std::uint8_t> collect(UdpStack& stack, std::uint16_t* port = nullptr) {
+    std::vector<std::uint8_t> out;
+    stack.poll([&](Datagram& d) {
+        out.assign(d.payload.begin(), d.payload.end());
+        if (port != nullptr) {
+            *port = d.port;
+        }
+    });
+    return out;
+}
+
+const std::uint8_t kHello[] = {'h', 'e', 'l', 'l', 'o'};
+
+}  // namespace
+
+TEST(internet_checksum_matches_rfc1071_example) {
+    const std::uint8_t data[] = {0x00, 0x01, 0xF2, 0x03, 0xF4, 0xF5, 0xF6, 0xF7};
+    CHECK_EQ(checksum_finish(checksum_add(data)), 0x220Du);
+    const std::uint8_t odd[] = {0x01};
+    CHECK_EQ(checksum_finish(checksum_add(odd)), 0xFEFFu);
+}
+
+TEST(first_send_resolves_peer_with_arp) {
+    Link link;
+    Node& a = *link.a;
+    Node& b = *link.b;
+    const Endpoint to{b.config.ip, 9000};
+
+    CHECK_EQ(a.stack.send_to(to, 5000, kHello), Status::not_found);
+    CHECK_EQ(a.stack.stats().arp_requests_sent, 1u);
+    b.stack.poll([](Datagram&) {});  // answers the request
+    CHECK_EQ(b.stack.stats().arp_replies_sent, 1u);
+    a.stack.poll([](Datagram&) {});  // learns the reply
+
+    MacAddress mac;
+    REQUIRE(a.stack.resolve(b.config.ip, mac));
+    CHECK(mac == b.config.mac);
+    REQUIRE_EQ(a.stack.send_to(to, 5000, kHello), Status::ok);
+    a.stack.flush();
+
+    std::uint16_t port = 0;
+    const auto got = collect(b.stack, &port);
+    CHECK(got == std::vector<std::uint8_t>(kHello, kHello + sizeof kHello));
+    CHECK_EQ(port, 9000u);
+    // b learned a's address from the datagram itself.
+    CHECK(b.stack.resolve(a.config.ip, mac));
+    a.stack.poll([](Datagram&) {});  // reclaims the sent datagram
+    CHECK_EQ(a.pool.available(), a.pool.capacity() - 8);  // only the rx ring is out
+}
+
+TEST(offload_inserts_valid_checksums) {
+    Link link;
+    Node& a = *link.a;
+    a.stack.send_to({link.b->config.ip, 9}, 1, kHello);  // triggers ARP
+    link.b->stack.poll([](Datagram&) {});
+    a.stack.poll([](Datagram&) {});
+    a.sim.clear_transmitted();
+    REQUIRE_EQ(a.stack.send_to({link.b->config.ip, 9}, 1, kHello), Status::ok);
+    a.stack.flush();
+
+    REQUIRE_EQ(a.sim.transmitted().size(), 1u);
+    const auto& f = a.sim.transmitted()[0];
+    CHECK_EQ(f.size(), 60u);  // padded by the MAC
+    const std::uint8_t* iph = &f[kEthHeaderSize];
+    CHECK_EQ(checksum_finish(checksum_add({iph, kIpv4HeaderSize})), 0u);
+    CHECK(load_be16(iph + kIpv4HeaderSize + udp::kChecksum) != 0);
+    CHECK_EQ(udp_checksum(a.config.ip, link.b->config.ip,
+                          {iph + kIpv4HeaderSize, kUdpHeaderSize + sizeof kHello}),
+             0u);
+}
+
+TEST(reply_reuses_the_received_packet) {
+    Link link;
+    Node& a = *link.a;
+    Node& b = *link.b;
+    const Endpoint to{b.config.ip, 7};
+    a.stack.send_to(to, 4000, kHello);
+    b.stack.poll([](Datagram&) {});
+    a.stack.poll([](Datagram&) {});
+    b.stack.poll([](Datagram&) {});  // reclaims the ARP reply
+
+    Packet* out = a.stack.allocate(sizeof kHello);
+    REQUIRE(out != nullptr);
+    std::memcpy(out->begin(), kHello, sizeof kHello);
+    REQUIRE_EQ(a.stack.send(out, to, 4000), Status::ok);
+    a.stack.flush();
+
+    const std::size_t b_free = b.pool.available();
+    std::size_t echoed = 0;
+    b.stack.poll([&](Datagram& d) {
+        const Packet* in = d.packet;
+        // The payload is read in place from the DMA buffer.
+        CHECK(d.payload.data() >= in->data && d.payload.end() <= in->data + Packet::kCapacity);
+        d.payload[0] = 'j';
+        if (b.stack.reply(d, d.payload.size()) == Status::ok) {
+            ++echoed;
+        }
+        CHECK(d.packet == nullptr);
+    });
+    CHECK_EQ(echoed, 1u);
+    // The received packet went out as the echo and is reclaimed on the next
+    // poll; only the block that re-armed the ring stays out until then.
+    CHECK_EQ(b.pool.available(), b_free - 1);
+    b.stack.poll([](Datagram&) {});
+    CHECK_EQ(b.pool.available(), b_free);
+
+    std::uint16_t port = 0;
+    const auto got = collect(a.stack, &port);
+    REQUIRE_EQ(got.size(), sizeof kHello);
+    CHECK_EQ(got[0], 'j');
+    CHECK_EQ(port, 4000u);
+}
+
+TEST(drops_traffic_not_addressed_to_us) {
+    Link link;
+    Node& a = *link.a;
+    Node& b = *link.b;
+    a.stack.send_to({b.config.ip, 1}, 1, kHello);
+    b.stack.poll([](Datagram&) {});
+    a.stack.poll([](Datagram&) {});
+    a.sim.clear_transmitted();
+    REQUIRE_EQ(a.stack.send_to({b.config.ip, 1}, 1, kHello), Status::ok);
+    a.stack.flush();
+    const auto good = a.sim.transmitted().back();
+
+    auto wrong_mac = good;
+    wrong_mac[eth::kDst + 5] ^= 0x40;
+    auto fragment = good;
+    store_be16(&fragment[kEthHeaderSize + ip::kFragment], ip::kMoreFragments);
+    fragment[kEthHeaderSize + ip::kChecksum] = 0;
+    fragment[kEthHeaderSize + ip::kChecksum + 1] = 0;
+    store_be16(&fragment[kEthHeaderSize + ip::kChecksum],
+               checksum_finish(checksum_add({&fragment[kEthHeaderSize], kIpv4HeaderSize})));
+
+    const std::uint32_t dropped = b.stack.stats().rx_dropped;
+    b.sim.receive({wrong_mac.data(), wrong_mac.size()});
+    b.sim.receive({fragment.data(), fragment.size()});
+    std::size_t delivered = b.stack.poll([](Datagram&) {});
+    CHECK_EQ(delivered, 1u);  // the original, delivered by the link
+    CHECK_EQ(b.stack.stats().rx_dropped, dropped + 2);
+
+    // Too short for an IPv4 header: dropped before any of it is read.
+    const std::vector<std::uint8_t> runt(good.begin(), good.begin() + kEthHeaderSize + kIpv4HeaderSize - 1);
+    b.sim.receive({runt.data(), runt.size()});
+    CHECK_EQ(b.stack.poll([](Datagram&) {}), 0u);
+    CHECK_EQ(b.stack.stats().rx_dropped, dropped + 3);
+
+    // A corrupted payload is caught by the receive checksum engine.
+    auto corrupt = good;
+    corrupt[kUdpHeadroom] ^= 0xFF;
+    b.sim.receive({corrupt.data(), corrupt.size()});
+    CHECK_EQ(b.stack.poll([](Datagram&) {}), 0u);
+    CHECK_EQ(b.eth.stats().rx_errors, 1u);
+}
+
+TEST(off_subnet_needs_a_gateway) {
+    auto node = std::make_unique<Node>(1);
+    node->sim.loopback();
+    node->stack.start();
+    CHECK_EQ(node->stack.send_to({ipv4(10, 0, 0, 1), 1}, 1, kHello), Status::not_found);
+    CHECK_EQ(node->stack.stats().arp_requests_sent, 0u);
+    // Subnet broadcast needs no resolution.
+    CHECK_EQ(node->stack.send_to({ipv4(192, 168, 1, 255), 1}, 1, kHello), Status::ok);
+    CHECK(node->stack.allocate(kMaxUdpPayload + 1) == nullptr);
+}
@@ -0,0 +1,48 @@
+// Cost of the instrumentation itself on the host.
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+
+namespace {
+
+NUCLEO_NOINLINE void empty_scope() { NUCLEO_PROBE("bench.empty"); }
+
+perf::Probe g_direct("bench.direct");
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+
+    std::uint32_t v = 1;
+    bench.run("probe_record", 1000, [&] {
+        v = v * 1664525u + 1013904223u;
+        g_direct.record(v >> 12);
+    });
+    bench.run("scoped_probe_empty_scope", 1000, [] { empty_scope(); });
+
+    // Thirty more populated probes for a realistic snapshot.
+    static char names[30][16];
+    static std::deque<perf::Probe> extra;
+    for (int i = 0; i < 30; ++i) {
+        std::snprintf(names[i], sizeof names[i], "bench.extra%02d", i);
+        perf::Probe& probe = extra.emplace_back(names[i]);
+        for (std::uint32_t k = 0; k < 1000; ++k) {
+            probe.record(k * 37 + static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::vector<std::uint8_t> buf(perf::snapshot_size_max());
+    std::size_t size = 0;
+    bench.run("write_snapshot_32_probes", 10, [&] {
+        size = perf::write_snapshot(ByteSpan{buf.data(), buf.size()}, 0);
+    });
+    bench.metric("snapshot_bytes_32_probes", static_cast<double>(size), "B");
+    return 0;
+}
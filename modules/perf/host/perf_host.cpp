@@ -0,0 +1,26 @@
+// Host counterparts of the DWT counter and the SWO sink.
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/host/swo_capture.hpp"
+#include "nucleo/perf/swo.hpp"
+
+namespace nucleo::perf {
+
+void cycle_counter_init() {}
+
+std::uint32_t cycle_counter_hz() { return 1'000'000'000; }
+
+void swo_init(std::uint32_t) {}
+
+void swo_write(ConstByteSpan data) {
+    host::swo_capture().insert(host::swo_capture().end(), data.begin(), data.end());
+}
+
+namespace host {
+
+std::vector<std::uint8_t>& swo_capture() {
+    static std::vector<std::uint8_t> bytes;
+    return bytes;
+}
+
+}  // namespace host
+}  // namespace nucleo::perf
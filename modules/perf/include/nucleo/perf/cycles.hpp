@@ -0,0 +1,38 @@
+// Free-running cycle counter.
+//
+// On the target this is the Cortex-M33 DWT CYCCNT at HCLK (250 MHz, wraps
+// every ~17 s); differences of two reads are valid across one wrap. On the
+// host it is the steady clock in nanoseconds, reported with a 1 GHz "clock"
+// so the same conversions apply.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/compiler.hpp"
+
+#if NUCLEO_PLATFORM_STM32H5
+#include "stm32h5xx.h"
+#else
+#include <chrono>
+#endif
+
+namespace nucleo::perf {
+
+/// Enables the trace block and starts CYCCNT. Idempotent.
+void cycle_counter_init();
+
+/// Frequency of the counter returned by cycles().
+std::uint32_t cycle_counter_hz();
+
+#if NUCLEO_PLATFORM_STM32H5
+NUCLEO_ALWAYS_INLINE std::uint32_t cycles() { return DWT->CYCCNT; }
+#else
+NUCLEO_ALWAYS_INLINE std::uint32_t cycles() {
+    return static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+#endif
+
+}  // namespace nucleo::perf
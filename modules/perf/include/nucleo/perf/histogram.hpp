@@ -0,0 +1,47 @@
+// Log-linear latency buckets shared by the firmware and the host decoder.
+//
+// Values below 4 get their own bucket; above that every power-of-two octave
+// is split into 4 equal sub-buckets, so a bucket's width is at most 25% of
+// its lower bound. Octaves run up to 2^24 cycles (67 ms at 250 MHz); longer
+// samples land in the final overflow bucket. Computing the index is a CLZ
+// and two shifts.
+#pragma once
+
+#include <cstdint>
+
+namespace nucleo::perf {
+
+inline constexpr unsigned kSubBucketBits = 2;
+inline constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+inline constexpr unsigned kMaxOctave = 24;
+/// 4 linear buckets, (kMaxOctave - 2) octaves of 4, one overflow bucket.
+inline constexpr unsigned kBucketCount = kSubBuckets + (kMaxOctave - kSubBucketBits) * kSubBuckets + 1;
+
+constexpr unsigned bucket_index(std::uint32_t value) {
+    if (value < kSubBuckets) {
+        return value;
+    }
+    const unsigned octave = 31u - static_cast<unsigned>(__builtin_clz(value));
+    if (octave >= kMaxOctave) {
+        return kBucketCount - 1;
+    }
+    const unsigned sub = (value >> (octave - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets + (octave - kSubBucketBits) * kSubBuckets + sub;
+}
+
+/// Smallest value that maps to `index`.
+constexpr std::uint64_t bucket_lower(unsigned index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const unsigned octave = (index - kSubBuckets) / kSubBuckets + kSubBucketBits;
+    const unsigned sub = (index - kSubBuckets) % kSubBuckets;
+    return (std::uint64_t{1} << octave) + (std::uint64_t{sub} << (octave - kSubBucketBits));
+}
+
+/// One past the largest value that maps to `index`.
+constexpr std::uint64_t bucket_upper(unsigned index) {
+    return index + 1 < kBucketCount ? bucket_lower(index + 1) : std::uint64_t{1} << 32;
+}
+
+}  // namespace nucleo::perf
@@ -0,0 +1,15 @@
+// Host-only access to bytes "sent" over the simulated SWO port.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/perf/host/swo_capture.hpp is only available in host builds"
+#endif
+
+namespace nucleo::perf::host {
+
+std::vector<std::uint8_t>& swo_capture();
+
+}  // namespace nucleo::perf::host
@@ -0,0 +1,103 @@
+// Scoped timing probes aggregated in place.
+//
+//   void control_step() {
+//       NUCLEO_PROBE("ctrl.step");
+//       ...
+//   }
+//
+// Each probe keeps count, min, max, total and a log-linear histogram of the
+// cycles spent in its scope; nothing is buffered per sample, so a probe can
+// sit on a hot path indefinitely. Probes register themselves on first use
+// and are exported together by write_snapshot().
+//
+// A probe is updated without locking: give each probe a single execution
+// context (one ISR, or thread code), which the macro does naturally since
+// it creates one probe per call site.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/histogram.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::perf {
+
+struct ProbeStats {
+    std::uint32_t count = 0;
+    std::uint32_t min = 0xFFFFFFFFu;
+    std::uint32_t max = 0;
+    std::uint64_t total = 0;
+    std::uint32_t buckets[kBucketCount] = {};
+};
+
+class Probe {
+public:
+    /// `name` must have static storage duration (a string literal).
+    explicit Probe(const char* name);
+    Probe(const Probe&) = delete;
+    Probe& operator=(const Probe&) = delete;
+
+    NUCLEO_ALWAYS_INLINE void record(std::uint32_t cycles) {
+        ProbeStats& s = stats_;
+        ++s.count;
+        s.total += cycles;
+        if (cycles < s.min) {
+            s.min = cycles;
+        }
+        if (cycles > s.max) {
+            s.max = cycles;
+        }
+        ++s.buckets[bucket_index(cycles)];
+    }
+
+    const char* name() const { return name_; }
+    std::uint16_t id() const { return id_; }
+    const ProbeStats& stats() const { return stats_; }
+    void reset();
+
+    /// Next registered probe, for iteration from first_probe().
+    const Probe* next() const { return next_; }
+    Probe* next() { return next_; }
+
+private:
+    const char* name_;
+    std::uint16_t id_;
+    Probe* next_;
+    ProbeStats stats_;
+};
+
+/// Head of the registration list (most recently registered first).
+Probe* first_probe();
+std::uint16_t probe_count();
+
+/// Clears the statistics of every registered probe.
+void reset_probes();
+
+class ScopedProbe {
+public:
+    NUCLEO_ALWAYS_INLINE explicit ScopedProbe(Probe& probe) : probe_(probe), start_(cycles()) {}
+    NUCLEO_ALWAYS_INLINE ~ScopedProbe() { probe_.record(cycles() - start_); }
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    Probe& probe_;
+    std::uint32_t start_;
+};
+
+}  // namespace nucleo::perf
+
+#define NUCLEO_PERF_CAT2(a, b) a##b
+#define NUCLEO_PERF_CAT(a, b) NUCLEO_PERF_CAT2(a, b)
+
+#if NUCLEO_PERF_DISABLE
+#define NUCLEO_PROBE(name) ((void)0)
+#else
+/// Times the rest of the enclosing scope under `name` (a string literal).
+#define NUCLEO_PROBE(name)                                                          \
+    static ::nucleo::perf::Probe NUCLEO_PERF_CAT(nucleo_probe_, __LINE__){name};    \
+    const ::nucleo::perf::ScopedProbe NUCLEO_PERF_CAT(nucleo_probe_scope_, __LINE__) { \
+        NUCLEO_PERF_CAT(nucleo_probe_, __LINE__)                                    \
+    }
+#endif
@@ -0,0 +1,35 @@
+// Compact binary export of all probe statistics.
+//
+// Layout (little-endian, varint = unsigned LEB128):
+//
+//   "NPRF"  version:u8  reserved:u8  probe_count:u16  clock_hz:u32  uptime_ms:u32
+//   probe_count x {
+//       id:varint  name_len:u8  name[name_len]
+//       count:varint  min:varint  max:varint  total:varint
+//       nonzero_buckets:u8  nonzero_buckets x { index:u8  count:varint }
+//   }
+//   crc32:u32   (over everything before it)
+//
+// A probe that saw no samples costs about a dozen bytes. Transport framing
+// (COBS over the UART, raw over SWO) is added by the caller.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::perf {
+
+inline constexpr std::uint8_t kSnapshotMagic[4] = {'N', 'P', 'R', 'F'};
+inline constexpr std::uint8_t kSnapshotVersion = 1;
+
+/// Worst-case size of write_snapshot() for the probes registered now.
+std::size_t snapshot_size_max();
+
+/// Serialises every registered probe into `out`. Returns the number of
+/// bytes written, or 0 if `out` is too small. Statistics are read with
+/// interrupts masked per probe so each probe's record is consistent.
+std::size_t write_snapshot(ByteSpan out, std::uint32_t uptime_ms);
+
+}  // namespace nucleo::perf
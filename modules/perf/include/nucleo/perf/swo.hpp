@@ -0,0 +1,19 @@
+// Serial Wire Output sink for profiling snapshots (ITM stimulus port 0).
+// The ST-LINK on the NUCLEO board captures SWO on PB3.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::perf {
+
+/// Configures TPIU for NRZ (UART-style) SWO at `baud` and enables ITM
+/// stimulus port 0.
+void swo_init(std::uint32_t baud);
+
+/// Writes bytes to stimulus port 0, blocking while the ITM FIFO is full.
+/// Drops the data silently when no debugger has enabled tracing.
+void swo_write(ConstByteSpan data);
+
+}  // namespace nucleo::perf
@@ -0,0 +1,35 @@
+#include "nucleo/perf/probe.hpp"
+
+#include "nucleo/platform/irq.hpp"
+
+namespace nucleo::perf {
+namespace {
+
+Probe* g_first = nullptr;
+std::uint16_t g_count = 0;
+
+}  // namespace
+
+Probe::Probe(const char* name) : name_(name) {
+    platform::CriticalSection lock;
+    id_ = g_count++;
+    next_ = g_first;
+    g_first = this;
+}
+
+void Probe::reset() {
+    platform::CriticalSection lock;
+    stats_ = ProbeStats{};
+}
+
+Probe* first_probe() { return g_first; }
+
+std::uint16_t probe_count() { return g_count; }
+
+void reset_probes() {
+    for (Probe* p = g_first; p != nullptr; p = p->next()) {
+        p->reset();
+    }
+}
+
+}  // namespace nucleo::perf
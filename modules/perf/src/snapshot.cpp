@@ -0,0 +1,76 @@
+#include "nucleo/perf/snapshot.hpp"
+
+#include <cstring>
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+#include "nucleo/platform/irq.hpp"
+
+namespace nucleo::perf {
+namespace {
+
+constexpr std::size_t kHeaderSize = 4 + 1 + 1 + 2 + 4 + 4;
+constexpr std::size_t kMaxVarint32 = 5;
+constexpr std::size_t kMaxVarint64 = 10;
+constexpr std::size_t kMaxName = 255;
+
+}  // namespace
+
+std::size_t snapshot_size_max() {
+    std::size_t size = kHeaderSize + 4;
+    for (const Probe* p = first_probe(); p != nullptr; p = p->next()) {
+        const std::size_t name = std::strlen(p->name());
+        size += kMaxVarint32 + 1 + (name < kMaxName ? name : kMaxName) + 3 * kMaxVarint32 +
+                kMaxVarint64 + 1 + kBucketCount * (1 + kMaxVarint32);
+    }
+    return size;
+}
+
+std::size_t write_snapshot(ByteSpan out, std::uint32_t uptime_ms) {
+    ByteWriter w(out);
+    w.bytes(kSnapshotMagic, sizeof kSnapshotMagic);
+    w.u8(kSnapshotVersion);
+    w.u8(0);
+    w.u16(probe_count());
+    w.u32(cycle_counter_hz());
+    w.u32(uptime_ms);
+
+    for (const Probe* p = first_probe(); p != nullptr; p = p->next()) {
+        ProbeStats s;
+        {
+            platform::CriticalSection lock;
+            s = p->stats();
+        }
+        const std::size_t name_len = std::strlen(p->name());
+        const std::uint8_t name_bytes = static_cast<std::uint8_t>(name_len < kMaxName ? name_len : kMaxName);
+        w.varint(p->id());
+        w.u8(name_bytes);
+        w.bytes(p->name(), name_bytes);
+        w.varint(s.count);
+        w.varint(s.count != 0 ? s.min : 0);
+        w.varint(s.max);
+        w.varint(s.total);
+
+        std::uint8_t nonzero = 0;
+        for (const std::uint32_t b : s.buckets) {
+            nonzero = static_cast<std::uint8_t>(nonzero + (b != 0 ? 1 : 0));
+        }
+        w.u8(nonzero);
+        for (unsigned i = 0; i < kBucketCount; ++i) {
+            if (s.buckets[i] != 0) {
+                w.u8(static_cast<std::uint8_t>(i));
+                w.varint(s.buckets[i]);
+            }
+        }
+    }
+
+    if (!w.ok()) {
+        return 0;
+    }
+    w.u32(crc32(w.data(), w.size()));
+    return w.ok() ? w.size() : 0;
+}
+
+}  // namespace nucleo::perf
@@ -0,0 +1,68 @@
+// DWT cycle counter and ITM/TPIU SWO output on the Cortex-M33.
+#include "stm32h5xx.h"
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/perf/swo.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::perf {
+namespace {
+
+constexpr std::uint32_t kTpiuProtocolNrz = 2;
+constexpr std::uint32_t kTraceBusId = 1;
+
+}  // namespace
+
+void cycle_counter_init() {
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+std::uint32_t cycle_counter_hz() { return platform::core_clock_hz(); }
+
+void swo_init(std::uint32_t baud) {
+    // PB3 carries TRACESWO as its reset-default AF0 function.
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOBEN;
+    (void)RCC->AHB2ENR;
+    GPIOB->MODER = (GPIOB->MODER & ~(3u << (3 * 2))) | (2u << (3 * 2));
+    GPIOB->AFR[0] &= ~(0xFu << (3 * 4));
+    GPIOB->OSPEEDR |= 3u << (3 * 2);
+
+    DBGMCU->CR |= DBGMCU_CR_TRACE_IOEN | DBGMCU_CR_TRACE_EN;
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+
+    TPI->SPPR = kTpiuProtocolNrz;
+    TPI->ACPR = platform::core_clock_hz() / baud - 1;
+    TPI->FFCR = 0x100;  // formatter off, TRIGIN on
+
+    ITM->TCR = ITM_TCR_ITMENA_Msk | ITM_TCR_SYNCENA_Msk | (kTraceBusId << ITM_TCR_TRACEBUSID_Pos);
+    ITM->TPR = 0;
+    ITM->TER |= 1u;
+}
+
+void swo_write(ConstByteSpan data) {
+    if ((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0 || (ITM->TER & 1u) == 0) {
+        return;
+    }
+    const std::uint8_t* p = data.data();
+    std::size_t n = data.size();
+    while (n >= 4) {
+        std::uint32_t word;
+        __builtin_memcpy(&word, p, 4);
+        while (ITM->PORT[0].u32 == 0) {
+        }
+        ITM->PORT[0].u32 = word;
+        p += 4;
+        n -= 4;
+    }
+    while (n-- != 0) {
+        while (ITM->PORT[0].u32 == 0) {
+        }
+        ITM->PORT[0].u8 = *p++;
+    }
+}
+
+}  // namespace nucleo::perf
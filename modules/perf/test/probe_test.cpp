@@ -0,0 +1,106 @@
+#include <cstring>
+#include <vector>
+
+#include "nucleo/perf/histogram.hpp"
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::perf;
+
+namespace {
+
+Probe g_alpha("test.alpha");
+Probe g_beta("test.beta");
+
+}  // namespace
+
+TEST(buckets_cover_values_contiguously) {
+    CHECK_EQ(kBucketCount, 93u);
+    CHECK_EQ(bucket_lower(0), 0u);
+    for (unsigned i = 0; i + 1 < kBucketCount; ++i) {
+        CHECK(bucket_lower(i) < bucket_upper(i));
+        CHECK_EQ(bucket_upper(i), bucket_lower(i + 1));
+    }
+    for (std::uint32_t v : {0u, 1u, 3u, 4u, 5u, 7u, 8u, 100u, 1000u, 65535u, 1u << 20, (1u << 24) - 1}) {
+        const unsigned i = bucket_index(v);
+        CHECK(bucket_lower(i) <= v);
+        CHECK(v < bucket_upper(i));
+    }
+    CHECK_EQ(bucket_index(1u << 24), kBucketCount - 1);
+    CHECK_EQ(bucket_index(0xFFFFFFFFu), kBucketCount - 1);
+}
+
+TEST(bucket_width_is_within_a_quarter) {
+    for (unsigned i = kSubBuckets; i + 1 < kBucketCount; ++i) {
+        const std::uint64_t width = bucket_upper(i) - bucket_lower(i);
+        CHECK(width * 4 <= bucket_lower(i));
+    }
+}
+
+TEST(probe_aggregates_samples) {
+    g_alpha.reset();
+    g_alpha.record(100);
+    g_alpha.record(10);
+    g_alpha.record(1000);
+    const ProbeStats& s = g_alpha.stats();
+    CHECK_EQ(s.count, 3u);
+    CHECK_EQ(s.min, 10u);
+    CHECK_EQ(s.max, 1000u);
+    CHECK_EQ(s.total, 1110u);
+    CHECK_EQ(s.buckets[bucket_index(100)], 1u);
+    CHECK_EQ(s.buckets[bucket_index(1000)], 1u);
+}
+
+TEST(probes_register_with_unique_ids) {
+    bool saw_alpha = false;
+    bool saw_beta = false;
+    std::vector<std::uint16_t> ids;
+    for (const Probe* p = first_probe(); p != nullptr; p = p->next()) {
+        saw_alpha = saw_alpha || p == &g_alpha;
+        saw_beta = saw_beta || p == &g_beta;
+        ids.push_back(p->id());
+    }
+    CHECK(saw_alpha && saw_beta);
+    CHECK_EQ(ids.size(), static_cast<std::size_t>(probe_count()));
+    CHECK(g_alpha.id() != g_beta.id());
+}
+
+TEST(scoped_macro_records_once_per_pass) {
+    const Probe* probe = nullptr;
+    for (int i = 0; i < 5; ++i) {
+        NUCLEO_PROBE("test.scoped");
+        probe = first_probe();  // the macro's probe registered most recently
+    }
+    REQUIRE(probe != nullptr);
+    CHECK(std::strcmp(probe->name(), "test.scoped") == 0);
+    CHECK_EQ(probe->stats().count, 5u);
+}
+
+TEST(snapshot_has_header_and_valid_crc) {
+    reset_probes();
+    g_beta.record(42);
+    std::vector<std::uint8_t> buf(snapshot_size_max());
+    const std::size_t n = write_snapshot(ByteSpan{buf.data(), buf.size()}, 1234);
+    REQUIRE(n > 20);
+    CHECK(std::memcmp(buf.data(), kSnapshotMagic, 4) == 0);
+
+    ByteReader r(ConstByteSpan{buf.data() + 4, n - 4});
+    CHECK_EQ(r.u8(), kSnapshotVersion);
+    r.u8();
+    CHECK_EQ(r.u16(), probe_count());
+    CHECK_EQ(r.u32(), cycle_counter_hz());
+    CHECK_EQ(r.u32(), 1234u);
+
+    std::uint32_t stored;
+    std::memcpy(&stored, buf.data() + n - 4, 4);
+    CHECK_EQ(stored, crc32(buf.data(), n - 4));
+}
+
+TEST(snapshot_refuses_small_buffer) {
+    std::uint8_t small[16];
+    CHECK_EQ(write_snapshot(small, 0), 0u);
+}
@@ -0,0 +1,70 @@
+// Simulated board: virtual clock and in-memory GPIO state.
+#include <array>
+#include <atomic>
+
+#include "nucleo/platform/board.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/host/sim.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+struct SimBoard {
+    std::atomic<std::uint32_t> now_ms{0};
+    std::array<bool, kLedCount> leds{};
+    std::array<std::uint32_t, kLedCount> transitions{};
+    bool button = false;
+};
+
+SimBoard g_board;
+
+constexpr std::size_t index(Led led) { return static_cast<std::size_t>(led); }
+
+}  // namespace
+
+void clock_init() {}
+
+void system_init() {}
+
+std::uint32_t core_clock_hz() { return kCoreClockHz; }
+
+std::uint32_t millis() { return g_board.now_ms.load(std::memory_order_relaxed); }
+
+void delay_ms(std::uint32_t ms) { host::advance_ms(ms); }
+
+void board_init() {
+    g_board.leds.fill(false);
+}
+
+void led_write(Led led, bool on) {
+    bool& state = g_board.leds[index(led)];
+    if (state != on) {
+        ++g_board.transitions[index(led)];
+    }
+    state = on;
+}
+
+void led_toggle(Led led) { led_write(led, !g_board.leds[index(led)]); }
+
+bool user_button_pressed() { return g_board.button; }
+
+namespace host {
+
+void reset() {
+    g_board.now_ms.store(0, std::memory_order_relaxed);
+    g_board.leds.fill(false);
+    g_board.transitions.fill(0);
+    g_board.button = false;
+    reset_boot_phases();
+}
+
+void advance_ms(std::uint32_t ms) { g_board.now_ms.fetch_add(ms, std::memory_order_relaxed); }
+
+void set_user_button(bool pressed) { g_board.button = pressed; }
+
+bool led_state(Led led) { return g_board.leds[index(led)]; }
+
+std::uint32_t led_transitions(Led led) { return g_board.transitions[index(led)]; }
+
+}  // namespace host
+}  // namespace nucleo::platform
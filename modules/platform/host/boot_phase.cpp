@@ -0,0 +1,49 @@
+// Boot-phase marks in host builds: wall-clock time since host::reset().
+#include <chrono>
+
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/host/sim.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Clock::time_point g_reset_at = Clock::now();
+std::uint32_t g_us[kBootPhases];
+std::uint8_t g_reached = 0;
+
+}  // namespace
+
+void mark_boot_phase(BootPhase phase) {
+    const std::uint8_t bit = static_cast<std::uint8_t>(1u << static_cast<unsigned>(phase));
+    if ((g_reached & bit) == 0) {
+        g_us[static_cast<std::size_t>(phase)] = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_reset_at).count());
+        g_reached = static_cast<std::uint8_t>(g_reached | bit);
+    }
+}
+
+bool boot_phase_reached(BootPhase phase) { return (g_reached & (1u << static_cast<unsigned>(phase))) != 0; }
+
+std::uint32_t boot_phase_us(BootPhase phase) {
+    return boot_phase_reached(phase) ? g_us[static_cast<std::size_t>(phase)] : 0;
+}
+
+ResetCause reset_cause() { return ResetCause::supply; }
+
+namespace host {
+
+void reset_boot_phases() {
+    g_reset_at = Clock::now();
+    g_reached = 0;
+    // The simulated board has no start-up code: reset, clocks and memory are
+    // ready at once.
+    mark_boot_phase(BootPhase::reset);
+    mark_boot_phase(BootPhase::clocks_ready);
+    mark_boot_phase(BootPhase::memory_ready);
+    mark_boot_phase(BootPhase::constructors_done);
+}
+
+}  // namespace host
+}  // namespace nucleo::platform
@@ -0,0 +1,45 @@
+// Host interrupt model: one process-wide recursive lock.
+#include "nucleo/platform/irq.hpp"
+
+#include <mutex>
+#include <thread>
+
+#include "nucleo/platform/host/sim.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+std::recursive_mutex& irq_lock() {
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+thread_local int t_isr_depth = 0;
+
+}  // namespace
+
+std::uint32_t irq_save() {
+    irq_lock().lock();
+    return 0;
+}
+
+void irq_restore(std::uint32_t) { irq_lock().unlock(); }
+
+bool in_isr() { return t_isr_depth > 0; }
+
+void wait_for_interrupt() { std::this_thread::yield(); }
+
+namespace host {
+
+IsrScope::IsrScope() {
+    irq_lock().lock();
+    ++t_isr_depth;
+}
+
+IsrScope::~IsrScope() {
+    --t_isr_depth;
+    irq_lock().unlock();
+}
+
+}  // namespace host
+}  // namespace nucleo::platform
@@ -0,0 +1,25 @@
+// NUCLEO-H563ZI board I/O: user LEDs LD1..LD3 and the blue user button.
+#pragma once
+
+#include <cstdint>
+
+namespace nucleo::platform {
+
+enum class Led : std::uint8_t {
+    green,   ///< LD1, PB0
+    yellow,  ///< LD2, PF4
+    red,     ///< LD3, PG4
+};
+
+inline constexpr std::uint8_t kLedCount = 3;
+
+/// Configures the LED and button GPIOs. LEDs start off.
+void board_init();
+
+void led_write(Led led, bool on);
+void led_toggle(Led led);
+
+/// B1 on PC13, active high.
+bool user_button_pressed();
+
+}  // namespace nucleo::platform
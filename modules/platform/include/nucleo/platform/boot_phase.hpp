@@ -0,0 +1,86 @@
+// Boot-phase timestamps and the cause of the last reset.
+//
+// The reset handler starts the DWT cycle counter on its first instruction
+// and marks the phases it runs itself (clocks, .data/.bss, constructors);
+// the boot sequencer and the application mark the rest. Each phase is
+// stored once, as time since reset, so a unit that reboots after a
+// brown-out can report where its start-up time went:
+//
+//   reset -> clocks_ready -> memory_ready -> constructors_done
+//         -> critical_init_done -> first_cycle_done -> deferred_init_done
+//
+// On the target the counter runs at the 32 MHz reset clock until PLL1 is
+// selected and at HCLK after that; boot_phase_us() accounts for both. It
+// wraps 17 s after the switch, so later phases are not meaningful. On the
+// host, phases are measured from host::reset() in wall-clock time.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nucleo::platform {
+
+enum class BootPhase : std::uint8_t {
+    reset,
+    clocks_ready,
+    memory_ready,
+    constructors_done,
+    critical_init_done,
+    first_cycle_done,
+    deferred_init_done,
+};
+
+inline constexpr std::size_t kBootPhases = 7;
+
+enum class ResetCause : std::uint8_t {
+    unknown,
+    /// Power-on or brown-out: the supply fell below the BOR threshold.
+    supply,
+    pin,
+    software,
+    watchdog,
+    low_power,
+};
+
+/// Records that `phase` was reached now. Only the first mark counts.
+void mark_boot_phase(BootPhase phase);
+bool boot_phase_reached(BootPhase phase);
+/// Microseconds from reset to `phase`, or 0 if it was not reached.
+std::uint32_t boot_phase_us(BootPhase phase);
+
+/// Decoded from RCC_RSR by the reset handler, which then clears the flags.
+ResetCause reset_cause();
+
+#if NUCLEO_PLATFORM_STM32H5
+/// For the reset handler, once .bss is zeroed: the RCC_RSR value it read
+/// and the cycle count at which PLL1 took over. Marks reset, clocks_ready
+/// and memory_ready.
+void record_reset(std::uint32_t rsr, std::uint32_t clocks_ready_cycles);
+#endif
+
+constexpr const char* to_string(BootPhase phase) {
+    switch (phase) {
+    case BootPhase::reset: return "reset";
+    case BootPhase::clocks_ready: return "clocks_ready";
+    case BootPhase::memory_ready: return "memory_ready";
+    case BootPhase::constructors_done: return "constructors_done";
+    case BootPhase::critical_init_done: return "critical_init_done";
+    case BootPhase::first_cycle_done: return "first_cycle_done";
+    case BootPhase::deferred_init_done: return "deferred_init_done";
+    }
+    return "unknown";
+}
+
+constexpr const char* to_string(ResetCause cause) {
+    switch (cause) {
+    case ResetCause::unknown: return "unknown";
+    case ResetCause::supply: return "supply";
+    case ResetCause::pin: return "pin";
+    case ResetCause::software: return "software";
+    case ResetCause::watchdog: return "watchdog";
+    case ResetCause::low_power: return "low_power";
+    }
+    return "unknown";
+}
+
+}  // namespace nucleo::platform
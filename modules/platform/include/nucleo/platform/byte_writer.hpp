@@ -0,0 +1,130 @@
+// Bounds-checked little-endian / LEB128 writer and reader over byte spans,
+// shared by the binary wire formats (profiling snapshots, telemetry).
+//
+// Writes past the end set an overflow flag instead of failing each call, so
+// an encoder can emit a whole record and check ok() once at the end.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo {
+
+class ByteWriter {
+public:
+    explicit ByteWriter(ByteSpan out) : out_(out) {}
+
+    void u8(std::uint8_t v) {
+        if (pos_ < out_.size()) {
+            out_[pos_++] = v;
+        } else {
+            overflow_ = true;
+        }
+    }
+    void u16(std::uint16_t v) { le(v, 2); }
+    void u32(std::uint32_t v) { le(v, 4); }
+    void u64(std::uint64_t v) { le(v, 8); }
+
+    /// Unsigned LEB128: 7 bits per byte, high bit set on all but the last.
+    void varint(std::uint64_t v) {
+        while (v >= 0x80) {
+            u8(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        u8(static_cast<std::uint8_t>(v));
+    }
+
+    /// ZigZag-mapped signed LEB128, so small negative values stay short.
+    void svarint(std::int64_t v) {
+        varint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+    }
+
+    void bytes(const void* data, std::size_t size) {
+        if (pos_ + size <= out_.size()) {
+            std::memcpy(out_.data() + pos_, data, size);
+            pos_ += size;
+        } else {
+            overflow_ = true;
+        }
+    }
+
+    std::size_t size() const { return pos_; }
+    bool ok() const { return !overflow_; }
+    std::uint8_t* data() const { return out_.data(); }
+
+private:
+    void le(std::uint64_t v, int n) {
+        for (int i = 0; i < n; ++i) {
+            u8(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+    }
+
+    ByteSpan out_;
+    std::size_t pos_ = 0;
+    bool overflow_ = false;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(ConstByteSpan in) : in_(in) {}
+
+    std::uint8_t u8() {
+        if (pos_ < in_.size()) {
+            return in_[pos_++];
+        }
+        underflow_ = true;
+        return 0;
+    }
+    std::uint16_t u16() { return static_cast<std::uint16_t>(le(2)); }
+    std::uint32_t u32() { return static_cast<std::uint32_t>(le(4)); }
+    std::uint64_t u64() { return le(8); }
+
+    std::uint64_t varint() {
+        std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = u8();
+            v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return v;
+            }
+        }
+        underflow_ = true;  // over-long encoding
+        return 0;
+    }
+
+    std::int64_t svarint() {
+        const std::uint64_t v = varint();
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    bool bytes(void* out, std::size_t size) {
+        if (pos_ + size > in_.size()) {
+            underflow_ = true;
+            return false;
+        }
+        std::memcpy(out, in_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    std::size_t position() const { return pos_; }
+    std::size_t remaining() const { return in_.size() - pos_; }
+    bool ok() const { return !underflow_; }
+
+private:
+    std::uint64_t le(int n) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < n; ++i) {
+            v |= static_cast<std::uint64_t>(u8()) << (8 * i);
+        }
+        return v;
+    }
+
+    ConstByteSpan in_;
+    std::size_t pos_ = 0;
+    bool underflow_ = false;
+};
+
+}  // namespace nucleo
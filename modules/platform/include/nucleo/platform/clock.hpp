@@ -0,0 +1,29 @@
+// System clock tree and the millisecond tick.
+#pragma once
+
+#include <cstdint>
+
+namespace nucleo::platform {
+
+/// HCLK after system_init(): PLL1 from the 8 MHz ST-LINK MCO, 250 MHz.
+inline constexpr std::uint32_t kCoreClockHz = 250'000'000;
+
+/// Voltage scaling, flash wait states, PLL1 and the instruction cache,
+/// using no RAM variables. The reset handler calls it before .data and
+/// .bss are initialised, so the copy loops and constructors already run
+/// at 250 MHz from cache. Does nothing once PLL1 is the system clock.
+void clock_init();
+
+/// clock_init(), then a 1 kHz SysTick. Call first thing in main().
+void system_init();
+
+/// Current HCLK frequency in Hz.
+std::uint32_t core_clock_hz();
+
+/// Milliseconds since system_init(). Wraps after ~49 days.
+std::uint32_t millis();
+
+/// Busy-waits (target) or advances virtual time (host).
+void delay_ms(std::uint32_t ms);
+
+}  // namespace nucleo::platform
@@ -0,0 +1,32 @@
+// Compiler and placement attributes shared by firmware and host builds.
+#pragma once
+
+#define NUCLEO_ALWAYS_INLINE inline __attribute__((always_inline))
+#define NUCLEO_NOINLINE __attribute__((noinline))
+#define NUCLEO_USED __attribute__((used))
+#define NUCLEO_WEAK __attribute__((weak))
+#define NUCLEO_ALIGNED(n) __attribute__((aligned(n)))
+#define NUCLEO_LIKELY(x) __builtin_expect(!!(x), 1)
+#define NUCLEO_UNLIKELY(x) __builtin_expect(!!(x), 0)
+
+#if NUCLEO_PLATFORM_STM32H5
+/// Places an object or function in a named output section (see the linker script).
+#define NUCLEO_SECTION(name) __attribute__((section(name)))
+/// Runs a function from SRAM2 instead of flash: no flash wait states and no
+/// ICACHE misses. Only the marked function moves; anything it calls that is
+/// not inlined or marked too still runs from flash, through a veneer.
+/// Copied by the startup code; the layout budget checks where it landed.
+#define NUCLEO_RAMFUNC __attribute__((section(".ramfunc"), noinline, long_call))
+#else
+// Host objects keep the default sections; placement is a target-only concern.
+#define NUCLEO_SECTION(name)
+#define NUCLEO_RAMFUNC
+#endif
+
+/// Alignment that keeps producer- and consumer-owned fields of a lock-free
+/// structure apart: the DCACHE line on the target, the L1 line on x86-64.
+#if NUCLEO_PLATFORM_STM32H5
+#define NUCLEO_CACHE_LINE 32
+#else
+#define NUCLEO_CACHE_LINE 64
+#endif
@@ -0,0 +1,13 @@
+// CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320), the checksum used by the
+// binary wire formats in this tree. Table-driven, one byte per step.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nucleo {
+
+/// Continues a CRC over `size` bytes; start with crc = 0.
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+}  // namespace nucleo
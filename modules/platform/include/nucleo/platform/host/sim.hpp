@@ -0,0 +1,41 @@
+// Host-only controls for the simulated board. Not available on the target.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/board.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/platform/host/sim.hpp is only available in host builds"
+#endif
+
+namespace nucleo::platform::host {
+
+/// Restores power-on state: time zero, LEDs off, button released, boot
+/// phases restarted.
+void reset();
+
+/// Restarts the boot-phase clock and marks the phases the target's reset
+/// handler would have (up to constructors_done). Called by reset().
+void reset_boot_phases();
+
+/// Advances the virtual millisecond clock.
+void advance_ms(std::uint32_t ms);
+
+void set_user_button(bool pressed);
+bool led_state(Led led);
+
+/// Number of off->on and on->off transitions seen on an LED since reset().
+std::uint32_t led_transitions(Led led);
+
+/// Runs a simulated interrupt handler: holds the interrupt lock and makes
+/// in_isr() return true for the duration, as on the target.
+class IsrScope {
+public:
+    IsrScope();
+    ~IsrScope();
+    IsrScope(const IsrScope&) = delete;
+    IsrScope& operator=(const IsrScope&) = delete;
+};
+
+}  // namespace nucleo::platform::host
@@ -0,0 +1,56 @@
+// Interrupt masking.
+//
+// On the target a critical section is PRIMASK save/disable/restore. On the
+// host, simulated peripherals deliver their "interrupts" while holding the
+// same recursive lock that CriticalSection takes, which gives application
+// code the exclusion it would have on the MCU.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/compiler.hpp"
+
+namespace nucleo::platform {
+
+#if NUCLEO_PLATFORM_STM32H5
+
+NUCLEO_ALWAYS_INLINE std::uint32_t irq_save() {
+    std::uint32_t primask;
+    __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask)::"memory");
+    return primask;
+}
+
+NUCLEO_ALWAYS_INLINE void irq_restore(std::uint32_t state) {
+    __asm volatile("msr primask, %0" ::"r"(state) : "memory");
+}
+
+NUCLEO_ALWAYS_INLINE bool in_isr() {
+    std::uint32_t ipsr;
+    __asm volatile("mrs %0, ipsr" : "=r"(ipsr));
+    return ipsr != 0;
+}
+
+NUCLEO_ALWAYS_INLINE void wait_for_interrupt() { __asm volatile("wfi"); }
+
+#else
+
+std::uint32_t irq_save();
+void irq_restore(std::uint32_t state);
+bool in_isr();
+void wait_for_interrupt();
+
+#endif
+
+/// RAII interrupt lock. Nests.
+class CriticalSection {
+public:
+    CriticalSection() : state_(irq_save()) {}
+    ~CriticalSection() { irq_restore(state_); }
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+    std::uint32_t state_;
+};
+
+}  // namespace nucleo::platform
@@ -0,0 +1,58 @@
+// Non-owning view over a contiguous array (a subset of C++20 std::span).
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nucleo {
+
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    constexpr Span() = default;
+    constexpr Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) : data_(array), size_(N) {}
+
+    template <typename U, std::size_t N,
+              typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(std::array<U, N>& array) : data_(array.data()), size_(N) {}
+
+    template <typename U, std::size_t N,
+              typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr Span(const std::array<U, N>& array) : data_(array.data()), size_(N) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr std::size_t size_bytes() const { return size_ * sizeof(T); }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr T& operator[](std::size_t i) const { return data_[i]; }
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+    constexpr Span first(std::size_t count) const { return {data_, count}; }
+    constexpr Span last(std::size_t count) const { return {data_ + size_ - count, count}; }
+    constexpr Span subspan(std::size_t offset) const { return {data_ + offset, size_ - offset}; }
+    constexpr Span subspan(std::size_t offset, std::size_t count) const {
+        return {data_ + offset, count};
+    }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+using ByteSpan = Span<std::uint8_t>;
+using ConstByteSpan = Span<const std::uint8_t>;
+
+}  // namespace nucleo
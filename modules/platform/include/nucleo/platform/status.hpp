@@ -0,0 +1,38 @@
+// Result codes returned by drivers and services. The firmware is built
+// without exceptions, so fallible operations report one of these instead.
+#pragma once
+
+#include <cstdint>
+
+namespace nucleo {
+
+enum class Status : std::uint8_t {
+    ok = 0,
+    busy,
+    timeout,
+    overflow,
+    underflow,
+    no_memory,
+    invalid_argument,
+    not_found,
+    corrupt,
+    hardware_error,
+};
+
+constexpr const char* to_string(Status status) {
+    switch (status) {
+    case Status::ok: return "ok";
+    case Status::busy: return "busy";
+    case Status::timeout: return "timeout";
+    case Status::overflow: return "overflow";
+    case Status::underflow: return "underflow";
+    case Status::no_memory: return "no_memory";
+    case Status::invalid_argument: return "invalid_argument";
+    case Status::not_found: return "not_found";
+    case Status::corrupt: return "corrupt";
+    case Status::hardware_error: return "hardware_error";
+    }
+    return "unknown";
+}
+
+}  // namespace nucleo
@@ -0,0 +1,58 @@
+// NUCLEO-H563ZI LEDs and user button, register level.
+#include "stm32h5xx.h"
+
+#include "nucleo/platform/board.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+struct Pin {
+    GPIO_TypeDef* port;
+    std::uint32_t pin;
+};
+
+const Pin kLedPins[kLedCount] = {
+    {GPIOB, 0},  // LD1 green
+    {GPIOF, 4},  // LD2 yellow
+    {GPIOG, 4},  // LD3 red
+};
+
+const Pin kButtonPin{GPIOC, 13};
+
+void configure_output(const Pin& p) {
+    p.port->BSRR = 1u << (p.pin + 16);
+    p.port->MODER = (p.port->MODER & ~(3u << (p.pin * 2))) | (1u << (p.pin * 2));
+    p.port->OTYPER &= ~(1u << p.pin);
+    p.port->OSPEEDR &= ~(3u << (p.pin * 2));
+}
+
+void configure_input(const Pin& p) {
+    p.port->MODER &= ~(3u << (p.pin * 2));
+    p.port->PUPDR &= ~(3u << (p.pin * 2));  // external pull-down on the board
+}
+
+}  // namespace
+
+void board_init() {
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOBEN | RCC_AHB2ENR_GPIOCEN | RCC_AHB2ENR_GPIOFEN |
+                    RCC_AHB2ENR_GPIOGEN;
+    (void)RCC->AHB2ENR;
+    for (const Pin& p : kLedPins) {
+        configure_output(p);
+    }
+    configure_input(kButtonPin);
+}
+
+void led_write(Led led, bool on) {
+    const Pin& p = kLedPins[static_cast<std::size_t>(led)];
+    p.port->BSRR = on ? (1u << p.pin) : (1u << (p.pin + 16));
+}
+
+void led_toggle(Led led) {
+    const Pin& p = kLedPins[static_cast<std::size_t>(led)];
+    led_write(led, (p.port->ODR & (1u << p.pin)) == 0);
+}
+
+bool user_button_pressed() { return (kButtonPin.port->IDR & (1u << kButtonPin.pin)) != 0; }
+
+}  // namespace nucleo::platform
@@ -0,0 +1,72 @@
+// Boot-phase marks on the DWT cycle counter started by the reset handler.
+#include "stm32h5xx.h"
+
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+// HSI (64 MHz) divided by 2: SYSCLK from reset until PLL1 is selected.
+constexpr std::uint32_t kResetClockMHz = 32;
+
+std::uint32_t g_cycles[kBootPhases];
+std::uint8_t g_reached = 0;  // one bit per phase
+ResetCause g_cause = ResetCause::unknown;
+
+void mark(BootPhase phase, std::uint32_t cycles) {
+    const std::uint8_t bit = static_cast<std::uint8_t>(1u << static_cast<unsigned>(phase));
+    if ((g_reached & bit) == 0) {
+        g_cycles[static_cast<std::size_t>(phase)] = cycles;
+        g_reached = static_cast<std::uint8_t>(g_reached | bit);
+    }
+}
+
+ResetCause decode(std::uint32_t rsr) {
+    // A power-on sets BORRSTF and PINRSTF together; the BOR flag wins.
+    if ((rsr & RCC_RSR_BORRSTF) != 0) {
+        return ResetCause::supply;
+    }
+    if ((rsr & (RCC_RSR_IWDGRSTF | RCC_RSR_WWDGRSTF)) != 0) {
+        return ResetCause::watchdog;
+    }
+    if ((rsr & RCC_RSR_SFTRSTF) != 0) {
+        return ResetCause::software;
+    }
+    if ((rsr & RCC_RSR_LPWRRSTF) != 0) {
+        return ResetCause::low_power;
+    }
+    if ((rsr & RCC_RSR_PINRSTF) != 0) {
+        return ResetCause::pin;
+    }
+    return ResetCause::unknown;
+}
+
+}  // namespace
+
+void record_reset(std::uint32_t rsr, std::uint32_t clocks_ready_cycles) {
+    g_cause = decode(rsr);
+    mark(BootPhase::reset, 0);
+    mark(BootPhase::clocks_ready, clocks_ready_cycles);
+    mark(BootPhase::memory_ready, DWT->CYCCNT);
+}
+
+void mark_boot_phase(BootPhase phase) { mark(phase, DWT->CYCCNT); }
+
+bool boot_phase_reached(BootPhase phase) { return (g_reached & (1u << static_cast<unsigned>(phase))) != 0; }
+
+std::uint32_t boot_phase_us(BootPhase phase) {
+    if (!boot_phase_reached(phase)) {
+        return 0;
+    }
+    const std::uint32_t cycles = g_cycles[static_cast<std::size_t>(phase)];
+    if (phase <= BootPhase::clocks_ready || !boot_phase_reached(BootPhase::clocks_ready)) {
+        return cycles / kResetClockMHz;
+    }
+    const std::uint32_t switched = g_cycles[static_cast<std::size_t>(BootPhase::clocks_ready)];
+    return switched / kResetClockMHz + (cycles - switched) / (core_clock_hz() / 1'000'000);
+}
+
+ResetCause reset_cause() { return g_cause; }
+
+}  // namespace nucleo::platform
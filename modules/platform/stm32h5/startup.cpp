@@ -0,0 +1,166 @@
+// Vector table and reset handler for the STM32H563ZI.
+//
+// Device interrupts default to Default_Handler through weak aliases; a driver
+// takes over a vector simply by defining the CMSIS-named handler.
+//
+// The reset handler brings up PLL1 and the instruction cache before it
+// touches RAM, so copying .data and the NUCLEO_RAMFUNC code (into SRAM2),
+// zeroing .bss and running constructors happen at 250 MHz rather than at
+// the 32 MHz reset clock. Only functions marked NUCLEO_RAMFUNC are copied;
+// everything else executes in place from flash through the cache. Each step
+// is timestamped (nucleo/platform/boot_phase.hpp).
+#include <cstdint>
+
+#include "stm32h5xx.h"
+
+#include "nucleo/platform/boot_phase.hpp"
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/compiler.hpp"
+
+extern "C" {
+
+// Linker script symbols.
+extern const std::uint32_t _estack;
+extern const std::uint32_t _sidata;
+extern std::uint32_t _sdata;
+extern std::uint32_t _edata;
+extern const std::uint32_t _siramfunc;
+extern std::uint32_t _sramfunc;
+extern std::uint32_t _eramfunc;
+extern std::uint32_t _sbss;
+extern std::uint32_t _ebss;
+extern std::uint32_t _ssram2_bss;
+extern std::uint32_t _esram2_bss;
+extern std::uint32_t _ssram3_bss;
+extern std::uint32_t _esram3_bss;
+extern void (*__preinit_array_start[])();
+extern void (*__preinit_array_end[])();
+extern void (*__init_array_start[])();
+extern void (*__init_array_end[])();
+
+int main();
+
+void Reset_Handler();
+void Default_Handler();
+
+void NMI_Handler() __attribute__((weak, alias("Default_Handler")));
+void HardFault_Handler() __attribute__((weak, alias("Default_Handler")));
+void MemManage_Handler() __attribute__((weak, alias("Default_Handler")));
+void BusFault_Handler() __attribute__((weak, alias("Default_Handler")));
+void UsageFault_Handler() __attribute__((weak, alias("Default_Handler")));
+void SecureFault_Handler() __attribute__((weak, alias("Default_Handler")));
+void SVC_Handler() __attribute__((weak, alias("Default_Handler")));
+void DebugMon_Handler() __attribute__((weak, alias("Default_Handler")));
+void PendSV_Handler() __attribute__((weak, alias("Default_Handler")));
+void SysTick_Handler() __attribute__((weak, alias("Default_Handler")));
+
+void GPDMA1_Channel0_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void GPDMA1_Channel1_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void GPDMA1_Channel4_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void ADC1_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void USART3_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void ETH_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+void USB_DRD_FS_IRQHandler() __attribute__((weak, alias("Default_Handler")));
+
+}  // extern "C"
+
+namespace {
+
+void copy_words(const std::uint32_t* src, std::uint32_t* begin, std::uint32_t* end) {
+    for (std::uint32_t* dst = begin; dst < end;) {
+        *dst++ = *src++;
+    }
+}
+
+void zero_fill(std::uint32_t* begin, std::uint32_t* end) {
+    for (std::uint32_t* p = begin; p < end;) {
+        *p++ = 0;
+    }
+}
+
+using Handler = void (*)();
+
+// RM0481: the STM32H563 NVIC implements 131 device interrupt lines.
+constexpr std::size_t kIrqCount = 131;
+
+struct VectorTable {
+    const void* initial_sp;
+    Handler exceptions[15];
+    Handler irqs[kIrqCount];
+};
+
+constexpr VectorTable make_vector_table() {
+    VectorTable t{};
+    t.initial_sp = &_estack;
+    t.exceptions[0] = Reset_Handler;
+    t.exceptions[1] = NMI_Handler;
+    t.exceptions[2] = HardFault_Handler;
+    t.exceptions[3] = MemManage_Handler;
+    t.exceptions[4] = BusFault_Handler;
+    t.exceptions[5] = UsageFault_Handler;
+    t.exceptions[6] = SecureFault_Handler;
+    t.exceptions[10] = SVC_Handler;
+    t.exceptions[11] = DebugMon_Handler;
+    t.exceptions[13] = PendSV_Handler;
+    t.exceptions[14] = SysTick_Handler;
+    for (Handler& irq : t.irqs) {
+        irq = Default_Handler;
+    }
+    t.irqs[GPDMA1_Channel0_IRQn] = GPDMA1_Channel0_IRQHandler;
+    t.irqs[GPDMA1_Channel1_IRQn] = GPDMA1_Channel1_IRQHandler;
+    t.irqs[GPDMA1_Channel4_IRQn] = GPDMA1_Channel4_IRQHandler;
+    t.irqs[ADC1_IRQn] = ADC1_IRQHandler;
+    t.irqs[USART3_IRQn] = USART3_IRQHandler;
+    t.irqs[ETH_IRQn] = ETH_IRQHandler;
+    t.irqs[USB_DRD_FS_IRQn] = USB_DRD_FS_IRQHandler;
+    return t;
+}
+
+}  // namespace
+
+extern "C" NUCLEO_USED NUCLEO_SECTION(".isr_vector") const VectorTable g_vector_table =
+    make_vector_table();
+
+extern "C" void Reset_Handler() {
+    // Enable CP10/CP11 before any compiler-generated FPU instruction.
+    SCB->CPACR |= (3u << 20) | (3u << 22);
+    __DSB();
+    __ISB();
+
+    // Cycle counter from here on; perf::cycle_counter_init() keeps it running.
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // Read before anything can clear it; the flags survive until RMVF.
+    const std::uint32_t reset_flags = RCC->RSR;
+    RCC->RSR = RCC_RSR_RMVF;
+
+    nucleo::platform::clock_init();
+    const std::uint32_t clocks_ready = DWT->CYCCNT;
+
+    copy_words(&_sidata, &_sdata, &_edata);
+    copy_words(&_siramfunc, &_sramfunc, &_eramfunc);
+    zero_fill(&_sbss, &_ebss);
+    zero_fill(&_ssram2_bss, &_esram2_bss);
+    zero_fill(&_ssram3_bss, &_esram3_bss);
+    nucleo::platform::record_reset(reset_flags, clocks_ready);
+
+    for (auto fn = __preinit_array_start; fn < __preinit_array_end; ++fn) {
+        (*fn)();
+    }
+    for (auto fn = __init_array_start; fn < __init_array_end; ++fn) {
+        (*fn)();
+    }
+    nucleo::platform::mark_boot_phase(nucleo::platform::BootPhase::constructors_done);
+
+    main();
+    for (;;) {
+    }
+}
+
+extern "C" void Default_Handler() {
+    for (;;) {
+        __BKPT(0);
+    }
+}
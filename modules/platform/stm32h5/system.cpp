@@ -0,0 +1,107 @@
+// Clock tree, instruction cache and SysTick for the STM32H563ZI.
+#include "stm32h5xx.h"
+
+#include "nucleo/platform/clock.hpp"
+
+namespace nucleo::platform {
+namespace {
+
+// HSE is the 8 MHz MCO output of the on-board ST-LINK (bypass mode).
+// PLL1: 8 MHz / M4 = 2 MHz (range 1), x N250 = 500 MHz VCO, / P2 = 250 MHz.
+constexpr std::uint32_t kPllM = 4;
+constexpr std::uint32_t kPllN = 250;
+constexpr std::uint32_t kPllP = 2;
+constexpr std::uint32_t kPllQ = 10;
+constexpr std::uint32_t kPllR = 2;
+constexpr std::uint32_t kPllSrcHse = 3;
+constexpr std::uint32_t kPllRange2To4MHz = 1;
+constexpr std::uint32_t kFlashLatency = 5;
+constexpr std::uint32_t kFlashWrHighFreq = 2;
+constexpr std::uint32_t kSwPll1 = 3;
+
+constexpr std::uint32_t kResetClockHz = 32'000'000;  // HSI / 2 after reset
+
+volatile std::uint32_t g_millis = 0;
+
+bool pll1_selected() { return ((RCC->CFGR1 & RCC_CFGR1_SWS) >> RCC_CFGR1_SWS_Pos) == kSwPll1; }
+
+void enable_voltage_scale0() {
+    PWR->VOSCR = (PWR->VOSCR & ~PWR_VOSCR_VOS) | PWR_VOSCR_VOS;  // VOS0
+    while ((PWR->VOSSR & PWR_VOSSR_VOSRDY) == 0) {
+    }
+}
+
+void set_flash_latency() {
+    const std::uint32_t acr = (FLASH->ACR & ~(FLASH_ACR_LATENCY | FLASH_ACR_WRHIGHFREQ)) |
+                              (kFlashLatency << FLASH_ACR_LATENCY_Pos) |
+                              (kFlashWrHighFreq << FLASH_ACR_WRHIGHFREQ_Pos) | FLASH_ACR_PRFTEN;
+    FLASH->ACR = acr;
+    while ((FLASH->ACR & FLASH_ACR_LATENCY) != (kFlashLatency << FLASH_ACR_LATENCY_Pos)) {
+    }
+}
+
+void start_pll1() {
+    RCC->CR |= RCC_CR_HSEBYP | RCC_CR_HSEON;
+    while ((RCC->CR & RCC_CR_HSERDY) == 0) {
+    }
+
+    RCC->PLL1CFGR = (kPllSrcHse << RCC_PLL1CFGR_PLL1SRC_Pos) |
+                    (kPllRange2To4MHz << RCC_PLL1CFGR_PLL1RGE_Pos) |
+                    (kPllM << RCC_PLL1CFGR_PLL1M_Pos) | RCC_PLL1CFGR_PLL1PEN |
+                    RCC_PLL1CFGR_PLL1QEN;
+    RCC->PLL1DIVR = ((kPllN - 1) << RCC_PLL1DIVR_PLL1N_Pos) |
+                    ((kPllP - 1) << RCC_PLL1DIVR_PLL1P_Pos) |
+                    ((kPllQ - 1) << RCC_PLL1DIVR_PLL1Q_Pos) |
+                    ((kPllR - 1) << RCC_PLL1DIVR_PLL1R_Pos);
+    RCC->CR |= RCC_CR_PLL1ON;
+    while ((RCC->CR & RCC_CR_PLL1RDY) == 0) {
+    }
+
+    RCC->CFGR1 = (RCC->CFGR1 & ~RCC_CFGR1_SW) | (kSwPll1 << RCC_CFGR1_SW_Pos);
+    while (((RCC->CFGR1 & RCC_CFGR1_SWS) >> RCC_CFGR1_SWS_Pos) != kSwPll1) {
+    }
+}
+
+void enable_icache() {
+    if ((ICACHE->CR & ICACHE_CR_EN) != 0) {
+        return;
+    }
+    ICACHE->CR |= ICACHE_CR_CACHEINV;
+    while ((ICACHE->SR & ICACHE_SR_BUSYF) != 0) {
+    }
+    ICACHE->CR |= ICACHE_CR_EN;
+}
+
+}  // namespace
+
+void clock_init() {
+    // The cache goes on first: the PLL lock and voltage scaling waits below
+    // are short next to everything that runs from flash after them.
+    enable_icache();
+    if (pll1_selected()) {
+        return;
+    }
+    enable_voltage_scale0();
+    set_flash_latency();
+    start_pll1();
+}
+
+void system_init() {
+    clock_init();
+    SysTick_Config(kCoreClockHz / 1000);
+}
+
+std::uint32_t core_clock_hz() { return pll1_selected() ? kCoreClockHz : kResetClockHz; }
+
+std::uint32_t millis() { return g_millis; }
+
+void delay_ms(std::uint32_t ms) {
+    const std::uint32_t start = g_millis;
+    while (g_millis - start < ms) {
+        __WFI();
+    }
+}
+
+}  // namespace nucleo::platform
+
+extern "C" void SysTick_Handler() { nucleo::platform::g_millis = nucleo::platform::g_millis + 1; }
@@ -0,0 +1,101 @@
+// Dispatch overhead of the run-to-completion scheduler.
+//
+//  * post_dispatch: one post() and one dispatch of an empty handler, the
+//    full cost of a scheduler "context switch"
+//  * post_dispatch_no_clock: the same on the virtual clock, which isolates
+//    the three timestamp reads (steady_clock here, a DWT load on target)
+//  * direct_call: the same empty handler called through a function
+//    pointer, i.e. the floor
+//  * isr_post: post() under the simulated interrupt lock, as an ISR does
+//  * mixed_levels_x24: 24 posts spread over all priority levels, then one
+//    run(); exercises the ready mask and level selection
+//  * replay: events per second through the host trace replay
+//
+// Timing uses the real clock (perf::cycles()), not the virtual one.
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/sched/host/replay.hpp"
+#include "nucleo/sched/scheduler.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::sched;
+using testkit::now_ns;
+
+namespace {
+
+std::uint32_t g_sink = 0;
+
+void empty_handler(void* context, const Event& event) {
+    *static_cast<std::uint32_t*>(context) += event.param;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+
+    auto s = std::make_unique<Scheduler>();
+    TaskId tasks[kPriorities];
+    for (std::size_t p = 0; p < kPriorities; ++p) {
+        tasks[p] = s->add_task({"bench", empty_handler, &g_sink, static_cast<std::uint8_t>(p), 0});
+    }
+
+    bench.run("post_dispatch", 256, [&] {
+        s->post(tasks[0], 0, 1);
+        s->dispatch_one();
+    });
+
+    auto frozen = std::make_unique<Scheduler>(host::virtual_ticks);
+    const TaskId frozen_task = frozen->add_task({"bench", empty_handler, &g_sink, 0, 0});
+    bench.run("post_dispatch_no_clock", 256, [&] {
+        frozen->post(frozen_task, 0, 1);
+        frozen->dispatch_one();
+    });
+
+    Handler volatile direct = empty_handler;
+    const Event event{0, 1, 0, tasks[0]};
+    bench.run("direct_call", 256, [&] { direct(&g_sink, event); });
+
+    bench.run("isr_post", 16, [&] {
+        {
+            platform::host::IsrScope isr;
+            s->post(tasks[3], 0, 1);
+        }
+        s->dispatch_one();
+    });
+
+    constexpr std::size_t kBatch = 24;
+    bench.run("mixed_levels_x24", 16, [&] {
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            s->post(tasks[(i * 5) % kPriorities], 0, 1);
+        }
+        s->run();
+    });
+
+    // Replay throughput on a synthetic trace: 4 periodic tasks.
+    host::Trace trace;
+    trace.tick_hz = 1'000'000;
+    for (std::uint8_t p = 0; p < 4; ++p) {
+        trace.tasks.push_back({"periodic", static_cast<std::uint8_t>(p * 2), 1000});
+    }
+    const std::size_t events = bench.scale(200'000);
+    for (std::size_t i = 0; i < events; ++i) {
+        TraceRecord r;
+        r.posted = static_cast<std::uint32_t>(i * 25);
+        r.started = r.posted;
+        r.finished = r.posted + 5 + static_cast<std::uint32_t>(i % 4) * 3;
+        r.task = static_cast<TaskId>(i % 4);
+        trace.records.push_back(r);
+    }
+    const std::uint64_t start = now_ns();
+    const host::ReplayReport report = host::replay(trace);
+    const double seconds = static_cast<double>(now_ns() - start) * 1e-9;
+    bench.metric("replay_rate", static_cast<double>(report.events) / seconds / 1e6, "Mevents/s");
+
+    testkit::do_not_optimize(g_sink);
+    return 0;
+}
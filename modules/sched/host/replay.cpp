@@ -0,0 +1,150 @@
+#include "nucleo/sched/host/replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+
+namespace nucleo::sched::host {
+namespace {
+
+std::atomic<std::uint32_t> g_ticks{0};
+
+struct Replayer {
+    std::vector<std::uint32_t> costs;  // per replayed event, indexed by Event::param
+    std::uint64_t busy = 0;
+};
+
+void consume(void* context, const Event& event) {
+    Replayer& r = *static_cast<Replayer*>(context);
+    const std::uint32_t cost = r.costs[event.param];
+    r.busy += cost;
+    advance_virtual_ticks(cost);
+}
+
+}  // namespace
+
+std::uint32_t virtual_ticks() { return g_ticks.load(std::memory_order_relaxed); }
+
+void set_virtual_ticks(std::uint32_t ticks) { g_ticks.store(ticks, std::memory_order_relaxed); }
+
+void advance_virtual_ticks(std::uint32_t ticks) { g_ticks.fetch_add(ticks, std::memory_order_relaxed); }
+
+Status decode_trace(ConstByteSpan data, Trace& out) {
+    if (data.size() < 4) {
+        return Status::underflow;
+    }
+    const std::size_t body = data.size() - 4;
+    ByteReader crc_reader(data.subspan(body));
+    if (crc_reader.u32() != crc32(data.data(), body)) {
+        return Status::corrupt;
+    }
+
+    ByteReader r(data.first(body));
+    std::uint8_t magic[4] = {};
+    r.bytes(magic, sizeof magic);
+    if (!r.ok() || std::memcmp(magic, kTraceMagic, sizeof magic) != 0 || r.u8() != kTraceVersion) {
+        return Status::corrupt;
+    }
+    r.u8();
+    const std::uint16_t task_count = r.u16();
+    out.tick_hz = r.u32();
+    const std::uint32_t record_count = r.u32();
+    if (task_count > kMaxTasks) {
+        return Status::corrupt;  // no scheduler could have written it, nor can replay it
+    }
+
+    out.tasks.assign(task_count, {});
+    for (TraceTask& task : out.tasks) {
+        task.priority = r.u8();
+        task.deadline = static_cast<std::uint32_t>(r.varint());
+        task.name.resize(r.u8());
+        r.bytes(task.name.data(), task.name.size());
+        if (task.priority >= kPriorities) {
+            return Status::corrupt;
+        }
+    }
+
+    out.records.clear();
+    out.records.reserve(std::min<std::size_t>(record_count, r.remaining()));
+    std::uint32_t posted = 0;
+    for (std::uint32_t i = 0; i < record_count && r.ok(); ++i) {
+        TraceRecord rec;
+        rec.task = r.u8();
+        rec.signal = static_cast<std::uint16_t>(r.varint());
+        rec.param = static_cast<std::uint32_t>(r.varint());
+        posted += static_cast<std::uint32_t>(r.svarint());
+        rec.posted = posted;
+        rec.started = rec.posted + static_cast<std::uint32_t>(r.varint());
+        rec.finished = rec.started + static_cast<std::uint32_t>(r.varint());
+        if (rec.task >= task_count) {
+            return Status::corrupt;
+        }
+        out.records.push_back(rec);
+    }
+    if (!r.ok()) {
+        return Status::underflow;
+    }
+    return r.remaining() == 0 ? Status::ok : Status::corrupt;
+}
+
+ReplayReport replay(const Trace& trace, double cost_scale) {
+    ReplayReport report;
+    std::vector<TraceRecord> arrivals = trace.records;
+    std::stable_sort(arrivals.begin(), arrivals.end(), [](const TraceRecord& a, const TraceRecord& b) {
+        return static_cast<std::int32_t>(a.posted - b.posted) < 0;
+    });
+
+    Replayer replayer;
+    replayer.costs.reserve(arrivals.size());
+    for (const TraceRecord& rec : arrivals) {
+        const double cost = std::round(static_cast<double>(rec.finished - rec.started) * cost_scale);
+        replayer.costs.push_back(static_cast<std::uint32_t>(cost));
+    }
+
+    auto scheduler = std::make_unique<Scheduler>(virtual_ticks);
+    for (const TraceTask& task : trace.tasks) {
+        scheduler->add_task({task.name.c_str(), consume, &replayer, task.priority, task.deadline});
+    }
+
+    const std::uint32_t start = arrivals.empty() ? 0 : arrivals.front().posted;
+    set_virtual_ticks(start);
+    std::size_t next = 0;
+    while (next < arrivals.size() || !scheduler->idle()) {
+        // Everything that arrived while the last handler ran is queued
+        // before the next dispatch decision, as on the target.
+        while (next < arrivals.size() && static_cast<std::int32_t>(arrivals[next].posted - virtual_ticks()) <= 0) {
+            const TraceRecord& rec = arrivals[next];
+            Event event;
+            event.posted = rec.posted;
+            event.param = static_cast<std::uint32_t>(next);
+            event.signal = rec.signal;
+            event.task = rec.task;
+            if (scheduler->post(event) == Status::ok) {
+                ++report.events;
+            } else {
+                ++report.rejected;
+            }
+            ++next;
+        }
+        if (!scheduler->dispatch_one() && next < arrivals.size()) {
+            set_virtual_ticks(arrivals[next].posted);
+        }
+    }
+
+    report.duration = virtual_ticks() - start;
+    report.busy = replayer.busy;
+    for (std::size_t i = 0; i < scheduler->task_count(); ++i) {
+        report.tasks.push_back(scheduler->task_stats(static_cast<TaskId>(i)));
+    }
+    for (std::size_t p = 0; p < kPriorities; ++p) {
+        report.queues[p] = scheduler->queue_stats(p);
+    }
+    return report;
+}
+
+}  // namespace nucleo::sched::host
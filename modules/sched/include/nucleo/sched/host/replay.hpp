@@ -0,0 +1,68 @@
+// Host-only virtual clock and deterministic replay of recorded traces.
+//
+// A scheduler built with `Scheduler s(host::virtual_ticks);` sees time move
+// only when the test or replay advances it, so latency, execution time and
+// deadline statistics are exact and repeatable.
+//
+// replay() rebuilds the recorded task table with stub handlers that each
+// consume their recorded execution time, re-posts every event at its
+// recorded arrival tick and reports what the scheduler measured. Editing the
+// decoded Trace first (priorities, deadlines, execution times) answers
+// what-if questions without touching the target.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+#include "nucleo/sched/scheduler.hpp"
+#include "nucleo/sched/trace.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/sched/host/replay.hpp is only available in host builds"
+#endif
+
+namespace nucleo::sched::host {
+
+std::uint32_t virtual_ticks();
+void set_virtual_ticks(std::uint32_t ticks);
+void advance_virtual_ticks(std::uint32_t ticks);
+
+struct TraceTask {
+    std::string name;
+    std::uint8_t priority = 0;
+    std::uint32_t deadline = 0;
+};
+
+struct Trace {
+    std::uint32_t tick_hz = 0;
+    std::vector<TraceTask> tasks;
+    std::vector<TraceRecord> records;
+};
+
+/// Parses the output of write_trace(). corrupt on bad magic, version, CRC
+/// or task indices; underflow when truncated.
+Status decode_trace(ConstByteSpan data, Trace& out);
+
+struct ReplayReport {
+    std::vector<TaskStats> tasks;
+    std::array<QueueStats, kPriorities> queues{};
+    /// Events the scheduler accepted.
+    std::size_t events = 0;
+    /// Events post() refused because their priority queue was full; they
+    /// never ran (also in queues[].overflows).
+    std::size_t rejected = 0;
+    /// Ticks from the first arrival until the scheduler went idle.
+    std::uint32_t duration = 0;
+    /// Ticks spent in handlers; busy / duration is the CPU load.
+    std::uint64_t busy = 0;
+};
+
+/// Replays `trace` on a fresh scheduler driven by the virtual clock.
+/// Execution times are multiplied by `cost_scale`.
+ReplayReport replay(const Trace& trace, double cost_scale = 1.0);
+
+}  // namespace nucleo::sched::host
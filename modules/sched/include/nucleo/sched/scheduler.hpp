@@ -0,0 +1,142 @@
+// Cooperative run-to-completion scheduler.
+//
+// Work is expressed as small fixed-size events addressed to tasks. A task is
+// a handler function plus a priority; it has no stack of its own and runs to
+// completion on the caller's stack each time one of its events is
+// dispatched, so a "context switch" is one indirect call. Each priority level
+// has its own lock-free queue, and a ready bitmask finds the highest
+// non-empty level with one count-trailing-zeros.
+//
+//   sched::Scheduler s;
+//   const TaskId adc = s.add_task({"adc", on_adc_block, &filter, 0, 250'000});
+//   void ADC_IRQHandler() { s.post(adc, kBlockReady, half); }     // any context
+//   for (;;) { s.run(); platform::wait_for_interrupt(); }          // main loop
+//
+// post() is safe from interrupt handlers and other threads; dispatching is
+// done by a single context. Tasks must be added before events are posted.
+//
+// Every dispatch is timed with the scheduler's tick source (DWT cycles by
+// default): per task it keeps the queueing latency, execution time and the
+// number of events whose post-to-completion time exceeded the task's
+// deadline.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/memory/bounded_queue.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::sched {
+
+using TaskId = std::uint8_t;
+inline constexpr TaskId kNoTask = 0xFF;
+
+/// Priority levels; 0 is the most urgent.
+inline constexpr std::size_t kPriorities = 8;
+/// Events that can wait at one priority level.
+inline constexpr std::size_t kQueueDepth = 32;
+inline constexpr std::size_t kMaxTasks = 32;
+
+struct Event {
+    /// Tick at which the event was posted.
+    std::uint32_t posted = 0;
+    std::uint32_t param = 0;
+    std::uint16_t signal = 0;
+    TaskId task = kNoTask;
+};
+
+using Handler = void (*)(void* context, const Event& event);
+
+struct TaskConfig {
+    const char* name = "";
+    Handler handler = nullptr;
+    void* context = nullptr;
+    std::uint8_t priority = kPriorities - 1;
+    /// Longest acceptable post-to-completion time in ticks; 0 disables
+    /// deadline accounting.
+    std::uint32_t deadline = 0;
+};
+
+struct TaskStats {
+    std::uint32_t dispatched = 0;
+    std::uint32_t deadline_misses = 0;
+    /// Post to start of the handler.
+    std::uint32_t max_latency = 0;
+    std::uint32_t max_execution = 0;
+    std::uint64_t total_execution = 0;
+};
+
+struct QueueStats {
+    std::uint32_t posted = 0;
+    /// Posts rejected because the level's queue was full.
+    std::uint32_t overflows = 0;
+    std::uint32_t high_water = 0;
+};
+
+class TraceRecorder;
+
+class Scheduler {
+public:
+    using TickSource = std::uint32_t (*)();
+
+    /// `ticks` defaults to perf::cycles().
+    explicit Scheduler(TickSource ticks = nullptr);
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /// Registers a task. Returns kNoTask when the table is full or the
+    /// configuration is invalid. Not safe once events are flowing.
+    TaskId add_task(const TaskConfig& config);
+
+    /// Queues an event for `task`, stamped with the current tick. Safe from
+    /// any context. overflow if the task's priority level is full.
+    Status post(TaskId task, std::uint16_t signal, std::uint32_t param = 0);
+
+    /// Queues a prepared event, keeping its timestamp (forwarding, replay).
+    Status post(const Event& event);
+
+    /// Runs the handler of the oldest event at the most urgent non-empty
+    /// level. Returns false when nothing was pending.
+    bool dispatch_one();
+
+    /// Dispatches until idle or `budget` events have run. Returns the count.
+    std::size_t run(std::size_t budget = SIZE_MAX);
+
+    bool idle() const { return ready_.load(std::memory_order_relaxed) == 0; }
+    std::uint32_t now() const { return now_(); }
+
+    std::size_t task_count() const { return task_count_; }
+    const TaskConfig& task_config(TaskId task) const { return tasks_[task].config; }
+    const TaskStats& task_stats(TaskId task) const { return tasks_[task].stats; }
+    QueueStats queue_stats(std::size_t priority) const;
+    void reset_stats();
+
+    /// Every completed dispatch is appended to `recorder` (nullptr stops).
+    void set_recorder(TraceRecorder* recorder) { recorder_ = recorder; }
+
+private:
+    struct Task {
+        TaskConfig config;
+        TaskStats stats;
+    };
+
+    struct Level {
+        memory::BoundedQueue<Event, kQueueDepth> queue;
+        std::atomic<std::uint32_t> posted{0};
+        std::atomic<std::uint32_t> overflows{0};
+        std::atomic<std::uint32_t> high_water{0};
+    };
+
+    void execute(const Event& event);
+
+    TickSource now_;
+    Task tasks_[kMaxTasks];
+    std::size_t task_count_ = 0;
+    Level levels_[kPriorities];
+    std::atomic<std::uint32_t> ready_{0};
+    TraceRecorder* recorder_ = nullptr;
+};
+
+}  // namespace nucleo::sched
@@ -0,0 +1,77 @@
+// Recording of dispatched events for off-target replay.
+//
+// The recorder keeps one record per completed dispatch in caller-provided
+// storage and stops (counting drops) when it is full. write_trace()
+// serialises the task table and the records so the host can replay the
+// exact arrival pattern against a virtual clock (nucleo/sched/host/replay.hpp).
+//
+// Layout (little-endian, varint = unsigned LEB128, svarint = ZigZag):
+//
+//   "NSCH"  version:u8  reserved:u8  task_count:u16  tick_hz:u32  record_count:u32
+//   task_count x { priority:u8  deadline:varint  name_len:u8  name[name_len] }
+//   record_count x {
+//       task:u8  signal:varint  param:varint
+//       posted:svarint (delta from the previous record's posted)
+//       started - posted:varint  finished - started:varint
+//   }
+//   crc32:u32   (over everything before it)
+//
+// Records are in completion order, so posted times are not monotonic.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/sched/scheduler.hpp"
+
+namespace nucleo::sched {
+
+inline constexpr std::uint8_t kTraceMagic[4] = {'N', 'S', 'C', 'H'};
+inline constexpr std::uint8_t kTraceVersion = 1;
+
+struct TraceRecord {
+    std::uint32_t posted = 0;
+    std::uint32_t started = 0;
+    std::uint32_t finished = 0;
+    std::uint32_t param = 0;
+    std::uint16_t signal = 0;
+    TaskId task = kNoTask;
+};
+
+class TraceRecorder {
+public:
+    explicit TraceRecorder(Span<TraceRecord> storage) : storage_(storage) {}
+
+    /// Called by the dispatching context only.
+    void record(const TraceRecord& r) {
+        if (size_ < storage_.size()) {
+            storage_[size_++] = r;
+        } else {
+            ++dropped_;
+        }
+    }
+
+    Span<const TraceRecord> records() const { return {storage_.data(), size_}; }
+    std::size_t size() const { return size_; }
+    std::uint32_t dropped() const { return dropped_; }
+    void clear() {
+        size_ = 0;
+        dropped_ = 0;
+    }
+
+private:
+    Span<TraceRecord> storage_;
+    std::size_t size_ = 0;
+    std::uint32_t dropped_ = 0;
+};
+
+/// Worst-case size of write_trace() for this scheduler and record count.
+std::size_t trace_size_max(const Scheduler& scheduler, std::size_t records);
+
+/// Serialises the task table and `records`. Returns the number of bytes
+/// written, or 0 if `out` is too small.
+std::size_t write_trace(ByteSpan out, const Scheduler& scheduler, Span<const TraceRecord> records,
+                        std::uint32_t tick_hz);
+
+}  // namespace nucleo::sched
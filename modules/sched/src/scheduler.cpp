@@ -0,0 +1,131 @@
+#include "nucleo/sched/scheduler.hpp"
+
+#include "nucleo/perf/cycles.hpp"
+#include "nucleo/sched/trace.hpp"
+
+namespace nucleo::sched {
+namespace {
+
+std::uint32_t default_ticks() { return perf::cycles(); }
+
+void raise_to(std::atomic<std::uint32_t>& value, std::uint32_t candidate) {
+    std::uint32_t current = value.load(std::memory_order_relaxed);
+    while (candidate > current &&
+           !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+Scheduler::Scheduler(TickSource ticks) : now_(ticks != nullptr ? ticks : default_ticks) {}
+
+TaskId Scheduler::add_task(const TaskConfig& config) {
+    if (task_count_ == kMaxTasks || config.handler == nullptr || config.priority >= kPriorities) {
+        return kNoTask;
+    }
+    tasks_[task_count_] = {config, {}};
+    return static_cast<TaskId>(task_count_++);
+}
+
+Status Scheduler::post(TaskId task, std::uint16_t signal, std::uint32_t param) {
+    Event event;
+    event.posted = now_();
+    event.param = param;
+    event.signal = signal;
+    event.task = task;
+    return post(event);
+}
+
+Status Scheduler::post(const Event& event) {
+    if (event.task >= task_count_) {
+        return Status::invalid_argument;
+    }
+    const std::uint8_t priority = tasks_[event.task].config.priority;
+    Level& level = levels_[priority];
+    if (!level.queue.push(event)) {
+        level.overflows.fetch_add(1, std::memory_order_relaxed);
+        return Status::overflow;
+    }
+    // Publish after the push: a dispatcher that sees the bit finds the event.
+    ready_.fetch_or(1u << priority, std::memory_order_release);
+    level.posted.fetch_add(1, std::memory_order_relaxed);
+    raise_to(level.high_water, static_cast<std::uint32_t>(level.queue.size()));
+    return Status::ok;
+}
+
+bool Scheduler::dispatch_one() {
+    for (;;) {
+        const std::uint32_t ready = ready_.load(std::memory_order_acquire);
+        if (ready == 0) {
+            return false;
+        }
+        const unsigned priority = static_cast<unsigned>(__builtin_ctz(ready));
+        Level& level = levels_[priority];
+        Event event;
+        if (level.queue.pop(event)) {
+            execute(event);
+            return true;
+        }
+        // Level drained. A post may land between the failed pop and the
+        // clear, so look again before leaving the bit cleared.
+        ready_.fetch_and(~(1u << priority), std::memory_order_acq_rel);
+        if (!level.queue.empty()) {
+            ready_.fetch_or(1u << priority, std::memory_order_release);
+        }
+    }
+}
+
+std::size_t Scheduler::run(std::size_t budget) {
+    std::size_t count = 0;
+    while (count < budget && dispatch_one()) {
+        ++count;
+    }
+    return count;
+}
+
+void Scheduler::execute(const Event& event) {
+    Task& task = tasks_[event.task];
+    const std::uint32_t started = now_();
+    task.config.handler(task.config.context, event);
+    const std::uint32_t finished = now_();
+
+    TaskStats& s = task.stats;
+    const std::uint32_t latency = started - event.posted;
+    const std::uint32_t execution = finished - started;
+    ++s.dispatched;
+    s.total_execution += execution;
+    if (latency > s.max_latency) {
+        s.max_latency = latency;
+    }
+    if (execution > s.max_execution) {
+        s.max_execution = execution;
+    }
+    if (task.config.deadline != 0 && finished - event.posted > task.config.deadline) {
+        ++s.deadline_misses;
+    }
+    if (recorder_ != nullptr) {
+        recorder_->record({event.posted, started, finished, event.param, event.signal, event.task});
+    }
+}
+
+QueueStats Scheduler::queue_stats(std::size_t priority) const {
+    const Level& level = levels_[priority];
+    QueueStats s;
+    s.posted = level.posted.load(std::memory_order_relaxed);
+    s.overflows = level.overflows.load(std::memory_order_relaxed);
+    s.high_water = level.high_water.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Scheduler::reset_stats() {
+    for (std::size_t i = 0; i < task_count_; ++i) {
+        tasks_[i].stats = {};
+    }
+    for (Level& level : levels_) {
+        level.posted.store(0, std::memory_order_relaxed);
+        level.overflows.store(0, std::memory_order_relaxed);
+        level.high_water.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace nucleo::sched
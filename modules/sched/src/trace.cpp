@@ -0,0 +1,68 @@
+#include "nucleo/sched/trace.hpp"
+
+#include <cstring>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+
+namespace nucleo::sched {
+namespace {
+
+constexpr std::size_t kHeaderSize = 4 + 1 + 1 + 2 + 4 + 4;
+constexpr std::size_t kMaxVarint32 = 5;
+constexpr std::size_t kMaxName = 255;
+constexpr std::size_t kMaxRecord = 1 + 5 * kMaxVarint32;
+
+std::uint8_t name_length(const char* name) {
+    const std::size_t n = std::strlen(name);
+    return static_cast<std::uint8_t>(n < kMaxName ? n : kMaxName);
+}
+
+}  // namespace
+
+std::size_t trace_size_max(const Scheduler& scheduler, std::size_t records) {
+    std::size_t size = kHeaderSize + 4 + records * kMaxRecord;
+    for (std::size_t i = 0; i < scheduler.task_count(); ++i) {
+        size += 1 + kMaxVarint32 + 1 + name_length(scheduler.task_config(static_cast<TaskId>(i)).name);
+    }
+    return size;
+}
+
+std::size_t write_trace(ByteSpan out, const Scheduler& scheduler, Span<const TraceRecord> records,
+                        std::uint32_t tick_hz) {
+    ByteWriter w(out);
+    w.bytes(kTraceMagic, sizeof kTraceMagic);
+    w.u8(kTraceVersion);
+    w.u8(0);
+    w.u16(static_cast<std::uint16_t>(scheduler.task_count()));
+    w.u32(tick_hz);
+    w.u32(static_cast<std::uint32_t>(records.size()));
+
+    for (std::size_t i = 0; i < scheduler.task_count(); ++i) {
+        const TaskConfig& task = scheduler.task_config(static_cast<TaskId>(i));
+        const std::uint8_t len = name_length(task.name);
+        w.u8(task.priority);
+        w.varint(task.deadline);
+        w.u8(len);
+        w.bytes(task.name, len);
+    }
+
+    std::uint32_t previous = 0;
+    for (const TraceRecord& r : records) {
+        w.u8(r.task);
+        w.varint(r.signal);
+        w.varint(r.param);
+        w.svarint(static_cast<std::int32_t>(r.posted - previous));
+        w.varint(r.started - r.posted);
+        w.varint(r.finished - r.started);
+        previous = r.posted;
+    }
+
+    if (!w.ok()) {
+        return 0;
+    }
+    w.u32(crc32(w.data(), w.size()));
+    return w.ok() ? w.size() : 0;
+}
+
+}  // namespace nucleo::sched
@@ -0,0 +1,197 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/sched/host/replay.hpp"
+#include "nucleo/sched/scheduler.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::sched;
+
+namespace {
+
+struct Log {
+    std::vector<std::uint32_t> params;
+    std::uint32_t cost = 0;  // virtual ticks each handler consumes
+};
+
+void log_event(void* context, const Event& event) {
+    Log& log = *static_cast<Log*>(context);
+    log.params.push_back(event.param);
+    host::advance_virtual_ticks(log.cost);
+}
+
+std::unique_ptr<Scheduler> make_scheduler() {
+    host::set_virtual_ticks(0);
+    return std::make_unique<Scheduler>(host::virtual_ticks);
+}
+
+}  // namespace
+
+TEST(most_urgent_level_runs_first_and_levels_are_fifo) {
+    auto s = make_scheduler();
+    Log log;
+    const TaskId low = s->add_task({"low", log_event, &log, 5, 0});
+    const TaskId high = s->add_task({"high", log_event, &log, 1, 0});
+    REQUIRE_EQ(s->post(low, 0, 10), Status::ok);
+    REQUIRE_EQ(s->post(low, 0, 11), Status::ok);
+    REQUIRE_EQ(s->post(high, 0, 20), Status::ok);
+    REQUIRE_EQ(s->post(high, 0, 21), Status::ok);
+    CHECK(!s->idle());
+    CHECK_EQ(s->run(), 4u);
+    CHECK(s->idle());
+    CHECK((log.params == std::vector<std::uint32_t>{20, 21, 10, 11}));
+    CHECK(!s->dispatch_one());
+}
+
+TEST(events_posted_by_a_handler_run_after_it_completes) {
+    auto s = make_scheduler();
+    struct Chain {
+        Scheduler* s;
+        TaskId self;
+        std::vector<std::uint32_t> order;
+    } chain{s.get(), kNoTask, {}};
+    chain.self = s->add_task({"chain",
+                              [](void* ctx, const Event& e) {
+                                  Chain& c = *static_cast<Chain*>(ctx);
+                                  c.order.push_back(e.param);
+                                  if (e.param < 3) {
+                                      c.s->post(c.self, 0, e.param + 1);
+                                  }
+                                  c.order.push_back(100 + e.param);
+                              },
+                              &chain, 0, 0});
+    s->post(chain.self, 0, 0);
+    CHECK_EQ(s->run(), 4u);
+    CHECK((chain.order == std::vector<std::uint32_t>{0, 100, 1, 101, 2, 102, 3, 103}));
+}
+
+TEST(run_honours_its_budget) {
+    auto s = make_scheduler();
+    Log log;
+    const TaskId t = s->add_task({"t", log_event, &log, 0, 0});
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        s->post(t, 0, i);
+    }
+    CHECK_EQ(s->run(2), 2u);
+    CHECK_EQ(log.params.size(), 2u);
+    CHECK_EQ(s->run(), 3u);
+}
+
+TEST(rejects_bad_tasks_and_counts_overflow) {
+    auto s = make_scheduler();
+    Log log;
+    CHECK_EQ(s->add_task({"no handler", nullptr, nullptr, 0, 0}), kNoTask);
+    CHECK_EQ(s->add_task({"bad priority", log_event, &log, kPriorities, 0}), kNoTask);
+    const TaskId t = s->add_task({"t", log_event, &log, 3, 0});
+    CHECK_EQ(s->post(static_cast<TaskId>(t + 1), 0), Status::invalid_argument);
+
+    for (std::size_t i = 0; i < kQueueDepth; ++i) {
+        REQUIRE_EQ(s->post(t, 0), Status::ok);
+    }
+    CHECK_EQ(s->post(t, 0), Status::overflow);
+    const QueueStats q = s->queue_stats(3);
+    CHECK_EQ(q.posted, kQueueDepth);
+    CHECK_EQ(q.overflows, 1u);
+    CHECK_EQ(q.high_water, kQueueDepth);
+
+    for (std::size_t i = 0; i < kMaxTasks - 1; ++i) {
+        CHECK(s->add_task({"filler", log_event, &log, 7, 0}) != kNoTask);
+    }
+    CHECK_EQ(s->add_task({"one too many", log_event, &log, 7, 0}), kNoTask);
+}
+
+TEST(latency_execution_and_deadline_misses_on_the_virtual_clock) {
+    auto s = make_scheduler();
+    Log fast{{}, 10};
+    Log slow{{}, 300};
+    const TaskId urgent = s->add_task({"urgent", log_event, &fast, 0, 100});
+    const TaskId bulk = s->add_task({"bulk", log_event, &slow, 4, 1000});
+
+    s->post(bulk, 0);   // t=0, runs 0..300
+    s->run(1);
+    s->post(urgent, 0);  // t=300, runs at once: 300..310
+    s->run();
+    host::set_virtual_ticks(400);
+    s->post(bulk, 0);    // t=400
+    s->post(urgent, 0);  // t=400, dispatched first: 400..410
+    s->run();            // then bulk 410..710
+    CHECK_EQ(s->task_stats(urgent).dispatched, 2u);
+    CHECK_EQ(s->task_stats(urgent).deadline_misses, 0u);
+    CHECK_EQ(s->task_stats(bulk).max_latency, 10u);
+    CHECK_EQ(s->task_stats(bulk).max_execution, 300u);
+    CHECK_EQ(s->task_stats(bulk).total_execution, 600u);
+
+    // An urgent event stuck behind a bulk handler misses its deadline: run
+    // to completion means no preemption.
+    s->post(bulk, 0);  // 710..1010
+    s->run(1);
+    Event late;  // arrived while bulk was running
+    late.posted = 750;
+    late.task = urgent;
+    s->post(late);
+    s->run();  // 1010..1020: 270 ticks after arrival
+    CHECK_EQ(s->task_stats(urgent).deadline_misses, 1u);
+    CHECK_EQ(s->task_stats(urgent).max_latency, 260u);
+
+    s->reset_stats();
+    CHECK_EQ(s->task_stats(urgent).dispatched, 0u);
+    CHECK_EQ(s->queue_stats(0).posted, 0u);
+}
+
+TEST(isr_and_thread_producers_deliver_everything_once) {
+    auto s = make_scheduler();
+    constexpr std::uint32_t kPerProducer = 20000;
+    constexpr int kProducers = 3;
+    struct Sink {
+        std::vector<std::uint32_t> next = std::vector<std::uint32_t>(kProducers, 0);
+        bool ordered = true;
+        std::uint32_t received = 0;
+    } sink;
+    const Handler count = [](void* ctx, const Event& e) {
+        Sink& k = *static_cast<Sink*>(ctx);
+        const std::uint32_t producer = e.param >> 24;
+        k.ordered = k.ordered && (e.param & 0xFFFFFF) == k.next[producer];
+        ++k.next[producer];
+        ++k.received;
+    };
+    TaskId tasks[kProducers];
+    for (int p = 0; p < kProducers; ++p) {
+        tasks[p] = s->add_task({"producer", count, &sink, static_cast<std::uint8_t>(p), 0});
+    }
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < kPerProducer; ++i) {
+                const std::uint32_t param = static_cast<std::uint32_t>(p) << 24 | i;
+                for (;;) {
+                    Status st;
+                    if (p == 0) {
+                        platform::host::IsrScope isr;  // one producer posts "from interrupts"
+                        st = s->post(tasks[p], 0, param);
+                    } else {
+                        st = s->post(tasks[p], 0, param);
+                    }
+                    if (st == Status::ok) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    while (sink.received < kPerProducer * kProducers) {
+        if (s->run() == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    CHECK(sink.ordered);
+    CHECK(s->idle());
+    CHECK_EQ(s->task_stats(tasks[1]).dispatched, kPerProducer);
+}
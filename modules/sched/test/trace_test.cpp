@@ -0,0 +1,209 @@
+#include <memory>
+#include <vector>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+#include "nucleo/sched/host/replay.hpp"
+#include "nucleo/sched/scheduler.hpp"
+#include "nucleo/sched/trace.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::sched;
+
+namespace {
+
+struct Costs {
+    std::uint32_t ticks;
+};
+
+void busy(void* context, const Event&) { host::advance_virtual_ticks(static_cast<Costs*>(context)->ticks); }
+
+// A control task every 1000 ticks and bursts of slower logging work, run
+// live on the virtual clock with a recorder attached.
+struct Recording {
+    Costs control{120};
+    Costs logging{700};
+    std::unique_ptr<Scheduler> s = std::make_unique<Scheduler>(host::virtual_ticks);
+    std::vector<TraceRecord> storage = std::vector<TraceRecord>(256);
+    TraceRecorder recorder{{storage.data(), storage.size()}};
+    TaskId control_task = s->add_task({"control", busy, &control, 0, 500});
+    TaskId logging_task = s->add_task({"logging", busy, &logging, 6, 5000});
+
+    Recording() {
+        host::set_virtual_ticks(0);
+        s->set_recorder(&recorder);
+        for (std::uint32_t t = 0; t < 20'000; t += 50) {
+            // Arrivals are posted at their tick; handlers may overrun into
+            // later slots, which is what the replay has to reproduce.
+            while (static_cast<std::int32_t>(host::virtual_ticks() - t) < 0) {
+                if (!s->dispatch_one()) {
+                    host::set_virtual_ticks(t);
+                }
+            }
+            Event e;
+            e.posted = t;
+            if (t % 1000 == 0) {
+                e.task = control_task;
+                e.signal = 1;
+                e.param = t / 1000;
+                s->post(e);
+            }
+            if (t % 3000 == 150) {
+                e.task = logging_task;
+                e.signal = 2;
+                s->post(e);
+                s->post(e);
+            }
+        }
+        s->run();
+    }
+};
+
+std::vector<std::uint8_t> encode(const Recording& r) {
+    std::vector<std::uint8_t> out(trace_size_max(*r.s, r.recorder.size()));
+    const std::size_t n = write_trace({out.data(), out.size()}, *r.s, r.recorder.records(), 1'000'000);
+    out.resize(n);
+    return out;
+}
+
+}  // namespace
+
+TEST(trace_round_trips) {
+    Recording r;
+    CHECK(r.recorder.size() > 0);
+    CHECK_EQ(r.recorder.dropped(), 0u);
+    const auto bytes = encode(r);
+    REQUIRE(!bytes.empty());
+
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace({bytes.data(), bytes.size()}, trace), Status::ok);
+    CHECK_EQ(trace.tick_hz, 1'000'000u);
+    REQUIRE_EQ(trace.tasks.size(), 2u);
+    CHECK(trace.tasks[0].name == "control");
+    CHECK_EQ(trace.tasks[0].deadline, 500u);
+    CHECK_EQ(trace.tasks[1].priority, 6);
+    REQUIRE_EQ(trace.records.size(), r.recorder.size());
+    for (std::size_t i = 0; i < trace.records.size(); ++i) {
+        const TraceRecord& a = trace.records[i];
+        const TraceRecord& b = r.recorder.records()[i];
+        CHECK(a.posted == b.posted && a.started == b.started && a.finished == b.finished &&
+              a.param == b.param && a.signal == b.signal && a.task == b.task);
+    }
+}
+
+TEST(decoder_rejects_damage) {
+    Recording r;
+    auto bytes = encode(r);
+    host::Trace trace;
+    bytes[bytes.size() / 2] ^= 0x40;
+    CHECK_EQ(host::decode_trace({bytes.data(), bytes.size()}, trace), Status::corrupt);
+    CHECK_EQ(host::decode_trace({bytes.data(), 3}, trace), Status::underflow);
+}
+
+TEST(decoder_rejects_more_tasks_than_a_scheduler_holds) {
+    // Well formed apart from the task count: no scheduler could have
+    // written it, and replay could not post events for the extra tasks.
+    const auto write = [](std::size_t tasks) {
+        std::vector<std::uint8_t> out(1024);
+        ByteWriter w({out.data(), out.size()});
+        w.bytes(kTraceMagic, sizeof kTraceMagic);
+        w.u8(kTraceVersion);
+        w.u8(0);
+        w.u16(static_cast<std::uint16_t>(tasks));
+        w.u32(1'000'000);
+        w.u32(1);
+        for (std::size_t t = 0; t < tasks; ++t) {
+            w.u8(0);
+            w.varint(0);
+            w.u8(1);
+            w.u8('t');
+        }
+        w.u8(static_cast<std::uint8_t>(tasks - 1));
+        w.varint(1);
+        w.varint(0);
+        w.svarint(10);
+        w.varint(1);
+        w.varint(5);
+        w.u32(crc32(out.data(), w.size()));
+        out.resize(w.size());
+        return out;
+    };
+    host::Trace trace;
+    const auto fits = write(kMaxTasks);
+    CHECK_EQ(host::decode_trace({fits.data(), fits.size()}, trace), Status::ok);
+    const auto too_many = write(kMaxTasks + 1);
+    CHECK_EQ(host::decode_trace({too_many.data(), too_many.size()}, trace), Status::corrupt);
+}
+
+TEST(recorder_counts_drops_and_writer_checks_space) {
+    Recording r;
+    TraceRecord small[2];
+    TraceRecorder recorder(small);
+    for (int i = 0; i < 5; ++i) {
+        recorder.record({});
+    }
+    CHECK_EQ(recorder.size(), 2u);
+    CHECK_EQ(recorder.dropped(), 3u);
+    std::uint8_t tiny[16];
+    CHECK_EQ(write_trace(tiny, *r.s, r.recorder.records(), 1), 0u);
+}
+
+TEST(replay_reproduces_live_statistics) {
+    Recording r;
+    const auto bytes = encode(r);
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace({bytes.data(), bytes.size()}, trace), Status::ok);
+
+    const host::ReplayReport report = host::replay(trace);
+    CHECK_EQ(report.events, r.recorder.size());
+    CHECK_EQ(report.rejected, 0u);
+    for (TaskId t : {r.control_task, r.logging_task}) {
+        const TaskStats& live = r.s->task_stats(t);
+        const TaskStats& replayed = report.tasks[t];
+        CHECK_EQ(replayed.dispatched, live.dispatched);
+        CHECK_EQ(replayed.max_latency, live.max_latency);
+        CHECK_EQ(replayed.total_execution, live.total_execution);
+        CHECK_EQ(replayed.deadline_misses, live.deadline_misses);
+    }
+    // Logging bursts (2 x 700) delay the control task past its deadline
+    // whenever they start just before a control slot.
+    CHECK(report.tasks[r.control_task].deadline_misses > 0);
+    CHECK(report.busy > 0 && report.busy < report.duration);
+}
+
+TEST(replay_answers_what_if) {
+    Recording r;
+    const auto bytes = encode(r);
+    host::Trace trace;
+    REQUIRE_EQ(host::decode_trace({bytes.data(), bytes.size()}, trace), Status::ok);
+
+    // Halving every execution time removes the control misses.
+    const host::ReplayReport faster = host::replay(trace, 0.5);
+    CHECK_EQ(faster.tasks[r.control_task].deadline_misses, 0u);
+    // Deterministic: the same trace gives the same answer.
+    const host::ReplayReport a = host::replay(trace);
+    const host::ReplayReport b = host::replay(trace);
+    CHECK_EQ(a.duration, b.duration);
+    CHECK_EQ(a.tasks[0].max_latency, b.tasks[0].max_latency);
+}
+
+TEST(replay_counts_events_a_full_queue_rejects) {
+    // A burst larger than one priority queue, all arriving at once.
+    host::Trace trace;
+    trace.tick_hz = 1'000'000;
+    trace.tasks.push_back({"burst", 3, 0});
+    for (std::uint32_t i = 0; i < kQueueDepth + 8; ++i) {
+        TraceRecord rec;
+        rec.posted = 100;
+        rec.started = 100 + 10 * i;
+        rec.finished = rec.started + 10;
+        rec.task = 0;
+        trace.records.push_back(rec);
+    }
+    const host::ReplayReport report = host::replay(trace);
+    CHECK_EQ(report.events, kQueueDepth);
+    CHECK_EQ(report.rejected, 8u);
+    CHECK_EQ(report.queues[3].overflows, 8u);
+    CHECK_EQ(report.tasks[0].dispatched, kQueueDepth);
+}
@@ -0,0 +1,120 @@
+// Log store costs on the simulated bank 2 (8 KB sectors, datasheet timings).
+//
+//  * put_stage: put() of a 64-byte value into the staging buffer, host time
+//  * write_throughput: sustained 64-byte puts with service() in the loop,
+//    in flash (virtual) time, erases and reclaiming included
+//  * write_amplification: flash bytes per payload byte over that run
+//  * mount_summaries / mount_full_walk: boot scan of a full region, bytes
+//    read and virtual time, with sector summaries and with a record walk
+//  * put_latency_background / put_latency_blocking: the longest a caller
+//    is held per put when erases run in the background (put + service) and
+//    when every put is made durable before returning (put + sync)
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "nucleo/storage/host/sim_flash.hpp"
+#include "nucleo/storage/log_store.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::storage;
+using host::SimFlash;
+
+namespace {
+
+using Store = StaticLogStore<256, 2048>;
+constexpr Key kKeys = 48;
+constexpr std::size_t kValueSize = 64;
+
+void fill_value(std::uint8_t* v, std::uint32_t n) {
+    for (std::size_t i = 0; i < kValueSize; ++i) {
+        v[i] = static_cast<std::uint8_t>(n + i);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    std::uint8_t value[kValueSize];
+
+    {
+        SimFlash flash;
+        Store store(flash);
+        store.mount();
+        std::uint32_t n = 0;
+        bench.run("put_stage", 8, [&] {
+            fill_value(value, n);
+            if (store.put(static_cast<Key>(n++ % kKeys), value) != Status::ok) {
+                store.sync();
+            }
+        });
+    }
+
+    SimFlash flash;
+    Store store(flash);
+    store.mount();
+    const std::size_t puts = bench.scale(200'000) < 5000 ? 5000 : bench.scale(200'000);
+    const double start_us = flash.now_us();
+    for (std::uint32_t n = 0; n < puts; ++n) {
+        fill_value(value, n);
+        while (store.put(static_cast<Key>(n % kKeys), value) == Status::no_memory) {
+            store.sync();
+        }
+        store.service();
+        flash.advance_us(20);  // the rest of the main loop
+    }
+    store.sync();
+    const double elapsed_s = (flash.now_us() - start_us - 20.0 * static_cast<double>(puts)) * 1e-6;
+    const StoreStats stats = store.stats();
+    bench.metric("write_throughput", static_cast<double>(stats.user_bytes) / elapsed_s / 1024.0, "KB/s");
+    bench.metric("write_amplification", stats.write_amplification(), "x");
+    bench.metric("sectors_erased", stats.sectors_erased, "sectors");
+    bench.metric("erase_spread", store.max_erase_count() - store.min_erase_count(), "erases");
+
+    // Boot scan of the region just written: 31 sealed sectors and a head.
+    for (const bool summaries : {true, false}) {
+        StoreConfig config;
+        config.use_summaries = summaries;
+        Store scanner(flash, config);
+        const double before_us = flash.now_us();
+        const std::uint64_t start_ns = testkit::now_ns();
+        scanner.mount();
+        const double host_us = static_cast<double>(testkit::now_ns() - start_ns) * 1e-3;
+        const char* name = summaries ? "mount_summaries" : "mount_full_walk";
+        char label[64];
+        std::snprintf(label, sizeof label, "%s_bytes", name);
+        bench.metric(label, scanner.stats().mount_bytes_read, "B");
+        std::snprintf(label, sizeof label, "%s_flash_time", name);
+        bench.metric(label, flash.now_us() - before_us, "us");
+        std::snprintf(label, sizeof label, "%s_host_time", name);
+        bench.metric(label, host_us, "us");
+    }
+
+    // Worst caller-visible latency per put, in flash time.
+    for (const bool blocking : {false, true}) {
+        SimFlash lat_flash;
+        Store lat(lat_flash);
+        lat.mount();
+        std::vector<double> samples;
+        const std::size_t n_puts = bench.quick() ? 3000 : 20000;
+        for (std::uint32_t n = 0; n < n_puts; ++n) {
+            fill_value(value, n);
+            const double t0 = lat_flash.now_us();
+            if (lat.put(static_cast<Key>(n % kKeys), value) != Status::ok) {
+                lat.sync();
+                lat.put(static_cast<Key>(n % kKeys), value);
+            }
+            if (blocking) {
+                lat.sync();
+            } else {
+                lat.service();
+            }
+            samples.push_back(lat_flash.now_us() - t0);
+            lat_flash.advance_us(200);
+        }
+        bench.report(blocking ? "put_latency_blocking" : "put_latency_background", testkit::summarize(samples), "us");
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "nucleo/storage/host/sim_flash.hpp"
+
+#include <cstring>
+
+namespace nucleo::storage {
+namespace host {
+
+SimFlash::SimFlash(FlashGeometry geometry, FlashTiming timing) : geometry_(geometry), timing_(timing) { reset(); }
+
+void SimFlash::reset() {
+    data_.assign(geometry_.size(), 0xFF);
+    cells_.assign(geometry_.size() / kQuadWord, Cell::erased);
+    erase_counts_.assign(geometry_.sector_count, 0);
+    now_us_ = stall_us_ = erase_done_us_ = 0;
+    erasing_ = UINT32_MAX;
+    cut_countdown_ = 0;
+    powered_ = true;
+    bytes_read_ = programmed_ = 0;
+}
+
+void SimFlash::load(std::uint32_t offset, ConstByteSpan data) {
+    std::memcpy(data_.data() + offset, data.data(), data.size());
+    for (std::size_t qw = offset / kQuadWord; qw < (offset + data.size() + kQuadWord - 1) / kQuadWord; ++qw) {
+        cells_[qw] = Cell::programmed;
+    }
+}
+
+void SimFlash::settle() {
+    if (erasing_ == UINT32_MAX || now_us_ < erase_done_us_) {
+        return;
+    }
+    const std::size_t first = static_cast<std::size_t>(erasing_) * geometry_.sector_size;
+    std::memset(data_.data() + first, 0xFF, geometry_.sector_size);
+    for (std::size_t qw = first / kQuadWord; qw < (first + geometry_.sector_size) / kQuadWord; ++qw) {
+        cells_[qw] = Cell::erased;
+    }
+    ++erase_counts_[erasing_];
+    erasing_ = UINT32_MAX;
+}
+
+std::uint32_t SimFlash::next_random() {
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    return rng_;
+}
+
+void SimFlash::tear(std::size_t qw) {
+    for (std::size_t i = 0; i < kQuadWord; ++i) {
+        data_[qw * kQuadWord + i] = static_cast<std::uint8_t>(next_random());
+    }
+    cells_[qw] = Cell::torn;
+}
+
+Status SimFlash::read(std::uint32_t offset, ByteSpan out) {
+    if (!powered_) {
+        return Status::hardware_error;
+    }
+    if (offset > geometry_.size() || out.size() > geometry_.size() - offset) {
+        return Status::invalid_argument;
+    }
+    if (erasing_ != UINT32_MAX && now_us_ < erase_done_us_) {
+        stall_us_ += erase_done_us_ - now_us_;
+        now_us_ = erase_done_us_;
+    }
+    settle();
+    bytes_read_ += out.size();
+    now_us_ += static_cast<double>(out.size()) * timing_.read_ns_per_byte / 1000.0;
+    if (out.empty()) {
+        return Status::ok;
+    }
+    for (std::size_t qw = offset / kQuadWord; qw <= (offset + out.size() - 1) / kQuadWord; ++qw) {
+        if (cells_[qw] == Cell::torn) {
+            return Status::corrupt;
+        }
+    }
+    std::memcpy(out.data(), data_.data() + offset, out.size());
+    return Status::ok;
+}
+
+Status SimFlash::program(std::uint32_t offset, ConstByteSpan data) {
+    if (!powered_) {
+        return Status::hardware_error;
+    }
+    if (offset % kQuadWord != 0 || data.size() % kQuadWord != 0 || offset > geometry_.size() ||
+        data.size() > geometry_.size() - offset) {
+        return Status::invalid_argument;
+    }
+    if (busy()) {
+        return Status::busy;
+    }
+    for (std::size_t i = 0; i < data.size(); i += kQuadWord) {
+        const std::size_t qw = (offset + i) / kQuadWord;
+        if (cut_countdown_ != 0 && --cut_countdown_ == 0) {
+            tear(qw);
+            powered_ = false;
+            return Status::hardware_error;
+        }
+        if (cells_[qw] != Cell::erased) {
+            return Status::hardware_error;  // PGSERR: target not erased
+        }
+        std::memcpy(data_.data() + qw * kQuadWord, data.data() + i, kQuadWord);
+        cells_[qw] = Cell::programmed;
+        now_us_ += timing_.program_us;
+        ++programmed_;
+    }
+    return Status::ok;
+}
+
+Status SimFlash::start_erase(std::uint32_t sector) {
+    if (!powered_) {
+        return Status::hardware_error;
+    }
+    if (sector >= geometry_.sector_count) {
+        return Status::invalid_argument;
+    }
+    if (busy()) {
+        return Status::busy;
+    }
+    erasing_ = sector;
+    erase_done_us_ = now_us_ + timing_.erase_us;
+    return Status::ok;
+}
+
+bool SimFlash::busy() {
+    settle();
+    return powered_ && erasing_ != UINT32_MAX;
+}
+
+Status SimFlash::wait() {
+    if (!powered_) {
+        return Status::hardware_error;
+    }
+    if (erasing_ != UINT32_MAX && now_us_ < erase_done_us_) {
+        stall_us_ += erase_done_us_ - now_us_;
+        now_us_ = erase_done_us_;
+    }
+    settle();
+    return Status::ok;
+}
+
+void SimFlash::cut_power_after(std::uint32_t programs) { cut_countdown_ = programs; }
+
+void SimFlash::cut_power_now() {
+    settle();
+    if (erasing_ != UINT32_MAX) {
+        const std::size_t first = static_cast<std::size_t>(erasing_) * geometry_.sector_size / kQuadWord;
+        for (std::size_t qw = first; qw < first + geometry_.sector_size / kQuadWord; ++qw) {
+            if (next_random() & 1) {
+                tear(qw);
+            } else {
+                std::memset(data_.data() + qw * kQuadWord, 0xFF, kQuadWord);
+                cells_[qw] = Cell::erased;
+            }
+        }
+        erasing_ = UINT32_MAX;
+    }
+    powered_ = false;
+}
+
+void SimFlash::power_cycle() {
+    powered_ = true;
+    cut_countdown_ = 0;
+}
+
+SimFlash& storage_flash_sim() {
+    static SimFlash sim;
+    return sim;
+}
+
+}  // namespace host
+
+FlashDevice& storage_flash() { return host::storage_flash_sim(); }
+
+}  // namespace nucleo::storage
@@ -0,0 +1,17 @@
+// The storage region: the top 256 KB of flash bank 2.
+#pragma once
+
+#include "nucleo/storage/flash.hpp"
+
+namespace nucleo::storage {
+
+/// Sectors 96..127 of bank 2 (0x081C0000, 32 x 8 KB). The firmware image
+/// runs from bank 1, so erases here never stall instruction fetches.
+inline constexpr std::uint32_t kStorageBase = 0x081C0000;
+inline constexpr FlashGeometry kStorageGeometry{8 * 1024, 32};
+
+/// The bank 2 driver on the target; the SimFlash returned by
+/// host::storage_flash_sim() on the host.
+FlashDevice& storage_flash();
+
+}  // namespace nucleo::storage
@@ -0,0 +1,51 @@
+// Raw flash access for the storage layer.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::storage {
+
+/// Programming unit of the STM32H5 flash: 128 bits with 9 bits of ECC. A
+/// quad-word can be programmed once between erases.
+inline constexpr std::size_t kQuadWord = 16;
+
+struct FlashGeometry {
+    std::uint32_t sector_size = 0;
+    std::uint32_t sector_count = 0;
+
+    std::uint32_t size() const { return sector_size * sector_count; }
+};
+
+/// A region of whole sectors, addressed from 0. Implemented over bank 2 of
+/// the internal flash on the target and by SimFlash on the host.
+class FlashDevice {
+public:
+    virtual FlashGeometry geometry() const = 0;
+
+    /// Copies flash contents. corrupt if the range covers a quad-word that
+    /// fails its ECC check (torn by a power cut).
+    virtual Status read(std::uint32_t offset, ByteSpan out) = 0;
+
+    /// Programs whole, previously erased quad-words at a quad-word aligned
+    /// offset, blocking for the programming time. busy while an erase is
+    /// running; hardware_error if a target quad-word was not erased.
+    virtual Status program(std::uint32_t offset, ConstByteSpan data) = 0;
+
+    /// Starts erasing a sector and returns at once; the region is busy()
+    /// until it finishes. Code keeps running from the other bank meanwhile.
+    virtual Status start_erase(std::uint32_t sector) = 0;
+
+    virtual bool busy() = 0;
+
+    /// Blocks until the erase in progress, if any, has finished.
+    virtual Status wait() = 0;
+
+protected:
+    ~FlashDevice() = default;
+};
+
+}  // namespace nucleo::storage
@@ -0,0 +1,93 @@
+// RAM-backed flash with STM32H5 programming rules, virtual time and power-cut
+// injection (host only).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "nucleo/storage/board_flash.hpp"
+#include "nucleo/storage/flash.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/storage/host/sim_flash.hpp is only available in host builds"
+#endif
+
+namespace nucleo::storage::host {
+
+/// Datasheet-order timings of the H563 bank 2 (DS14258, typical values).
+struct FlashTiming {
+    double program_us = 16;   ///< per quad-word
+    double erase_us = 2000;   ///< per 8 KB sector
+    double read_ns_per_byte = 0.2;
+};
+
+/// Each quad-word is erased, programmed, or torn (interrupted by a power
+/// cut: unreadable until erased). Time is virtual: programs advance it,
+/// erases run while the caller advances it (advance_us(), or wait(),
+/// which counts the gap as stall time), so results are exact and
+/// repeatable.
+class SimFlash final : public FlashDevice {
+public:
+    explicit SimFlash(FlashGeometry geometry = kStorageGeometry, FlashTiming timing = {});
+
+    FlashGeometry geometry() const override { return geometry_; }
+    /// Reading during an erase stalls until it finishes, as on the bank.
+    Status read(std::uint32_t offset, ByteSpan out) override;
+    Status program(std::uint32_t offset, ConstByteSpan data) override;
+    Status start_erase(std::uint32_t sector) override;
+    bool busy() override;
+    Status wait() override;
+
+    /// Erases everything, clears counters and restores power.
+    void reset();
+    /// Writes raw bytes regardless of state, as a foreign image would.
+    void load(std::uint32_t offset, ConstByteSpan data);
+
+    double now_us() const { return now_us_; }
+    void advance_us(double us) { now_us_ += us; }
+
+    /// Power fails during the `programs`-th quad-word program from now: that
+    /// quad-word is torn and the device goes dead (every call then fails
+    /// with hardware_error) until power_cycle().
+    void cut_power_after(std::uint32_t programs);
+    /// Power fails now. An erase in progress leaves every quad-word of its
+    /// sector either erased or torn.
+    void cut_power_now();
+    void power_cycle();
+    bool powered() const { return powered_; }
+    void seed(std::uint32_t seed) { rng_ = seed != 0 ? seed : 1; }
+
+    std::uint32_t erase_count(std::uint32_t sector) const { return erase_counts_[sector]; }
+    std::uint64_t bytes_read() const { return bytes_read_; }
+    std::uint64_t quad_words_programmed() const { return programmed_; }
+    /// Time spent blocked in wait() and stalled reads.
+    double stall_us() const { return stall_us_; }
+
+private:
+    enum class Cell : std::uint8_t { erased, programmed, torn };
+
+    void settle();
+    void tear(std::size_t qw);
+    std::uint32_t next_random();
+
+    FlashGeometry geometry_;
+    FlashTiming timing_;
+    std::vector<std::uint8_t> data_;
+    std::vector<Cell> cells_;
+    std::vector<std::uint32_t> erase_counts_;
+    double now_us_ = 0;
+    double stall_us_ = 0;
+    double erase_done_us_ = 0;
+    std::uint32_t erasing_ = UINT32_MAX;
+    std::uint32_t cut_countdown_ = 0;
+    bool powered_ = true;
+    std::uint32_t rng_ = 0x2545F491;
+    std::uint64_t bytes_read_ = 0;
+    std::uint64_t programmed_ = 0;
+};
+
+/// The simulated storage region, same object as storage_flash() in host
+/// builds.
+SimFlash& storage_flash_sim();
+
+}  // namespace nucleo::storage::host
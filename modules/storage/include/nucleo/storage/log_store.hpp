@@ -0,0 +1,227 @@
+// Append-only, power-fail-safe log and key-value store on raw flash.
+//
+// Everything is a record appended at the head of the newest sector: values,
+// deletions (tombstones) and log entries. A record is a header quad-word
+// (kind, key, length, payload CRC, header CRC) followed by the payload
+// padded to quad-words, and is programmed header first. A power cut can
+// therefore leave at most one damaged record, at the end of the head: a
+// torn header is skipped one quad-word at a time, and a value whose
+// payload fails its CRC is ignored, so the previous value stays current.
+//
+// Sector layout (quad-word granular):
+//
+//   [0]   erase stamp: erase count, written right after each erase
+//   [1]   open stamp: sequence number, written when the sector is opened
+//   [2..] records
+//   ...   summary: (key, kind, offset) of every record, written on seal
+//   [-1]  footer: locates the summary and carries its CRC
+//
+// Mounting reads the stamps of every sector, and the footer and summary of
+// sealed ones; only the head is walked record by record. A RAM index maps
+// each key to its newest record.
+//
+// Sectors are reused oldest first: when fewer than `reserve_sectors` erased
+// sectors remain, the oldest sector's live values are copied to the head a
+// few per service() call and the sector is erased in the background. New
+// sectors are taken lowest erase count first, so wear stays even. Log
+// entries and tombstones are dropped when their sector is reclaimed.
+//
+// put()/remove()/append_log() only encode the record into a RAM staging
+// buffer, so callers never wait for the flash. service(), called from the
+// main loop, programs staged records while no erase is running. A record is
+// durable once pending_bytes() is back to 0; sync() gets there blocking.
+// Reads of the region stall while bank 2 erases (the bank has no
+// read-while-erase); code and data in bank 1 and SRAM are unaffected.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+#include "nucleo/storage/flash.hpp"
+
+namespace nucleo::storage {
+
+using Key = std::uint16_t;
+/// Not a valid key: marks empty index slots.
+inline constexpr Key kNoKey = 0xFFFF;
+inline constexpr std::size_t kMaxPayload = 496;
+inline constexpr std::size_t kMaxSectors = 128;
+
+struct IndexEntry {
+    Key key = kNoKey;
+    /// Record size in bytes, header included.
+    std::uint16_t size = 0;
+    /// Flash offset of the record.
+    std::uint32_t location = 0;
+};
+
+struct StoreConfig {
+    /// Erased sectors kept in hand; reclaiming starts below this.
+    std::size_t reserve_sectors = 2;
+    /// Live records copied per service() call while reclaiming.
+    std::size_t copy_budget = 8;
+    /// Trust sector summaries at mount. false walks every record, which
+    /// also verifies every header (slower; for diagnostics and benches).
+    bool use_summaries = true;
+};
+
+struct StoreStats {
+    std::uint64_t user_bytes = 0;        ///< payload bytes accepted
+    std::uint64_t flash_bytes = 0;       ///< bytes programmed, all overheads included
+    std::uint64_t copied_bytes = 0;      ///< programmed again by reclaiming
+    std::uint32_t records_written = 0;
+    std::uint32_t sectors_erased = 0;
+    std::uint32_t log_records_dropped = 0;
+    std::uint32_t staging_rejects = 0;   ///< calls refused: staging buffer full
+    std::uint32_t staging_high_water = 0;
+    std::uint32_t flash_errors = 0;
+    // Last mount.
+    std::uint32_t mount_bytes_read = 0;
+    std::uint32_t mount_sectors_summarized = 0;
+    std::uint32_t mount_sectors_walked = 0;
+
+    /// Bytes programmed per payload byte accepted.
+    double write_amplification() const {
+        return user_bytes != 0 ? static_cast<double>(flash_bytes) / static_cast<double>(user_bytes) : 0.0;
+    }
+};
+
+class LogStore {
+public:
+    /// `index` holds one entry per distinct key (a power of two, at least
+    /// twice the keys in use keeps probing short). `staging` buffers
+    /// records until they are programmed.
+    LogStore(FlashDevice& flash, Span<IndexEntry> index, ByteSpan staging, const StoreConfig& config = {});
+    LogStore(const LogStore&) = delete;
+    LogStore& operator=(const LogStore&) = delete;
+
+    /// Scans the region and rebuilds the index. A blank or foreign region
+    /// mounts empty; unreadable sectors are queued for erase.
+    Status mount();
+
+    /// Stores a value. no_memory if the live data would not fit the region
+    /// or the staging buffer is full (call service() and retry).
+    Status put(Key key, ConstByteSpan value);
+
+    /// Copies the newest value into `out`; `size` receives its length.
+    /// not_found, overflow if `out` is too small, corrupt on a CRC error.
+    Status get(Key key, ByteSpan out, std::size_t& size);
+
+    bool contains(Key key) const;
+    Status remove(Key key);
+
+    /// Appends a log entry. Entries are kept oldest first, as space allows.
+    Status append_log(ConstByteSpan entry);
+
+    /// Calls fn(ConstByteSpan) for every surviving log entry, oldest first.
+    template <typename Fn>
+    Status for_each_log(Fn&& fn) {
+        return visit_log(
+            [](void* ctx, ConstByteSpan entry) { (*static_cast<Fn*>(ctx))(entry); }, &fn);
+    }
+
+    /// Programs staged records, advances reclaiming and starts erases. Never
+    /// waits for an erase. Call from the main loop.
+    Status service();
+
+    /// Blocks until every staged record is on flash.
+    Status sync();
+
+    std::size_t pending_bytes() const { return staged_end_ - staged_begin_; }
+    std::size_t key_count() const { return key_count_; }
+    std::size_t free_sectors() const;
+    /// Bytes of live values, and the most the region can hold.
+    std::size_t live_bytes() const { return live_bytes_; }
+    std::size_t capacity_bytes() const;
+    StoreStats stats() const { return stats_; }
+    std::uint32_t min_erase_count() const;
+    std::uint32_t max_erase_count() const;
+
+private:
+    enum class SectorState : std::uint8_t { blank, free, used, dirty, erasing };
+    enum class Step : std::uint8_t { record, end, closed };
+
+    struct Sector {
+        SectorState state = SectorState::blank;
+        std::uint32_t seq = 0;
+        std::uint32_t erase_count = 0;
+    };
+
+    struct RecordInfo;
+    using LogVisitor = void (*)(void* context, ConstByteSpan entry);
+
+    Status visit_log(LogVisitor visitor, void* context);
+    Status stage(std::uint8_t kind, Key key, ConstByteSpan payload);
+    bool find_staged(Key key, RecordInfo& record, const std::uint8_t*& payload) const;
+
+    IndexEntry* find(Key key);
+    const IndexEntry* find(Key key) const;
+    bool index_put(Key key, std::uint32_t size, std::uint32_t location);
+    void index_remove(Key key);
+    bool apply(std::uint8_t kind, Key key, std::uint32_t location, std::uint32_t size);
+
+    Status mount_sector(std::uint32_t sector, bool newest);
+    Status apply_summary(std::uint32_t sector, std::uint32_t where, std::uint32_t crc);
+    Step next_record(std::uint32_t base, std::uint32_t& pos, RecordInfo& record);
+    bool payload_ok(const RecordInfo& record);
+    bool verify_erased(std::uint32_t sector);
+    std::size_t sectors_by_age(std::uint8_t* order) const;
+
+    Status flush();
+    Status ensure_room(std::uint32_t size, bool for_copy);
+    Status open_sector();
+    Status seal_head();
+    std::uint32_t summary_size(std::uint32_t records) const;
+    Status write_record(const std::uint8_t* record, std::uint32_t size, std::uint32_t& location);
+    Status advance_reclaim();
+    Status start_erase(std::uint32_t sector);
+    Status finish_erase();
+    Status read(std::uint32_t offset, ByteSpan out);
+    Status program(std::uint32_t offset, ConstByteSpan data);
+
+    FlashDevice& flash_;
+    Span<IndexEntry> index_;
+    ByteSpan staging_;
+    StoreConfig config_;
+    FlashGeometry geometry_{};
+    Sector sectors_[kMaxSectors];
+    bool mounted_ = false;
+
+    std::uint32_t head_ = UINT32_MAX;  // sector taking appends
+    std::uint32_t head_pos_ = 0;
+    std::uint32_t head_records_ = 0;
+    std::uint32_t head_checked_ = 0;  // records below this came from the mount walk
+    std::uint32_t next_seq_ = 1;
+
+    std::uint32_t reclaim_ = UINT32_MAX;  // sector being emptied
+    std::uint32_t reclaim_pos_ = 0;
+    std::uint32_t erasing_ = UINT32_MAX;
+
+    std::size_t staged_begin_ = 0;
+    std::size_t staged_end_ = 0;
+    std::size_t staged_values_ = 0;
+    std::size_t key_count_ = 0;
+    std::size_t live_bytes_ = 0;
+    std::uint64_t bytes_read_ = 0;
+    StoreStats stats_;
+    std::uint8_t scratch_[kMaxPayload + kQuadWord];
+};
+
+/// A LogStore with its index and staging buffer inline.
+template <std::size_t IndexSlots, std::size_t StagingBytes = 2048>
+class StaticLogStore : public LogStore {
+    static_assert((IndexSlots & (IndexSlots - 1)) == 0, "index size must be a power of two");
+    static_assert(StagingBytes % kQuadWord == 0, "staging holds whole quad-words");
+
+public:
+    explicit StaticLogStore(FlashDevice& flash, const StoreConfig& config = {})
+        : LogStore(flash, index_storage_, staging_storage_, config) {}
+
+private:
+    IndexEntry index_storage_[IndexSlots];
+    alignas(kQuadWord) std::uint8_t staging_storage_[StagingBytes];
+};
+
+}  // namespace nucleo::storage
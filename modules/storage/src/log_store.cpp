@@ -0,0 +1,932 @@
+#include "nucleo/storage/log_store.hpp"
+
+#include <cstring>
+
+#include "nucleo/platform/crc32.hpp"
+
+namespace nucleo::storage {
+namespace {
+
+constexpr std::uint32_t kEraseMagic = 0x45534C4E;  // "NLSE"
+constexpr std::uint32_t kOpenMagic = 0x4F534C4E;   // "NLSO"
+constexpr std::uint32_t kSealMagic = 0x53534C4E;   // "NLSS"
+constexpr std::uint8_t kRecordMarker = 0xA5;
+
+// Record kinds. Summary entries use the first three in two bits; 0 marks a
+// value whose payload was found damaged.
+constexpr std::uint8_t kDamaged = 0;
+constexpr std::uint8_t kValue = 1;
+constexpr std::uint8_t kTombstone = 2;
+constexpr std::uint8_t kLog = 3;
+constexpr std::uint8_t kSummary = 4;
+
+constexpr std::uint32_t kQw = kQuadWord;
+constexpr std::uint32_t kFirstRecord = 2 * kQw;
+constexpr std::uint32_t kNone = UINT32_MAX;
+constexpr std::uint32_t kEntryBytes = 4;
+
+constexpr std::uint32_t pad(std::uint32_t n) { return (n + kQw - 1) & ~(kQw - 1); }
+constexpr std::uint32_t record_size(std::uint32_t length) { return kQw + pad(length); }
+
+void put_u16(std::uint8_t* p, std::uint32_t v) {
+    p[0] = static_cast<std::uint8_t>(v);
+    p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void put_u32(std::uint8_t* p, std::uint32_t v) {
+    put_u16(p, v);
+    put_u16(p + 2, v >> 16);
+}
+
+std::uint16_t get_u16(const std::uint8_t* p) { return static_cast<std::uint16_t>(p[0] | p[1] << 8); }
+
+std::uint32_t get_u32(const std::uint8_t* p) {
+    return get_u16(p) | static_cast<std::uint32_t>(get_u16(p + 2)) << 16;
+}
+
+bool erased(const std::uint8_t* p, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (p[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stamps and the footer: magic, two words, CRC of the first twelve bytes.
+void encode_stamp(std::uint8_t* qw, std::uint32_t magic, std::uint32_t a, std::uint32_t b) {
+    put_u32(qw, magic);
+    put_u32(qw + 4, a);
+    put_u32(qw + 8, b);
+    put_u32(qw + 12, crc32(qw, 12));
+}
+
+bool decode_stamp(const std::uint8_t* qw, std::uint32_t magic, std::uint32_t& a, std::uint32_t& b) {
+    if (get_u32(qw) != magic || get_u32(qw + 12) != crc32(qw, 12)) {
+        return false;
+    }
+    a = get_u32(qw + 4);
+    b = get_u32(qw + 8);
+    return true;
+}
+
+void encode_header(std::uint8_t* qw, std::uint8_t kind, Key key, std::uint32_t length, std::uint32_t payload_crc) {
+    qw[0] = kRecordMarker;
+    qw[1] = kind;
+    put_u16(qw + 2, key);
+    put_u16(qw + 4, length);
+    put_u16(qw + 6, 0);
+    put_u32(qw + 8, payload_crc);
+    put_u32(qw + 12, crc32(qw, 12));
+}
+
+std::uint32_t hash_key(Key key) { return (key * 0x9E3779B1u) >> 16; }
+
+}  // namespace
+
+struct LogStore::RecordInfo {
+    std::uint32_t offset = 0;
+    std::uint32_t payload_crc = 0;
+    std::uint32_t length = 0;
+    Key key = 0;
+    std::uint8_t kind = 0;
+
+    std::uint32_t size() const { return record_size(length); }
+
+    bool decode(const std::uint8_t* qw) {
+        if (qw[0] != kRecordMarker || get_u32(qw + 12) != crc32(qw, 12)) {
+            return false;
+        }
+        kind = qw[1];
+        key = get_u16(qw + 2);
+        length = get_u16(qw + 4);
+        payload_crc = get_u32(qw + 8);
+        return kind >= kValue && kind <= kSummary && (kind == kSummary || length <= kMaxPayload);
+    }
+};
+
+LogStore::LogStore(FlashDevice& flash, Span<IndexEntry> index, ByteSpan staging, const StoreConfig& config)
+    : flash_(flash), index_(index), staging_(staging), config_(config) {
+    for (IndexEntry& entry : index_) {
+        entry = {};
+    }
+}
+
+// --- Mount -----------------------------------------------------------------
+
+Status LogStore::mount() {
+    mounted_ = false;
+    geometry_ = flash_.geometry();
+    const std::uint32_t size = geometry_.sector_size;
+    if (size % kQw != 0 || size < 1024 || size > 0xFFFF + 1 || geometry_.sector_count > kMaxSectors ||
+        config_.reserve_sectors < 2 || geometry_.sector_count < config_.reserve_sectors + 2 ||
+        index_.size() < 2 || (index_.size() & (index_.size() - 1)) != 0 ||
+        staging_.size() < record_size(kMaxPayload)) {
+        return Status::invalid_argument;
+    }
+    // A previous instance may have left an erase running.
+    Status status = flash_.wait();
+    if (status != Status::ok) {
+        return status;
+    }
+
+    for (IndexEntry& entry : index_) {
+        entry = {};
+    }
+    key_count_ = live_bytes_ = 0;
+    staged_begin_ = staged_end_ = staged_values_ = 0;
+    head_ = reclaim_ = erasing_ = kNone;
+    const std::uint64_t read_before = bytes_read_;
+    stats_.mount_sectors_summarized = stats_.mount_sectors_walked = 0;
+
+    bool known[kMaxSectors] = {};
+    std::uint32_t max_erases = 0;
+    std::uint32_t max_seq = 0;
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        Sector& sector = sectors_[s];
+        sector = {};
+        std::uint8_t qw[kQw];
+        status = read(s * size, qw);
+        if (status == Status::hardware_error) {
+            return status;
+        }
+        std::uint32_t a = 0;
+        std::uint32_t b = 0;
+        if (status == Status::ok && erased(qw, kQw)) {
+            continue;  // blank; checked in full before use
+        }
+        if (status != Status::ok || !decode_stamp(qw, kEraseMagic, a, b)) {
+            sector.state = SectorState::dirty;
+            continue;
+        }
+        known[s] = true;
+        sector.erase_count = a;
+        max_erases = a > max_erases ? a : max_erases;
+
+        status = read(s * size + kQw, qw);
+        if (status == Status::ok && erased(qw, kQw)) {
+            sector.state = SectorState::free;
+        } else if (status == Status::ok && decode_stamp(qw, kOpenMagic, a, b)) {
+            sector.state = SectorState::used;
+            sector.seq = a;
+            max_seq = a > max_seq ? a : max_seq;
+        } else {
+            sector.state = SectorState::dirty;
+        }
+    }
+    // Sectors whose count was lost (blank, torn, foreign) are assumed to be
+    // as worn as the worst known one.
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        if (!known[s]) {
+            sectors_[s].erase_count = max_erases;
+        }
+    }
+    next_seq_ = max_seq + 1;
+
+    std::uint8_t order[kMaxSectors];
+    const std::size_t used = sectors_by_age(order);
+    for (std::size_t i = 0; i < used; ++i) {
+        status = mount_sector(order[i], i + 1 == used);
+        if (status != Status::ok) {
+            return status;
+        }
+    }
+    stats_.mount_bytes_read = static_cast<std::uint32_t>(bytes_read_ - read_before);
+    mounted_ = true;
+    return Status::ok;
+}
+
+Status LogStore::mount_sector(std::uint32_t sector, bool newest) {
+    const std::uint32_t size = geometry_.sector_size;
+    const std::uint32_t base = sector * size;
+    if (config_.use_summaries) {
+        std::uint8_t qw[kQw];
+        std::uint32_t where = 0;
+        std::uint32_t crc = 0;
+        if (read(base + size - kQw, qw) == Status::ok && decode_stamp(qw, kSealMagic, where, crc)) {
+            const Status status = apply_summary(sector, where, crc);
+            if (status == Status::ok) {
+                ++stats_.mount_sectors_summarized;
+                return status;
+            }
+            if (status == Status::no_memory) {
+                return status;
+            }
+            // Damaged summary: fall back to the walk, which replays the
+            // same records in the same order.
+        }
+    }
+
+    ++stats_.mount_sectors_walked;
+    std::uint32_t pos = kFirstRecord;
+    std::uint32_t records = 0;
+    RecordInfo record;
+    Step step;
+    while ((step = next_record(base, pos, record)) == Step::record) {
+        ++records;
+        if (record.kind == kValue && !payload_ok(record)) {
+            continue;  // cut while programming the payload
+        }
+        if (!apply(record.kind, record.key, record.offset, record.size())) {
+            return Status::no_memory;
+        }
+    }
+    if (newest && step == Step::end) {
+        head_ = sector;
+        head_pos_ = pos;
+        head_records_ = records;
+        head_checked_ = pos;
+    }
+    return Status::ok;
+}
+
+Status LogStore::apply_summary(std::uint32_t sector, std::uint32_t where, std::uint32_t crc) {
+    const std::uint32_t base = sector * geometry_.sector_size;
+    const std::uint32_t pos = where & 0xFFFF;
+    const std::uint32_t count = where >> 16;
+    const std::uint32_t length = count * kEntryBytes;
+    RecordInfo header;
+    std::uint32_t header_pos = pos;
+    if (pos < kFirstRecord || next_record(base, header_pos, header) != Step::closed || header.offset != base + pos ||
+        header.length != length) {
+        return Status::corrupt;
+    }
+
+    const std::uint32_t first = base + pos + kQw;
+    std::uint32_t check = 0;
+    for (std::uint32_t done = 0; done < length;) {
+        const std::uint32_t n = length - done < sizeof scratch_ ? length - done : sizeof scratch_;
+        if (read(first + done, {scratch_, n}) != Status::ok) {
+            return Status::corrupt;
+        }
+        check = crc32(scratch_, n, check);
+        done += n;
+    }
+    if (check != crc) {
+        return Status::corrupt;
+    }
+
+    // Entries are in offset order; each record runs to the next one and the
+    // last to the summary. A summary that fits the scratch buffer is still
+    // there from the CRC pass.
+    const bool cached = length <= sizeof scratch_;
+    std::uint32_t previous = 0;
+    for (std::uint32_t i = 0; i <= count; ++i) {
+        std::uint32_t entry = 0;
+        std::uint32_t offset = pos;
+        if (i < count) {
+            const std::uint32_t at = i * kEntryBytes;
+            if (!cached && at % sizeof scratch_ == 0) {
+                const std::uint32_t n = length - at < sizeof scratch_ ? length - at : sizeof scratch_;
+                if (read(first + at, {scratch_, n}) != Status::ok) {
+                    return Status::corrupt;
+                }
+            }
+            entry = get_u32(scratch_ + at % sizeof scratch_);
+            offset = (entry >> 18) * kQw;
+        }
+        if (i > 0) {
+            const std::uint32_t start = (previous >> 18) * kQw;
+            if (offset <= start) {
+                return Status::corrupt;
+            }
+            // Torn headers skipped after a cut add to the span; the index
+            // only uses the size for accounting.
+            const std::uint32_t span = offset - start;
+            const std::uint32_t size = span < record_size(kMaxPayload) ? span : record_size(kMaxPayload);
+            const auto kind = static_cast<std::uint8_t>((previous >> 16) & 3);
+            if (!apply(kind, static_cast<Key>(previous), base + start, size)) {
+                return Status::no_memory;
+            }
+        }
+        previous = entry;
+    }
+    return Status::ok;
+}
+
+LogStore::Step LogStore::next_record(std::uint32_t base, std::uint32_t& pos, RecordInfo& record) {
+    const std::uint32_t limit = geometry_.sector_size - kQw;
+    while (pos + kQw <= limit) {
+        std::uint8_t qw[kQw];
+        const Status status = read(base + pos, qw);
+        if (status == Status::ok && erased(qw, kQw)) {
+            return Step::end;
+        }
+        if (status == Status::ok && record.decode(qw) && pos + record.size() <= limit) {
+            record.offset = base + pos;
+            if (record.kind == kSummary) {
+                return Step::closed;
+            }
+            pos += record.size();
+            return Step::record;
+        }
+        // A torn header: it was the last thing programmed before the cut,
+        // and appending resumed right after it.
+        pos += kQw;
+    }
+    return Step::closed;
+}
+
+bool LogStore::payload_ok(const RecordInfo& record) {
+    if (read(record.offset + kQw, {scratch_, record.length}) != Status::ok) {
+        return false;
+    }
+    return crc32(scratch_, record.length) == record.payload_crc;
+}
+
+bool LogStore::verify_erased(std::uint32_t sector) {
+    const std::uint32_t size = geometry_.sector_size;
+    for (std::uint32_t done = 0; done < size; done += sizeof scratch_) {
+        const std::uint32_t n = size - done < sizeof scratch_ ? size - done : sizeof scratch_;
+        if (read(sector * size + done, {scratch_, n}) != Status::ok || !erased(scratch_, n)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t LogStore::sectors_by_age(std::uint8_t* order) const {
+    std::size_t n = 0;
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        if (sectors_[s].state != SectorState::used) {
+            continue;
+        }
+        std::size_t i = n++;
+        for (; i > 0 && sectors_[order[i - 1]].seq > sectors_[s].seq; --i) {
+            order[i] = order[i - 1];
+        }
+        order[i] = static_cast<std::uint8_t>(s);
+    }
+    return n;
+}
+
+// --- Index -----------------------------------------------------------------
+
+IndexEntry* LogStore::find(Key key) {
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t i = hash_key(key) & mask;; i = (i + 1) & mask) {
+        if (index_[i].key == key) {
+            return &index_[i];
+        }
+        if (index_[i].key == kNoKey) {
+            return nullptr;
+        }
+    }
+}
+
+const IndexEntry* LogStore::find(Key key) const { return const_cast<LogStore*>(this)->find(key); }
+
+bool LogStore::index_put(Key key, std::uint32_t size, std::uint32_t location) {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t i = hash_key(key) & mask;
+    while (index_[i].key != key && index_[i].key != kNoKey) {
+        i = (i + 1) & mask;
+    }
+    IndexEntry& entry = index_[i];
+    if (entry.key == kNoKey) {
+        // One slot always stays empty so probes terminate.
+        if (key_count_ + 2 > index_.size()) {
+            return false;
+        }
+        entry.key = key;
+        ++key_count_;
+    } else {
+        live_bytes_ -= entry.size;
+    }
+    entry.size = static_cast<std::uint16_t>(size);
+    entry.location = location;
+    live_bytes_ += size;
+    return true;
+}
+
+void LogStore::index_remove(Key key) {
+    IndexEntry* entry = find(key);
+    if (entry == nullptr) {
+        return;
+    }
+    live_bytes_ -= entry->size;
+    --key_count_;
+    // Backward-shift deletion: pull later members of the probe run into the
+    // hole so lookups never need tombstones.
+    const std::size_t mask = index_.size() - 1;
+    std::size_t hole = static_cast<std::size_t>(entry - index_.data());
+    for (std::size_t j = (hole + 1) & mask; index_[j].key != kNoKey; j = (j + 1) & mask) {
+        const std::size_t home = hash_key(index_[j].key) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            index_[hole] = index_[j];
+            hole = j;
+        }
+    }
+    index_[hole] = {};
+}
+
+bool LogStore::apply(std::uint8_t kind, Key key, std::uint32_t location, std::uint32_t size) {
+    if (kind == kValue) {
+        return index_put(key, size, location);
+    }
+    if (kind == kTombstone) {
+        index_remove(key);
+    }
+    return true;
+}
+
+// --- Front end ---------------------------------------------------------------
+
+Status LogStore::stage(std::uint8_t kind, Key key, ConstByteSpan payload) {
+    const std::uint32_t length = static_cast<std::uint32_t>(payload.size());
+    const std::uint32_t size = record_size(length);
+    if (staged_end_ + size > staging_.size() && staged_begin_ != 0) {
+        std::memmove(staging_.data(), staging_.data() + staged_begin_, staged_end_ - staged_begin_);
+        staged_end_ -= staged_begin_;
+        staged_begin_ = 0;
+    }
+    if (staged_end_ + size > staging_.size()) {
+        ++stats_.staging_rejects;
+        return Status::no_memory;
+    }
+    std::uint8_t* record = staging_.data() + staged_end_;
+    encode_header(record, kind, key, length, crc32(payload.data(), length));
+    if (length != 0) {
+        std::memcpy(record + kQw, payload.data(), length);
+    }
+    std::memset(record + kQw + length, 0xFF, size - kQw - length);
+    staged_end_ += size;
+    stats_.user_bytes += length;
+    if (pending_bytes() > stats_.staging_high_water) {
+        stats_.staging_high_water = static_cast<std::uint32_t>(pending_bytes());
+    }
+    return Status::ok;
+}
+
+bool LogStore::find_staged(Key key, RecordInfo& record, const std::uint8_t*& payload) const {
+    bool found = false;
+    for (std::size_t pos = staged_begin_; pos < staged_end_;) {
+        RecordInfo candidate;
+        candidate.decode(staging_.data() + pos);
+        if (candidate.key == key && (candidate.kind == kValue || candidate.kind == kTombstone)) {
+            record = candidate;
+            payload = staging_.data() + pos + kQw;
+            found = true;
+        }
+        pos += candidate.size();
+    }
+    return found;
+}
+
+Status LogStore::put(Key key, ConstByteSpan value) {
+    if (!mounted_ || key == kNoKey || value.size() > kMaxPayload) {
+        return Status::invalid_argument;
+    }
+    // Admission is conservative: everything staged counts as new data.
+    const IndexEntry* entry = find(key);
+    const std::size_t live = live_bytes_ - (entry != nullptr ? entry->size : 0);
+    if (live + pending_bytes() + record_size(static_cast<std::uint32_t>(value.size())) > capacity_bytes() ||
+        (entry == nullptr && key_count_ + staged_values_ + 2 > index_.size())) {
+        return Status::no_memory;
+    }
+    const Status status = stage(kValue, key, value);
+    if (status == Status::ok) {
+        ++staged_values_;
+    }
+    return status;
+}
+
+Status LogStore::get(Key key, ByteSpan out, std::size_t& size) {
+    if (!mounted_) {
+        return Status::invalid_argument;
+    }
+    RecordInfo record;
+    const std::uint8_t* staged = nullptr;
+    if (find_staged(key, record, staged)) {
+        if (record.kind == kTombstone) {
+            return Status::not_found;
+        }
+        size = record.length;
+        if (out.size() < record.length) {
+            return Status::overflow;
+        }
+        std::memcpy(out.data(), staged, record.length);
+        return Status::ok;
+    }
+
+    const IndexEntry* entry = find(key);
+    if (entry == nullptr) {
+        return Status::not_found;
+    }
+    std::uint8_t qw[kQw];
+    Status status = read(entry->location, qw);
+    if (status != Status::ok) {
+        return status;
+    }
+    if (!record.decode(qw) || record.kind != kValue || record.key != key) {
+        return Status::corrupt;
+    }
+    size = record.length;
+    if (out.size() < record.length) {
+        return Status::overflow;
+    }
+    status = read(entry->location + kQw, out.first(record.length));
+    if (status != Status::ok) {
+        return status;
+    }
+    return crc32(out.data(), record.length) == record.payload_crc ? Status::ok : Status::corrupt;
+}
+
+bool LogStore::contains(Key key) const {
+    RecordInfo record;
+    const std::uint8_t* staged = nullptr;
+    if (find_staged(key, record, staged)) {
+        return record.kind == kValue;
+    }
+    return find(key) != nullptr;
+}
+
+Status LogStore::remove(Key key) {
+    if (!mounted_) {
+        return Status::invalid_argument;
+    }
+    if (!contains(key)) {
+        return Status::not_found;
+    }
+    return stage(kTombstone, key, {});
+}
+
+Status LogStore::append_log(ConstByteSpan entry) {
+    if (!mounted_ || entry.size() > kMaxPayload) {
+        return Status::invalid_argument;
+    }
+    return stage(kLog, 0, entry);
+}
+
+Status LogStore::visit_log(LogVisitor visitor, void* context) {
+    if (!mounted_) {
+        return Status::invalid_argument;
+    }
+    std::uint8_t order[kMaxSectors];
+    const std::size_t used = sectors_by_age(order);
+    for (std::size_t i = 0; i < used; ++i) {
+        std::uint32_t pos = kFirstRecord;
+        RecordInfo record;
+        while (next_record(order[i] * geometry_.sector_size, pos, record) == Step::record) {
+            if (record.kind == kLog && payload_ok(record)) {
+                visitor(context, {scratch_, record.length});
+            }
+        }
+    }
+    for (std::size_t pos = staged_begin_; pos < staged_end_;) {
+        RecordInfo record;
+        record.decode(staging_.data() + pos);
+        if (record.kind == kLog) {
+            visitor(context, {staging_.data() + pos + kQw, record.length});
+        }
+        pos += record.size();
+    }
+    return Status::ok;
+}
+
+// --- Back end ----------------------------------------------------------------
+
+Status LogStore::service() {
+    if (!mounted_) {
+        return Status::invalid_argument;
+    }
+    if (erasing_ != kNone) {
+        if (flash_.busy()) {
+            return Status::ok;
+        }
+        const Status status = finish_erase();
+        if (status != Status::ok) {
+            return status;
+        }
+    }
+
+    // Staged records wait while a sector is being emptied: the copies must
+    // fit in what the head and the last erased sector have left.
+    Status status = Status::ok;
+    if (reclaim_ == kNone) {
+        status = flush();
+    }
+    if (status == Status::ok && (reclaim_ != kNone || free_sectors() < config_.reserve_sectors)) {
+        status = advance_reclaim();
+    }
+    if (status == Status::ok && erasing_ == kNone) {
+        for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+            if (sectors_[s].state == SectorState::dirty) {
+                return start_erase(s);
+            }
+        }
+    }
+    return status;
+}
+
+Status LogStore::sync() {
+    for (;;) {
+        const std::uint64_t programmed = stats_.flash_bytes;
+        const std::uint32_t erased_before = stats_.sectors_erased;
+        Status status = service();
+        if (status != Status::ok) {
+            return status;
+        }
+        if (pending_bytes() == 0) {
+            return Status::ok;
+        }
+        if (erasing_ != kNone) {
+            status = flash_.wait();
+            if (status != Status::ok) {
+                return status;
+            }
+        } else if (stats_.flash_bytes == programmed && stats_.sectors_erased == erased_before) {
+            return Status::no_memory;
+        }
+    }
+}
+
+Status LogStore::flush() {
+    while (staged_begin_ != staged_end_) {
+        const std::uint8_t* data = staging_.data() + staged_begin_;
+        RecordInfo record;
+        record.decode(data);
+        Status status = ensure_room(record.size(), false);
+        if (status == Status::busy) {
+            return Status::ok;  // waiting for a sector to be reclaimed
+        }
+        std::uint32_t location = 0;
+        if (status == Status::ok) {
+            status = write_record(data, record.size(), location);
+        }
+        if (status != Status::ok) {
+            return status;
+        }
+        if (record.kind == kValue) {
+            --staged_values_;
+        }
+        staged_begin_ += record.size();
+        if (!apply(record.kind, record.key, location, record.size())) {
+            return Status::no_memory;
+        }
+    }
+    staged_begin_ = staged_end_ = 0;
+    return Status::ok;
+}
+
+std::uint32_t LogStore::summary_size(std::uint32_t records) const {
+    return record_size(records * kEntryBytes);
+}
+
+Status LogStore::ensure_room(std::uint32_t size, bool for_copy) {
+    if (head_ != kNone &&
+        head_pos_ + size + summary_size(head_records_ + 1) + kQw <= geometry_.sector_size) {
+        return Status::ok;
+    }
+    if (head_ != kNone) {
+        const Status status = seal_head();
+        if (status != Status::ok) {
+            return status;
+        }
+    }
+    // New data leaves the reserve to reclaiming, which may use it all.
+    const std::size_t needed = for_copy ? 1 : config_.reserve_sectors;
+    if (free_sectors() < needed) {
+        return Status::busy;
+    }
+    return open_sector();
+}
+
+Status LogStore::open_sector() {
+    for (;;) {
+        std::uint32_t best = kNone;
+        for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+            const Sector& sector = sectors_[s];
+            if ((sector.state == SectorState::free || sector.state == SectorState::blank) &&
+                (best == kNone || sector.erase_count < sectors_[best].erase_count)) {
+                best = s;
+            }
+        }
+        if (best == kNone) {
+            return Status::busy;
+        }
+
+        Sector& sector = sectors_[best];
+        const std::uint32_t base = best * geometry_.sector_size;
+        std::uint8_t qw[kQw];
+        Status status = Status::ok;
+        if (sector.state == SectorState::blank) {
+            if (!verify_erased(best)) {
+                sector.state = SectorState::dirty;  // torn erase; redo it
+                continue;
+            }
+            encode_stamp(qw, kEraseMagic, sector.erase_count, 0);
+            status = program(base, qw);
+        }
+        if (status == Status::ok) {
+            encode_stamp(qw, kOpenMagic, next_seq_, 0);
+            status = program(base + kQw, qw);
+        }
+        if (status != Status::ok) {
+            sector.state = SectorState::dirty;
+            return status;
+        }
+        sector.state = SectorState::used;
+        sector.seq = next_seq_++;
+        head_ = best;
+        head_pos_ = kFirstRecord;
+        head_records_ = 0;
+        head_checked_ = kFirstRecord;
+        return Status::ok;
+    }
+}
+
+Status LogStore::seal_head() {
+    const std::uint32_t size = geometry_.sector_size;
+    const std::uint32_t base = head_ * size;
+    const std::uint32_t at = head_pos_;
+    const std::uint32_t count = head_records_;
+    head_ = kNone;  // closed even if sealing fails; mount then walks it
+    if (at + summary_size(count) + kQw > size) {
+        return Status::ok;  // a torn summary header took the room
+    }
+
+    std::uint8_t qw[kQw];
+    encode_header(qw, kSummary, 0, count * kEntryBytes, 0);
+    Status status = program(base + at, qw);
+
+    std::uint32_t crc = 0;
+    std::uint32_t filled = 0;
+    std::uint32_t out = base + at + kQw;
+    std::uint32_t pos = kFirstRecord;
+    RecordInfo record;
+    while (status == Status::ok && pos < at && next_record(base, pos, record) == Step::record) {
+        std::uint8_t kind = record.kind;
+        if (kind == kValue && record.offset - base < head_checked_ && !payload_ok(record)) {
+            kind = kDamaged;
+        }
+        put_u32(qw + filled, record.key | static_cast<std::uint32_t>(kind) << 16 |
+                                 (record.offset - base) / kQw << 18);
+        filled += kEntryBytes;
+        if (filled == kQw) {
+            crc = crc32(qw, kQw, crc);
+            status = program(out, qw);
+            out += kQw;
+            filled = 0;
+        }
+    }
+    if (status == Status::ok && filled != 0) {
+        crc = crc32(qw, filled, crc);
+        std::memset(qw + filled, 0xFF, kQw - filled);
+        status = program(out, qw);
+    }
+    if (status == Status::ok) {
+        encode_stamp(qw, kSealMagic, at | count << 16, crc);
+        status = program(base + size - kQw, qw);
+    }
+    return status;
+}
+
+Status LogStore::write_record(const std::uint8_t* record, std::uint32_t size, std::uint32_t& location) {
+    location = head_ * geometry_.sector_size + head_pos_;
+    Status status = program(location, {record, kQw});
+    if (status == Status::ok && size > kQw) {
+        status = program(location + kQw, {record + kQw, size - kQw});
+    }
+    if (status != Status::ok) {
+        // Whatever was programmed is unreadable garbage; leave the sector.
+        head_ = kNone;
+        return status;
+    }
+    head_pos_ += size;
+    ++head_records_;
+    ++stats_.records_written;
+    return Status::ok;
+}
+
+Status LogStore::advance_reclaim() {
+    if (reclaim_ == kNone) {
+        std::uint8_t order[kMaxSectors];
+        const std::size_t used = sectors_by_age(order);
+        if (used == 0 || (used == 1 && order[0] == head_)) {
+            return Status::ok;
+        }
+        reclaim_ = order[0] != head_ ? order[0] : order[1];
+        reclaim_pos_ = kFirstRecord;
+    }
+
+    const std::uint32_t base = reclaim_ * geometry_.sector_size;
+    for (std::size_t copied = 0; copied < config_.copy_budget;) {
+        const std::uint32_t pos = reclaim_pos_;
+        RecordInfo record;
+        if (next_record(base, reclaim_pos_, record) != Step::record) {
+            const std::uint32_t sector = reclaim_;
+            reclaim_ = kNone;
+            return start_erase(sector);
+        }
+        if (record.kind == kLog) {
+            ++stats_.log_records_dropped;
+            continue;
+        }
+        const IndexEntry* entry = find(record.key);
+        if (record.kind != kValue || entry == nullptr || entry->location != record.offset) {
+            continue;  // superseded, deleted or a tombstone: garbage now
+        }
+
+        Status status = ensure_room(record.size(), true);
+        if (status == Status::busy) {
+            status = Status::no_memory;  // the reserve was too small
+        }
+        if (status == Status::ok) {
+            status = read(record.offset, {scratch_, record.size()});
+            if (status == Status::corrupt ||
+                (status == Status::ok && crc32(scratch_ + kQw, record.length) != record.payload_crc)) {
+                // Unreadable: there is nothing to carry over.
+                ++stats_.flash_errors;
+                index_remove(record.key);
+                continue;
+            }
+        }
+        std::uint32_t location = 0;
+        if (status == Status::ok) {
+            status = write_record(scratch_, record.size(), location);
+        }
+        if (status != Status::ok) {
+            reclaim_pos_ = pos;
+            return status;
+        }
+        index_put(record.key, record.size(), location);
+        stats_.copied_bytes += record.size();
+        ++copied;
+    }
+    return Status::ok;
+}
+
+Status LogStore::start_erase(std::uint32_t sector) {
+    const Status status = flash_.start_erase(sector);
+    if (status != Status::ok) {
+        ++stats_.flash_errors;
+        return status;
+    }
+    sectors_[sector].state = SectorState::erasing;
+    erasing_ = sector;
+    return Status::ok;
+}
+
+Status LogStore::finish_erase() {
+    Sector& sector = sectors_[erasing_];
+    ++sector.erase_count;
+    ++stats_.sectors_erased;
+    std::uint8_t qw[kQw];
+    encode_stamp(qw, kEraseMagic, sector.erase_count, 0);
+    const Status status = program(erasing_ * geometry_.sector_size, qw);
+    sector.state = status == Status::ok ? SectorState::free : SectorState::dirty;
+    sector.seq = 0;
+    erasing_ = kNone;
+    return status;
+}
+
+Status LogStore::read(std::uint32_t offset, ByteSpan out) {
+    bytes_read_ += out.size();
+    return flash_.read(offset, out);
+}
+
+Status LogStore::program(std::uint32_t offset, ConstByteSpan data) {
+    const Status status = flash_.program(offset, data);
+    if (status == Status::ok) {
+        stats_.flash_bytes += data.size();
+    } else {
+        ++stats_.flash_errors;
+    }
+    return status;
+}
+
+// --- Statistics --------------------------------------------------------------
+
+std::size_t LogStore::free_sectors() const {
+    std::size_t n = 0;
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        n += sectors_[s].state == SectorState::free || sectors_[s].state == SectorState::blank;
+    }
+    return n;
+}
+
+std::size_t LogStore::capacity_bytes() const {
+    // Worst case is all 16-byte records, each with a 4-byte summary entry;
+    // one sector is always open and `reserve_sectors` stay erased.
+    const std::uint32_t per_sector = ((geometry_.sector_size - 4 * kQw) * 4 / 5) & ~(kQw - 1);
+    return static_cast<std::size_t>(geometry_.sector_count - config_.reserve_sectors - 1) * per_sector;
+}
+
+std::uint32_t LogStore::min_erase_count() const {
+    std::uint32_t n = UINT32_MAX;
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        n = sectors_[s].erase_count < n ? sectors_[s].erase_count : n;
+    }
+    return geometry_.sector_count != 0 ? n : 0;
+}
+
+std::uint32_t LogStore::max_erase_count() const {
+    std::uint32_t n = 0;
+    for (std::uint32_t s = 0; s < geometry_.sector_count; ++s) {
+        n = sectors_[s].erase_count > n ? sectors_[s].erase_count : n;
+    }
+    return n;
+}
+
+}  // namespace nucleo::storage
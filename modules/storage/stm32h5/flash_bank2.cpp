@@ -0,0 +1,158 @@
+// The storage region in flash bank 2, programmed through the non-secure
+// flash interface. Erases are started and left to run; the firmware image
+// executes from bank 1, which stays readable throughout.
+#include "stm32h5xx.h"
+
+#include <cstring>
+
+#include "nucleo/storage/board_flash.hpp"
+
+namespace nucleo::storage {
+namespace {
+
+constexpr std::uint32_t kBank2Base = 0x08100000;
+constexpr std::uint32_t kFirstSector = (kStorageBase - kBank2Base) / 8192;
+constexpr std::uint32_t kKey1 = 0x45670123;
+constexpr std::uint32_t kKey2 = 0xCDEF89AB;
+constexpr std::uint32_t kErrors = FLASH_SR_WRPERR | FLASH_SR_PGSERR | FLASH_SR_STRBERR | FLASH_SR_INCERR;
+
+// Set by the NMI when a read hits a quad-word with a double ECC error: a
+// program or erase interrupted by a power cut.
+volatile bool g_ecc_fault = false;
+
+void invalidate_icache() {
+    // Flash data reads go through the ICACHE; drop lines that may hold
+    // what was there before.
+    ICACHE->CR |= ICACHE_CR_CACHEINV;
+    while ((ICACHE->SR & ICACHE_SR_BUSYF) != 0) {
+    }
+}
+
+Status take_errors() {
+    const std::uint32_t errors = FLASH->NSSR & kErrors;
+    if (errors == 0) {
+        return Status::ok;
+    }
+    FLASH->NSCCR = errors;
+    return Status::hardware_error;
+}
+
+class Bank2Flash final : public FlashDevice {
+public:
+    FlashGeometry geometry() const override { return kStorageGeometry; }
+    Status read(std::uint32_t offset, ByteSpan out) override;
+    Status program(std::uint32_t offset, ConstByteSpan data) override;
+    Status start_erase(std::uint32_t sector) override;
+    bool busy() override;
+    Status wait() override;
+
+private:
+    void unlock();
+
+    bool erasing_ = false;
+    Status erase_status_ = Status::ok;
+};
+
+Bank2Flash g_flash;
+
+void Bank2Flash::unlock() {
+    if ((FLASH->NSCR & FLASH_CR_LOCK) != 0) {
+        FLASH->NSKEYR = kKey1;
+        FLASH->NSKEYR = kKey2;
+    }
+}
+
+Status Bank2Flash::read(std::uint32_t offset, ByteSpan out) {
+    if (offset > kStorageGeometry.size() || out.size() > kStorageGeometry.size() - offset) {
+        return Status::invalid_argument;
+    }
+    // Reads of bank 2 stall on the bus while it erases; nothing to do here.
+    g_ecc_fault = false;
+    std::memcpy(out.data(), reinterpret_cast<const void*>(kStorageBase + offset), out.size());
+    return g_ecc_fault ? Status::corrupt : Status::ok;
+}
+
+Status Bank2Flash::program(std::uint32_t offset, ConstByteSpan data) {
+    if (offset % kQuadWord != 0 || data.size() % kQuadWord != 0 || offset > kStorageGeometry.size() ||
+        data.size() > kStorageGeometry.size() - offset) {
+        return Status::invalid_argument;
+    }
+    if (busy()) {
+        return Status::busy;
+    }
+    unlock();
+    FLASH->NSCR = FLASH_CR_PG;
+    Status status = Status::ok;
+    for (std::size_t i = 0; i < data.size() && status == Status::ok; i += kQuadWord) {
+        // Four word writes fill the write buffer; the fourth starts the
+        // program. The source may be unaligned.
+        volatile std::uint32_t* dst = reinterpret_cast<volatile std::uint32_t*>(kStorageBase + offset + i);
+        for (std::size_t w = 0; w < 4; ++w) {
+            std::uint32_t word;
+            std::memcpy(&word, data.data() + i + 4 * w, sizeof word);
+            dst[w] = word;
+        }
+        __DSB();
+        while ((FLASH->NSSR & (FLASH_SR_BSY | FLASH_SR_WBNE | FLASH_SR_DBNE)) != 0) {
+        }
+        status = take_errors();
+    }
+    FLASH->NSCR = 0;
+    FLASH->NSCCR = FLASH_CCR_CLR_EOP;
+    invalidate_icache();
+    return status;
+}
+
+Status Bank2Flash::start_erase(std::uint32_t sector) {
+    if (sector >= kStorageGeometry.sector_count) {
+        return Status::invalid_argument;
+    }
+    if (busy()) {
+        return Status::busy;
+    }
+    unlock();
+    FLASH->NSCR = FLASH_CR_SER | FLASH_CR_BKSEL | ((kFirstSector + sector) << FLASH_CR_SNB_Pos);
+    FLASH->NSCR |= FLASH_CR_STRT;
+    erasing_ = true;
+    erase_status_ = Status::ok;
+    return Status::ok;
+}
+
+bool Bank2Flash::busy() {
+    if (!erasing_) {
+        return false;
+    }
+    if ((FLASH->NSSR & FLASH_SR_BSY) != 0) {
+        return true;
+    }
+    erasing_ = false;
+    erase_status_ = take_errors();
+    FLASH->NSCR = 0;
+    FLASH->NSCCR = FLASH_CCR_CLR_EOP;
+    invalidate_icache();
+    return false;
+}
+
+Status Bank2Flash::wait() {
+    while (busy()) {
+    }
+    const Status status = erase_status_;
+    erase_status_ = Status::ok;
+    return status;
+}
+
+}  // namespace
+
+FlashDevice& storage_flash() { return g_flash; }
+
+}  // namespace nucleo::storage
+
+extern "C" void NMI_Handler() {
+    if ((FLASH->ECCDETR & FLASH_ECCR_ECCD) != 0) {
+        FLASH->ECCDETR = FLASH_ECCR_ECCD;  // write 1 to clear
+        nucleo::storage::g_ecc_fault = true;
+        return;
+    }
+    for (;;) {
+    }
+}
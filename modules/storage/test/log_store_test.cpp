@@ -0,0 +1,329 @@
+#include <cstring>
+#include <vector>
+
+#include "nucleo/storage/host/sim_flash.hpp"
+#include "nucleo/storage/log_store.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::storage;
+using host::SimFlash;
+
+namespace {
+
+constexpr FlashGeometry kSmall{2048, 8};
+
+using Store = StaticLogStore<64, 1024>;
+
+ConstByteSpan bytes(const std::vector<std::uint8_t>& v) { return {v.data(), v.size()}; }
+
+std::vector<std::uint8_t> value_for(Key key, std::uint32_t version, std::size_t size) {
+    std::vector<std::uint8_t> v(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<std::uint8_t>(key * 31 + version * 7 + i);
+    }
+    return v;
+}
+
+bool holds(LogStore& store, Key key, const std::vector<std::uint8_t>& expected) {
+    std::uint8_t out[kMaxPayload];
+    std::size_t size = 0;
+    return store.get(key, out, size) == Status::ok && size == expected.size() &&
+           std::memcmp(out, expected.data(), size) == 0;
+}
+
+// Rewrites `keys` keys `rounds` times, servicing as a main loop would.
+void churn(LogStore& store, SimFlash& flash, Key keys, std::uint32_t rounds, std::size_t size) {
+    for (std::uint32_t r = 0; r < rounds; ++r) {
+        for (Key k = 0; k < keys; ++k) {
+            while (store.put(k, bytes(value_for(k, r, size))) == Status::no_memory) {
+                store.service();
+                flash.advance_us(500);
+            }
+            store.service();
+            flash.advance_us(100);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(blank_region_mounts_empty) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    CHECK_EQ(store.key_count(), 0u);
+    CHECK_EQ(store.free_sectors(), kSmall.sector_count);
+    std::uint8_t out[8];
+    std::size_t size = 0;
+    CHECK_EQ(store.get(1, out, size), Status::not_found);
+    CHECK_EQ(store.remove(1), Status::not_found);
+}
+
+TEST(rejects_unusable_configurations) {
+    SimFlash tiny({2048, 3});
+    Store few_sectors(tiny);
+    CHECK_EQ(few_sectors.mount(), Status::invalid_argument);
+
+    SimFlash flash(kSmall);
+    StoreConfig config;
+    config.reserve_sectors = 1;
+    Store no_reserve(flash, config);
+    CHECK_EQ(no_reserve.mount(), Status::invalid_argument);
+
+    Store unmounted(flash);
+    CHECK_EQ(unmounted.put(1, bytes(value_for(1, 0, 4))), Status::invalid_argument);
+}
+
+TEST(put_get_update_remove) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+
+    const auto a = value_for(1, 0, 10);
+    const auto b = value_for(1, 1, 37);
+    REQUIRE_EQ(store.put(1, bytes(a)), Status::ok);
+    CHECK(store.contains(1));
+    CHECK(holds(store, 1, a));  // served from staging
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK_EQ(store.pending_bytes(), 0u);
+    CHECK(holds(store, 1, a));  // served from flash
+
+    REQUIRE_EQ(store.put(1, bytes(b)), Status::ok);
+    CHECK(holds(store, 1, b));
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK(holds(store, 1, b));
+    CHECK_EQ(store.key_count(), 1u);
+
+    std::uint8_t small[4];
+    std::size_t size = 0;
+    CHECK_EQ(store.get(1, small, size), Status::overflow);
+    CHECK_EQ(size, b.size());
+
+    REQUIRE_EQ(store.remove(1), Status::ok);
+    CHECK(!store.contains(1));
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK(!store.contains(1));
+    CHECK_EQ(store.key_count(), 0u);
+    CHECK_EQ(store.live_bytes(), 0u);
+
+    CHECK_EQ(store.put(kNoKey, bytes(a)), Status::invalid_argument);
+    const std::vector<std::uint8_t> big(kMaxPayload + 1);
+    CHECK_EQ(store.put(2, bytes(big)), Status::invalid_argument);
+    CHECK_EQ(store.put(3, {}), Status::ok);
+    CHECK(store.contains(3));
+}
+
+TEST(values_survive_remount_with_and_without_summaries) {
+    SimFlash flash(kSmall);
+    {
+        Store store(flash);
+        REQUIRE_EQ(store.mount(), Status::ok);
+        churn(store, flash, 12, 24, 40);
+        REQUIRE_EQ(store.remove(5), Status::ok);
+        REQUIRE_EQ(store.sync(), Status::ok);
+        CHECK(store.stats().sectors_erased > 0);
+    }
+
+    Store fast(flash);
+    REQUIRE_EQ(fast.mount(), Status::ok);
+    const StoreStats fast_stats = fast.stats();
+    CHECK(fast_stats.mount_sectors_summarized > 0);
+    CHECK(fast_stats.mount_sectors_walked <= 1);
+
+    StoreConfig walk_config;
+    walk_config.use_summaries = false;
+    Store slow(flash, walk_config);
+    REQUIRE_EQ(slow.mount(), Status::ok);
+    CHECK_EQ(slow.stats().mount_sectors_summarized, 0u);
+    CHECK(slow.stats().mount_bytes_read > fast_stats.mount_bytes_read);
+
+    for (Key k = 0; k < 12; ++k) {
+        if (k == 5) {
+            CHECK(!fast.contains(k));
+            CHECK(!slow.contains(k));
+        } else {
+            CHECK(holds(fast, k, value_for(k, 23, 40)));
+            CHECK(holds(slow, k, value_for(k, 23, 40)));
+        }
+    }
+    CHECK_EQ(fast.key_count(), 11u);
+    CHECK_EQ(fast.live_bytes(), slow.live_bytes());
+}
+
+TEST(log_entries_read_back_oldest_first) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        std::uint8_t entry[6] = {static_cast<std::uint8_t>(i), 0xAB, 0, 0, 0, static_cast<std::uint8_t>(i)};
+        REQUIRE_EQ(store.append_log(entry), Status::ok);
+        if (i == 9) {
+            REQUIRE_EQ(store.sync(), Status::ok);
+        }
+    }
+    // Half on flash, half still staged.
+    std::vector<std::uint32_t> seen;
+    store.for_each_log([&](ConstByteSpan entry) {
+        CHECK_EQ(entry.size(), 6u);
+        seen.push_back(entry[0]);
+    });
+    REQUIRE_EQ(seen.size(), 20u);
+    for (std::uint32_t i = 0; i < 20; ++i) {
+        CHECK_EQ(seen[i], i);
+    }
+
+    REQUIRE_EQ(store.sync(), Status::ok);
+    Store again(flash);
+    REQUIRE_EQ(again.mount(), Status::ok);
+    seen.clear();
+    again.for_each_log([&](ConstByteSpan entry) { seen.push_back(entry[0]); });
+    CHECK_EQ(seen.size(), 20u);
+}
+
+TEST(old_log_entries_are_dropped_to_make_room) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    std::uint32_t appended = 0;
+    for (; appended < 600; ++appended) {
+        std::uint8_t entry[40] = {};
+        std::memcpy(entry, &appended, sizeof appended);
+        REQUIRE_EQ(store.append_log(entry), Status::ok);
+        REQUIRE_EQ(store.sync(), Status::ok);
+    }
+    std::uint32_t previous = 0;
+    std::uint32_t count = 0;
+    bool ordered = true;
+    store.for_each_log([&](ConstByteSpan entry) {
+        std::uint32_t n = 0;
+        std::memcpy(&n, entry.data(), sizeof n);
+        ordered = ordered && (count == 0 || n == previous + 1);
+        previous = n;
+        ++count;
+    });
+    CHECK(ordered);
+    CHECK_EQ(previous, appended - 1);  // the newest are kept
+    CHECK(store.stats().log_records_dropped > 0);
+    CHECK_EQ(count + store.stats().log_records_dropped, appended);
+}
+
+TEST(wear_is_spread_across_sectors) {
+    SimFlash flash({2048, 16});
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    // Static data that is never rewritten, plus a hot key.
+    for (Key k = 100; k < 110; ++k) {
+        REQUIRE_EQ(store.put(k, bytes(value_for(k, 0, 64))), Status::ok);
+    }
+    churn(store, flash, 1, 3000, 48);
+    REQUIRE_EQ(store.sync(), Status::ok);
+
+    CHECK(store.stats().sectors_erased > 60);
+    CHECK(store.max_erase_count() - store.min_erase_count() <= 2);
+    for (Key k = 100; k < 110; ++k) {
+        CHECK(holds(store, k, value_for(k, 0, 64)));
+    }
+    CHECK(holds(store, 0, value_for(0, 2999, 48)));
+    // Single-key churn reclaims almost nothing live: amplification stays
+    // near the record overhead.
+    CHECK(store.stats().write_amplification() < 2.0);
+}
+
+TEST(writes_never_wait_for_an_erase) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    // Write until the store starts reclaiming a sector in the background.
+    std::uint32_t version = 0;
+    while (!flash.busy()) {
+        REQUIRE_EQ(store.put(static_cast<Key>(version % 4), bytes(value_for(0, version, 100))), Status::ok);
+        REQUIRE_EQ(store.service(), Status::ok);
+        ++version;
+    }
+    const double before = flash.now_us();
+    for (Key k = 10; k < 18; ++k) {
+        CHECK_EQ(store.put(k, bytes(value_for(k, 0, 32))), Status::ok);
+        CHECK_EQ(store.service(), Status::ok);  // erase running: returns at once
+    }
+    CHECK_EQ(flash.now_us(), before);
+    CHECK(store.pending_bytes() > 0);
+    CHECK(holds(store, 13, value_for(13, 0, 32)));
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK(flash.stall_us() > 0);  // sync() is the one call that waits
+    CHECK(holds(store, 13, value_for(13, 0, 32)));
+}
+
+TEST(staging_full_is_reported) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    Status status = Status::ok;
+    Key k = 0;
+    for (; k < 64 && status == Status::ok; ++k) {
+        status = store.put(k, bytes(value_for(k, 0, 100)));
+    }
+    CHECK_EQ(status, Status::no_memory);
+    CHECK_EQ(store.stats().staging_rejects, 1u);
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK_EQ(store.put(k, bytes(value_for(k, 0, 100))), Status::ok);
+}
+
+TEST(capacity_is_enforced) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    Status status = Status::ok;
+    Key k = 0;
+    for (; k < 60 && status == Status::ok; ++k) {
+        status = store.put(k, bytes(value_for(k, 0, 400)));
+        store.sync();
+    }
+    CHECK_EQ(status, Status::no_memory);
+    CHECK(store.live_bytes() <= store.capacity_bytes());
+    // Rewriting an existing key in place of itself still fits.
+    CHECK_EQ(store.put(0, bytes(value_for(0, 1, 400))), Status::ok);
+    REQUIRE_EQ(store.sync(), Status::ok);
+    CHECK(holds(store, 0, value_for(0, 1, 400)));
+}
+
+TEST(foreign_contents_are_erased) {
+    SimFlash flash(kSmall);
+    std::vector<std::uint8_t> junk(kSmall.sector_size, 0x5A);
+    flash.load(3 * kSmall.sector_size, bytes(junk));
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    CHECK_EQ(store.key_count(), 0u);
+    CHECK_EQ(store.free_sectors(), kSmall.sector_count - 1u);
+    REQUIRE_EQ(store.service(), Status::ok);
+    REQUIRE_EQ(flash.wait(), Status::ok);
+    REQUIRE_EQ(store.service(), Status::ok);
+    CHECK_EQ(store.free_sectors(), kSmall.sector_count);
+    CHECK_EQ(flash.erase_count(3), 1u);
+}
+
+TEST(damaged_record_reads_corrupt) {
+    SimFlash flash(kSmall);
+    Store store(flash);
+    REQUIRE_EQ(store.mount(), Status::ok);
+    REQUIRE_EQ(store.put(9, bytes(value_for(9, 0, 32))), Status::ok);
+    REQUIRE_EQ(store.sync(), Status::ok);
+    // Flip payload bits behind the store's back (a programmed cell that
+    // lost charge). The first record of the first opened sector sits at 32.
+    std::uint32_t at = 0;
+    for (std::uint32_t s = 0; s < kSmall.sector_count; ++s) {
+        std::uint8_t qw[kQuadWord];
+        flash.read(s * kSmall.sector_size + 2 * kQuadWord, qw);
+        if (qw[0] == 0xA5) {
+            at = s * kSmall.sector_size + 3 * kQuadWord;
+        }
+    }
+    REQUIRE(at != 0);
+    std::uint8_t payload[kQuadWord];
+    flash.read(at, payload);
+    payload[0] ^= 0x01;
+    flash.load(at, payload);
+    std::uint8_t out[64];
+    std::size_t size = 0;
+    CHECK_EQ(store.get(9, out, size), Status::corrupt);
+}
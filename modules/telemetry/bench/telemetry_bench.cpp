@@ -0,0 +1,143 @@
+// Binary telemetry against text log lines for the same records: encode
+// time per record and bytes per record on the link.
+//
+//  * binary: the generated board encoder (key record every 32)
+//  * struct: memcpy of the record struct behind an id byte, the cheapest
+//    binary format there is and the size floor without varints
+//  * text:   one snprintf log line per record, as the firmware would print
+//
+// Each stream is a few thousand records of plausible, slowly varying
+// values. Times are host nanoseconds; bytes per record do not depend on
+// the machine.
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "nucleo/telemetry/board_schema.hpp"
+#include "nucleo/testkit/bench.hpp"
+
+using namespace nucleo;
+using namespace nucleo::telemetry;
+
+namespace {
+
+constexpr std::size_t kRecords = 4096;
+
+int format(char* out, std::size_t size, const board::AdcBlock& r) {
+    return std::snprintf(out, size, "adc t=%" PRIu32 " ch=%u min=%d max=%d mean=%d ovr=%u\n", r.timestamp_us,
+                         static_cast<unsigned>(r.channel), r.min, r.max, r.mean, static_cast<unsigned>(r.overruns));
+}
+
+int format(char* out, std::size_t size, const board::LoopTiming& r) {
+    return std::snprintf(out, size, "loop t=%" PRIu32 " min=%" PRIu32 " max=%" PRIu32 " mean=%" PRIu32 " miss=%u\n",
+                         r.timestamp_us, r.cycles_min, r.cycles_max, r.cycles_mean,
+                         static_cast<unsigned>(r.deadline_misses));
+}
+
+int format(char* out, std::size_t size, const board::Power& r) {
+    return std::snprintf(out, size, "power t=%" PRIu32 " vdd=%umV i=%" PRId32 "uA temp=%.2fC\n", r.timestamp_ms,
+                         static_cast<unsigned>(r.vdd_mv), r.current_ua, static_cast<double>(r.temperature_c));
+}
+
+std::vector<board::AdcBlock> adc_stream() {
+    std::mt19937 rng(1);
+    std::vector<board::AdcBlock> out;
+    std::int16_t mean = 2048;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        board::AdcBlock r;
+        r.timestamp_us = static_cast<std::uint32_t>(i / 4 * 1000);  // 4 channels per 1 ms block
+        r.channel = static_cast<std::uint8_t>(i % 4);
+        mean = static_cast<std::int16_t>(mean + static_cast<int>(rng() % 9) - 4);
+        r.mean = mean;
+        r.min = static_cast<std::int16_t>(mean - 30 - static_cast<int>(rng() % 20));
+        r.max = static_cast<std::int16_t>(mean + 30 + static_cast<int>(rng() % 20));
+        r.overruns = 0;
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::vector<board::LoopTiming> loop_stream() {
+    std::mt19937 rng(2);
+    std::vector<board::LoopTiming> out;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        board::LoopTiming r;
+        r.timestamp_us = static_cast<std::uint32_t>(i * 100'000);
+        r.cycles_min = 11'800 + rng() % 100;
+        r.cycles_max = 14'000 + rng() % 3000;
+        r.cycles_mean = 12'400 + rng() % 200;
+        r.deadline_misses = rng() % 50 == 0 ? 1 : 0;
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::vector<board::Power> power_stream() {
+    std::mt19937 rng(3);
+    std::vector<board::Power> out;
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        board::Power r;
+        r.timestamp_ms = static_cast<std::uint32_t>(i * 1000);
+        r.vdd_mv = static_cast<std::uint16_t>(3300 + rng() % 5 - 2);
+        r.current_ua = 48'000 + static_cast<std::int32_t>(rng() % 4000);
+        r.temperature_c = 31.5f + static_cast<float>(rng() % 100) * 0.01f;
+        out.push_back(r);
+    }
+    return out;
+}
+
+template <typename Record>
+void compare(testkit::Bench& bench, const char* name, const std::vector<Record>& records) {
+    char label[64];
+    std::uint8_t buf[256];
+    char line[256];
+
+    // Bytes per record over the whole stream, key records included.
+    board::Encoder sizing;
+    std::size_t binary_bytes = 0;
+    std::size_t text_bytes = 0;
+    for (const Record& r : records) {
+        binary_bytes += sizing.encode(r, buf);
+        text_bytes += static_cast<std::size_t>(format(line, sizeof line, r));
+    }
+    const double n = static_cast<double>(records.size());
+
+    board::Encoder encoder;
+    std::size_t i = 0;
+    std::snprintf(label, sizeof label, "%s_binary", name);
+    bench.run(label, 256, [&] {
+        testkit::do_not_optimize(encoder.encode(records[i], buf));
+        i = i + 1 == records.size() ? 0 : i + 1;
+    });
+    std::snprintf(label, sizeof label, "%s_struct", name);
+    bench.run(label, 256, [&] {
+        buf[0] = Record::kId;
+        std::memcpy(buf + 1, &records[i], sizeof(Record));
+        testkit::clobber_memory();
+        i = i + 1 == records.size() ? 0 : i + 1;
+    });
+    std::snprintf(label, sizeof label, "%s_text", name);
+    bench.run(label, 256, [&] {
+        testkit::do_not_optimize(format(line, sizeof line, records[i]));
+        i = i + 1 == records.size() ? 0 : i + 1;
+    });
+
+    std::snprintf(label, sizeof label, "%s_binary_bytes", name);
+    bench.metric(label, static_cast<double>(binary_bytes) / n, "B/record");
+    std::snprintf(label, sizeof label, "%s_struct_bytes", name);
+    bench.metric(label, static_cast<double>(1 + sizeof(Record)), "B/record");
+    std::snprintf(label, sizeof label, "%s_text_bytes", name);
+    bench.metric(label, static_cast<double>(text_bytes) / n, "B/record");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    compare(bench, "adc", adc_stream());
+    compare(bench, "loop", loop_stream());
+    compare(bench, "power", power_stream());
+    return 0;
+}
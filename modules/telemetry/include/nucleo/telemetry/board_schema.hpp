@@ -0,0 +1,7 @@
+// Record types and encoder for the board telemetry schema
+// (board_schema.def).
+#pragma once
+
+#define NUCLEO_TELEMETRY_SCHEMA "nucleo/telemetry/board_schema.def"
+#define NUCLEO_TELEMETRY_NAMESPACE nucleo::telemetry::board
+#include "nucleo/telemetry/generate.hpp"
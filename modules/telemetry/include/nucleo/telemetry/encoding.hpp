@@ -0,0 +1,185 @@
+// Field encodings and the schema descriptors shared by the generated
+// serializers (generate.hpp) and the host decoder (nucleo-teledump).
+//
+// A telemetry stream is a sequence of records, each one header byte
+// followed by its fields in schema order:
+//
+//   header:u8   record id (1..127), bit 7 set on key records
+//   fields      per-field encoding below, no tags and no lengths
+//
+// Delta-encoded fields carry the change since the previous record of the
+// same type, so a decoder must see every record after a key record. Key
+// records encode delta fields against zero; the encoder emits one for the
+// first record of each type, every key_interval records after that, and
+// after Encoder::reset(). Header byte 0 starts a schema record,
+//
+//   0x00  version:u8  schema_hash:u32
+//
+// which lets the decoder check it was built from the same schema file and
+// marks the point where every record type restarts with a key record.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nucleo::telemetry {
+
+inline constexpr std::uint8_t kFormatVersion = 1;
+inline constexpr std::uint8_t kSchemaRecordId = 0;
+inline constexpr std::uint8_t kMaxRecordId = 127;
+inline constexpr std::uint8_t kKeyFlag = 0x80;
+inline constexpr std::size_t kSchemaRecordSize = 1 + 1 + 4;
+inline constexpr std::uint8_t kDefaultKeyInterval = 32;
+
+enum class Encoding : std::uint8_t {
+    /// Unsigned LEB128; for counters and other small non-negative values.
+    uvarint,
+    /// ZigZag LEB128; for signed values that stay near zero.
+    svarint,
+    /// ZigZag LEB128 of the change since the previous record, modulo the
+    /// field width; for timestamps and slowly moving values.
+    delta,
+    /// The little-endian bytes of the value; for floats and for values with
+    /// no bias towards small numbers.
+    fixed,
+};
+
+enum class FieldKind : std::uint8_t {
+    unsigned_integer,
+    signed_integer,
+    floating,
+};
+
+struct FieldInfo {
+    const char* name;
+    Encoding encoding;
+    FieldKind kind;
+    /// Size of the C++ type in bytes.
+    std::uint8_t width;
+};
+
+struct RecordInfo {
+    const char* name;
+    std::uint8_t id;
+    const FieldInfo* fields;
+    std::size_t field_count;
+};
+
+struct Schema {
+    const RecordInfo* records;
+    std::size_t record_count;
+    /// FNV-1a over every name, id, encoding and type in the schema.
+    std::uint32_t hash;
+};
+
+template <typename T>
+constexpr FieldKind kind_of() {
+    if constexpr (std::is_floating_point_v<T>) {
+        return FieldKind::floating;
+    } else if constexpr (std::is_signed_v<T>) {
+        return FieldKind::signed_integer;
+    } else {
+        return FieldKind::unsigned_integer;
+    }
+}
+
+/// Whether `T` can be stored with encoding `E`: integers (and bool) of up
+/// to 64 bits with any encoding except that uvarint needs an unsigned type
+/// and delta excludes bool; float and double only as fixed.
+template <Encoding E, typename T>
+constexpr bool valid_encoding() {
+    if constexpr (std::is_floating_point_v<T>) {
+        return E == Encoding::fixed && (sizeof(T) == 4 || sizeof(T) == 8);
+    } else if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+        if constexpr (E == Encoding::uvarint) {
+            return std::is_unsigned_v<T>;
+        } else if constexpr (E == Encoding::delta) {
+            return !std::is_same_v<T, bool>;
+        } else {
+            return true;
+        }
+    } else {
+        return false;
+    }
+}
+
+/// Worst-case encoded size of one field.
+template <Encoding E, typename T>
+constexpr std::size_t max_encoded_size() {
+    if constexpr (E == Encoding::fixed) {
+        return sizeof(T);
+    } else {
+        // ZigZag keeps the width: an n-bit value maps to n bits.
+        return (sizeof(T) * 8 + 6) / 7;
+    }
+}
+
+template <Encoding E, typename T>
+constexpr FieldInfo field_info(const char* name) {
+    return {name, E, kind_of<T>(), static_cast<std::uint8_t>(sizeof(T))};
+}
+
+namespace detail {
+
+constexpr std::uint32_t fnv1a(std::uint32_t hash, std::uint8_t byte) {
+    return (hash ^ byte) * 16777619u;
+}
+
+constexpr std::uint32_t fnv1a(std::uint32_t hash, const char* text) {
+    for (; *text != '\0'; ++text) {
+        hash = fnv1a(hash, static_cast<std::uint8_t>(*text));
+    }
+    return fnv1a(hash, std::uint8_t{0});
+}
+
+}  // namespace detail
+
+template <std::size_t N>
+constexpr std::uint32_t schema_hash(const RecordInfo (&records)[N]) {
+    std::uint32_t hash = 2166136261u;
+    for (const RecordInfo& r : records) {
+        hash = detail::fnv1a(hash, r.name);
+        hash = detail::fnv1a(hash, r.id);
+        for (std::size_t i = 0; i < r.field_count; ++i) {
+            const FieldInfo& f = r.fields[i];
+            hash = detail::fnv1a(hash, f.name);
+            hash = detail::fnv1a(hash, static_cast<std::uint8_t>(f.encoding));
+            hash = detail::fnv1a(hash, static_cast<std::uint8_t>(f.kind));
+            hash = detail::fnv1a(hash, f.width);
+        }
+    }
+    return hash;
+}
+
+template <std::size_t N>
+constexpr bool record_ids_valid(const RecordInfo (&records)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (records[i].id == kSchemaRecordId || records[i].id > kMaxRecordId) {
+            return false;
+        }
+        for (std::size_t j = 0; j < i; ++j) {
+            if (records[i].id == records[j].id) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <std::size_t N>
+constexpr Schema make_schema(const RecordInfo (&records)[N]) {
+    return {records, N, schema_hash(records)};
+}
+
+constexpr const char* to_string(Encoding encoding) {
+    switch (encoding) {
+    case Encoding::uvarint: return "uvarint";
+    case Encoding::svarint: return "svarint";
+    case Encoding::delta: return "delta";
+    case Encoding::fixed: return "fixed";
+    }
+    return "unknown";
+}
+
+}  // namespace nucleo::telemetry
@@ -0,0 +1,165 @@
+// Expands a telemetry schema file into record structs, an allocation-free
+// encoder and the descriptor table the host decoder reads. A schema header
+// names the schema file and the namespace to generate into, then includes
+// this file (which therefore has no include guard):
+//
+//   #pragma once
+//   #define NUCLEO_TELEMETRY_SCHEMA "nucleo/telemetry/board_schema.def"
+//   #define NUCLEO_TELEMETRY_NAMESPACE nucleo::telemetry::board
+//   #include "nucleo/telemetry/generate.hpp"
+//
+// The schema file lists records, each a run of fields closed by END:
+//
+//   NUCLEO_TELEMETRY_RECORD(AdcBlock, 2)             // id 1..127, never reused
+//   NUCLEO_TELEMETRY_FIELD(std::uint32_t, timestamp_us, delta)
+//   NUCLEO_TELEMETRY_FIELD(std::int16_t, mean, svarint)
+//   NUCLEO_TELEMETRY_END()
+//
+// and the namespace receives, per record, `struct AdcBlock` with one member
+// per field plus kId and kName, and kMaxRecordSize<AdcBlock>; for the whole
+// schema, kRecords, kSchema and class Encoder:
+//
+//   board::Encoder encoder;
+//   std::uint8_t buf[board::kMaxRecordSize<board::AdcBlock>];
+//   const std::size_t n = encoder.encode(board::AdcBlock{now, mean}, buf);
+//
+// Encoding choices are checked at compile time (valid_encoding()), as are
+// record ids. Changing a schema changes kSchema.hash, so a decoder built
+// from the old file rejects the stream instead of misreading it.
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/telemetry/encoding.hpp"
+#include "nucleo/telemetry/writer.hpp"
+
+#if !defined(NUCLEO_TELEMETRY_SCHEMA) || !defined(NUCLEO_TELEMETRY_NAMESPACE)
+#error "define NUCLEO_TELEMETRY_SCHEMA and NUCLEO_TELEMETRY_NAMESPACE before including generate.hpp"
+#endif
+
+namespace NUCLEO_TELEMETRY_NAMESPACE {
+
+// Record structs.
+#define NUCLEO_TELEMETRY_RECORD(Type, id)                                        \
+    struct Type {                                                                \
+        static_assert((id) > ::nucleo::telemetry::kSchemaRecordId &&             \
+                          (id) <= ::nucleo::telemetry::kMaxRecordId,             \
+                      "record ids are 1..127");                                  \
+        static constexpr std::uint8_t kId = (id);                                \
+        static constexpr const char* kName = #Type;
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding)                             \
+    static_assert(::nucleo::telemetry::valid_encoding<                           \
+                      ::nucleo::telemetry::Encoding::encoding, type>(),          \
+                  #name ": encoding does not fit the field type");               \
+    type name{};
+#define NUCLEO_TELEMETRY_END() };
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+
+// Worst-case encoded size of each record type.
+template <typename Record>
+inline constexpr std::size_t kMaxRecordSize = 0;
+#define NUCLEO_TELEMETRY_RECORD(Type, id) template <> inline constexpr std::size_t kMaxRecordSize<Type> = 1
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding) \
+    +::nucleo::telemetry::max_encoded_size<::nucleo::telemetry::Encoding::encoding, type>()
+#define NUCLEO_TELEMETRY_END() ;
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+
+// Field descriptors, one array per record.
+namespace fields {
+#define NUCLEO_TELEMETRY_RECORD(Type, id) inline constexpr ::nucleo::telemetry::FieldInfo Type[] = {
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding) \
+    ::nucleo::telemetry::field_info<::nucleo::telemetry::Encoding::encoding, type>(#name),
+#define NUCLEO_TELEMETRY_END() };
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+}  // namespace fields
+
+inline constexpr ::nucleo::telemetry::RecordInfo kRecords[] = {
+#define NUCLEO_TELEMETRY_RECORD(Type, id) {#Type, (id), fields::Type, std::size(fields::Type)},
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding)
+#define NUCLEO_TELEMETRY_END()
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+};
+static_assert(::nucleo::telemetry::record_ids_valid(kRecords), "record ids must be unique");
+
+inline constexpr ::nucleo::telemetry::Schema kSchema = ::nucleo::telemetry::make_schema(kRecords);
+
+/// Serialises records into caller buffers, keeping the previous value of
+/// every delta field. One encoder per stream: the decoder tracks the same
+/// state, so records from two encoders must not be interleaved.
+class Encoder {
+public:
+    /// A key record every `key_interval` records of each type bounds how
+    /// much a lost frame costs; 0 sends key records only after reset().
+    explicit Encoder(std::uint8_t key_interval = ::nucleo::telemetry::kDefaultKeyInterval)
+        : key_interval_(key_interval) {}
+
+    // std::size_t encode(const Record& record, ByteSpan out), per record:
+    // writes the record at the start of `out` and returns its size, or 0
+    // with nothing changed if `out` is shorter than it needs.
+    // kMaxRecordSize<Record> bytes always suffice.
+#define NUCLEO_TELEMETRY_RECORD(Type, id)                                                       \
+    std::size_t encode(const Type& record, ::nucleo::ByteSpan out) {                            \
+        auto& state = Type##_state_;                                                            \
+        ::nucleo::ByteWriter w(out);                                                            \
+        const bool key = ::nucleo::telemetry::begin_record(w, Type::kId, state.since_key, key_interval_);
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding) \
+    ::nucleo::telemetry::put<::nucleo::telemetry::Encoding::encoding>(w, record.name, state.last.name, key);
+#define NUCLEO_TELEMETRY_END()                                         \
+        return ::nucleo::telemetry::end_record(w, state, record, key); \
+    }
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+
+    /// Writes a schema record, then reset(). Send one when a decoder may
+    /// have just attached, e.g. at start-up and on reconnect.
+    std::size_t encode_schema(::nucleo::ByteSpan out) {
+        const std::size_t n = ::nucleo::telemetry::write_schema_record(out, kSchema.hash);
+        if (n != 0) {
+            reset();
+        }
+        return n;
+    }
+
+    /// Makes the next record of every type a key record, e.g. after the
+    /// transport dropped a frame.
+    void reset() {
+#define NUCLEO_TELEMETRY_RECORD(Type, id) Type##_state_.since_key = ::nucleo::telemetry::kNeedKey;
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding)
+#define NUCLEO_TELEMETRY_END()
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+    }
+
+private:
+    std::uint8_t key_interval_;
+#define NUCLEO_TELEMETRY_RECORD(Type, id) ::nucleo::telemetry::RecordState<Type> Type##_state_;
+#define NUCLEO_TELEMETRY_FIELD(type, name, encoding)
+#define NUCLEO_TELEMETRY_END()
+#include NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_RECORD
+#undef NUCLEO_TELEMETRY_FIELD
+#undef NUCLEO_TELEMETRY_END
+};
+
+}  // namespace NUCLEO_TELEMETRY_NAMESPACE
+
+#undef NUCLEO_TELEMETRY_SCHEMA
+#undef NUCLEO_TELEMETRY_NAMESPACE
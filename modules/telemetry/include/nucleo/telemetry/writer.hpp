@@ -0,0 +1,92 @@
+// Field writers used by the serializers that generate.hpp expands from a
+// schema file. Everything here is a template over the field type and
+// encoding, so each generated encode() compiles to straight-line stores
+// with no per-field dispatch.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/telemetry/encoding.hpp"
+
+namespace nucleo::telemetry {
+
+/// RecordState::since_key value that forces a key record.
+inline constexpr std::uint16_t kNeedKey = 0xFFFF;
+
+/// Per record type: the last values sent and the records since the last
+/// key record.
+template <typename Record>
+struct RecordState {
+    Record last{};
+    std::uint16_t since_key = kNeedKey;
+};
+
+template <Encoding E, typename T>
+void put(ByteWriter& w, T value, T previous, bool key) {
+    static_assert(valid_encoding<E, T>(), "encoding does not fit the field type");
+    if constexpr (E == Encoding::fixed) {
+        if constexpr (std::is_floating_point_v<T>) {
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> bits;
+            std::memcpy(&bits, &value, sizeof bits);
+            if constexpr (sizeof(T) == 4) {
+                w.u32(bits);
+            } else {
+                w.u64(bits);
+            }
+        } else if constexpr (sizeof(T) == 1) {
+            w.u8(static_cast<std::uint8_t>(value));
+        } else if constexpr (sizeof(T) == 2) {
+            w.u16(static_cast<std::uint16_t>(value));
+        } else if constexpr (sizeof(T) == 4) {
+            w.u32(static_cast<std::uint32_t>(value));
+        } else {
+            w.u64(static_cast<std::uint64_t>(value));
+        }
+    } else if constexpr (E == Encoding::uvarint) {
+        w.varint(static_cast<std::uint64_t>(value));
+    } else if constexpr (E == Encoding::svarint) {
+        w.svarint(static_cast<std::int64_t>(value));
+    } else {
+        // Wrapping difference at the field's own width, so a 32-bit
+        // timestamp that rolls over still costs one or two bytes.
+        using U = std::make_unsigned_t<T>;
+        const U base = key ? U{0} : static_cast<U>(previous);
+        const U diff = static_cast<U>(static_cast<U>(value) - base);
+        w.svarint(static_cast<std::make_signed_t<U>>(diff));
+    }
+}
+
+/// Writes the header byte. Returns whether this is a key record.
+inline bool begin_record(ByteWriter& w, std::uint8_t id, std::uint16_t since_key, std::uint8_t key_interval) {
+    const bool key = since_key == kNeedKey || (key_interval != 0 && since_key >= key_interval);
+    w.u8(static_cast<std::uint8_t>(key ? id | kKeyFlag : id));
+    return key;
+}
+
+/// Commits the record to the state if it fitted. Returns its size or 0.
+template <typename Record>
+std::size_t end_record(const ByteWriter& w, RecordState<Record>& state, const Record& record, bool key) {
+    if (!w.ok()) {
+        return 0;
+    }
+    state.last = record;
+    if (key) {
+        state.since_key = 1;
+    } else if (state.since_key < kNeedKey - 1) {
+        ++state.since_key;
+    }
+    return w.size();
+}
+
+inline std::size_t write_schema_record(ByteSpan out, std::uint32_t hash) {
+    ByteWriter w(out);
+    w.u8(kSchemaRecordId);
+    w.u8(kFormatVersion);
+    w.u32(hash);
+    return w.ok() ? w.size() : 0;
+}
+
+}  // namespace nucleo::telemetry
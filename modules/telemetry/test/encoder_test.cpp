@@ -0,0 +1,132 @@
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "nucleo/telemetry/board_schema.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo;
+using namespace nucleo::telemetry;
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+template <typename Record>
+Bytes encode(board::Encoder& encoder, const Record& record) {
+    std::uint8_t buf[board::kMaxRecordSize<Record>];
+    const std::size_t n = encoder.encode(record, buf);
+    return Bytes(buf, buf + n);
+}
+
+template <Encoding E, typename T>
+Bytes put_one(T value, T previous = T{}, bool key = true) {
+    std::uint8_t buf[16];
+    ByteWriter w(buf);
+    put<E>(w, value, previous, key);
+    return Bytes(buf, buf + w.size());
+}
+
+constexpr FieldInfo kFieldsA[] = {field_info<Encoding::delta, std::uint32_t>("t")};
+constexpr FieldInfo kFieldsB[] = {field_info<Encoding::uvarint, std::uint32_t>("t")};
+constexpr RecordInfo kSchemaA[] = {{"R", 1, kFieldsA, 1}};
+constexpr RecordInfo kSchemaB[] = {{"R", 1, kFieldsB, 1}};
+constexpr RecordInfo kDuplicateIds[] = {{"R", 1, kFieldsA, 1}, {"S", 1, kFieldsB, 1}};
+
+}  // namespace
+
+// Worst cases: 1 header byte, then 5 bytes per 32-bit varint, 3 per 16-bit,
+// 2 per 8-bit, sizeof(T) per fixed field.
+static_assert(board::kMaxRecordSize<board::AdcBlock> == 1 + 5 + 2 + 3 + 3 + 3 + 3);
+static_assert(board::kMaxRecordSize<board::Power> == 1 + 5 + 3 + 5 + 4);
+static_assert(board::kSchema.record_count == 4);
+static_assert(schema_hash(kSchemaA) != schema_hash(kSchemaB));
+static_assert(!record_ids_valid(kDuplicateIds));
+
+TEST(descriptor_table_matches_the_schema_file) {
+    CHECK_EQ(std::strcmp(board::kRecords[1].name, "AdcBlock"), 0);
+    CHECK_EQ(board::kRecords[1].id, board::AdcBlock::kId);
+    REQUIRE_EQ(board::kRecords[1].field_count, 6u);
+    const FieldInfo& mean = board::kRecords[1].fields[4];
+    CHECK_EQ(std::strcmp(mean.name, "mean"), 0);
+    CHECK(mean.encoding == Encoding::delta);
+    CHECK(mean.kind == FieldKind::signed_integer);
+    CHECK_EQ(mean.width, 2u);
+    CHECK(board::kRecords[3].fields[3].kind == FieldKind::floating);
+}
+
+TEST(first_record_is_a_key_record_and_later_ones_carry_deltas) {
+    board::Encoder encoder;
+    const Bytes key = encode(encoder, board::Status{1000, 2, 0, 5, 0});
+    // Header with the key flag; 1000 zigzags to 2000 = 0xD0 0x0F.
+    CHECK(key == (Bytes{0x81, 0xD0, 0x0F, 0x04, 0x00, 0x0A, 0x00}));
+    const Bytes delta = encode(encoder, board::Status{2000, 4, 1, 5, 0});
+    CHECK(delta == (Bytes{0x01, 0xD0, 0x0F, 0x04, 0x01, 0x00, 0x00}));
+}
+
+TEST(deltas_wrap_at_the_field_width) {
+    board::Encoder encoder;
+    (void)encode(encoder, board::Power{0xFFFFFFF0u, 3300, -5, 25.0f});
+    const Bytes b = encode(encoder, board::Power{0x10, 3299, -5, 25.0f});
+    // +32 ms across the wrap, -1 mV, -5 uA, then the float's bits.
+    CHECK(b == (Bytes{0x04, 0x40, 0x01, 0x09, 0x00, 0x00, 0xC8, 0x41}));
+}
+
+TEST(key_records_repeat_at_the_interval_and_after_reset) {
+    board::Encoder encoder(4);
+    Bytes headers;
+    for (std::uint32_t i = 0; i < 9; ++i) {
+        headers.push_back(encode(encoder, board::AdcBlock{i * 500, 1, 0, 0, 0, 0})[0]);
+    }
+    CHECK(headers == (Bytes{0x82, 0x02, 0x02, 0x02, 0x82, 0x02, 0x02, 0x02, 0x82}));
+
+    // Other record types keep their own count.
+    CHECK_EQ(encode(encoder, board::Status{})[0], 0x81);
+    CHECK_EQ(encode(encoder, board::AdcBlock{})[0], 0x02);
+    encoder.reset();
+    CHECK_EQ(encode(encoder, board::AdcBlock{})[0], 0x82);
+
+    board::Encoder manual(0);
+    CHECK_EQ(encode(manual, board::Status{})[0], 0x81);
+    for (int i = 0; i < 300; ++i) {
+        CHECK_EQ(encode(manual, board::Status{})[0], 0x01);
+    }
+}
+
+TEST(schema_record_carries_the_hash_and_forces_key_records) {
+    board::Encoder encoder;
+    (void)encode(encoder, board::LoopTiming{});
+    std::uint8_t buf[kSchemaRecordSize];
+    REQUIRE_EQ(encoder.encode_schema(buf), kSchemaRecordSize);
+    CHECK_EQ(buf[0], kSchemaRecordId);
+    CHECK_EQ(buf[1], kFormatVersion);
+    std::uint32_t hash = 0;
+    std::memcpy(&hash, buf + 2, 4);
+    CHECK_EQ(hash, board::kSchema.hash);
+    CHECK_EQ(encode(encoder, board::LoopTiming{})[0], 0x83);
+}
+
+TEST(short_buffer_writes_nothing_and_keeps_state) {
+    board::Encoder encoder;
+    std::uint8_t small[3];
+    CHECK_EQ(encoder.encode(board::Status{123456, 1, 0, 0, 0}, small), 0u);
+    // Still the first record, so still a key record.
+    const Bytes b = encode(encoder, board::Status{123456, 1, 0, 0, 0});
+    CHECK_EQ(b[0], 0x81);
+    CHECK_EQ(encoder.encode_schema(ByteSpan{small, sizeof small}), 0u);
+}
+
+TEST(field_encodings) {
+    CHECK(put_one<Encoding::uvarint>(std::numeric_limits<std::uint64_t>::max()).size() == 10);
+    CHECK(put_one<Encoding::svarint>(std::numeric_limits<std::int64_t>::min()).size() == 10);
+    CHECK(put_one<Encoding::svarint>(std::int8_t{-1}) == (Bytes{0x01}));
+    CHECK(put_one<Encoding::uvarint>(true) == (Bytes{0x01}));
+    CHECK(put_one<Encoding::fixed>(false) == (Bytes{0x00}));
+    CHECK(put_one<Encoding::fixed>(std::uint16_t{0x1234}) == (Bytes{0x34, 0x12}));
+    CHECK(put_one<Encoding::fixed>(std::int32_t{-2}) == (Bytes{0xFE, 0xFF, 0xFF, 0xFF}));
+    CHECK(put_one<Encoding::fixed>(1.0) == (Bytes{0, 0, 0, 0, 0, 0, 0xF0, 0x3F}));
+    // 127 -> -128 is one step at 8 bits.
+    CHECK(put_one<Encoding::delta>(std::int8_t{-128}, std::int8_t{127}, false) == (Bytes{0x02}));
+    CHECK(put_one<Encoding::delta>(std::int8_t{-128}, std::int8_t{127}, true) == (Bytes{0xFF, 0x01}));
+    CHECK(put_one<Encoding::delta>(std::uint64_t{0}, std::uint64_t{1}, false) == (Bytes{0x01}));
+}
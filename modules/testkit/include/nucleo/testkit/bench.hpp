@@ -0,0 +1,86 @@
+// Host microbenchmark harness.
+//
+// Every benchmark binary accepts --quick (shortened run used by CTest) and
+// prints one line per measurement so results can be diffed between commits:
+//
+//   bench  ring_push_pop          p50 12.1 ns  p99 14.0 ns  max 220.3 ns  (2000 samples)
+//   metric uart_throughput        41.87 MB/s
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nucleo::testkit {
+
+struct Summary {
+    double min = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+    double mean = 0;
+    std::size_t samples = 0;
+};
+
+/// Sorts `samples` in place and returns order statistics.
+Summary summarize(std::vector<double>& samples);
+
+inline std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+/// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+class Bench {
+public:
+    Bench(int argc, char** argv);
+
+    bool quick() const { return quick_; }
+
+    /// Full-length count, or a hundredth of it (at least 1) under --quick.
+    std::size_t scale(std::size_t full) const;
+
+    /// Times `batch` calls of fn() per sample and reports per-call latency.
+    template <typename Fn>
+    Summary run(const char* name, std::size_t batch, Fn&& fn) {
+        const std::size_t sample_count = scale(2000);
+        for (std::size_t i = 0; i < batch; ++i) {
+            fn();  // warm caches and branch predictors
+        }
+        std::vector<double> samples;
+        samples.reserve(sample_count);
+        for (std::size_t s = 0; s < sample_count; ++s) {
+            const std::uint64_t start = now_ns();
+            for (std::size_t i = 0; i < batch; ++i) {
+                fn();
+            }
+            const std::uint64_t end = now_ns();
+            samples.push_back(static_cast<double>(end - start) / static_cast<double>(batch));
+        }
+        Summary summary = summarize(samples);
+        report(name, summary, "ns");
+        return summary;
+    }
+
+    /// Prints a distribution measured by the caller.
+    void report(const char* name, const Summary& summary, const char* unit) const;
+
+    /// Prints a single derived figure (throughput, ratio, ...).
+    void metric(const char* name, double value, const char* unit) const;
+
+private:
+    bool quick_ = false;
+};
+
+}  // namespace nucleo::testkit
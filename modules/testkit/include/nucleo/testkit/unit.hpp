@@ -0,0 +1,83 @@
+// Minimal self-registering unit test framework for the host build.
+//
+//   TEST(ring_wraps_around) {
+//       CHECK_EQ(ring.size(), 3u);
+//       REQUIRE(ok);  // returns from the test on failure
+//   }
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace nucleo::testkit {
+
+using TestFn = void (*)();
+
+struct Registrar {
+    Registrar(const char* name, TestFn fn);
+};
+
+/// Records a failed check against the running test.
+void fail(const char* file, int line, const std::string& message);
+
+template <typename T, typename = void>
+struct IsStreamable : std::false_type {};
+template <typename T>
+struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>>
+    : std::true_type {};
+
+template <typename T>
+std::string describe(const T& value) {
+    std::ostringstream out;
+    if constexpr (std::is_enum_v<T>) {
+        out << static_cast<long long>(value);
+    } else if constexpr (std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::int8_t>) {
+        out << static_cast<int>(value);
+    } else if constexpr (IsStreamable<T>::value) {
+        out << value;
+    } else {
+        out << "<" << sizeof(T) << "-byte value>";
+    }
+    return out.str();
+}
+
+template <typename A, typename B>
+bool check_eq(const char* file, int line, const char* a_expr, const char* b_expr, const A& a,
+              const B& b) {
+    if (a == b) {
+        return true;
+    }
+    fail(file, line,
+         std::string(a_expr) + " == " + b_expr + " (" + describe(a) + " vs " + describe(b) + ")");
+    return false;
+}
+
+}  // namespace nucleo::testkit
+
+#define NUCLEO_TESTKIT_CAT2(a, b) a##b
+#define NUCLEO_TESTKIT_CAT(a, b) NUCLEO_TESTKIT_CAT2(a, b)
+
+#define TEST(name)                                                                          \
+    static void name();                                                                     \
+    static const ::nucleo::testkit::Registrar NUCLEO_TESTKIT_CAT(name, _registrar){#name,   \
+                                                                                  &name};  \
+    static void name()
+
+#define CHECK(expr)                                                 \
+    ((expr) ? true : (::nucleo::testkit::fail(__FILE__, __LINE__, #expr), false))
+
+#define CHECK_EQ(a, b) ::nucleo::testkit::check_eq(__FILE__, __LINE__, #a, #b, (a), (b))
+
+#define REQUIRE(expr)     \
+    do {                  \
+        if (!CHECK(expr)) \
+            return;       \
+    } while (0)
+
+#define REQUIRE_EQ(a, b)     \
+    do {                     \
+        if (!CHECK_EQ(a, b)) \
+            return;          \
+    } while (0)
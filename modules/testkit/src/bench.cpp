@@ -0,0 +1,56 @@
+#include "nucleo/testkit/bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace nucleo::testkit {
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+    const std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+}  // namespace
+
+Summary summarize(std::vector<double>& samples) {
+    Summary s;
+    if (samples.empty()) {
+        return s;
+    }
+    std::sort(samples.begin(), samples.end());
+    s.samples = samples.size();
+    s.min = samples.front();
+    s.max = samples.back();
+    s.p50 = percentile(samples, 0.50);
+    s.p90 = percentile(samples, 0.90);
+    s.p99 = percentile(samples, 0.99);
+    s.p999 = percentile(samples, 0.999);
+    s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    return s;
+}
+
+Bench::Bench(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick_ = true;
+        }
+    }
+}
+
+std::size_t Bench::scale(std::size_t full) const {
+    return quick_ ? std::max<std::size_t>(1, full / 100) : full;
+}
+
+void Bench::report(const char* name, const Summary& s, const char* unit) const {
+    std::printf("bench  %-34s p50 %9.1f %s  p99 %9.1f %s  max %10.1f %s  (%zu samples)\n", name,
+                s.p50, unit, s.p99, unit, s.max, unit, s.samples);
+}
+
+void Bench::metric(const char* name, double value, const char* unit) const {
+    std::printf("metric %-34s %12.2f %s\n", name, value, unit);
+}
+
+}  // namespace nucleo::testkit
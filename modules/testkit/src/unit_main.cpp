@@ -0,0 +1,57 @@
+// Test runner: runs every registered TEST, optionally filtered by a
+// substring given on the command line.
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "nucleo/testkit/unit.hpp"
+
+namespace nucleo::testkit {
+namespace {
+
+struct Entry {
+    const char* name;
+    TestFn fn;
+};
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+int g_failures_in_test = 0;
+
+}  // namespace
+
+Registrar::Registrar(const char* name, TestFn fn) { registry().push_back({name, fn}); }
+
+void fail(const char* file, int line, const std::string& message) {
+    ++g_failures_in_test;
+    std::fprintf(stderr, "  %s:%d: check failed: %s\n", file, line, message.c_str());
+}
+
+}  // namespace nucleo::testkit
+
+int main(int argc, char** argv) {
+    using namespace nucleo::testkit;
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    int failed = 0;
+    for (const Entry& test : registry()) {
+        if (filter != nullptr && std::strstr(test.name, filter) == nullptr) {
+            continue;
+        }
+        g_failures_in_test = 0;
+        test.fn();
+        ++run;
+        if (g_failures_in_test != 0) {
+            ++failed;
+            std::printf("[FAIL] %s\n", test.name);
+        } else {
+            std::printf("[ ok ] %s\n", test.name);
+        }
+    }
+    std::printf("%d/%d tests passed\n", run - failed, run);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// UART receive path benchmarks.
+//
+//  * framing cost: COBS encode/decode per 64-byte frame
+//  * pipeline cost: simulated DMA delivery + drain + decode, single thread,
+//    expressed as the line rate one core could sustain
+//  * streaming: a producer thread plays the DMA/ISR at a given baud rate in
+//    real time while the consumer thread drains and decodes; reports
+//    sustained payload throughput, overruns and idle-to-frame latency
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "nucleo/testkit/bench.hpp"
+#include "nucleo/uart/cobs.hpp"
+#include "nucleo/uart/host/sim_uart.hpp"
+#include "nucleo/uart/uart.hpp"
+
+using namespace nucleo;
+using namespace nucleo::uart;
+using testkit::now_ns;
+
+namespace {
+
+constexpr std::size_t kPayload = 64;
+
+std::vector<std::uint8_t> make_frame(std::uint32_t seq) {
+    std::array<std::uint8_t, kPayload> payload{};
+    std::memcpy(payload.data(), &seq, sizeof seq);
+    for (std::size_t i = sizeof seq; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::uint8_t>(seq * 31 + i);
+    }
+    std::vector<std::uint8_t> out(cobs_encoded_size_max(kPayload));
+    out.resize(cobs_encode(payload, ByteSpan{out.data(), out.size()}));
+    return out;
+}
+
+void bench_framing(testkit::Bench& bench) {
+    std::array<std::uint8_t, kPayload> payload{};
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::uint8_t>(i * 7);  // includes zeros
+    }
+    std::array<std::uint8_t, cobs_encoded_size_max(kPayload)> encoded{};
+    bench.run("cobs_encode_64B", 256, [&] {
+        testkit::do_not_optimize(cobs_encode(payload, encoded));
+    });
+
+    const std::size_t n = cobs_encode(payload, encoded);
+    std::array<std::uint8_t, kPayload> frame{};
+    CobsDecoder decoder(frame);
+    bench.run("cobs_stream_decode_64B", 256, [&] {
+        decoder.feed(ConstByteSpan{encoded.data(), n}, [](ConstByteSpan f) { testkit::do_not_optimize(f); });
+    });
+}
+
+void bench_pipeline(testkit::Bench& bench) {
+    static std::array<std::uint8_t, 4096> rx{};
+    static std::array<std::uint8_t, 256> tx{};
+    host::SimUart sim;
+    Uart driver(sim, rx, tx);
+    driver.start(12'000'000);
+
+    std::vector<std::uint8_t> burst;
+    for (std::uint32_t i = 0; i < 16; ++i) {
+        const auto f = make_frame(i);
+        burst.insert(burst.end(), f.begin(), f.end());
+    }
+    std::array<std::uint8_t, kPayload> frame{};
+    CobsDecoder decoder(frame);
+    const auto summary = bench.run("dma_drain_decode_16_frames", 16, [&] {
+        sim.receive(ConstByteSpan{burst.data(), burst.size()});
+        driver.rx_drain([&](ConstByteSpan span) {
+            decoder.feed(span, [](ConstByteSpan f) { testkit::do_not_optimize(f); });
+        });
+    });
+    const double ns_per_byte = summary.p50 / static_cast<double>(burst.size());
+    bench.metric("pipeline_ns_per_byte", ns_per_byte, "ns/B");
+    bench.metric("pipeline_max_line_rate_one_core", 10.0 / ns_per_byte * 1e3, "Mbaud");
+}
+
+void bench_streaming(testkit::Bench& bench, std::uint32_t baud) {
+    static std::array<std::uint8_t, 16384> rx{};
+    static std::array<std::uint8_t, 256> tx{};
+    host::SimUart sim;
+    Uart driver(sim, rx, tx);
+    driver.start(baud);
+
+    const std::uint64_t duration_ns = bench.quick() ? 20'000'000ull : 1'000'000'000ull;
+    const auto frame0 = make_frame(0);
+    const double frame_ns = sim.wire_time_s(frame0.size()) * 1e9;
+    const std::size_t frame_count = static_cast<std::size_t>(duration_ns / frame_ns) + 1;
+
+    std::vector<std::vector<std::uint8_t>> frames;
+    frames.reserve(frame_count);
+    for (std::uint32_t i = 0; i < frame_count; ++i) {
+        frames.push_back(make_frame(i));
+    }
+    std::vector<std::atomic<std::uint64_t>> arrival(frame_count);
+    std::vector<double> latency_us;
+    latency_us.reserve(frame_count);
+    std::atomic<bool> done{false};
+
+    std::thread consumer([&] {
+        std::array<std::uint8_t, kPayload> frame{};
+        CobsDecoder decoder(frame);
+        while (!done.load(std::memory_order_acquire) || driver.rx_available() != 0) {
+            const RxDrain drained = driver.rx_drain([&](ConstByteSpan span) {
+                decoder.feed(span, [&](ConstByteSpan f) {
+                    std::uint32_t seq;
+                    std::memcpy(&seq, f.data(), sizeof seq);
+                    const std::uint64_t t = now_ns();
+                    if (seq < frame_count) {
+                        latency_us.push_back(static_cast<double>(t - arrival[seq].load()) / 1e3);
+                    }
+                });
+            });
+            if (drained.overrun) {
+                decoder.reset();
+            }
+            if (drained.bytes == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    const std::uint64_t start = now_ns();
+    for (std::size_t i = 0; i < frame_count; ++i) {
+        const std::uint64_t due = start + static_cast<std::uint64_t>(frame_ns * static_cast<double>(i + 1));
+        while (now_ns() < due) {
+            std::this_thread::yield();
+        }
+        arrival[i].store(now_ns(), std::memory_order_relaxed);
+        sim.receive(ConstByteSpan{frames[i].data(), frames[i].size()});
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    const double elapsed_s = static_cast<double>(now_ns() - start) / 1e9;
+
+    char name[64];
+    std::snprintf(name, sizeof name, "stream_%uMbaud_idle_to_frame", baud / 1'000'000);
+    bench.report(name, testkit::summarize(latency_us), "us");
+    std::snprintf(name, sizeof name, "stream_%uMbaud_payload_throughput", baud / 1'000'000);
+    bench.metric(name, static_cast<double>(latency_us.size() * kPayload) / elapsed_s / 1e6, "MB/s");
+    std::snprintf(name, sizeof name, "stream_%uMbaud_frames_lost", baud / 1'000'000);
+    bench.metric(name, static_cast<double>(frame_count - latency_us.size()), "frames");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    bench_framing(bench);
+    bench_pipeline(bench);
+    for (const std::uint32_t baud : {2'000'000u, 4'000'000u, 8'000'000u, 12'000'000u}) {
+        bench_streaming(bench, baud);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "nucleo/uart/host/sim_uart.hpp"
+
+#include <cstring>
+
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+namespace nucleo::uart {
+namespace host {
+
+Status SimUart::start(Uart& owner, std::uint32_t baud, ByteSpan rx_buffer) {
+    owner_ = &owner;
+    baud_ = baud;
+    rx_buffer_ = rx_buffer;
+    dma_index_ = 0;
+    last_event_index_ = 0;
+    tx_pending_ = {};
+    return Status::ok;
+}
+
+void SimUart::start_tx(ConstByteSpan data) { tx_pending_ = data; }
+
+void SimUart::receive(ConstByteSpan bytes, bool idle) {
+    if (owner_ == nullptr || rx_buffer_.empty()) {
+        return;
+    }
+    const std::size_t size = rx_buffer_.size();
+    const std::size_t half = size / 2;
+    std::size_t offset = 0;
+    while (offset < bytes.size()) {
+        // Copy up to the next half/full boundary, where the DMA raises an event.
+        const std::size_t boundary = dma_index_ < half ? half : size;
+        std::size_t n = boundary - dma_index_;
+        if (n > bytes.size() - offset) {
+            n = bytes.size() - offset;
+        }
+        std::memcpy(rx_buffer_.data() + dma_index_, bytes.data() + offset, n);
+        dma_index_ += n;
+        offset += n;
+        if (dma_index_ == size) {
+            dma_index_ = 0;
+            rx_event(0);
+        } else if (dma_index_ == half) {
+            rx_event(half);
+        }
+    }
+    if (idle && dma_index_ != last_event_index_) {
+        rx_event(dma_index_);
+    }
+}
+
+void SimUart::rx_event(std::size_t index) {
+    last_event_index_ = index;
+    platform::host::IsrScope isr;
+    owner_->isr_rx_position(index);
+}
+
+void SimUart::inject_line_error(LineError error) {
+    platform::host::IsrScope isr;
+    owner_->isr_line_error(error);
+}
+
+bool SimUart::complete_tx() {
+    if (tx_pending_.empty()) {
+        return false;
+    }
+    transmitted_.insert(transmitted_.end(), tx_pending_.begin(), tx_pending_.end());
+    tx_pending_ = {};
+    platform::host::IsrScope isr;
+    owner_->isr_tx_done();
+    return true;
+}
+
+void SimUart::flush_tx() {
+    while (complete_tx()) {
+    }
+}
+
+SimUart& vcp_sim() {
+    static SimUart sim;
+    return sim;
+}
+
+}  // namespace host
+
+UartPort& vcp_port() { return host::vcp_sim(); }
+
+}  // namespace nucleo::uart
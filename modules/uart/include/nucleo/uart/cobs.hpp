@@ -0,0 +1,116 @@
+// COBS (Consistent Overhead Byte Stuffing) framing for the serial link.
+//
+// Frames are COBS-encoded and terminated by 0x00, so a receiver can
+// resynchronise on the next zero byte after an overrun or line error. The
+// overhead is one byte per 254 bytes of payload plus the delimiter.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::uart {
+
+/// Encoded size of `payload_size` bytes, including the trailing delimiter.
+constexpr std::size_t cobs_encoded_size_max(std::size_t payload_size) {
+    return payload_size + payload_size / 254 + 2;
+}
+
+/// Encodes `payload` into `out` and appends the 0x00 delimiter. Returns the
+/// number of bytes written, or 0 if `out` is too small.
+std::size_t cobs_encode(ConstByteSpan payload, ByteSpan out);
+
+/// Decodes one encoded frame (without delimiter) into `out`. Returns the
+/// payload size, or 0 on malformed input or overflow.
+std::size_t cobs_decode(ConstByteSpan encoded, ByteSpan out);
+
+/// Incremental decoder for a byte stream split at arbitrary points, such as
+/// the regions handed out by Uart::rx_drain(). Data bytes are moved in runs
+/// (one memcpy per COBS block) rather than one at a time.
+class CobsDecoder {
+public:
+    /// Decoded frames are assembled in `frame_buffer`; longer frames are
+    /// counted as errors and dropped.
+    explicit CobsDecoder(ByteSpan frame_buffer) : buffer_(frame_buffer) {}
+
+    /// Consumes `bytes` and calls on_frame(ConstByteSpan payload) for every
+    /// completed frame. The payload view is valid only during the call.
+    template <typename Fn>
+    void feed(ConstByteSpan bytes, Fn&& on_frame) {
+        const std::uint8_t* p = bytes.data();
+        const std::uint8_t* const end = p + bytes.size();
+        while (p < end) {
+            if (remaining_ == 0) {
+                const std::uint8_t code = *p++;
+                if (code == 0) {
+                    if (!discard_ && length_ != 0) {
+                        ++frames_;
+                        on_frame(ConstByteSpan{buffer_.data(), length_});
+                    }
+                    reset();
+                    continue;
+                }
+                if (zero_pending_) {
+                    append(&kZero, 1);
+                }
+                zero_pending_ = code != 0xFF;
+                remaining_ = static_cast<std::uint8_t>(code - 1);
+                continue;
+            }
+            std::size_t run = static_cast<std::size_t>(end - p);
+            if (run > remaining_) {
+                run = remaining_;
+            }
+            const void* delimiter = std::memchr(p, 0, run);
+            if (NUCLEO_UNLIKELY(delimiter != nullptr)) {
+                // Frame cut short (lost bytes): drop it and restart after the zero.
+                ++errors_;
+                reset();
+                p = static_cast<const std::uint8_t*>(delimiter) + 1;
+                continue;
+            }
+            append(p, run);
+            p += run;
+            remaining_ = static_cast<std::uint8_t>(remaining_ - run);
+        }
+    }
+
+    /// Forgets any partial frame, e.g. after the driver reported an overrun.
+    void reset() {
+        length_ = 0;
+        remaining_ = 0;
+        zero_pending_ = false;
+        discard_ = false;
+    }
+
+    std::uint32_t frames() const { return frames_; }
+    std::uint32_t errors() const { return errors_; }
+
+private:
+    static constexpr std::uint8_t kZero = 0;
+
+    void append(const std::uint8_t* data, std::size_t count) {
+        if (discard_) {
+            return;
+        }
+        if (NUCLEO_UNLIKELY(length_ + count > buffer_.size())) {
+            ++errors_;
+            discard_ = true;
+            return;
+        }
+        std::memcpy(buffer_.data() + length_, data, count);
+        length_ += count;
+    }
+
+    ByteSpan buffer_;
+    std::size_t length_ = 0;
+    std::uint8_t remaining_ = 0;  // data bytes left in the current block
+    bool zero_pending_ = false;   // a zero goes between this block and the next
+    bool discard_ = false;
+    std::uint32_t frames_ = 0;
+    std::uint32_t errors_ = 0;
+};
+
+}  // namespace nucleo::uart
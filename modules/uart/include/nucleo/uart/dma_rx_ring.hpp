@@ -0,0 +1,112 @@
+// Zero-copy receive ring over a circular DMA buffer.
+//
+// The DMA controller is the producer: it writes bytes into the buffer
+// continuously and the driver's interrupt handler (half-transfer,
+// transfer-complete, idle line) publishes the hardware write index with
+// publish(). The consumer reads the bytes in place with read_span() and
+// releases them with consume(). Nothing is copied in the interrupt.
+//
+// Because the hardware cannot be back-pressured, the consumer may fall a
+// full lap behind. That is detected on the consumer side (head - tail >
+// capacity) and resolved by dropping everything pending; framing above
+// resynchronises on the next delimiter.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/uart/spsc_ring.hpp"
+
+namespace nucleo::uart {
+
+class DmaRxRing {
+public:
+    /// `buffer.size()` must be a power of two.
+    void reset(ByteSpan buffer) {
+        buffer_ = buffer;
+        mask_ = static_cast<std::uint32_t>(buffer.size() - 1);
+        last_index_ = 0;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        overruns_.store(0, std::memory_order_relaxed);
+        dropped_bytes_.store(0, std::memory_order_relaxed);
+    }
+
+    bool valid() const { return is_power_of_two(buffer_.size()); }
+    std::size_t capacity() const { return buffer_.size(); }
+    std::uint8_t* dma_buffer() const { return buffer_.data(); }
+
+    // ---- producer (interrupt) side ----
+
+    /// Publishes everything the DMA wrote up to `write_index`. Must be called
+    /// at least twice per lap (half and full transfer) so the distance since
+    /// the previous call is unambiguous.
+    NUCLEO_ALWAYS_INLINE void publish(std::size_t write_index) {
+        const std::uint32_t index = static_cast<std::uint32_t>(write_index);
+        const std::uint32_t delta = (index - last_index_) & mask_;
+        last_index_ = index;
+        head_.store(head_.load(std::memory_order_relaxed) + delta, std::memory_order_release);
+    }
+
+    /// Total bytes published since reset().
+    std::uint32_t received() const { return head_.load(std::memory_order_acquire); }
+
+    // ---- consumer side ----
+
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+    /// Contiguous readable bytes, in place in the DMA buffer.
+    ConstByteSpan read_span() {
+        std::uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const std::uint32_t head = head_.load(std::memory_order_acquire);
+        std::size_t used = head - tail;
+        if (NUCLEO_UNLIKELY(used > capacity())) {
+            drop(head - tail);
+            tail = head;
+            tail_.store(tail, std::memory_order_relaxed);
+            used = 0;
+        }
+        const std::size_t offset = tail & mask_;
+        const std::size_t until_wrap = capacity() - offset;
+        return {buffer_.data() + offset, used < until_wrap ? used : until_wrap};
+    }
+
+    /// Releases bytes returned by read_span(). Returns false when the DMA
+    /// lapped the consumer while it was reading them; the bytes just handed
+    /// out may have been overwritten and the overrun counter is bumped.
+    bool consume(std::size_t count) {
+        const std::uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const std::uint32_t head = head_.load(std::memory_order_acquire);
+        tail_.store(tail + static_cast<std::uint32_t>(count), std::memory_order_relaxed);
+        if (NUCLEO_UNLIKELY(head - tail > capacity())) {
+            overruns_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /// Number of times the consumer fell a full lap behind.
+    std::uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+    /// Bytes discarded by overrun recovery.
+    std::uint32_t dropped_bytes() const { return dropped_bytes_.load(std::memory_order_relaxed); }
+
+private:
+    void drop(std::uint32_t count) {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+        dropped_bytes_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    ByteSpan buffer_;
+    std::uint32_t mask_ = 0;
+    std::uint32_t last_index_ = 0;  // interrupt-side only
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> head_{0};
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> tail_{0};
+    std::atomic<std::uint32_t> overruns_{0};
+    std::atomic<std::uint32_t> dropped_bytes_{0};
+};
+
+}  // namespace nucleo::uart
@@ -0,0 +1,60 @@
+// Simulated UART peripheral with circular-DMA semantics (host only).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "nucleo/uart/port.hpp"
+#include "nucleo/uart/uart.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/uart/host/sim_uart.hpp is only available in host builds"
+#endif
+
+namespace nucleo::uart::host {
+
+class SimUart final : public UartPort {
+public:
+    Status start(Uart& owner, std::uint32_t baud, ByteSpan rx_buffer) override;
+    void start_tx(ConstByteSpan data) override;
+
+    /// Delivers bytes from the line exactly as the GPDMA would: written into
+    /// the receive buffer in order, with a half-transfer event at the
+    /// midpoint, a transfer-complete event at the end of the buffer and,
+    /// when `idle` is set, an idle-line event after the last byte. Events
+    /// run as simulated interrupts and may come from any thread.
+    void receive(ConstByteSpan bytes, bool idle = true);
+
+    void inject_line_error(LineError error);
+
+    /// Finishes the transmit DMA in flight, appending its bytes to
+    /// transmitted(). Returns false if nothing was in flight.
+    bool complete_tx();
+
+    /// Completes transfers until the driver stops starting new ones.
+    void flush_tx();
+
+    bool tx_busy() const { return !tx_pending_.empty(); }
+    const std::vector<std::uint8_t>& transmitted() const { return transmitted_; }
+    void clear_transmitted() { transmitted_.clear(); }
+
+    std::uint32_t baud() const { return baud_; }
+    /// Seconds the line needs for `bytes` at the configured baud (8N1).
+    double wire_time_s(std::size_t bytes) const { return static_cast<double>(bytes) * 10.0 / baud_; }
+
+private:
+    void rx_event(std::size_t index);
+
+    Uart* owner_ = nullptr;
+    ByteSpan rx_buffer_;
+    std::size_t dma_index_ = 0;
+    std::size_t last_event_index_ = 0;
+    std::uint32_t baud_ = 0;
+    ConstByteSpan tx_pending_;
+    std::vector<std::uint8_t> transmitted_;
+};
+
+/// The simulated VCP, same object as vcp_port() in host builds.
+SimUart& vcp_sim();
+
+}  // namespace nucleo::uart::host
@@ -0,0 +1,38 @@
+// Hardware half of a UART driver.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::uart {
+
+class Uart;
+
+enum class LineError : std::uint8_t {
+    overrun,  ///< receiver shift register overrun (DMA starved)
+    framing,
+    noise,
+    parity,
+};
+
+/// Implemented by the USART3/GPDMA driver on the target and by SimUart on
+/// the host. Calls are per DMA transfer, never per byte.
+class UartPort {
+public:
+    /// Configures the line and starts circular DMA reception into
+    /// `rx_buffer`. From then on the port reports the DMA write index through
+    /// owner.isr_rx_position() on half-transfer, transfer-complete and idle
+    /// line, and transmit completions through owner.isr_tx_done().
+    virtual Status start(Uart& owner, std::uint32_t baud, ByteSpan rx_buffer) = 0;
+
+    /// Starts transmitting `data` by DMA. The bytes stay untouched by the
+    /// driver until the port calls owner.isr_tx_done().
+    virtual void start_tx(ConstByteSpan data) = 0;
+
+protected:
+    ~UartPort() = default;
+};
+
+}  // namespace nucleo::uart
@@ -0,0 +1,117 @@
+// Lock-free single-producer/single-consumer byte ring over caller storage.
+//
+// head_ and tail_ are free-running byte counters; the storage index is the
+// counter masked by capacity - 1, so capacity must be a power of two. The
+// producer only stores head_, the consumer only stores tail_, and each side
+// publishes with release / observes with acquire. No interrupt masking is
+// needed when the two sides are an ISR and thread code.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::uart {
+
+constexpr bool is_power_of_two(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+class SpscRing {
+public:
+    SpscRing() = default;
+    /// `storage.size()` must be a power of two; check valid() afterwards.
+    explicit SpscRing(ByteSpan storage) { reset(storage); }
+
+    void reset(ByteSpan storage) {
+        storage_ = storage;
+        mask_ = static_cast<std::uint32_t>(storage.size() - 1);
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    bool valid() const { return is_power_of_two(storage_.size()); }
+    std::size_t capacity() const { return storage_.size(); }
+
+    std::size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    std::size_t free() const { return capacity() - size(); }
+    bool empty() const { return size() == 0; }
+
+    // ---- producer side ----
+
+    /// Largest contiguous writable region; may be shorter than free() at the wrap.
+    ByteSpan write_span() const {
+        const std::uint32_t head = head_.load(std::memory_order_relaxed);
+        const std::uint32_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t free_bytes = capacity() - (head - tail);
+        const std::size_t offset = head & mask_;
+        const std::size_t until_wrap = capacity() - offset;
+        return {storage_.data() + offset, free_bytes < until_wrap ? free_bytes : until_wrap};
+    }
+
+    /// Publishes `count` bytes written into write_span().
+    void commit(std::size_t count) {
+        head_.store(head_.load(std::memory_order_relaxed) + static_cast<std::uint32_t>(count),
+                    std::memory_order_release);
+    }
+
+    /// Copies as much of `data` as fits; returns the number of bytes accepted.
+    std::size_t write(const std::uint8_t* data, std::size_t count) {
+        std::size_t written = 0;
+        while (written < count) {
+            const ByteSpan span = write_span();
+            if (span.empty()) {
+                break;
+            }
+            const std::size_t n = span.size() < count - written ? span.size() : count - written;
+            std::memcpy(span.data(), data + written, n);
+            commit(n);
+            written += n;
+        }
+        return written;
+    }
+
+    // ---- consumer side ----
+
+    /// Largest contiguous readable region; may be shorter than size() at the wrap.
+    NUCLEO_ALWAYS_INLINE ConstByteSpan read_span() const {
+        const std::uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const std::uint32_t head = head_.load(std::memory_order_acquire);
+        const std::size_t used = head - tail;
+        const std::size_t offset = tail & mask_;
+        const std::size_t until_wrap = capacity() - offset;
+        return {storage_.data() + offset, used < until_wrap ? used : until_wrap};
+    }
+
+    /// Releases `count` bytes returned by read_span() back to the producer.
+    NUCLEO_ALWAYS_INLINE void consume(std::size_t count) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + static_cast<std::uint32_t>(count),
+                    std::memory_order_release);
+    }
+
+    std::size_t read(std::uint8_t* out, std::size_t count) {
+        std::size_t done = 0;
+        while (done < count) {
+            const ConstByteSpan span = read_span();
+            if (span.empty()) {
+                break;
+            }
+            const std::size_t n = span.size() < count - done ? span.size() : count - done;
+            std::memcpy(out + done, span.data(), n);
+            consume(n);
+            done += n;
+        }
+        return done;
+    }
+
+private:
+    ByteSpan storage_;
+    std::uint32_t mask_ = 0;
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> head_{0};
+    alignas(NUCLEO_CACHE_LINE) std::atomic<std::uint32_t> tail_{0};
+};
+
+}  // namespace nucleo::uart
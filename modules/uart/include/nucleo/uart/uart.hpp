@@ -0,0 +1,122 @@
+// DMA ring-buffer UART driver.
+//
+// Reception is circular DMA straight into the receive buffer with no
+// per-byte interrupts; the application reads the bytes in place. Transmit
+// data is staged in a second ring and sent by DMA in contiguous chunks,
+// chained from the transfer-complete interrupt.
+#pragma once
+
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+#include "nucleo/uart/dma_rx_ring.hpp"
+#include "nucleo/uart/port.hpp"
+#include "nucleo/uart/spsc_ring.hpp"
+
+namespace nucleo::uart {
+
+struct UartStats {
+    std::uint32_t rx_bytes = 0;
+    std::uint32_t rx_events = 0;          ///< half/full/idle interrupts
+    std::uint32_t rx_overruns = 0;        ///< consumer fell a full lap behind
+    std::uint32_t rx_dropped_bytes = 0;
+    std::uint32_t line_errors = 0;
+    std::uint32_t tx_bytes = 0;
+    std::uint32_t tx_transfers = 0;       ///< DMA transfers started
+    std::uint32_t tx_rejected_bytes = 0;  ///< bytes of write() calls that did not fit
+};
+
+/// Result of Uart::rx_drain().
+struct RxDrain {
+    std::size_t bytes = 0;  ///< bytes handed to the callback
+    bool overrun = false;   ///< received bytes were lost; framing must resync
+};
+
+class Uart {
+public:
+    /// GPDMA block transfers carry a 16-bit byte count.
+    static constexpr std::size_t kMaxDmaTransfer = 0xFFFF;
+
+    /// Both buffers must be powers of two in size. The receive buffer is
+    /// written by DMA and must be reachable by the DMA controller.
+    Uart(UartPort& port, ByteSpan rx_dma_buffer, ByteSpan tx_buffer);
+
+    Status start(std::uint32_t baud);
+
+    // ---- receive (thread side) ----
+
+    /// Contiguous received bytes, in place in the DMA buffer.
+    ConstByteSpan rx_peek() { return rx_.read_span(); }
+
+    /// Releases bytes returned by rx_peek(). Returns false if they were
+    /// overwritten by the DMA while being read.
+    bool rx_consume(std::size_t count) { return rx_.consume(count); }
+
+    /// Hands every pending region to fn(ConstByteSpan) (two calls when the
+    /// data wraps) and releases it. `overrun` is set when the DMA lapped the
+    /// reader, before or during the drain; a stream decoder should then
+    /// forget its partial frame.
+    template <typename Fn>
+    RxDrain rx_drain(Fn&& fn) {
+        RxDrain result;
+        const std::uint32_t overruns = rx_.overruns();
+        for (int pass = 0; pass < 2; ++pass) {
+            const ConstByteSpan span = rx_.read_span();
+            if (span.empty()) {
+                break;
+            }
+            fn(span);
+            rx_.consume(span.size());
+            result.bytes += span.size();
+        }
+        result.overrun = rx_.overruns() != overruns;
+        return result;
+    }
+
+    /// Copying convenience for callers that want their own buffer.
+    std::size_t read(std::uint8_t* out, std::size_t max);
+
+    std::size_t rx_available() const { return rx_.size(); }
+
+    // ---- transmit (thread side) ----
+
+    /// Queues as much of `data` as fits and starts DMA if idle. Returns the
+    /// number of bytes accepted.
+    std::size_t write(ConstByteSpan data);
+
+    /// Contiguous free space in the transmit ring for building a message in
+    /// place; follow with tx_commit().
+    ByteSpan tx_reserve() { return tx_.write_span(); }
+    void tx_commit(std::size_t count);
+
+    std::size_t tx_free() const { return tx_.free(); }
+    bool tx_idle() const;
+
+    UartStats stats() const;
+
+    // ---- interrupt side, called by the port ----
+
+    void isr_rx_position(std::size_t write_index) {
+        rx_.publish(write_index);
+        ++rx_events_;
+    }
+    void isr_tx_done();
+    void isr_line_error(LineError error);
+
+private:
+    void kick_tx();
+
+    UartPort& port_;
+    ByteSpan rx_storage_;
+    DmaRxRing rx_;
+    SpscRing tx_;
+    std::size_t tx_in_flight_ = 0;  // guarded by the interrupt lock
+    volatile std::uint32_t rx_events_ = 0;
+    volatile std::uint32_t line_errors_ = 0;
+    volatile std::uint32_t tx_bytes_ = 0;
+    volatile std::uint32_t tx_transfers_ = 0;
+    std::uint32_t tx_rejected_bytes_ = 0;
+};
+
+}  // namespace nucleo::uart
@@ -0,0 +1,12 @@
+// The ST-LINK virtual COM port (USART3 on PD8/PD9).
+#pragma once
+
+#include "nucleo/uart/port.hpp"
+
+namespace nucleo::uart {
+
+/// USART3 + GPDMA1 channels 0 (RX) and 1 (TX) on the target; the SimUart
+/// returned by host::vcp_sim() on the host.
+UartPort& vcp_port();
+
+}  // namespace nucleo::uart
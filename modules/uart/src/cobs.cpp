@@ -0,0 +1,52 @@
+#include "nucleo/uart/cobs.hpp"
+
+namespace nucleo::uart {
+
+std::size_t cobs_encode(ConstByteSpan payload, ByteSpan out) {
+    if (out.size() < cobs_encoded_size_max(payload.size())) {
+        return 0;
+    }
+    std::uint8_t* dst = out.data();
+    std::uint8_t* code_ptr = dst++;
+    std::uint8_t code = 1;
+    for (const std::uint8_t byte : payload) {
+        if (byte != 0) {
+            *dst++ = byte;
+            ++code;
+        }
+        if (byte == 0 || code == 0xFF) {
+            *code_ptr = code;
+            code_ptr = dst++;
+            code = 1;
+        }
+    }
+    *code_ptr = code;
+    *dst++ = 0;
+    return static_cast<std::size_t>(dst - out.data());
+}
+
+std::size_t cobs_decode(ConstByteSpan encoded, ByteSpan out) {
+    std::size_t written = 0;
+    std::size_t i = 0;
+    while (i < encoded.size()) {
+        const std::uint8_t code = encoded[i++];
+        if (code == 0 || i + code - 1 > encoded.size() || written + code - 1 > out.size()) {
+            return 0;
+        }
+        if (std::memchr(encoded.data() + i, 0, code - 1u) != nullptr) {
+            return 0;
+        }
+        std::memcpy(out.data() + written, encoded.data() + i, code - 1u);
+        written += code - 1u;
+        i += code - 1u;
+        if (code != 0xFF && i < encoded.size()) {
+            if (written == out.size()) {
+                return 0;
+            }
+            out[written++] = 0;
+        }
+    }
+    return written;
+}
+
+}  // namespace nucleo::uart
@@ -0,0 +1,96 @@
+#include "nucleo/uart/uart.hpp"
+
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/platform/irq.hpp"
+
+namespace nucleo::uart {
+
+Uart::Uart(UartPort& port, ByteSpan rx_dma_buffer, ByteSpan tx_buffer)
+    : port_(port), rx_storage_(rx_dma_buffer), tx_(tx_buffer) {
+    rx_.reset(rx_dma_buffer);
+}
+
+Status Uart::start(std::uint32_t baud) {
+    if (!rx_.valid() || !tx_.valid() || baud == 0) {
+        return Status::invalid_argument;
+    }
+    rx_.reset(rx_storage_);
+    return port_.start(*this, baud, rx_storage_);
+}
+
+std::size_t Uart::read(std::uint8_t* out, std::size_t max) {
+    std::size_t done = 0;
+    while (done < max) {
+        const ConstByteSpan span = rx_.read_span();
+        if (span.empty()) {
+            break;
+        }
+        const std::size_t n = span.size() < max - done ? span.size() : max - done;
+        std::memcpy(out + done, span.data(), n);
+        rx_.consume(n);
+        done += n;
+    }
+    return done;
+}
+
+std::size_t Uart::write(ConstByteSpan data) {
+    const std::size_t accepted = tx_.write(data.data(), data.size());
+    tx_rejected_bytes_ += static_cast<std::uint32_t>(data.size() - accepted);
+    if (accepted != 0) {
+        platform::CriticalSection lock;
+        if (tx_in_flight_ == 0) {
+            kick_tx();
+        }
+    }
+    return accepted;
+}
+
+void Uart::tx_commit(std::size_t count) {
+    tx_.commit(count);
+    platform::CriticalSection lock;
+    if (tx_in_flight_ == 0) {
+        kick_tx();
+    }
+}
+
+bool Uart::tx_idle() const {
+    platform::CriticalSection lock;
+    return tx_in_flight_ == 0 && tx_.empty();
+}
+
+NUCLEO_RAMFUNC void Uart::kick_tx() {
+    ConstByteSpan span = tx_.read_span();
+    if (span.empty()) {
+        return;
+    }
+    if (span.size() > kMaxDmaTransfer) {
+        span = span.first(kMaxDmaTransfer);
+    }
+    tx_in_flight_ = span.size();
+    ++tx_transfers_;
+    port_.start_tx(span);
+}
+
+NUCLEO_RAMFUNC void Uart::isr_tx_done() {
+    tx_.consume(tx_in_flight_);
+    tx_bytes_ += static_cast<std::uint32_t>(tx_in_flight_);
+    tx_in_flight_ = 0;
+    kick_tx();
+}
+
+NUCLEO_RAMFUNC void Uart::isr_line_error(LineError) { ++line_errors_; }
+
+UartStats Uart::stats() const {
+    UartStats s;
+    s.rx_bytes = rx_.received();
+    s.rx_events = rx_events_;
+    s.rx_overruns = rx_.overruns();
+    s.rx_dropped_bytes = rx_.dropped_bytes();
+    s.line_errors = line_errors_;
+    s.tx_bytes = tx_bytes_;
+    s.tx_transfers = tx_transfers_;
+    s.tx_rejected_bytes = tx_rejected_bytes_;
+    return s;
+}
+
+}  // namespace nucleo::uart
@@ -0,0 +1,173 @@
+// USART3 (ST-LINK VCP) with GPDMA1 channel 0 circular RX and channel 1 TX.
+#include "stm32h5xx.h"
+
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/platform/compiler.hpp"
+#include "nucleo/uart/uart.hpp"
+#include "nucleo/uart/vcp.hpp"
+
+namespace nucleo::uart {
+namespace {
+
+// RM0481, GPDMA1 request mapping.
+constexpr std::uint32_t kRequestUsart3Rx = 25;
+constexpr std::uint32_t kRequestUsart3Tx = 26;
+constexpr std::uint32_t kAfUsart3 = 7;
+constexpr std::uint32_t kPinTx = 8;  // PD8
+constexpr std::uint32_t kPinRx = 9;  // PD9
+constexpr std::uint32_t kIrqPriority = 5;
+
+constexpr std::uint32_t kDmaAllFlags = DMA_CFCR_TCF | DMA_CFCR_HTF | DMA_CFCR_DTEF |
+                                       DMA_CFCR_ULEF | DMA_CFCR_USEF | DMA_CFCR_SUSPF |
+                                       DMA_CFCR_TOF;
+
+// Linked-list item that reloads the block size and destination address at
+// the end of every block, pointing back at itself: circular reception
+// without CPU involvement. Fields follow the register order of CLLR's
+// update bits (CBR1, CDAR, CLLR).
+struct CircularLli {
+    std::uint32_t cbr1;
+    std::uint32_t cdar;
+    std::uint32_t cllr;
+};
+
+class Usart3Port final : public UartPort {
+public:
+    Status start(Uart& owner, std::uint32_t baud, ByteSpan rx_buffer) override;
+    void start_tx(ConstByteSpan data) override;
+
+    void on_usart_irq();
+    void on_rx_dma_irq();
+    void on_tx_dma_irq();
+
+private:
+    std::size_t rx_index() const {
+        return rx_size_ - (GPDMA1_Channel0->CBR1 & DMA_CBR1_BNDT);
+    }
+
+    Uart* owner_ = nullptr;
+    std::size_t rx_size_ = 0;
+    CircularLli lli_{};
+};
+
+Usart3Port g_port;
+
+void configure_pins() {
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIODEN;
+    (void)RCC->AHB2ENR;
+    for (const std::uint32_t pin : {kPinTx, kPinRx}) {
+        GPIOD->MODER = (GPIOD->MODER & ~(3u << (pin * 2))) | (2u << (pin * 2));
+        GPIOD->OSPEEDR |= 3u << (pin * 2);
+        GPIOD->AFR[1] = (GPIOD->AFR[1] & ~(0xFu << ((pin - 8) * 4))) | (kAfUsart3 << ((pin - 8) * 4));
+    }
+}
+
+Status Usart3Port::start(Uart& owner, std::uint32_t baud, ByteSpan rx_buffer) {
+    // USART3 kernel clock is PCLK1 (= HCLK); oversampling by 16 caps the
+    // line rate at 15.6 Mbaud.
+    if (rx_buffer.size() > DMA_CBR1_BNDT || baud > platform::core_clock_hz() / 16) {
+        return Status::invalid_argument;
+    }
+    owner_ = &owner;
+    rx_size_ = rx_buffer.size();
+
+    RCC->APB1LENR |= RCC_APB1LENR_USART3EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPDMA1EN;
+    (void)RCC->AHB1ENR;
+    configure_pins();
+
+    USART3->CR1 = 0;
+    USART3->BRR = (platform::core_clock_hz() + baud / 2) / baud;
+    USART3->CR3 = USART_CR3_DMAR | USART_CR3_DMAT | USART_CR3_EIE;
+
+    DMA_Channel_TypeDef* rx = GPDMA1_Channel0;
+    rx->CCR = DMA_CCR_RESET;
+    const std::uint32_t lli_addr = reinterpret_cast<std::uint32_t>(&lli_);
+    const std::uint32_t cllr = DMA_CLLR_UB1 | DMA_CLLR_UDA | (lli_addr & DMA_CLLR_LA);
+    lli_ = {static_cast<std::uint32_t>(rx_size_), reinterpret_cast<std::uint32_t>(rx_buffer.data()),
+            cllr};
+    rx->CTR1 = DMA_CTR1_DINC;  // byte to byte, peripheral fixed, memory increments
+    rx->CTR2 = kRequestUsart3Rx << DMA_CTR2_REQSEL_Pos;
+    rx->CBR1 = static_cast<std::uint32_t>(rx_size_);
+    rx->CSAR = reinterpret_cast<std::uint32_t>(&USART3->RDR);
+    rx->CDAR = reinterpret_cast<std::uint32_t>(rx_buffer.data());
+    rx->CLBAR = lli_addr & DMA_CLBAR_LBA;
+    rx->CLLR = cllr;
+    rx->CFCR = kDmaAllFlags;
+    rx->CCR = DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_DTEIE | DMA_CCR_ULEIE | DMA_CCR_USEIE |
+              DMA_CCR_EN;
+
+    GPDMA1_Channel1->CCR = DMA_CCR_RESET;
+
+    NVIC_SetPriority(USART3_IRQn, kIrqPriority);
+    NVIC_SetPriority(GPDMA1_Channel0_IRQn, kIrqPriority);
+    NVIC_SetPriority(GPDMA1_Channel1_IRQn, kIrqPriority);
+    NVIC_EnableIRQ(USART3_IRQn);
+    NVIC_EnableIRQ(GPDMA1_Channel0_IRQn);
+    NVIC_EnableIRQ(GPDMA1_Channel1_IRQn);
+
+    USART3->ICR = USART_ICR_IDLECF | USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF |
+                  USART_ICR_PECF;
+    USART3->CR1 = USART_CR1_FIFOEN | USART_CR1_IDLEIE | USART_CR1_RE | USART_CR1_TE;
+    USART3->CR1 |= USART_CR1_UE;
+    return Status::ok;
+}
+
+NUCLEO_RAMFUNC void Usart3Port::start_tx(ConstByteSpan data) {
+    DMA_Channel_TypeDef* tx = GPDMA1_Channel1;
+    tx->CTR1 = DMA_CTR1_SINC;
+    tx->CTR2 = (kRequestUsart3Tx << DMA_CTR2_REQSEL_Pos) | DMA_CTR2_DREQ;
+    tx->CBR1 = static_cast<std::uint32_t>(data.size());
+    tx->CSAR = reinterpret_cast<std::uint32_t>(data.data());
+    tx->CDAR = reinterpret_cast<std::uint32_t>(&USART3->TDR);
+    tx->CLLR = 0;
+    tx->CFCR = kDmaAllFlags;
+    tx->CCR = DMA_CCR_TCIE | DMA_CCR_DTEIE | DMA_CCR_USEIE | DMA_CCR_EN;
+}
+
+NUCLEO_RAMFUNC void Usart3Port::on_usart_irq() {
+    const std::uint32_t isr = USART3->ISR;
+    if ((isr & USART_ISR_IDLE) != 0) {
+        USART3->ICR = USART_ICR_IDLECF;
+        owner_->isr_rx_position(rx_index());
+    }
+    if ((isr & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE | USART_ISR_PE)) != 0) {
+        USART3->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF | USART_ICR_PECF;
+        const LineError error = (isr & USART_ISR_ORE) != 0  ? LineError::overrun
+                                : (isr & USART_ISR_FE) != 0 ? LineError::framing
+                                : (isr & USART_ISR_NE) != 0 ? LineError::noise
+                                                            : LineError::parity;
+        owner_->isr_line_error(error);
+    }
+}
+
+NUCLEO_RAMFUNC void Usart3Port::on_rx_dma_irq() {
+    DMA_Channel_TypeDef* rx = GPDMA1_Channel0;
+    const std::uint32_t csr = rx->CSR;
+    rx->CFCR = csr & kDmaAllFlags;
+    if ((csr & (DMA_CSR_HTF | DMA_CSR_TCF)) != 0) {
+        owner_->isr_rx_position(rx_index());
+    }
+    if ((csr & (DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF)) != 0) {
+        owner_->isr_line_error(LineError::overrun);
+    }
+}
+
+NUCLEO_RAMFUNC void Usart3Port::on_tx_dma_irq() {
+    DMA_Channel_TypeDef* tx = GPDMA1_Channel1;
+    const std::uint32_t csr = tx->CSR;
+    tx->CFCR = csr & kDmaAllFlags;
+    if ((csr & DMA_CSR_TCF) != 0) {
+        owner_->isr_tx_done();
+    }
+}
+
+}  // namespace
+
+UartPort& vcp_port() { return g_port; }
+
+}  // namespace nucleo::uart
+
+extern "C" NUCLEO_RAMFUNC void USART3_IRQHandler() { nucleo::uart::g_port.on_usart_irq(); }
+extern "C" NUCLEO_RAMFUNC void GPDMA1_Channel0_IRQHandler() { nucleo::uart::g_port.on_rx_dma_irq(); }
+extern "C" NUCLEO_RAMFUNC void GPDMA1_Channel1_IRQHandler() { nucleo::uart::g_port.on_tx_dma_irq(); }
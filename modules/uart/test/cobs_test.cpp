@@ -0,0 +1,115 @@
+#include <random>
+#include <vector>
+
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/cobs.hpp"
+
+using namespace nucleo;
+using namespace nucleo::uart;
+
+namespace {
+
+std::vector<std::uint8_t> encode(const std::vector<std::uint8_t>& payload) {
+    std::vector<std::uint8_t> out(cobs_encoded_size_max(payload.size()));
+    out.resize(cobs_encode(ConstByteSpan{payload.data(), payload.size()}, ByteSpan{out.data(), out.size()}));
+    return out;
+}
+
+}  // namespace
+
+TEST(encode_known_vectors) {
+    CHECK(encode({0x00}) == (std::vector<std::uint8_t>{0x01, 0x01, 0x00}));
+    CHECK(encode({0x11, 0x22, 0x00, 0x33}) ==
+          (std::vector<std::uint8_t>{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    CHECK(encode({0x11, 0x00, 0x00}) == (std::vector<std::uint8_t>{0x02, 0x11, 0x01, 0x01, 0x00}));
+}
+
+TEST(encode_rejects_small_output) {
+    const std::uint8_t payload[] = {1, 2, 3};
+    std::uint8_t out[4];
+    CHECK_EQ(cobs_encode(payload, out), 0u);
+}
+
+TEST(round_trip_block_boundaries) {
+    for (std::size_t size : {1u, 253u, 254u, 255u, 508u, 1000u}) {
+        std::vector<std::uint8_t> payload(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            payload[i] = static_cast<std::uint8_t>(i % 255 + 1);  // no zeros
+        }
+        const auto encoded = encode(payload);
+        CHECK(encoded.size() <= cobs_encoded_size_max(size));
+        CHECK_EQ(encoded.back(), 0u);
+
+        std::vector<std::uint8_t> decoded(size);
+        const std::size_t n = cobs_decode(ConstByteSpan{encoded.data(), encoded.size() - 1},
+                                          ByteSpan{decoded.data(), decoded.size()});
+        CHECK_EQ(n, size);
+        CHECK(decoded == payload);
+    }
+}
+
+TEST(stream_decoder_handles_arbitrary_splits) {
+    std::mt19937 rng(7);
+    std::vector<std::vector<std::uint8_t>> frames;
+    std::vector<std::uint8_t> stream;
+    for (int f = 0; f < 200; ++f) {
+        std::vector<std::uint8_t> payload(1 + rng() % 600);
+        for (auto& b : payload) {
+            b = static_cast<std::uint8_t>(rng() % 4 == 0 ? 0 : rng());
+        }
+        const auto encoded = encode(payload);
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+        frames.push_back(std::move(payload));
+    }
+
+    std::uint8_t buffer[1024];
+    CobsDecoder decoder(buffer);
+    std::size_t next = 0;
+    bool all_match = true;
+    std::size_t offset = 0;
+    while (offset < stream.size()) {
+        const std::size_t n = std::min<std::size_t>(1 + rng() % 97, stream.size() - offset);
+        decoder.feed(ConstByteSpan{stream.data() + offset, n}, [&](ConstByteSpan frame) {
+            all_match = all_match && next < frames.size() && frame.size() == frames[next].size() &&
+                        std::equal(frame.begin(), frame.end(), frames[next].begin());
+            ++next;
+        });
+        offset += n;
+    }
+    CHECK(all_match);
+    CHECK_EQ(next, frames.size());
+    CHECK_EQ(decoder.errors(), 0u);
+}
+
+TEST(stream_decoder_resyncs_after_truncated_frame) {
+    const auto good = encode({1, 2, 3, 4, 5, 6, 7, 8});
+    std::vector<std::uint8_t> stream(good.begin(), good.begin() + 4);  // lost the tail
+    stream.push_back(0);
+    stream.insert(stream.end(), good.begin(), good.end());
+
+    std::uint8_t buffer[64];
+    CobsDecoder decoder(buffer);
+    int frames = 0;
+    decoder.feed(ConstByteSpan{stream.data(), stream.size()}, [&](ConstByteSpan frame) {
+        ++frames;
+        CHECK_EQ(frame.size(), 8u);
+    });
+    CHECK_EQ(frames, 1);
+    CHECK_EQ(decoder.errors(), 1u);
+}
+
+TEST(stream_decoder_drops_oversized_frames) {
+    const auto big = encode(std::vector<std::uint8_t>(100, 0x55));
+    const auto small = encode({9, 9});
+    std::vector<std::uint8_t> stream(big);
+    stream.insert(stream.end(), small.begin(), small.end());
+
+    std::uint8_t buffer[32];
+    CobsDecoder decoder(buffer);
+    std::size_t last_size = 0;
+    decoder.feed(ConstByteSpan{stream.data(), stream.size()},
+                 [&](ConstByteSpan frame) { last_size = frame.size(); });
+    CHECK_EQ(decoder.frames(), 1u);
+    CHECK_EQ(last_size, 2u);
+    CHECK_EQ(decoder.errors(), 1u);
+}
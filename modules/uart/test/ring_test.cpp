@@ -0,0 +1,97 @@
+#include <array>
+#include <cstring>
+
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/dma_rx_ring.hpp"
+#include "nucleo/uart/spsc_ring.hpp"
+
+using namespace nucleo;
+using namespace nucleo::uart;
+
+TEST(spsc_rejects_non_power_of_two_storage) {
+    std::array<std::uint8_t, 12> storage{};
+    SpscRing ring(storage);
+    CHECK(!ring.valid());
+}
+
+TEST(spsc_write_read_wraps) {
+    std::array<std::uint8_t, 8> storage{};
+    SpscRing ring(storage);
+    REQUIRE(ring.valid());
+
+    const std::uint8_t first[] = {1, 2, 3, 4, 5, 6};
+    CHECK_EQ(ring.write(first, sizeof first), 6u);
+    std::uint8_t out[8] = {};
+    CHECK_EQ(ring.read(out, 4), 4u);
+
+    // Six more bytes: only four slots are free, and they straddle the wrap.
+    const std::uint8_t second[] = {7, 8, 9, 10, 11, 12};
+    CHECK_EQ(ring.write(second, sizeof second), 6u);
+    CHECK_EQ(ring.size(), 8u);
+    CHECK_EQ(ring.free(), 0u);
+    CHECK_EQ(ring.write(second, 1), 0u);
+
+    CHECK_EQ(ring.read(out, 8), 8u);
+    const std::uint8_t expected[] = {5, 6, 7, 8, 9, 10, 11, 12};
+    CHECK(std::memcmp(out, expected, 8) == 0);
+    CHECK(ring.empty());
+}
+
+TEST(spsc_spans_stop_at_wrap) {
+    std::array<std::uint8_t, 8> storage{};
+    SpscRing ring(storage);
+    ring.commit(6);
+    ring.consume(6);
+    CHECK_EQ(ring.write_span().size(), 2u);
+    ring.commit(2);
+    CHECK_EQ(ring.write_span().size(), 6u);
+    CHECK_EQ(ring.read_span().size(), 2u);
+}
+
+TEST(dma_ring_publishes_hardware_index) {
+    std::array<std::uint8_t, 16> dma{};
+    DmaRxRing ring;
+    ring.reset(dma);
+    REQUIRE(ring.valid());
+
+    std::memcpy(dma.data(), "abcdefghij", 10);
+    ring.publish(10);
+    ConstByteSpan span = ring.read_span();
+    CHECK_EQ(span.size(), 10u);
+    CHECK(std::memcmp(span.data(), "abcdefghij", 10) == 0);
+    CHECK(ring.consume(10));
+
+    // DMA wraps: 6 bytes to the end, then 4 from the start.
+    std::memcpy(dma.data() + 10, "klmnop", 6);
+    std::memcpy(dma.data(), "qrst", 4);
+    ring.publish(0);
+    ring.publish(4);
+    CHECK_EQ(ring.size(), 10u);
+    CHECK_EQ(ring.read_span().size(), 6u);
+    ring.consume(6);
+    span = ring.read_span();
+    CHECK_EQ(span.size(), 4u);
+    CHECK(std::memcmp(span.data(), "qrst", 4) == 0);
+    ring.consume(4);
+    CHECK_EQ(ring.received(), 20u);
+    CHECK_EQ(ring.overruns(), 0u);
+}
+
+TEST(dma_ring_overrun_drops_pending_bytes) {
+    std::array<std::uint8_t, 16> dma{};
+    DmaRxRing ring;
+    ring.reset(dma);
+
+    // Two and a half laps published in half-buffer steps, nothing consumed.
+    for (std::size_t index : {8u, 0u, 8u, 0u, 8u}) {
+        ring.publish(index);
+    }
+    CHECK_EQ(ring.received(), 40u);
+    CHECK(ring.read_span().empty());
+    CHECK_EQ(ring.overruns(), 1u);
+    CHECK_EQ(ring.dropped_bytes(), 40u);
+
+    // Reception continues normally afterwards.
+    ring.publish(12);
+    CHECK_EQ(ring.read_span().size(), 4u);
+}
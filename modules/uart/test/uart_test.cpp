@@ -0,0 +1,140 @@
+#include <array>
+#include <string>
+
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/host/sim_uart.hpp"
+#include "nucleo/uart/uart.hpp"
+
+using namespace nucleo;
+using namespace nucleo::uart;
+
+namespace {
+
+ConstByteSpan bytes(const std::string& s) {
+    return {reinterpret_cast<const std::uint8_t*>(s.data()), s.size()};
+}
+
+std::string drain(Uart& uart) {
+    std::string out;
+    uart.rx_drain([&](ConstByteSpan span) { out.append(span.begin(), span.end()); });
+    return out;
+}
+
+struct Fixture {
+    std::array<std::uint8_t, 64> rx{};
+    std::array<std::uint8_t, 32> tx{};
+    host::SimUart sim;
+    Uart uart{sim, rx, tx};
+};
+
+}  // namespace
+
+TEST(start_validates_buffers) {
+    std::array<std::uint8_t, 48> rx{};
+    std::array<std::uint8_t, 32> tx{};
+    host::SimUart sim;
+    Uart uart(sim, rx, tx);
+    CHECK_EQ(uart.start(115200), Status::invalid_argument);
+}
+
+TEST(idle_line_delivers_short_message) {
+    Fixture f;
+    REQUIRE_EQ(f.uart.start(2'000'000), Status::ok);
+    f.sim.receive(bytes("hello"));
+    CHECK_EQ(f.uart.rx_available(), 5u);
+    CHECK_EQ(drain(f.uart), std::string("hello"));
+    CHECK_EQ(f.uart.stats().rx_events, 1u);
+}
+
+TEST(bytes_without_idle_wait_for_half_transfer) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    f.sim.receive(bytes(std::string(20, 'a')), /*idle=*/false);
+    CHECK_EQ(f.uart.rx_available(), 0u);
+    f.sim.receive(bytes(std::string(12, 'b')), /*idle=*/false);  // reaches 32 = half
+    CHECK_EQ(f.uart.rx_available(), 32u);
+}
+
+TEST(reception_wraps_and_drain_returns_both_regions) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    f.sim.receive(bytes(std::string(50, 'x')));
+    CHECK_EQ(drain(f.uart).size(), 50u);
+    f.sim.receive(bytes("0123456789abcdefghij"));  // 14 bytes to the end, 6 after wrap
+    CHECK_EQ(drain(f.uart), std::string("0123456789abcdefghij"));
+    CHECK_EQ(f.uart.stats().rx_bytes, 70u);
+}
+
+TEST(slow_consumer_is_reported_as_overrun) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    f.sim.receive(bytes(std::string(100, 'z')));
+    CHECK(f.uart.rx_peek().empty());
+    const UartStats s = f.uart.stats();
+    CHECK_EQ(s.rx_overruns, 1u);
+    CHECK_EQ(s.rx_dropped_bytes, 100u);
+    f.sim.receive(bytes("ok"));
+    CHECK_EQ(drain(f.uart), std::string("ok"));
+}
+
+TEST(drain_reports_an_overrun_once) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    f.sim.receive(bytes(std::string(100, 'z')));
+    std::string out;
+    const auto append = [&](ConstByteSpan span) { out.append(span.begin(), span.end()); };
+    RxDrain d = f.uart.rx_drain(append);
+    CHECK(d.overrun);
+    CHECK_EQ(d.bytes, 0u);
+    f.sim.receive(bytes("ok"));
+    d = f.uart.rx_drain(append);
+    CHECK(!d.overrun);
+    CHECK_EQ(d.bytes, 2u);
+    CHECK_EQ(out, std::string("ok"));
+}
+
+TEST(line_errors_are_counted) {
+    Fixture f;
+    f.uart.start(115200);
+    f.sim.inject_line_error(LineError::framing);
+    f.sim.inject_line_error(LineError::noise);
+    CHECK_EQ(f.uart.stats().line_errors, 2u);
+}
+
+TEST(transmit_chains_dma_chunks_across_wrap) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    CHECK_EQ(f.uart.write(bytes(std::string(20, 'a'))), 20u);
+    CHECK(f.sim.tx_busy());
+    f.sim.flush_tx();
+    CHECK(f.uart.tx_idle());
+
+    // 20 bytes from offset 20: 12 to the end of the ring, 8 after the wrap.
+    CHECK_EQ(f.uart.write(bytes("ABCDEFGHIJKLMNOPQRST")), 20u);
+    f.sim.flush_tx();
+    const std::string sent(f.sim.transmitted().begin(), f.sim.transmitted().end());
+    CHECK_EQ(sent, std::string(20, 'a') + "ABCDEFGHIJKLMNOPQRST");
+    const UartStats s = f.uart.stats();
+    CHECK_EQ(s.tx_bytes, 40u);
+    CHECK_EQ(s.tx_transfers, 3u);
+}
+
+TEST(transmit_rejects_what_does_not_fit) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    CHECK_EQ(f.uart.write(bytes(std::string(40, 'q'))), 32u);
+    CHECK_EQ(f.uart.stats().tx_rejected_bytes, 8u);
+}
+
+TEST(transmit_in_place_through_reserve) {
+    Fixture f;
+    f.uart.start(2'000'000);
+    ByteSpan space = f.uart.tx_reserve();
+    REQUIRE(space.size() >= 3);
+    space[0] = 'x';
+    space[1] = 'y';
+    space[2] = 'z';
+    f.uart.tx_commit(3);
+    f.sim.flush_tx();
+    CHECK_EQ(f.sim.transmitted().size(), 3u);
+}
@@ -0,0 +1,181 @@
+// USB bulk throughput and latency, in virtual bus time against SimUsb.
+//
+//  * log streaming: a main loop offering 40-byte lines faster than the bus
+//    can take them, through write() with one transfer per line (the old
+//    path), coalesced into a single packet buffer, and coalesced with the
+//    double-buffered endpoint
+//  * firmware dump: 4 KB blocks through submit(), single and double
+//    buffered, against the full-speed bulk limit of 19 packets per frame
+//  * write-to-host latency of an occasional short message on an idle bus
+//  * OUT throughput into two resubmitted 512-byte buffers
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "nucleo/testkit/bench.hpp"
+#include "nucleo/usb/device.hpp"
+#include "nucleo/usb/host/sim_usb.hpp"
+
+using namespace nucleo;
+using namespace nucleo::usb;
+
+namespace {
+
+constexpr double kBusLimitKBps = 19.0 * 64.0;  // bytes per 1 ms frame = KB/s
+
+double kbps(std::size_t bytes, double us) { return static_cast<double>(bytes) / us * 1000.0; }
+
+struct Rig {
+    explicit Rig(const DeviceConfig& config) : device(config) {
+        device.start(sim);
+        (void)sim.enumerate();
+        sim.listen(Device::kDataIn);
+    }
+    host::SimUsb sim;
+    Device device;
+};
+
+DeviceConfig config_for(Framing framing, bool coalesce, bool double_buffered) {
+    DeviceConfig config;
+    config.in.framing = framing;
+    config.in.coalesce = coalesce;
+    config.double_buffered = double_buffered;
+    return config;
+}
+
+void bench_log_stream(testkit::Bench& bench, const char* name, const DeviceConfig& config) {
+    Rig rig(config);
+    const double duration_us = static_cast<double>(bench.scale(2000)) * 1000.0;  // 2 s of bus time
+    const std::string line = "12345678 I adc: block 0042 rms=0.1234\n";
+    std::size_t lines = 0;
+    std::size_t refused = 0;
+    // One line per 20 us offered: ~2 MB/s, above what full speed carries.
+    rig.sim.set_main_loop(
+        [&] {
+            const ConstByteSpan bytes{reinterpret_cast<const std::uint8_t*>(line.data()), line.size()};
+            if (rig.device.in().write(bytes) == Status::ok) {
+                ++lines;
+            } else {
+                ++refused;
+            }
+        },
+        20.0);
+    const double start = rig.sim.now_us();
+    rig.sim.run_us(duration_us);
+    const double elapsed = rig.sim.now_us() - start;
+    const host::EndpointStats stats = rig.sim.stats(Device::kDataIn);
+
+    char metric[64];
+    std::snprintf(metric, sizeof metric, "log_%s_throughput", name);
+    bench.metric(metric, kbps(stats.bytes, elapsed), "KB/s");
+    std::snprintf(metric, sizeof metric, "log_%s_bytes_per_packet", name);
+    bench.metric(metric, static_cast<double>(stats.bytes) / stats.packets, "B");
+    std::snprintf(metric, sizeof metric, "log_%s_lines_refused", name);
+    bench.metric(metric, 100.0 * static_cast<double>(refused) / static_cast<double>(lines + refused), "%");
+}
+
+void bench_dump(testkit::Bench& bench, const char* name, bool double_buffered) {
+    Rig rig(config_for(Framing::stream, true, double_buffered));
+    const std::size_t total = bench.scale(200) * 4096 + 4096;  // up to 800 KB
+    std::vector<std::uint8_t> image(total);
+    for (std::size_t i = 0; i < image.size(); ++i) {
+        image[i] = static_cast<std::uint8_t>(i * 13);
+    }
+    // The application keeps the queue topped up from its main loop.
+    std::size_t offset = 0;
+    rig.sim.set_main_loop(
+        [&] {
+            while (offset < total && rig.device.in().queued() < 4) {
+                if (rig.device.in().submit({image.data() + offset, 4096}) != Status::ok) {
+                    break;
+                }
+                offset += 4096;
+            }
+        },
+        50.0);
+    const double start = rig.sim.now_us();
+    rig.sim.run_until([&] { return offset == total && rig.device.in().idle(); }, 10e6);
+    const double elapsed = rig.sim.now_us() - start;
+
+    char metric[64];
+    std::snprintf(metric, sizeof metric, "dump_%s_throughput", name);
+    bench.metric(metric, kbps(rig.sim.received(Device::kDataIn).size(), elapsed), "KB/s");
+    std::snprintf(metric, sizeof metric, "dump_%s_of_bus_limit", name);
+    bench.metric(metric, 100.0 * kbps(rig.sim.received(Device::kDataIn).size(), elapsed) / kBusLimitKBps, "%");
+    std::snprintf(metric, sizeof metric, "dump_%s_host_naks", name);
+    bench.metric(metric, rig.sim.stats(Device::kDataIn).naks, "polls");
+}
+
+void bench_latency(testkit::Bench& bench, const char* name, const DeviceConfig& config) {
+    Rig rig(config);
+    const std::string message = "evt 17 fault=0\n";
+    const std::size_t count = bench.scale(2000);
+    std::vector<double> latency_us;
+    latency_us.reserve(count);
+    double written_at = 0;
+    rig.sim.set_in_listener([&](std::uint8_t, ConstByteSpan packet) {
+        if (packet.size() != 0) {
+            latency_us.push_back(rig.sim.now_us() - written_at);
+        }
+    });
+    // One message every 1.3 ms, so they land at every point in the frame.
+    for (std::size_t i = 0; i < count; ++i) {
+        rig.sim.run_us(1300.0);
+        written_at = rig.sim.now_us();
+        (void)rig.device.in().write({reinterpret_cast<const std::uint8_t*>(message.data()), message.size()});
+    }
+    rig.sim.run_us(2000.0);
+
+    char label[64];
+    std::snprintf(label, sizeof label, "latency_%s_write_to_host", name);
+    bench.report(label, testkit::summarize(latency_us), "us");
+}
+
+void bench_out(testkit::Bench& bench) {
+    Rig rig(DeviceConfig{});
+    const std::size_t total = bench.scale(200) * 4096 + 4096;
+    std::vector<std::uint8_t> data(total, 0x5A);
+    std::vector<std::uint8_t> a(512), b(512);
+    BulkOut& out = rig.device.out();
+    (void)out.submit({a.data(), a.size()});
+    (void)out.submit({b.data(), b.size()});
+    std::size_t received = 0;
+    rig.sim.set_main_loop(
+        [&] {
+            // Each buffer goes straight back once consumed.
+            std::vector<std::uint8_t>* returned[2];
+            std::size_t n = 0;
+            out.receive([&](ConstByteSpan chunk) {
+                received += chunk.size();
+                returned[n++] = chunk.data() == a.data() ? &a : &b;
+            });
+            for (std::size_t i = 0; i < n; ++i) {
+                (void)out.submit({returned[i]->data(), returned[i]->size()});
+            }
+        },
+        50.0);
+    rig.sim.send_out(Device::kDataOut, {data.data(), data.size()});
+    const double start = rig.sim.now_us();
+    rig.sim.run_until([&] { return received == total; }, 10e6);
+    bench.metric("out_throughput", kbps(received, rig.sim.now_us() - start), "KB/s");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    testkit::Bench bench(argc, argv);
+    bench.metric("bus_limit", kBusLimitKBps, "KB/s");
+
+    bench_log_stream(bench, "per_line", config_for(Framing::transfer, false, false));
+    bench_log_stream(bench, "coalesced_single", config_for(Framing::stream, true, false));
+    bench_log_stream(bench, "coalesced_double", config_for(Framing::stream, true, true));
+
+    bench_dump(bench, "single_buffered", false);
+    bench_dump(bench, "double_buffered", true);
+
+    bench_latency(bench, "per_line", config_for(Framing::transfer, false, false));
+    bench_latency(bench, "coalesced", config_for(Framing::stream, true, true));
+
+    bench_out(bench);
+    return 0;
+}
@@ -0,0 +1,527 @@
+#include "nucleo/usb/host/sim_usb.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "nucleo/platform/host/sim.hpp"
+#include "nucleo/usb/fs_port.hpp"
+
+namespace nucleo::usb {
+namespace host {
+namespace {
+
+constexpr std::uint8_t kEp0In = 0x80;
+constexpr std::uint8_t kEp0Out = 0x00;
+constexpr double kControlTimeoutUs = 50000.0;  // USB 2.0 9.2.6.4: 50 ms for a data stage
+constexpr double kResetUs = 10000.0;
+constexpr std::uint8_t kAssignedAddress = 5;
+
+// Bulk slots polled round-robin: IN 1-7, then OUT 1-7.
+constexpr std::size_t kSlots = 16;
+std::uint8_t slot_address(std::size_t slot) {
+    return static_cast<std::uint8_t>(slot < 8 ? (slot | kIn) : slot - 8);
+}
+
+SetupPacket request(std::uint8_t type, std::uint8_t req, std::uint16_t value, std::uint16_t index,
+                    std::uint16_t length) {
+    return {type, req, value, index, length};
+}
+
+}  // namespace
+
+SimUsb::Endpoint& SimUsb::endpoint(std::uint8_t address) {
+    return (address & kIn) != 0 ? in_[address & 7] : out_[address & 7];
+}
+
+const SimUsb::Endpoint& SimUsb::endpoint(std::uint8_t address) const {
+    return (address & kIn) != 0 ? in_[address & 7] : out_[address & 7];
+}
+
+// ---- device side ----
+
+Status SimUsb::start(Device& owner) {
+    owner_ = &owner;
+    return Status::ok;
+}
+
+void SimUsb::stop() {
+    owner_ = nullptr;
+    for (std::size_t i = 0; i < 8; ++i) {
+        in_[i].open = false;
+        out_[i].open = false;
+    }
+    interrupts_.clear();
+}
+
+Status SimUsb::open(const EndpointConfig& config) {
+    if (config.max_packet > sizeof(Buffer::data) || (config.address & 0x70) != 0) {
+        return Status::invalid_argument;
+    }
+    Endpoint& ep = endpoint(config.address);
+    ep.open = true;
+    ep.stalled = false;
+    ep.max_packet = config.max_packet;
+    ep.buffers = config.double_buffered ? 2 : 1;
+    ep.buffer[0].full = false;
+    ep.buffer[1].full = false;
+    ep.cpu = 0;
+    ep.hw = 0;
+    return Status::ok;
+}
+
+void SimUsb::set_address(std::uint8_t address) {
+    pending_address_ = address;
+    address_pending_ = true;
+}
+
+std::size_t SimUsb::write_space(std::uint8_t address) {
+    const Endpoint& ep = endpoint(address);
+    if (!ep.open) {
+        return 0;
+    }
+    std::size_t free = 0;
+    for (std::size_t i = 0; i < ep.buffers; ++i) {
+        free += ep.buffer[i].full ? 0 : 1;
+    }
+    return free;
+}
+
+Status SimUsb::write(std::uint8_t address, ConstByteSpan packet) {
+    Endpoint& ep = endpoint(address);
+    if (!ep.open || (address & kIn) == 0 || packet.size() > ep.max_packet) {
+        return Status::invalid_argument;
+    }
+    Buffer& b = ep.buffer[ep.cpu];
+    if (b.full) {
+        return Status::busy;
+    }
+    std::memcpy(b.data, packet.data(), packet.size());
+    b.size = packet.size();
+    b.full = true;
+    ep.cpu = (ep.cpu + 1) % ep.buffers;
+    return Status::ok;
+}
+
+Status SimUsb::read(std::uint8_t address, ByteSpan out, std::size_t& size) {
+    Endpoint& ep = endpoint(address);
+    if (!ep.open || (address & kIn) != 0) {
+        return Status::invalid_argument;
+    }
+    Buffer& b = ep.buffer[ep.cpu];
+    if (!b.full) {
+        return Status::underflow;
+    }
+    if (out.size() < b.size) {
+        return Status::overflow;
+    }
+    std::memcpy(out.data(), b.data, b.size);
+    size = b.size;
+    b.full = false;
+    ep.cpu = (ep.cpu + 1) % ep.buffers;
+    return Status::ok;
+}
+
+void SimUsb::stall(std::uint8_t address, bool stalled) { endpoint(address).stalled = stalled; }
+
+// ---- simulation ----
+
+void SimUsb::reset() {
+    owner_ = nullptr;
+    timing_ = {};
+    now_ns_ = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        in_[i] = {};
+        out_[i] = {};
+    }
+    address_ = 0;
+    pending_address_ = 0;
+    address_pending_ = false;
+    interrupts_.clear();
+    next_poll_ = 0;
+    main_loop_ = nullptr;
+    loop_period_ns_ = 0;
+    next_loop_ns_ = 0;
+    in_listener_ = nullptr;
+}
+
+double SimUsb::packet_us(std::size_t bytes) const {
+    return static_cast<double>(bytes + timing_.overhead_bytes) * 8.0 / timing_.bit_rate * 1e6;
+}
+
+void SimUsb::interrupt(Event event, std::uint8_t address, const SetupPacket& setup) {
+    interrupts_.push_back({now_ns_ + ns(timing_.isr_latency_us), event, address, setup});
+}
+
+void SimUsb::deliver(const Pending& pending) {
+    if (owner_ == nullptr) {
+        return;
+    }
+    platform::host::IsrScope isr;
+    switch (pending.event) {
+    case Event::reset:
+        owner_->isr_reset();
+        break;
+    case Event::setup:
+        owner_->isr_setup(pending.setup);
+        break;
+    case Event::in:
+        owner_->isr_in(pending.address);
+        break;
+    case Event::out:
+        owner_->isr_out(pending.address);
+        break;
+    }
+}
+
+bool SimUsb::polled(std::size_t slot) const {
+    if (slot % 8 == 0) {
+        return false;  // EP0 moves only under control_in()/control_out()
+    }
+    const Endpoint& ep = endpoint(slot_address(slot));
+    if (!ep.open || ep.stalled) {
+        return false;
+    }
+    return slot < 8 ? ep.listening && ep.resume_ns <= now_ns_ : !ep.pending.empty();
+}
+
+bool SimUsb::ready(std::size_t slot) const {
+    const Endpoint& ep = endpoint(slot_address(slot));
+    return slot < 8 ? ep.buffer[ep.hw].full : !ep.buffer[ep.hw].full;
+}
+
+// One host transaction, or false if every polled endpoint would NAK: then
+// nothing changes until the next device interrupt.
+bool SimUsb::transaction() {
+    bool any = false;
+    for (std::size_t s = 0; s < kSlots && !any; ++s) {
+        any = polled(s) && ready(s);
+    }
+    if (!any) {
+        return false;
+    }
+    const std::size_t slot = next_poll_;
+    next_poll_ = (next_poll_ + 1) % kSlots;
+    if (!polled(slot)) {
+        return true;
+    }
+    const std::uint8_t address = slot_address(slot);
+    Endpoint& ep = endpoint(address);
+    if (!ready(slot)) {
+        now_ns_ += ns(timing_.nak_us);
+        ++ep.stats.naks;
+        return true;
+    }
+    // A transaction must finish inside the frame it starts in; the next
+    // frame begins with its SOF.
+    const std::size_t bytes = slot < 8 ? ep.buffer[ep.hw].size : ep.pending.front().size();
+    const std::uint64_t duration = ns(packet_us(bytes));
+    const std::uint64_t frame = ns(timing_.frame_us);
+    const std::uint64_t sof = ns(timing_.sof_us);
+    const std::uint64_t in_frame = now_ns_ % frame;
+    if (in_frame < sof || in_frame + duration > frame) {
+        now_ns_ += in_frame < sof ? sof - in_frame : frame - in_frame + sof;
+        next_poll_ = slot;
+        return true;
+    }
+    now_ns_ += duration;
+    if (slot < 8) {
+        in_packet(address, ep);
+    } else {
+        out_packet(address, ep);
+    }
+    return true;
+}
+
+void SimUsb::in_packet(std::uint8_t address, Endpoint& ep) {
+    Buffer& b = ep.buffer[ep.hw];
+    b.full = false;
+    ep.hw = (ep.hw + 1) % ep.buffers;
+    ep.received.insert(ep.received.end(), b.data, b.data + b.size);
+    ++ep.stats.packets;
+    ep.stats.bytes += static_cast<std::uint32_t>(b.size);
+    ep.stats.zlps += b.size == 0 ? 1 : 0;
+    if (b.size < ep.max_packet && timing_.short_packet_ends_frame) {
+        const std::uint64_t frame = ns(timing_.frame_us);
+        ep.resume_ns = (now_ns_ / frame + 1) * frame;
+    }
+    interrupt(Event::in, address);
+    if (in_listener_) {
+        in_listener_(address, {b.data, b.size});
+    }
+}
+
+void SimUsb::out_packet(std::uint8_t address, Endpoint& ep) {
+    Buffer& b = ep.buffer[ep.hw];
+    const std::vector<std::uint8_t>& packet = ep.pending.front();
+    std::copy(packet.begin(), packet.end(), b.data);
+    b.size = packet.size();
+    b.full = true;
+    ep.hw = (ep.hw + 1) % ep.buffers;
+    ++ep.stats.packets;
+    ep.stats.bytes += static_cast<std::uint32_t>(b.size);
+    ep.stats.zlps += b.size == 0 ? 1 : 0;
+    ep.pending.pop_front();
+    interrupt(Event::out, address);
+}
+
+void SimUsb::step(std::uint64_t deadline) {
+    if (!interrupts_.empty() && interrupts_.front().at <= now_ns_) {
+        const Pending pending = interrupts_.front();
+        interrupts_.pop_front();
+        deliver(pending);
+        return;
+    }
+    if (main_loop_ && next_loop_ns_ <= now_ns_) {
+        next_loop_ns_ += loop_period_ns_;
+        main_loop_();
+        return;
+    }
+    if (transaction()) {
+        return;
+    }
+    // Idle until the next event; the host keeps polling meanwhile.
+    std::uint64_t next = deadline;
+    if (!interrupts_.empty()) {
+        next = std::min(next, interrupts_.front().at);
+    }
+    if (main_loop_) {
+        next = std::min(next, next_loop_ns_);
+    }
+    for (const Endpoint& ep : in_) {
+        if (ep.resume_ns > now_ns_) {
+            next = std::min(next, ep.resume_ns);
+        }
+    }
+    if (next > now_ns_) {
+        std::size_t count = 0;
+        for (std::size_t s = 0; s < kSlots; ++s) {
+            count += polled(s) ? 1 : 0;
+        }
+        for (std::size_t s = 0; s < kSlots && count != 0; ++s) {
+            if (polled(s)) {
+                const std::uint64_t polls = (next - now_ns_) / ns(timing_.nak_us) / count;
+                endpoint(slot_address(s)).stats.naks += static_cast<std::uint32_t>(polls != 0 ? polls : 1);
+            }
+        }
+        now_ns_ = next;
+    }
+}
+
+void SimUsb::run_us(double us) {
+    const std::uint64_t deadline = now_ns_ + ns(us);
+    while (now_ns_ < deadline) {
+        step(deadline);
+    }
+}
+
+bool SimUsb::run_until(const std::function<bool()>& done, double timeout_us) {
+    const std::uint64_t deadline = now_ns_ + ns(timeout_us);
+    while (!done()) {
+        if (now_ns_ >= deadline) {
+            return false;
+        }
+        step(deadline);
+    }
+    return true;
+}
+
+void SimUsb::set_main_loop(std::function<void()> fn, double period_us) {
+    main_loop_ = std::move(fn);
+    loop_period_ns_ = std::max<std::uint64_t>(1, ns(period_us));
+    next_loop_ns_ = now_ns_;
+}
+
+// ---- host side ----
+
+void SimUsb::bus_reset() {
+    for (std::size_t i = 0; i < 8; ++i) {
+        for (Endpoint* ep : {&in_[i], &out_[i]}) {
+            ep->open = false;
+            ep->stalled = false;
+            ep->buffer[0].full = false;
+            ep->buffer[1].full = false;
+            ep->cpu = 0;
+            ep->hw = 0;
+            ep->pending.clear();
+        }
+    }
+    address_ = 0;
+    address_pending_ = false;
+    interrupts_.clear();
+    now_ns_ += ns(kResetUs);
+    interrupt(Event::reset, 0);
+    settle();
+}
+
+void SimUsb::settle() {
+    run_until([this] { return interrupts_.empty(); }, kControlTimeoutUs);
+}
+
+Status SimUsb::setup_stage(const SetupPacket& setup) {
+    if (owner_ == nullptr) {
+        return Status::not_found;
+    }
+    // SETUP is always accepted: it clears an EP0 stall and whatever EP0
+    // was still holding from the previous control transfer.
+    for (Endpoint* ep : {&endpoint(kEp0In), &endpoint(kEp0Out)}) {
+        if (!ep->open) {
+            return Status::not_found;
+        }
+        ep->stalled = false;
+        ep->buffer[0].full = false;
+        ep->cpu = 0;
+        ep->hw = 0;
+    }
+    now_ns_ += ns(packet_us(8));
+    interrupt(Event::setup, kEp0Out, setup);
+    return Status::ok;
+}
+
+Status SimUsb::take_control_in(std::vector<std::uint8_t>& data, std::size_t& size) {
+    Endpoint& ep = endpoint(kEp0In);
+    if (!run_until([&ep] { return ep.stalled || ep.buffer[ep.hw].full; }, kControlTimeoutUs)) {
+        return Status::timeout;
+    }
+    if (ep.stalled) {
+        return Status::hardware_error;
+    }
+    Buffer& b = ep.buffer[ep.hw];
+    data.insert(data.end(), b.data, b.data + b.size);
+    size = b.size;
+    b.full = false;
+    now_ns_ += ns(packet_us(size));
+    ++ep.stats.packets;
+    ep.stats.bytes += static_cast<std::uint32_t>(size);
+    ep.stats.zlps += size == 0 ? 1 : 0;
+    if (size == 0 && address_pending_) {
+        // The status stage of SET_ADDRESS is done: the new address counts.
+        address_ = pending_address_;
+        address_pending_ = false;
+    }
+    interrupt(Event::in, kEp0In);
+    return Status::ok;
+}
+
+Status SimUsb::put_control_out(ConstByteSpan packet) {
+    Endpoint& ep = endpoint(kEp0Out);
+    if (!run_until([&ep] { return ep.stalled || !ep.buffer[ep.hw].full; }, kControlTimeoutUs)) {
+        return Status::timeout;
+    }
+    if (ep.stalled) {
+        return Status::hardware_error;
+    }
+    Buffer& b = ep.buffer[ep.hw];
+    std::memcpy(b.data, packet.data(), packet.size());
+    b.size = packet.size();
+    b.full = true;
+    now_ns_ += ns(packet_us(packet.size()));
+    ++ep.stats.packets;
+    ep.stats.bytes += static_cast<std::uint32_t>(packet.size());
+    interrupt(Event::out, kEp0Out);
+    return Status::ok;
+}
+
+Status SimUsb::control_in(const SetupPacket& setup, std::vector<std::uint8_t>& data) {
+    data.clear();
+    Status status = setup_stage(setup);
+    const std::size_t max_packet = endpoint(kEp0In).max_packet;
+    while (status == Status::ok && data.size() < setup.length) {
+        std::size_t size = 0;
+        status = take_control_in(data, size);
+        if (size < max_packet) {
+            break;
+        }
+    }
+    if (status == Status::ok) {
+        status = put_control_out({});
+    }
+    settle();
+    return status;
+}
+
+Status SimUsb::control_out(const SetupPacket& setup, ConstByteSpan data) {
+    Status status = setup_stage(setup);
+    const std::size_t max_packet = endpoint(kEp0Out).max_packet;
+    for (std::size_t at = 0; status == Status::ok && at < data.size(); at += max_packet) {
+        status = put_control_out(data.subspan(at, std::min(max_packet, data.size() - at)));
+    }
+    if (status == Status::ok) {
+        std::vector<std::uint8_t> zlp;
+        std::size_t size = 0;
+        status = take_control_in(zlp, size);
+        if (status == Status::ok && size != 0) {
+            status = Status::corrupt;
+        }
+    }
+    settle();
+    return status;
+}
+
+Status SimUsb::enumerate() {
+    bus_reset();
+    // As a host does: the first 64 bytes of the device descriptor at
+    // address 0, then SET_ADDRESS and the full descriptors.
+    std::vector<std::uint8_t> data;
+    Status status = control_in(request(0x80, 0x06, 0x0100, 0, 64), data);
+    if (status == Status::ok) {
+        status = control_out(request(0x00, 0x05, kAssignedAddress, 0, 0));
+    }
+    if (status == Status::ok) {
+        status = control_in(request(0x80, 0x06, 0x0100, 0, 18), data);
+    }
+    if (status == Status::ok) {
+        status = control_in(request(0x80, 0x06, 0x0200, 0, 9), data);
+    }
+    if (status == Status::ok && data.size() >= 4) {
+        const std::uint16_t total = static_cast<std::uint16_t>(data[2] | data[3] << 8);
+        status = control_in(request(0x80, 0x06, 0x0200, 0, total), data);
+    }
+    for (std::uint16_t index = 0; index <= 3 && status == Status::ok; ++index) {
+        status = control_in(request(0x80, 0x06, static_cast<std::uint16_t>(0x0300 | index), 0x0409, 255), data);
+    }
+    if (status == Status::ok) {
+        status = control_out(request(0x00, 0x09, 1, 0, 0));
+    }
+    return status;
+}
+
+void SimUsb::listen(std::uint8_t address, bool on) { endpoint(address).listening = on; }
+
+const std::vector<std::uint8_t>& SimUsb::received(std::uint8_t address) const { return endpoint(address).received; }
+
+void SimUsb::clear_received(std::uint8_t address) { endpoint(address).received.clear(); }
+
+void SimUsb::send_out(std::uint8_t address, ConstByteSpan data, bool end_transfer) {
+    Endpoint& ep = endpoint(address);
+    const std::size_t max_packet = ep.max_packet != 0 ? ep.max_packet : 64;
+    for (std::size_t at = 0; at < data.size(); at += max_packet) {
+        const std::size_t n = std::min(max_packet, data.size() - at);
+        ep.pending.emplace_back(data.data() + at, data.data() + at + n);
+    }
+    if (end_transfer && data.size() % max_packet == 0) {
+        ep.pending.emplace_back();
+    }
+}
+
+std::size_t SimUsb::out_pending(std::uint8_t address) const {
+    std::size_t n = 0;
+    for (const std::vector<std::uint8_t>& packet : endpoint(address).pending) {
+        n += packet.size();
+    }
+    return n;
+}
+
+bool SimUsb::stalled(std::uint8_t address) const { return endpoint(address).stalled; }
+
+EndpointStats SimUsb::stats(std::uint8_t address) const { return endpoint(address).stats; }
+
+SimUsb& usb_sim() {
+    static SimUsb sim;
+    return sim;
+}
+
+}  // namespace host
+
+UsbPort& fs_port() { return host::usb_sim(); }
+
+}  // namespace nucleo::usb
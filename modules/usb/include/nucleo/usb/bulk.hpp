@@ -0,0 +1,220 @@
+// Bulk pipes: the data path of the CDC and vendor classes.
+//
+// BulkIn sends multi-packet transfers straight out of the caller's memory:
+// each packet is copied from the application buffer into the endpoint's
+// packet memory as a hardware buffer frees up, with no staging copy in
+// between. The refill runs from the transmit-complete interrupt, and with
+// a double-buffered endpoint the next packet is already waiting when the
+// host's IN token arrives, so the endpoint never NAKs while data is
+// queued. Small writes are copied into a staging buffer instead and merged
+// while the endpoint is busy, so a burst of log lines goes out as full
+// packets rather than one short transfer per line.
+//
+// BulkOut receives into caller buffers the same way: packets are copied
+// from packet memory into the oldest submitted buffer. With no buffer
+// submitted the packet stays in packet memory and the host is NAKed,
+// which is USB's flow control.
+//
+// submit()/write()/flush()/receive() may be called from the main loop;
+// they mask interrupts while they touch the queues.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/irq.hpp"
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+#include "nucleo/usb/port.hpp"
+
+namespace nucleo::usb {
+
+/// Full-speed bulk packet size.
+constexpr std::size_t kBulkPacket = 64;
+
+enum class Framing : std::uint8_t {
+    /// Submissions form one byte stream: packets are filled across their
+    /// boundaries and only the end of a burst is a short packet (or a ZLP).
+    /// What a CDC serial port carries.
+    stream,
+    /// Every submission ends in a short packet or ZLP, so the host reads it
+    /// as one transfer. For message-oriented vendor protocols.
+    transfer,
+};
+
+struct BulkInConfig {
+    Framing framing = Framing::stream;
+    /// Merge write()s while the endpoint is busy. Off, each write() is
+    /// queued as its own transfer.
+    bool coalesce = true;
+};
+
+struct BulkInStats {
+    std::uint32_t transfers = 0;      ///< submissions completed, staged ones included
+    std::uint32_t packets = 0;        ///< packets handed to the port, ZLPs included
+    std::uint32_t short_packets = 0;  ///< below max packet size, ZLPs included
+    std::uint32_t zlps = 0;
+    std::uint32_t bytes = 0;
+    std::uint32_t coalesced_writes = 0;  ///< write()s joining bytes already staged
+    std::uint32_t queue_full = 0;        ///< submit()/write() refused with busy
+};
+
+class BulkIn {
+public:
+    static constexpr std::size_t kQueueDepth = 8;
+    /// Staging ring for write(): two full-speed frames' worth of packets.
+    static constexpr std::size_t kStageSize = 1024;
+
+    using Ticket = std::uint32_t;
+
+    explicit BulkIn(BulkInConfig config = {}) : config_(config) {}
+    BulkIn(const BulkIn&) = delete;
+    BulkIn& operator=(const BulkIn&) = delete;
+
+    /// Queues `data` to be sent from the caller's memory. The memory is
+    /// read until done(ticket) (the last byte copied into packet memory).
+    /// busy if the queue is full; not_found if no host has configured the
+    /// device.
+    Status submit(ConstByteSpan data, Ticket* ticket = nullptr);
+
+    /// Copies up to kStageSize bytes for sending. busy if the staging ring
+    /// cannot take all of `data` now.
+    Status write(ConstByteSpan data);
+
+    /// Sends what is staged as soon as a buffer is free, even as a short
+    /// packet, instead of holding it back to fill a packet.
+    void flush();
+
+    bool done(Ticket ticket) const { return static_cast<std::int32_t>(completed_ - ticket) >= 0; }
+    /// Submissions not yet done.
+    std::size_t queued() const { return count_; }
+    /// Nothing queued, staged or in flight.
+    bool idle() const { return count_ == 0 && stage_size_ == 0 && in_flight_ == 0; }
+    bool attached() const { return port_ != nullptr; }
+    BulkInStats stats() const { return stats_; }
+
+    // ---- driven by the device, with interrupts masked ----
+
+    /// The endpoint was opened.
+    void attach(UsbPort& port, std::uint8_t address);
+    /// Bus reset or deconfiguration: everything queued is dropped and
+    /// counts as done, so callers waiting on tickets do not hang.
+    void detach();
+    /// A transmit buffer went out.
+    void on_sent();
+
+private:
+    // A submission: caller memory, or (data == nullptr) the next `size`
+    // bytes of the staging ring.
+    struct Transfer {
+        const std::uint8_t* data;
+        std::uint32_t size;
+        std::uint32_t offset;
+    };
+
+    Status enqueue(const std::uint8_t* data, std::size_t size, Ticket* ticket);
+    void claim_tail();
+    std::size_t tail() const { return stage_size_ - stage_claimed_; }
+    std::size_t available(std::size_t cap) const;
+    std::size_t gather(std::size_t want, std::uint8_t* bounce, const std::uint8_t*& out, std::size_t& finished);
+    void send(const std::uint8_t* data, std::size_t size);
+    void complete(std::size_t transfers);
+    void pump();
+
+    BulkInConfig config_;
+    UsbPort* port_ = nullptr;
+    std::uint8_t address_ = 0;
+    std::size_t in_flight_ = 0;  // packets written and not yet reported sent
+    bool need_zlp_ = false;      // the last packet was full and ended a burst
+    bool push_ = false;          // flush(): no holding back until drained
+
+    Transfer queue_[kQueueDepth] = {};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    Ticket issued_ = 0;
+    Ticket completed_ = 0;
+
+    std::uint8_t stage_[kStageSize] = {};
+    std::size_t stage_head_ = 0;     // oldest staged byte
+    std::size_t stage_size_ = 0;     // staged bytes
+    std::size_t stage_claimed_ = 0;  // of which queued as ring transfers
+
+    BulkInStats stats_{};
+};
+
+struct BulkOutStats {
+    std::uint32_t packets = 0;
+    std::uint32_t bytes = 0;
+    std::uint32_t buffers = 0;    ///< buffers completed
+    std::uint32_t held = 0;       ///< packets left in packet memory for want of a buffer
+};
+
+class BulkOut {
+public:
+    static constexpr std::size_t kQueueDepth = 8;
+
+    BulkOut() = default;
+    BulkOut(const BulkOut&) = delete;
+    BulkOut& operator=(const BulkOut&) = delete;
+
+    /// Queues `buffer` (at least kBulkPacket bytes) to receive into. It
+    /// completes when full or when a short packet ends the host's transfer.
+    Status submit(ByteSpan buffer);
+
+    /// Hands each completed buffer to fn(ConstByteSpan received) in order;
+    /// the buffer is the caller's again once fn returns. Returns the number
+    /// delivered.
+    template <typename Fn>
+    std::size_t receive(Fn&& fn) {
+        std::size_t delivered = 0;
+        for (;;) {
+            ConstByteSpan data;
+            {
+                platform::CriticalSection lock;
+                if (done_ == 0) {
+                    break;
+                }
+                const Slot& slot = slots_[head_];
+                data = {slot.buffer.data(), slot.filled};
+            }
+            fn(data);
+            {
+                platform::CriticalSection lock;
+                head_ = (head_ + 1) % kQueueDepth;
+                --count_;
+                --done_;
+            }
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    /// Buffers submitted and not yet filled.
+    std::size_t waiting() const { return count_ - done_; }
+    BulkOutStats stats() const { return stats_; }
+
+    // ---- driven by the device, with interrupts masked ----
+
+    void attach(UsbPort& port, std::uint8_t address);
+    void detach();
+    /// A packet arrived.
+    void on_packet();
+
+private:
+    struct Slot {
+        ByteSpan buffer;
+        std::size_t filled;
+    };
+
+    void drain();
+
+    UsbPort* port_ = nullptr;
+    std::uint8_t address_ = 0;
+    Slot slots_[kQueueDepth] = {};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;  // submitted, not yet handed back
+    std::size_t done_ = 0;   // the first done_ of them are complete
+    BulkOutStats stats_{};
+};
+
+}  // namespace nucleo::usb
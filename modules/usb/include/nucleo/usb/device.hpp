@@ -0,0 +1,143 @@
+// USB device: enumeration, the EP0 control state machine and the CDC-ACM
+// or vendor-class bulk interface.
+//
+// One configuration, one data interface with a bulk IN (0x81, double
+// buffered) and a bulk OUT (0x02) endpoint. As a CDC-ACM device it also
+// has the communication interface with its interrupt notification endpoint
+// (0x83), which is what makes the host bind its serial driver (ttyACM,
+// usbser.sys) without a custom driver; as a vendor-class device the host
+// talks to the bulk endpoints directly (libusb, WinUSB).
+//
+// All of it runs from the USB interrupt; the application only touches the
+// bulk pipes, through in() and out().
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+#include "nucleo/usb/bulk.hpp"
+#include "nucleo/usb/port.hpp"
+
+namespace nucleo::usb {
+
+enum class DeviceClass : std::uint8_t {
+    cdc_acm,
+    vendor,
+};
+
+struct DeviceConfig {
+    DeviceClass device_class = DeviceClass::cdc_acm;
+    std::uint16_t vendor_id = 0x0483;  // STMicroelectronics
+    std::uint16_t product_id = 0x5740;  // ST virtual COM port
+    const char* manufacturer = "nucleo";
+    const char* product = "nucleo-h563zi";
+    const char* serial = "0001";
+    BulkInConfig in;
+    /// Two packet buffers on the bulk IN endpoint, so one is refilled while
+    /// the other is on the bus.
+    bool double_buffered = true;
+};
+
+/// CDC line coding (SET/GET_LINE_CODING). The device does not act on it;
+/// it is kept so the host reads back what it set.
+struct LineCoding {
+    std::uint32_t baud = 115200;
+    std::uint8_t stop_bits = 0;  ///< 0: 1, 1: 1.5, 2: 2
+    std::uint8_t parity = 0;     ///< 0 none, 1 odd, 2 even, 3 mark, 4 space
+    std::uint8_t data_bits = 8;
+};
+
+struct DeviceStats {
+    std::uint32_t resets = 0;
+    std::uint32_t setups = 0;
+    std::uint32_t stalls = 0;  ///< requests answered with a protocol stall
+};
+
+class Device {
+public:
+    static constexpr std::uint8_t kDataIn = 0x81;
+    static constexpr std::uint8_t kDataOut = 0x02;
+    static constexpr std::uint8_t kNotify = 0x83;
+    static constexpr std::uint16_t kControlPacket = 64;
+
+    explicit Device(const DeviceConfig& config = {});
+    Device(const Device&) = delete;
+    Device& operator=(const Device&) = delete;
+
+    /// Connects to the bus; enumeration continues from the interrupt.
+    Status start(UsbPort& port);
+    void stop();
+
+    /// The host has selected the configuration: the bulk pipes are live.
+    bool configured() const { return configuration_ != 0; }
+    std::uint8_t address() const { return address_; }
+    BulkIn& in() { return in_; }
+    BulkOut& out() { return out_; }
+    LineCoding line_coding() const { return line_coding_; }
+    /// DTR from SET_CONTROL_LINE_STATE: a terminal has the port open.
+    bool dtr() const { return (line_state_ & 0x01) != 0; }
+    DeviceStats stats() const { return stats_; }
+
+    /// The descriptors as the host reads them.
+    ConstByteSpan device_descriptor() const { return {device_desc_, sizeof device_desc_}; }
+    ConstByteSpan config_descriptor() const { return {config_desc_, config_size_}; }
+
+    // ---- called by the port, from its interrupt ----
+
+    void isr_reset();
+    void isr_setup(const SetupPacket& setup);
+    void isr_in(std::uint8_t address);
+    void isr_out(std::uint8_t address);
+
+private:
+    enum class Stage : std::uint8_t {
+        idle,
+        data_in,     // sending reply_ to the host
+        data_out,    // receiving the request's data stage
+        status_in,   // status ZLP queued
+        status_out,  // waiting for the host's status ZLP
+    };
+
+    void build_descriptors();
+    bool standard_request(const SetupPacket& setup);
+    bool class_request(const SetupPacket& setup);
+    bool get_descriptor(std::uint16_t value);
+    bool set_configuration(std::uint8_t value);
+    void finish_data_out();
+    void reply(ConstByteSpan data);
+    void send_next_control();
+    void acknowledge();
+    void stall_control();
+    void open_data_endpoints();
+
+    DeviceConfig config_;
+    UsbPort* port_ = nullptr;
+    BulkIn in_;
+    BulkOut out_;
+
+    Stage stage_ = Stage::idle;
+    SetupPacket setup_{};
+    ConstByteSpan reply_;
+    std::size_t reply_sent_ = 0;
+    bool reply_zlp_ = false;
+    std::uint8_t control_[kControlPacket] = {};  // string descriptors, small replies, OUT data
+    std::size_t control_size_ = 0;
+
+    std::uint8_t address_ = 0;
+    std::uint8_t configuration_ = 0;
+    std::uint8_t alternate_ = 0;
+    bool in_halted_ = false;
+    bool out_halted_ = false;
+    LineCoding line_coding_{};
+    std::uint16_t line_state_ = 0;
+
+    std::uint8_t device_desc_[18] = {};
+    std::uint8_t config_desc_[67] = {};
+    std::size_t config_size_ = 0;
+
+    DeviceStats stats_{};
+};
+
+}  // namespace nucleo::usb
@@ -0,0 +1,13 @@
+// The full-speed USB device port (USB_DRD_FS on PA11/PA12, the user USB
+// connector CN13).
+#pragma once
+
+#include "nucleo/usb/port.hpp"
+
+namespace nucleo::usb {
+
+/// USB_DRD_FS clocked from HSI48 with CRS trimming on the target; the
+/// SimUsb returned by host::usb_sim() on the host.
+UsbPort& fs_port();
+
+}  // namespace nucleo::usb
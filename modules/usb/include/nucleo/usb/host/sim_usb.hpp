@@ -0,0 +1,180 @@
+// Simulated USB device controller and the host on the other end of the
+// cable (host only).
+//
+// The endpoint layer behaves like USB_DRD_FS: one or two packet buffers per
+// endpoint, owned alternately by the CPU and the hardware, and an
+// interrupt per packet. The host side runs the bus in virtual time: SOF
+// every frame, bulk transactions back to back within the frame at
+// full-speed packet timing, and NAKs while the device has nothing ready.
+// Device interrupts arrive isr_latency_us after the packet that caused
+// them, inside an IsrScope. Throughput and latency measured against it are
+// those of the protocol and the class, not of the host CPU.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "nucleo/usb/device.hpp"
+#include "nucleo/usb/port.hpp"
+
+#if !NUCLEO_PLATFORM_HOST
+#error "nucleo/usb/host/sim_usb.hpp is only available in host builds"
+#endif
+
+namespace nucleo::usb::host {
+
+struct BusTiming {
+    double frame_us = 1000.0;
+    double sof_us = 4.0;      ///< start of each frame taken by the SOF packet
+    double bit_rate = 12e6;
+    /// Bytes on the wire per data transaction besides the payload: token,
+    /// data PID and CRC, handshake, sync and EOP fields and inter-packet
+    /// gaps. 13 allows 19 full packets per frame, as on a real bus.
+    std::size_t overhead_bytes = 13;
+    double nak_us = 4.0;  ///< a token answered with NAK
+    double isr_latency_us = 3.0;
+    /// A short packet (or ZLP) completes the host's transfer, and the host
+    /// controller polls that endpoint again only from the next frame, once
+    /// the transfer is retired and the driver has queued another. This is
+    /// what holds one-transfer-per-message traffic to 1000 messages/s.
+    bool short_packet_ends_frame = true;
+};
+
+struct EndpointStats {
+    std::uint32_t packets = 0;
+    std::uint32_t bytes = 0;
+    std::uint32_t zlps = 0;
+    std::uint32_t naks = 0;  ///< host polls answered NAK
+};
+
+class SimUsb final : public UsbPort {
+public:
+    Status start(Device& owner) override;
+    void stop() override;
+    Status open(const EndpointConfig& config) override;
+    void set_address(std::uint8_t address) override;
+    std::size_t write_space(std::uint8_t address) override;
+    Status write(std::uint8_t address, ConstByteSpan packet) override;
+    Status read(std::uint8_t address, ByteSpan out, std::size_t& size) override;
+    void stall(std::uint8_t address, bool stalled) override;
+
+    /// Power-on state: detached, time zero, default timing, nothing queued.
+    void reset();
+    void set_timing(const BusTiming& timing) { timing_ = timing; }
+    const BusTiming& timing() const { return timing_; }
+
+    // ---- host side ----
+
+    /// Drives a bus reset; every endpoint closes and the address returns
+    /// to 0.
+    void bus_reset();
+    /// Bus reset, descriptors, SET_ADDRESS and SET_CONFIGURATION(1), as a
+    /// host does on attach.
+    Status enumerate();
+    /// A control transfer with an IN data stage; `data` receives up to
+    /// setup.length bytes. A stall from the device is hardware_error.
+    Status control_in(const SetupPacket& setup, std::vector<std::uint8_t>& data);
+    /// A control transfer with an OUT data stage (or none).
+    Status control_out(const SetupPacket& setup, ConstByteSpan data = {});
+
+    /// Keeps IN tokens going to bulk endpoint `address`, as a host does
+    /// while an application reads from it. Received bytes collect in
+    /// received().
+    void listen(std::uint8_t address, bool on = true);
+    /// Called for every IN data packet, with now_us() at its end.
+    void set_in_listener(std::function<void(std::uint8_t address, ConstByteSpan packet)> listener) {
+        in_listener_ = std::move(listener);
+    }
+    const std::vector<std::uint8_t>& received(std::uint8_t address) const;
+    void clear_received(std::uint8_t address);
+
+    /// Queues bytes for OUT endpoint `address`; a transfer that ends on a
+    /// packet boundary is closed with a ZLP when `end_transfer` is set.
+    void send_out(std::uint8_t address, ConstByteSpan data, bool end_transfer = true);
+    /// Bytes queued by send_out() not yet accepted by the device.
+    std::size_t out_pending(std::uint8_t address) const;
+
+    /// Runs `fn` every `period_us` of virtual time, outside interrupt
+    /// context: the application's main loop. nullptr removes it.
+    void set_main_loop(std::function<void()> fn, double period_us);
+
+    void run_us(double us);
+    /// Runs until done() holds or timeout_us passes. Returns done().
+    bool run_until(const std::function<bool()>& done, double timeout_us);
+    double now_us() const { return static_cast<double>(now_ns_) / 1000.0; }
+
+    std::uint8_t address() const { return address_; }
+    bool stalled(std::uint8_t address) const;
+    EndpointStats stats(std::uint8_t address) const;
+    /// Wire time of one data transaction with `bytes` of payload.
+    double packet_us(std::size_t bytes) const;
+
+private:
+    struct Buffer {
+        std::uint8_t data[64];
+        std::size_t size;
+        bool full;
+    };
+    struct Endpoint {
+        bool open = false;
+        bool stalled = false;
+        bool listening = false;
+        std::uint16_t max_packet = 0;
+        std::size_t buffers = 1;
+        Buffer buffer[2] = {};
+        std::size_t cpu = 0;  // next buffer the CPU fills (IN) or drains (OUT)
+        std::size_t hw = 0;   // next buffer the bus sends (IN) or fills (OUT)
+        std::vector<std::uint8_t> received;
+        std::deque<std::vector<std::uint8_t>> pending;  // OUT packets from send_out()
+        std::uint64_t resume_ns = 0;                    // IN polling pauses until then
+        EndpointStats stats;
+    };
+    enum class Event : std::uint8_t { reset, setup, in, out };
+    struct Pending {
+        std::uint64_t at;
+        Event event;
+        std::uint8_t address;
+        SetupPacket setup;
+    };
+
+    Endpoint& endpoint(std::uint8_t address);
+    const Endpoint& endpoint(std::uint8_t address) const;
+    std::uint64_t ns(double us) const { return static_cast<std::uint64_t>(us * 1000.0 + 0.5); }
+    void interrupt(Event event, std::uint8_t address, const SetupPacket& setup = {});
+    void deliver(const Pending& pending);
+    void step(std::uint64_t deadline);
+    bool transaction();
+    bool polled(std::size_t slot) const;
+    bool ready(std::size_t slot) const;
+    void in_packet(std::uint8_t address, Endpoint& ep);
+    void out_packet(std::uint8_t address, Endpoint& ep);
+    Status setup_stage(const SetupPacket& setup);
+    Status take_control_in(std::vector<std::uint8_t>& data, std::size_t& size);
+    Status put_control_out(ConstByteSpan packet);
+    void settle();
+
+    Device* owner_ = nullptr;
+    BusTiming timing_{};
+    std::uint64_t now_ns_ = 0;
+    Endpoint in_[8];
+    Endpoint out_[8];
+    std::uint8_t address_ = 0;
+    std::uint8_t pending_address_ = 0;
+    bool address_pending_ = false;
+    std::deque<Pending> interrupts_;
+    std::size_t next_poll_ = 0;  // round-robin position over the bulk endpoints
+
+    std::function<void()> main_loop_;
+    std::uint64_t loop_period_ns_ = 0;
+    std::uint64_t next_loop_ns_ = 0;
+    std::function<void(std::uint8_t, ConstByteSpan)> in_listener_;
+};
+
+/// The simulated port, same object as fs_port() in host builds.
+SimUsb& usb_sim();
+
+}  // namespace nucleo::usb::host
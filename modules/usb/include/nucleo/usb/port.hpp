@@ -0,0 +1,95 @@
+// Hardware half of the USB device stack: the endpoint layer.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/platform/status.hpp"
+
+namespace nucleo::usb {
+
+class Device;
+
+/// Direction bit of an endpoint address.
+constexpr std::uint8_t kIn = 0x80;
+
+/// bmAttributes transfer types.
+enum class EndpointType : std::uint8_t {
+    control = 0,
+    bulk = 2,
+    interrupt = 3,
+};
+
+struct EndpointConfig {
+    std::uint8_t address;  ///< number | kIn for IN endpoints
+    EndpointType type;
+    std::uint16_t max_packet;
+    /// Two packet buffers that the hardware and the CPU alternate on, so
+    /// one can be filled (or drained) while the other is on the bus. Bulk
+    /// only; a double-buffered endpoint is one direction only.
+    bool double_buffered = false;
+};
+
+/// The 8-byte SETUP packet of a control transfer.
+struct SetupPacket {
+    std::uint8_t request_type;
+    std::uint8_t request;
+    std::uint16_t value;
+    std::uint16_t index;
+    std::uint16_t length;
+
+    bool device_to_host() const { return (request_type & 0x80) != 0; }
+    std::uint8_t type() const { return (request_type >> 5) & 0x03; }  ///< 0 standard, 1 class, 2 vendor
+    std::uint8_t recipient() const { return request_type & 0x1F; }
+
+    static SetupPacket parse(const std::uint8_t* raw) {
+        return {raw[0], raw[1], static_cast<std::uint16_t>(raw[2] | raw[3] << 8),
+                static_cast<std::uint16_t>(raw[4] | raw[5] << 8), static_cast<std::uint16_t>(raw[6] | raw[7] << 8)};
+    }
+};
+
+/// Implemented by the USB DRD driver on the target and by SimUsb on the
+/// host. Calls are per packet: the port copies between packet memory and
+/// the caller's bytes and never holds on to them.
+///
+/// Bus events reach the owner through owner.isr_reset(), isr_setup(),
+/// isr_in(address) when a transmit buffer has gone out, and
+/// isr_out(address) when a packet has arrived. A SETUP discards whatever
+/// EP0 still had to send, as the control transfer it belonged to is over.
+class UsbPort {
+public:
+    /// Powers the transceiver and connects the D+ pull-up. The host's bus
+    /// reset follows as owner.isr_reset().
+    virtual Status start(Device& owner) = 0;
+    /// Disconnects from the bus.
+    virtual void stop() = 0;
+
+    /// Allocates packet memory for an endpoint. A bus reset closes every
+    /// endpoint, so the owner reopens them (EP0 first) from isr_reset().
+    /// OUT endpoints are ready to receive as soon as they are open.
+    virtual Status open(const EndpointConfig& config) = 0;
+
+    /// Takes effect once the status stage of SET_ADDRESS has gone out.
+    virtual void set_address(std::uint8_t address) = 0;
+
+    /// Transmit buffers of IN endpoint `address` the CPU may fill now.
+    virtual std::size_t write_space(std::uint8_t address) = 0;
+    /// Copies one packet (up to max_packet bytes; empty for a ZLP) into a
+    /// free buffer and hands it to the hardware. busy if none is free.
+    virtual Status write(std::uint8_t address, ConstByteSpan packet) = 0;
+
+    /// Copies the oldest received packet of OUT endpoint `address` into
+    /// `out`, sets `size` and gives the buffer back to the hardware.
+    /// underflow if nothing is waiting; overflow (packet kept) if `out` is
+    /// too small.
+    virtual Status read(std::uint8_t address, ByteSpan out, std::size_t& size) = 0;
+
+    /// Sets or clears the halt condition. An EP0 stall ends at the next SETUP.
+    virtual void stall(std::uint8_t address, bool stalled) = 0;
+
+protected:
+    ~UsbPort() = default;
+};
+
+}  // namespace nucleo::usb
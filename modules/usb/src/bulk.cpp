@@ -0,0 +1,324 @@
+#include "nucleo/usb/bulk.hpp"
+
+#include <cstring>
+
+namespace nucleo::usb {
+
+// ---- BulkIn ----
+
+Status BulkIn::submit(ConstByteSpan data, Ticket* ticket) {
+    platform::CriticalSection lock;
+    if (port_ == nullptr) {
+        return Status::not_found;
+    }
+    // Staged bytes written before this submission go out before it.
+    if (tail() != 0) {
+        if (count_ + 1 >= kQueueDepth) {
+            ++stats_.queue_full;
+            return Status::busy;
+        }
+        claim_tail();
+    }
+    const Status status = enqueue(data.data(), data.size(), ticket);
+    if (status == Status::ok) {
+        pump();
+    }
+    return status;
+}
+
+Status BulkIn::write(ConstByteSpan data) {
+    platform::CriticalSection lock;
+    if (port_ == nullptr) {
+        return Status::not_found;
+    }
+    if (data.size() > kStageSize) {
+        return Status::invalid_argument;
+    }
+    if (data.empty()) {
+        return Status::ok;
+    }
+    if (kStageSize - stage_size_ < data.size() || (!config_.coalesce && count_ == kQueueDepth)) {
+        ++stats_.queue_full;
+        return Status::busy;
+    }
+    if (tail() != 0) {
+        ++stats_.coalesced_writes;
+    }
+    // Copy in at the ring's end, in two pieces if it wraps.
+    const std::size_t at = (stage_head_ + stage_size_) % kStageSize;
+    const std::size_t first = data.size() < kStageSize - at ? data.size() : kStageSize - at;
+    std::memcpy(stage_ + at, data.data(), first);
+    std::memcpy(stage_, data.data() + first, data.size() - first);
+    stage_size_ += data.size();
+    if (!config_.coalesce) {
+        claim_tail();
+    }
+    pump();
+    return Status::ok;
+}
+
+void BulkIn::flush() {
+    platform::CriticalSection lock;
+    if (port_ == nullptr) {
+        return;
+    }
+    push_ = true;
+    pump();
+}
+
+void BulkIn::attach(UsbPort& port, std::uint8_t address) {
+    port_ = &port;
+    address_ = address;
+    in_flight_ = 0;
+    need_zlp_ = false;
+    push_ = false;
+}
+
+void BulkIn::detach() {
+    port_ = nullptr;
+    complete(count_);
+    stage_head_ = 0;
+    stage_size_ = 0;
+    stage_claimed_ = 0;
+    in_flight_ = 0;
+    need_zlp_ = false;
+    push_ = false;
+}
+
+void BulkIn::on_sent() {
+    if (in_flight_ != 0) {
+        --in_flight_;
+    }
+    pump();
+}
+
+Status BulkIn::enqueue(const std::uint8_t* data, std::size_t size, Ticket* ticket) {
+    if (size > UINT32_MAX) {
+        return Status::invalid_argument;
+    }
+    if (count_ == kQueueDepth) {
+        ++stats_.queue_full;
+        return Status::busy;
+    }
+    queue_[(head_ + count_) % kQueueDepth] = {data, static_cast<std::uint32_t>(size), 0};
+    ++count_;
+    ++issued_;
+    if (ticket != nullptr) {
+        *ticket = issued_;
+    }
+    return Status::ok;
+}
+
+void BulkIn::claim_tail() {
+    const std::size_t n = tail();
+    stage_claimed_ = stage_size_;
+    (void)enqueue(nullptr, n, nullptr);
+}
+
+std::size_t BulkIn::available(std::size_t cap) const {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count_ && n < cap; ++i) {
+        const Transfer& t = queue_[(head_ + i) % kQueueDepth];
+        n += t.size - t.offset;
+    }
+    if (config_.framing == Framing::stream) {
+        n += tail();
+    }
+    return n < cap ? n : cap;
+}
+
+// Takes the next `want` bytes: a pointer straight into their source when
+// one contiguous piece holds them all, else a copy in `bounce`. Sets
+// `finished` to the number of transfers at the head now fully taken; they
+// are completed once the packet has been copied out.
+std::size_t BulkIn::gather(std::size_t want, std::uint8_t* bounce, const std::uint8_t*& out, std::size_t& finished) {
+    std::size_t got = 0;
+    std::size_t index = 0;
+    finished = 0;
+    out = bounce;
+    while (got < want) {
+        const std::uint8_t* p;
+        std::size_t left;
+        Transfer* t = nullptr;
+        if (index < count_) {
+            t = &queue_[(head_ + index) % kQueueDepth];
+            left = t->size - t->offset;
+            if (left == 0) {
+                ++index;
+                ++finished;
+                continue;
+            }
+        } else {
+            left = tail();
+        }
+        std::size_t take = want - got < left ? want - got : left;
+        if (t != nullptr && t->data != nullptr) {
+            p = t->data + t->offset;
+        } else {
+            p = stage_ + stage_head_;
+            if (take > kStageSize - stage_head_) {
+                take = kStageSize - stage_head_;
+            }
+            stage_head_ = (stage_head_ + take) % kStageSize;
+            stage_size_ -= take;
+            if (t != nullptr) {
+                stage_claimed_ -= take;
+            }
+        }
+        if (got == 0 && take == want) {
+            out = p;
+        } else {
+            std::memcpy(bounce + got, p, take);
+        }
+        got += take;
+        if (t != nullptr) {
+            t->offset += static_cast<std::uint32_t>(take);
+            if (t->offset == t->size) {
+                ++index;
+                ++finished;
+            }
+        }
+    }
+    return got;
+}
+
+void BulkIn::send(const std::uint8_t* data, std::size_t size) {
+    (void)port_->write(address_, {data, size});
+    ++in_flight_;
+    ++stats_.packets;
+    stats_.bytes += static_cast<std::uint32_t>(size);
+    if (size < kBulkPacket) {
+        ++stats_.short_packets;
+    }
+    if (size == 0) {
+        ++stats_.zlps;
+    }
+}
+
+void BulkIn::complete(std::size_t transfers) {
+    head_ = (head_ + transfers) % kQueueDepth;
+    count_ -= transfers;
+    completed_ += static_cast<Ticket>(transfers);
+    stats_.transfers += static_cast<std::uint32_t>(transfers);
+}
+
+void BulkIn::pump() {
+    if (port_ == nullptr) {
+        return;
+    }
+    // Stream framing holds a short packet back while one is on the bus, so
+    // bytes written meanwhile join it: the packet rate is the only limit on
+    // how much gets merged, and an idle endpoint still sends at once.
+    const bool hold = config_.framing == Framing::stream && config_.coalesce && !push_;
+    std::uint8_t bounce[kBulkPacket];
+    while (port_->write_space(address_) != 0) {
+        const std::uint8_t* packet = nullptr;
+        std::size_t size = 0;
+        std::size_t finished = 0;
+        if (config_.framing == Framing::transfer) {
+            // Packets never span transfers; coalesced writes become one
+            // transfer once everything ahead of them has gone.
+            if (count_ == 0 && tail() != 0) {
+                claim_tail();
+            }
+            if (count_ == 0) {
+                break;
+            }
+            const Transfer& t = queue_[head_];
+            const std::size_t left = t.size - t.offset;
+            size = gather(left < kBulkPacket ? left : kBulkPacket, bounce, packet, finished);
+            // A full last packet keeps the transfer at the head with
+            // nothing left, which sends the ZLP next time round.
+            finished = size < kBulkPacket ? 1 : 0;
+        } else {
+            const std::size_t n = available(kBulkPacket);
+            if (n == 0) {
+                // Whatever is still queued is empty submissions.
+                complete(count_);
+                if (need_zlp_ && (!hold || in_flight_ == 0)) {
+                    send(bounce, 0);
+                    need_zlp_ = false;
+                }
+                push_ = false;
+                break;
+            }
+            if (n < kBulkPacket && hold && in_flight_ != 0) {
+                break;
+            }
+            size = gather(n, bounce, packet, finished);
+            need_zlp_ = size == kBulkPacket;
+        }
+        send(packet, size);
+        complete(finished);
+    }
+}
+
+// ---- BulkOut ----
+
+Status BulkOut::submit(ByteSpan buffer) {
+    platform::CriticalSection lock;
+    if (port_ == nullptr) {
+        return Status::not_found;
+    }
+    if (buffer.size() < kBulkPacket) {
+        return Status::invalid_argument;
+    }
+    if (count_ == kQueueDepth) {
+        return Status::busy;
+    }
+    slots_[(head_ + count_) % kQueueDepth] = {buffer, 0};
+    ++count_;
+    // A packet held for want of a buffer can land now.
+    drain();
+    return Status::ok;
+}
+
+void BulkOut::attach(UsbPort& port, std::uint8_t address) {
+    port_ = &port;
+    address_ = address;
+}
+
+void BulkOut::detach() {
+    // Buffers go back to the caller with whatever they hold.
+    port_ = nullptr;
+    stats_.buffers += static_cast<std::uint32_t>(count_ - done_);
+    done_ = count_;
+}
+
+void BulkOut::on_packet() {
+    if (done_ == count_) {
+        ++stats_.held;
+        return;
+    }
+    drain();
+}
+
+void BulkOut::drain() {
+    while (port_ != nullptr && done_ < count_) {
+        Slot& slot = slots_[(head_ + done_) % kQueueDepth];
+        std::size_t size = 0;
+        const Status status = port_->read(address_, slot.buffer.subspan(slot.filled), size);
+        if (status == Status::underflow) {
+            break;
+        }
+        if (status == Status::overflow) {
+            // The packet does not fit in what is left: this buffer is done
+            // and the packet goes into the next one.
+            ++done_;
+            ++stats_.buffers;
+            continue;
+        }
+        ++stats_.packets;
+        if (size == 0 && slot.filled == 0) {
+            continue;  // the ZLP after a transfer that filled the last buffer
+        }
+        stats_.bytes += static_cast<std::uint32_t>(size);
+        slot.filled += size;
+        if (size < kBulkPacket || slot.filled == slot.buffer.size()) {
+            ++done_;
+            ++stats_.buffers;
+        }
+    }
+}
+
+}  // namespace nucleo::usb
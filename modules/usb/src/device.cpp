@@ -0,0 +1,430 @@
+#include "nucleo/usb/device.hpp"
+
+#include <cstring>
+
+#include "nucleo/platform/byte_writer.hpp"
+
+namespace nucleo::usb {
+namespace {
+
+// bRequest codes, USB 2.0 table 9-4 and CDC PSTN table 13.
+constexpr std::uint8_t kGetStatus = 0x00;
+constexpr std::uint8_t kClearFeature = 0x01;
+constexpr std::uint8_t kSetFeature = 0x03;
+constexpr std::uint8_t kSetAddress = 0x05;
+constexpr std::uint8_t kGetDescriptor = 0x06;
+constexpr std::uint8_t kGetConfiguration = 0x08;
+constexpr std::uint8_t kSetConfiguration = 0x09;
+constexpr std::uint8_t kGetInterface = 0x0A;
+constexpr std::uint8_t kSetInterface = 0x0B;
+
+constexpr std::uint8_t kSetLineCoding = 0x20;
+constexpr std::uint8_t kGetLineCoding = 0x21;
+constexpr std::uint8_t kSetControlLineState = 0x22;
+constexpr std::uint8_t kSendBreak = 0x23;
+
+constexpr std::uint8_t kRecipientDevice = 0;
+constexpr std::uint8_t kRecipientInterface = 1;
+constexpr std::uint8_t kRecipientEndpoint = 2;
+constexpr std::uint16_t kEndpointHalt = 0;
+
+constexpr std::uint8_t kDescDevice = 1;
+constexpr std::uint8_t kDescConfig = 2;
+constexpr std::uint8_t kDescString = 3;
+constexpr std::uint8_t kDescInterface = 4;
+constexpr std::uint8_t kDescEndpoint = 5;
+constexpr std::uint8_t kDescCsInterface = 0x24;
+
+constexpr std::uint8_t kEp0Out = 0x00;
+constexpr std::uint8_t kEp0In = 0x80;
+constexpr std::uint16_t kNotifyPacket = 8;
+
+void endpoint(ByteWriter& w, std::uint8_t address, EndpointType type, std::uint16_t max_packet,
+              std::uint8_t interval) {
+    w.u8(7);
+    w.u8(kDescEndpoint);
+    w.u8(address);
+    w.u8(static_cast<std::uint8_t>(type));
+    w.u16(max_packet);
+    w.u8(interval);
+}
+
+void interface(ByteWriter& w, std::uint8_t number, std::uint8_t endpoints, std::uint8_t cls, std::uint8_t subclass,
+               std::uint8_t protocol) {
+    w.u8(9);
+    w.u8(kDescInterface);
+    w.u8(number);
+    w.u8(0);  // alternate setting
+    w.u8(endpoints);
+    w.u8(cls);
+    w.u8(subclass);
+    w.u8(protocol);
+    w.u8(0);  // no string
+}
+
+}  // namespace
+
+Device::Device(const DeviceConfig& config) : config_(config), in_(config.in) { build_descriptors(); }
+
+void Device::build_descriptors() {
+    const bool cdc = config_.device_class == DeviceClass::cdc_acm;
+
+    ByteWriter d({device_desc_, sizeof device_desc_});
+    d.u8(18);
+    d.u8(kDescDevice);
+    d.u16(0x0200);          // USB 2.0
+    d.u8(cdc ? 0x02 : 0);   // CDC at device level; vendor class per interface
+    d.u8(0);
+    d.u8(0);
+    d.u8(kControlPacket);
+    d.u16(config_.vendor_id);
+    d.u16(config_.product_id);
+    d.u16(0x0100);  // bcdDevice
+    d.u8(1);        // manufacturer, product and serial strings
+    d.u8(2);
+    d.u8(3);
+    d.u8(1);  // configurations
+
+    ByteWriter c({config_desc_, sizeof config_desc_});
+    c.u8(9);
+    c.u8(kDescConfig);
+    c.u16(0);  // total length, patched below
+    c.u8(cdc ? 2 : 1);
+    c.u8(1);     // bConfigurationValue
+    c.u8(0);     // no string
+    c.u8(0x80);  // bus powered
+    c.u8(50);    // 100 mA
+    if (cdc) {
+        // Communication interface: abstract control model, with the
+        // functional descriptors that tie it to data interface 1.
+        interface(c, 0, 1, 0x02, 0x02, 0x01);
+        const std::uint8_t functional[] = {
+            5, kDescCsInterface, 0x00, 0x10, 0x01,  // header, CDC 1.10
+            5, kDescCsInterface, 0x01, 0x00, 0x01,  // call management: data interface 1
+            4, kDescCsInterface, 0x02, 0x02,        // ACM: line coding and control line state
+            5, kDescCsInterface, 0x06, 0x00, 0x01,  // union: 0 controls 1
+        };
+        c.bytes(functional, sizeof functional);
+        endpoint(c, kNotify, EndpointType::interrupt, kNotifyPacket, 16);
+        interface(c, 1, 2, 0x0A, 0, 0);
+    } else {
+        interface(c, 0, 2, 0xFF, 0, 0);
+    }
+    endpoint(c, kDataOut, EndpointType::bulk, kBulkPacket, 0);
+    endpoint(c, kDataIn, EndpointType::bulk, kBulkPacket, 0);
+    config_size_ = c.size();
+    config_desc_[2] = static_cast<std::uint8_t>(config_size_);
+    config_desc_[3] = static_cast<std::uint8_t>(config_size_ >> 8);
+}
+
+Status Device::start(UsbPort& port) {
+    port_ = &port;
+    return port.start(*this);
+}
+
+void Device::stop() {
+    if (port_ == nullptr) {
+        return;
+    }
+    port_->stop();
+    in_.detach();
+    out_.detach();
+    configuration_ = 0;
+    address_ = 0;
+    stage_ = Stage::idle;
+}
+
+void Device::isr_reset() {
+    ++stats_.resets;
+    in_.detach();
+    out_.detach();
+    address_ = 0;
+    configuration_ = 0;
+    alternate_ = 0;
+    in_halted_ = false;
+    out_halted_ = false;
+    line_state_ = 0;
+    stage_ = Stage::idle;
+    (void)port_->open({kEp0Out, EndpointType::control, kControlPacket});
+    (void)port_->open({kEp0In, EndpointType::control, kControlPacket});
+}
+
+void Device::isr_setup(const SetupPacket& setup) {
+    ++stats_.setups;
+    setup_ = setup;
+    stage_ = Stage::idle;
+    control_size_ = 0;
+    if (!setup.device_to_host() && setup.length > kControlPacket) {
+        stall_control();
+        return;
+    }
+    bool handled = false;
+    if (setup.type() == 0) {
+        handled = standard_request(setup);
+    } else if (setup.type() == 1 && config_.device_class == DeviceClass::cdc_acm) {
+        handled = class_request(setup);
+    }
+    if (!handled) {
+        stall_control();
+    }
+}
+
+bool Device::standard_request(const SetupPacket& setup) {
+    const std::uint8_t recipient = setup.recipient();
+    const std::uint8_t ep = static_cast<std::uint8_t>(setup.index);
+    const bool data_ep = ep == kDataIn || ep == kDataOut;
+    switch (setup.request) {
+    case kGetStatus: {
+        std::uint8_t status = 0;
+        if (recipient == kRecipientEndpoint) {
+            if (!data_ep && (ep & 0x7F) != 0) {
+                return false;
+            }
+            status = (ep == kDataIn && in_halted_) || (ep == kDataOut && out_halted_) ? 1 : 0;
+        }
+        control_[0] = status;
+        control_[1] = 0;
+        reply({control_, 2});
+        return true;
+    }
+    case kClearFeature:
+    case kSetFeature: {
+        // Endpoint halt is the only feature: no remote wakeup, no test modes.
+        if (recipient != kRecipientEndpoint || setup.value != kEndpointHalt || !data_ep || !configured()) {
+            return false;
+        }
+        const bool halt = setup.request == kSetFeature;
+        (ep == kDataIn ? in_halted_ : out_halted_) = halt;
+        port_->stall(ep, halt);
+        acknowledge();
+        return true;
+    }
+    case kSetAddress:
+        if (recipient != kRecipientDevice || setup.value > 127) {
+            return false;
+        }
+        address_ = static_cast<std::uint8_t>(setup.value);
+        port_->set_address(address_);
+        acknowledge();
+        return true;
+    case kGetDescriptor:
+        return get_descriptor(setup.value);
+    case kGetConfiguration:
+        control_[0] = configuration_;
+        reply({control_, 1});
+        return true;
+    case kSetConfiguration:
+        return recipient == kRecipientDevice && set_configuration(static_cast<std::uint8_t>(setup.value));
+    case kGetInterface:
+        if (recipient != kRecipientInterface || !configured()) {
+            return false;
+        }
+        control_[0] = alternate_;
+        reply({control_, 1});
+        return true;
+    case kSetInterface:
+        // Every interface has just the one alternate setting.
+        if (recipient != kRecipientInterface || !configured() || setup.value != 0) {
+            return false;
+        }
+        acknowledge();
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool Device::class_request(const SetupPacket& setup) {
+    if (setup.recipient() != kRecipientInterface || setup.index != 0) {
+        return false;
+    }
+    switch (setup.request) {
+    case kSetLineCoding:
+        if (setup.length != 7) {
+            return false;
+        }
+        stage_ = Stage::data_out;
+        return true;
+    case kGetLineCoding: {
+        ByteWriter w({control_, sizeof control_});
+        w.u32(line_coding_.baud);
+        w.u8(line_coding_.stop_bits);
+        w.u8(line_coding_.parity);
+        w.u8(line_coding_.data_bits);
+        reply({control_, w.size()});
+        return true;
+    }
+    case kSetControlLineState:
+        line_state_ = setup.value;
+        acknowledge();
+        return true;
+    case kSendBreak:
+        acknowledge();
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool Device::get_descriptor(std::uint16_t value) {
+    const std::uint8_t type = static_cast<std::uint8_t>(value >> 8);
+    const std::uint8_t index = static_cast<std::uint8_t>(value);
+    switch (type) {
+    case kDescDevice:
+        reply(device_descriptor());
+        return true;
+    case kDescConfig:
+        reply(config_descriptor());
+        return true;
+    case kDescString: {
+        if (index == 0) {
+            const std::uint8_t languages[] = {4, kDescString, 0x09, 0x04};  // en-US
+            std::memcpy(control_, languages, sizeof languages);
+            reply({control_, sizeof languages});
+            return true;
+        }
+        const char* const strings[] = {config_.manufacturer, config_.product, config_.serial};
+        if (index > 3 || strings[index - 1] == nullptr) {
+            return false;
+        }
+        // ASCII to UTF-16LE, cut to what fits in one packet.
+        std::size_t size = 2;
+        for (const char* s = strings[index - 1]; *s != '\0' && size + 2 <= kControlPacket; ++s) {
+            control_[size++] = static_cast<std::uint8_t>(*s);
+            control_[size++] = 0;
+        }
+        control_[0] = static_cast<std::uint8_t>(size);
+        control_[1] = kDescString;
+        reply({control_, size});
+        return true;
+    }
+    default:
+        // Device qualifier and other-speed configuration: a full-speed-only
+        // device stalls them.
+        return false;
+    }
+}
+
+bool Device::set_configuration(std::uint8_t value) {
+    if (value > 1 || address_ == 0) {
+        return false;
+    }
+    in_.detach();
+    out_.detach();
+    in_halted_ = false;
+    out_halted_ = false;
+    configuration_ = value;
+    if (value == 1) {
+        open_data_endpoints();
+        in_.attach(*port_, kDataIn);
+        out_.attach(*port_, kDataOut);
+    }
+    acknowledge();
+    return true;
+}
+
+void Device::open_data_endpoints() {
+    (void)port_->open({kDataOut, EndpointType::bulk, kBulkPacket});
+    (void)port_->open({kDataIn, EndpointType::bulk, kBulkPacket, config_.double_buffered});
+    if (config_.device_class == DeviceClass::cdc_acm) {
+        (void)port_->open({kNotify, EndpointType::interrupt, kNotifyPacket});
+    }
+}
+
+void Device::finish_data_out() {
+    if (setup_.request == kSetLineCoding) {
+        ByteReader r({control_, control_size_});
+        line_coding_.baud = r.u32();
+        line_coding_.stop_bits = r.u8();
+        line_coding_.parity = r.u8();
+        line_coding_.data_bits = r.u8();
+    }
+    acknowledge();
+}
+
+void Device::reply(ConstByteSpan data) {
+    // Never more than the host asked for; a reply that ends on a packet
+    // boundary short of that needs a ZLP to tell the host it is complete.
+    const std::size_t size = data.size() < setup_.length ? data.size() : setup_.length;
+    reply_ = data.first(size);
+    reply_sent_ = 0;
+    reply_zlp_ = size < setup_.length && size % kControlPacket == 0;
+    stage_ = Stage::data_in;
+    send_next_control();
+}
+
+void Device::send_next_control() {
+    const std::size_t left = reply_.size() - reply_sent_;
+    const std::size_t n = left < kControlPacket ? left : kControlPacket;
+    if (n == 0) {
+        reply_zlp_ = false;
+    }
+    (void)port_->write(kEp0In, reply_.subspan(reply_sent_, n));
+    reply_sent_ += n;
+}
+
+void Device::acknowledge() {
+    stage_ = Stage::status_in;
+    (void)port_->write(kEp0In, {});
+}
+
+void Device::stall_control() {
+    ++stats_.stalls;
+    stage_ = Stage::idle;
+    port_->stall(kEp0In, true);
+    port_->stall(kEp0Out, true);
+}
+
+void Device::isr_in(std::uint8_t address) {
+    if (address == kDataIn) {
+        in_.on_sent();
+        return;
+    }
+    if (address != kEp0In) {
+        return;
+    }
+    switch (stage_) {
+    case Stage::data_in:
+        if (reply_sent_ < reply_.size() || reply_zlp_) {
+            send_next_control();
+        } else {
+            stage_ = Stage::status_out;
+        }
+        break;
+    case Stage::status_in:
+        stage_ = Stage::idle;
+        break;
+    default:
+        break;
+    }
+}
+
+void Device::isr_out(std::uint8_t address) {
+    if (address == kDataOut) {
+        out_.on_packet();
+        return;
+    }
+    if (address != kEp0Out) {
+        return;
+    }
+    std::size_t size = 0;
+    if (stage_ != Stage::data_out) {
+        // The status stage of an IN request, or a host giving up early.
+        std::uint8_t scratch[kControlPacket];
+        (void)port_->read(kEp0Out, {scratch, sizeof scratch}, size);
+        if (stage_ == Stage::status_out || stage_ == Stage::data_in) {
+            stage_ = Stage::idle;
+        }
+        return;
+    }
+    if (port_->read(kEp0Out, {control_ + control_size_, kControlPacket - control_size_}, size) != Status::ok) {
+        stall_control();
+        return;
+    }
+    control_size_ += size;
+    if (control_size_ >= setup_.length || size < kControlPacket) {
+        finish_data_out();
+    }
+}
+
+}  // namespace nucleo::usb
@@ -0,0 +1,371 @@
+// USB_DRD_FS in device mode, on the user USB connector (PA11/PA12).
+//
+// The peripheral has no DMA: every packet is copied between the caller's
+// bytes and the 2 KB packet memory (PMA) by the CPU, from the interrupt
+// that reports the previous one. The PMA starts with the buffer descriptor
+// table, one TXBD/RXBD word pair per channel; packet buffers follow it,
+// allocated in open() order and released all at once by a bus reset.
+//
+// CHEPnR mixes three kinds of bits: read/write (address, type, kind),
+// toggle-on-write-1 (STAT and DTOG) and clear-on-write-0 (VTRX/VTTX).
+// Every write goes through set_chep() so that only the intended bits move.
+#include "stm32h5xx.h"
+
+#include <cstring>
+
+#include "nucleo/platform/clock.hpp"
+#include "nucleo/usb/device.hpp"
+#include "nucleo/usb/fs_port.hpp"
+
+namespace nucleo::usb {
+namespace {
+
+constexpr std::uint32_t kAfUsb = 10;
+constexpr std::uint32_t kPinDm = 11;  // PA11
+constexpr std::uint32_t kPinDp = 12;  // PA12
+constexpr std::uint32_t kIrqPriority = 6;
+constexpr std::uint32_t kHsi48TimeoutMs = 10;
+
+// RM0481, USB packet memory.
+constexpr std::uintptr_t kPma = 0x40016400;
+constexpr std::uint32_t kPmaSize = 2048;
+constexpr std::uint32_t kBdtSize = 8 * 8;
+
+// CHEPnR fields.
+constexpr std::uint32_t kEa = 0x000F;
+constexpr std::uint32_t kStatTx = 0x0030;
+constexpr std::uint32_t kDtogTx = 0x0040;
+constexpr std::uint32_t kVtTx = 0x0080;
+constexpr std::uint32_t kKind = 0x0100;  // bulk: double buffered
+constexpr std::uint32_t kUtype = 0x0600;
+constexpr std::uint32_t kSetup = 0x0800;
+constexpr std::uint32_t kStatRx = 0x3000;
+constexpr std::uint32_t kDtogRx = 0x4000;  // SW_BUF of a double-buffered IN endpoint
+constexpr std::uint32_t kVtRx = 0x8000;
+constexpr std::uint32_t kReadWrite = kEa | kKind | kUtype;
+
+constexpr std::uint32_t kStatStall = 1;
+constexpr std::uint32_t kStatNak = 2;
+constexpr std::uint32_t kStatValid = 3;
+
+constexpr std::uint32_t kUtypeBulk = 0;
+constexpr std::uint32_t kUtypeControl = 1;
+constexpr std::uint32_t kUtypeInterrupt = 3;
+
+volatile std::uint32_t& chep(std::size_t n) { return (&USB_DRD_FS->CHEP0R)[n]; }
+volatile std::uint32_t* pma_word(std::uint32_t offset) { return reinterpret_cast<volatile std::uint32_t*>(kPma + offset); }
+volatile std::uint32_t& txbd(std::size_t n) { return *pma_word(static_cast<std::uint32_t>(8 * n)); }
+volatile std::uint32_t& rxbd(std::size_t n) { return *pma_word(static_cast<std::uint32_t>(8 * n + 4)); }
+
+// Sets the toggle fields selected by `mask` to `value` and clears the VT
+// flags in `clear`; everything else is left as it is.
+void set_chep(std::size_t n, std::uint32_t mask, std::uint32_t value, std::uint32_t clear = 0) {
+    const std::uint32_t r = chep(n);
+    chep(n) = (r & kReadWrite) | ((kVtRx | kVtTx) & ~clear) | ((r ^ value) & mask);
+}
+
+void set_stat_tx(std::size_t n, std::uint32_t stat) { set_chep(n, kStatTx, stat << 4); }
+void set_stat_rx(std::size_t n, std::uint32_t stat) { set_chep(n, kStatRx, stat << 12); }
+
+// RXBD size field: 32-byte blocks above 62 bytes.
+std::uint32_t rx_size_field(std::uint32_t bytes) {
+    return bytes > 62 ? (1u << 31) | (((bytes / 32) - 1) << 26) : ((bytes + 1) / 2) << 26;
+}
+
+void pma_write(std::uint32_t offset, ConstByteSpan data) {
+    volatile std::uint32_t* p = pma_word(offset);
+    std::size_t i = 0;
+    for (; i + 4 <= data.size(); i += 4) {
+        std::uint32_t word;
+        std::memcpy(&word, data.data() + i, sizeof word);
+        *p++ = word;
+    }
+    if (i < data.size()) {
+        std::uint32_t word = 0;
+        std::memcpy(&word, data.data() + i, data.size() - i);
+        *p = word;
+    }
+}
+
+void pma_read(std::uint32_t offset, std::uint8_t* out, std::size_t size) {
+    const volatile std::uint32_t* p = pma_word(offset);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const std::uint32_t word = *p++;
+        std::memcpy(out + i, &word, sizeof word);
+    }
+    if (i < size) {
+        const std::uint32_t word = *p;
+        std::memcpy(out + i, &word, size - i);
+    }
+}
+
+class DrdPort final : public UsbPort {
+public:
+    Status start(Device& owner) override;
+    void stop() override;
+    Status open(const EndpointConfig& config) override;
+    void set_address(std::uint8_t address) override;
+    std::size_t write_space(std::uint8_t address) override;
+    Status write(std::uint8_t address, ConstByteSpan packet) override;
+    Status read(std::uint8_t address, ByteSpan out, std::size_t& size) override;
+    void stall(std::uint8_t address, bool stalled) override;
+
+    void on_irq();
+
+private:
+    struct In {
+        std::uint32_t buffer[2];
+        std::uint8_t buffers;
+        std::uint8_t queued;  // buffers handed to the hardware
+        std::uint8_t next;    // buffer the CPU fills next
+    };
+    struct Out {
+        std::uint32_t buffer;
+        bool ready;  // a packet is waiting in `buffer`
+    };
+
+    std::uint32_t allocate(std::uint32_t bytes);
+    void on_reset();
+    void on_setup();
+
+    Device* owner_ = nullptr;
+    std::uint32_t pma_next_ = kBdtSize;
+    std::uint8_t pending_address_ = 0;
+    bool address_pending_ = false;
+    In in_[8] = {};
+    Out out_[8] = {};
+};
+
+DrdPort g_port;
+
+void configure_clock() {
+    // HSI48, trimmed against the host's SOF by the CRS: crystal-less USB.
+    RCC->CR |= RCC_CR_HSI48ON;
+    const std::uint32_t start = platform::millis();
+    while ((RCC->CR & RCC_CR_HSI48RDY) == 0 && platform::millis() - start < kHsi48TimeoutMs) {
+    }
+    RCC->CCIPR4 = (RCC->CCIPR4 & ~RCC_CCIPR4_USBSEL) | (3u << RCC_CCIPR4_USBSEL_Pos);
+    RCC->APB1LENR |= RCC_APB1LENR_CRSEN;
+    RCC->APB2ENR |= RCC_APB2ENR_USBEN;
+    RCC->AHB2ENR |= RCC_AHB2ENR_GPIOAEN;
+    (void)RCC->APB2ENR;
+    CRS->CFGR = (CRS->CFGR & ~CRS_CFGR_SYNCSRC) | (2u << CRS_CFGR_SYNCSRC_Pos);  // USB SOF
+    CRS->CR |= CRS_CR_AUTOTRIMEN | CRS_CR_CEN;
+    // The transceiver's 3.3 V supply is monitored separately.
+    PWR->USBSCR |= PWR_USBSCR_USB33DEN | PWR_USBSCR_USB33SV;
+}
+
+void configure_pins() {
+    for (const std::uint32_t pin : {kPinDm, kPinDp}) {
+        GPIOA->MODER = (GPIOA->MODER & ~(3u << (pin * 2))) | (2u << (pin * 2));
+        GPIOA->OSPEEDR |= 3u << (pin * 2);
+        GPIOA->AFR[1] = (GPIOA->AFR[1] & ~(0xFu << ((pin - 8) * 4))) | (kAfUsb << ((pin - 8) * 4));
+    }
+}
+
+Status DrdPort::start(Device& owner) {
+    owner_ = &owner;
+    configure_clock();
+    if ((RCC->CR & RCC_CR_HSI48RDY) == 0) {
+        return Status::hardware_error;
+    }
+    configure_pins();
+    // Out of power-down, then out of reset once the transceiver is up
+    // (tSTARTUP is 1 us; a millisecond is the finest wait available).
+    USB_DRD_FS->CNTR = USB_CNTR_USBRST;
+    platform::delay_ms(1);
+    USB_DRD_FS->CNTR = 0;
+    USB_DRD_FS->ISTR = 0;
+    USB_DRD_FS->CNTR = USB_CNTR_CTRM | USB_CNTR_RESETM;
+    NVIC_SetPriority(USB_DRD_FS_IRQn, kIrqPriority);
+    NVIC_EnableIRQ(USB_DRD_FS_IRQn);
+    // The pull-up on D+ announces a full-speed device; the host resets it.
+    USB_DRD_FS->BCDR |= USB_BCDR_DPPU;
+    return Status::ok;
+}
+
+void DrdPort::stop() {
+    USB_DRD_FS->BCDR &= ~USB_BCDR_DPPU;
+    NVIC_DisableIRQ(USB_DRD_FS_IRQn);
+    USB_DRD_FS->CNTR = USB_CNTR_USBRST | USB_CNTR_PDWN;
+    owner_ = nullptr;
+}
+
+std::uint32_t DrdPort::allocate(std::uint32_t bytes) {
+    const std::uint32_t at = pma_next_;
+    pma_next_ += (bytes + 3) & ~3u;
+    return pma_next_ <= kPmaSize ? at : 0;
+}
+
+Status DrdPort::open(const EndpointConfig& config) {
+    const std::size_t n = config.address & 0x0F;
+    const bool in = (config.address & kIn) != 0;
+    if (n >= 8 || config.max_packet > 64) {
+        return Status::invalid_argument;
+    }
+    const std::uint32_t utype = config.type == EndpointType::control     ? kUtypeControl
+                                : config.type == EndpointType::interrupt ? kUtypeInterrupt
+                                                                         : kUtypeBulk;
+    const bool dbl = config.double_buffered && config.type == EndpointType::bulk && in;
+    // Address, type and kind; the data toggles restart at DATA0.
+    const std::uint32_t r = chep(n);
+    chep(n) = (n & kEa) | (utype << 9) | (dbl ? kKind : 0) | kVtRx | kVtTx | (r & (in ? kDtogTx : kDtogRx)) |
+              (dbl ? (r & kDtogRx) : 0);
+    if (in) {
+        In& ep = in_[n];
+        ep.buffers = dbl ? 2 : 1;
+        ep.queued = 0;
+        ep.next = 0;
+        for (std::size_t b = 0; b < ep.buffers; ++b) {
+            ep.buffer[b] = allocate(config.max_packet);
+            if (ep.buffer[b] == 0) {
+                return Status::no_memory;
+            }
+        }
+        txbd(n) = ep.buffer[0];
+        if (dbl) {
+            rxbd(n) = ep.buffer[1];  // the second TX buffer uses the RX descriptor
+            set_stat_tx(n, kStatValid);  // the hardware waits on SW_BUF instead
+        } else {
+            set_stat_tx(n, kStatNak);
+        }
+    } else {
+        Out& ep = out_[n];
+        ep.buffer = allocate(config.max_packet);
+        if (ep.buffer == 0) {
+            return Status::no_memory;
+        }
+        ep.ready = false;
+        rxbd(n) = ep.buffer | rx_size_field(config.max_packet);
+        set_stat_rx(n, kStatValid);
+    }
+    return Status::ok;
+}
+
+void DrdPort::set_address(std::uint8_t address) {
+    pending_address_ = address;
+    address_pending_ = true;
+}
+
+std::size_t DrdPort::write_space(std::uint8_t address) {
+    const In& ep = in_[address & 7];
+    return ep.buffers - ep.queued;
+}
+
+Status DrdPort::write(std::uint8_t address, ConstByteSpan packet) {
+    const std::size_t n = address & 7;
+    In& ep = in_[n];
+    if (ep.queued == ep.buffers) {
+        return Status::busy;
+    }
+    pma_write(ep.buffer[ep.next], packet);
+    const std::uint32_t count = static_cast<std::uint32_t>(packet.size()) << 16;
+    if (ep.buffers == 2) {
+        volatile std::uint32_t& bd = ep.next == 0 ? txbd(n) : rxbd(n);
+        bd = ep.buffer[ep.next] | count;
+        // Toggling SW_BUF hands the buffer over.
+        chep(n) = (chep(n) & kReadWrite) | kVtRx | kVtTx | kDtogRx;
+    } else {
+        txbd(n) = ep.buffer[0] | count;
+        set_stat_tx(n, kStatValid);
+    }
+    ep.next = static_cast<std::uint8_t>((ep.next + 1) % ep.buffers);
+    ++ep.queued;
+    return Status::ok;
+}
+
+Status DrdPort::read(std::uint8_t address, ByteSpan out, std::size_t& size) {
+    const std::size_t n = address & 7;
+    Out& ep = out_[n];
+    if (!ep.ready) {
+        return Status::underflow;
+    }
+    const std::size_t count = (rxbd(n) >> 16) & 0x3FF;
+    if (count > out.size()) {
+        return Status::overflow;
+    }
+    pma_read(ep.buffer, out.data(), count);
+    size = count;
+    ep.ready = false;
+    set_stat_rx(n, kStatValid);
+    return Status::ok;
+}
+
+void DrdPort::stall(std::uint8_t address, bool stalled) {
+    const std::size_t n = address & 7;
+    const bool in = (address & kIn) != 0;
+    if (stalled) {
+        in ? set_stat_tx(n, kStatStall) : set_stat_rx(n, kStatStall);
+        return;
+    }
+    // Clearing a halt restarts the data toggle at DATA0.
+    if (in) {
+        set_chep(n, kStatTx | kDtogTx, (in_[n].buffers == 2 || in_[n].queued != 0 ? kStatValid : kStatNak) << 4);
+    } else {
+        set_chep(n, kStatRx | kDtogRx, (out_[n].ready ? kStatNak : kStatValid) << 12);
+    }
+}
+
+void DrdPort::on_reset() {
+    pma_next_ = kBdtSize;
+    address_pending_ = false;
+    for (std::size_t n = 0; n < 8; ++n) {
+        in_[n] = {};
+        out_[n] = {};
+        chep(n) = 0;
+    }
+    USB_DRD_FS->DADDR = USB_DADDR_EF;
+    owner_->isr_reset();
+}
+
+void DrdPort::on_setup() {
+    std::uint8_t raw[8];
+    pma_read(out_[0].buffer, raw, sizeof raw);
+    // A SETUP ends whatever control transfer was in progress.
+    in_[0].queued = 0;
+    set_chep(0, kStatTx | kStatRx, (kStatNak << 4) | (kStatValid << 12), kVtRx);
+    owner_->isr_setup(SetupPacket::parse(raw));
+}
+
+void DrdPort::on_irq() {
+    std::uint32_t istr = USB_DRD_FS->ISTR;
+    if ((istr & USB_ISTR_RESET) != 0) {
+        USB_DRD_FS->ISTR = ~USB_ISTR_RESET;
+        on_reset();
+        return;
+    }
+    while (((istr = USB_DRD_FS->ISTR) & USB_ISTR_CTR) != 0) {
+        const std::size_t n = istr & USB_ISTR_IDN;
+        const std::uint32_t r = chep(n);
+        if ((r & kVtRx) != 0) {
+            if ((r & kSetup) != 0) {
+                on_setup();
+                continue;
+            }
+            set_chep(n, 0, 0, kVtRx);
+            out_[n].ready = true;
+            owner_->isr_out(static_cast<std::uint8_t>(n));
+        }
+        if ((r & kVtTx) != 0) {
+            set_chep(n, 0, 0, kVtTx);
+            if (in_[n].queued != 0) {
+                --in_[n].queued;
+            }
+            if (n == 0 && address_pending_) {
+                // The status stage of SET_ADDRESS has gone out.
+                USB_DRD_FS->DADDR = USB_DADDR_EF | pending_address_;
+                address_pending_ = false;
+            }
+            owner_->isr_in(static_cast<std::uint8_t>(n | kIn));
+        }
+    }
+}
+
+}  // namespace
+
+UsbPort& fs_port() { return g_port; }
+
+}  // namespace nucleo::usb
+
+extern "C" void USB_DRD_FS_IRQHandler() { nucleo::usb::g_port.on_irq(); }
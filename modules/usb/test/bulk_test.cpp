@@ -0,0 +1,275 @@
+#include <string>
+#include <vector>
+
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/usb/device.hpp"
+#include "nucleo/usb/host/sim_usb.hpp"
+
+using namespace nucleo;
+using namespace nucleo::usb;
+
+namespace {
+
+constexpr std::uint8_t kBulkIn = Device::kDataIn;
+constexpr std::uint8_t kBulkOut = Device::kDataOut;
+
+ConstByteSpan bytes(const std::vector<std::uint8_t>& v) { return {v.data(), v.size()}; }
+ConstByteSpan text(const std::string& s) { return {reinterpret_cast<const std::uint8_t*>(s.data()), s.size()}; }
+
+std::vector<std::uint8_t> pattern(std::size_t n, std::uint8_t seed = 1) {
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<std::uint8_t>(i * 7 + seed);
+    }
+    return v;
+}
+
+DeviceConfig with_in(Framing framing, bool coalesce, bool double_buffered = true) {
+    DeviceConfig config;
+    config.in.framing = framing;
+    config.in.coalesce = coalesce;
+    config.double_buffered = double_buffered;
+    return config;
+}
+
+struct Fixture {
+    explicit Fixture(const DeviceConfig& config = {}) : device(config) {
+        device.start(sim);
+        enumerated = sim.enumerate() == Status::ok;
+    }
+    bool run_until_idle() {
+        return sim.run_until([this] { return device.in().idle(); }, 100000);
+    }
+    host::SimUsb sim;
+    Device device;
+    bool enumerated = false;
+};
+
+}  // namespace
+
+TEST(multi_packet_transfer_goes_out_of_the_callers_buffer) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> data = pattern(1000);
+    BulkIn::Ticket ticket = 0;
+    REQUIRE_EQ(f.device.in().submit(bytes(data), &ticket), Status::ok);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    CHECK(f.device.in().done(ticket));
+    CHECK(f.sim.received(kBulkIn) == data);
+    // 15 full packets and a 40-byte one, which ends the transfer.
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 16u);
+    CHECK_EQ(f.device.in().stats().short_packets, 1u);
+    CHECK_EQ(f.device.in().stats().zlps, 0u);
+}
+
+TEST(ticket_is_done_once_the_last_byte_is_copied) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> data = pattern(200);
+    BulkIn::Ticket ticket = 0;
+    REQUIRE_EQ(f.device.in().submit(bytes(data), &ticket), Status::ok);
+    // Two packets fit the double buffer before the host reads anything.
+    CHECK(!f.device.in().done(ticket));
+    CHECK_EQ(f.device.in().queued(), 1u);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.sim.run_until([&] { return f.device.in().done(ticket); }, 10000));
+    CHECK_EQ(f.device.in().queued(), 0u);
+}
+
+TEST(stream_ends_a_burst_of_whole_packets_with_a_zlp) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    f.sim.listen(kBulkIn);
+    const std::vector<std::uint8_t> data = pattern(128);
+    REQUIRE_EQ(f.device.in().submit(bytes(data)), Status::ok);
+    REQUIRE(f.run_until_idle());
+    CHECK(f.sim.received(kBulkIn) == data);
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 3u);
+    CHECK_EQ(f.sim.stats(kBulkIn).zlps, 1u);
+}
+
+TEST(stream_packs_packets_across_submissions) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> a = pattern(40, 1);
+    const std::vector<std::uint8_t> b = pattern(40, 2);
+    const std::vector<std::uint8_t> c = pattern(40, 3);
+    // The host is not reading yet: the first submission is a short packet
+    // (the endpoint was idle), the rest are held and packed.
+    REQUIRE_EQ(f.device.in().submit(bytes(a)), Status::ok);
+    REQUIRE_EQ(f.device.in().submit(bytes(b)), Status::ok);
+    REQUIRE_EQ(f.device.in().submit(bytes(c)), Status::ok);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    std::vector<std::uint8_t> expected = a;
+    expected.insert(expected.end(), b.begin(), b.end());
+    expected.insert(expected.end(), c.begin(), c.end());
+    CHECK(f.sim.received(kBulkIn) == expected);
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 3u);  // 40, 64, 16
+    CHECK_EQ(f.device.in().stats().transfers, 3u);
+}
+
+TEST(transfer_framing_closes_each_submission) {
+    Fixture f(with_in(Framing::transfer, true));
+    REQUIRE(f.enumerated);
+    f.sim.listen(kBulkIn);
+    const std::vector<std::uint8_t> a = pattern(64, 1);
+    const std::vector<std::uint8_t> b = pattern(10, 2);
+    REQUIRE_EQ(f.device.in().submit(bytes(a)), Status::ok);
+    REQUIRE_EQ(f.device.in().submit(bytes(b)), Status::ok);
+    REQUIRE_EQ(f.device.in().submit({}), Status::ok);
+    REQUIRE(f.run_until_idle());
+    // 64 + ZLP, 10, and a ZLP for the empty submission.
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 4u);
+    CHECK_EQ(f.sim.stats(kBulkIn).zlps, 2u);
+    CHECK_EQ(f.device.in().stats().transfers, 3u);
+    CHECK_EQ(f.sim.received(kBulkIn).size(), 74u);
+}
+
+TEST(small_writes_coalesce_while_the_endpoint_is_busy) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    f.sim.listen(kBulkIn);
+    std::string expected;
+    for (int i = 0; i < 30; ++i) {
+        const std::string line = "t=" + std::to_string(1000 + i) + " adc=1234 state=run\n";
+        REQUIRE_EQ(f.device.in().write(text(line)), Status::ok);
+        expected += line;
+    }
+    REQUIRE(f.run_until_idle());
+    const std::vector<std::uint8_t>& got = f.sim.received(kBulkIn);
+    CHECK(std::string(got.begin(), got.end()) == expected);
+    // Only the first line went out alone.
+    CHECK_EQ(f.device.in().stats().coalesced_writes, 28u);
+    CHECK(f.sim.stats(kBulkIn).packets <= expected.size() / 64 + 3);
+}
+
+TEST(without_coalescing_every_write_is_its_own_transfer) {
+    Fixture f(with_in(Framing::transfer, false));
+    REQUIRE(f.enumerated);
+    f.sim.listen(kBulkIn);
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE_EQ(f.device.in().write(text("line\n")), Status::ok);
+        f.sim.run_us(10);
+    }
+    REQUIRE(f.run_until_idle());
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 6u);
+    CHECK_EQ(f.device.in().stats().coalesced_writes, 0u);
+}
+
+TEST(writes_and_submissions_keep_their_order) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::string middle = "def";
+    REQUIRE_EQ(f.device.in().write(text("abc")), Status::ok);
+    REQUIRE_EQ(f.device.in().write(text("ABC")), Status::ok);
+    REQUIRE_EQ(f.device.in().submit(text(middle)), Status::ok);
+    REQUIRE_EQ(f.device.in().write(text("ghi")), Status::ok);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    const std::vector<std::uint8_t>& got = f.sim.received(kBulkIn);
+    CHECK(std::string(got.begin(), got.end()) == "abcABCdefghi");
+}
+
+TEST(flush_sends_a_held_short_packet) {
+    Fixture f(with_in(Framing::stream, true, false));
+    REQUIRE(f.enumerated);
+    REQUIRE_EQ(f.device.in().write(text("first")), Status::ok);  // goes out: endpoint idle
+    REQUIRE_EQ(f.device.in().write(text("second")), Status::ok);  // held behind it
+    f.device.in().flush();
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    CHECK_EQ(f.sim.stats(kBulkIn).packets, 2u);
+}
+
+TEST(full_staging_ring_pushes_back) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> big(BulkIn::kStageSize + 1, 'x');
+    CHECK_EQ(f.device.in().write(bytes(big)), Status::invalid_argument);
+    // Nobody reading: the two packet buffers fill, then the ring.
+    const std::vector<std::uint8_t> chunk(256, 'y');
+    std::size_t accepted = 0;
+    while (f.device.in().write(bytes(chunk)) == Status::ok) {
+        accepted += chunk.size();
+    }
+    CHECK_EQ(accepted, BulkIn::kStageSize);
+    CHECK_EQ(f.device.in().stats().queue_full, 1u);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    CHECK_EQ(f.sim.received(kBulkIn).size(), accepted);
+    CHECK_EQ(f.device.in().write(bytes(chunk)), Status::ok);
+}
+
+TEST(submission_queue_depth_is_bounded) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> data = pattern(500);
+    std::size_t accepted = 0;
+    while (f.device.in().submit(bytes(data)) == Status::ok) {
+        ++accepted;
+    }
+    CHECK_EQ(accepted, BulkIn::kQueueDepth);
+    f.sim.listen(kBulkIn);
+    REQUIRE(f.run_until_idle());
+    CHECK_EQ(f.sim.received(kBulkIn).size(), accepted * data.size());
+}
+
+TEST(out_fills_buffers_until_a_short_packet) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    std::vector<std::uint8_t> buffer(256);
+    REQUIRE_EQ(f.device.out().submit({buffer.data(), buffer.size()}), Status::ok);
+    const std::vector<std::uint8_t> data = pattern(200);
+    f.sim.send_out(kBulkOut, bytes(data));
+    REQUIRE(f.sim.run_until([&] { return f.device.out().waiting() == 0; }, 10000));
+    std::vector<std::uint8_t> got;
+    CHECK_EQ(f.device.out().receive([&](ConstByteSpan b) { got.assign(b.begin(), b.end()); }), 1u);
+    CHECK(got == data);
+}
+
+TEST(out_without_a_buffer_naks_the_host) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    const std::vector<std::uint8_t> data = pattern(300);
+    f.sim.send_out(kBulkOut, bytes(data));
+    f.sim.run_us(2000);
+    // One packet sits in packet memory; the rest wait at the host.
+    CHECK_EQ(f.sim.out_pending(kBulkOut), 300u - 64u);
+    CHECK(f.sim.stats(kBulkOut).naks > 0);
+    CHECK_EQ(f.device.out().stats().held, 1u);
+
+    std::vector<std::uint8_t> a(128), b(512);
+    REQUIRE_EQ(f.device.out().submit({a.data(), a.size()}), Status::ok);
+    REQUIRE_EQ(f.device.out().submit({b.data(), b.size()}), Status::ok);
+    REQUIRE(f.sim.run_until([&] { return f.device.out().waiting() == 0; }, 10000));
+    std::vector<std::uint8_t> got;
+    std::vector<std::size_t> sizes;
+    f.device.out().receive([&](ConstByteSpan s) {
+        got.insert(got.end(), s.begin(), s.end());
+        sizes.push_back(s.size());
+    });
+    CHECK(got == data);
+    REQUIRE_EQ(sizes.size(), 2u);
+    CHECK_EQ(sizes[0], 128u);
+    CHECK_EQ(sizes[1], 172u);
+}
+
+TEST(out_packet_that_does_not_fit_moves_to_the_next_buffer) {
+    Fixture f;
+    REQUIRE(f.enumerated);
+    std::vector<std::uint8_t> a(100), b(100);
+    REQUIRE_EQ(f.device.out().submit({a.data(), a.size()}), Status::ok);
+    REQUIRE_EQ(f.device.out().submit({b.data(), b.size()}), Status::ok);
+    const std::vector<std::uint8_t> data = pattern(128);
+    f.sim.send_out(kBulkOut, bytes(data));
+    REQUIRE(f.sim.run_until([&] { return f.device.out().waiting() == 0; }, 10000));
+    std::vector<std::size_t> sizes;
+    f.device.out().receive([&](ConstByteSpan s) { sizes.push_back(s.size()); });
+    REQUIRE_EQ(sizes.size(), 2u);
+    CHECK_EQ(sizes[0], 64u);
+    CHECK_EQ(sizes[1], 64u);
+    // b is completed by the ZLP that closes the 128-byte transfer.
+    CHECK_EQ(f.device.out().stats().buffers, 2u);
+}
@@ -0,0 +1,187 @@
+#include <string>
+#include <vector>
+
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/usb/device.hpp"
+#include "nucleo/usb/host/sim_usb.hpp"
+
+using namespace nucleo;
+using namespace nucleo::usb;
+
+namespace {
+
+SetupPacket get_descriptor(std::uint8_t type, std::uint8_t index, std::uint16_t length) {
+    return {0x80, 0x06, static_cast<std::uint16_t>(type << 8 | index), 0, length};
+}
+
+std::string utf16(const std::vector<std::uint8_t>& desc) {
+    std::string s;
+    for (std::size_t i = 2; i + 1 < desc.size(); i += 2) {
+        s += static_cast<char>(desc[i]);
+    }
+    return s;
+}
+
+struct Fixture {
+    explicit Fixture(const DeviceConfig& config = {}) : device(config) { device.start(sim); }
+    host::SimUsb sim;
+    Device device;
+};
+
+}  // namespace
+
+TEST(enumeration_configures_the_device) {
+    Fixture f;
+    CHECK(!f.device.configured());
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    CHECK(f.device.configured());
+    CHECK_EQ(f.device.address(), 5u);
+    CHECK_EQ(f.sim.address(), 5u);
+    CHECK(f.device.in().attached());
+    CHECK_EQ(f.device.stats().resets, 1u);
+    CHECK_EQ(f.device.stats().stalls, 0u);
+}
+
+TEST(cdc_descriptors_bind_the_serial_driver) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(1, 0, 18), d), Status::ok);
+    REQUIRE_EQ(d.size(), 18u);
+    CHECK_EQ(d[4], 0x02);  // CDC
+    CHECK_EQ(d[7], 64u);   // EP0 max packet
+    CHECK_EQ(d[8] | d[9] << 8, 0x0483);
+
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(2, 0, 255), d), Status::ok);
+    REQUIRE_EQ(d.size(), 67u);
+    CHECK_EQ(d[2] | d[3] << 8, 67);
+    CHECK_EQ(d[4], 2u);  // two interfaces
+    // Communication interface (ACM), then the data interface with both
+    // bulk endpoints.
+    CHECK_EQ(d[9 + 5], 0x02);
+    CHECK_EQ(d[9 + 6], 0x02);
+    const std::size_t data_if = 9 + 9 + 5 + 5 + 4 + 5 + 7;
+    CHECK_EQ(d[data_if + 1], 4u);
+    CHECK_EQ(d[data_if + 5], 0x0A);
+    CHECK_EQ(d[data_if + 9 + 2], Device::kDataOut);
+    CHECK_EQ(d[data_if + 16 + 2], Device::kDataIn);
+    CHECK_EQ(d[data_if + 16 + 4], 64u);
+}
+
+TEST(vendor_class_has_one_interface) {
+    DeviceConfig config;
+    config.device_class = DeviceClass::vendor;
+    Fixture f(config);
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(2, 0, 255), d), Status::ok);
+    REQUIRE_EQ(d.size(), 32u);
+    CHECK_EQ(d[4], 1u);
+    CHECK_EQ(d[9 + 5], 0xFF);
+    // No CDC class requests on a vendor device.
+    CHECK_EQ(f.sim.control_out({0x21, 0x22, 1, 0, 0}), Status::hardware_error);
+}
+
+TEST(descriptor_replies_are_cut_to_the_requested_length) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(2, 0, 9), d), Status::ok);
+    CHECK_EQ(d.size(), 9u);
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(2, 0, 66), d), Status::ok);
+    CHECK_EQ(d.size(), 66u);
+}
+
+TEST(strings_are_utf16) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(3, 0, 255), d), Status::ok);
+    REQUIRE_EQ(d.size(), 4u);
+    CHECK_EQ(d[2] | d[3] << 8, 0x0409);
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(3, 2, 255), d), Status::ok);
+    CHECK_EQ(d[0], d.size());
+    CHECK_EQ(utf16(d), std::string("nucleo-h563zi"));
+    CHECK_EQ(f.sim.control_in(get_descriptor(3, 4, 255), d), Status::hardware_error);
+}
+
+TEST(reply_of_whole_packets_ends_with_a_zlp) {
+    // 31 characters make a 64-byte string descriptor: one full packet, so
+    // the host needs a ZLP to know it is complete.
+    DeviceConfig config;
+    config.serial = "0123456789012345678901234567890";
+    Fixture f(config);
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    const std::uint32_t zlps = f.sim.stats(0x80).zlps;
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in(get_descriptor(3, 3, 255), d), Status::ok);
+    CHECK_EQ(d.size(), 64u);
+    CHECK_EQ(utf16(d), std::string(config.serial));
+    // The data-stage ZLP; the status stage of an IN request is the host's.
+    CHECK_EQ(f.sim.stats(0x80).zlps, zlps + 1);
+}
+
+TEST(line_coding_round_trips_and_dtr_is_tracked) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    const std::uint8_t coding[7] = {0x00, 0x10, 0x0E, 0x00, 2, 2, 7};  // 921600 7E2
+    REQUIRE_EQ(f.sim.control_out({0x21, 0x20, 0, 0, 7}, {coding, sizeof coding}), Status::ok);
+    CHECK_EQ(f.device.line_coding().baud, 921600u);
+    CHECK_EQ(f.device.line_coding().parity, 2u);
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in({0xA1, 0x21, 0, 0, 7}, d), Status::ok);
+    CHECK(d == std::vector<std::uint8_t>(coding, coding + 7));
+
+    CHECK(!f.device.dtr());
+    REQUIRE_EQ(f.sim.control_out({0x21, 0x22, 0x0003, 0, 0}), Status::ok);
+    CHECK(f.device.dtr());
+    REQUIRE_EQ(f.sim.control_out({0x21, 0x22, 0x0000, 0, 0}), Status::ok);
+    CHECK(!f.device.dtr());
+}
+
+TEST(unsupported_requests_stall_and_the_next_setup_recovers) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    std::vector<std::uint8_t> d;
+    CHECK_EQ(f.sim.control_in({0xC0, 0x42, 0, 0, 8}, d), Status::hardware_error);  // vendor request
+    CHECK_EQ(f.sim.control_in(get_descriptor(6, 0, 10), d), Status::hardware_error);  // device qualifier
+    CHECK_EQ(f.sim.control_out({0x21, 0x20, 0, 0, 6}, {}), Status::hardware_error);  // bad line coding size
+    CHECK_EQ(f.device.stats().stalls, 3u);
+    REQUIRE_EQ(f.sim.control_in({0x80, 0x00, 0, 0, 2}, d), Status::ok);
+    CHECK_EQ(d.size(), 2u);
+}
+
+TEST(endpoint_halt_is_set_reported_and_cleared) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    REQUIRE_EQ(f.sim.control_out({0x02, 0x03, 0, Device::kDataIn, 0}), Status::ok);
+    CHECK(f.sim.stalled(Device::kDataIn));
+    std::vector<std::uint8_t> d;
+    REQUIRE_EQ(f.sim.control_in({0x82, 0x00, 0, Device::kDataIn, 2}, d), Status::ok);
+    CHECK_EQ(d[0], 1u);
+    REQUIRE_EQ(f.sim.control_out({0x02, 0x01, 0, Device::kDataIn, 0}), Status::ok);
+    CHECK(!f.sim.stalled(Device::kDataIn));
+    REQUIRE_EQ(f.sim.control_in({0x82, 0x00, 0, Device::kDataIn, 2}, d), Status::ok);
+    CHECK_EQ(d[0], 0u);
+}
+
+TEST(deconfiguration_and_bus_reset_detach_the_pipes) {
+    Fixture f;
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    const std::uint8_t data[300] = {};
+    BulkIn::Ticket ticket = 0;
+    REQUIRE_EQ(f.device.in().submit({data, sizeof data}, &ticket), Status::ok);
+    CHECK(!f.device.in().done(ticket));
+
+    f.sim.bus_reset();
+    CHECK(!f.device.configured());
+    CHECK_EQ(f.device.address(), 0u);
+    CHECK(f.device.in().done(ticket));
+    CHECK_EQ(f.device.in().submit({data, sizeof data}), Status::not_found);
+
+    REQUIRE_EQ(f.sim.enumerate(), Status::ok);
+    CHECK_EQ(f.device.in().write({data, 10}), Status::ok);
+    REQUIRE_EQ(f.sim.control_out({0x00, 0x09, 0, 0, 0}), Status::ok);
+    CHECK(!f.device.configured());
+    CHECK_EQ(f.device.in().write({data, 10}), Status::not_found);
+}
@@ -0,0 +1,108 @@
+// nucleo-layout: where a firmware image's sections and symbols landed, and
+// whether that fits the memory budget.
+//
+//   nucleo-layout <map-file> [--symbols <nm-file>] [--budget <file>]
+//                 [--top <n>] [--output <file>]
+//
+// --symbols  `nm -S -C` listing of the ELF, for per-symbol sizes including
+//            local symbols, which the map does not list
+// --budget   budget file (app/stm32h5/layout.budget); violations go to
+//            stderr and the exit status is 1
+// --top      symbols listed per region (default 10)
+// --output   write the report there instead of stdout
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "map_layout.hpp"
+
+namespace {
+
+bool read_file(const char* path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* map_path = nullptr;
+    const char* symbols_path = nullptr;
+    const char* budget_path = nullptr;
+    const char* output_path = nullptr;
+    std::size_t top = 10;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--symbols") == 0 && has_value) {
+            symbols_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--budget") == 0 && has_value) {
+            budget_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && has_value) {
+            output_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--top") == 0 && has_value) {
+            top = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            map_path = argv[i];
+        }
+    }
+    if (map_path == nullptr) {
+        std::fprintf(stderr,
+                     "usage: %s <map-file> [--symbols <nm-file>] [--budget <file>] [--top <n>] [--output <file>]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::string text;
+    std::string error;
+    nucleo::tools::MapLayout layout;
+    if (!read_file(map_path, text)) {
+        return 1;
+    }
+    if (!nucleo::tools::parse_map(text, layout, error)) {
+        std::fprintf(stderr, "%s: %s\n", map_path, error.c_str());
+        return 1;
+    }
+    if (symbols_path != nullptr) {
+        if (!read_file(symbols_path, text)) {
+            return 1;
+        }
+        nucleo::tools::parse_symbols(text, layout);
+    }
+
+    const std::string report = nucleo::tools::format_layout(layout, top);
+    if (output_path != nullptr) {
+        std::ofstream out(output_path);
+        out << report;
+        if (!out) {
+            std::fprintf(stderr, "cannot write %s\n", output_path);
+            return 1;
+        }
+    } else {
+        std::fputs(report.c_str(), stdout);
+    }
+
+    if (budget_path == nullptr) {
+        return 0;
+    }
+    nucleo::tools::Budget budget;
+    if (!read_file(budget_path, text)) {
+        return 1;
+    }
+    if (!nucleo::tools::parse_budget(text, budget, error)) {
+        std::fprintf(stderr, "%s: %s\n", budget_path, error.c_str());
+        return 1;
+    }
+    const auto violations = nucleo::tools::check_budget(layout, budget);
+    for (const std::string& v : violations) {
+        std::fprintf(stderr, "%s: %s\n", budget_path, v.c_str());
+    }
+    return violations.empty() ? 0 : 1;
+}
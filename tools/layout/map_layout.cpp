@@ -0,0 +1,487 @@
+#include "map_layout.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace nucleo::tools {
+namespace {
+
+std::vector<std::string> split_lines(const std::string& text) {
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::vector<std::string> tokens(const std::string& line) {
+    std::vector<std::string> out;
+    std::istringstream in(line);
+    std::string t;
+    while (in >> t) {
+        out.push_back(t);
+    }
+    return out;
+}
+
+// Offset just past the first `n` whitespace-separated tokens of `line`.
+std::size_t skip_tokens(const std::string& line, std::size_t n) {
+    std::size_t at = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        at = line.find_first_not_of(" \t", at);
+        at = line.find_first_of(" \t", at);
+        if (at == std::string::npos) {
+            return line.size();
+        }
+    }
+    return at;
+}
+
+std::string trim(const std::string& s) {
+    const std::size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    return s.substr(begin, s.find_last_not_of(" \t") - begin + 1);
+}
+
+bool parse_hex(const std::string& s, std::uint64_t& value) {
+    if (s.size() < 3 || s[0] != '0' || (s[1] != 'x' && s[1] != 'X')) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtoull(s.c_str() + 2, &end, 16);
+    return *end == '\0';
+}
+
+// Decimal or 0x hex, with an optional K or M suffix.
+bool parse_size(std::string s, std::uint64_t& value) {
+    std::uint64_t scale = 1;
+    if (!s.empty() && (s.back() == 'K' || s.back() == 'k')) {
+        scale = 1024;
+        s.pop_back();
+    } else if (!s.empty() && (s.back() == 'M' || s.back() == 'm')) {
+        scale = 1024 * 1024;
+        s.pop_back();
+    }
+    if (s.empty()) {
+        return false;
+    }
+    if (parse_hex(s, value)) {
+        value *= scale;
+        return true;
+    }
+    char* end = nullptr;
+    value = std::strtoull(s.c_str(), &end, 10) * scale;
+    return *end == '\0';
+}
+
+// Input sections that take no space in the load image.
+bool zero_fill(const InputSection& in) { return in.name.find("bss") != std::string::npos || in.name == "COMMON"; }
+
+bool loaded(const OutputSection& s) {
+    return std::any_of(s.inputs.begin(), s.inputs.end(),
+                       [](const InputSection& in) { return in.size != 0 && !zero_fill(in); });
+}
+
+// "0xADDR 0xSIZE [load address 0xLMA]" after the section name.
+bool parse_output_tail(const std::vector<std::string>& t, std::size_t first, OutputSection& s) {
+    if (t.size() < first + 2 || !parse_hex(t[first], s.address) || !parse_hex(t[first + 1], s.size)) {
+        return false;
+    }
+    s.load_address = s.address;
+    if (t.size() >= first + 5 && t[first + 2] == "load" && t[first + 3] == "address") {
+        parse_hex(t[first + 4], s.load_address);
+    }
+    return true;
+}
+
+// "0xADDR 0xSIZE object" after the input section name.
+bool parse_input_tail(const std::string& line, std::size_t first, InputSection& in) {
+    const std::vector<std::string> t = tokens(line);
+    if (t.size() < first + 2 || !parse_hex(t[first], in.address) || !parse_hex(t[first + 1], in.size)) {
+        return false;
+    }
+    // The object name may contain spaces (paths); take the rest of the line.
+    in.object = trim(line.substr(skip_tokens(line, first + 2)));
+    return true;
+}
+
+const char* region_name(const MapLayout& layout, int region) {
+    return region >= 0 ? layout.regions[static_cast<std::size_t>(region)].name.c_str() : "-";
+}
+
+}  // namespace
+
+int MapLayout::region_at(std::uint64_t address) const {
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        if (regions[i].contains(address)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+const OutputSection* MapLayout::section(const std::string& name) const {
+    for (const OutputSection& s : sections) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+bool parse_map(const std::string& text, MapLayout& out, std::string& error) {
+    out = MapLayout{};
+    const std::vector<std::string> lines = split_lines(text);
+
+    std::size_t i = 0;
+    while (i < lines.size() && lines[i] != "Memory Configuration") {
+        ++i;
+    }
+    while (i < lines.size() && lines[i].compare(0, 4, "Name") != 0) {
+        ++i;
+    }
+    for (++i; i < lines.size() && !trim(lines[i]).empty(); ++i) {
+        const std::vector<std::string> t = tokens(lines[i]);
+        MemoryRegion r;
+        if (t.size() < 3 || !parse_hex(t[1], r.origin) || !parse_hex(t[2], r.length)) {
+            error = "bad memory configuration line: " + lines[i];
+            return false;
+        }
+        if (t[0] != "*default*") {
+            r.name = t[0];
+            out.regions.push_back(r);
+        }
+    }
+    if (out.regions.empty()) {
+        error = "no memory configuration (is this a GNU ld map?)";
+        return false;
+    }
+
+    while (i < lines.size() && lines[i] != "Linker script and memory map") {
+        ++i;
+    }
+    if (i == lines.size()) {
+        error = "no memory map";
+        return false;
+    }
+
+    std::vector<OutputSection> sections;
+    std::string pending_output;  // section name printed on a line of its own
+    std::string pending_input;
+    for (++i; i < lines.size(); ++i) {
+        const std::string& line = lines[i];
+        if (line.empty()) {
+            continue;
+        }
+        if (line.compare(0, 7, "OUTPUT(") == 0) {
+            break;
+        }
+        const std::vector<std::string> t = tokens(line);
+        if (line[0] != ' ') {
+            // Output section: name, then address and size on this line or the next.
+            pending_output.clear();
+            pending_input.clear();
+            if (line.compare(0, 5, "LOAD ") == 0 || t[0][0] != '.') {
+                continue;
+            }
+            OutputSection s;
+            s.name = t[0];
+            if (parse_output_tail(t, 1, s)) {
+                sections.push_back(s);
+            } else if (t.size() == 1) {
+                pending_output = t[0];
+            }
+            continue;
+        }
+        if (!pending_output.empty()) {
+            OutputSection s;
+            s.name = pending_output;
+            pending_output.clear();
+            if (parse_output_tail(t, 0, s)) {
+                sections.push_back(s);
+            }
+            continue;
+        }
+        if (sections.empty()) {
+            continue;
+        }
+        std::vector<InputSection>& inputs = sections.back().inputs;
+        if (line.size() > 1 && line[1] != ' ') {
+            // Input section, unless it is a fill or an input section spec.
+            pending_input.clear();
+            if (t[0][0] != '.' && t[0] != "COMMON") {
+                continue;
+            }
+            InputSection in;
+            in.name = t[0];
+            if (parse_input_tail(line, 1, in)) {
+                inputs.push_back(in);
+            } else if (t.size() == 1) {
+                pending_input = t[0];
+            }
+            continue;
+        }
+        if (!pending_input.empty()) {
+            InputSection in;
+            in.name = pending_input;
+            pending_input.clear();
+            if (parse_input_tail(line, 0, in)) {
+                inputs.push_back(in);
+            }
+            continue;
+        }
+        // "0xADDR name" lists a global symbol; assignments have " = ".
+        std::uint64_t address = 0;
+        if (!inputs.empty() && t.size() >= 2 && parse_hex(t[0], address) && line.find(" = ") == std::string::npos &&
+            t[1].compare(0, 7, "PROVIDE") != 0) {
+            InputSection& in = inputs.back();
+            if (address >= in.address && address < in.address + std::max<std::uint64_t>(in.size, 1)) {
+                in.symbols.push_back(trim(line.substr(skip_tokens(line, 1))));
+            }
+        }
+    }
+
+    // Keep what occupies target memory; debug and attribute sections sit at 0.
+    for (OutputSection& s : sections) {
+        s.region = out.region_at(s.address);
+        if (s.region < 0) {
+            continue;
+        }
+        s.load_region = s.load_address == s.address ? s.region : out.region_at(s.load_address);
+        out.regions[static_cast<std::size_t>(s.region)].used += s.size;
+        if (s.load_region >= 0 && s.load_region != s.region && loaded(s)) {
+            out.regions[static_cast<std::size_t>(s.load_region)].used += s.size;
+        } else if (s.load_region != s.region) {
+            s.load_region = s.region;
+            s.load_address = s.address;
+        }
+        out.sections.push_back(std::move(s));
+    }
+    return true;
+}
+
+void parse_symbols(const std::string& text, MapLayout& out) {
+    for (const std::string& line : split_lines(text)) {
+        // "ADDRESS SIZE TYPE NAME"; symbols without a size are labels.
+        const std::vector<std::string> t = tokens(line);
+        if (t.size() < 4 || t[2].size() != 1) {
+            continue;
+        }
+        Symbol s;
+        s.type = t[2][0];
+        if (std::string("tTdDbBrRwWvV").find(s.type) == std::string::npos) {
+            continue;
+        }
+        char* end = nullptr;
+        s.address = std::strtoull(t[0].c_str(), &end, 16);
+        if (*end != '\0') {
+            continue;
+        }
+        s.size = std::strtoull(t[1].c_str(), &end, 16);
+        if (*end != '\0' || s.size == 0) {
+            continue;
+        }
+        // Thumb function addresses carry the mode in bit 0.
+        if (s.type == 't' || s.type == 'T' || s.type == 'w' || s.type == 'W') {
+            s.address &= ~std::uint64_t{1};
+        }
+        s.name = trim(line.substr(skip_tokens(line, 3)));
+        s.region = out.region_at(s.address);
+        out.symbols.push_back(s);
+    }
+    std::stable_sort(out.symbols.begin(), out.symbols.end(),
+                     [](const Symbol& a, const Symbol& b) { return a.size > b.size; });
+}
+
+std::string format_layout(const MapLayout& layout, std::size_t top) {
+    std::string out;
+    char line[512];
+    std::snprintf(line, sizeof line, "%-10s %10s %10s %10s %10s %6s\n", "region", "origin", "length", "used", "free",
+                  "use");
+    out += line;
+    for (const MemoryRegion& r : layout.regions) {
+        const double pct = r.length != 0 ? 100.0 * static_cast<double>(r.used) / static_cast<double>(r.length) : 0.0;
+        std::snprintf(line, sizeof line, "%-10s 0x%08" PRIx64 " %10" PRIu64 " %10" PRIu64 " %10" PRId64 " %5.1f%%\n",
+                      r.name.c_str(), r.origin, r.length, r.used,
+                      static_cast<std::int64_t>(r.length) - static_cast<std::int64_t>(r.used), pct);
+        out += line;
+    }
+
+    std::snprintf(line, sizeof line, "\n%-16s %10s %10s  %-8s %s\n", "section", "address", "size", "region", "load");
+    out += line;
+    for (const OutputSection& s : layout.sections) {
+        if (s.load_region != s.region) {
+            std::snprintf(line, sizeof line, "%-16s 0x%08" PRIx64 " %10" PRIu64 "  %-8s %s 0x%08" PRIx64 "\n",
+                          s.name.c_str(), s.address, s.size, region_name(layout, s.region),
+                          region_name(layout, s.load_region), s.load_address);
+        } else {
+            std::snprintf(line, sizeof line, "%-16s 0x%08" PRIx64 " %10" PRIu64 "  %s\n", s.name.c_str(), s.address,
+                          s.size, region_name(layout, s.region));
+        }
+        out += line;
+    }
+
+    struct Entry {
+        const std::string* name;
+        std::uint64_t address;
+        std::uint64_t size;
+        int region;
+    };
+    std::vector<Entry> entries;
+    if (!layout.symbols.empty()) {
+        for (const Symbol& s : layout.symbols) {
+            entries.push_back({&s.name, s.address, s.size, s.region});
+        }
+    } else {
+        for (const OutputSection& s : layout.sections) {
+            for (const InputSection& in : s.inputs) {
+                entries.push_back({in.symbols.empty() ? &in.name : &in.symbols.front(), in.address, in.size,
+                                   layout.region_at(in.address)});
+            }
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.size > b.size; });
+    }
+    for (std::size_t r = 0; r < layout.regions.size(); ++r) {
+        std::size_t shown = 0;
+        for (const Entry& e : entries) {
+            if (shown == top) {
+                break;
+            }
+            if (e.region != static_cast<int>(r) || e.size == 0) {
+                continue;
+            }
+            if (shown++ == 0) {
+                std::snprintf(line, sizeof line, "\nlargest in %s\n", layout.regions[r].name.c_str());
+                out += line;
+            }
+            std::snprintf(line, sizeof line, "%10" PRIu64 "  0x%08" PRIx64 "  %s\n", e.size, e.address,
+                          e.name->c_str());
+            out += line;
+        }
+    }
+    return out;
+}
+
+bool parse_budget(const std::string& text, Budget& out, std::string& error) {
+    out = Budget{};
+    std::size_t number = 0;
+    for (std::string line : split_lines(text)) {
+        ++number;
+        line = line.substr(0, line.find('#'));
+        const std::vector<std::string> t = tokens(line);
+        if (t.empty()) {
+            continue;
+        }
+        bool ok = false;
+        if (t[0] == "region" && t.size() == 3) {
+            Budget::RegionLimit r{t[1], 0};
+            ok = parse_size(t[2], r.max);
+            out.regions.push_back(r);
+        } else if (t[0] == "section" && (t.size() == 3 || t.size() == 4)) {
+            Budget::SectionRule s{t[1], t[2], 0};
+            ok = t.size() == 3 || parse_size(t[3], s.max);
+            out.sections.push_back(s);
+        } else if (t[0] == "symbol" && t.size() == 3) {
+            out.symbols.push_back({t[1], t[2]});
+            ok = true;
+        }
+        if (!ok) {
+            error = "line " + std::to_string(number) + ": " + trim(line);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> check_budget(const MapLayout& layout, const Budget& budget) {
+    std::vector<std::string> violations;
+    char line[512];
+    const auto find_region = [&](const std::string& name) {
+        for (std::size_t i = 0; i < layout.regions.size(); ++i) {
+            if (layout.regions[i].name == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    };
+
+    for (const Budget::RegionLimit& limit : budget.regions) {
+        const int r = find_region(limit.region);
+        if (r < 0) {
+            violations.push_back("region " + limit.region + ": not in the map");
+        } else if (layout.regions[static_cast<std::size_t>(r)].used > limit.max) {
+            std::snprintf(line, sizeof line, "region %s: %" PRIu64 " bytes used, budget %" PRIu64,
+                          limit.region.c_str(), layout.regions[static_cast<std::size_t>(r)].used, limit.max);
+            violations.push_back(line);
+        }
+    }
+
+    for (const Budget::SectionRule& rule : budget.sections) {
+        const OutputSection* s = layout.section(rule.section);
+        if (s == nullptr) {
+            violations.push_back("section " + rule.section + ": not in the map");
+            continue;
+        }
+        if (s->region != find_region(rule.region)) {
+            std::snprintf(line, sizeof line, "section %s: in %s, budget says %s", rule.section.c_str(),
+                          region_name(layout, s->region), rule.region.c_str());
+            violations.push_back(line);
+        }
+        if (rule.max != 0 && s->size > rule.max) {
+            std::snprintf(line, sizeof line, "section %s: %" PRIu64 " bytes, budget %" PRIu64, rule.section.c_str(),
+                          s->size, rule.max);
+            violations.push_back(line);
+        }
+    }
+
+    for (const Budget::SymbolRule& rule : budget.symbols) {
+        const int want = find_region(rule.region);
+        bool found = false;
+        const auto check = [&](const std::string& name, int region) {
+            if (name.find(rule.text) == std::string::npos) {
+                return;
+            }
+            found = true;
+            if (region != want) {
+                std::snprintf(line, sizeof line, "symbol %s: %s in %s, budget says %s", rule.text.c_str(),
+                              name.c_str(), region_name(layout, region), rule.region.c_str());
+                violations.push_back(line);
+            }
+        };
+        for (const Symbol& s : layout.symbols) {
+            check(s.name, s.region);
+        }
+        // Without an nm listing, fall back to what the map shows. Input
+        // sections keep their own names under -ffunction-sections and
+        // -fdata-sections, except those placed with NUCLEO_SECTION.
+        if (layout.symbols.empty()) {
+            for (const OutputSection& s : layout.sections) {
+                for (const InputSection& in : s.inputs) {
+                    const std::string* name = &in.name;
+                    for (const std::string& symbol : in.symbols) {
+                        if (symbol.find(rule.text) != std::string::npos) {
+                            name = &symbol;
+                        }
+                    }
+                    check(*name, layout.region_at(in.address));
+                }
+            }
+        }
+        if (!found) {
+            violations.push_back("symbol " + rule.text + ": not in the image");
+        }
+    }
+    return violations;
+}
+
+}  // namespace nucleo::tools
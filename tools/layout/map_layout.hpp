@@ -0,0 +1,102 @@
+// Memory layout of a firmware image, read from the GNU ld map file and,
+// optionally, an `nm -S -C` symbol listing, and checked against budgets.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nucleo::tools {
+
+struct MemoryRegion {
+    std::string name;
+    std::uint64_t origin = 0;
+    std::uint64_t length = 0;
+    /// Bytes taken by output sections linked here plus the load images of
+    /// sections that run elsewhere (.data, .ramfunc).
+    std::uint64_t used = 0;
+
+    bool contains(std::uint64_t address) const { return address >= origin && address - origin < length; }
+};
+
+struct InputSection {
+    std::string name;    // e.g. .text._ZN6nucleo3app11Application4stepEv
+    std::string object;  // object file or archive(member)
+    std::uint64_t address = 0;
+    std::uint64_t size = 0;
+    std::vector<std::string> symbols;  // global symbols the map lists in it
+};
+
+struct OutputSection {
+    std::string name;
+    std::uint64_t address = 0;
+    std::uint64_t size = 0;
+    std::uint64_t load_address = 0;  // == address unless linked AT> another region
+    int region = -1;                 // index into MapLayout::regions, -1 if none
+    int load_region = -1;            // region holding the load image, -1 if none
+    std::vector<InputSection> inputs;
+};
+
+struct Symbol {
+    std::string name;
+    std::uint64_t address = 0;
+    std::uint64_t size = 0;
+    char type = '?';  // nm type letter
+    int region = -1;
+};
+
+struct MapLayout {
+    std::vector<MemoryRegion> regions;
+    std::vector<OutputSection> sections;  // allocated sections only, in address order of the map
+    std::vector<Symbol> symbols;          // from the nm listing, largest first
+
+    int region_at(std::uint64_t address) const;
+    const OutputSection* section(const std::string& name) const;
+};
+
+/// Reads the "Memory Configuration" table and the allocated output sections
+/// of a GNU ld map. Returns false with `error` set if either is missing.
+bool parse_map(const std::string& text, MapLayout& out, std::string& error);
+
+/// Adds the sized symbols of an `nm -S -C` listing, each assigned to the
+/// region holding its address. parse_map() must have run first.
+void parse_symbols(const std::string& text, MapLayout& out);
+
+/// Region use, section placement and the `top` largest symbols per region.
+/// Falls back to input sections for the symbol list without an nm listing.
+std::string format_layout(const MapLayout& layout, std::size_t top);
+
+/// Limits from a budget file. One rule per line, `#` starts a comment,
+/// sizes take a K or M suffix:
+///
+///   region  NAME MAX            region use (see MemoryRegion::used)
+///   section NAME REGION [MAX]   output section placement and size
+///   symbol  TEXT REGION         every symbol or input section whose name
+///                               contains TEXT lies in REGION; at least one must
+struct Budget {
+    struct RegionLimit {
+        std::string region;
+        std::uint64_t max = 0;
+    };
+    struct SectionRule {
+        std::string section;
+        std::string region;
+        std::uint64_t max = 0;  // 0: placement only
+    };
+    struct SymbolRule {
+        std::string text;
+        std::string region;
+    };
+    std::vector<RegionLimit> regions;
+    std::vector<SectionRule> sections;
+    std::vector<SymbolRule> symbols;
+};
+
+/// Returns false with `error` naming the first bad line.
+bool parse_budget(const std::string& text, Budget& out, std::string& error);
+
+/// One line per violated rule; empty if the layout is within budget.
+std::vector<std::string> check_budget(const MapLayout& layout, const Budget& budget);
+
+}  // namespace nucleo::tools
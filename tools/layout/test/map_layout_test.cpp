@@ -0,0 +1,193 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "map_layout.hpp"
+#include "nucleo/testkit/unit.hpp"
+
+using namespace nucleo::tools;
+
+namespace {
+
+// A trimmed map and `nm -S -C` listing of the firmware image: every output
+// section, a subset of the input sections at sizes a -Os link produces,
+// consistent addresses throughout, and the budget the firmware is held to.
+std::string read(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+MapLayout fixture(bool with_symbols) {
+    MapLayout layout;
+    std::string error;
+    parse_map(read(NUCLEO_LAYOUT_FIXTURE_DIR "/nucleo_h563zi.map"), layout, error);
+    if (with_symbols) {
+        parse_symbols(read(NUCLEO_LAYOUT_FIXTURE_DIR "/nucleo_h563zi.sym"), layout);
+    }
+    return layout;
+}
+
+Budget budget_from(const std::string& text) {
+    Budget budget;
+    std::string error;
+    parse_budget(text, budget, error);
+    return budget;
+}
+
+const MemoryRegion& region(const MapLayout& layout, const char* name) {
+    for (const MemoryRegion& r : layout.regions) {
+        if (r.name == name) {
+            return r;
+        }
+    }
+    return layout.regions.front();
+}
+
+}  // namespace
+
+TEST(parses_regions_and_allocated_sections) {
+    MapLayout layout;
+    std::string error;
+    REQUIRE(parse_map(read(NUCLEO_LAYOUT_FIXTURE_DIR "/nucleo_h563zi.map"), layout, error));
+    REQUIRE_EQ(layout.regions.size(), std::size_t{5});
+    CHECK_EQ(layout.regions[0].name, std::string("FLASH"));
+    CHECK_EQ(layout.regions[0].length, std::uint64_t{1024 * 1024});
+    CHECK_EQ(layout.regions[1].name, std::string("STORAGE"));
+    CHECK_EQ(layout.regions[4].origin, std::uint64_t{0x20050000});
+
+    // Debug and attribute sections are dropped; /DISCARD/ never appears.
+    CHECK(layout.section(".ARM.attributes") == nullptr);
+    CHECK(layout.section(".comment") == nullptr);
+    CHECK(layout.section(".debug_info") == nullptr);
+
+    const OutputSection* text = layout.section(".text");
+    REQUIRE(text != nullptr);
+    CHECK_EQ(text->address, std::uint64_t{0x0800024c});
+    CHECK_EQ(text->size, std::uint64_t{0xe20});
+    CHECK_EQ(text->region, 0);
+    REQUIRE_EQ(text->inputs.size(), std::size_t{13});
+    CHECK_EQ(text->inputs[1].name, std::string(".text._ZN6nucleo3app11ApplicationC2ERKNS0_6ConfigE"));
+    CHECK_EQ(text->inputs[1].object, std::string("app/libnucleo_app.a(application.cpp.obj)"));
+    CHECK_EQ(text->inputs[1].size, std::uint64_t{0x4c});
+    REQUIRE_EQ(text->inputs[9].symbols.size(), std::size_t{2});
+    CHECK_EQ(text->inputs[9].symbols[0], std::string("TIM6_IRQHandler"));
+
+    const OutputSection* ramfunc = layout.section(".ramfunc");
+    REQUIRE(ramfunc != nullptr);
+    CHECK_EQ(layout.regions[static_cast<std::size_t>(ramfunc->region)].name, std::string("SRAM2"));
+    CHECK_EQ(ramfunc->load_address, std::uint64_t{0x08001140});
+    CHECK_EQ(layout.regions[static_cast<std::size_t>(ramfunc->load_region)].name, std::string("FLASH"));
+    REQUIRE_EQ(ramfunc->inputs.size(), std::size_t{3});
+    CHECK_EQ(ramfunc->inputs[0].object, std::string("modules/uart/libnucleo_uart.a(uart.cpp.obj)"));
+    CHECK_EQ(ramfunc->inputs[1].symbols.size(), std::size_t{3});
+    CHECK_EQ(ramfunc->inputs[2].symbols[0], std::string("ETH_IRQHandler"));
+}
+
+TEST(region_use_counts_load_images_but_not_bss) {
+    const MapLayout layout = fixture(false);
+    // Flash holds its own sections plus the .data and .ramfunc images; the
+    // load address ld prints for .bss takes no space.
+    CHECK_EQ(region(layout, "FLASH").used, std::uint64_t{0x10dc + 0x64 + 0x3b4});
+    CHECK_EQ(region(layout, "SRAM1").used, std::uint64_t{0x64 + 0x904 + 0x2000});
+    CHECK_EQ(region(layout, "SRAM2").used, std::uint64_t{0x3b4});
+    CHECK_EQ(region(layout, "SRAM3").used, std::uint64_t{0x1d580});
+    CHECK_EQ(region(layout, "STORAGE").used, std::uint64_t{0});  // the log store's, nothing linked
+    const OutputSection* bss = layout.section(".bss");
+    REQUIRE(bss != nullptr);
+    CHECK_EQ(bss->load_region, bss->region);
+}
+
+TEST(symbols_are_sized_and_placed) {
+    const MapLayout layout = fixture(true);
+    REQUIRE_EQ(layout.symbols.size(), std::size_t{46});
+    CHECK_EQ(layout.symbols.front().name, std::string("(anonymous namespace)::g_hil_storage"));
+    for (std::size_t i = 1; i < layout.symbols.size(); ++i) {
+        CHECK(layout.symbols[i - 1].size >= layout.symbols[i].size);
+    }
+    for (const Symbol& s : layout.symbols) {
+        if (s.name == "(anonymous namespace)::g_packet_storage") {
+            CHECK_EQ(s.size, std::uint64_t{0xc400});
+            CHECK_EQ(s.type, 'b');
+            CHECK_EQ(layout.regions[static_cast<std::size_t>(s.region)].name, std::string("SRAM3"));
+        }
+        if (s.name == "ETH_IRQHandler") {
+            CHECK_EQ(s.address, std::uint64_t{0x200403a0});  // Thumb bit dropped
+        }
+    }
+}
+
+TEST(report_lists_regions_sections_and_largest_symbols) {
+    const std::string report = format_layout(fixture(true), 2);
+    CHECK(report.find("SRAM2      0x20040000      65536        948      64588   1.4%") != std::string::npos);
+    CHECK(report.find(".ramfunc         0x20040000        948  SRAM2    FLASH 0x08001140") != std::string::npos);
+    CHECK(report.find("\nlargest in SRAM3\n     65536  0x2005d580  (anonymous namespace)::g_hil_storage\n"
+                      "     50176  0x20051000  (anonymous namespace)::g_packet_storage\n") != std::string::npos);
+    CHECK(report.find("Usart3Port::on_usart_irq") == std::string::npos);  // third in SRAM2, past the top 2
+
+    // Without a symbol listing the map's input sections stand in.
+    const std::string map_only = format_layout(fixture(false), 1);
+    CHECK(map_only.find("\nlargest in FLASH\n       728  0x0800048c  nucleo::app::Application::poll(unsigned long)\n") !=
+          std::string::npos);
+}
+
+TEST(firmware_budget_holds_for_the_fixture) {
+    Budget budget;
+    std::string error;
+    REQUIRE(parse_budget(read(NUCLEO_LAYOUT_BUDGET), budget, error));
+    CHECK(!budget.symbols.empty());
+    const auto violations = check_budget(fixture(true), budget);
+    for (const std::string& v : violations) {
+        std::fprintf(stderr, "  %s\n", v.c_str());
+    }
+    CHECK(violations.empty());
+}
+
+TEST(budget_reports_size_and_placement_violations) {
+    const Budget budget = budget_from(
+        "# comment\n"
+        "region SRAM2 512       # too small\n"
+        "region SRAM3 0x20000\n"
+        "region CCM 1K\n"
+        "section .ramfunc SRAM1\n"
+        "section .data SRAM1 0x40\n"
+        "section .noinit SRAM1\n"
+        "symbol on_irq SRAM1\n"
+        "symbol ::console SRAM3\n"
+        "symbol ADC1_IRQHandler SRAM2\n");
+    const auto v = check_budget(fixture(true), budget);
+    REQUIRE_EQ(v.size(), std::size_t{8});
+    CHECK_EQ(v[0], std::string("region SRAM2: 948 bytes used, budget 512"));
+    CHECK_EQ(v[1], std::string("region CCM: not in the map"));
+    CHECK_EQ(v[2], std::string("section .ramfunc: in SRAM2, budget says SRAM1"));
+    CHECK_EQ(v[3], std::string("section .data: 100 bytes, budget 64"));
+    CHECK_EQ(v[4], std::string("section .noinit: not in the map"));
+    CHECK_EQ(v[5], std::string("symbol on_irq: nucleo::net::(anonymous namespace)::EthPort::on_irq() in SRAM2, budget says SRAM1"));
+    // Matching is by substring: g_console_rx/tx (SRAM3) and the
+    // service_console() probe do not contain "::console".
+    CHECK_EQ(v[6], std::string("symbol ::console: main::console in SRAM1, budget says SRAM3"));
+    CHECK_EQ(v[7], std::string("symbol ADC1_IRQHandler: not in the image"));
+}
+
+TEST(budget_falls_back_to_map_symbols) {
+    // Interrupt handlers are global, so the map alone places them.
+    const auto ok = check_budget(fixture(false), budget_from("symbol ETH_IRQHandler SRAM2\n"));
+    CHECK(ok.empty());
+    const auto moved = check_budget(fixture(false), budget_from("symbol USART3_IRQHandler FLASH\n"));
+    REQUIRE_EQ(moved.size(), std::size_t{1});
+    CHECK_EQ(moved[0], std::string("symbol USART3_IRQHandler: USART3_IRQHandler in SRAM2, budget says FLASH"));
+}
+
+TEST(rejects_malformed_input) {
+    MapLayout layout;
+    std::string error;
+    CHECK(!parse_map("not a map\n", layout, error));
+    CHECK_EQ(error, std::string("no memory configuration (is this a GNU ld map?)"));
+
+    Budget budget;
+    CHECK(!parse_budget("region FLASH 10K\nsection .text\n", budget, error));
+    CHECK_EQ(error, std::string("line 2: section .text"));
+    CHECK(!parse_budget("region FLASH lots\n", budget, error));
+    CHECK(parse_budget("region FLASH 0x40000\nsection .text FLASH 2M\n", budget, error));
+    CHECK_EQ(budget.regions[0].max, std::uint64_t{0x40000});
+    CHECK_EQ(budget.sections[0].max, std::uint64_t{2 * 1024 * 1024});
+}
@@ -0,0 +1,66 @@
+// nucleo-perfdump: turns captured profiling snapshots into latency reports.
+//
+//   nucleo-perfdump [--cobs] [--cycles] [--all] <capture-file | ->
+//
+// --cobs    capture is the UART console stream (COBS frames); default is a
+//           raw SWO capture
+// --cycles  report counter ticks instead of microseconds
+// --all     report every snapshot found, not just the last one
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "perf_report.hpp"
+
+int main(int argc, char** argv) {
+    bool cobs = false;
+    bool cycles = false;
+    bool all = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cobs") == 0) {
+            cobs = true;
+        } else if (std::strcmp(argv[i], "--cycles") == 0) {
+            cycles = true;
+        } else if (std::strcmp(argv[i], "--all") == 0) {
+            all = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::fprintf(stderr, "usage: %s [--cobs] [--cycles] [--all] <capture-file | ->\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::uint8_t> capture;
+    if (std::strcmp(path, "-") == 0) {
+        capture.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+        capture.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    std::size_t errors = 0;
+    const auto snapshots = nucleo::tools::extract_snapshots(
+        nucleo::ConstByteSpan{capture.data(), capture.size()}, cobs, errors);
+    if (errors != 0) {
+        std::fprintf(stderr, "%zu corrupt snapshot(s) skipped\n", errors);
+    }
+    if (snapshots.empty()) {
+        std::fprintf(stderr, "no snapshots found\n");
+        return 1;
+    }
+    const std::size_t first = all ? 0 : snapshots.size() - 1;
+    for (std::size_t i = first; i < snapshots.size(); ++i) {
+        std::fputs(nucleo::tools::format_report(snapshots[i], cycles).c_str(), stdout);
+    }
+    return 0;
+}
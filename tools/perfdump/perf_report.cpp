@@ -0,0 +1,170 @@
+#include "perf_report.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/platform/crc32.hpp"
+#include "nucleo/uart/cobs.hpp"
+
+namespace nucleo::tools {
+
+std::uint64_t ProbeRecord::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double rank = q * static_cast<double>(count);
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < perf::kBucketCount; ++i) {
+        seen += buckets[i];
+        if (static_cast<double>(seen) >= rank && buckets[i] != 0) {
+            const std::uint64_t upper = perf::bucket_upper(i) - 1;
+            return std::clamp(upper, min, max);
+        }
+    }
+    return max;
+}
+
+const char* to_string(DecodeError error) {
+    switch (error) {
+    case DecodeError::none: return "ok";
+    case DecodeError::truncated: return "truncated";
+    case DecodeError::bad_magic: return "bad magic";
+    case DecodeError::bad_version: return "unsupported version";
+    case DecodeError::bad_crc: return "CRC mismatch";
+    case DecodeError::malformed: return "malformed";
+    }
+    return "unknown";
+}
+
+DecodeError decode_snapshot(ConstByteSpan data, Snapshot& out, std::size_t& consumed) {
+    if (data.size() < sizeof perf::kSnapshotMagic ||
+        std::memcmp(data.data(), perf::kSnapshotMagic, sizeof perf::kSnapshotMagic) != 0) {
+        return DecodeError::bad_magic;
+    }
+    ByteReader r(data.subspan(sizeof perf::kSnapshotMagic));
+    if (r.u8() != perf::kSnapshotVersion) {
+        return r.ok() ? DecodeError::bad_version : DecodeError::truncated;
+    }
+    r.u8();
+    const std::uint16_t probe_count = r.u16();
+    Snapshot snap;
+    snap.clock_hz = r.u32();
+    snap.uptime_ms = r.u32();
+
+    for (std::uint16_t p = 0; p < probe_count && r.ok(); ++p) {
+        ProbeRecord rec;
+        rec.id = static_cast<std::uint32_t>(r.varint());
+        const std::uint8_t name_len = r.u8();
+        rec.name.resize(name_len);
+        r.bytes(rec.name.data(), name_len);
+        rec.count = r.varint();
+        rec.min = r.varint();
+        rec.max = r.varint();
+        rec.total = r.varint();
+        const std::uint8_t nonzero = r.u8();
+        for (std::uint8_t b = 0; b < nonzero && r.ok(); ++b) {
+            const std::uint8_t index = r.u8();
+            const std::uint64_t n = r.varint();
+            if (index >= perf::kBucketCount) {
+                return DecodeError::malformed;
+            }
+            rec.buckets[index] = n;
+        }
+        snap.probes.push_back(std::move(rec));
+    }
+    if (!r.ok()) {
+        return DecodeError::truncated;
+    }
+
+    const std::size_t body = sizeof perf::kSnapshotMagic + r.position();
+    const std::uint32_t stored = r.u32();
+    if (!r.ok()) {
+        return DecodeError::truncated;
+    }
+    if (stored != crc32(data.data(), body)) {
+        return DecodeError::bad_crc;
+    }
+    consumed = body + 4;
+    out = std::move(snap);
+    return DecodeError::none;
+}
+
+std::vector<Snapshot> extract_snapshots(ConstByteSpan capture, bool cobs, std::size_t& errors) {
+    std::vector<Snapshot> snapshots;
+    errors = 0;
+    if (cobs) {
+        std::vector<std::uint8_t> frame(64 * 1024);
+        uart::CobsDecoder decoder(ByteSpan{frame.data(), frame.size()});
+        decoder.feed(capture, [&](ConstByteSpan payload) {
+            Snapshot snap;
+            std::size_t consumed = 0;
+            const DecodeError e = decode_snapshot(payload, snap, consumed);
+            if (e == DecodeError::none) {
+                snapshots.push_back(std::move(snap));
+            } else if (e != DecodeError::bad_magic) {
+                ++errors;  // other traffic on the console is not an error
+            }
+        });
+        return snapshots;
+    }
+
+    std::size_t pos = 0;
+    while (pos + sizeof perf::kSnapshotMagic <= capture.size()) {
+        const auto* begin = capture.data() + pos;
+        const auto* hit = std::search(begin, capture.end(), std::begin(perf::kSnapshotMagic),
+                                      std::end(perf::kSnapshotMagic));
+        if (hit == capture.end()) {
+            break;
+        }
+        pos = static_cast<std::size_t>(hit - capture.data());
+        Snapshot snap;
+        std::size_t consumed = 0;
+        if (decode_snapshot(capture.subspan(pos), snap, consumed) == DecodeError::none) {
+            snapshots.push_back(std::move(snap));
+            pos += consumed;
+        } else {
+            ++errors;
+            ++pos;
+        }
+    }
+    return snapshots;
+}
+
+std::string format_report(const Snapshot& snapshot, bool cycles) {
+    const double scale = cycles || snapshot.clock_hz == 0 ? 1.0 : 1e6 / snapshot.clock_hz;
+    const char* unit = cycles ? "cycles" : "us";
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof line, "uptime %.3f s, counter %.3f MHz, %zu probes\n",
+                  snapshot.uptime_ms / 1000.0, snapshot.clock_hz / 1e6, snapshot.probes.size());
+    out += line;
+    std::snprintf(line, sizeof line, "%-24s %10s %10s %10s %10s %10s %10s %10s  (%s)\n", "probe",
+                  "count", "min", "p50", "p90", "p99", "max", "mean", unit);
+    out += line;
+
+    std::vector<const ProbeRecord*> sorted;
+    for (const ProbeRecord& p : snapshot.probes) {
+        sorted.push_back(&p);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ProbeRecord* a, const ProbeRecord* b) { return a->total > b->total; });
+    for (const ProbeRecord* p : sorted) {
+        if (p->count == 0) {
+            std::snprintf(line, sizeof line, "%-24s %10llu\n", p->name.c_str(), 0ull);
+        } else {
+            std::snprintf(line, sizeof line,
+                          "%-24s %10llu %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                          p->name.c_str(), static_cast<unsigned long long>(p->count),
+                          p->min * scale, p->percentile(0.50) * scale,
+                          p->percentile(0.90) * scale, p->percentile(0.99) * scale,
+                          p->max * scale, p->mean() * scale);
+        }
+        out += line;
+    }
+    return out;
+}
+
+}  // namespace nucleo::tools
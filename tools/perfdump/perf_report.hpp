@@ -0,0 +1,60 @@
+// Decoding and reporting of profiling snapshots (nucleo/perf/snapshot.hpp).
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nucleo/perf/histogram.hpp"
+#include "nucleo/platform/span.hpp"
+
+namespace nucleo::tools {
+
+struct ProbeRecord {
+    std::uint32_t id = 0;
+    std::string name;
+    std::uint64_t count = 0;
+    std::uint64_t min = 0;
+    std::uint64_t max = 0;
+    std::uint64_t total = 0;
+    std::array<std::uint64_t, perf::kBucketCount> buckets{};
+
+    double mean() const { return count != 0 ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+
+    /// Histogram estimate of the q-quantile (0..1): the upper edge of the
+    /// bucket holding it, clamped to [min, max].
+    std::uint64_t percentile(double q) const;
+};
+
+struct Snapshot {
+    std::uint32_t clock_hz = 0;
+    std::uint32_t uptime_ms = 0;
+    std::vector<ProbeRecord> probes;
+};
+
+enum class DecodeError {
+    none,
+    truncated,
+    bad_magic,
+    bad_version,
+    bad_crc,
+    malformed,
+};
+
+const char* to_string(DecodeError error);
+
+/// Decodes one snapshot starting at `data[0]`. On success `consumed` is its
+/// total size including the CRC.
+DecodeError decode_snapshot(ConstByteSpan data, Snapshot& out, std::size_t& consumed);
+
+/// Finds every snapshot in a capture. With `cobs` the capture is a COBS
+/// frame stream from the UART console; otherwise it is a raw byte stream
+/// (SWO) that is scanned for the magic. Undecodable candidates are counted
+/// in `errors`.
+std::vector<Snapshot> extract_snapshots(ConstByteSpan capture, bool cobs, std::size_t& errors);
+
+/// Per-probe latency table, in microseconds or in raw cycles.
+std::string format_report(const Snapshot& snapshot, bool cycles);
+
+}  // namespace nucleo::tools
@@ -0,0 +1,157 @@
+#include <vector>
+
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/cobs.hpp"
+#include "perf_report.hpp"
+
+using namespace nucleo;
+using namespace nucleo::tools;
+
+namespace {
+
+perf::Probe g_isr("isr.adc");
+perf::Probe g_loop("loop.main");
+
+std::vector<std::uint8_t> snapshot(std::uint32_t uptime_ms) {
+    std::vector<std::uint8_t> buf(perf::snapshot_size_max());
+    buf.resize(perf::write_snapshot(ByteSpan{buf.data(), buf.size()}, uptime_ms));
+    return buf;
+}
+
+const ProbeRecord* find(const Snapshot& s, const char* name) {
+    for (const ProbeRecord& p : s.probes) {
+        if (p.name == name) {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST(round_trips_probe_statistics) {
+    perf::reset_probes();
+    for (std::uint32_t i = 1; i <= 1000; ++i) {
+        g_isr.record(i);
+    }
+    g_loop.record(5000);
+
+    const auto bytes = snapshot(4321);
+    Snapshot s;
+    std::size_t consumed = 0;
+    REQUIRE_EQ(decode_snapshot(ConstByteSpan{bytes.data(), bytes.size()}, s, consumed), DecodeError::none);
+    CHECK_EQ(consumed, bytes.size());
+    CHECK_EQ(s.uptime_ms, 4321u);
+    CHECK_EQ(s.clock_hz, perf::cycle_counter_hz());
+    CHECK_EQ(s.probes.size(), static_cast<std::size_t>(perf::probe_count()));
+
+    const ProbeRecord* isr = find(s, "isr.adc");
+    REQUIRE(isr != nullptr);
+    CHECK_EQ(isr->id, static_cast<std::uint32_t>(g_isr.id()));
+    CHECK_EQ(isr->count, 1000u);
+    CHECK_EQ(isr->min, 1u);
+    CHECK_EQ(isr->max, 1000u);
+    CHECK_EQ(isr->total, 500500u);
+    CHECK_EQ(isr->buckets[perf::bucket_index(700)], static_cast<std::uint64_t>(g_isr.stats().buckets[perf::bucket_index(700)]));
+
+    const ProbeRecord* loop = find(s, "loop.main");
+    REQUIRE(loop != nullptr);
+    CHECK_EQ(loop->count, 1u);
+    CHECK_EQ(loop->percentile(0.5), 5000u);  // clamped to the single sample
+}
+
+TEST(percentiles_are_within_bucket_resolution) {
+    perf::reset_probes();
+    for (std::uint32_t i = 1; i <= 10000; ++i) {
+        g_isr.record(i);
+    }
+    const auto bytes = snapshot(0);
+    Snapshot s;
+    std::size_t consumed = 0;
+    REQUIRE_EQ(decode_snapshot(ConstByteSpan{bytes.data(), bytes.size()}, s, consumed), DecodeError::none);
+    const ProbeRecord* isr = find(s, "isr.adc");
+    REQUIRE(isr != nullptr);
+    for (const double q : {0.5, 0.9, 0.99}) {
+        const double exact = q * 10000;
+        const double estimate = static_cast<double>(isr->percentile(q));
+        CHECK(estimate >= exact);
+        CHECK(estimate <= exact * 1.25 + 1);
+    }
+}
+
+TEST(detects_corruption) {
+    perf::reset_probes();
+    g_loop.record(10);
+    auto bytes = snapshot(1);
+    Snapshot s;
+    std::size_t consumed = 0;
+
+    auto flipped = bytes;
+    flipped[flipped.size() / 2] ^= 0x40;
+    CHECK_EQ(decode_snapshot(ConstByteSpan{flipped.data(), flipped.size()}, s, consumed), DecodeError::bad_crc);
+
+    CHECK_EQ(decode_snapshot(ConstByteSpan{bytes.data(), bytes.size() - 3}, s, consumed),
+             DecodeError::truncated);
+
+    bytes[0] = 'X';
+    CHECK_EQ(decode_snapshot(ConstByteSpan{bytes.data(), bytes.size()}, s, consumed), DecodeError::bad_magic);
+}
+
+TEST(scans_raw_swo_capture_with_noise) {
+    perf::reset_probes();
+    g_loop.record(10);
+    const auto a = snapshot(100);
+    g_loop.record(20);
+    const auto b = snapshot(200);
+
+    std::vector<std::uint8_t> capture = {0x00, 'N', 'P', 0x13, 0x37};
+    capture.insert(capture.end(), a.begin(), a.end());
+    capture.insert(capture.end(), {'N', 'P', 'R', 'F', 0x01});  // torn snapshot
+    capture.insert(capture.end(), b.begin(), b.end());
+
+    std::size_t errors = 0;
+    const auto found = extract_snapshots(ConstByteSpan{capture.data(), capture.size()}, false, errors);
+    REQUIRE_EQ(found.size(), 2u);
+    CHECK_EQ(found[0].uptime_ms, 100u);
+    CHECK_EQ(found[1].uptime_ms, 200u);
+    CHECK_EQ(errors, 1u);
+}
+
+TEST(reads_cobs_console_stream) {
+    perf::reset_probes();
+    g_isr.record(77);
+    const auto snap = snapshot(300);
+
+    std::vector<std::uint8_t> stream;
+    auto append_frame = [&](const std::vector<std::uint8_t>& payload) {
+        std::vector<std::uint8_t> enc(uart::cobs_encoded_size_max(payload.size()));
+        enc.resize(uart::cobs_encode(ConstByteSpan{payload.data(), payload.size()}, ByteSpan{enc.data(), enc.size()}));
+        stream.insert(stream.end(), enc.begin(), enc.end());
+    };
+    append_frame({1, 2, 3});  // unrelated console traffic
+    append_frame(snap);
+
+    std::size_t errors = 0;
+    const auto found = extract_snapshots(ConstByteSpan{stream.data(), stream.size()}, true, errors);
+    REQUIRE_EQ(found.size(), 1u);
+    CHECK_EQ(found[0].uptime_ms, 300u);
+    CHECK_EQ(errors, 0u);
+}
+
+TEST(report_lists_probes_by_total_time) {
+    perf::reset_probes();
+    g_isr.record(10);
+    g_loop.record(1000);
+    const auto bytes = snapshot(0);
+    Snapshot s;
+    std::size_t consumed = 0;
+    decode_snapshot(ConstByteSpan{bytes.data(), bytes.size()}, s, consumed);
+    const std::string report = format_report(s, true);
+    const auto loop_at = report.find("loop.main");
+    const auto isr_at = report.find("isr.adc");
+    CHECK(loop_at != std::string::npos);
+    CHECK(isr_at != std::string::npos);
+    CHECK(loop_at < isr_at);
+}
@@ -0,0 +1,64 @@
+// nucleo-teledump: prints the telemetry records in a capture, one line each.
+//
+//   nucleo-teledump [--cobs] <capture-file | ->
+//   nucleo-teledump --schema
+//
+// --cobs    capture is the UART console stream (COBS frames); default is
+//           the raw record stream
+// --schema  print the board schema this tool was built with and exit
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "nucleo/telemetry/board_schema.hpp"
+#include "telemetry_decode.hpp"
+
+int main(int argc, char** argv) {
+    bool cobs = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cobs") == 0) {
+            cobs = true;
+        } else if (std::strcmp(argv[i], "--schema") == 0) {
+            std::fputs(nucleo::tools::format_schema(nucleo::telemetry::board::kSchema).c_str(), stdout);
+            return 0;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::fprintf(stderr, "usage: %s [--cobs] <capture-file | ->\n       %s --schema\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    std::vector<std::uint8_t> capture;
+    if (std::strcmp(path, "-") == 0) {
+        capture.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+        capture.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    nucleo::tools::TelemetryDecoder decoder(nucleo::telemetry::board::kSchema);
+    std::size_t errors = 0;
+    const auto records = nucleo::tools::extract_records(nucleo::ConstByteSpan{capture.data(), capture.size()}, cobs,
+                                                        decoder, errors);
+    for (const auto& record : records) {
+        std::puts(nucleo::tools::format_record(record).c_str());
+    }
+    if (errors != 0) {
+        std::fprintf(stderr, "%zu undecodable frame(s) skipped\n", errors);
+    }
+    if (decoder.records_dropped() != 0) {
+        std::fprintf(stderr, "%llu record(s) dropped waiting for a key record\n",
+                     static_cast<unsigned long long>(decoder.records_dropped()));
+    }
+    return records.empty() ? 1 : 0;
+}
@@ -0,0 +1,214 @@
+#include "telemetry_decode.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "nucleo/platform/byte_writer.hpp"
+#include "nucleo/uart/cobs.hpp"
+
+namespace nucleo::tools {
+namespace {
+
+using telemetry::Encoding;
+using telemetry::FieldKind;
+
+// Truncates to the field width, then sign-extends signed fields.
+std::uint64_t extend(std::uint64_t v, const telemetry::FieldInfo& f) {
+    if (f.width >= 8) {
+        return v;
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << (8 * f.width)) - 1;
+    v &= mask;
+    if (f.kind == FieldKind::signed_integer && (v >> (8 * f.width - 1)) != 0) {
+        v |= ~mask;
+    }
+    return v;
+}
+
+}  // namespace
+
+double FieldValue::as_double() const {
+    switch (info->kind) {
+    case FieldKind::floating:
+        if (info->width == 4) {
+            const std::uint32_t b = static_cast<std::uint32_t>(bits);
+            float f;
+            std::memcpy(&f, &b, sizeof f);
+            return f;
+        } else {
+            double d;
+            std::memcpy(&d, &bits, sizeof d);
+            return d;
+        }
+    case FieldKind::signed_integer: return static_cast<double>(as_signed());
+    case FieldKind::unsigned_integer: return static_cast<double>(bits);
+    }
+    return 0;
+}
+
+const FieldValue* TelemetryRecord::field(const char* name) const {
+    for (const FieldValue& f : fields) {
+        if (std::strcmp(f.info->name, name) == 0) {
+            return &f;
+        }
+    }
+    return nullptr;
+}
+
+const char* to_string(TelemetryError error) {
+    switch (error) {
+    case TelemetryError::none: return "ok";
+    case TelemetryError::truncated: return "truncated";
+    case TelemetryError::unknown_record: return "unknown record";
+    case TelemetryError::schema_mismatch: return "schema mismatch";
+    case TelemetryError::missing_key: return "missing key record";
+    }
+    return "unknown";
+}
+
+TelemetryDecoder::TelemetryDecoder(const telemetry::Schema& schema)
+    : schema_(schema), previous_(schema.record_count), keyed_(schema.record_count, false) {
+    for (std::size_t i = 0; i < schema.record_count; ++i) {
+        previous_[i].assign(schema.records[i].field_count, 0);
+    }
+}
+
+void TelemetryDecoder::reset() { keyed_.assign(keyed_.size(), false); }
+
+TelemetryError TelemetryDecoder::decode(ConstByteSpan data, std::vector<TelemetryRecord>& out) {
+    ByteReader r(data);
+    bool dropped = false;
+    while (r.remaining() != 0) {
+        const std::uint8_t header = r.u8();
+        if (header == telemetry::kSchemaRecordId) {
+            const std::uint8_t version = r.u8();
+            const std::uint32_t hash = r.u32();
+            if (!r.ok()) {
+                return TelemetryError::truncated;
+            }
+            if (version != telemetry::kFormatVersion || hash != schema_.hash) {
+                return TelemetryError::schema_mismatch;
+            }
+            reset();
+            continue;
+        }
+
+        const std::uint8_t id = header & static_cast<std::uint8_t>(~telemetry::kKeyFlag);
+        const bool key = (header & telemetry::kKeyFlag) != 0;
+        std::size_t type = 0;
+        while (type < schema_.record_count && schema_.records[type].id != id) {
+            ++type;
+        }
+        if (type == schema_.record_count) {
+            return TelemetryError::unknown_record;
+        }
+
+        const telemetry::RecordInfo& info = schema_.records[type];
+        TelemetryRecord record;
+        record.info = &info;
+        record.key = key;
+        record.fields.reserve(info.field_count);
+        bool has_delta = false;
+        for (std::size_t i = 0; i < info.field_count; ++i) {
+            const telemetry::FieldInfo& f = info.fields[i];
+            std::uint64_t v = 0;
+            switch (f.encoding) {
+            case Encoding::uvarint: v = r.varint(); break;
+            case Encoding::svarint: v = static_cast<std::uint64_t>(r.svarint()); break;
+            case Encoding::delta:
+                v = static_cast<std::uint64_t>(r.svarint()) + (key ? 0 : previous_[type][i]);
+                has_delta = true;
+                break;
+            case Encoding::fixed:
+                for (unsigned b = 0; b < f.width; ++b) {
+                    v |= static_cast<std::uint64_t>(r.u8()) << (8 * b);
+                }
+                break;
+            }
+            record.fields.push_back({&f, f.kind == FieldKind::floating ? v : extend(v, f)});
+        }
+        if (!r.ok()) {
+            return TelemetryError::truncated;
+        }
+        if (has_delta && !key && !keyed_[type]) {
+            ++dropped_;
+            dropped = true;
+            continue;
+        }
+        keyed_[type] = true;
+        for (std::size_t i = 0; i < info.field_count; ++i) {
+            previous_[type][i] = record.fields[i].bits;
+        }
+        ++decoded_;
+        out.push_back(std::move(record));
+    }
+    return dropped ? TelemetryError::missing_key : TelemetryError::none;
+}
+
+std::vector<TelemetryRecord> extract_records(ConstByteSpan capture, bool cobs, TelemetryDecoder& decoder,
+                                             std::size_t& errors) {
+    std::vector<TelemetryRecord> records;
+    errors = 0;
+    const auto decode = [&](ConstByteSpan data) {
+        const std::size_t before = records.size();
+        const TelemetryError e = decoder.decode(data, records);
+        if (e == TelemetryError::none || e == TelemetryError::missing_key) {
+            return;
+        }
+        // A console frame that does not even start with a record is other
+        // traffic (echoes, profiling snapshots), not an error.
+        if (cobs && e == TelemetryError::unknown_record && records.size() == before) {
+            return;
+        }
+        ++errors;
+        decoder.reset();
+    };
+    if (cobs) {
+        std::vector<std::uint8_t> frame(64 * 1024);
+        uart::CobsDecoder frames(ByteSpan{frame.data(), frame.size()});
+        frames.feed(capture, decode);
+    } else {
+        decode(capture);
+    }
+    return records;
+}
+
+std::string format_record(const TelemetryRecord& record) {
+    std::string out = record.info->name;
+    char value[64];
+    for (const FieldValue& f : record.fields) {
+        switch (f.info->kind) {
+        case FieldKind::floating: std::snprintf(value, sizeof value, "%g", f.as_double()); break;
+        case FieldKind::signed_integer: std::snprintf(value, sizeof value, "%" PRId64, f.as_signed()); break;
+        case FieldKind::unsigned_integer: std::snprintf(value, sizeof value, "%" PRIu64, f.as_unsigned()); break;
+        }
+        out += ' ';
+        out += f.info->name;
+        out += '=';
+        out += value;
+    }
+    return out;
+}
+
+std::string format_schema(const telemetry::Schema& schema) {
+    std::string out;
+    char line[128];
+    for (std::size_t r = 0; r < schema.record_count; ++r) {
+        const telemetry::RecordInfo& info = schema.records[r];
+        std::snprintf(line, sizeof line, "%3u %s\n", static_cast<unsigned>(info.id), info.name);
+        out += line;
+        for (std::size_t i = 0; i < info.field_count; ++i) {
+            const telemetry::FieldInfo& f = info.fields[i];
+            const char kind = f.kind == FieldKind::floating ? 'f' : f.kind == FieldKind::signed_integer ? 'i' : 'u';
+            std::snprintf(line, sizeof line, "      %-20s %c%-3u %s\n", f.name, kind, 8u * f.width,
+                          telemetry::to_string(f.encoding));
+            out += line;
+        }
+    }
+    std::snprintf(line, sizeof line, "schema hash %08" PRIx32 "\n", schema.hash);
+    out += line;
+    return out;
+}
+
+}  // namespace nucleo::tools
@@ -0,0 +1,93 @@
+// Decoding of telemetry streams (nucleo/telemetry/encoding.hpp) against the
+// descriptor table of the schema the firmware was built with.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nucleo/platform/span.hpp"
+#include "nucleo/telemetry/encoding.hpp"
+
+namespace nucleo::tools {
+
+struct FieldValue {
+    const telemetry::FieldInfo* info = nullptr;
+    /// Integers sign- or zero-extended to 64 bits; floats as their bits.
+    std::uint64_t bits = 0;
+
+    std::uint64_t as_unsigned() const { return bits; }
+    std::int64_t as_signed() const { return static_cast<std::int64_t>(bits); }
+    /// Any kind, converted.
+    double as_double() const;
+};
+
+struct TelemetryRecord {
+    const telemetry::RecordInfo* info = nullptr;
+    bool key = false;
+    std::vector<FieldValue> fields;
+
+    /// The field called `name`, or null.
+    const FieldValue* field(const char* name) const;
+};
+
+enum class TelemetryError {
+    none,
+    /// The data ends inside a record.
+    truncated,
+    /// A header byte names no record in the schema; the rest of the data
+    /// cannot be delimited.
+    unknown_record,
+    /// A schema record with another hash or format version.
+    schema_mismatch,
+    /// Delta records arrived before the first key record of their type and
+    /// were dropped; decoding went on after them.
+    missing_key,
+};
+
+const char* to_string(TelemetryError error);
+
+/// Keeps the delta state of one stream. Feed it the stream in order; a
+/// transport frame may hold any number of whole records.
+class TelemetryDecoder {
+public:
+    explicit TelemetryDecoder(const telemetry::Schema& schema);
+
+    /// Appends the records in `data` to `out`. Stops at the first
+    /// truncated, unknown_record or schema_mismatch error and returns it;
+    /// otherwise returns missing_key if any record was dropped for lack of
+    /// a key record, else none.
+    TelemetryError decode(ConstByteSpan data, std::vector<TelemetryRecord>& out);
+
+    /// Forgets the delta state, so each type waits for its next key record.
+    /// Call it when the transport reports a lost frame.
+    void reset();
+
+    const telemetry::Schema& schema() const { return schema_; }
+    std::uint64_t records_decoded() const { return decoded_; }
+    std::uint64_t records_dropped() const { return dropped_; }
+
+private:
+    const telemetry::Schema& schema_;
+    // Per record type, in schema order: last value of every field.
+    std::vector<std::vector<std::uint64_t>> previous_;
+    std::vector<bool> keyed_;
+    std::uint64_t decoded_ = 0;
+    std::uint64_t dropped_ = 0;
+};
+
+/// Every record in a capture. With `cobs` the capture is a COBS frame
+/// stream from the UART console, where frames that are not telemetry are
+/// skipped; otherwise it is the raw record stream. Errors other than
+/// missing_key are counted in `errors`, and the decoder state is reset
+/// after them.
+std::vector<TelemetryRecord> extract_records(ConstByteSpan capture, bool cobs, TelemetryDecoder& decoder,
+                                             std::size_t& errors);
+
+/// "AdcBlock timestamp_us=1000 channel=1 min=-3 ...", no newline.
+std::string format_record(const TelemetryRecord& record);
+
+/// One line per record type with its id and fields, then the schema hash.
+std::string format_schema(const telemetry::Schema& schema);
+
+}  // namespace nucleo::tools
@@ -0,0 +1,270 @@
+#include <limits>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "nucleo/perf/probe.hpp"
+#include "nucleo/perf/snapshot.hpp"
+#include "nucleo/telemetry/board_schema.hpp"
+#include "nucleo/testkit/unit.hpp"
+#include "nucleo/uart/cobs.hpp"
+#include "telemetry_decode.hpp"
+
+#define NUCLEO_TELEMETRY_SCHEMA "test/wide_schema.def"
+#define NUCLEO_TELEMETRY_NAMESPACE wide
+#include "nucleo/telemetry/generate.hpp"
+
+using namespace nucleo;
+using namespace nucleo::tools;
+namespace board = nucleo::telemetry::board;
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+using BoardRecord = std::variant<board::Status, board::AdcBlock, board::LoopTiming, board::Power>;
+
+template <typename Encoder, typename Record>
+void append(Bytes& out, Encoder& encoder, const Record& record) {
+    std::uint8_t buf[256];
+    const std::size_t n = encoder.encode(record, buf);
+    out.insert(out.end(), buf, buf + n);
+}
+
+template <typename Encoder>
+void append_schema(Bytes& out, Encoder& encoder) {
+    std::uint8_t buf[telemetry::kSchemaRecordSize];
+    const std::size_t n = encoder.encode_schema(buf);
+    out.insert(out.end(), buf, buf + n);
+}
+
+std::uint64_t u(const TelemetryRecord& r, const char* name) {
+    const FieldValue* f = r.field(name);
+    return f != nullptr ? f->as_unsigned() : 0xDEAD;
+}
+
+std::int64_t s(const TelemetryRecord& r, const char* name) {
+    const FieldValue* f = r.field(name);
+    return f != nullptr ? f->as_signed() : 0xDEAD;
+}
+
+double d(const TelemetryRecord& r, const char* name) {
+    const FieldValue* f = r.field(name);
+    return f != nullptr ? f->as_double() : -1;
+}
+
+bool matches(const TelemetryRecord& r, const board::Status& e) {
+    return std::string(r.info->name) == "Status" && u(r, "uptime_ms") == e.uptime_ms &&
+           u(r, "heartbeats") == e.heartbeats && u(r, "button_presses") == e.button_presses &&
+           u(r, "frames_echoed") == e.frames_echoed && u(r, "datagrams_echoed") == e.datagrams_echoed;
+}
+
+bool matches(const TelemetryRecord& r, const board::AdcBlock& e) {
+    return std::string(r.info->name) == "AdcBlock" && u(r, "timestamp_us") == e.timestamp_us &&
+           u(r, "channel") == e.channel && s(r, "min") == e.min && s(r, "max") == e.max && s(r, "mean") == e.mean &&
+           u(r, "overruns") == e.overruns;
+}
+
+bool matches(const TelemetryRecord& r, const board::LoopTiming& e) {
+    return std::string(r.info->name) == "LoopTiming" && u(r, "timestamp_us") == e.timestamp_us &&
+           u(r, "cycles_min") == e.cycles_min && u(r, "cycles_max") == e.cycles_max &&
+           u(r, "cycles_mean") == e.cycles_mean && u(r, "deadline_misses") == e.deadline_misses;
+}
+
+bool matches(const TelemetryRecord& r, const board::Power& e) {
+    return std::string(r.info->name) == "Power" && u(r, "timestamp_ms") == e.timestamp_ms &&
+           u(r, "vdd_mv") == e.vdd_mv && s(r, "current_ua") == e.current_ua &&
+           d(r, "temperature_c") == static_cast<double>(e.temperature_c);
+}
+
+std::vector<BoardRecord> random_board_records(std::size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    const auto next = [&] { return static_cast<std::uint32_t>(rng()); };
+    std::vector<BoardRecord> out;
+    std::uint32_t t = 0xFFFF0000u;  // wraps part-way through
+    for (std::size_t i = 0; i < n; ++i) {
+        t += next() % 5000;
+        switch (next() % 4) {
+        case 0:
+            out.push_back(board::Status{t, static_cast<std::uint32_t>(i), static_cast<std::uint16_t>(next()), next(),
+                                        next() % 3});
+            break;
+        case 1:
+            out.push_back(board::AdcBlock{t, static_cast<std::uint8_t>(next() % 8), static_cast<std::int16_t>(next()),
+                                          static_cast<std::int16_t>(next()), static_cast<std::int16_t>(next()),
+                                          static_cast<std::uint16_t>(next() % 2)});
+            break;
+        case 2: out.push_back(board::LoopTiming{t, next() % 20000, next(), next() % 20000, 0}); break;
+        default:
+            out.push_back(board::Power{t / 1000, static_cast<std::uint16_t>(3300 + next() % 20),
+                                       static_cast<std::int32_t>(next()), static_cast<float>(next() % 1000) / 8});
+            break;
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(board_records_round_trip) {
+    const auto expected = random_board_records(2000, 1);
+    board::Encoder encoder(8);
+    Bytes stream;
+    append_schema(stream, encoder);
+    for (const BoardRecord& r : expected) {
+        std::visit([&](const auto& record) { append(stream, encoder, record); }, r);
+    }
+
+    TelemetryDecoder decoder(board::kSchema);
+    std::vector<TelemetryRecord> got;
+    REQUIRE_EQ(decoder.decode(ConstByteSpan{stream.data(), stream.size()}, got), TelemetryError::none);
+    REQUIRE_EQ(got.size(), expected.size());
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        if (!std::visit([&](const auto& record) { return matches(got[i], record); }, expected[i])) {
+            ++mismatches;
+        }
+    }
+    CHECK_EQ(mismatches, 0u);
+    CHECK_EQ(decoder.records_decoded(), expected.size());
+}
+
+TEST(every_field_type_round_trips_at_its_limits) {
+    using I64 = std::numeric_limits<std::int64_t>;
+    const wide::Wide records[] = {
+        {0, 0, 0, 0, 0, 0, 0, 0, false, false, 0.0, 0.0f},
+        {UINT64_MAX, I64::min(), I64::max(), UINT64_MAX, 127, 255, -32768, UINT32_MAX, true, true, -1.5e300, 3.5f},
+        {1, I64::max(), I64::min(), 1, -128, 0, 32767, 0, false, true, 1e-300, -0.0f},
+        {UINT64_MAX / 3, -1, -1, 42, -1, 1, -1, 7, true, false, 2.0, 1e30f},
+    };
+    wide::Encoder encoder(3);
+    Bytes stream;
+    for (int pass = 0; pass < 3; ++pass) {
+        for (const wide::Wide& r : records) {
+            append(stream, encoder, r);
+        }
+    }
+
+    TelemetryDecoder decoder(wide::kSchema);
+    std::vector<TelemetryRecord> got;
+    REQUIRE_EQ(decoder.decode(ConstByteSpan{stream.data(), stream.size()}, got), TelemetryError::none);
+    REQUIRE_EQ(got.size(), 12u);
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        const wide::Wide& e = records[i % 4];
+        const TelemetryRecord& r = got[i];
+        CHECK_EQ(u(r, "u64"), e.u64);
+        CHECK_EQ(s(r, "i64"), e.i64);
+        CHECK_EQ(s(r, "i64_delta"), e.i64_delta);
+        CHECK_EQ(u(r, "u64_fixed"), e.u64_fixed);
+        CHECK_EQ(s(r, "i8_delta"), e.i8_delta);
+        CHECK_EQ(u(r, "u8_delta"), e.u8_delta);
+        CHECK_EQ(s(r, "i16_fixed"), e.i16_fixed);
+        CHECK_EQ(u(r, "u32_svarint"), e.u32_svarint);
+        CHECK_EQ(u(r, "flag"), e.flag ? 1u : 0u);
+        CHECK_EQ(u(r, "flag_fixed"), e.flag_fixed ? 1u : 0u);
+        CHECK_EQ(d(r, "ratio"), e.ratio);
+        CHECK_EQ(d(r, "gain"), static_cast<double>(e.gain));
+    }
+}
+
+TEST(joining_mid_stream_waits_for_key_records) {
+    board::Encoder encoder(4);
+    Bytes head;
+    Bytes tail;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+        append(i < 2 ? head : tail, encoder, board::AdcBlock{i * 1000, 0, 0, 0, static_cast<std::int16_t>(i), 0});
+    }
+
+    TelemetryDecoder decoder(board::kSchema);
+    std::vector<TelemetryRecord> got;
+    // Records 2 and 3 are deltas against records the decoder never saw;
+    // record 4 is the next key record.
+    CHECK_EQ(decoder.decode(ConstByteSpan{tail.data(), tail.size()}, got), TelemetryError::missing_key);
+    CHECK_EQ(decoder.records_dropped(), 2u);
+    REQUIRE_EQ(got.size(), 6u);
+    CHECK(got[0].key);
+    CHECK_EQ(u(got[0], "timestamp_us"), 4000u);
+    CHECK_EQ(s(got[5], "mean"), 9);
+
+    // Records without delta fields need no key record.
+    wide::Encoder events;
+    Bytes event;
+    append(event, events, wide::Event{3});
+    append(event, events, wide::Event{4});
+    TelemetryDecoder event_decoder(wide::kSchema);
+    got.clear();
+    CHECK_EQ(event_decoder.decode(ConstByteSpan{event.data() + 2, 2}, got), TelemetryError::none);
+    REQUIRE_EQ(got.size(), 1u);
+    CHECK(!got[0].key);
+    CHECK_EQ(u(got[0], "code"), 4u);
+}
+
+TEST(rejects_other_schemas_and_truncated_records) {
+    board::Encoder encoder;
+    Bytes stream;
+    append_schema(stream, encoder);
+    append(stream, encoder, board::Status{1, 2, 3, 4, 5});
+    append(stream, encoder, board::Power{1, 3300, -4, 20.0f});
+
+    TelemetryDecoder decoder(board::kSchema);
+    std::vector<TelemetryRecord> got;
+    CHECK_EQ(decoder.decode(ConstByteSpan{stream.data(), stream.size() - 1}, got), TelemetryError::truncated);
+    CHECK_EQ(got.size(), 1u);
+
+    TelemetryDecoder other(wide::kSchema);
+    got.clear();
+    CHECK_EQ(other.decode(ConstByteSpan{stream.data(), stream.size()}, got), TelemetryError::schema_mismatch);
+    CHECK(got.empty());
+
+    stream[1] = telemetry::kFormatVersion + 1;
+    CHECK_EQ(decoder.decode(ConstByteSpan{stream.data(), stream.size()}, got), TelemetryError::schema_mismatch);
+}
+
+TEST(console_capture_skips_other_frames) {
+    perf::Probe probe("teledump.test");
+    probe.record(5);
+    Bytes snapshot(perf::snapshot_size_max());
+    snapshot.resize(perf::write_snapshot(ByteSpan{snapshot.data(), snapshot.size()}, 0));
+
+    board::Encoder encoder;
+    Bytes capture;
+    const auto frame = [&](const Bytes& payload) {
+        Bytes encoded(uart::cobs_encoded_size_max(payload.size()));
+        encoded.resize(uart::cobs_encode(ConstByteSpan{payload.data(), payload.size()},
+                                         ByteSpan{encoded.data(), encoded.size()}));
+        capture.insert(capture.end(), encoded.begin(), encoded.end());
+    };
+    Bytes records;
+    append_schema(records, encoder);
+    append(records, encoder, board::Status{1000, 1, 0, 0, 0});
+    append(records, encoder, board::Status{2000, 2, 0, 0, 0});
+    frame(records);
+    frame(Bytes{'h', 'e', 'l', 'l', 'o'});
+    frame(snapshot);
+    records.clear();
+    append(records, encoder, board::Status{3000, 3, 0, 0, 0});
+    frame(records);
+
+    TelemetryDecoder decoder(board::kSchema);
+    std::size_t errors = 0;
+    const auto got = extract_records(ConstByteSpan{capture.data(), capture.size()}, true, decoder, errors);
+    CHECK_EQ(errors, 0u);
+    REQUIRE_EQ(got.size(), 3u);
+    CHECK_EQ(u(got[2], "uptime_ms"), 3000u);
+    CHECK_EQ(u(got[2], "heartbeats"), 3u);
+}
+
+TEST(formats_records_and_schemas) {
+    board::Encoder encoder;
+    Bytes stream;
+    append(stream, encoder, board::Power{5, 3300, -12, 25.5f});
+    TelemetryDecoder decoder(board::kSchema);
+    std::vector<TelemetryRecord> got;
+    REQUIRE_EQ(decoder.decode(ConstByteSpan{stream.data(), stream.size()}, got), TelemetryError::none);
+    REQUIRE_EQ(got.size(), 1u);
+    CHECK(format_record(got[0]) == "Power timestamp_ms=5 vdd_mv=3300 current_ua=-12 temperature_c=25.5");
+
+    const std::string schema = format_schema(board::kSchema);
+    CHECK(schema.find("  2 AdcBlock\n") != std::string::npos);
+    CHECK(schema.find("mean                 i16  delta\n") != std::string::npos);
+}